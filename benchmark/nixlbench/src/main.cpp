@@ -50,6 +50,12 @@ static std::pair<size_t, size_t> getStrideScheme(xferBenchWorker &worker, int nu
         if (worker.isTarget()) {
             count = initiator_device;
         }
+    } else if (XFERBENCH_SCHEME_MANY_TO_MANY == xferBenchConfig::scheme) {
+        if (worker.isInitiator()) {
+            count = target_device;
+        } else if (worker.isTarget()) {
+            count = initiator_device;
+        }
     } else if (XFERBENCH_SCHEME_TP == xferBenchConfig::scheme) {
         if (worker.isInitiator()) {
             if (initiator_device < target_device) {
@@ -74,11 +80,21 @@ static std::vector<std::vector<xferBenchIOV>> createTransferDescLists(xferBenchW
     auto [count, stride] = getStrideScheme(worker, num_threads);
     std::vector<std::vector<xferBenchIOV>> xfer_lists;
 
+    // For many to many, the target lists its devices per initiator device, so that the
+    // chunk of each initiator device for a target device meets the chunk of that target
+    // device for it
+    bool by_chunk = (XFERBENCH_SCHEME_MANY_TO_MANY == xferBenchConfig::scheme) &&
+                    worker.isTarget();
+
     for (const auto &iov_list: iov_lists) {
         std::vector<xferBenchIOV> xfer_list;
+        size_t outer = by_chunk ? count : iov_list.size();
+        size_t inner = by_chunk ? iov_list.size() : count;
 
-        for (const auto &iov : iov_list) {
-            for (size_t i = 0; i < count; i++) {
+        for (size_t o = 0; o < outer; o++) {
+            for (size_t n = 0; n < inner; n++) {
+                const auto &iov = iov_list[by_chunk ? n : o];
+                size_t i = by_chunk ? o : n;
                 size_t offset = ((i * stride) % iov.len);
 
                 for (size_t j = 0; j < batch_size; j++) {
@@ -134,7 +150,7 @@ static int processBatchSizes(xferBenchWorker &worker,
             }
 
             xferBenchUtils::printStats(block_size, batch_size,
-                                    std::get<double>(result));
+                                    std::get<double>(result), worker.getLatencies());
         }
     }
 
@@ -211,6 +227,16 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (worker_ptr->isInitiator()) {
+        if (0 != xferBenchUtils::writeResults()) {
+            return EXIT_FAILURE;
+        }
+        // Regressions fail the run, to gate changes on it
+        if (0 != xferBenchUtils::compareBaseline()) {
+            return EXIT_FAILURE;
+        }
+    }
+
     gflags::ShutDownCommandLineFlags();
 
     return EXIT_SUCCESS;
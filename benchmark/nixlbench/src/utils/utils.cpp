@@ -15,7 +15,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <fstream>
 #include <gflags/gflags.h>
 #include <sstream>
 #include <sys/time.h>
@@ -23,6 +26,7 @@
 #include <utility>
 #include <iomanip>
 #include <omp.h>
+#include <regex>
 #if HAVE_CUDA
 #include <cuda_runtime.h>
 #endif
@@ -36,13 +40,13 @@
  **********/
 DEFINE_string(runtime_type, XFERBENCH_RT_ETCD, "Runtime type to use for communication [ETCD]");
 DEFINE_string(worker_type, XFERBENCH_WORKER_NIXL, "Type of worker [nixl, nvshmem]");
-DEFINE_string(backend, XFERBENCH_BACKEND_UCX, "Name of communication backend [UCX, UCX_MO, GDS] \
+DEFINE_string(backend, XFERBENCH_BACKEND_UCX, "Name of communication backend [UCX, UCX_MO, GDS, POSIX] \
               (only used with nixl worker)");
 DEFINE_string(initiator_seg_type, XFERBENCH_SEG_TYPE_DRAM, "Type of memory segment for initiator \
               [DRAM, VRAM]");
 DEFINE_string(target_seg_type, XFERBENCH_SEG_TYPE_DRAM, "Type of memory segment for target \
               [DRAM, VRAM]");
-DEFINE_string(scheme, XFERBENCH_SCHEME_PAIRWISE, "Scheme: pairwise, maytoone, onetomany, tp");
+DEFINE_string(scheme, XFERBENCH_SCHEME_PAIRWISE, "Scheme: pairwise, maytoone, onetomany, manytomany, tp");
 DEFINE_string(mode, XFERBENCH_MODE_SG, "MODE: SG (Single GPU per proc), MG (Multi GPU per proc) [default: SG]");
 DEFINE_string(op_type, XFERBENCH_OP_WRITE, "Op type: READ, WRITE");
 DEFINE_bool(check_consistency, false, "Enable Consistency Check");
@@ -63,15 +67,38 @@ DEFINE_int32(num_threads, 1,
 DEFINE_int32(num_initiator_dev, 1, "Number of device in initiator process");
 DEFINE_int32(num_target_dev, 1, "Number of device in target process");
 DEFINE_bool(enable_pt, false, "Enable Progress Thread (only used with nixl worker)");
-// GDS options - only used when backend is GDS
-DEFINE_string(gds_filepath, "", "File path for GDS operations (only used with GDS backend)");
-DEFINE_bool(gds_enable_direct, false, "Enable direct I/O for GDS operations (only used with GDS backend)");
+// File options - only used when backend is GDS or POSIX
+DEFINE_string(gds_filepath, "", "File path for GDS and POSIX operations (only used with file backends)");
+DEFINE_bool(gds_enable_direct, false, "Enable direct I/O for GDS and POSIX operations (only used with \
+            file backends)");
+DEFINE_bool(storage_workload, false, "Transfer IOs of the block and batch sizes at file offsets of \
+            io_pattern, instead of whole buffers, reporting IOPS and latency percentiles \
+            (only used with file backends)");
+DEFINE_string(io_pattern, XFERBENCH_IO_PATTERN_SEQ, "Offsets of the IOs of the storage workload \
+              [seq, random]");
+DEFINE_int32(read_ratio, -1, "Percentage of reads of a mixed storage workload, -1 for op_type only");
+DEFINE_int32(num_files, 1, "Number of files of the storage workload (Default: 1)");
+DEFINE_uint64(file_size, 0, "Size of each file of the storage workload, 0 for total_buffer_size");
+DEFINE_string(output_file, "", "File to write the configuration and results to, in output_format");
+DEFINE_string(output_format, XFERBENCH_OUTPUT_JSON, "Format of output_file [json, csv]");
+DEFINE_string(baseline, "", "Result file of a previous run, json or csv, to compare the results with. \
+              Exits with failure on regressions beyond regression_threshold");
+DEFINE_double(regression_threshold, 5.0, "Percentage by which bandwidth or IOPS may drop, or \
+              latency percentiles grow, from the baseline (Default: 5)");
+DEFINE_uint64(stripe_size, 0, "Bytes of each file in turn over the files of the storage workload, \
+              0 to concatenate the files");
 // TODO: We should take rank wise device list as input to extend support
 // <rank>:<device_list>, ...
 // For example- 0:mlx5_0,mlx5_1,mlx5_2,1:mlx5_3,mlx5_4, ...
 DEFINE_string(device_list, "all", "Comma-separated device name to use for \
 		      communication (only used with nixl worker)");
 DEFINE_string(etcd_endpoints, "http://localhost:2379", "ETCD server endpoints for communication");
+DEFINE_bool(latency_percentiles, false, "Report min/p50/p90/p99/p99.9/max of the post to \
+            completion latency of the iterations (only used with nixl worker)");
+DEFINE_uint64(offered_load, 0, "Posts per second of each thread at fixed intervals, with the \
+              latency from the scheduled post time. 0 posts back to back (only used with nixl worker)");
+DEFINE_int32(queue_depth, 1, "Transfers kept in flight per thread, each reposted once done, over \
+             the same buffers. Bounds the posts in flight with offered_load (Default: 1)");
 
 std::string xferBenchConfig::runtime_type = "";
 std::string xferBenchConfig::worker_type = "";
@@ -97,6 +124,19 @@ std::string xferBenchConfig::device_list = "";
 std::string xferBenchConfig::etcd_endpoints = "";
 std::string xferBenchConfig::gds_filepath = "";
 bool xferBenchConfig::gds_enable_direct = false;
+bool xferBenchConfig::latency_percentiles = false;
+uint64_t xferBenchConfig::offered_load = 0;
+int xferBenchConfig::queue_depth = 0;
+bool xferBenchConfig::storage_workload = false;
+std::string xferBenchConfig::io_pattern = "";
+int xferBenchConfig::read_ratio = -1;
+int xferBenchConfig::num_files = 0;
+size_t xferBenchConfig::file_size = 0;
+size_t xferBenchConfig::stripe_size = 0;
+std::string xferBenchConfig::output_file = "";
+std::string xferBenchConfig::output_format = "";
+std::string xferBenchConfig::baseline = "";
+double xferBenchConfig::regression_threshold = 0;
 std::vector<std::string> devices = { };
 
 int xferBenchConfig::loadFromFlags() {
@@ -108,11 +148,58 @@ int xferBenchConfig::loadFromFlags() {
         backend = FLAGS_backend;
         enable_pt = FLAGS_enable_pt;
         device_list = FLAGS_device_list;
+        latency_percentiles = FLAGS_latency_percentiles;
+        offered_load = FLAGS_offered_load;
+        queue_depth = FLAGS_queue_depth;
 
-        // Load GDS-specific configurations if backend is GDS
-        if (backend == XFERBENCH_BACKEND_GDS) {
+        if (queue_depth < 1) {
+            std::cerr << "queue_depth must be at least 1" << std::endl;
+            return -1;
+        }
+
+        // Load file configurations if backend is GDS or POSIX
+        if (IS_FILE_BACKEND()) {
             gds_filepath = FLAGS_gds_filepath;
             gds_enable_direct = FLAGS_gds_enable_direct;
+            storage_workload = FLAGS_storage_workload;
+        }
+
+        if (storage_workload) {
+            io_pattern = FLAGS_io_pattern;
+            read_ratio = FLAGS_read_ratio;
+            num_files = FLAGS_num_files;
+            file_size = FLAGS_file_size ? FLAGS_file_size : FLAGS_total_buffer_size;
+            stripe_size = FLAGS_stripe_size;
+            // Percentiles are part of the report of the storage workload
+            latency_percentiles = true;
+
+            if ((io_pattern != XFERBENCH_IO_PATTERN_SEQ) &&
+                (io_pattern != XFERBENCH_IO_PATTERN_RANDOM)) {
+                std::cerr << "Invalid io_pattern: " << io_pattern << std::endl;
+                return -1;
+            }
+            if ((read_ratio < -1) || (read_ratio > 100)) {
+                std::cerr << "read_ratio must be -1 or between 0 and 100" << std::endl;
+                return -1;
+            }
+            if (num_files < 1) {
+                std::cerr << "num_files must be at least 1" << std::endl;
+                return -1;
+            }
+            if (stripe_size && (file_size % stripe_size)) {
+                std::cerr << "file_size must be a multiple of stripe_size" << std::endl;
+                return -1;
+            }
+            if (FLAGS_scheme != XFERBENCH_SCHEME_PAIRWISE) {
+                std::cerr << "Storage workload is only supported with pairwise scheme" << std::endl;
+                return -1;
+            }
+            if ((num_files * file_size) / FLAGS_num_threads <
+                FLAGS_max_block_size * FLAGS_max_batch_size) {
+                std::cerr << "Files of the storage workload have less than "
+                          << "(max_block_size * max_batch_size) per thread" << std::endl;
+                return -1;
+            }
         }
     }
 
@@ -133,6 +220,19 @@ int xferBenchConfig::loadFromFlags() {
     warmup_iter = FLAGS_warmup_iter;
     num_threads = FLAGS_num_threads;
     etcd_endpoints = FLAGS_etcd_endpoints;
+    output_file = FLAGS_output_file;
+    output_format = FLAGS_output_format;
+    baseline = FLAGS_baseline;
+    regression_threshold = FLAGS_regression_threshold;
+
+    if ((output_format != XFERBENCH_OUTPUT_JSON) && (output_format != XFERBENCH_OUTPUT_CSV)) {
+        std::cerr << "Invalid output_format: " << output_format << std::endl;
+        return -1;
+    }
+    if (regression_threshold < 0) {
+        std::cerr << "regression_threshold must not be negative" << std::endl;
+        return -1;
+    }
 
     if (worker_type == XFERBENCH_WORKER_NVSHMEM) {
         if (!((XFERBENCH_SEG_TYPE_VRAM == initiator_seg_type) &&
@@ -212,26 +312,46 @@ void xferBenchConfig::printConfig() {
     std::cout << std::left << std::setw(60) << "Worker type (--worker_type=[nixl,nvshmem])" << ": "
               << worker_type << std::endl;
     if (worker_type == XFERBENCH_WORKER_NIXL) {
-        std::cout << std::left << std::setw(60) << "Backend (--backend=[UCX,UCX_MO,GDS])" << ": "
+        std::cout << std::left << std::setw(60) << "Backend (--backend=[UCX,UCX_MO,GDS,POSIX])" << ": "
                   << backend << std::endl;
         std::cout << std::left << std::setw(60) << "Enable pt (--enable_pt=[0,1])" << ": "
                   << enable_pt << std::endl;
         std::cout << std::left << std::setw(60) << "Device list (--device_list=dev1,dev2,...)" << ": "
                   << device_list << std::endl;
-
-        // Print GDS options if backend is GDS
-        if (backend == XFERBENCH_BACKEND_GDS) {
+        std::cout << std::left << std::setw(60) << "Latency percentiles (--latency_percentiles=[0,1])" << ": "
+                  << latency_percentiles << std::endl;
+        std::cout << std::left << std::setw(60) << "Offered load (--offered_load=N)" << ": "
+                  << offered_load << std::endl;
+        std::cout << std::left << std::setw(60) << "Queue depth (--queue_depth=N)" << ": "
+                  << queue_depth << std::endl;
+
+        // Print file options if backend is GDS or POSIX
+        if (IS_FILE_BACKEND()) {
             std::cout << std::left << std::setw(60) << "GDS filepath (--gds_filepath=path)" << ": "
                       << gds_filepath << std::endl;
             std::cout << std::left << std::setw(60) << "GDS enable direct (--gds_enable_direct=[0,1])" << ": "
                       << gds_enable_direct << std::endl;
+            std::cout << std::left << std::setw(60) << "Storage workload (--storage_workload=[0,1])" << ": "
+                      << storage_workload << std::endl;
+        }
+        if (storage_workload) {
+            std::cout << std::left << std::setw(60) << "IO pattern (--io_pattern=[seq,random])" << ": "
+                      << io_pattern << std::endl;
+            std::cout << std::left << std::setw(60) << "Read ratio (--read_ratio=N)" << ": "
+                      << read_ratio << std::endl;
+            std::cout << std::left << std::setw(60) << "Num files (--num_files=N)" << ": "
+                      << num_files << std::endl;
+            std::cout << std::left << std::setw(60) << "File size (--file_size=N)" << ": "
+                      << file_size << std::endl;
+            std::cout << std::left << std::setw(60) << "Stripe size (--stripe_size=N)" << ": "
+                      << stripe_size << std::endl;
         }
     }
     std::cout << std::left << std::setw(60) << "Initiator seg type (--initiator_seg_type=[DRAM,VRAM])" << ": "
               << initiator_seg_type << std::endl;
     std::cout << std::left << std::setw(60) << "Target seg type (--target_seg_type=[DRAM,VRAM])" << ": "
               << target_seg_type << std::endl;
-    std::cout << std::left << std::setw(60) << "Scheme (--scheme=[pairwise,manytoone,onetomany,tp])" << ": "
+    std::cout << std::left << std::setw(60) << "Scheme (--scheme=[pairwise,manytoone,onetomany,manytomany,tp])" << ": "
               << scheme << std::endl;
     std::cout << std::left << std::setw(60) << "Mode (--mode=[SG,MG])" << ": "
               << mode << std::endl;
@@ -259,10 +379,75 @@ void xferBenchConfig::printConfig() {
               << warmup_iter << std::endl;
     std::cout << std::left << std::setw(60) << "Num threads (--num_threads=N)" << ": "
               << num_threads << std::endl;
+    if (output_file != "") {
+        std::cout << std::left << std::setw(60) << "Output file (--output_file=path)" << ": "
+                  << output_file << std::endl;
+        std::cout << std::left << std::setw(60) << "Output format (--output_format=[json,csv])" << ": "
+                  << output_format << std::endl;
+    }
+    if (baseline != "") {
+        std::cout << std::left << std::setw(60) << "Baseline (--baseline=path)" << ": "
+                  << baseline << std::endl;
+        std::cout << std::left << std::setw(60) << "Regression threshold (--regression_threshold=N)" << ": "
+                  << regression_threshold << std::endl;
+    }
     std::cout << std::string(80, '-') << std::endl;
     std::cout << std::endl;
 }
 
+std::vector<std::pair<std::string, std::string>> xferBenchConfig::getConfigFields() {
+    std::vector<std::pair<std::string, std::string>> fields;
+    auto add = [&fields](const std::string &name, const auto &value) {
+        std::ostringstream ss;
+        ss << value;
+        fields.emplace_back(name, ss.str());
+    };
+
+    add("runtime_type", runtime_type);
+    if (runtime_type == XFERBENCH_RT_ETCD) {
+        add("etcd_endpoints", etcd_endpoints);
+    }
+    add("worker_type", worker_type);
+    if (worker_type == XFERBENCH_WORKER_NIXL) {
+        add("backend", backend);
+        add("enable_pt", enable_pt);
+        add("device_list", device_list);
+        add("latency_percentiles", latency_percentiles);
+        add("offered_load", offered_load);
+        add("queue_depth", queue_depth);
+        if (IS_FILE_BACKEND()) {
+            add("gds_filepath", gds_filepath);
+            add("gds_enable_direct", gds_enable_direct);
+            add("storage_workload", storage_workload);
+        }
+        if (storage_workload) {
+            add("io_pattern", io_pattern);
+            add("read_ratio", read_ratio);
+            add("num_files", num_files);
+            add("file_size", file_size);
+            add("stripe_size", stripe_size);
+        }
+    }
+    add("initiator_seg_type", initiator_seg_type);
+    add("target_seg_type", target_seg_type);
+    add("scheme", scheme);
+    add("mode", mode);
+    add("op_type", op_type);
+    add("check_consistency", check_consistency);
+    add("total_buffer_size", total_buffer_size);
+    add("num_initiator_dev", num_initiator_dev);
+    add("num_target_dev", num_target_dev);
+    add("start_block_size", start_block_size);
+    add("max_block_size", max_block_size);
+    add("start_batch_size", start_batch_size);
+    add("max_batch_size", max_batch_size);
+    add("num_iter", num_iter);
+    add("warmup_iter", warmup_iter);
+    add("num_threads", num_threads);
+
+    return fields;
+}
+
 std::vector<std::string> xferBenchConfig::parseDeviceList() {
     std::vector<std::string> devices;
     std::string dev;
@@ -294,6 +479,16 @@ std::vector<std::string> xferBenchConfig::parseDeviceList() {
  **********/
 xferBenchRT *xferBenchUtils::rt = nullptr;
 std::string xferBenchUtils::dev_to_use = "";
+std::vector<xferBenchResult> xferBenchUtils::results;
+
+std::optional<double> xferBenchResult::getMetric(const std::string &metric) const {
+    for (const auto &m : metrics) {
+        if (m.first == metric) {
+            return m.second;
+        }
+    }
+    return std::nullopt;
+}
 
 void xferBenchUtils::setRT(xferBenchRT *rt) {
     xferBenchUtils::rt = rt;
@@ -383,13 +578,32 @@ void xferBenchUtils::printStatsHeader() {
                   << std::setw(15) << "Avg Lat. (us)"
                   << std::setw(15) << "B/W (MiB/Sec)"
                   << std::setw(15) << "B/W (GiB/Sec)"
-                  << std::setw(15) << "B/W (GB/Sec)"
-                  << std::endl;
+                  << std::setw(15) << "B/W (GB/Sec)";
+        if (xferBenchConfig::storage_workload) {
+            std::cout << std::setw(15) << "IOPS";
+        }
+        if (xferBenchConfig::latency_percentiles) {
+            std::cout << std::setw(12) << "Min (us)"
+                      << std::setw(12) << "P50 (us)"
+                      << std::setw(12) << "P90 (us)"
+                      << std::setw(12) << "P99 (us)"
+                      << std::setw(12) << "P99.9 (us)"
+                      << std::setw(12) << "Max (us)";
+        }
+        std::cout << std::endl;
     }
     std::cout << std::string(80, '-') << std::endl;
 }
 
-void xferBenchUtils::printStats(size_t block_size, size_t batch_size, double total_duration) {
+// Latency of the iteration at quantile q of the sorted latencies, nearest rank
+static double getPercentile(const std::vector<double> &sorted, double q) {
+    size_t rank = (size_t)std::ceil(q * sorted.size());
+
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+void xferBenchUtils::printStats(size_t block_size, size_t batch_size, double total_duration,
+                                std::vector<double> latencies) {
     size_t total_data_transferred = 0;
     double avg_latency = 0, throughput = 0, throughput_gib = 0, throughput_gb = 0;
     double totalbw = 0;
@@ -436,13 +650,266 @@ void xferBenchUtils::printStats(size_t block_size, size_t batch_size, double tot
                   << std::setw(25) << totalbw
                   << std::setw(20) << (totalbw / (rt->getSize()/2 * MAXBW))*100
                   << std::endl;
+        results.push_back({block_size, batch_size,
+                           {{"avg_lat_us", avg_latency}, {"bw_mib_s", throughput},
+                            {"bw_gib_s", throughput_gib}, {"bw_gb_s", throughput_gb},
+                            {"aggregate_bw_gb_s", totalbw},
+                            {"network_util_pct", (totalbw / (rt->getSize()/2 * MAXBW))*100}}});
     } else {
+        xferBenchResult result{block_size, batch_size,
+                               {{"avg_lat_us", avg_latency}, {"bw_mib_s", throughput},
+                                {"bw_gib_s", throughput_gib}, {"bw_gb_s", throughput_gb}}};
+
         std::cout << std::left << std::setw(20) << block_size
                   << std::setw(15) << batch_size
                   << std::setw(15) << avg_latency
                   << std::setw(15) << throughput
                   << std::setw(15) << throughput_gib
-                  << std::setw(15) << throughput_gb
-                  << std::endl;
+                  << std::setw(15) << throughput_gb;
+        if (xferBenchConfig::storage_workload) {
+            // Each iteration is one IO of the batch
+            std::cout << std::setw(15) << (num_iter / (total_duration / 1e6));
+            result.metrics.emplace_back("iops", num_iter / (total_duration / 1e6));
+        }
+        if (xferBenchConfig::latency_percentiles && !latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << std::setw(12) << latencies.front()
+                      << std::setw(12) << getPercentile(latencies, 0.5)
+                      << std::setw(12) << getPercentile(latencies, 0.9)
+                      << std::setw(12) << getPercentile(latencies, 0.99)
+                      << std::setw(12) << getPercentile(latencies, 0.999)
+                      << std::setw(12) << latencies.back();
+            result.metrics.insert(result.metrics.end(),
+                                  {{"lat_min_us", latencies.front()},
+                                   {"lat_p50_us", getPercentile(latencies, 0.5)},
+                                   {"lat_p90_us", getPercentile(latencies, 0.9)},
+                                   {"lat_p99_us", getPercentile(latencies, 0.99)},
+                                   {"lat_p99_9_us", getPercentile(latencies, 0.999)},
+                                   {"lat_max_us", latencies.back()}});
+        }
+        std::cout << std::endl;
+        results.push_back(std::move(result));
+    }
+}
+
+static std::string jsonString(const std::string &str) {
+    std::string out = "\"";
+
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+// Non finite values, e.g. rates of runs too short to time, are left out as null
+static std::string jsonNumber(double value) {
+    std::ostringstream ss;
+
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    ss << std::setprecision(10) << value;
+    return ss.str();
+}
+
+int xferBenchUtils::writeResults() {
+    if (xferBenchConfig::output_file == "" || results.empty()) {
+        return 0;
+    }
+
+    std::ofstream out(xferBenchConfig::output_file);
+    if (!out) {
+        std::cerr << "Failed to open output file " << xferBenchConfig::output_file << std::endl;
+        return -1;
+    }
+
+    auto config = xferBenchConfig::getConfigFields();
+
+    if (xferBenchConfig::output_format == XFERBENCH_OUTPUT_JSON) {
+        // One result per line, as read back by loadResults
+        out << "{\n  \"config\": {";
+        for (size_t i = 0; i < config.size(); i++) {
+            out << (i ? ",\n    " : "\n    ") << jsonString(config[i].first) << ": "
+                << jsonString(config[i].second);
+        }
+        out << "\n  },\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            out << (i ? ",\n    " : "\n    ") << "{\"block_size\": " << results[i].block_size
+                << ", \"batch_size\": " << results[i].batch_size;
+            for (const auto &m : results[i].metrics) {
+                out << ", " << jsonString(m.first) << ": " << jsonNumber(m.second);
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    } else {
+        // The configuration is in comment lines ahead of the header
+        for (const auto &field : config) {
+            out << "# " << field.first << "=" << field.second << "\n";
+        }
+        out << "block_size,batch_size";
+        for (const auto &m : results[0].metrics) {
+            out << "," << m.first;
+        }
+        out << "\n";
+        for (const auto &result : results) {
+            out << result.block_size << "," << result.batch_size;
+            for (const auto &m : result.metrics) {
+                out << "," << (std::isfinite(m.second) ? jsonNumber(m.second) : "");
+            }
+            out << "\n";
+        }
+    }
+
+    if (!out) {
+        std::cerr << "Failed to write output file " << xferBenchConfig::output_file << std::endl;
+        return -1;
     }
+    return 0;
+}
+
+static xferBenchResult makeResult(const std::vector<std::pair<std::string, double>> &values) {
+    xferBenchResult result{0, 0, {}};
+
+    for (const auto &v : values) {
+        if (v.first == "block_size") {
+            result.block_size = (size_t)v.second;
+        } else if (v.first == "batch_size") {
+            result.batch_size = (size_t)v.second;
+        } else {
+            result.metrics.push_back(v);
+        }
+    }
+    return result;
+}
+
+// Reads a result file written by writeResults, in either format
+static int loadResults(const std::string &path, std::vector<xferBenchResult> &loaded) {
+    std::ifstream in(path);
+    std::string line;
+    std::vector<std::string> header;
+    bool json = false, first = true;
+
+    if (!in) {
+        std::cerr << "Failed to open baseline file " << path << std::endl;
+        return -1;
+    }
+
+    while (std::getline(in, line)) {
+        if (first) {
+            size_t pos = line.find_first_not_of(" \t");
+            json = (pos != std::string::npos) && (line[pos] == '{');
+            first = false;
+        }
+
+        if (json) {
+            static const std::regex field("\"([a-z0-9_]+)\": (-?[0-9][0-9.eE+-]*)");
+            std::vector<std::pair<std::string, double>> values;
+
+            if (line.find("\"block_size\"") == std::string::npos) {
+                continue;
+            }
+            for (std::sregex_iterator it(line.begin(), line.end(), field), end; it != end; ++it) {
+                values.emplace_back((*it)[1], std::stod((*it)[2]));
+            }
+            loaded.push_back(makeResult(values));
+        } else if (!line.empty() && line[0] != '#') {
+            std::vector<std::string> cells;
+            std::stringstream ss(line);
+            std::string cell;
+
+            while (std::getline(ss, cell, ',')) {
+                cells.push_back(cell);
+            }
+            if (header.empty()) {
+                header = cells;
+                continue;
+            }
+
+            std::vector<std::pair<std::string, double>> values;
+            for (size_t i = 0; i < cells.size() && i < header.size(); i++) {
+                if (!cells[i].empty()) {
+                    values.emplace_back(header[i], std::stod(cells[i]));
+                }
+            }
+            loaded.push_back(makeResult(values));
+        }
+    }
+
+    if (loaded.empty()) {
+        std::cerr << "No results in baseline file " << path << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+int xferBenchUtils::compareBaseline() {
+    // Metrics compared, and whether higher values are better
+    static const std::vector<std::pair<std::string, bool>> compared = {
+        {"bw_gb_s", true}, {"aggregate_bw_gb_s", true}, {"iops", true},
+        {"lat_p50_us", false}, {"lat_p99_us", false}
+    };
+    std::vector<xferBenchResult> base_results;
+    int regressions = 0, total = 0;
+
+    if (xferBenchConfig::baseline == "" || results.empty()) {
+        return 0;
+    }
+    if (loadResults(xferBenchConfig::baseline, base_results) < 0) {
+        return -1;
+    }
+
+    std::cout << std::endl << "Comparison with baseline " << xferBenchConfig::baseline
+              << " (threshold " << xferBenchConfig::regression_threshold << "%)" << std::endl;
+    std::cout << std::left << std::setw(20) << "Block Size (B)"
+              << std::setw(15) << "Batch Size"
+              << std::setw(20) << "Metric"
+              << std::setw(15) << "Baseline"
+              << std::setw(15) << "Current"
+              << std::setw(15) << "Change (%)"
+              << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (const auto &result : results) {
+        auto base = std::find_if(base_results.begin(), base_results.end(),
+                                 [&result](const xferBenchResult &b) {
+                                     return b.block_size == result.block_size &&
+                                            b.batch_size == result.batch_size;
+                                 });
+        if (base == base_results.end()) {
+            continue;
+        }
+
+        for (const auto &[metric, higher_better] : compared) {
+            auto current = result.getMetric(metric);
+            auto previous = base->getMetric(metric);
+            if (!current || !previous || *previous == 0 ||
+                !std::isfinite(*current) || !std::isfinite(*previous)) {
+                continue;
+            }
+
+            double change = ((*current - *previous) / *previous) * 100;
+            bool regressed = higher_better ? (change < -xferBenchConfig::regression_threshold) :
+                                             (change > xferBenchConfig::regression_threshold);
+
+            total++;
+            if (regressed) {
+                regressions++;
+            }
+            std::cout << std::left << std::setw(20) << result.block_size
+                      << std::setw(15) << result.batch_size
+                      << std::setw(20) << metric
+                      << std::setw(15) << *previous
+                      << std::setw(15) << *current
+                      << std::setw(15) << change
+                      << (regressed ? "REGRESSION" : "")
+                      << std::endl;
+        }
+    }
+
+    std::cout << regressions << " of " << total << " compared metrics regressed" << std::endl;
+    return regressions;
 }
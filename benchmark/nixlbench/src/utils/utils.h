@@ -25,6 +25,7 @@
 #include <variant>
 #include <vector>
 #include <optional>
+#include <utility>
 #include "runtime/runtime.h"
 
 #if HAVE_CUDA
@@ -67,17 +68,27 @@
 #define XFERBENCH_BACKEND_UCX "UCX"
 #define XFERBENCH_BACKEND_UCX_MO "UCX_MO"
 #define XFERBENCH_BACKEND_GDS "GDS"
+#define XFERBENCH_BACKEND_POSIX "POSIX"
 
 // Scheme types for transfer patterns
 #define XFERBENCH_SCHEME_PAIRWISE     "pairwise"
 #define XFERBENCH_SCHEME_ONE_TO_MANY  "onetomany"
 #define XFERBENCH_SCHEME_MANY_TO_ONE  "manytoone"
 #define XFERBENCH_SCHEME_TP           "tp"
+#define XFERBENCH_SCHEME_MANY_TO_MANY "manytomany"
 
 // Operation types
 #define XFERBENCH_OP_READ  "READ"
 #define XFERBENCH_OP_WRITE "WRITE"
 
+// IO patterns of the storage workload
+#define XFERBENCH_IO_PATTERN_SEQ    "seq"
+#define XFERBENCH_IO_PATTERN_RANDOM "random"
+
+// Output formats of the result file
+#define XFERBENCH_OUTPUT_JSON "json"
+#define XFERBENCH_OUTPUT_CSV  "csv"
+
 // Mode types
 #define XFERBENCH_MODE_SG  "SG"
 #define XFERBENCH_MODE_MG  "MG"
@@ -90,6 +101,10 @@
 #define XFERBENCH_WORKER_NIXL     "nixl"
 #define XFERBENCH_WORKER_NVSHMEM  "nvshmem"
 
+// Backends transferring between local memory and files of the initiator
+#define IS_FILE_BACKEND() (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend || \
+                           XFERBENCH_BACKEND_POSIX == xferBenchConfig::backend)
+
 #define IS_PAIRWISE_AND_SG() (XFERBENCH_SCHEME_PAIRWISE == xferBenchConfig::scheme && \
                               XFERBENCH_MODE_SG == xferBenchConfig::mode)
 class xferBenchConfig {
@@ -118,9 +133,24 @@ class xferBenchConfig {
         static std::string etcd_endpoints;
         static std::string gds_filepath;
         static bool gds_enable_direct;
+        static bool latency_percentiles;
+        static uint64_t offered_load;
+        static int queue_depth;
+        static bool storage_workload;
+        static std::string io_pattern;
+        static int read_ratio;
+        static int num_files;
+        static size_t file_size;
+        static size_t stripe_size;
+        static std::string output_file;
+        static std::string output_format;
+        static std::string baseline;
+        static double regression_threshold;
 
         static int loadFromFlags();
         static void printConfig();
+        // Printed configuration as flag name and value pairs, for the result file
+        static std::vector<std::pair<std::string, std::string>> getConfigFields();
         static std::vector<std::string> parseDeviceList();
 };
 
@@ -134,10 +164,22 @@ public:
     xferBenchIOV(uintptr_t a, size_t l, int d) : addr(a), len(l), devId(d) {}
 };
 
+// Printed statistics of one block and batch size
+class xferBenchResult {
+public:
+    size_t block_size;
+    size_t batch_size;
+    std::vector<std::pair<std::string, double>> metrics;
+
+    std::optional<double> getMetric(const std::string &metric) const;
+};
+
 class xferBenchUtils {
     private:
         static xferBenchRT *rt;
         static std::string dev_to_use;
+        // Of the lines printed by printStats, for the result file and the baseline
+        static std::vector<xferBenchResult> results;
     public:
         static void setRT(xferBenchRT *rt);
         static void setDevToUse(std::string dev);
@@ -146,7 +188,14 @@ class xferBenchUtils {
         static void checkConsistency(std::vector<std::vector<xferBenchIOV>> &desc_lists);
         static void printStatsHeader();
         static void printStats(size_t block_size, size_t batch_size,
-			                   double total_duration);
+			                   double total_duration,
+                               std::vector<double> latencies = {});
+
+        // Writes the configuration and results to output_file, if set
+        static int writeResults();
+        // Compares the results with the baseline file, if set, and returns the number of
+        // regressions beyond regression_threshold, or -1 on error
+        static int compareBaseline();
 };
 
 #endif // __UTILS_H
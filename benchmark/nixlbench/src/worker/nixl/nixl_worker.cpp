@@ -16,6 +16,7 @@
  */
 
 #include "worker/nixl/nixl_worker.h"
+#include <chrono>
 #include <cstring>
 #if HAVE_CUDA
 #include <cuda.h>
@@ -24,6 +25,7 @@
 #include <fcntl.h>
 #include <filesystem>
 #include <iomanip>
+#include <random>
 #include <sstream>
 #include "utils/utils.h"
 #include <unistd.h>
@@ -38,6 +40,8 @@
 static uintptr_t gds_running_ptr = 0x0;
 static int gds_remote_fd = -1;
 static std::vector<std::vector<xferBenchIOV>> gds_remote_iovs;
+// Files of the storage workload, registered whole
+static std::vector<int> storage_fds;
 
 #if HAVE_CUDA
 static size_t __attribute__((unused)) padded_size = 0;
@@ -101,7 +105,7 @@ xferBenchNixlWorker::xferBenchNixlWorker(int *argc, char ***argv, std::vector<st
 
     if (0 == xferBenchConfig::backend.compare(XFERBENCH_BACKEND_UCX) ||
         0 == xferBenchConfig::backend.compare(XFERBENCH_BACKEND_UCX_MO) ||
-        0 == xferBenchConfig::backend.compare(XFERBENCH_BACKEND_GDS)){
+        IS_FILE_BACKEND()) {
         backend_name = xferBenchConfig::backend;
     } else {
         std::cerr << "Unsupported backend: " << xferBenchConfig::backend << std::endl;
@@ -136,9 +140,9 @@ xferBenchNixlWorker::xferBenchNixlWorker(int *argc, char ***argv, std::vector<st
         std::cout << "Init nixl worker, dev " << (("all" == devices[0]) ? "all" : backend_params["device_list"])
                   << " rank " << rank << ", type " << name << ", hostname "
                   << hostname << std::endl;
-    } else if (0 == xferBenchConfig::backend.compare(XFERBENCH_BACKEND_GDS)) {
-        // Using default param values for GDS backend
-        std::cout << "GDS backend" << std::endl;
+    } else if (IS_FILE_BACKEND()) {
+        // Using default param values for file backends
+        std::cout << xferBenchConfig::backend << " backend" << std::endl;
     } else {
         std::cerr << "Unsupported backend: " << xferBenchConfig::backend << std::endl;
         exit(EXIT_FAILURE);
@@ -358,7 +362,21 @@ std::vector<std::vector<xferBenchIOV>> xferBenchNixlWorker::allocateMemory(int n
 
     opt_args.backends.push_back(backend_engine);
 
-    if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+    if (xferBenchConfig::storage_workload) {
+        nixl_reg_dlist_t desc_list(FILE_SEG);
+
+        for (int f = 0; f < xferBenchConfig::num_files; f++) {
+            int fd = createGdsFile(getName() + "_" + std::to_string(f));
+            if (fd < 0 || ftruncate(fd, xferBenchConfig::file_size) < 0) {
+                std::cerr << "Failed to create storage workload file" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            desc_list.addDesc(nixlBlobDesc(0, xferBenchConfig::file_size, fd));
+            storage_fds.push_back(fd);
+        }
+        CHECK_NIXL_ERROR(agent->registerMem(desc_list, &opt_args),
+                         "registerMem failed");
+    } else if (IS_FILE_BACKEND()) {
         gds_remote_fd = createGdsFile(getName());
         if (gds_remote_fd < 0) {
             std::cerr << "Failed to create GDS file" << std::endl;
@@ -444,7 +462,19 @@ void xferBenchNixlWorker::deallocateMemory(std::vector<std::vector<xferBenchIOV>
                          "deregisterMem failed");
     }
 
-    if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+    if (xferBenchConfig::storage_workload) {
+        nixl_reg_dlist_t desc_list(FILE_SEG);
+
+        for (int fd : storage_fds) {
+            desc_list.addDesc(nixlBlobDesc(0, xferBenchConfig::file_size, fd));
+        }
+        CHECK_NIXL_ERROR(agent->deregisterMem(desc_list, &opt_args),
+                         "deregisterMem failed");
+        for (int fd : storage_fds) {
+            close(fd);
+        }
+        storage_fds.clear();
+    } else if (IS_FILE_BACKEND()) {
         for (auto &iov_list: gds_remote_iovs) {
             for (auto &iov: iov_list) {
                 cleanupBasicDescFile(iov);
@@ -460,7 +490,7 @@ void xferBenchNixlWorker::deallocateMemory(std::vector<std::vector<xferBenchIOV>
 int xferBenchNixlWorker::exchangeMetadata() {
     int meta_sz, ret = 0;
 
-    if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+    if (IS_FILE_BACKEND()) {
         return 0;
     }
 
@@ -515,7 +545,7 @@ xferBenchNixlWorker::exchangeIOV(const std::vector<std::vector<xferBenchIOV>> &l
     int desc_str_sz;
 
     // Special case for GDS
-    if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+    if (IS_FILE_BACKEND()) {
         for (auto &iov_list: local_iovs) {
             std::vector<xferBenchIOV> remote_iov_list;
             for (auto &iov: iov_list) {
@@ -578,12 +608,101 @@ xferBenchNixlWorker::exchangeIOV(const std::vector<std::vector<xferBenchIOV>> &l
     return res;
 }
 
+static double elapsedUs(const std::chrono::steady_clock::time_point &start,
+                        const std::chrono::steady_clock::time_point &end) {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Posts each request once done, latencies are from its post to completion
+static bool postBackToBack(nixlAgent *agent, nixlXferReqH *req, const int num_iter,
+                           std::vector<double> *latencies) {
+    nixl_status_t rc;
+
+    for (int i = 0; i < num_iter; i++) {
+        auto start = std::chrono::steady_clock::now();
+        rc = agent->postXferReq(req);
+        if (NIXL_ERR_BACKEND == rc) {
+            std::cout << "NIXL postRequest failed" << std::endl;
+            return false;
+        }
+        do {
+            /* XXX agent isn't const because the getXferStatus() is not const  */
+            rc = agent->getXferStatus(req);
+            if (NIXL_ERR_BACKEND == rc) {
+                std::cout << "NIXL getStatus failed" << std::endl;
+                return false;
+            }
+        } while (NIXL_SUCCESS != rc);
+        if (latencies) {
+            latencies->push_back(elapsedUs(start, std::chrono::steady_clock::now()));
+        }
+    }
+    return true;
+}
+
+// Keeps depth posts in flight. With as many requests as depth, each is reposted once
+// done, and with more, they are posted once each in turn. With offered_load, posts
+// are made at fixed intervals and latencies are from the time a post was scheduled at,
+// so posts delayed by requests still in flight count their wait. Otherwise they are
+// from the post to completion.
+static bool postQueued(nixlAgent *agent, const std::vector<nixlXferReqH *> &reqs,
+                       const size_t depth, const int num_iter, std::vector<double> *latencies) {
+    const uint64_t offered_load = xferBenchConfig::offered_load;
+    const auto interval = offered_load ?
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>(1.0 / offered_load)) :
+                          std::chrono::steady_clock::duration::zero();
+    std::vector<std::chrono::steady_clock::time_point> scheduled(depth);
+    std::vector<nixlXferReqH *> inflight(depth, nullptr);
+    auto next = std::chrono::steady_clock::now();
+    int posted = 0, done = 0;
+    nixl_status_t rc;
+
+    while (done < num_iter) {
+        auto now = std::chrono::steady_clock::now();
+
+        for (size_t r = 0; r < depth; r++) {
+            if (inflight[r]) {
+                rc = agent->getXferStatus(inflight[r]);
+                if (NIXL_ERR_BACKEND == rc) {
+                    std::cout << "NIXL getStatus failed" << std::endl;
+                    return false;
+                }
+                if (NIXL_SUCCESS == rc) {
+                    inflight[r] = nullptr;
+                    done++;
+                    if (latencies) {
+                        latencies->push_back(elapsedUs(scheduled[r],
+                                                       std::chrono::steady_clock::now()));
+                    }
+                }
+            }
+
+            if (!inflight[r] && (posted < num_iter) && (!offered_load || (now >= next))) {
+                nixlXferReqH *req = (reqs.size() > depth) ? reqs[posted] : reqs[r];
+
+                scheduled[r] = offered_load ? next : std::chrono::steady_clock::now();
+                rc = agent->postXferReq(req);
+                if (NIXL_ERR_BACKEND == rc) {
+                    std::cout << "NIXL postRequest failed" << std::endl;
+                    return false;
+                }
+                inflight[r] = req;
+                next += interval;
+                posted++;
+            }
+        }
+    }
+    return true;
+}
+
 static int execTransfer(nixlAgent *agent,
                         const std::vector<std::vector<xferBenchIOV>> &local_iovs,
                         const std::vector<std::vector<xferBenchIOV>> &remote_iovs,
                         const nixl_xfer_op_t op,
                         const int num_iter,
-                        const int num_threads)
+                        const int num_threads,
+                        std::vector<double> *latencies)
 {
     int ret = 0;
 
@@ -597,7 +716,7 @@ static int execTransfer(nixlAgent *agent,
         nixl_xfer_dlist_t local_desc(GET_SEG_TYPE(true));
         nixl_xfer_dlist_t remote_desc(GET_SEG_TYPE(false));
 
-        if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+        if (IS_FILE_BACKEND()) {
             remote_desc = nixl_xfer_dlist_t(FILE_SEG);
         }
 
@@ -606,11 +725,11 @@ static int execTransfer(nixlAgent *agent,
 
         nixl_opt_args_t params;
         bool error = false;
-        nixlXferReqH *req;
-        nixl_status_t rc;
         std::string target;
+        std::vector<double> thread_latencies;
+        std::vector<double> *lat = latencies ? &thread_latencies : nullptr;
 
-        if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+        if (IS_FILE_BACKEND()) {
             target = "initiator";
         } else {
             params.notifMsg = "0xBEEF";
@@ -618,32 +737,143 @@ static int execTransfer(nixlAgent *agent,
             target = "target";
         }
 
-        CHECK_NIXL_ERROR(agent->createXferReq(op, local_desc, remote_desc, target,
-                                            req, &params), "createTransferReq failed");
+        // Requests over the same buffers, to keep queue_depth posts in flight
+        std::vector<nixlXferReqH *> reqs(xferBenchConfig::queue_depth);
+        for (auto &req : reqs) {
+            CHECK_NIXL_ERROR(agent->createXferReq(op, local_desc, remote_desc, target,
+                                                req, &params), "createTransferReq failed");
+        }
 
-        for (int i = 0; i < num_iter && !error; i++) {
-            rc = agent->postXferReq(req);
-            if (NIXL_ERR_BACKEND == rc) {
-                std::cout << "NIXL postRequest failed" << std::endl;
-                error = true;
-            } else {
-                do {
-                    /* XXX agent isn't const because the getXferStatus() is not const  */
-                    rc = agent->getXferStatus(req);
-                    if (NIXL_ERR_BACKEND == rc) {
-                        std::cout << "NIXL getStatus failed" << std::endl;
-                        error = true;
-                        break;
-                    }
-                } while (NIXL_SUCCESS != rc);
+        if (lat) {
+            lat->reserve(num_iter);
+        }
+        if (xferBenchConfig::offered_load || (reqs.size() > 1)) {
+            error = !postQueued(agent, reqs, reqs.size(), num_iter, lat);
+        } else {
+            error = !postBackToBack(agent, reqs[0], num_iter, lat);
+        }
+
+        for (auto &req : reqs) {
+            agent->releaseXferReq(req);
+        }
+        if (error) {
+            std::cout << "NIXL releaseXferReq failed" << std::endl;
+            ret = -1;
+        }
+
+        if (latencies) {
+            #pragma omp critical
+            latencies->insert(latencies->end(), thread_latencies.begin(),
+                              thread_latencies.end());
+        }
+    }
+
+    return ret;
+}
+
+// Adds the transfer of len bytes at local_addr to offset of the files of the storage
+// workload, split where it crosses from a stripe or file to the next
+static void addStorageRange(uintptr_t local_addr, int local_dev, size_t offset, size_t len,
+                            nixl_xfer_dlist_t &local_desc, nixl_xfer_dlist_t &remote_desc) {
+    const size_t stripe = xferBenchConfig::stripe_size ? xferBenchConfig::stripe_size :
+                                                         xferBenchConfig::file_size;
+
+    while (len) {
+        size_t unit = offset / stripe;
+        size_t in_unit = offset % stripe;
+        size_t piece = std::min(len, stripe - in_unit);
+        size_t file_offset = (unit / storage_fds.size()) * stripe + in_unit;
+
+        local_desc.addDesc(nixlBasicDesc(local_addr, piece, local_dev));
+        remote_desc.addDesc(nixlBasicDesc(file_offset, piece, storage_fds[unit % storage_fds.size()]));
+        local_addr += piece;
+        offset += piece;
+        len -= piece;
+    }
+}
+
+// Each thread makes num_iter IOs over its part of the files, of the local descriptors
+// of the thread to consecutive offsets, sequential or random. The IOs are created up
+// front and posted once each, queue_depth of them in flight, and the duration of
+// the posts is returned.
+static int execStorageTransfer(nixlAgent *agent,
+                               const std::vector<std::vector<xferBenchIOV>> &local_iovs,
+                               const nixl_xfer_op_t op,
+                               const int num_iter,
+                               const int num_threads,
+                               const unsigned seed,
+                               double *duration,
+                               std::vector<double> *latencies)
+{
+    std::chrono::steady_clock::time_point t_start;
+    int ret = 0;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        const int tid = omp_get_thread_num();
+        const auto &local_iov = local_iovs[tid];
+        const size_t span = (storage_fds.size() * xferBenchConfig::file_size) / num_threads;
+        std::mt19937_64 rng(seed + tid);
+        size_t io_bytes = 0;
+
+        for (const auto &iov : local_iov) {
+            io_bytes += iov.len;
+        }
+
+        const size_t slots = span / io_bytes;
+        std::vector<nixlXferReqH *> reqs(num_iter, nullptr);
+        std::vector<double> thread_latencies;
+        std::vector<double> *lat = latencies ? &thread_latencies : nullptr;
+        nixl_opt_args_t params;
+        bool error = false;
+
+        for (int i = 0; i < num_iter; i++) {
+            nixl_xfer_dlist_t local_desc(GET_SEG_TYPE(true));
+            nixl_xfer_dlist_t remote_desc(FILE_SEG);
+            nixl_xfer_op_t io_op = op;
+            size_t slot = (XFERBENCH_IO_PATTERN_RANDOM == xferBenchConfig::io_pattern) ?
+                          (rng() % slots) : (i % slots);
+            size_t offset = tid * span + slot * io_bytes;
+
+            if (xferBenchConfig::read_ratio >= 0) {
+                io_op = ((int)(rng() % 100) < xferBenchConfig::read_ratio) ? NIXL_READ : NIXL_WRITE;
+            }
+
+            for (const auto &iov : local_iov) {
+                addStorageRange(iov.addr, iov.devId, offset, iov.len, local_desc, remote_desc);
+                offset += iov.len;
             }
+
+            CHECK_NIXL_ERROR(agent->createXferReq(io_op, local_desc, remote_desc, "initiator",
+                                                reqs[i], &params), "createTransferReq failed");
+        }
+
+        if (lat) {
+            lat->reserve(num_iter);
         }
 
-        agent->releaseXferReq(req);
+        // Timed from when all the threads created their IOs
+        #pragma omp barrier
+        #pragma omp master
+        t_start = std::chrono::steady_clock::now();
+        error = !postQueued(agent, reqs, xferBenchConfig::queue_depth, num_iter, lat);
+        #pragma omp barrier
+        #pragma omp master
+        *duration = elapsedUs(t_start, std::chrono::steady_clock::now());
+
+        for (auto &req : reqs) {
+            agent->releaseXferReq(req);
+        }
         if (error) {
             std::cout << "NIXL releaseXferReq failed" << std::endl;
             ret = -1;
         }
+
+        if (latencies) {
+            #pragma omp critical
+            latencies->insert(latencies->end(), thread_latencies.begin(),
+                              thread_latencies.end());
+        }
     }
 
     return ret;
@@ -666,14 +896,31 @@ std::variant<double, int> xferBenchNixlWorker::transfer(size_t block_size,
         num_iter /= LARGE_BLOCK_SIZE_ITER_FACTOR;
     }
 
-    ret = execTransfer(agent, local_iovs, remote_iovs, xfer_op, skip, xferBenchConfig::num_threads);
+    if (xferBenchConfig::storage_workload) {
+        // Timed without the creation of the IOs, which have their offsets set up front
+        ret = execStorageTransfer(agent, local_iovs, xfer_op, skip, xferBenchConfig::num_threads,
+                                  0, &total_duration, nullptr);
+        if (ret < 0) {
+            return std::variant<double, int>(ret);
+        }
+
+        latencies.clear();
+        ret = execStorageTransfer(agent, local_iovs, xfer_op, num_iter, xferBenchConfig::num_threads,
+                                  block_size, &total_duration, &latencies);
+        return ret < 0 ? std::variant<double, int>(ret) : std::variant<double, int>(total_duration);
+    }
+
+    ret = execTransfer(agent, local_iovs, remote_iovs, xfer_op, skip, xferBenchConfig::num_threads,
+                       nullptr);
     if (ret < 0) {
         return std::variant<double, int>(ret);
     }
 
+    latencies.clear();
     gettimeofday(&t_start, nullptr);
 
-    ret = execTransfer(agent, local_iovs, remote_iovs, xfer_op, num_iter, xferBenchConfig::num_threads);
+    ret = execTransfer(agent, local_iovs, remote_iovs, xfer_op, num_iter, xferBenchConfig::num_threads,
+                       xferBenchConfig::latency_percentiles ? &latencies : nullptr);
 
     gettimeofday(&t_end, nullptr);
     total_duration += (((t_end.tv_sec - t_start.tv_sec) * 1e6) +
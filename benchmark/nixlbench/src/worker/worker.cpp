@@ -26,7 +26,7 @@ static xferBenchRT *createRT(int *argc, char ***argv) {
             total = xferBenchConfig::num_initiator_dev +
                 xferBenchConfig::num_target_dev;
         }
-        if (XFERBENCH_BACKEND_GDS == xferBenchConfig::backend) {
+        if (IS_FILE_BACKEND()) {
             total = 1;
         }
         return new xferBenchEtcdRT(xferBenchConfig::etcd_endpoints, total);
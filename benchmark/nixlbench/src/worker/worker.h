@@ -29,6 +29,8 @@ class xferBenchWorker {
     protected:
         std::string name;
         xferBenchRT *rt;
+        // Post to completion latency in us of each iteration of the last transfer
+        std::vector<double> latencies;
     public:
         xferBenchWorker(int *argc, char ***argv);
         virtual ~xferBenchWorker();
@@ -36,6 +38,7 @@ class xferBenchWorker {
         std::string getName() const;
         bool isInitiator();
         bool isTarget();
+        const std::vector<double> &getLatencies() const { return latencies; }
 
         // Memory management
         virtual std::vector<std::vector<xferBenchIOV>> allocateMemory(int num_threads) = 0;
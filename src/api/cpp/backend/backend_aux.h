@@ -33,11 +33,63 @@ class nixlBackendOptionalArgs {
         // During postXfer, user might ask for a notification if supported
         nixl_blob_t notifMsg;
         bool        hasNotif = false;
+
+        // During postXfer, if set and supportsXferCompletion is true, the backend
+        // reports the completion of an in progress transfer to its completion
+        // sink with this context.
+        void*       completionCtx = nullptr;
+
+        // During postXfer, the CUDA stream to enqueue the transfer on and the
+        // CUDA event to record after it, for stream-ordered backends
+        void*       cudaStream = nullptr;
+        void*       cudaEvent  = nullptr;
+
+        // During prepXfer and postXfer, the priority class of the transfer, which
+        // the backend can map to separate endpoints or service levels
+        nixl_xfer_priority_t priority = nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
 };
 
 typedef nixlBackendOptionalArgs nixl_opt_b_args_t;
 
 
+// Rough performance of a backend for a pair of memory types, used by
+// the agent to rank candidates and reported to applications.
+typedef nixlXferHints nixlBackendXferHints;
+
+// Set by the agent, so backends can report completed transfers as they
+// find them, possibly from their own progress thread.
+class nixlBackendCompletionSink {
+    public:
+        virtual void xferDone(void* completion_ctx, nixl_status_t status) = 0;
+        virtual ~nixlBackendCompletionSink() { }
+};
+
+class nixlBackendEngine;
+class nixlBackendInitParams;
+
+// Set by the agent, so a backend can create engines of other backends,
+// e.g. to wrap one. Engines are created from the loaded plugins.
+class nixlBackendFactory {
+    public:
+        virtual nixlBackendEngine* createEngine(const nixlBackendInitParams* init_params) = 0;
+        virtual void destroyEngine(nixlBackendEngine* engine) = 0;
+        virtual ~nixlBackendFactory() { }
+};
+
+// Set by the agent when one agent thread progresses all of its engines, instead
+// of each starting a progress thread. Engines that would start one add themselves,
+// and progressRound is called from that thread until they are removed.
+class nixlProgressDriver {
+    public:
+        virtual void addEngine(nixlBackendEngine* engine) = 0;
+        // Returns after any round of the engine in progress
+        virtual void removeEngine(nixlBackendEngine* engine) = 0;
+        // Called after queueing work, in case the thread is waiting
+        virtual void wake() = 0;
+        virtual bool isProgressThread() const = 0;
+        virtual ~nixlProgressDriver() { }
+};
+
 // A base class to point to backend initialization data
 // User doesn't know about fields such as local_agent but can access it
 // after the backend is initialized by agent. If we needed to make it private
@@ -51,6 +103,10 @@ class nixlBackendInitParams {
 
         bool              enableProgTh;
         nixlTime::us_t    pthrDelay;
+
+        nixlBackendFactory* factory = nullptr;
+        // Only set with enableProgTh, when the agent runs the progress thread
+        nixlProgressDriver* progressDriver = nullptr;
 };
 
 // Pure virtual class to have a common pointer type
@@ -109,6 +165,25 @@ class nixlMetaDesc : public nixlBasicDesc {
         }
 };
 
+// Transfers of a few descriptors are prepared without allocating their lists
+template<>
+struct nixlDescInline<nixlMetaDesc> { static constexpr size_t value = 4; };
+
 typedef nixlDescList<nixlMetaDesc> nixl_meta_dlist_t;
 
+// Arguments of a single transfer within a batch passed to postXfers.
+// The status field is filled by the backend, similar to postXfer return.
+class nixlBackendXferArgs {
+    public:
+        nixl_xfer_op_t           operation;
+        const nixl_meta_dlist_t* local;
+        const nixl_meta_dlist_t* remote;
+        const std::string*       remoteAgent;
+        nixlBackendReqH*         handle;
+        nixl_opt_b_args_t        optArgs;
+        nixl_status_t            status;
+};
+
+typedef std::vector<nixlBackendXferArgs> nixl_b_xfer_batch_t;
+
 #endif
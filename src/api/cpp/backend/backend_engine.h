@@ -19,6 +19,7 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 #include "nixl_types.h"
 #include "backend_aux.h"
 
@@ -34,6 +35,9 @@ class nixlBackendEngine {
         bool              initErr;
         const std::string localAgent;
 
+        // Where to report transfers posted with a completionCtx, can be null
+        nixlBackendCompletionSink* completionSink = nullptr;
+
         nixl_status_t setInitParam(const std::string &key, const std::string &value) {
             if (customParams->count(key)==0) {
                 (*customParams)[key] = value;
@@ -66,6 +70,7 @@ class nixlBackendEngine {
         }
 
         bool getInitErr() { return initErr; }
+        void setCompletionSink(nixlBackendCompletionSink* sink) { completionSink = sink; }
         nixl_backend_t getType () const { return backendType; }
         nixl_b_params_t getCustomParams () const { return *customParams; }
 
@@ -87,6 +92,35 @@ class nixlBackendEngine {
 
         virtual nixl_mem_list_t getSupportedMems () const = 0;
 
+        // Determines if a backend reports completion of transfers to completionSink by
+        // itself, instead of the agent polling checkXfer. Not required to be implemented.
+        virtual bool supportsXferCompletion () const { return false; }
+
+        // Determines if loadRemoteMD can be called from several threads at once, and while
+        // other threads prepare or post transfers. Not required to be implemented.
+        virtual bool supportsConcurrentLoad () const { return false; }
+
+        // Determines if registerMem and deregisterMem can be called from several threads
+        // at once, and while other threads use the engine. Not required to be implemented.
+        virtual bool supportsConcurrentReg () const { return false; }
+
+        // Performance hints for transfers between the local and remote memory types.
+        // Backends without hints, or not supporting the pair, are ranked last.
+        virtual nixl_status_t getXferHints (const nixl_mem_t &local_mem,
+                                            const nixl_mem_t &remote_mem,
+                                            nixlBackendXferHints &hints) const {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
+        // Hints for transfers with a specific remote agent, e.g. probed when connecting
+        // to it. Defaults to the hints of the memory types.
+        virtual nixl_status_t getPeerXferHints (const nixl_mem_t &local_mem,
+                                                const nixl_mem_t &remote_mem,
+                                                const std::string &remote_agent,
+                                                nixlBackendXferHints &hints) const {
+            return getXferHints(local_mem, remote_mem, hints);
+        }
+
 
         // *** Pure virtual methods that need to be implemented by any backend *** //
 
@@ -102,6 +136,20 @@ class nixlBackendEngine {
         virtual nixl_status_t connect(const std::string &remote_agent) = 0;
         virtual nixl_status_t disconnect(const std::string &remote_agent) = 0;
 
+        // Connecting to several agents at once, status of each is set in statuses and the
+        // first error is returned. Backends can override it to overlap the connections.
+        virtual nixl_status_t connectAgents(const std::vector<std::string> &remote_agents,
+                                            std::vector<nixl_status_t> &statuses) {
+            nixl_status_t ret = NIXL_SUCCESS;
+            statuses.resize(remote_agents.size());
+            for (size_t i = 0; i < remote_agents.size(); ++i) {
+                statuses[i] = connect(remote_agents[i]);
+                if ((statuses[i] < 0) && (ret == NIXL_SUCCESS))
+                    ret = statuses[i];
+            }
+            return ret;
+        }
+
         // Remove loaded local or remtoe metadata for target
         virtual nixl_status_t unloadMD (nixlBackendMD* input) = 0;
 
@@ -123,12 +171,32 @@ class nixlBackendEngine {
                                         const nixl_opt_b_args_t* opt_args=nullptr
                                        ) = 0;
 
+        // Posting a batch of prepared requests, status of each is set in its element and the
+        // first error is returned. Backends can override it to share work across the batch.
+        virtual nixl_status_t postXfers (nixl_b_xfer_batch_t &xfers) {
+            nixl_status_t ret = NIXL_SUCCESS;
+            for (auto & x : xfers) {
+                x.status = postXfer(x.operation, *x.local, *x.remote, *x.remoteAgent,
+                                    x.handle, &x.optArgs);
+                if ((x.status < 0) && (ret == NIXL_SUCCESS))
+                    ret = x.status;
+            }
+            return ret;
+        }
+
         // Use a handle to progress backend engine and see if a transfer is completed or not
         virtual nixl_status_t checkXfer(nixlBackendReqH* handle) = 0;
 
         //Backend aborts the transfer if necessary, and destructs the relevant objects
         virtual nixl_status_t releaseReqH(nixlBackendReqH* handle) = 0;
 
+        // Backend specific statistics of the last post of a handle, e.g. bytes sent
+        // after compression. Not required to be implemented.
+        virtual nixl_status_t getXferStats(const nixlBackendReqH* handle,
+                                           nixl_b_params_t &stats) const {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
 
         // *** Needs to be implemented if supportsRemote() is true *** //
 
@@ -145,6 +213,8 @@ class nixlBackendEngine {
 
         // Deserialize from string the connection info for a remote node, if supported
         // The generated data should be deleted in nixlBackendEngine destructor
+        // NIXL_ERR_NOT_SUPPORTED means the node cannot be reached by this backend,
+        // and its metadata is loaded for the other backends only.
         virtual nixl_status_t loadRemoteConnInfo (const std::string &remote_agent,
                                                   const std::string &remote_conn_info) {
             return NIXL_ERR_BACKEND;
@@ -173,6 +243,17 @@ class nixlBackendEngine {
         // Populate an empty received notif list. Elements are released within backend then.
         virtual nixl_status_t getNotifs(notif_list_t &notif_list) { return NIXL_ERR_BACKEND; }
 
+        // Appends the notifications to caller storage. Backends can override it to
+        // skip the intermediate list, and to not allocate when there are none.
+        virtual nixl_status_t appendNotifs(nixl_notif_list_t &notif_list) {
+            notif_list_t  list;
+            nixl_status_t ret = getNotifs(list);
+
+            for (auto & elm : list)
+                notif_list.add(elm.first, std::move(elm.second));
+            return ret;
+        }
+
         // Generates a standalone notification, not bound to a transfer.
         virtual nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg) {
             return NIXL_ERR_BACKEND;
@@ -183,5 +264,9 @@ class nixlBackendEngine {
 
         // Force backend engine worker to progress.
         virtual int progress() { return 0; }
+
+        // A round of the work of the progress thread, called by the progressDriver
+        // the engine added itself to. Returns whether anything was progressed.
+        virtual bool progressRound() { return progress() > 0; }
 };
 #endif
@@ -87,6 +87,29 @@ class nixlAgent {
                           nixl_mem_list_t &mems,
                           nixl_b_params_t &params) const;
 
+        /**
+         * @brief  Get the estimated performance of a backend for transfers between a
+         *         pair of memory types, which schedulers can use for placement. With a
+         *         remote agent, the estimate can be specific to the connection to it,
+         *         e.g. probed once connected to it. Transfer time is roughly
+         *         latencyUs plus size over bandwidthGBps, per descriptor of up to
+         *         chunkSize bytes when set.
+         *
+         * @param  backend       Backend handle
+         * @param  local_mem     Memory type of the local descriptors
+         * @param  remote_mem    Memory type of the remote descriptors
+         * @param  remote_agent  Remote agent name, or empty for any peer
+         * @param  hints [out]   Estimated bandwidth, latency and preferred chunk size
+         * @return nixl_status_t NIXL_ERR_NOT_SUPPORTED if the backend has no estimates
+         *                       for the pair of memory types
+         */
+        nixl_status_t
+        getBackendXferHints (const nixlBackendH* backend,
+                             const nixl_mem_t &local_mem,
+                             const nixl_mem_t &remote_mem,
+                             const std::string &remote_agent,
+                             nixl_xfer_hints_t &hints) const;
+
         /**
          * @brief  Instantiate a backend engine object based on the corresponding parameters
          *
@@ -111,6 +134,43 @@ class nixlAgent {
         registerMem (const nixl_reg_dlist_t &descs,
                      const nixl_opt_args_t* extra_params = nullptr);
 
+        /**
+         * @brief  Register a memory/storage with NIXL as registerMem, in the background.
+         *         The backends register the descriptors on the asyncRegThreads of the
+         *         agent, and the memory is added to the agent metadata once they're
+         *         done, so getLocalMD exports it from then on. Backends not supporting
+         *         concurrent registration hold the agent lock meanwhile. Registers
+         *         before returning with NIXL_THREAD_SYNC_NONE in the agent config.
+         *
+         * @param  descs         Descriptor list of the buffers to be registered
+         * @param  reg_hndl      [out] Handle to query the registration, or to release it
+         * @param  extra_params  Optional backends, and regCallback to call when done
+         * @return nixl_status_t NIXL_IN_PROG while registering, or its final status
+         */
+        nixl_status_t
+        registerMemAsync (const nixl_reg_dlist_t &descs,
+                          nixlRegReqH* &reg_hndl,
+                          const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Get the status of a registration by registerMemAsync.
+         *
+         * @param  reg_hndl      Handle of the registration
+         * @return nixl_status_t NIXL_IN_PROG, or the status registerMem would return
+         */
+        nixl_status_t
+        getRegStatus (const nixlRegReqH* reg_hndl) const;
+
+        /**
+         * @brief  Release the handle of a finished registration. The memory stays
+         *         registered, until deregisterMem is called for it.
+         *
+         * @param  reg_hndl      Handle of the registration
+         * @return nixl_status_t NIXL_ERR_NOT_ALLOWED while it's in progress
+         */
+        nixl_status_t
+        releaseRegReq (nixlRegReqH* reg_hndl) const;
+
         /**
          * @brief  Deregister a memory/storage from NIXL. If a list of backends hints is provided
          *         (via extra_params), the deregistration is limited to the specified backends.
@@ -136,6 +196,21 @@ class nixlAgent {
         makeConnection (const std::string &remote_agent,
                         const nixl_opt_args_t* extra_params = nullptr);
 
+        /**
+         * @brief  Make connections to several agents at once, e.g. a full mesh before the
+         *         first transfer. Backends overlap the connections where they can. The
+         *         backends are selected per agent as in makeConnection.
+         *
+         * @param  remote_agents  Names of the remote agents
+         * @param  statuses [out] Status of the connection to each agent
+         * @param  extra_params   Optional backends to connect with
+         * @return nixl_status_t  First error of the agents, or NIXL_SUCCESS
+         */
+        nixl_status_t
+        makeConnections (const std::vector<std::string> &remote_agents,
+                         std::vector<nixl_status_t> &statuses,
+                         const nixl_opt_args_t* extra_params = nullptr);
+
         /*** Transfer Request Preparation ***/
         /**
          * @brief  Prepare a list of descriptors for a transfer request, so later elements
@@ -151,6 +226,9 @@ class nixlAgent {
          *         If a list of backends hints is provided (via extra_params), the preparation
          *         is limited to the specified backends. If `descs` has the sorted flag, that
          *         enables an optimization to speed up the preparation process.
+         *         With lazyMDFetch in the agent config, the metadata of an unknown remote
+         *         agent is fetched from the metadata server, and NIXL_IN_PROG is returned
+         *         until it is loaded or lazyMDTimeoutUs passes.
          *
          * @param  agent_name       Agent name as a string for preparing xfer handle
          * @param  descs            The descriptor list to be prepared for transfer requests
@@ -187,6 +265,28 @@ class nixlAgent {
                      const std::vector<int> &remote_indices,
                      nixlXferReqH* &req_hndl,
                      const nixl_opt_args_t* extra_params = nullptr) const;
+        /**
+         * @brief  Same as above, with the indices of each side selected by ranges, so a
+         *         run of descriptors is selected without listing each index. The ranges
+         *         of the two sides can be split differently, but select as many indices.
+         *
+         * @param  operation        Operation for transfer (e.g., NIXL_WRITE)
+         * @param  local_side       Local prepared descriptor list handle
+         * @param  local_ranges     Index ranges in the local prepared descriptor list handle
+         * @param  remote_side      Remote (or loopback) prepared descriptor list handle
+         * @param  remote_ranges    Index ranges in the remote prepared descriptor list handle
+         * @param  req_handle [out] Transfer request handle output
+         * @param  extra_params     Optional additional parameters used in making a transfer request
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t
+        makeXferReq (const nixl_xfer_op_t &operation,
+                     const nixlDlistH* local_side,
+                     const nixl_index_ranges_t &local_ranges,
+                     const nixlDlistH* remote_side,
+                     const nixl_index_ranges_t &remote_ranges,
+                     nixlXferReqH* &req_hndl,
+                     const nixl_opt_args_t* extra_params = nullptr) const;
         /**
          * @brief  A combined API, to create a transfer request from two descriptor lists.
          *         NIXL will prepare each side and create a transfer handle `req_hndl`.
@@ -207,6 +307,7 @@ class nixlAgent {
          *         Optionally, a notification message can also be provided through extra_params.
          *         If `local_descs` or `remote_descs` have the sorted flag, that enables an
          *         optimization to speed up the preparation process.
+         *         An unknown remote agent is fetched as in prepXferDlist with lazyMDFetch.
          *
          * @param  operation      Operation for transfer (e.g., NIXL_WRITE)
          * @param  local_descs    Local descriptor list
@@ -223,6 +324,25 @@ class nixlAgent {
                        const std::string &remote_agent,
                        nixlXferReqH* &req_hndl,
                        const nixl_opt_args_t* extra_params = nullptr) const;
+        /**
+         * @brief  Same as above, with the remote agent given by the id from getRemoteAgentId,
+         *         so the agent is found without looking up its name.
+         *
+         * @param  operation      Operation for transfer (e.g., NIXL_WRITE)
+         * @param  local_descs    Local descriptor list
+         * @param  remote_descs   Remote (or loopback) descriptor list
+         * @param  remote_id      Id of the remote (or self) agent
+         * @param  req_hndl [out] Transfer request handle output
+         * @param  extra_params   Optional extra parameters used in creating a transfer request
+         * @return nixl_status_t  NIXL_ERR_NOT_FOUND if the metadata of the agent is not loaded
+         */
+        nixl_status_t
+        createXferReq (const nixl_xfer_op_t &operation,
+                       const nixl_xfer_dlist_t &local_descs,
+                       const nixl_xfer_dlist_t &remote_descs,
+                       const nixl_agent_id_t &remote_id,
+                       nixlXferReqH* &req_hndl,
+                       const nixl_opt_args_t* extra_params = nullptr) const;
 
         /*** Operations on prepared Transfer Request ***/
 
@@ -242,6 +362,24 @@ class nixlAgent {
         postXferReq (nixlXferReqH* req_hndl,
                      const nixl_opt_args_t* extra_params = nullptr) const;
 
+        /**
+         * @brief  Submit a batch of transfer requests under a single agent lock acquisition.
+         *         Requests that use the same backend are handed to it together, so it can
+         *         share work such as endpoint flushes across the batch. Per request semantics
+         *         are the same as postXferReq, and extra_params applies to all of them.
+         *         Handles are not released on errors, their status is reported instead.
+         *
+         * @param  req_hndls        Transfer request handles obtained from makeXferReq/createXferReq
+         * @param  statuses   [out] Status of each request, same order as req_hndls
+         * @param  extra_params     Optional extra parameters used in posting the transfer requests
+         * @return nixl_status_t    NIXL_IN_PROG if any request is in progress, NIXL_SUCCESS if
+         *                          all completed, or the first error code if any failed
+         */
+        nixl_status_t
+        postXferReqs (const std::vector<nixlXferReqH*> &req_hndls,
+                      std::vector<nixl_status_t> &statuses,
+                      const nixl_opt_args_t* extra_params = nullptr) const;
+
         /**
          * @brief  Check the status of transfer request `req_hndl`
          *
@@ -251,6 +389,44 @@ class nixlAgent {
         nixl_status_t
         getXferStatus (nixlXferReqH* req_hndl);
 
+        /**
+         * @brief  Check the status of a batch of transfer requests under a single agent lock
+         *         acquisition.
+         *
+         * @param  req_hndls        Transfer request handles after postXferReq/postXferReqs
+         * @param  statuses   [out] Status of each request, same order as req_hndls
+         * @return nixl_status_t    NIXL_IN_PROG if any request is in progress, NIXL_SUCCESS if
+         *                          all completed, or the first error code if any failed
+         */
+        nixl_status_t
+        getXferStatus (const std::vector<nixlXferReqH*> &req_hndls,
+                       std::vector<nixl_status_t> &statuses);
+
+        /**
+         * @brief  Get the requests posted with useCompletionQueue that finished since
+         *         the last call, successfully or not. Their status is updated, so
+         *         getXferStatus returns it without checking the backend again.
+         *
+         * @param  max              Maximum number of requests to return
+         * @param  completed  [out] Finished transfer request handles
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t
+        pollCompletions (const size_t &max,
+                         std::vector<nixlXferReqH*> &completed);
+
+        /**
+         * @brief  Get a file descriptor that becomes readable when backends that report
+         *         completions by themselves finish a request, to wait on it with poll/epoll
+         *         before calling pollCompletions. For the other backends, completions are
+         *         only found by calling pollCompletions.
+         *
+         * @param  fd         [out] Nonblocking eventfd, owned by the agent
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t
+        getCompletionFd (int &fd) const;
+
         /**
          * @brief  Query the backend associated with `req_hndl`. E.g., if for genNotif
          *         the same backend as a transfer is desired.
@@ -263,6 +439,51 @@ class nixlAgent {
         queryXferBackend (const nixlXferReqH* req_hndl,
                           nixlBackendH* &backend) const;
 
+        /**
+         * @brief  Get the statistics the backend of `req_hndl` keeps for its last post,
+         *         e.g. the compression ratio. Keys and values are backend specific.
+         *
+         * @param  req_hndl      Transfer request handle after postXferReq
+         * @param  stats   [out] Statistics as key value pairs
+         * @return nixl_status_t NIXL_ERR_NOT_SUPPORTED if the backend keeps none
+         */
+        nixl_status_t
+        getXferStats (const nixlXferReqH* req_hndl,
+                      nixl_b_params_t &stats) const;
+
+        /**
+         * @brief  Get the counters of the progress thread of the agent, which progresses
+         *         the backends with sharedProgThread in the agent config.
+         *
+         * @param  stats   [out] Counters since the agent was created
+         * @return nixl_status_t NIXL_ERR_NOT_SUPPORTED without the progress thread
+         */
+        nixl_status_t
+        getProgressStats (nixlProgressStats &stats) const;
+
+        /**
+         * @brief  Get the bytes of transfer requests deferred by the limits in the agent
+         *         config, priorityMaxBytes and the peer limits, and the bytes in flight.
+         *
+         * @param  stats        [out] Counters at the time of the call
+         * @param  remote_agent Remote agent to get the counters of, all of them if empty
+         * @return nixl_status_t NIXL_ERR_NOT_SUPPORTED without any of the limits
+         */
+        nixl_status_t
+        getXferQueueStats (nixlXferQueueStats &stats,
+                           const std::string &remote_agent = "") const;
+
+        /**
+         * @brief  Get the counters and latency histograms of the transfers of the agent,
+         *         per backend, operation and remote agent, with enableTelemetry in the
+         *         agent config. Per thread counters, summed at the time of the call.
+         *
+         * @param  telemetry [out] Counters since the agent was created
+         * @return nixl_status_t NIXL_ERR_NOT_SUPPORTED if not enabled, or not built in
+         */
+        nixl_status_t
+        getTelemetry (nixl_xfer_telemetry_t &telemetry) const;
+
         /**
          * @brief  Release the transfer request `req_hndl`. If the transfer is active,
          *         it will be canceled, or return an error if the transfer cannot be aborted.
@@ -299,6 +520,20 @@ class nixlAgent {
         getNotifs (nixl_notifs_t &notif_map,
                    const nixl_opt_args_t* extra_params = nullptr);
 
+        /**
+         * @brief  Append new notifications to a caller owned list (can be non-empty), that is
+         *         meant to be cleared and reused across calls. Agents are identified by IDs
+         *         interned in the list, and no allocation is done when nothing was received.
+         *         Optionally, a list of backends can be mentioned in extra_params.
+         *
+         * @param  notif_list    Input notifications list
+         * @param  extra_params  Optional extra parameters used in getting notifications
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getNotifs (nixl_notif_list_t &notif_list,
+                   const nixl_opt_args_t* extra_params = nullptr);
+
         /**
          * @brief  Generate a notification, not bound to a transfer, e.g., for control.
          *         Metadata of remote agent should be available before this call. The
@@ -324,6 +559,8 @@ class nixlAgent {
          *                       If IP is specified, this will enable peer to peer sending of your metadata.
          *                       If IP unspecified, this will send your data to the metadata server.
          *                       Port can be specified or defaults to default_comm_port.
+         *                       If mdPeers is specified instead, your metadata is broadcast
+         *                       to them along a tree of mdFanout children per peer.
          *
          * @return nixl_status_t Error code if call was not successful
          */
@@ -351,6 +588,18 @@ class nixlAgent {
         sendLocalPartialMD(nixl_reg_dlist_t  &descs,
                            const nixl_opt_args_t* extra_params = nullptr) const;
 
+        /**
+         * @brief  Send the changes of your own agent metadata since it was last sent to
+         *         the peer at `extra_params->ipAddr` and `extra_params->port`. The full
+         *         metadata is sent the first time, or if the changes are no longer kept.
+         *
+         * @param  extra_params  IP address and optionally port of the peer.
+         *
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        sendLocalMDDelta (const nixl_opt_args_t* extra_params = nullptr) const;
+
         /**
          * @brief  Fetch other agent's metadata and unpack it internally.
          *
@@ -389,6 +638,56 @@ class nixlAgent {
         nixl_status_t
         getLocalMD (nixl_blob_t &str) const;
 
+        /**
+         * @brief  Get metadata blob for this agent with the memory registrations and
+         *         deregistrations since `since_version`, for an agent that loaded the
+         *         metadata of that version. If these changes are no longer kept, the
+         *         full metadata is returned instead. Both are loaded with loadRemoteMD.
+         *
+         * @param  since_version [in]  Version of the metadata the remote agent holds
+         * @param  str           [out] The serialized metadata blob
+         * @return nixl_status_t       Error code if call was not successful
+         */
+        nixl_status_t
+        getLocalMDDelta (const uint64_t &since_version,
+                         nixl_blob_t &str) const;
+
+        /**
+         * @brief  Get the version of the metadata of this agent, incremented by every
+         *         registration and deregistration of memory.
+         *
+         * @param  version [out] Version of the local metadata
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getLocalMDVersion (uint64_t &version) const;
+
+        /**
+         * @brief  Get the version of the metadata loaded from a remote agent, 0 if
+         *         the remote agent only sent unversioned or partial metadata.
+         *
+         * @param  remote_agent  Remote agent name
+         * @param  version [out] Version of the loaded metadata
+         * @return nixl_status_t NIXL_ERR_NOT_FOUND if no metadata of the agent is loaded
+         */
+        nixl_status_t
+        getRemoteMDVersion (const std::string &remote_agent,
+                            uint64_t &version) const;
+
+        /**
+         * @brief  Get the id of a remote agent, assigned when its metadata is first loaded,
+         *         to create transfer requests without its name. The agent keeps its id if
+         *         its metadata is invalidated and loaded again. The agent itself has an id
+         *         once memory is registered with a backend supporting local transfers.
+         *
+         * @param  remote_agent    Remote agent name
+         * @param  agent_id  [out] Id of the remote agent
+         * @return nixl_status_t   NIXL_ERR_NOT_FOUND if no metadata of the agent is loaded
+         */
+        nixl_status_t
+        getRemoteAgentId (const std::string &remote_agent,
+                          nixl_agent_id_t &agent_id) const;
+
         /**
          * @brief  Get partial metadata blob for this agent, to be given to other agents.
          *         If `descs` is empty, only backends' connection info is included in the metadata,
@@ -412,6 +711,9 @@ class nixlAgent {
         /**
          * @brief  Load other agent's metadata and unpack it internally. Now the local
          *         agent can initiate transfers towards the remote agent.
+         *         A metadata delta that is older than the loaded metadata is ignored,
+         *         and one that starts after the loaded version returns NIXL_ERR_NOT_FOUND,
+         *         in which case the full metadata of the remote agent should be loaded.
          *
          * @param  remote_metadata  Serialized metadata blob to be loaded
          * @param  agent_name [out] Agent name extracted from the loaded metadata blob
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ * @file nixl_coro.h
+ * @brief Awaitable transfers for C++20 coroutines, on top of the completion
+ *        queue of an agent. Empty when coroutines are not supported.
+ */
+#ifndef _NIXL_CORO_H
+#define _NIXL_CORO_H
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "nixl.h"
+
+class nixlXferDispatcher;
+
+/**
+ * @class nixlXferAwaiter
+ * @brief Posts a transfer request when awaited, and resumes the coroutine from
+ *        nixlXferDispatcher::progress once it finishes. co_await returns the
+ *        final status of the request.
+ */
+class nixlXferAwaiter {
+    private:
+        nixlXferDispatcher &dispatcher;
+        nixlXferReqH*       req;
+        nixl_opt_args_t     args;
+
+        // Status of a post that finished at once, for the await_resume that
+        // follows in the same thread when await_suspend returns false
+        struct inlineResult {
+            nixlXferReqH* req = nullptr;
+            nixl_status_t status = NIXL_IN_PROG;
+        };
+        static inlineResult& lastInline() {
+            static thread_local inlineResult result;
+            return result;
+        }
+
+    public:
+        nixlXferAwaiter(nixlXferDispatcher &dispatcher, nixlXferReqH* req,
+                        const nixl_opt_args_t* extra_params)
+            : dispatcher(dispatcher), req(req) {
+            if (extra_params)
+                args = *extra_params;
+            args.useCompletionQueue = true;
+        }
+
+        bool await_ready() const noexcept { return false; }
+        inline bool await_suspend(std::coroutine_handle<> handle);
+        inline nixl_status_t await_resume();
+};
+
+/**
+ * @class nixlXferDispatcher
+ * @brief Multiplexes the transfers awaited by many coroutines of an agent. The
+ *        executor threads call progress, e.g. when getFd is readable or between
+ *        tasks, which resumes the coroutines of the finished transfers in the
+ *        calling thread. The dispatcher drains the completion queue of the agent,
+ *        so there is to be one per agent, and pollCompletions is not to be called
+ *        elsewhere. Coroutines still waiting when it is destroyed are not resumed.
+ */
+class nixlXferDispatcher {
+    private:
+        nixlAgent &agent;
+        std::mutex lock;
+        std::unordered_map<nixlXferReqH*, std::coroutine_handle<>> waiters;
+
+    public:
+        explicit nixlXferDispatcher(nixlAgent &agent) : agent(agent) { }
+
+        nixlXferDispatcher(const nixlXferDispatcher&) = delete;
+        nixlXferDispatcher& operator=(const nixlXferDispatcher&) = delete;
+
+        /**
+         * @brief  Awaitable posting `req_hndl` with useCompletionQueue set, e.g.
+         *         `nixl_status_t ret = co_await dispatcher.transfer(req_hndl);`
+         *         A request is to be awaited by one coroutine at a time.
+         *
+         * @param  req_hndl      Transfer request handle obtained from makeXferReq/createXferReq
+         * @param  extra_params  Optional extra parameters used in posting the transfer request
+         * @return nixlXferAwaiter Awaitable returning the final status of the request
+         */
+        nixlXferAwaiter
+        transfer(nixlXferReqH* req_hndl, const nixl_opt_args_t* extra_params = nullptr) {
+            return nixlXferAwaiter(*this, req_hndl, extra_params);
+        }
+
+        /**
+         * @brief  File descriptor to wait on before calling progress, see
+         *         nixlAgent::getCompletionFd. Transfers on backends that do not
+         *         report completions are only found by calling progress.
+         *
+         * @param  fd         [out] Nonblocking eventfd, owned by the agent
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t getFd(int &fd) const { return agent.getCompletionFd(fd); }
+
+        /**
+         * @brief  Resumes the coroutines awaiting transfers that finished, in the
+         *         calling thread. Can be called from several threads at once.
+         *
+         * @param  max      Maximum number of finished requests to take
+         * @return size_t   Number of coroutines resumed
+         */
+        size_t progress(size_t max = 64) {
+            std::vector<nixlXferReqH*>          completed;
+            std::vector<std::coroutine_handle<>> ready;
+
+            if (agent.pollCompletions(max, completed) != NIXL_SUCCESS)
+                return 0;
+
+            for (auto req : completed) {
+                // A completion of a previous post of a request can be taken
+                // after it is posted again, it's then left to the next one.
+                if (agent.getXferStatus(req) == NIXL_IN_PROG)
+                    continue;
+
+                std::lock_guard<std::mutex> guard(lock);
+                auto it = waiters.find(req);
+                if (it == waiters.end())
+                    continue;
+                ready.push_back(it->second);
+                waiters.erase(it);
+            }
+
+            for (auto handle : ready)
+                handle.resume();
+            return ready.size();
+        }
+
+        /**
+         * @brief  Number of coroutines awaiting a transfer
+         */
+        size_t waiting() {
+            std::lock_guard<std::mutex> guard(lock);
+            return waiters.size();
+        }
+
+    friend class nixlXferAwaiter;
+};
+
+// The waiter is added before posting, as another thread in progress can find
+// the request finished before the post returns. From then on the coroutine can
+// be resumed and its frame, this awaiter included, freed at any time, so only
+// locals are used past that point.
+inline bool nixlXferAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    nixlXferDispatcher &disp = dispatcher;
+    nixlXferReqH* r = req;
+    nixl_opt_args_t post_args = args;
+
+    {
+        std::lock_guard<std::mutex> guard(disp.lock);
+        disp.waiters[r] = handle;
+    }
+
+    nixl_status_t ret = disp.agent.postXferReq(r, &post_args);
+    if (ret == NIXL_IN_PROG)
+        return true;
+
+    std::lock_guard<std::mutex> guard(disp.lock);
+    // Finished in the post, but already taken by progress, which resumes it
+    if (disp.waiters.erase(r) == 0)
+        return true;
+    lastInline() = {r, ret};
+    return false;
+}
+
+inline nixl_status_t nixlXferAwaiter::await_resume() {
+    inlineResult &result = lastInline();
+    if (result.req == req) {
+        result.req = nullptr;
+        return result.status;
+    }
+    return dispatcher.agent.getXferStatus(req);
+}
+
+#endif
+
+#endif
@@ -22,7 +22,9 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <type_traits>
 #include "nixl_types.h"
+#include "nixl_small_vector.h"
 
 /**
  * @class nixlBasicDesc
@@ -178,12 +180,56 @@ class nixlBlobDesc : public nixlBasicDesc {
         void print(const std::string &suffix) const;
 };
 
+/**
+ * @class nixlStridedDesc
+ * @brief A regular pattern of count blocks of len bytes, starting every stride
+ *        bytes from addr, such as the blocks of a paged KV cache. Added to
+ *        descriptor lists as one descriptor per block.
+ */
+class nixlStridedDesc {
+    public:
+        /** @var Start of the first block */
+        uintptr_t addr;
+        /** @var Length of each block */
+        size_t    len;
+        /** @var Distance between the starts of consecutive blocks */
+        size_t    stride;
+        /** @var Number of blocks */
+        size_t    count;
+        /** @var deviceID/blockID/fileID */
+        uint64_t  devId;
+
+        nixlStridedDesc(const uintptr_t &addr, const size_t &len,
+                        const size_t &stride, const size_t &count,
+                        const uint64_t &dev_id)
+            : addr(addr), len(len), stride(stride), count(count), devId(dev_id) {}
+
+        /**
+         * @brief Get the block at index
+         */
+        inline nixlBasicDesc block(size_t index) const
+            { return nixlBasicDesc(addr + index * stride, len, devId); }
+};
+
+/**
+ * @struct nixlDescInline
+ * @brief Number of descriptors a nixlDescList of type T keeps without allocating.
+ *        Descriptors with metadata blobs allocate for the blobs anyway, and have none.
+ */
+template<class T>
+struct nixlDescInline { static constexpr size_t value = 0; };
+
+template<>
+struct nixlDescInline<nixlBasicDesc> { static constexpr size_t value = 4; };
+
 /**
  * @class nixlDescList
  * @brief A class for describing a list of descriptors, as a template based on
- *        the nixlDesc type that is used.
+ *        the nixlDesc type that is used. Up to N descriptors are stored inside
+ *        the object, so short lists do not allocate. The library is built for
+ *        the default N of each descriptor type.
  */
-template<class T>
+template<class T, size_t N = nixlDescInline<T>::value>
 class nixlDescList {
     private:
         /** @var NIXL memory type */
@@ -193,10 +239,18 @@ class nixlDescList {
          *       has comparison order of devID, then addr, then len.
          */
         bool           sorted;
-        /** @var Vector for storing nixlDescs */
-        std::vector<T> descs;
+        /** @var Vector for storing nixlDescs, inline for up to N of them */
+        typedef std::conditional_t<(N > 0), nixlSmallVector<T, N>, std::vector<T>> storage_t;
+        storage_t      descs;
+
+        /** @brief Sorts the descriptors from index start on, and merges them into the rest */
+        void mergeAppended(const size_t &start);
 
     public:
+        /** @var Iterator types, as in std::vector */
+        typedef typename storage_t::iterator       iterator;
+        typedef typename storage_t::const_iterator const_iterator;
+
         /**
          * @brief Parametrized Constructor for nixlDescList
          *
@@ -220,13 +274,21 @@ class nixlDescList {
          *
          * @param d_list other nixlDescList object of the same type
          */
-        nixlDescList(const nixlDescList<T> &d_list) = default;
+        nixlDescList(const nixlDescList<T, N> &d_list) = default;
         /**
          * @brief Operator = overloading constructor for nixlDescList
          *
          * @param d_list nixlDescList object
          */
-        nixlDescList& operator=(const nixlDescList<T> &d_list) = default;
+        nixlDescList& operator=(const nixlDescList<T, N> &d_list) = default;
+        /**
+         * @brief Move constructor and assignment, taking the descriptors of d_list
+         *        without copying them if they are not inline
+         *
+         * @param d_list nixlDescList object, left empty
+         */
+        nixlDescList(nixlDescList<T, N> &&d_list) noexcept = default;
+        nixlDescList& operator=(nixlDescList<T, N> &&d_list) noexcept = default;
         /**
          * @brief nixlDescList Destructor
          */
@@ -261,13 +323,13 @@ class nixlDescList {
         /**
          * @brief Vector like iterators for const and non-const elements
          */
-        inline typename std::vector<T>::const_iterator begin() const
+        inline const_iterator begin() const
             { return descs.begin(); }
-        inline typename std::vector<T>::const_iterator end() const
+        inline const_iterator end() const
             { return descs.end(); }
-        inline typename std::vector<T>::iterator begin()
+        inline iterator begin()
             { return descs.begin(); }
-        inline typename std::vector<T>::iterator end()
+        inline iterator end()
             { return descs.end(); }
         /**
          * @brief Operator overloading (==) to compare nixlDescList objects
@@ -276,8 +338,8 @@ class nixlDescList {
          * @param rhs   nixlDescList object
          *
          */
-        template <class Y> friend bool operator==(const nixlDescList<Y> &lhs,
-                                                  const nixlDescList<Y> &rhs);
+        template <class Y, size_t M> friend bool operator==(const nixlDescList<Y, M> &lhs,
+                                                            const nixlDescList<Y, M> &rhs);
         /**
          * @brief Resize nixlDescList object. If new size is more than the
          *        original size, the sorted status will be negated if set.
@@ -294,16 +356,71 @@ class nixlDescList {
          * @brief Empty the descriptors list
          */
         inline void clear() { descs.clear(); }
+        /**
+         * @brief Empty the descriptors list and set a new memory type and
+         *        sorted flag, keeping the allocated capacity for reuse
+         *
+         * @param new_type   NIXL memory type of descriptor list
+         * @param new_sorted Flag to set sorted option
+         */
+        inline void reset(const nixl_mem_t &new_type, const bool &new_sorted)
+            { type = new_type; sorted = new_sorted; descs.clear(); }
         /**
          * @brief     Add Descriptors to descriptor list
          *               If nixlDescList object is sorted, this method keeps it sorted
          */
         void addDesc(const T &desc);
+        /**
+         * @brief     Construct a descriptor in the list from the arguments of a T
+         *            constructor, e.g. addr, len and devId, without a temporary to
+         *            copy from when the list is not sorted.
+         *               If nixlDescList object is sorted, this method keeps it sorted
+         */
+        template<class... Args>
+        void emplaceDesc(Args&&... args) {
+            if (!sorted) {
+                descs.emplace_back(std::forward<Args>(args)...);
+            } else {
+                T desc(std::forward<Args>(args)...);
+                auto itr = std::upper_bound(descs.begin(), descs.end(), desc);
+                descs.insert(itr, std::move(desc));
+            }
+        }
+        /**
+         * @brief     Allocate for count descriptors in total, so adding up to
+         *            that many does not allocate again
+         */
+        inline void reserve(const size_t &count) { descs.reserve(count); }
+        /**
+         * @brief     Add the descriptors of a range at once. If nixlDescList object is
+         *            sorted, they are sorted and merged into it in O(N + M log M), in
+         *            the same order as adding them one by one with addDesc
+         */
+        template<class InputIt>
+        void addDescs(InputIt first, InputIt last) {
+            size_t start = descs.size();
+            for (; first != last; ++first)
+                descs.push_back(*first);
+            if (sorted)
+                mergeAppended(start);
+        }
+        /**
+         * @brief     Add a descriptor for each block of a strided descriptor, in one
+         *            allocation. The blocks are appended at once if they sort after
+         *            the list, e.g. when building it in order.
+         */
+        void addStridedDesc(const nixlStridedDesc &desc);
         /**
          * @brief Remove descriptor from list at index
          *        Can throw std::out_of_range exception.
          */
         void remDesc(const int &index);
+        /**
+         * @brief Remove the descriptors at indices from list in one pass, keeping the
+         *        order of the rest. Repeated indices are removed once.
+         *        Can throw std::out_of_range exception.
+         */
+        void remDescs(std::vector<int> indices);
         /**
          * @brief Convert a nixlDescList with metadata by trimming it to a
          *        nixlDescList of nixlBasicDesc elements
@@ -326,9 +443,12 @@ class nixlDescList {
         /**
          * @brief Serialize a descriptor list with nixlSerDes class
          * @param serializer nixlSerDes object to serialize nixlDescList
+         * @param packed     Delta encode the addresses of descriptors, and the lengths and
+         *                   devIds of runs of descriptors without metadata blobs, which is
+         *                   compact for sorted lists but not read by older releases
          * @return nixl_status_t Error code if serialize was not successful
          */
-        nixl_status_t serialize(nixlSerDes* serializer) const;
+        nixl_status_t serialize(nixlSerDes* serializer, const bool &packed=false) const;
         /**
          * @brief Print the descriptor list for debugging
          */
@@ -17,7 +17,9 @@
 #ifndef _NIXL_PARAMS_H
 #define _NIXL_PARAMS_H
 
+#include <array>
 #include <string>
+#include <vector>
 #include <cstdint>
 #include "nixl_types.h"
 
@@ -51,11 +53,121 @@ class nixlAgentConfig {
         uint64_t pthrDelay;
         /**
          * @var Listener thread frequency knob (in us)
-         *      Listener thread sleeps in a similar way to progress thread, desrcibed previously.
-         *      These will be combined into a unified NIXL Thread API in a future version.
+         *      Unused, the listener thread sleeps until a socket or a queued command is
+         *      ready. Kept for compatibility of the constructor.
          */
         uint64_t lthrDelay;
-
+        /**
+         * @var Codec compressing the memory sections of the metadata of this agent,
+         *      lz4, zstd or deflate if built in. NIXL_MD_CODEC is used when empty,
+         *      and without either the sections are sent uncompressed. Agents of
+         *      older releases cannot load compressed metadata.
+         */
+        std::string mdCodec;
+        /**
+         * @var IP addresses and ports of the peers the listener forwards the metadata
+         *      of a broadcast through mdPeers to, besides those it is connected to.
+         *      Peers of a received broadcast that are in neither are left out.
+         */
+        std::vector<std::pair<std::string, int>> mdForwardPeers;
+        /**
+         * @var Fetch the metadata of a remote agent from the metadata server when
+         *      prepXferDlist or createXferReq first use it, instead of failing with
+         *      NIXL_ERR_NOT_FOUND. Fetched agents are kept up to date by the server.
+         */
+        bool lazyMDFetch = false;
+        /**
+         * @var Time in us to wait for a fetch on first use. With 0 the call returns
+         *      NIXL_IN_PROG at once, and is to be retried.
+         */
+        uint64_t lazyMDTimeoutUs = 0;
+        /**
+         * @var Number of agents fetched on first use to keep, the least recently
+         *      used is invalidated beyond it. Agents with dlist or transfer handles
+         *      not released yet are kept. 0 keeps all of them.
+         */
+        size_t lazyMDCacheSize = 0;
+        /**
+         * @var Threads loading the descriptors of a remote agent metadata, in chunks.
+         *      0 uses the number of cores, and 1 loads them in the calling thread.
+         */
+        size_t mdImportThreads = 0;
+        /**
+         * @var Threads registering memory for registerMemAsync, started on its first
+         *      call.
+         */
+        size_t asyncRegThreads = 1;
+        /**
+         * @var Threads registering the descriptors of a list with a backend, in chunks,
+         *      for backends supporting concurrent registration. 0 uses the number of
+         *      cores, and 1 registers them in the calling thread.
+         */
+        size_t regThreads = 0;
+        /**
+         * @var With useProgThread, progress all backends from one agent thread, which
+         *      is also the listener thread, instead of a thread per backend engine.
+         *      Listener work, such as loading received metadata, delays the progress.
+         */
+        bool sharedProgThread = false;
+        /**
+         * @var Backoff of the progress thread with sharedProgThread. After a round
+         *      that progressed nothing, it polls again for progSpinUs, then waits
+         *      pthrDelay between rounds. Idle for progIdleUs, it sleeps until work
+         *      is posted, a listener event, or for up to progSleepUs. 0 for
+         *      progIdleUs keeps it polling.
+         */
+        uint64_t progSpinUs  = 0;
+        uint64_t progIdleUs  = 0;
+        uint64_t progSleepUs = 1000;
+        /**
+         * @var CPUs to pin the listener thread to, which is also the progress thread
+         *      with sharedProgThread. A CPU list such as "0-7,16", or "numa:<node>"
+         *      for the CPUs of a NUMA node. Empty leaves the thread unpinned.
+         */
+        std::string commThreadCpus;
+        /**
+         * @var With sharedProgThread, size of a lock free queue of posts to the
+         *      progress thread. postXferReq then queues the request and returns
+         *      NIXL_IN_PROG, without taking the agent lock, and the progress thread
+         *      posts it. Errors of the post are then reported by getXferStatus, or
+         *      with the completion of the request. A request is posted by the
+         *      calling thread when the queue is full. Needs a syncMode other than
+         *      NIXL_THREAD_SYNC_NONE. 0 disables the queue.
+         */
+        size_t submitQueueSize = 0;
+        /**
+         * @var Bytes in flight per priority class, indexed by nixl_xfer_priority_t.
+         *      Posts beyond them are deferred and return NIXL_IN_PROG, and are posted
+         *      once requests of their class finish, higher classes first. Deferred
+         *      requests are posted from agent calls, such as getXferStatus and
+         *      pollCompletions, or by the progress thread with sharedProgThread.
+         *      A request larger than the limit is posted when its class is idle.
+         *      0 leaves a class unlimited.
+         */
+        std::array<size_t, nixl_xfer_priority_count> priorityMaxBytes = {0, 0, 0};
+        /**
+         * @var Shaping of the transfers to each remote agent, applied like
+         *      priorityMaxBytes. peerMaxBytes limits the bytes in flight to an agent,
+         *      and peerRateBytes the bytes per second posted to it, in bursts of up to
+         *      peerBurstBytes. Remote agents with deferred requests take turns, a
+         *      request each, once their requests fit. 0 disables a limit, and 0 for
+         *      peerBurstBytes allows 10ms at peerRateBytes.
+         */
+        size_t   peerMaxBytes   = 0;
+        uint64_t peerRateBytes  = 0;
+        size_t   peerBurstBytes = 0;
+        /**
+         * @var Count the posts, bytes and completions of the transfers per backend,
+         *      operation and remote agent, with histograms of their latencies, read
+         *      with getTelemetry. Also enabled by NIXL_TELEMETRY=1. Not available
+         *      when built with disable_telemetry.
+         */
+        bool enableTelemetry = false;
+        /**
+         * @var With enableTelemetry, period in ms of logging the telemetry at info
+         *      level. 0 disables the logging.
+         */
+        uint64_t telemetryDumpMs = 0;
 
 
         /**
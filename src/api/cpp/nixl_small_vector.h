@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_SMALL_VECTOR_H
+#define _NIXL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/**
+ * @class nixlSmallVector
+ * @brief A vector keeping up to N elements inside the object, and allocating
+ *        only for more. Has the subset of the std::vector methods used by
+ *        nixlDescList, with pointers as iterators.
+ */
+template<class T, size_t N>
+class nixlSmallVector {
+    private:
+        T*     elms;
+        size_t count;
+        size_t cap;
+        alignas(T) unsigned char local[N * sizeof(T)];
+
+        inline T* localData() { return reinterpret_cast<T*>(local); }
+        inline bool isLocal() const { return elms == reinterpret_cast<const T*>(local); }
+
+        void grow(size_t new_cap) {
+            T* new_elms = static_cast<T*>(::operator new(new_cap * sizeof(T)));
+            std::uninitialized_move(elms, elms + count, new_elms);
+            std::destroy(elms, elms + count);
+            if (!isLocal())
+                ::operator delete(elms);
+            elms = new_elms;
+            cap  = new_cap;
+        }
+
+        void release() {
+            clear();
+            if (!isLocal())
+                ::operator delete(elms);
+            elms = localData();
+            cap  = N;
+        }
+
+    public:
+        typedef T*       iterator;
+        typedef const T* const_iterator;
+
+        nixlSmallVector() : elms(localData()), count(0), cap(N) {}
+
+        nixlSmallVector(const nixlSmallVector &other) : nixlSmallVector() {
+            *this = other;
+        }
+
+        nixlSmallVector(nixlSmallVector &&other) noexcept : nixlSmallVector() {
+            *this = std::move(other);
+        }
+
+        ~nixlSmallVector() { release(); }
+
+        nixlSmallVector& operator=(const nixlSmallVector &other) {
+            if (this == &other)
+                return *this;
+            clear();
+            reserve(other.count);
+            std::uninitialized_copy(other.elms, other.elms + other.count, elms);
+            count = other.count;
+            return *this;
+        }
+
+        nixlSmallVector& operator=(nixlSmallVector &&other) noexcept {
+            if (this == &other)
+                return *this;
+            release();
+            if (other.isLocal()) {
+                std::uninitialized_move(other.elms, other.elms + other.count, elms);
+                count = other.count;
+                other.clear();
+            } else {
+                // Heap storage changes hands without moving the elements
+                elms  = other.elms;
+                count = other.count;
+                cap   = other.cap;
+                other.elms  = other.localData();
+                other.count = 0;
+                other.cap   = N;
+            }
+            return *this;
+        }
+
+        inline size_t size() const { return count; }
+        inline size_t capacity() const { return cap; }
+        inline bool empty() const { return count == 0; }
+        inline T* data() { return elms; }
+        inline const T* data() const { return elms; }
+
+        inline T& operator[](size_t index) { return elms[index]; }
+        inline const T& operator[](size_t index) const { return elms[index]; }
+
+        inline iterator begin() { return elms; }
+        inline iterator end() { return elms + count; }
+        inline const_iterator begin() const { return elms; }
+        inline const_iterator end() const { return elms + count; }
+
+        void reserve(size_t new_cap) {
+            if (new_cap > cap)
+                grow(new_cap);
+        }
+
+        void resize(size_t new_count) {
+            if (new_count > cap)
+                grow(std::max(new_count, 2 * cap));
+            if (new_count > count) {
+                for (size_t i = count; i < new_count; ++i)
+                    new (elms + i) T();
+            } else {
+                std::destroy(elms + new_count, elms + count);
+            }
+            count = new_count;
+        }
+
+        // Keeps the allocated capacity, as std::vector does
+        void clear() {
+            std::destroy(elms, elms + count);
+            count = 0;
+        }
+
+        void push_back(const T &elm) {
+            if (count == cap) {
+                // elm can be one of the elements, moved by growing
+                T copy(elm);
+                grow(std::max<size_t>(1, 2 * cap));
+                new (elms + count) T(std::move(copy));
+            } else {
+                new (elms + count) T(elm);
+            }
+            count++;
+        }
+
+        template<class... Args>
+        T& emplace_back(Args&&... args) {
+            if (count == cap) {
+                // The arguments can refer to the elements, moved by growing
+                T elm(std::forward<Args>(args)...);
+                grow(std::max<size_t>(1, 2 * cap));
+                new (elms + count) T(std::move(elm));
+            } else {
+                new (elms + count) T(std::forward<Args>(args)...);
+            }
+            return elms[count++];
+        }
+
+        iterator insert(const_iterator pos, T &&elm) {
+            size_t index = pos - elms;
+            emplace_back(std::move(elm));
+            std::rotate(elms + index, elms + count - 1, elms + count);
+            return elms + index;
+        }
+
+        iterator insert(const_iterator pos, const T &elm) {
+            size_t index = pos - elms;
+            push_back(elm);
+            std::rotate(elms + index, elms + count - 1, elms + count);
+            return elms + index;
+        }
+
+        iterator erase(const_iterator pos) {
+            size_t index = pos - elms;
+            std::move(elms + index + 1, elms + count, elms + index);
+            std::destroy_at(elms + count - 1);
+            count--;
+            return elms + index;
+        }
+};
+
+#endif
@@ -16,6 +16,8 @@
  */
 #ifndef _NIXL_TYPES_H
 #define _NIXL_TYPES_H
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -26,6 +28,7 @@ class nixlSerDes;
 class nixlDlistH;
 class nixlBackendH;
 class nixlXferReqH;
+class nixlRegReqH;
 class nixlAgentData;
 
 
@@ -69,9 +72,51 @@ typedef enum {
 enum class nixl_thread_sync_t {
     NIXL_THREAD_SYNC_NONE,
     NIXL_THREAD_SYNC_STRICT,
+    /**
+     * Reader/writer locking: transfer and notification calls run concurrently
+     * under a shared lock, and calls that change registrations, backends or
+     * remote metadata take it exclusively. Backends are then called from
+     * multiple threads at once, so they must be thread safe.
+     */
+    NIXL_THREAD_SYNC_RW,
     NIXL_THREAD_SYNC_DEFAULT = NIXL_THREAD_SYNC_NONE,
 };
 
+/**
+ * @enum nixl_backend_policy_t
+ * @brief An enumeration of how createXferReq selects a backend among the ones that
+ *        have both sides of the transfer registered
+ */
+enum class nixl_backend_policy_t {
+    /** First one in backend creation order, or in the order of the backends hint */
+    NIXL_BACKEND_POLICY_FIRST,
+    /** Backend types in backendPreference first, in that order, then the rest */
+    NIXL_BACKEND_POLICY_PREFERENCE,
+    /** Lowest estimated time for the transfer size, based on backend hints */
+    NIXL_BACKEND_POLICY_COST,
+    NIXL_BACKEND_POLICY_DEFAULT = NIXL_BACKEND_POLICY_FIRST,
+};
+
+/**
+ * @enum nixl_xfer_priority_t
+ * @brief An enumeration of the priority classes of transfer requests. The agent
+ *        limits the bytes in flight per class, see nixlAgentConfig::priorityMaxBytes,
+ *        and posts the deferred requests of higher classes first.
+ */
+enum class nixl_xfer_priority_t {
+    /** Latency critical, e.g. the KV cache of the next layer */
+    NIXL_XFER_PRIORITY_HIGH,
+    NIXL_XFER_PRIORITY_NORMAL,
+    /** Throughput bound, e.g. prefetch or checkpoints */
+    NIXL_XFER_PRIORITY_BULK,
+    NIXL_XFER_PRIORITY_DEFAULT = NIXL_XFER_PRIORITY_NORMAL,
+};
+
+/**
+ * @brief Number of transfer priority classes
+ */
+constexpr size_t nixl_xfer_priority_count = 3;
+
 /**
  * @namespace nixlEnumStrings
  * @brief     This namespace to get string representation
@@ -99,6 +144,12 @@ typedef std::string nixl_backend_t;
  */
 typedef std::string nixl_blob_t;
 
+/**
+ * @brief A typedef for a uint32_t to identify remote agents in transfer calls
+ *        without their name, interned when their metadata is first loaded.
+ */
+typedef uint32_t nixl_agent_id_t;
+
 /**
  * @brief A typedef for a std::vector<nixl_mem_t> to create nixl_mem_list_t objects.
  */
@@ -116,6 +167,183 @@ typedef std::unordered_map<std::string, std::string> nixl_b_params_t;
  */
 typedef std::unordered_map<std::string, std::vector<nixl_blob_t>> nixl_notifs_t;
 
+/**
+ * @class nixlXferHints
+ * @brief Estimated performance of a backend for transfers between a pair of memory
+ *        types with a peer, declared by the backend or probed when connecting.
+ *        Fields left at 0 are not known.
+ */
+class nixlXferHints {
+    public:
+        double bandwidthGBps = 0; // Sustained bandwidth for large transfers
+        double latencyUs     = 0; // Fixed cost of a transfer
+        size_t chunkSize     = 0; // Preferred largest size of a single descriptor
+};
+/**
+ * @brief A typedef for a nixlXferHints, performance estimates of a backend
+ */
+typedef nixlXferHints nixl_xfer_hints_t;
+
+/**
+ * @class nixlProgressStats
+ * @brief Counters of the progress thread of an agent, to tune its latency against
+ *        its CPU use.
+ */
+class nixlProgressStats {
+    public:
+        uint64_t iterations = 0; // Rounds over the engines
+        uint64_t idleUs     = 0; // Time spent yielding or sleeping between rounds
+        uint64_t sleeps     = 0; // Times it slept after the idle window
+        uint64_t wakeups    = 0; // Sleeps ended by work or events, not the timeout
+};
+
+/**
+ * @class nixlXferQueueStats
+ * @brief Bytes of the transfer requests of an agent held back by its limits, and
+ *        posted to the backends and not found done yet.
+ */
+class nixlXferQueueStats {
+    public:
+        size_t queuedBytes   = 0;
+        size_t queuedReqs    = 0;
+        size_t inflightBytes = 0;
+};
+
+/**
+ * @brief Buckets of the latency histograms of nixlXferTelemetry
+ */
+constexpr size_t nixl_telemetry_buckets = 32;
+
+/**
+ * @class nixlXferTelemetry
+ * @brief Counters of the transfers of an agent on a backend, for an operation and a
+ *        remote agent. Latencies are from the post to the backend until the agent
+ *        finds the request done, in log2 buckets of us: bucket 0 counts those below
+ *        1us, bucket i those from 2^(i-1) up to 2^i us, and the last one the rest.
+ */
+class nixlXferTelemetry {
+    public:
+        nixl_backend_t backend;
+        nixl_xfer_op_t op = NIXL_WRITE;
+        std::string    remoteAgent;
+        uint64_t posts       = 0; // Posts of requests, and of their pieces on this backend
+        uint64_t bytes       = 0; // Bytes of the posts
+        uint64_t completions = 0; // Requests found done, including failed ones
+        uint64_t errors      = 0; // Of the completions, failed posts and transfers
+        std::array<uint64_t, nixl_telemetry_buckets> latencyUs = {};
+
+        // Upper bound in us of the bucket of quantile q, in (0, 1], of the latencies
+        uint64_t getLatencyUs(const double &q) const {
+            uint64_t total = 0, seen = 0;
+
+            for (auto & count : latencyUs)
+                total += count;
+            for (size_t i = 0; i < nixl_telemetry_buckets; ++i) {
+                seen += latencyUs[i];
+                if ((total > 0) && (seen >= q * total))
+                    return 1ULL << i;
+            }
+            return 0;
+        }
+};
+/**
+ * @brief A typedef for the telemetry of an agent, an element per backend,
+ *        operation and remote agent
+ */
+typedef std::vector<nixlXferTelemetry> nixl_xfer_telemetry_t;
+
+/**
+ * @class nixlIndexRange
+ * @brief Indices start, start + stride, ... of count descriptors in a prepared
+ *        descriptor list, to select runs of them without listing each index.
+ */
+class nixlIndexRange {
+    public:
+        int start  = 0;
+        int count  = 0;
+        int stride = 1;
+
+        nixlIndexRange() { }
+        nixlIndexRange(int start, int count, int stride = 1)
+            : start(start), count(count), stride(stride) { }
+};
+/**
+ * @brief A typedef for a std::vector<nixlIndexRange>, selecting their indices in order
+ */
+typedef std::vector<nixlIndexRange> nixl_index_ranges_t;
+
+/**
+ * @class nixlNotifList
+ * @brief Caller owned notifications storage, to be reused across getNotifs calls.
+ *        clear() keeps the allocated entries, and agent names are interned to IDs
+ *        that stay valid for the lifetime of the object, so once warmed up, getting
+ *        notifications doesn't allocate memory for the list itself.
+ */
+class nixlNotifList {
+    private:
+        std::vector<std::string>                      agents;
+        std::vector<std::pair<size_t, nixl_blob_t>>   notifs;
+        size_t                                        count = 0;
+
+    public:
+        /**
+         * @brief Get the ID of an agent name, adding it if seen for the first time
+         */
+        inline size_t agentId(const std::string &agent) {
+            for (size_t i=0; i<agents.size(); ++i)
+                if (agents[i] == agent)
+                    return i;
+            agents.push_back(agent);
+            return agents.size() - 1;
+        }
+        inline const std::string& agentName(const size_t &agent_id) const {
+            return agents[agent_id];
+        }
+        inline size_t agentCount() const { return agents.size(); }
+
+        /**
+         * @brief Append a notification, the message is moved in
+         */
+        inline void add(const std::string &agent, nixl_blob_t &&msg) {
+            size_t agent_id = agentId(agent);
+            if (count == notifs.size()) {
+                notifs.emplace_back(agent_id, std::move(msg));
+            } else {
+                notifs[count].first  = agent_id;
+                notifs[count].second = std::move(msg);
+            }
+            count++;
+        }
+
+        inline size_t size() const { return count; }
+        inline bool empty() const { return count == 0; }
+        inline size_t getAgentId(const size_t &index) const { return notifs[index].first; }
+        inline const nixl_blob_t& getMsg(const size_t &index) const {
+            return notifs[index].second;
+        }
+
+        /**
+         * @brief Drop the notifications, keeping the storage and the interned agents
+         */
+        inline void clear() { count = 0; }
+};
+/**
+ * @brief A typedef for a nixlNotifList, caller owned reusable notifications list
+ */
+typedef nixlNotifList nixl_notif_list_t;
+
+/**
+ * @brief A typedef for a callback called when a transfer request finishes, with
+ *        its final status and the context given along with it
+ */
+typedef void (*nixl_xfer_cb_t)(nixlXferReqH* req_hndl, nixl_status_t status, void* ctx);
+
+/**
+ * @brief A typedef for a callback called when a registration by registerMemAsync
+ *        finishes, with its final status and the context given along with it
+ */
+typedef void (*nixl_reg_cb_t)(nixlRegReqH* reg_hndl, nixl_status_t status, void* ctx);
+
 /**
  * @brief A constant to define the default communication port.
  */
@@ -146,10 +374,84 @@ class nixlAgentOptionalArgs {
         bool hasNotif = false;
 
         /**
-         * @var makeXferReq boolean to skip merging consecutive descriptors, used in makeXferReq.
+         * @var skipDescMerge boolean to skip merging consecutive descriptors, used in makeXferReq and createXferReq.
          */
         bool skipDescMerge = false;
 
+        /**
+         * @var backendPolicy How createXferReq picks the backend among the candidates.
+         */
+        nixl_backend_policy_t backendPolicy = nixl_backend_policy_t::NIXL_BACKEND_POLICY_DEFAULT;
+        /**
+         * @var backendPreference Backend types in order of preference, used in createXferReq
+         *                        when backendPolicy is NIXL_BACKEND_POLICY_PREFERENCE.
+         */
+        std::vector<nixl_backend_t> backendPreference;
+
+        /**
+         * @var splitCount Number of backends to split a transfer over in createXferReq, by
+         *                 equal shares of bytes. The backends are taken in the order of the
+         *                 selection policy among the ones having both sides registered, so
+         *                 fewer pieces are made if there are not enough of them. The pieces
+         *                 are posted together, the request completes when all of them are
+         *                 done, and then the notification is sent, if any.
+         */
+        size_t splitCount = 1;
+
+        /**
+         * @var priority Priority class of a transfer request, used in createXferReq /
+         *               makeXferReq. Backends can post the classes on separate lanes.
+         */
+        nixl_xfer_priority_t priority = nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
+
+        /**
+         * @var useCompletionQueue boolean to report the completion of a transfer request
+         *      through pollCompletions, used in createXferReq / makeXferReq / postXferReq.
+         *      Once set for a request, it stays set until the request is released.
+         */
+        bool useCompletionQueue = false;
+
+        /**
+         * @var xferCallback Called when a posted transfer request finishes, instead of
+         *      adding it to the queue of pollCompletions, used in createXferReq /
+         *      makeXferReq. It's called from the thread that finds the request done:
+         *      the progress thread of backends that report completions, postXferReq,
+         *      getXferStatus, or pollCompletions for the other backends. It's not
+         *      called for posts returning an error, nor after the request is released.
+         *      It is not to call into the agent, and should be short, e.g. to wake a
+         *      waiting thread.
+         */
+        nixl_xfer_cb_t xferCallback = nullptr;
+        /**
+         * @var xferCallbackCtx Context passed to xferCallback.
+         */
+        void* xferCallbackCtx = nullptr;
+
+        /**
+         * @var regCallback Called when a registration by registerMemAsync finishes, from
+         *      the registration thread, once the memory is in the agent metadata. It's
+         *      called before getRegStatus reports the registration done.
+         */
+        nixl_reg_cb_t regCallback = nullptr;
+        /**
+         * @var regCallbackCtx Context passed to regCallback.
+         */
+        void* regCallbackCtx = nullptr;
+
+        /**
+         * @var cudaStream CUDA stream (cudaStream_t) to order the transfer on, used in
+         *                 postXferReq by backends supporting stream-ordered transfers.
+         *                 The transfer starts after the work already queued on the stream
+         *                 and completes before the work queued after it.
+         */
+        void* cudaStream = nullptr;
+        /**
+         * @var cudaEvent CUDA event (cudaEvent_t) recorded on cudaStream after the
+         *                transfer, used in postXferReq along with cudaStream. Completion
+         *                can then be waited for on the GPU, getXferStatus still works.
+         */
+        void* cudaEvent = nullptr;
+
         /**
          * @var includeConnInfo boolean to include connection information in the metadata,
          *                      used in getLocalPartialMD.
@@ -166,6 +468,20 @@ class nixlAgentOptionalArgs {
          *                      used in sendLocalMD, fetchRemoteMD, invalidateLocalMD, sendLocalPartialMD.
          */
         int port = default_comm_port;
+
+        /**
+         * @var mdPeers IP addresses and ports of the peers to broadcast the metadata to in
+         *              sendLocalMD, instead of ipAddr. It is sent to up to mdFanout of them,
+         *              and each forwards it to up to mdFanout of the rest through its listener,
+         *              so the peers take part in sending it to the others.
+         */
+        std::vector<std::pair<std::string, int>> mdPeers;
+        /**
+         * @var mdFanout Number of peers each agent sends the metadata to, in a broadcast
+         *               through mdPeers, up to 64. The peers forward it only to those
+         *               they are connected to or have in mdForwardPeers of their config.
+         */
+        uint32_t mdFanout = 2;
 };
 /**
  * @brief A typedef for a nixlAgentOptionalArgs
@@ -179,4 +495,9 @@ typedef nixlAgentOptionalArgs nixl_opt_args_t;
  */
 #define NIXL_INIT_AGENT ""
 
+/**
+ * @brief A define for an agent id not assigned to any agent.
+ */
+#define NIXL_INVALID_AGENT_ID UINT32_MAX
+
 #endif
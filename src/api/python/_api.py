@@ -14,7 +14,9 @@
 # limitations under the License.
 
 import pickle
-from typing import Optional
+import array
+import asyncio
+from typing import Optional, Union
 
 import torch
 
@@ -27,6 +29,29 @@ nixl_backend_handle = int
 nixl_prepped_dlist_handle = int
 nixl_xfer_handle = int
 
+
+# Integer arrays passed to the bindings as buffers, e.g. NumPy arrays
+def _is_int_buffer(obj) -> bool:
+    return isinstance(obj, (array.array, memoryview)) or hasattr(
+        obj, "__array_interface__"
+    )
+
+
+# Flattened (addr, len, devId) of the tensors, filled without building tuples
+def _tensor_descs(tensors: list[torch.Tensor]) -> Optional[array.array]:
+    tensor_type = tensors[0].device
+    flat = array.array("Q", bytes(24 * len(tensors)))
+
+    for i, tensor in enumerate(tensors):
+        if tensor.device != tensor_type:
+            return None
+        gpu_id = tensor.get_device()
+        flat[3 * i] = tensor.data_ptr()
+        flat[3 * i + 1] = tensor.numel() * tensor.element_size()
+        flat[3 * i + 2] = 0 if gpu_id == -1 else gpu_id  # -1 is DRAM
+    return flat
+
+
 """
 @brief Configuration class for NIXL agent.
 
@@ -93,6 +118,12 @@ class nixl_agent:
         self.backend_mems: dict[str, list[str]] = {}
         self.backend_options: dict[str, dict[str, str]] = {}
 
+        # For transfer_async, requests waited for and the loop watching completions
+        self._completion_waiters: dict[nixl_xfer_handle, asyncio.Future] = {}
+        self._completion_loop: Optional[asyncio.AbstractEventLoop] = None
+        self._completion_timer: Optional[asyncio.TimerHandle] = None
+        self._completion_interval = 0.001
+
         self.plugin_list = self.agent.getAvailPlugins()
         if len(self.plugin_list) == 0:
             print("No plugins available, cannot start transfers!")
@@ -213,6 +244,39 @@ class nixl_agent:
             print("Backend", backend, "not instantiated to get its parameters.")
             return {}
 
+    """
+    @brief  Get the estimated performance of a backend for transfers between two memory types.
+            A transfer takes roughly latency_us plus its size over bandwidth_gbps.
+
+    @param backend Name of the backend.
+    @param local_mem Memory type of the local buffers, e.g. "DRAM" or "VRAM".
+    @param remote_mem Memory type of the remote buffers.
+    @param remote_agent Optional peer, for estimates of the connection to it.
+    @return Dictionary with bandwidth_gbps, latency_us and chunk_size, 0 when not known,
+            or None if the backend has no estimates for the memory types.
+    """
+
+    def get_backend_xfer_hints(
+        self, backend: str, local_mem: str, remote_mem: str, remote_agent: str = ""
+    ) -> Optional[dict]:
+        if backend not in self.backends:
+            print("Backend", backend, "not instantiated to get its hints.")
+            return None
+        try:
+            (bandwidth, latency, chunk) = self.agent.getBackendXferHints(
+                self.backends[backend],
+                self.nixl_mems[local_mem],
+                self.nixl_mems[remote_mem],
+                remote_agent,
+            )
+        except nixlBind.nixlNotSupportedError:
+            return None
+        return {
+            "bandwidth_gbps": bandwidth,
+            "latency_us": latency,
+            "chunk_size": chunk,
+        }
+
     """
     @brief  Initialize a backend with the specified initialization parameters, described above.
 
@@ -291,6 +355,24 @@ class nixl_agent:
 
         self.agent.makeConnection(remote_agent, handle_list)
 
+    """
+    @brief  Make connections to several remote agents at once, overlapping them
+            where the backends can.
+
+    @param remote_agents List of remote agent names.
+    @param backends Optional list of backend names to connect with.
+    @return Dict of the agent names to their connection status, NIXL_SUCCESS (0)
+            or an error code.
+    """
+
+    def make_connections(self, remote_agents: list[str], backends: list[str] = []):
+        handle_list = []
+        for backend_string in backends:
+            handle_list.append(self.backends[backend_string])
+
+        statuses = self.agent.makeConnections(remote_agents, handle_list)
+        return dict(zip(remote_agents, [int(s) for s in statuses]))
+
     """
     @brief  Prepare a transfer descriptor list for data transfer.
             Later, elements from this list can be used to create a transfer request by index.
@@ -339,10 +421,13 @@ class nixl_agent:
     @param operation Type of operation ("WRITE" or "READ").
     @param local_xfer_side Handle to the local transfer descriptor list,
             received from prep_xfer_dlist.
-    @param local_indices List of indices for selecting local descriptors.
+    @param local_indices List of indices for selecting local descriptors, or of
+           (start, count, stride) tuples selecting runs of them. Indices can also be
+           given as a 1-D integer array or CPU tensor, read without conversion to a list.
     @param remote_xfer_side Handle to the remote (or loopback) transfer descriptor list,
             received from prep_xfer_dlist.
-    @param remote_indices List of indices for selecting remote descriptors.
+    @param remote_indices List of indices for selecting remote descriptors, or of
+           (start, count, stride) tuples.
     @param notif_msg Optional notification message to send after transfer is done.
            notif_msg should be bytes, as that is what will be returned to the target, but will work with str too.
     @param backends Optional list of backend names to limit which backends NIXL can use.
@@ -354,9 +439,9 @@ class nixl_agent:
         self,
         operation: str,
         local_xfer_side: nixl_prepped_dlist_handle,
-        local_indices: list[int],
+        local_indices: Union[list[int], list[tuple[int, int, int]], torch.Tensor],
         remote_xfer_side: nixl_prepped_dlist_handle,
-        remote_indices: list[int],
+        remote_indices: Union[list[int], list[tuple[int, int, int]], torch.Tensor],
         notif_msg: bytes = b"",
         backends: list[str] = [],
         skip_desc_merge: bool = False,
@@ -367,6 +452,11 @@ class nixl_agent:
             for backend_string in backends:
                 handle_list.append(self.backends[backend_string])
 
+            if isinstance(local_indices, torch.Tensor):
+                local_indices = local_indices.numpy()
+            if isinstance(remote_indices, torch.Tensor):
+                remote_indices = remote_indices.numpy()
+
             handle = self.agent.makeXferReq(
                 op,
                 local_xfer_side,
@@ -393,7 +483,7 @@ class nixl_agent:
     @param operation Type of operation ("WRITE" or "READ").
     @param local_descs List of local transfer descriptors, from get_xfer_descs.
     @param remote_descs List of remote (or loopback) transfer descriptors, from get_xfer_descs.
-    @param remote_agent Name of the remote agent.
+    @param remote_agent Name of the remote agent, or its id from get_remote_agent_id.
     @param notif_msg Optional notification message.
            notif_msg should be bytes, as that is what will be returned to the target, but will work with str too.
     @param backends Optional list of backend names to limit which backends NIXL can use.
@@ -405,7 +495,7 @@ class nixl_agent:
         operation: str,
         local_descs: nixlBind.nixlXferDList,
         remote_descs: nixlBind.nixlXferDList,
-        remote_agent: str,
+        remote_agent: Union[str, int],
         notif_msg: bytes = b"",
         backends: list[str] = [],
     ) -> nixl_xfer_handle:
@@ -445,6 +535,91 @@ class nixl_agent:
         else:
             return "ERR"
 
+    """
+    @brief  Initiate a data transfer operation and wait for it in asyncio, without polling
+            its state in a loop. Finished requests are taken from the completion queue of
+            the agent when its event fd is readable. Requests on backends that do not report
+            their completions, e.g. UCX without a progress thread, are checked every
+            poll_interval seconds while any request is waited for.
+            The completion queue is drained here, so other users of pollCompletions on the
+            agent would miss completions.
+
+    @param handle Handle to the transfer operation, from make_prepped_xfer, or initialize_xfer.
+    @param notif_msg Optional notification message can be specified or updated per transfer call.
+    @param poll_interval Seconds between checks of requests on non reporting backends.
+    @return Final status of the transfer operation ("DONE" or "ERR").
+    """
+
+    async def transfer_async(
+        self,
+        handle: nixl_xfer_handle,
+        notif_msg: bytes = b"",
+        poll_interval: float = 0.001,
+    ) -> str:
+        loop = asyncio.get_running_loop()
+        if self._completion_loop is not loop:
+            self._watch_completions(loop)
+
+        future = loop.create_future()
+        self._completion_waiters[handle] = future
+        try:
+            status = self.agent.postXferReq(handle, notif_msg, True)
+        except Exception:
+            del self._completion_waiters[handle]
+            raise
+
+        if status != nixlBind.NIXL_IN_PROG:
+            del self._completion_waiters[handle]
+            return "DONE" if status == nixlBind.NIXL_SUCCESS else "ERR"
+
+        self._completion_interval = min(self._completion_interval, poll_interval)
+        if self._completion_timer is None:
+            self._completion_timer = loop.call_later(
+                self._completion_interval, self._poll_completions
+            )
+        return await future
+
+    def _watch_completions(self, loop: asyncio.AbstractEventLoop):
+        if self._completion_loop is not None:
+            self._completion_loop.remove_reader(self._completion_fd)
+            if self._completion_timer is not None:
+                self._completion_timer.cancel()
+                self._completion_timer = None
+        self._completion_fd = self.agent.getCompletionFd()
+        loop.add_reader(self._completion_fd, self._drain_completions)
+        self._completion_loop = loop
+
+    def _drain_completions(self):
+        while True:
+            completed = self.agent.pollCompletions(64)
+            for handle in completed:
+                future = self._completion_waiters.get(handle)
+                if future is None:
+                    continue
+                try:
+                    state = self.check_xfer_state(handle)
+                except Exception as e:
+                    del self._completion_waiters[handle]
+                    if not future.done():
+                        future.set_exception(e)
+                    continue
+                # A completion of a previous post can be taken after it is posted again
+                if state == "PROC":
+                    continue
+                del self._completion_waiters[handle]
+                if not future.done():
+                    future.set_result(state)
+            if len(completed) < 64:
+                break
+
+    def _poll_completions(self):
+        self._completion_timer = None
+        self._drain_completions()
+        if self._completion_waiters and self._completion_loop is not None:
+            self._completion_timer = self._completion_loop.call_later(
+                self._completion_interval, self._poll_completions
+            )
+
     """
     @brief Check the state of a transfer operation.
 
@@ -590,6 +765,52 @@ class nixl_agent:
     def get_agent_metadata(self) -> bytes:
         return self.agent.getLocalMD()
 
+    """
+    @brief Get the changes of the local agent metadata since a version loaded
+           by a remote agent, or all of it if the changes are no longer kept.
+
+    @param since_version Version of the metadata the remote agent holds.
+
+    @return Metadata of the local agent, in bytes.
+    """
+
+    def get_agent_metadata_delta(self, since_version: int) -> bytes:
+        return self.agent.getLocalMDDelta(since_version)
+
+    """
+    @brief Get the version of the local agent metadata, incremented by every
+           registration and deregistration of memory.
+
+    @return Version of the local metadata.
+    """
+
+    def get_agent_metadata_version(self) -> int:
+        return self.agent.getLocalMDVersion()
+
+    """
+    @brief Get the version of the metadata loaded from a remote agent,
+           0 if it only sent unversioned or partial metadata.
+
+    @param remote_agent Name of the remote agent.
+
+    @return Version of the loaded metadata.
+    """
+
+    def get_remote_metadata_version(self, remote_agent: str) -> int:
+        return self.agent.getRemoteMDVersion(remote_agent)
+
+    """
+    @brief Get the id of a remote agent, assigned when its metadata is first loaded.
+           The id can be given to initialize_xfer instead of the agent name.
+
+    @param remote_agent Name of the remote agent.
+
+    @return Id of the remote agent.
+    """
+
+    def get_remote_agent_id(self, remote_agent: str) -> int:
+        return self.agent.getRemoteAgentId(remote_agent)
+
     """
     @brief Get partial metadata of the local agent.
 
@@ -622,6 +843,17 @@ class nixl_agent:
     def send_local_metadata(self, ip_addr: str = "", port: int = DEFAULT_COMM_PORT):
         self.agent.sendLocalMD(ip_addr, port)
 
+    """
+    @brief Send the changes of your metadata since it was last sent to a peer,
+           or all of it the first time.
+
+    @param ip_addr IP address of the peer.
+    @param port    If specified, will try to send to specific port.
+    """
+
+    def send_local_metadata_delta(self, ip_addr: str, port: int = DEFAULT_COMM_PORT):
+        self.agent.sendLocalMDDelta(ip_addr, port)
+
     """
     @brief Send partial metadata of the local agent.
 
@@ -702,9 +934,12 @@ class nixl_agent:
             b) a tensor
             c) a list of tensors
             d) passes along if an xfer_dlist is given.
+            e) an integer array of shape (count, 3), or flattened, of (address, len, device ID),
+               e.g. a NumPy array, alongside a mandatory memory type. Much faster than (a) for
+               long lists, as the array is read in place.
 
     @param descs List of any of the above types
-    @param mem_type Optional memory type necessary for (a).
+    @param mem_type Optional memory type necessary for (a) and (e).
     @param is_sorted Optional bool for if the descriptors are sorted for (a) and (c)
             sort criteria has the comparison order of devID, then addr, then len.
     @return Transfer descriptor list, nixlXferDList.
@@ -720,6 +955,12 @@ class nixl_agent:
 
         if isinstance(descs, nixlBind.nixlXferDList):
             return descs
+        elif _is_int_buffer(descs):
+            if mem_type is not None:
+                new_descs = nixlBind.nixlXferDList(self.nixl_mems[mem_type], descs, is_sorted)
+            else:
+                print("Please specify a mem type if not using Tensors")
+                new_descs = None
         elif isinstance(descs[0], tuple):
             if mem_type is not None and len(descs[0]) == 3:
                 new_descs = nixlBind.nixlXferDList(
@@ -744,19 +985,10 @@ class nixl_agent:
                 is_sorted,
             )
         elif isinstance(descs[0], torch.Tensor):  # List[torch.Tensor]:
-            tensor_type = descs[0].device
-            dlist = [(0, 0, 0)] * len(descs)
-
-            for i in range(len(descs)):
-                if descs[i].device != tensor_type:
-                    return None
-                base_addr = descs[i].data_ptr()
-                region_len = descs[i].numel() * descs[i].element_size()
-                gpu_id = descs[i].get_device()
-                if gpu_id == -1:  # DRAM
-                    gpu_id = 0
-                dlist[i] = (base_addr, region_len, gpu_id)
-            mem_type = "cuda" if str(tensor_type).startswith("cuda") else "cpu"
+            dlist = _tensor_descs(descs)
+            if dlist is None:
+                return None
+            mem_type = "cuda" if str(descs[0].device).startswith("cuda") else "cpu"
             new_descs = nixlBind.nixlXferDList(
                 self.nixl_mems[mem_type], dlist, is_sorted
             )
@@ -774,9 +1006,11 @@ class nixl_agent:
             b) a tensor
             c) a list of tensors
             d) passes along if a reg_dlist is given.
+            e) an integer array of shape (count, 3), or flattened, of (address, len, device ID),
+               e.g. a NumPy array, alongside a mandatory memory type. Meta info is left empty.
 
     @param descs List of any of the above types
-    @param mem_type Optional memory type necessary for (a).
+    @param mem_type Optional memory type necessary for (a) and (e).
     @param is_sorted Optional bool for if the descriptors are sorted for (a) and (c)
             sort criteria has the comparison order of devID, then addr, then len.
     @return Registration descriptor list, nixlRegDList.
@@ -792,6 +1026,12 @@ class nixl_agent:
 
         if isinstance(descs, nixlBind.nixlRegDList):
             return descs
+        elif _is_int_buffer(descs):
+            if mem_type is not None:
+                new_descs = nixlBind.nixlRegDList(self.nixl_mems[mem_type], descs, is_sorted)
+            else:
+                print("Please specify a mem type if not using Tensors")
+                new_descs = None
         elif isinstance(descs[0], tuple):
             if mem_type is not None and len(descs[0]) == 4:
                 new_descs = nixlBind.nixlRegDList(
@@ -816,19 +1056,10 @@ class nixl_agent:
                 is_sorted,
             )
         elif isinstance(descs[0], torch.Tensor):  # List[torch.Tensor]:
-            tensor_type = descs[0].device
-            dlist = [(0, 0, 0, "")] * len(descs)
-
-            for i in range(len(descs)):
-                if descs[i].device != tensor_type:
-                    return None
-                base_addr = descs[i].data_ptr()
-                region_len = descs[i].numel() * descs[i].element_size()
-                gpu_id = descs[i].get_device()
-                if gpu_id == -1:  # DRAM
-                    gpu_id = 0
-                dlist[i] = (base_addr, region_len, gpu_id, "")
-            mem_type = "cuda" if str(tensor_type).startswith("cuda") else "cpu"
+            dlist = _tensor_descs(descs)
+            if dlist is None:
+                return None
+            mem_type = "cuda" if str(descs[0].device).startswith("cuda") else "cpu"
             new_descs = nixlBind.nixlRegDList(
                 self.nixl_mems[mem_type], dlist, is_sorted
             )
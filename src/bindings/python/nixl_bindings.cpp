@@ -20,6 +20,8 @@
 
 #include <tuple>
 #include <iostream>
+#include <cctype>
+#include <cstring>
 
 #include "nixl.h"
 #include "serdes/serdes.h"
@@ -113,6 +115,67 @@ void throw_nixl_exception(const nixl_status_t &status) {
     }
 }
 
+// Integers of an object supporting the buffer protocol, e.g. a NumPy array or an
+// array.array, read in place instead of through a list of Python ints
+class nixlPyIntBuffer {
+    private:
+        py::buffer_info info;
+        bool            isSigned;
+
+    public:
+        nixlPyIntBuffer(const py::buffer &buf) : info(buf.request()) {
+            char fmt = info.format.empty() ? 0 : info.format.back();
+            if ((info.ndim != 1 && info.ndim != 2) || (info.itemsize != 4 && info.itemsize != 8) ||
+                !fmt || !strchr("ilqILQ", fmt))
+                throw nixlInvalidParamError("expected a buffer of 32 or 64 bit integers");
+            isSigned = islower(fmt);
+        }
+
+        ssize_t ndim() const { return info.ndim; }
+        ssize_t shape(int dim) const { return info.shape[dim]; }
+        ssize_t size() const { return info.size; }
+
+        // Element i of a 1-D buffer, or (i, j) of a 2-D one
+        int64_t at(ssize_t i, ssize_t j = 0) const {
+            const char* ptr = (const char*) info.ptr + i * info.strides[0] +
+                              (info.ndim > 1 ? j * info.strides[1] : 0);
+            if (info.itemsize == 8) {
+                int64_t val;
+                memcpy(&val, ptr, sizeof(val));
+                return val;
+            } else if (isSigned) {
+                int32_t val;
+                memcpy(&val, ptr, sizeof(val));
+                return val;
+            } else {
+                uint32_t val;
+                memcpy(&val, ptr, sizeof(val));
+                return val;
+            }
+        }
+
+        // Descriptor count of a (count, 3) buffer of (addr, len, devId), or of its
+        // flattened form of 3 * count integers
+        size_t descCount() const {
+            if ((info.ndim == 2 && info.shape[1] != 3) || (info.ndim == 1 && info.size % 3))
+                throw nixlInvalidParamError("expected descriptors of shape (count, 3)");
+            return info.size / 3;
+        }
+
+        int64_t descField(size_t i, int field) const {
+            return info.ndim == 2 ? at(i, field) : at(3 * i + field);
+        }
+
+        std::vector<int> indices() const {
+            if (info.ndim != 1)
+                throw nixlInvalidParamError("expected a 1-D buffer of indices");
+            std::vector<int> ret(info.size);
+            for (ssize_t i = 0; i < info.size; i++)
+                ret[i] = at(i);
+            return ret;
+        }
+};
+
 PYBIND11_MODULE(_bindings, m) {
 
     //TODO: each nixl class and/or function can be documented in place
@@ -127,7 +190,7 @@ PYBIND11_MODULE(_bindings, m) {
         .value("DRAM_SEG", DRAM_SEG)
         .value("VRAM_SEG", VRAM_SEG)
         .value("BLK_SEG", BLK_SEG)
-        .value("OBJ_SEG", BLK_SEG)
+        .value("OBJ_SEG", OBJ_SEG)
         .value("FILE_SEG", FILE_SEG)
         .export_values();
 
@@ -169,6 +232,17 @@ PYBIND11_MODULE(_bindings, m) {
                 if (sorted) new_list.verifySorted();
                 return new_list;
             }), py::arg("type"), py::arg("descs"), py::arg("sorted")=false)
+        // Descriptors of (addr, len, devId) in a (count, 3) integer buffer
+        .def(py::init([](nixl_mem_t mem, const py::buffer &descs, bool sorted) {
+                nixlPyIntBuffer buf(descs);
+                size_t count = buf.descCount();
+                nixl_xfer_dlist_t new_list(mem, sorted, count);
+                for (size_t i = 0; i < count; i++)
+                    new_list[i] = nixlBasicDesc(buf.descField(i, 0), buf.descField(i, 1),
+                                                buf.descField(i, 2));
+                if (sorted) new_list.verifySorted();
+                return new_list;
+            }), py::arg("type"), py::arg("descs"), py::arg("sorted")=false)
         .def("getType", &nixl_xfer_dlist_t::getType)
         .def("descCount", &nixl_xfer_dlist_t::descCount)
         .def("isEmpty", &nixl_xfer_dlist_t::isEmpty)
@@ -187,11 +261,15 @@ PYBIND11_MODULE(_bindings, m) {
                 list[i] = nixlBasicDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>());
             })
         .def("addDesc", [](nixl_xfer_dlist_t &list, const py::tuple &desc) {
-                list.addDesc(nixlBasicDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>()));
+                list.emplaceDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>());
             })
         .def("append", [](nixl_xfer_dlist_t &list, const py::tuple &desc) {
-                list.addDesc(nixlBasicDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>()));
+                list.emplaceDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>());
             })
+        .def("addStridedDesc", [](nixl_xfer_dlist_t &list, uintptr_t addr, size_t len,
+                                  size_t stride, size_t count, uint64_t dev_id) {
+                list.addStridedDesc(nixlStridedDesc(addr, len, stride, count, dev_id));
+            }, py::arg("addr"), py::arg("len"), py::arg("stride"), py::arg("count"), py::arg("dev_id"))
         .def("index", [](nixl_xfer_dlist_t &list, const py::tuple &desc) {
                 int ret = (nixl_status_t) list.getIndex(nixlBasicDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
                                                   desc[2].cast<uint64_t>()));
@@ -205,7 +283,7 @@ PYBIND11_MODULE(_bindings, m) {
         .def(py::pickle(
             [](const nixl_xfer_dlist_t& self) { // __getstate__
                 nixlSerDes serdes;
-                self.serialize(&serdes);
+                self.serialize(&serdes, true);
                 return py::bytes(serdes.exportStr());
             },
             [](py::bytes serdes_str) { // __setstate__
@@ -226,6 +304,17 @@ PYBIND11_MODULE(_bindings, m) {
                 if (sorted) new_list.verifySorted();
                 return new_list;
             }), py::arg("type"), py::arg("descs"), py::arg("sorted")=false)
+        // Descriptors of (addr, len, devId) in a (count, 3) integer buffer, without meta info
+        .def(py::init([](nixl_mem_t mem, const py::buffer &descs, bool sorted) {
+                nixlPyIntBuffer buf(descs);
+                size_t count = buf.descCount();
+                nixl_reg_dlist_t new_list(mem, sorted, count);
+                for (size_t i = 0; i < count; i++)
+                    new_list[i] = nixlBlobDesc(buf.descField(i, 0), buf.descField(i, 1),
+                                               buf.descField(i, 2), "");
+                if (sorted) new_list.verifySorted();
+                return new_list;
+            }), py::arg("type"), py::arg("descs"), py::arg("sorted")=false)
         .def("getType", &nixl_reg_dlist_t::getType)
         .def("descCount", &nixl_reg_dlist_t::descCount)
         .def("isEmpty", &nixl_reg_dlist_t::isEmpty)
@@ -245,12 +334,12 @@ PYBIND11_MODULE(_bindings, m) {
                 list[i] = nixlBlobDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(), desc[2].cast<uint64_t>(), desc[3].cast<std::string>());
             })
         .def("addDesc", [](nixl_reg_dlist_t &list, const py::tuple &desc) {
-                list.addDesc(nixlBlobDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
-                                            desc[2].cast<uint64_t>(),desc[3].cast<std::string>()));
+                list.emplaceDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
+                                desc[2].cast<uint64_t>(), desc[3].cast<std::string>());
             })
         .def("append", [](nixl_reg_dlist_t &list, const py::tuple &desc) {
-                list.addDesc(nixlBlobDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
-                                            desc[2].cast<uint64_t>(),desc[3].cast<std::string>()));
+                list.emplaceDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
+                                desc[2].cast<uint64_t>(), desc[3].cast<std::string>());
             })
         .def("index", [](nixl_reg_dlist_t &list, const py::tuple &desc) {
                 int ret = list.getIndex(nixlBlobDesc(desc[0].cast<uintptr_t>(), desc[1].cast<size_t>(),
@@ -266,7 +355,7 @@ PYBIND11_MODULE(_bindings, m) {
         .def(py::pickle(
             [](const nixl_reg_dlist_t& self) { // __getstate__
                 nixlSerDes serdes;
-                self.serialize(&serdes);
+                self.serialize(&serdes, true);
                 return py::bytes(serdes.exportStr());
             },
             [](py::bytes serdes_str) { // __setstate__
@@ -287,6 +376,9 @@ PYBIND11_MODULE(_bindings, m) {
     //note: pybind will automatically convert notif_map to python types:
     //so, a Dictionary of string: List<string>
 
+    //calls that can block or spin release the GIL, the Python arguments and
+    //results are converted outside of the release
+
     py::class_<nixlAgent>(m, "nixlAgent")
         .def(py::init<std::string, nixlAgentConfig>())
         .def("getAvailPlugins", [](nixlAgent &agent) -> std::vector<nixl_backend_t> {
@@ -312,12 +404,20 @@ PYBIND11_MODULE(_bindings, m) {
                         mems_vec.push_back(nixlEnumStrings::memTypeStr(elm));
                     return std::make_pair(params, mems_vec);
             })
+        .def("getBackendXferHints", [](nixlAgent &agent, uintptr_t backend, nixl_mem_t local_mem,
+                                       nixl_mem_t remote_mem, const std::string &remote_agent)
+                                       -> std::tuple<double, double, size_t> {
+                    nixl_xfer_hints_t hints;
+                    throw_nixl_exception(agent.getBackendXferHints((nixlBackendH*) backend, local_mem,
+                                                                   remote_mem, remote_agent, hints));
+                    return std::make_tuple(hints.bandwidthGBps, hints.latencyUs, hints.chunkSize);
+            }, py::arg("backend"), py::arg("local_mem"), py::arg("remote_mem"), py::arg("remote_agent") = std::string())
         .def("createBackend", [](nixlAgent &agent, const nixl_backend_t &type, const nixl_b_params_t &initParams) -> uintptr_t {
                     nixlBackendH* backend = nullptr;
                     throw_nixl_exception(agent.createBackend(type, initParams, backend));
                     return (uintptr_t) backend;
-            })
-        .def("registerMem", [](nixlAgent &agent, nixl_reg_dlist_t descs, std::vector<uintptr_t> backends) -> nixl_status_t {
+            }, py::call_guard<py::gil_scoped_release>())
+        .def("registerMem", [](nixlAgent &agent, const nixl_reg_dlist_t &descs, std::vector<uintptr_t> backends) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
                     for(uintptr_t backend: backends)
@@ -326,8 +426,9 @@ PYBIND11_MODULE(_bindings, m) {
                     ret = agent.registerMem(descs, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
-        .def("deregisterMem", [](nixlAgent &agent, nixl_reg_dlist_t descs, std::vector<uintptr_t> backends) -> nixl_status_t {
+                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}),
+                   py::call_guard<py::gil_scoped_release>())
+        .def("deregisterMem", [](nixlAgent &agent, const nixl_reg_dlist_t &descs, std::vector<uintptr_t> backends) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
                     for(uintptr_t backend: backends)
@@ -336,7 +437,8 @@ PYBIND11_MODULE(_bindings, m) {
                     ret = agent.deregisterMem(descs, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
+                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}),
+                   py::call_guard<py::gil_scoped_release>())
         .def("makeConnection", [](nixlAgent &agent,
                                   const std::string &remote_agent,
                                   std::vector<uintptr_t> backends) {
@@ -348,7 +450,19 @@ PYBIND11_MODULE(_bindings, m) {
                     nixl_status_t ret = agent.makeConnection(remote_agent, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, py::call_guard<py::gil_scoped_release>())
+        .def("makeConnections", [](nixlAgent &agent,
+                                   const std::vector<std::string> &remote_agents,
+                                   std::vector<uintptr_t> backends) {
+                    nixl_opt_args_t extra_params;
+                    std::vector<nixl_status_t> statuses;
+
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    agent.makeConnections(remote_agents, statuses, &extra_params);
+                    return statuses;
+                }, py::call_guard<py::gil_scoped_release>())
         .def("prepXferDlist", [](nixlAgent &agent,
                                  std::string &agent_name,
                                  const nixl_xfer_dlist_t &descs,
@@ -362,7 +476,48 @@ PYBIND11_MODULE(_bindings, m) {
                     throw_nixl_exception(agent.prepXferDlist(agent_name, descs, handle, &extra_params));
 
                     return (uintptr_t) handle;
-                }, py::arg("agent_name"), py::arg("descs"), py::arg("backend") = std::vector<uintptr_t>({}))
+                }, py::arg("agent_name"), py::arg("descs"), py::arg("backend") = std::vector<uintptr_t>({}),
+                   py::call_guard<py::gil_scoped_release>())
+        // Indices in 1-D integer buffers, registered first as NumPy arrays would
+        // otherwise be taken element by element by the list overload
+        .def("makeXferReq", [](nixlAgent &agent,
+                               const nixl_xfer_op_t &operation,
+                               uintptr_t local_side,
+                               const py::buffer &local_indices,
+                               uintptr_t remote_side,
+                               const py::buffer &remote_indices,
+                               const std::string &notif_msg,
+                               std::vector<uintptr_t> backends,
+                               bool skip_desc_merge) -> uintptr_t {
+                    nixlXferReqH* handle = nullptr;
+                    nixl_opt_args_t extra_params;
+                    std::vector<int> local  = nixlPyIntBuffer(local_indices).indices();
+                    std::vector<int> remote = nixlPyIntBuffer(remote_indices).indices();
+
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    if (notif_msg.size()>0) {
+                        extra_params.notifMsg = notif_msg;
+                        extra_params.hasNotif = true;
+                    }
+                    extra_params.skipDescMerge = skip_desc_merge;
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.makeXferReq(operation,
+                                                (nixlDlistH*) local_side, local,
+                                                (nixlDlistH*) remote_side, remote,
+                                                handle, &extra_params);
+                    }
+                    throw_nixl_exception(ret);
+
+                    return (uintptr_t) handle;
+                }, py::arg("operation"), py::arg("local_side"),
+                   py::arg("local_indices"), py::arg("remote_side"),
+                   py::arg("remote_indices"), py::arg("notif_msg") = std::string(""),
+                   py::arg("backend") = std::vector<uintptr_t>({}),
+                   py::arg("skip_desc_merg") = false)
         .def("makeXferReq", [](nixlAgent &agent,
                                const nixl_xfer_op_t &operation,
                                uintptr_t local_side,
@@ -393,7 +548,45 @@ PYBIND11_MODULE(_bindings, m) {
                    py::arg("local_indices"), py::arg("remote_side"),
                    py::arg("remote_indices"), py::arg("notif_msg") = std::string(""),
                    py::arg("backend") = std::vector<uintptr_t>({}),
-                   py::arg("skip_desc_merg") = false)
+                   py::arg("skip_desc_merg") = false, py::call_guard<py::gil_scoped_release>())
+        .def("makeXferReq", [](nixlAgent &agent,
+                               const nixl_xfer_op_t &operation,
+                               uintptr_t local_side,
+                               const std::vector<std::tuple<int, int, int>> &local_ranges,
+                               uintptr_t remote_side,
+                               const std::vector<std::tuple<int, int, int>> &remote_ranges,
+                               const std::string &notif_msg,
+                               std::vector<uintptr_t> backends,
+                               bool skip_desc_merge) -> uintptr_t {
+                    nixlXferReqH* handle = nullptr;
+                    nixl_opt_args_t extra_params;
+                    nixl_index_ranges_t local, remote;
+
+                    // (start, count, stride) tuples
+                    for (auto & r : local_ranges)
+                        local.emplace_back(std::get<0>(r), std::get<1>(r), std::get<2>(r));
+                    for (auto & r : remote_ranges)
+                        remote.emplace_back(std::get<0>(r), std::get<1>(r), std::get<2>(r));
+
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    if (notif_msg.size()>0) {
+                        extra_params.notifMsg = notif_msg;
+                        extra_params.hasNotif = true;
+                    }
+                    extra_params.skipDescMerge = skip_desc_merge;
+                    throw_nixl_exception(agent.makeXferReq(operation,
+                                                           (nixlDlistH*) local_side, local,
+                                                           (nixlDlistH*) remote_side, remote,
+                                                           handle, &extra_params));
+
+                    return (uintptr_t) handle;
+                }, py::arg("operation"), py::arg("local_side"),
+                   py::arg("local_ranges"), py::arg("remote_side"),
+                   py::arg("remote_ranges"), py::arg("notif_msg") = std::string(""),
+                   py::arg("backend") = std::vector<uintptr_t>({}),
+                   py::arg("skip_desc_merg") = false, py::call_guard<py::gil_scoped_release>())
         .def("createXferReq", [](nixlAgent &agent,
                                  const nixl_xfer_op_t &operation,
                                  const nixl_xfer_dlist_t &local_descs,
@@ -418,24 +611,67 @@ PYBIND11_MODULE(_bindings, m) {
                 }, py::arg("operation"), py::arg("local_descs"),
                    py::arg("remote_descs"), py::arg("remote_agent"),
                    py::arg("notif_msg") = std::string(""),
-                   py::arg("backend") = std::vector<uintptr_t>({}))
-        .def("postXferReq", [](nixlAgent &agent, uintptr_t reqh, std::string notif_msg) -> nixl_status_t {
+                   py::arg("backend") = std::vector<uintptr_t>({}),
+                      py::call_guard<py::gil_scoped_release>())
+        .def("createXferReq", [](nixlAgent &agent,
+                                 const nixl_xfer_op_t &operation,
+                                 const nixl_xfer_dlist_t &local_descs,
+                                 const nixl_xfer_dlist_t &remote_descs,
+                                 nixl_agent_id_t remote_id,
+                                 const std::string &notif_msg,
+                                 std::vector<uintptr_t> backends) -> uintptr_t {
+                    nixlXferReqH* handle = nullptr;
+                    nixl_opt_args_t extra_params;
+
+                    for(uintptr_t backend: backends)
+                        extra_params.backends.push_back((nixlBackendH*) backend);
+
+                    if (notif_msg.size()>0) {
+                        extra_params.notifMsg = notif_msg;
+                        extra_params.hasNotif = true;
+                    }
+                    nixl_status_t ret = agent.createXferReq(operation, local_descs, remote_descs, remote_id, handle, &extra_params);
+
+                    throw_nixl_exception(ret);
+                    return (uintptr_t) handle;
+                }, py::arg("operation"), py::arg("local_descs"),
+                   py::arg("remote_descs"), py::arg("remote_agent"),
+                   py::arg("notif_msg") = std::string(""),
+                   py::arg("backend") = std::vector<uintptr_t>({}),
+                      py::call_guard<py::gil_scoped_release>())
+        .def("postXferReq", [](nixlAgent &agent, uintptr_t reqh, std::string notif_msg,
+                               bool use_completion_queue) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
+                    extra_params.useCompletionQueue = use_completion_queue;
                     if (notif_msg.size()>0) {
                         extra_params.notifMsg = notif_msg;
                         extra_params.hasNotif = true;
                         ret = agent.postXferReq((nixlXferReqH*) reqh, &extra_params);
+                    } else if (use_completion_queue) {
+                        ret = agent.postXferReq((nixlXferReqH*) reqh, &extra_params);
                     } else {
                         ret = agent.postXferReq((nixlXferReqH*) reqh);
                     }
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("reqh"), py::arg("notif_msg") = std::string(""))
+                }, py::arg("reqh"), py::arg("notif_msg") = std::string(""),
+                   py::arg("use_completion_queue") = false,
+                   py::call_guard<py::gil_scoped_release>())
         .def("getXferStatus", [](nixlAgent &agent, uintptr_t reqh) -> nixl_status_t {
                     nixl_status_t ret = agent.getXferStatus((nixlXferReqH*) reqh);
                     throw_nixl_exception(ret);
                     return ret;
+                }, py::call_guard<py::gil_scoped_release>())
+        .def("pollCompletions", [](nixlAgent &agent, size_t max) -> std::vector<uintptr_t> {
+                    std::vector<nixlXferReqH*> completed;
+                    throw_nixl_exception(agent.pollCompletions(max, completed));
+                    return std::vector<uintptr_t>(completed.begin(), completed.end());
+                }, py::arg("max") = 64, py::call_guard<py::gil_scoped_release>())
+        .def("getCompletionFd", [](nixlAgent &agent) -> int {
+                    int fd = -1;
+                    throw_nixl_exception(agent.getCompletionFd(fd));
+                    return fd;
                 })
         .def("queryXferBackend", [](nixlAgent &agent, uintptr_t reqh) -> uintptr_t {
                     nixlBackendH* backend = nullptr;
@@ -446,7 +682,7 @@ PYBIND11_MODULE(_bindings, m) {
                     nixl_status_t ret = agent.releaseXferReq((nixlXferReqH*) reqh);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, py::call_guard<py::gil_scoped_release>())
         .def("releasedDlistH", [](nixlAgent &agent, uintptr_t handle) -> nixl_status_t {
                     nixl_status_t ret = agent.releasedDlistH((nixlDlistH*) handle);
                     throw_nixl_exception(ret);
@@ -461,7 +697,11 @@ PYBIND11_MODULE(_bindings, m) {
                     for(uintptr_t backend: backends)
                         extra_params.backends.push_back((nixlBackendH*) backend);
 
-                    nixl_status_t ret = agent.getNotifs(new_notifs, &extra_params);
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.getNotifs(new_notifs, &extra_params);
+                    }
 
                     throw_nixl_exception(ret);
 
@@ -485,14 +725,35 @@ PYBIND11_MODULE(_bindings, m) {
 
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("remote_agent"), py::arg("msg"), py::arg("backends") = std::vector<uintptr_t>({}))
+                }, py::arg("remote_agent"), py::arg("msg"), py::arg("backends") = std::vector<uintptr_t>({}),
+                   py::call_guard<py::gil_scoped_release>())
         .def("getLocalMD", [](nixlAgent &agent) -> py::bytes {
                     //python can only interpret text strings
                     std::string ret_str("");
                     throw_nixl_exception(agent.getLocalMD(ret_str));
                     return py::bytes(ret_str);
                 })
-        .def("getLocalPartialMD", [](nixlAgent &agent, nixl_reg_dlist_t descs, bool inc_conn_info, std::vector<uintptr_t> backends) -> py::bytes {
+        .def("getLocalMDDelta", [](nixlAgent &agent, uint64_t since_version) -> py::bytes {
+                    std::string ret_str("");
+                    throw_nixl_exception(agent.getLocalMDDelta(since_version, ret_str));
+                    return py::bytes(ret_str);
+                }, py::arg("since_version"))
+        .def("getLocalMDVersion", [](nixlAgent &agent) -> uint64_t {
+                    uint64_t version = 0;
+                    throw_nixl_exception(agent.getLocalMDVersion(version));
+                    return version;
+                })
+        .def("getRemoteMDVersion", [](nixlAgent &agent, const std::string &remote_agent) -> uint64_t {
+                    uint64_t version = 0;
+                    throw_nixl_exception(agent.getRemoteMDVersion(remote_agent, version));
+                    return version;
+                }, py::arg("remote_agent"))
+        .def("getRemoteAgentId", [](nixlAgent &agent, const std::string &remote_agent) -> nixl_agent_id_t {
+                    nixl_agent_id_t agent_id = NIXL_INVALID_AGENT_ID;
+                    throw_nixl_exception(agent.getRemoteAgentId(remote_agent, agent_id));
+                    return agent_id;
+                }, py::arg("remote_agent"))
+        .def("getLocalPartialMD", [](nixlAgent &agent, const nixl_reg_dlist_t &descs, bool inc_conn_info, std::vector<uintptr_t> backends) -> py::bytes {
                     std::string ret_str("");
 
                     nixl_opt_args_t extra_params;
@@ -511,9 +772,19 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.sendLocalMD(&extra_params));
-                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
+                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0,
+                   py::call_guard<py::gil_scoped_release>())
+        .def("sendLocalMDDelta", [](nixlAgent &agent, std::string ip_addr, int port){
+                    nixl_opt_args_t extra_params;
 
-        .def("sendLocalPartialMD", [](nixlAgent &agent, nixl_reg_dlist_t descs, bool inc_conn_info, std::vector<uintptr_t> backends, std::string ip_addr, int port) {
+                    extra_params.ipAddr = ip_addr;
+                    extra_params.port = port;
+
+                    throw_nixl_exception(agent.sendLocalMDDelta(&extra_params));
+                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0,
+                   py::call_guard<py::gil_scoped_release>())
+
+        .def("sendLocalPartialMD", [](nixlAgent &agent, const nixl_reg_dlist_t &descs, bool inc_conn_info, std::vector<uintptr_t> backends, std::string ip_addr, int port) {
                     std::string ret_str("");
 
                     nixl_opt_args_t extra_params;
@@ -525,7 +796,8 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.sendLocalPartialMD(descs, &extra_params));
-                }, py::arg("descs"), py::arg("inc_conn_info") = false, py::arg("backends") = std::vector<uintptr_t>({}), py::arg("ip_addr") = std::string(""), py::arg("port") = 0)
+                }, py::arg("descs"), py::arg("inc_conn_info") = false, py::arg("backends") = std::vector<uintptr_t>({}), py::arg("ip_addr") = std::string(""), py::arg("port") = 0,
+                   py::call_guard<py::gil_scoped_release>())
         .def("fetchRemoteMD", [](nixlAgent &agent, std::string remote_agent, std::string ip_addr, int port){
                     nixl_opt_args_t extra_params;
 
@@ -533,7 +805,8 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.fetchRemoteMD(remote_agent, &extra_params));
-                }, py::arg("remote_agent"), py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
+                }, py::arg("remote_agent"), py::arg("ip_addr") = std::string(""), py::arg("port") = 0,
+                   py::call_guard<py::gil_scoped_release>())
         .def("invalidateLocalMD", [](nixlAgent &agent, std::string ip_addr, int port){
                     nixl_opt_args_t extra_params;
 
@@ -541,11 +814,17 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.invalidateLocalMD(&extra_params));
-                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
+                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0,
+                   py::call_guard<py::gil_scoped_release>())
         .def("loadRemoteMD", [](nixlAgent &agent, const std::string &remote_metadata) -> py::bytes {
                     //python can only interpret text strings
                     std::string remote_name("");
-                    throw_nixl_exception(agent.loadRemoteMD(remote_metadata, remote_name));
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.loadRemoteMD(remote_metadata, remote_name);
+                    }
+                    throw_nixl_exception(ret);
                     return py::bytes(remote_name);
                 })
         .def("invalidateRemoteMD", &nixlAgent::invalidateRemoteMD);
@@ -45,9 +45,10 @@ use bindings::{
     nixl_capi_deregister_mem, nixl_capi_destroy_agent, nixl_capi_destroy_backend,
     nixl_capi_destroy_mem_list, nixl_capi_destroy_notif_map, nixl_capi_destroy_opt_args,
     nixl_capi_destroy_params, nixl_capi_destroy_reg_dlist, nixl_capi_destroy_string_list,
-    nixl_capi_destroy_xfer_dlist, nixl_capi_get_available_plugins, nixl_capi_get_backend_params,
-    nixl_capi_get_local_md, nixl_capi_get_notifs, nixl_capi_get_plugin_params,
-    nixl_capi_get_xfer_status, nixl_capi_invalidate_remote_md, nixl_capi_load_remote_md,
+    nixl_capi_destroy_xfer_dlist, nixl_capi_drain_notifs, nixl_capi_get_available_plugins,
+    nixl_capi_get_backend_params, nixl_capi_get_local_md, nixl_capi_get_notifs,
+    nixl_capi_get_plugin_params, nixl_capi_get_xfer_status, nixl_capi_get_xfer_statuses,
+    nixl_capi_invalidate_remote_md, nixl_capi_load_remote_md,
     nixl_capi_mem_list_get, nixl_capi_mem_list_is_empty, nixl_capi_mem_list_size,
     nixl_capi_mem_type_t, nixl_capi_mem_type_to_string, nixl_capi_notif_map_get_agent_at,
     nixl_capi_notif_map_get_notif, nixl_capi_notif_map_get_notifs_size, nixl_capi_notif_map_size,
@@ -56,10 +57,12 @@ use bindings::{
     nixl_capi_opt_args_set_has_notif, nixl_capi_opt_args_set_notif_msg,
     nixl_capi_opt_args_set_skip_desc_merge, nixl_capi_params_create_iterator,
     nixl_capi_params_destroy_iterator, nixl_capi_params_is_empty, nixl_capi_params_iterator_next,
-    nixl_capi_post_xfer_req, nixl_capi_reg_dlist_add_desc, nixl_capi_reg_dlist_clear,
+    nixl_capi_post_xfer_req, nixl_capi_post_xfer_reqs, nixl_capi_reg_dlist_add_desc,
+    nixl_capi_reg_dlist_add_descs, nixl_capi_reg_dlist_clear,
     nixl_capi_reg_dlist_has_overlaps, nixl_capi_reg_dlist_len, nixl_capi_reg_dlist_resize,
     nixl_capi_register_mem, nixl_capi_string_list_get, nixl_capi_string_list_size,
-    nixl_capi_xfer_dlist_add_desc, nixl_capi_xfer_dlist_clear, nixl_capi_xfer_dlist_has_overlaps,
+    nixl_capi_xfer_dlist_add_desc, nixl_capi_xfer_dlist_add_descs, nixl_capi_xfer_dlist_clear,
+    nixl_capi_xfer_dlist_has_overlaps,
     nixl_capi_xfer_dlist_len, nixl_capi_xfer_dlist_resize,
 };
 
@@ -92,6 +95,15 @@ pub enum NixlError {
     RegDescAddFailed,
 }
 
+/// A descriptor of the bulk functions, laid out as `nixl_capi_desc_t`
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Desc {
+    pub addr: usize,
+    pub len: usize,
+    pub dev_id: u64,
+}
+
 /// Memory types supported by NIXL
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum MemType {
@@ -745,6 +757,96 @@ impl Agent {
         }
     }
 
+    /// Posts a batch of transfer requests in one call
+    ///
+    /// Returns `Ok(true)` if any of them is in progress, `Ok(false)` if all completed.
+    ///
+    /// # Arguments
+    /// * `reqs` - Transfer request handles obtained from `create_xfer_req`
+    /// * `opt_args` - Optional arguments for the transfer requests
+    pub fn post_xfer_reqs(
+        &self,
+        reqs: &[&XferRequest],
+        opt_args: Option<&OptArgs>,
+    ) -> Result<bool, NixlError> {
+        let handles: Vec<_> = reqs.iter().map(|req| req.inner.as_ptr()).collect();
+        let status = unsafe {
+            nixl_capi_post_xfer_reqs(
+                self.inner.write().unwrap().handle.as_ptr(),
+                handles.as_ptr(),
+                handles.len(),
+                ptr::null_mut(),
+                opt_args.map_or(ptr::null_mut(), |args| args.inner.as_ptr()),
+            )
+        };
+
+        match status {
+            NIXL_CAPI_SUCCESS => Ok(false),
+            NIXL_CAPI_IN_PROG => Ok(true),
+            NIXL_CAPI_ERROR_INVALID_PARAM => Err(NixlError::InvalidParam),
+            _ => Err(NixlError::BackendError),
+        }
+    }
+
+    /// Checks the status of a batch of transfer requests in one call
+    ///
+    /// Returns `Ok(true)` if any of them is still in progress, `Ok(false)` if all completed.
+    ///
+    /// # Arguments
+    /// * `reqs` - Transfer request handles after `post_xfer_req` or `post_xfer_reqs`
+    pub fn get_xfer_statuses(&self, reqs: &[&XferRequest]) -> Result<bool, NixlError> {
+        let handles: Vec<_> = reqs.iter().map(|req| req.inner.as_ptr()).collect();
+        let status = unsafe {
+            nixl_capi_get_xfer_statuses(
+                self.inner.write().unwrap().handle.as_ptr(),
+                handles.as_ptr(),
+                handles.len(),
+                ptr::null_mut(),
+            )
+        };
+
+        match status {
+            NIXL_CAPI_SUCCESS => Ok(false),
+            NIXL_CAPI_IN_PROG => Ok(true),
+            NIXL_CAPI_ERROR_INVALID_PARAM => Err(NixlError::InvalidParam),
+            _ => Err(NixlError::BackendError),
+        }
+    }
+
+    /// Takes new notifications into a reusable buffer, without allocating per notification
+    ///
+    /// Returns `Ok(true)` if more notifications are pending that did not fit.
+    ///
+    /// # Arguments
+    /// * `notifs` - Buffer to drain the notifications into, replacing its contents
+    /// * `opt_args` - Optional arguments to filter notifications by backend
+    pub fn drain_notifications(
+        &self,
+        notifs: &mut NotificationBuffer,
+        opt_args: Option<&OptArgs>,
+    ) -> Result<bool, NixlError> {
+        let mut has_more = false;
+        notifs.count = 0;
+        let status = unsafe {
+            nixl_capi_drain_notifs(
+                self.inner.write().unwrap().handle.as_ptr(),
+                notifs.notifs.as_mut_ptr() as *mut bindings::nixl_capi_notif_t,
+                notifs.notifs.len(),
+                notifs.data.as_mut_ptr() as *mut std::ffi::c_void,
+                notifs.data.len(),
+                &mut notifs.count,
+                &mut has_more,
+                opt_args.map_or(ptr::null_mut(), |args| args.inner.as_ptr()),
+            )
+        };
+
+        match status {
+            NIXL_CAPI_SUCCESS => Ok(has_more),
+            NIXL_CAPI_ERROR_INVALID_PARAM => Err(NixlError::InvalidParam),
+            _ => Err(NixlError::BackendError),
+        }
+    }
+
     /// Gets notifications from other agents
     ///
     /// # Arguments
@@ -1192,6 +1294,23 @@ impl<'a> XferDescList<'a> {
         }
     }
 
+    /// Adds the descriptors of a slice in one call
+    pub fn add_descs(&mut self, descs: &[Desc]) -> Result<(), NixlError> {
+        let status = unsafe {
+            nixl_capi_xfer_dlist_add_descs(
+                self.inner.as_ptr(),
+                descs.as_ptr() as *const bindings::nixl_capi_desc_t,
+                descs.len(),
+            )
+        };
+
+        match status {
+            NIXL_CAPI_SUCCESS => Ok(()),
+            NIXL_CAPI_ERROR_INVALID_PARAM => Err(NixlError::InvalidParam),
+            _ => Err(NixlError::BackendError),
+        }
+    }
+
     /// Returns the number of descriptors in the list
     pub fn len(&self) -> Result<usize, NixlError> {
         let mut len = 0;
@@ -1333,6 +1452,23 @@ impl<'a> RegDescList<'a> {
         }
     }
 
+    /// Adds the descriptors of a slice in one call
+    pub fn add_descs(&mut self, descs: &[Desc]) -> Result<(), NixlError> {
+        let status = unsafe {
+            nixl_capi_reg_dlist_add_descs(
+                self.inner.as_ptr(),
+                descs.as_ptr() as *const bindings::nixl_capi_desc_t,
+                descs.len(),
+            )
+        };
+
+        match status {
+            NIXL_CAPI_SUCCESS => Ok(()),
+            NIXL_CAPI_ERROR_INVALID_PARAM => Err(NixlError::InvalidParam),
+            _ => Err(NixlError::BackendError),
+        }
+    }
+
     /// Returns the number of descriptors in the list
     pub fn len(&self) -> Result<usize, NixlError> {
         let mut len = 0;
@@ -1664,6 +1800,64 @@ impl NotificationMap {
     }
 }
 
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct RawNotif {
+    agent_name: *const std::os::raw::c_char,
+    msg: *const u8,
+    msg_len: usize,
+}
+
+/// A reusable buffer of notifications for `Agent::drain_notifications`, holding the
+/// agent names and messages of up to a number of notifications in one allocation
+pub struct NotificationBuffer {
+    notifs: Vec<RawNotif>,
+    data: Vec<u8>,
+    count: usize,
+}
+
+// SAFETY: The pointers of the notifications only point into the buffer itself
+unsafe impl Send for NotificationBuffer {}
+
+impl NotificationBuffer {
+    /// Creates a buffer for up to `max_notifs` notifications of `data_len` bytes in total,
+    /// counting the agent names with a terminating byte
+    pub fn new(max_notifs: usize, data_len: usize) -> Self {
+        let empty = RawNotif {
+            agent_name: ptr::null(),
+            msg: ptr::null(),
+            msg_len: 0,
+        };
+        Self {
+            notifs: vec![empty; max_notifs],
+            data: vec![0; data_len],
+            count: 0,
+        }
+    }
+
+    /// Returns the number of notifications drained
+    pub fn len(&self) -> usize {
+        self.count
+    }
+
+    /// Returns true if no notifications were drained
+    pub fn is_empty(&self) -> bool {
+        self.count == 0
+    }
+
+    /// Returns an iterator over the (agent name, message) pairs drained
+    pub fn iter(&self) -> impl Iterator<Item = (&str, &[u8])> + '_ {
+        self.notifs[..self.count].iter().map(|notif| {
+            // SAFETY: The pointers were set by nixl_capi_drain_notifs into self.data
+            unsafe {
+                let name = CStr::from_ptr(notif.agent_name).to_str().unwrap_or("");
+                let msg = std::slice::from_raw_parts(notif.msg, notif.msg_len);
+                (name, msg)
+            }
+        })
+    }
+}
+
 /// An iterator over agent names in a NotificationMap
 pub struct NotificationMapAgentIterator<'a> {
     map: &'a NotificationMap,
@@ -157,6 +157,29 @@ mod tests {
         assert!(dlist.has_overlaps().unwrap());
     }
 
+    #[test]
+    fn test_xfer_dlist_bulk() {
+        let mut dlist = XferDescList::new(MemType::Dram).unwrap();
+        let descs: Vec<Desc> = (0..1024)
+            .map(|i| Desc {
+                addr: 0x1000 + i * 0x100,
+                len: 0x100,
+                dev_id: 0,
+            })
+            .collect();
+
+        dlist.add_descs(&descs).unwrap();
+        assert_eq!(dlist.len().unwrap(), 1024);
+        assert!(!dlist.has_overlaps().unwrap());
+
+        dlist.add_desc(0x1050, 0x100, 0).unwrap();
+        assert!(dlist.has_overlaps().unwrap());
+
+        let mut reg_list = RegDescList::new(MemType::Dram).unwrap();
+        reg_list.add_descs(&descs[..16]).unwrap();
+        assert_eq!(reg_list.len().unwrap(), 16);
+    }
+
     #[test]
     fn test_reg_dlist() {
         let mut dlist = RegDescList::new(MemType::Dram).unwrap();
@@ -32,6 +32,9 @@ extern "C" {
 // Internal struct definitions to match our opaque types
 struct nixl_capi_agent_s {
   nixlAgent* inner;
+  // Notifications taken by nixl_capi_drain_notifs, from index drained_notifs on not yet returned
+  nixl_notif_list_t notifs;
+  size_t drained_notifs = 0;
 };
 
 struct nixl_capi_string_list_s {
@@ -1241,4 +1244,177 @@ nixl_capi_notif_map_get_notif(
   }
 }
 
+namespace {
+
+nixl_capi_status_t
+to_capi_status(nixl_status_t ret)
+{
+  return ret == NIXL_SUCCESS ? NIXL_CAPI_SUCCESS : ret == NIXL_IN_PROG ? NIXL_CAPI_IN_PROG : NIXL_CAPI_ERROR_BACKEND;
+}
+
+// Handles of the requests of a bulk call, kept per thread to not allocate on each call
+std::vector<nixlXferReqH*>&
+bulk_handles(const nixl_capi_xfer_req_t* reqs, size_t count)
+{
+  thread_local std::vector<nixlXferReqH*> handles;
+  handles.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    handles[i] = reqs[i] ? reqs[i]->req : nullptr;
+  }
+  return handles;
+}
+
+nixl_capi_status_t
+bulk_result(const std::vector<nixl_status_t>& rets, nixl_capi_status_t* statuses)
+{
+  nixl_capi_status_t result = NIXL_CAPI_SUCCESS;
+  for (size_t i = 0; i < rets.size(); i++) {
+    nixl_capi_status_t status = to_capi_status(rets[i]);
+    if (statuses) {
+      statuses[i] = status;
+    }
+    if (status == NIXL_CAPI_ERROR_BACKEND && result != NIXL_CAPI_ERROR_BACKEND) {
+      result = status;
+    } else if (status == NIXL_CAPI_IN_PROG && result == NIXL_CAPI_SUCCESS) {
+      result = status;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+nixl_capi_status_t
+nixl_capi_xfer_dlist_add_descs(nixl_capi_xfer_dlist_t dlist, const nixl_capi_desc_t* descs, size_t count)
+{
+  if (!dlist || (!descs && count)) {
+    return NIXL_CAPI_ERROR_INVALID_PARAM;
+  }
+
+  try {
+    dlist->dlist->reserve(dlist->dlist->descCount() + count);
+    for (size_t i = 0; i < count; i++) {
+      dlist->dlist->emplaceDesc(descs[i].addr, descs[i].len, descs[i].dev_id);
+    }
+    return NIXL_CAPI_SUCCESS;
+  }
+  catch (...) {
+    return NIXL_CAPI_ERROR_BACKEND;
+  }
+}
+
+nixl_capi_status_t
+nixl_capi_reg_dlist_add_descs(nixl_capi_reg_dlist_t dlist, const nixl_capi_desc_t* descs, size_t count)
+{
+  if (!dlist || (!descs && count)) {
+    return NIXL_CAPI_ERROR_INVALID_PARAM;
+  }
+
+  try {
+    dlist->dlist->reserve(dlist->dlist->descCount() + count);
+    for (size_t i = 0; i < count; i++) {
+      dlist->dlist->emplaceDesc(descs[i].addr, descs[i].len, descs[i].dev_id);  // Empty metadata
+    }
+    return NIXL_CAPI_SUCCESS;
+  }
+  catch (...) {
+    return NIXL_CAPI_ERROR_BACKEND;
+  }
+}
+
+nixl_capi_status_t
+nixl_capi_post_xfer_reqs(
+    nixl_capi_agent_t agent, const nixl_capi_xfer_req_t* reqs, size_t count, nixl_capi_status_t* statuses,
+    nixl_capi_opt_args_t opt_args)
+{
+  if (!agent || (!reqs && count)) {
+    return NIXL_CAPI_ERROR_INVALID_PARAM;
+  }
+
+  try {
+    thread_local std::vector<nixl_status_t> rets;
+    agent->inner->postXferReqs(bulk_handles(reqs, count), rets, opt_args ? &opt_args->args : nullptr);
+    rets.resize(count, NIXL_ERR_BACKEND);
+    return bulk_result(rets, statuses);
+  }
+  catch (...) {
+    return NIXL_CAPI_ERROR_BACKEND;
+  }
+}
+
+nixl_capi_status_t
+nixl_capi_get_xfer_statuses(
+    nixl_capi_agent_t agent, const nixl_capi_xfer_req_t* reqs, size_t count, nixl_capi_status_t* statuses)
+{
+  if (!agent || (!reqs && count)) {
+    return NIXL_CAPI_ERROR_INVALID_PARAM;
+  }
+
+  try {
+    thread_local std::vector<nixl_status_t> rets;
+    agent->inner->getXferStatus(bulk_handles(reqs, count), rets);
+    rets.resize(count, NIXL_ERR_BACKEND);
+    return bulk_result(rets, statuses);
+  }
+  catch (...) {
+    return NIXL_CAPI_ERROR_BACKEND;
+  }
+}
+
+nixl_capi_status_t
+nixl_capi_drain_notifs(
+    nixl_capi_agent_t agent, nixl_capi_notif_t* notifs, size_t max_notifs, void* buf, size_t buf_len,
+    size_t* count, bool* has_more, nixl_capi_opt_args_t opt_args)
+{
+  if (!agent || !count || (!notifs && max_notifs) || (!buf && buf_len)) {
+    return NIXL_CAPI_ERROR_INVALID_PARAM;
+  }
+
+  try {
+    nixl_notif_list_t& list = agent->notifs;
+    if (agent->drained_notifs == list.size()) {
+      list.clear();
+      agent->drained_notifs = 0;
+      if (agent->inner->getNotifs(list, opt_args ? &opt_args->args : nullptr) != NIXL_SUCCESS) {
+        return NIXL_CAPI_ERROR_BACKEND;
+      }
+    }
+
+    char* out = static_cast<char*>(buf);
+    size_t used = 0;
+    size_t n = 0;
+    while (n < max_notifs && agent->drained_notifs < list.size()) {
+      const std::string& name = list.agentName(list.getAgentId(agent->drained_notifs));
+      const nixl_blob_t& msg = list.getMsg(agent->drained_notifs);
+      size_t needed = name.size() + 1 + msg.size();
+      if (used + needed > buf_len) {
+        if (n == 0) {
+          return NIXL_CAPI_ERROR_INVALID_PARAM;
+        }
+        break;
+      }
+
+      memcpy(out + used, name.c_str(), name.size() + 1);
+      notifs[n].agent_name = out + used;
+      used += name.size() + 1;
+      memcpy(out + used, msg.data(), msg.size());
+      notifs[n].msg = out + used;
+      notifs[n].msg_len = msg.size();
+      used += msg.size();
+
+      n++;
+      agent->drained_notifs++;
+    }
+
+    *count = n;
+    if (has_more) {
+      *has_more = agent->drained_notifs < list.size();
+    }
+    return NIXL_CAPI_SUCCESS;
+  }
+  catch (...) {
+    return NIXL_CAPI_ERROR_BACKEND;
+  }
+}
+
 }  // extern "C"
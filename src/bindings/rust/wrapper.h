@@ -192,6 +192,43 @@ nixl_capi_status_t nixl_capi_notif_map_get_notifs_size(nixl_capi_notif_map_t map
 nixl_capi_status_t nixl_capi_notif_map_get_notif(
     nixl_capi_notif_map_t map, const char* agent_name, size_t index, const void** data, size_t* len);
 
+// Bulk functions, one call for many descriptors, requests or notifications
+typedef struct {
+  uintptr_t addr;
+  size_t len;
+  uint64_t dev_id;
+} nixl_capi_desc_t;
+
+// A drained notification, agent_name (NUL terminated) and msg point into the caller buffer
+typedef struct {
+  const char* agent_name;
+  const void* msg;
+  size_t msg_len;
+} nixl_capi_notif_t;
+
+// Append count descriptors to the list
+nixl_capi_status_t nixl_capi_xfer_dlist_add_descs(
+    nixl_capi_xfer_dlist_t dlist, const nixl_capi_desc_t* descs, size_t count);
+nixl_capi_status_t nixl_capi_reg_dlist_add_descs(
+    nixl_capi_reg_dlist_t dlist, const nixl_capi_desc_t* descs, size_t count);
+
+// Post or check count requests under one agent call. statuses can be null, or hold count
+// elements for the status of each. Returns the first error, else NIXL_CAPI_IN_PROG if any
+// request is in progress, else NIXL_CAPI_SUCCESS.
+nixl_capi_status_t nixl_capi_post_xfer_reqs(
+    nixl_capi_agent_t agent, const nixl_capi_xfer_req_t* reqs, size_t count, nixl_capi_status_t* statuses,
+    nixl_capi_opt_args_t opt_args);
+nixl_capi_status_t nixl_capi_get_xfer_statuses(
+    nixl_capi_agent_t agent, const nixl_capi_xfer_req_t* reqs, size_t count, nixl_capi_status_t* statuses);
+
+// Take up to max_notifs new notifications, copying their agent names and messages into buf.
+// Notifications that do not fit are kept for the next call, and has_more is set. Returns
+// NIXL_CAPI_ERROR_INVALID_PARAM if the next notification does not fit into an empty buf.
+// To be called from one thread at a time per agent.
+nixl_capi_status_t nixl_capi_drain_notifs(
+    nixl_capi_agent_t agent, nixl_capi_notif_t* notifs, size_t max_notifs, void* buf, size_t buf_len,
+    size_t* count, bool* has_more, nixl_capi_opt_args_t opt_args);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,26 +17,58 @@
 #ifndef __AGENT_DATA_H_
 #define __AGENT_DATA_H_
 
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <set>
+#include <unordered_set>
 #include "common/str_tools.h"
+#include "common/ring.h"
 #include "mem_section.h"
 #include "stream/metadata_stream.h"
 #include "sync.h"
+#include "transfer_request.h"
+#include "reg_request.h"
+#include "completion_queue.h"
+#include "xfer_scheduler.h"
+#include "telemetry.h"
+#include "agent_progress.h"
+#include "metadata_kv.h"
 
 typedef std::vector<nixlBackendEngine*> backend_list_t;
 
+// Candidate backends for a transfer, indexed by local and remote memory types
+typedef std::array<std::array<backend_list_t, FILE_SEG+1>, FILE_SEG+1>
+        backend_matrix_t;
+
 //Internal typedef to define metadata communication request types
-//To be extended with ETCD operations
-typedef enum { SOCK_SEND, SOCK_FETCH, SOCK_INVAL } nixl_comm_t;
+//SOCK_FWD sends metadata along with the peers to forward it to
+//KV_UPDATE and KV_REMOVE are queued by the watches of the metadata store
+typedef enum { SOCK_SEND, SOCK_FETCH, SOCK_INVAL, SOCK_FWD,
+               KV_SEND, KV_FETCH, KV_INVAL, KV_UPDATE, KV_REMOVE } nixl_comm_t;
 
 //Command to be sent to listener thread from NIXL API
 // 1) Command type
-// 2) IP Address
+// 2) IP Address, or agent name for the metadata store
 // 3) Port
 // 4) Metadata to send (for sendLocalMD calls)
 typedef std::tuple<nixl_comm_t, std::string, int, nixl_blob_t> nixl_comm_req_t;
 
 typedef std::pair<std::string, int> nixl_socket_peer_t;
 
+// Bounds of a metadata broadcast tree, also on the payloads received to forward
+#define NIXL_MD_TREE_MAX_FANOUT 64
+#define NIXL_MD_TREE_MAX_DEPTH  64
+#define NIXL_MD_TREE_MAX_PEERS  65536
+
+// Remote agent interned by the agent, with its section while its metadata is
+// loaded, and the common local and remote backends per memory types
+struct nixlRemoteAgentEntry {
+    std::string        name;
+    nixlRemoteSection* section = nullptr;
+    backend_matrix_t   candidates;
+};
+
 class nixlAgentData {
     private:
         std::string     name;
@@ -64,22 +96,197 @@ class nixlAgentData {
         std::unordered_map<std::string, nixlRemoteSection*,
                            std::hash<std::string>, strEqual>     remoteSections;
 
+        // Remote agents indexed by the id interned for their name, so the
+        // transfer path does not hash names. Ids are not reused, an agent
+        // invalidated and loaded again keeps its id.
+        std::vector<nixlRemoteAgentEntry>                        remoteAgents;
+        std::unordered_map<std::string, nixl_agent_id_t,
+                           std::hash<std::string>, strEqual>     remoteAgentIds;
+
+        nixl_agent_id_t internAgent(const std::string &remote_agent);
+        // Sets or, if null, removes the section of remote_agent in both maps
+        void setRemoteSection(const std::string &remote_agent,
+                              nixlRemoteSection* section);
+        inline nixlRemoteSection* getRemoteSection(const nixl_agent_id_t &id) const {
+            return (id < remoteAgents.size()) ? remoteAgents[id].section : nullptr;
+        }
+
+        // Common local and remote backends, in backend creation order. Updated
+        // when registrations or remote metadata change, so the transfer path
+        // only reads them.
+        void updateXferCandidates(nixlRemoteAgentEntry &remote);
+        void updateXferCandidates();
+        const backend_list_t* getXferCandidates(const nixl_mem_t &local_mem,
+                                                const nixl_agent_id_t &remote_id,
+                                                const nixl_mem_t &remote_mem) const;
+
+        nixl_status_t createXferReq(const nixl_xfer_op_t &operation,
+                                    const nixl_xfer_dlist_t &local_descs,
+                                    const nixl_xfer_dlist_t &remote_descs,
+                                    const nixl_agent_id_t &remote_id,
+                                    nixlXferReqH* &req_hndl,
+                                    const nixl_opt_args_t* extra_params);
+
+        // LocalIdx and RemoteIdx walk the selected indices of each side in order
+        template <class LocalIdx, class RemoteIdx>
+        nixl_status_t makeXferReq(const nixl_xfer_op_t &operation,
+                                  const nixlDlistH* local_side,
+                                  LocalIdx &local_idx,
+                                  const nixlDlistH* remote_side,
+                                  RemoteIdx &remote_idx,
+                                  nixlXferReqH* &req_hndl,
+                                  const nixl_opt_args_t* extra_params);
+
+        // Recycled transfer handles, reused by makeXferReq/createXferReq
+        nixlXferReqPool                                          xferReqPool;
+
+        // Bytes in flight per priority class and remote agent, with the config limits
+        nixlXferScheduler                                        xferScheduler;
+
+        // Counters and latencies of the transfers, with config.enableTelemetry
+        nixlTelemetry                                            telemetry;
+
+        // Finished requests that were posted with useCompletionQueue
+        nixlXferCompletionQueue                                  completionQueue;
+
+        // A request found done, or failed, gives back its scheduled bytes
+        inline void finishXfer(nixlXferReqH* req_hndl, const nixl_status_t &status) {
+            xferScheduler.release(req_hndl);
+            if (telemetry.isEnabled())
+                telemetry.finished(req_hndl, status);
+        }
+        inline void startXfer(nixlXferReqH* req_hndl) {
+            if (telemetry.isEnabled())
+                telemetry.posted(req_hndl);
+        }
+
+        void prepCompletion(nixlXferReqH* req_hndl, nixl_opt_b_args_t &opt_args);
+        void postCompletion(nixlXferReqH* req_hndl,
+                            const nixl_opt_b_args_t &opt_args,
+                            const nixl_status_t &status);
+
+        // Pieces of transfers split over several backends, by createXferReq
+        void splitXferBytes(nixlXferReqH* handle);
+
+        // Adds descriptors registered with a backend to the self remote section,
+        // for local transfers, with the agent lock held. Removes them on errors.
+        nixl_status_t loadSelfDescs(const nixl_reg_dlist_t &descs,
+                                    nixlBackendEngine* backend,
+                                    nixl_sec_dlist_t &self_descs);
+
+        // Threads registering a list with a backend, from config.regThreads
+        size_t getRegThreads() const {
+            return config.regThreads ? config.regThreads :
+                   std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // Registrations of registerMemAsync, run by config.asyncRegThreads
+        std::vector<std::thread>           regThreads;
+        std::deque<nixlRegReqH*>           regQueue;
+        std::mutex                         regLock;
+        std::condition_variable            regCv;
+        bool                               regStop = false;
+
+        void enqueueRegistration(nixlRegReqH* reg_hndl);
+        void runRegistration(nixlRegReqH* reg_hndl);
+        void regWorker();
+        // Waits for the queued registrations to be done
+        void stopRegWorkers();
+
         // State/methods for listener thread
-        nixlMDStreamListener               *listener;
+        nixlMDStreamListener               *listener = nullptr;
         std::map<nixl_socket_peer_t, int>  remoteSockets;
+        // Metadata version last sent to each peer, by sendLocalMDDelta
+        std::map<nixl_socket_peer_t, uint64_t> sentMDVersions;
+        std::mutex                         sentMDLock;
         std::thread                        commThread;
         std::vector<nixl_comm_req_t>       commQueue;
         std::mutex                         commLock;
-        bool                               commThreadStop;
+        std::atomic<bool>                  commThreadStop{false};
+        // Listener thread waits on the sockets and on commEventFd, signaled
+        // by enqueueCommWork
+        int                                commEpollFd = -1;
+        int                                commEventFd = -1;
+        // Central metadata store, null when it is not configured
+        std::unique_ptr<nixlMetadataKV>    metadataKV;
+        // Progress of the engines from the listener thread, with sharedProgThread
+        std::unique_ptr<nixlAgentProgress> progressDriver;
+        // Posts from the other threads, with config.submitQueueSize
+        std::unique_ptr<nixlRing<nixlXferSubmission>> submitQueue;
+
+        // Called from the progress thread, returns whether anything was posted
+        bool postSubmissions(nixlAgent* myAgent);
+        // Posts requests queued or deferred, without the agent lock held
+        void postSubmission(nixlAgent* myAgent, nixlXferSubmission &sub);
+        // Posts the deferred requests that fit, returns whether any was posted
+        bool postDeferred(nixlAgent* myAgent);
+        inline void checkDeferred(nixlAgent* myAgent) {
+            if (xferScheduler.hasDeferred())
+                postDeferred(myAgent);
+        }
+
+        // Logs the telemetry every config.telemetryDumpMs
+        std::thread                        telemetryThread;
+        std::mutex                         telemetryLock;
+        std::condition_variable            telemetryCv;
+        bool                               telemetryStop = false;
+
+        void telemetryWorker(nixlAgent* myAgent);
 
         void commWorker(nixlAgent* myAgent);
         void enqueueCommWork(nixl_comm_req_t request);
+        // Sends md to up to fanout of the peers, each forwarding it to a part of the rest,
+        // from an agent at depth of the tree
+        void enqueueMDTree(const nixl_blob_t &md,
+                           const std::vector<nixl_socket_peer_t> &peers,
+                           uint32_t fanout, uint32_t depth = 0);
+        void forwardMDTree(nixlAgent* myAgent, const std::string &payload, bool load);
         void getCommWork(std::vector<nixl_comm_req_t> &req_list);
+        void wakeCommWorker();
+        void addCommSocket(const nixl_socket_peer_t &peer, int fd);
+        void closeCommSocket(const nixl_socket_peer_t &peer);
+
+        // Frames partly received or still to send, per socket
+        std::map<int, nixlMDFrameReader>   commReaders;
+        std::map<int, nixlMDFrameWriter>   commWriters;
+        // Invalidated sockets, closed once their frames are sent
+        std::set<int>                      commClosing;
+
+        void setCommEvents(int fd, uint32_t events);
+        void closeCommFd(int fd);
+        void dropCommFd(int fd);
+        void sendCommFrame(int fd, uint32_t type, std::string &&data);
+        void flushCommSocket(int fd);
+        void doKVWork(nixlAgent* myAgent, const nixl_comm_req_t &request);
+
+        // Remote agents fetched from the metadata server on first use, with
+        // config.lazyMDFetch. Those loaded are evicted least recently used first,
+        // skipping the ones still referenced by dlist or transfer handles.
+        std::mutex                         lazyMDLock;
+        std::condition_variable            lazyMDCond;
+        std::unordered_set<std::string>    lazyMDPending;
+        std::list<std::string>             lazyMDLru;
+        std::unordered_map<std::string, std::list<std::string>::iterator> lazyMDAgents;
+        std::unordered_map<std::string, size_t> lazyMDRefs;
+
+        // Called without the agent lock held, as it can wait for the fetch
+        nixl_status_t lazyFetch(const std::string &agent);
+        void lazyFetchDone(nixlAgent* myAgent, const std::string &agent, bool loaded);
+        // Take lazyMDLock, so they can be called with the agent lock held
+        void lazyMDRef(const std::string &agent);
+        void lazyMDUnref(const std::string &agent);
+
+        // Remote agents with a metadata import or invalidation in progress.
+        // Imports of different agents load their descriptors at the same time.
+        std::mutex                         importLock;
+        std::condition_variable            importCond;
+        std::unordered_set<std::string>    importAgents;
 
         nixlAgentData(const std::string &name, const nixlAgentConfig &cfg);
         ~nixlAgentData();
 
     friend class nixlAgent;
+    friend class nixlImportSlot;
 };
 
 class nixlBackendEngine;
@@ -99,6 +306,15 @@ class nixlBackendH {
         bool supportsNotif  () const { return engine->supportsNotif (); }
         bool supportsProgTh () const { return engine->supportsProgTh(); }
 
+        nixl_status_t getXferHints (const nixl_mem_t &local_mem,
+                                    const nixl_mem_t &remote_mem,
+                                    const std::string &remote_agent,
+                                    nixl_xfer_hints_t &hints) const {
+            if (remote_agent.empty())
+                return engine->getXferHints(local_mem, remote_mem, hints);
+            return engine->getPeerXferHints(local_mem, remote_mem, remote_agent, hints);
+        }
+
     friend class nixlAgentData;
     friend class nixlAgent;
 };
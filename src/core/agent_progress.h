@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __AGENT_PROGRESS_H_
+#define __AGENT_PROGRESS_H_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "nixl_params.h"
+#include "backend/backend_engine.h"
+
+// Progress of the engines of an agent with sharedProgThread. Engines that would
+// start a progress thread add themselves instead, and the listener thread runs
+// a round of each of them between its events, so an agent has one thread
+// polling for all of its backends.
+//
+// Between rounds the thread backs off: it polls right away while rounds make
+// progress and for spinUs after, then waits delay between rounds, and after
+// idleUs sleeps in the listener wait until woken or for up to sleepUs.
+class nixlAgentProgress : public nixlProgressDriver {
+    private:
+        std::mutex                      lock;
+        std::vector<nixlBackendEngine*> engines;
+        std::atomic<bool>               hasEngines{false};
+        // Work of the agent done along with each round, set before the thread starts
+        std::function<bool()>           agentWork;
+        // Set by the thread itself, read by the others in isProgressThread
+        std::atomic<std::thread::id>    threadId;
+        int                             wakeFd;
+
+        nixlTime::us_t                  delay;
+        nixlTime::us_t                  spinUs;
+        nixlTime::us_t                  idleUs;
+        nixlTime::us_t                  sleepUs;
+
+        // Only used by the thread, sleepStart is 0 when not sleeping
+        nixlTime::us_t                  lastActive = 0;
+        nixlTime::us_t                  sleepStart = 0;
+        std::atomic<bool>               sleeping{false};
+
+        std::atomic<uint64_t>           iterations{0};
+        std::atomic<uint64_t>           idleTime{0};
+        std::atomic<uint64_t>           sleeps{0};
+        std::atomic<uint64_t>           wakeups{0};
+
+        bool progressEngines();
+        void signal();
+
+    public:
+        // wake_fd is written to wake up the thread from waiting for events
+        nixlAgentProgress(const nixlAgentConfig &cfg, const int &wake_fd)
+            : wakeFd(wake_fd), delay(cfg.pthrDelay), spinUs(cfg.progSpinUs),
+              idleUs(cfg.progIdleUs), sleepUs(cfg.progSleepUs) { }
+
+        // Called by the thread first, before any of its work
+        void setThread(const std::thread::id &id) { threadId.store(id); }
+        // Called in every round, e.g. to post queued transfers. Returns whether
+        // anything was done.
+        void setAgentWork(std::function<bool()> work) { agentWork = std::move(work); }
+
+        void addEngine(nixlBackendEngine* engine) override;
+        void removeEngine(nixlBackendEngine* engine) override;
+        void wake() override;
+        bool isProgressThread() const override {
+            return std::this_thread::get_id() == threadId.load();
+        }
+
+        // A round of every engine, and the backoff after it. Returns the timeout
+        // in ms to wait for events with: 0 to only check for them, or -1 if
+        // there are no engines nor agent work.
+        int run();
+        // Called once the wait for events returns
+        void waited(const int &n_events);
+
+        void getStats(nixlProgressStats &stats) const;
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COMPLETION_QUEUE_H_
+#define __COMPLETION_QUEUE_H_
+
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "nixl.h"
+#include "backend/backend_aux.h"
+#include "xfer_scheduler.h"
+#include "telemetry.h"
+
+// Per agent queue of finished transfer requests, drained by pollCompletions.
+// Requests on backends that report completions themselves are tracked until
+// xferDone is called for them, the rest are checked by the agent while polling.
+// Requests with a callback get it called when they finish instead of queued.
+// The scheduler and telemetry are told about finished requests as soon as found.
+class nixlXferCompletionQueue : public nixlBackendCompletionSink {
+    private:
+        std::mutex                 lock;
+        int                        eventFd;
+        // To give back the bytes of finished requests, can be null
+        nixlXferScheduler*         scheduler = nullptr;
+        // To record the latencies of finished requests, can be null
+        nixlTelemetry*             telemetry = nullptr;
+
+        inline void finished(nixlXferReqH* req, const nixl_status_t &status) {
+            if (scheduler)
+                scheduler->release(req);
+            if (telemetry)
+                telemetry->finished(req, status);
+        }
+
+        // Posted on a backend without completion reporting, polled by the agent
+        std::vector<nixlXferReqH*> pending;
+        // Posted on a backend that calls xferDone with the request as context
+        std::unordered_set<nixlXferReqH*> tracked;
+        std::deque<std::pair<nixlXferReqH*, nixl_status_t>> completed;
+
+        void signal();
+
+    public:
+        nixlXferCompletionQueue();
+        ~nixlXferCompletionQueue();
+
+        int getFd() const { return eventFd; }
+        void setScheduler(nixlXferScheduler* sched) { scheduler = sched; }
+        void setTelemetry(nixlTelemetry* telem) { telemetry = telem; }
+
+        // Has to be called before posting to a reporting backend, as the
+        // completion can be reported before the post returns.
+        void expect(nixlXferReqH* req);
+        void addPending(nixlXferReqH* req);
+        void addCompleted(nixlXferReqH* req, const nixl_status_t &status);
+
+        // Drops any state of the request, late xferDone calls are ignored
+        void remove(nixlXferReqH* req);
+
+        void xferDone(void* completion_ctx, nixl_status_t status) override;
+
+        // Returns up to max finished requests, after setting their status
+        void poll(const size_t &max, std::vector<nixlXferReqH*> &out);
+};
+
+#endif
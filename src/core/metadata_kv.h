@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __METADATA_KV_H
+#define __METADATA_KV_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "nixl_types.h"
+
+// Central key-value store the agents publish their metadata in, instead of
+// sending it to each peer. Keys are the agent names, under a namespace.
+class nixlMetadataKV {
+    public:
+        // Called on a thread of the store with the new value of a watched
+        // agent, or with null when its metadata was removed or expired
+        typedef std::function<void(const std::string &agent,
+                                   const std::string *value)> watch_cb_t;
+
+        virtual ~nixlMetadataKV() { }
+
+        // Published metadata is removed when the agent goes away
+        virtual nixl_status_t put(const std::string &agent, const std::string &value) = 0;
+        // NIXL_ERR_NOT_FOUND if the agent did not publish any. The revision
+        // of the store the value was read at is set in both cases.
+        virtual nixl_status_t get(const std::string &agent, std::string &value,
+                                  uint64_t &revision) = 0;
+        virtual nixl_status_t remove(const std::string &agent) = 0;
+
+        // Changes from a revision on, 0 for the changes after the call. One
+        // watch per agent, a repeated call keeps the first.
+        virtual nixl_status_t watch(const std::string &agent, const uint64_t &from_revision,
+                                    const watch_cb_t &cb) = 0;
+        virtual void unwatch(const std::string &agent) = 0;
+};
+
+// Store of the environment: etcd at NIXL_ETCD_ENDPOINTS, with keys under
+// NIXL_ETCD_NAMESPACE. Null if it is not set or etcd support is not built in.
+std::unique_ptr<nixlMetadataKV> nixlMetadataKVCreate();
+
+#endif
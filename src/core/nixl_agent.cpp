@@ -15,14 +15,27 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <functional>
+#include <tuple>
+#include <cstdlib>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include "nixl.h"
 #include "serdes/serdes.h"
 #include "backend/backend_engine.h"
 #include "transfer_request.h"
 #include "agent_data.h"
+#include "desc_kernels.h"
 #include "plugin_manager.h"
 #include "common/nixl_log.h"
+#include "common/cpu_affinity.h"
+#include "common/nixl_trace.h"
+#ifdef HAVE_NIXL_CODEC
+#include "compress/compress_codec.h"
+#endif
 
 /*** nixlEnumStrings namespace implementation in API ***/
 std::string nixlEnumStrings::memTypeStr(const nixl_mem_t &mem) {
@@ -58,12 +71,71 @@ std::string nixlEnumStrings::statusStr (const nixl_status_t &status) {
     }
 }
 
+// Held by the import or invalidation of a remote agent, while others wait
+class nixlImportSlot {
+    private:
+        nixlAgentData     *data;
+        const std::string &agent;
+
+    public:
+        nixlImportSlot(nixlAgentData *agent_data, const std::string &remote_agent) :
+            data(agent_data), agent(remote_agent) {
+            std::unique_lock<std::mutex> guard(data->importLock);
+            data->importCond.wait(guard, [this]() {
+                return data->importAgents.count(agent) == 0; });
+            data->importAgents.insert(agent);
+        }
+
+        ~nixlImportSlot() {
+            {
+                const std::lock_guard<std::mutex> guard(data->importLock);
+                data->importAgents.erase(agent);
+            }
+            data->importCond.notify_all();
+        }
+};
+
 /*** nixlAgentData constructor/destructor, as part of nixlAgent's ***/
+static bool telemetryEnabled(const nixlAgentConfig &cfg) {
+    const char *telemetry = getenv("NIXL_TELEMETRY");
+
+    return cfg.enableTelemetry || (telemetry && (std::string(telemetry) == "1"));
+}
+
 nixlAgentData::nixlAgentData(const std::string &name,
                              const nixlAgentConfig &cfg) :
-                                   name(name), config(cfg), lock(cfg.syncMode)
+                                   name(name), config(cfg), lock(cfg.syncMode),
+                                   xferReqPool(
+                                       (cfg.syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_RW) ?
+                                       nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT :
+                                       nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE),
+                                   xferScheduler(cfg),
+                                   telemetry(telemetryEnabled(cfg))
 {
         memorySection = new nixlLocalSection();
+        if (xferScheduler.isEnabled())
+            completionQueue.setScheduler(&xferScheduler);
+        if (telemetry.isEnabled())
+            completionQueue.setTelemetry(&telemetry);
+#ifdef DISABLE_TELEMETRY
+        if (telemetryEnabled(cfg))
+            NIXL_WARN << "Telemetry is not built in, not enabled";
+#endif
+
+        if (config.mdCodec.empty()) {
+            const char *md_codec = getenv("NIXL_MD_CODEC");
+            if (md_codec)
+                config.mdCodec = md_codec;
+        }
+#ifdef HAVE_NIXL_CODEC
+        if (!config.mdCodec.empty() && !nixlCompressCodecCreate(config.mdCodec, 0)) {
+#else
+        if (!config.mdCodec.empty()) {
+#endif
+            NIXL_WARN << "Metadata codec " << config.mdCodec
+                      << " is not built in, metadata is sent uncompressed";
+            config.mdCodec.clear();
+        }
 }
 
 nixlAgentData::~nixlAgentData() {
@@ -85,8 +157,273 @@ nixlAgentData::~nixlAgentData() {
     for (auto & elm: backendHandles)
         delete elm.second;
 
+    NIXL_DEBUG << "Transfer request pool: " << xferReqPool.getAllocCount()
+               << " allocations, " << xferReqPool.getReuseCount() << " reuses";
+}
+
+
+// The caller holds the lock exclusively for the methods changing remote agents
+nixl_agent_id_t nixlAgentData::internAgent(const std::string &remote_agent) {
+    auto it = remoteAgentIds.find(remote_agent);
+    if (it != remoteAgentIds.end())
+        return it->second;
+
+    nixl_agent_id_t id = remoteAgents.size();
+    remoteAgents.emplace_back();
+    remoteAgents.back().name = remote_agent;
+    remoteAgentIds.emplace(remote_agent, id);
+    return id;
+}
+
+void nixlAgentData::setRemoteSection(const std::string &remote_agent,
+                                     nixlRemoteSection* section) {
+    if (section) {
+        remoteSections[remote_agent] = section;
+        remoteAgents[internAgent(remote_agent)].section = section;
+        return;
+    }
+
+    remoteSections.erase(remote_agent);
+    auto it = remoteAgentIds.find(remote_agent);
+    if (it != remoteAgentIds.end()) {
+        nixlRemoteAgentEntry &remote = remoteAgents[it->second];
+        remote.section = nullptr;
+        for (auto & row : remote.candidates)
+            for (auto & list : row)
+                list.clear();
+    }
+}
+
+// Remote section should exist, and the caller holds the lock
+void nixlAgentData::updateXferCandidates(nixlRemoteAgentEntry &remote) {
+    backend_matrix_t &candidates = remote.candidates;
+    nixlRemoteSection* remote_section = remote.section;
+
+    for (int l=DRAM_SEG; l<=FILE_SEG; ++l) {
+        backend_set_t* local_set =
+            memorySection->queryBackends((nixl_mem_t) l);
+        for (int r=DRAM_SEG; r<=FILE_SEG; ++r) {
+            backend_set_t* remote_set =
+                remote_section->queryBackends((nixl_mem_t) r);
+            candidates[l][r].clear();
+            for (auto & backend : memToBackend[l])
+                if (local_set->count(backend) && remote_set->count(backend))
+                    candidates[l][r].push_back(backend);
+        }
+    }
+}
+
+void nixlAgentData::updateXferCandidates() {
+    for (auto & remote : remoteAgents)
+        if (remote.section)
+            updateXferCandidates(remote);
+}
+
+const backend_list_t*
+nixlAgentData::getXferCandidates(const nixl_mem_t &local_mem,
+                                 const nixl_agent_id_t &remote_id,
+                                 const nixl_mem_t &remote_mem) const {
+    if ((local_mem < DRAM_SEG) || (local_mem > FILE_SEG) ||
+        (remote_mem < DRAM_SEG) || (remote_mem > FILE_SEG) ||
+        !getRemoteSection(remote_id))
+        return nullptr;
+
+    return &remoteAgents[remote_id].candidates[local_mem][remote_mem];
+}
+
+// Keeps the [start, end) byte range of a transfer in its descriptor lists,
+// cutting the descriptors at the edges. Both lists have matching lengths.
+static void keepByteRange(nixl_meta_dlist_t &local_descs,
+                          nixl_meta_dlist_t &remote_descs,
+                          const size_t &start, const size_t &end) {
+    size_t offset = 0;
+    int    j = 0;
+
+    for (int i=0; i<local_descs.descCount(); ++i) {
+        size_t desc_start = offset;
+        size_t desc_end   = offset + local_descs[i].len;
+        size_t keep_start = std::max(start, desc_start);
+        size_t keep_end   = std::min(end, desc_end);
+
+        offset = desc_end;
+        if (keep_start >= keep_end)
+            continue;
+
+        nixlMetaDesc local_desc  = local_descs[i];
+        nixlMetaDesc remote_desc = remote_descs[i];
+        local_desc.addr  += keep_start - desc_start;
+        remote_desc.addr += keep_start - desc_start;
+        local_desc.len    = keep_end - keep_start;
+        remote_desc.len   = keep_end - keep_start;
+        local_descs[j]  = local_desc;
+        remote_descs[j] = remote_desc;
+        j++;
+    }
+
+    local_descs.resize(j);
+    remote_descs.resize(j);
+}
+
+// Before a post: drops what the queue has from a previous post of the request,
+// and for backends that report completions, passes the request as context.
+// It's tracked before posting, as the backend can report before returning.
+void nixlAgentData::prepCompletion(nixlXferReqH* req_hndl,
+                                   nixl_opt_b_args_t &opt_args) {
+    if (!req_hndl->useCq)
+        return;
+
+    completionQueue.remove(req_hndl);
+    if (req_hndl->engine->supportsXferCompletion() && req_hndl->parts.empty()) {
+        opt_args.completionCtx = req_hndl;
+        completionQueue.expect(req_hndl);
+    }
+}
+
+// After a post: backends report in progress requests that got a context, the
+// others are polled. Errors are only returned to the caller of the post.
+void nixlAgentData::postCompletion(nixlXferReqH* req_hndl,
+                                   const nixl_opt_b_args_t &opt_args,
+                                   const nixl_status_t &status) {
+    if (!req_hndl->useCq)
+        return;
+
+    if (status == NIXL_SUCCESS)
+        completionQueue.addCompleted(req_hndl, status);
+    else if (status < 0)
+        completionQueue.remove(req_hndl);
+    else if (!opt_args.completionCtx)
+        completionQueue.addPending(req_hndl);
+}
+
+// Gives an equal share of the bytes to the request and each of its pieces,
+// which all start with the whole populated transfer. If there are not enough
+// bytes for every piece to get some, the pieces are dropped.
+void nixlAgentData::splitXferBytes(nixlXferReqH* handle) {
+    size_t total_len = 0;
+    size_t count     = handle->parts.size() + 1;
+
+    for (int i=0; i<handle->initiatorDescs->descCount(); ++i)
+        total_len += (*handle->initiatorDescs)[i].len;
+
+    if (total_len < count) {
+        for (auto & part : handle->parts)
+            xferReqPool.put(part);
+        handle->parts.clear();
+        return;
+    }
+
+    keepByteRange(*handle->initiatorDescs, *handle->targetDescs,
+                  0, total_len / count);
+    for (size_t k=1; k<count; ++k) {
+        nixlXferReqH* part = handle->parts[k-1];
+        keepByteRange(*part->initiatorDescs, *part->targetDescs,
+                      total_len * k / count, total_len * (k + 1) / count);
+    }
+
+    NIXL_DEBUG << "Transfer of " << total_len << " bytes split over "
+               << count << " backends";
+}
+
+// Overall status of a batch: first error if any, otherwise in progress
+// if any of the requests is not done yet.
+static nixl_status_t mergeStatuses(const std::vector<nixl_status_t> &statuses) {
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    for (auto & status : statuses) {
+        if (status < 0)
+            return status;
+        if (status == NIXL_IN_PROG)
+            ret = NIXL_IN_PROG;
+    }
+    return ret;
+}
+
+// Merges back to back descriptors in place, when both the initiator and target
+// sides are contiguous and belong to the same registrations. Returns new size.
+static int mergeContiguousDescs(nixl_meta_dlist_t &local_descs,
+                                nixl_meta_dlist_t &remote_descs) {
+    int desc_count = local_descs.descCount();
+    int j = 0;
+
+    for (int i=1; i<desc_count; ++i) {
+        nixlMetaDesc &local_desc1  = local_descs[j];
+        nixlMetaDesc &remote_desc1 = remote_descs[j];
+        const nixlMetaDesc &local_desc2  = local_descs[i];
+        const nixlMetaDesc &remote_desc2 = remote_descs[i];
+
+        if (((local_desc1.addr + local_desc1.len) == local_desc2.addr)
+            && ((remote_desc1.addr + remote_desc1.len) == remote_desc2.addr)
+            && (local_desc1.metadataP == local_desc2.metadataP)
+            && (remote_desc1.metadataP == remote_desc2.metadataP)
+            && (local_desc1.devId == local_desc2.devId)
+            && (remote_desc1.devId == remote_desc2.devId)) {
+            local_desc1.len  += local_desc2.len;
+            remote_desc1.len += remote_desc2.len;
+        } else {
+            j++;
+            if (j != i) {
+                local_descs[j]  = local_desc2;
+                remote_descs[j] = remote_desc2;
+            }
+        }
+    }
+
+    if (desc_count > 0) {
+        j++;
+        local_descs.resize(j);
+        remote_descs.resize(j);
+    }
+    return j;
 }
 
+// Orders the candidate backends of createXferReq based on the selection policy.
+// Ties and backends without hints keep the order of backend_cands.
+static void orderBackends(const nixl_opt_args_t* extra_params,
+                          const backend_list_t &backend_cands,
+                          const nixl_xfer_dlist_t &local_descs,
+                          const nixl_mem_t &remote_mem,
+                          const std::string &remote_agent,
+                          backend_list_t &ordered) {
+    ordered.clear();
+
+    if (extra_params->backendPolicy ==
+        nixl_backend_policy_t::NIXL_BACKEND_POLICY_PREFERENCE) {
+        for (auto & type : extra_params->backendPreference)
+            for (auto & backend : backend_cands)
+                if ((backend->getType() == type) &&
+                    (std::find(ordered.begin(), ordered.end(), backend) == ordered.end()))
+                    ordered.push_back(backend);
+        for (auto & backend : backend_cands)
+            if (std::find(ordered.begin(), ordered.end(), backend) == ordered.end())
+                ordered.push_back(backend);
+        return;
+    }
+
+    // NIXL_BACKEND_POLICY_COST: latency plus size over bandwidth
+    std::vector<std::pair<double, nixlBackendEngine*>> costs;
+    double total_len = 0;
+    for (int i=0; i<local_descs.descCount(); ++i)
+        total_len += local_descs[i].len;
+
+    for (auto & backend : backend_cands) {
+        nixlBackendXferHints hints;
+        double cost = std::numeric_limits<double>::infinity();
+
+        if ((backend->getPeerXferHints(local_descs.getType(), remote_mem,
+                                       remote_agent, hints) == NIXL_SUCCESS) &&
+            (hints.bandwidthGBps > 0))
+            cost = hints.latencyUs + total_len / (hints.bandwidthGBps * 1e3);
+        costs.emplace_back(cost, backend);
+    }
+
+    std::stable_sort(costs.begin(), costs.end(),
+                     [](const std::pair<double, nixlBackendEngine*> &a,
+                        const std::pair<double, nixlBackendEngine*> &b) {
+                         return a.first < b.first;
+                     });
+    for (auto & elm : costs)
+        ordered.push_back(elm.second);
+}
 
 /*** nixlAgent implementation ***/
 nixlAgent::nixlAgent(const std::string &name,
@@ -94,22 +431,91 @@ nixlAgent::nixlAgent(const std::string &name,
     if (name.size() == 0)
         throw std::invalid_argument("Agent needs a name");
     data = new nixlAgentData(name, cfg);
+    data->metadataKV = nixlMetadataKVCreate();
+    if (cfg.lazyMDFetch && !data->metadataKV)
+        NIXL_WARN << "No metadata server configured, remote agents are not fetched on first use";
 
     if(cfg.useListenThread) {
         int my_port = cfg.listenPort;
         if(my_port == 0) my_port = default_comm_port;
         data->listener = new nixlMDStreamListener(my_port);
         data->listener->setupListener();
+    }
+
+    // The metadata store is also used from the listener thread, as its
+    // calls block, even when there is nothing to listen on. So are the
+    // engines progressed from one agent thread.
+    bool shared_prog = cfg.useProgThread && cfg.sharedProgThread;
+    if(cfg.useListenThread || data->metadataKV || shared_prog) {
+        data->commEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        data->commEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((data->commEpollFd == -1) || (data->commEventFd == -1))
+            throw std::runtime_error("Cannot create the listener thread events");
+
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        int listen_fd = data->listener ? data->listener->getSocketFd() : -1;
+        for (int fd : {listen_fd, data->commEventFd}) {
+            // Listener setup failed already, only sending metadata works
+            if (fd == -1)
+                continue;
+            ev.data.fd = fd;
+            if (epoll_ctl(data->commEpollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+                throw std::runtime_error("Cannot wait on the listener thread events");
+        }
+
+        if (shared_prog)
+            data->progressDriver.reset(new nixlAgentProgress(cfg, data->commEventFd));
+        if (shared_prog && cfg.submitQueueSize &&
+            (cfg.syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE)) {
+            NIXL_WARN << "Submission queue needs a thread synchronization mode, not used";
+        } else if (shared_prog && cfg.submitQueueSize) {
+            data->submitQueue.reset(new nixlRing<nixlXferSubmission>(cfg.submitQueueSize));
+        }
+        if (data->submitQueue || (shared_prog && data->xferScheduler.isEnabled())) {
+            data->progressDriver->setAgentWork([this]() {
+                bool posted = data->submitQueue && data->postSubmissions(this);
+                return (data->xferScheduler.hasDeferred() && data->postDeferred(this)) ||
+                       posted;
+            });
+        }
+
         data->commThreadStop = false;
         data->commThread = std::thread(&nixlAgentData::commWorker, data, this);
+        if (!nixlPinThread(data->commThread.native_handle(), cfg.commThreadCpus))
+            NIXL_WARN << "Cannot pin the listener thread to CPUs " << cfg.commThreadCpus;
     }
+
+    if (data->telemetry.isEnabled() && cfg.telemetryDumpMs)
+        data->telemetryThread = std::thread(&nixlAgentData::telemetryWorker, data, this);
 }
 
 nixlAgent::~nixlAgent() {
-    if(data->config.useListenThread) {
+    if (data->telemetryThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(data->telemetryLock);
+            data->telemetryStop = true;
+        }
+        data->telemetryCv.notify_all();
+        data->telemetryThread.join();
+    }
+    data->stopRegWorkers();
+    if(data->commThread.joinable()) {
         data->commThreadStop = true;
-        if(data->commThread.joinable()) data->commThread.join();
+        data->wakeCommWorker();
+        data->commThread.join();
+    }
+    // Watches queue work until they are stopped, and the published
+    // metadata is removed with the lease
+    data->metadataKV.reset();
+    if(data->commEpollFd != -1) {
         if(data->listener) delete data->listener;
+        for (auto & elm : data->remoteSockets)
+            close(elm.second);
+        for (int fd : data->commClosing)
+            close(fd);
+        close(data->commEventFd);
+        close(data->commEpollFd);
     }
     delete data;
 }
@@ -117,7 +523,7 @@ nixlAgent::~nixlAgent() {
 nixl_status_t
 nixlAgent::getAvailPlugins (std::vector<nixl_backend_t> &plugins) {
     auto& plugin_manager = nixlPluginManager::getInstance();
-    plugins = plugin_manager.getLoadedPluginNames();
+    plugins = plugin_manager.getAvailablePluginNames();
     return NIXL_SUCCESS;
 }
 
@@ -145,7 +551,7 @@ nixlAgent::getPluginParams (const nixl_backend_t &type,
         params = plugin_handle->getBackendOptions();
         mems   = plugin_handle->getBackendMems();
 
-        NIXL_LOCK_GUARD(data->lock);
+        NIXL_SHARED_LOCK_GUARD(data->lock);
 
         // We don't keep the plugin loaded if we didn't have it before
         if (data->backendEngines.count(type) == 0) {
@@ -164,12 +570,26 @@ nixlAgent::getBackendParams (const nixlBackendH* backend,
     if (!backend)
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     mems   = backend->engine->getSupportedMems();
     params = backend->engine->getCustomParams();
     return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::getBackendXferHints (const nixlBackendH* backend,
+                                const nixl_mem_t &local_mem,
+                                const nixl_mem_t &remote_mem,
+                                const std::string &remote_agent,
+                                nixl_xfer_hints_t &hints) const {
+    if (!backend)
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    hints = nixl_xfer_hints_t();
+    return backend->getXferHints(local_mem, remote_mem, remote_agent, hints);
+}
+
 nixl_status_t
 nixlAgent::createBackend(const nixl_backend_t &type,
                          const nixl_b_params_t &params,
@@ -192,10 +612,12 @@ nixlAgent::createBackend(const nixl_backend_t &type,
     init_params.customParams = const_cast<nixl_b_params_t*>(&params);
     init_params.enableProgTh = data->config.useProgThread;
     init_params.pthrDelay    = data->config.pthrDelay;
+    init_params.progressDriver = data->progressDriver.get();
 
     // First, try to load the backend as a plugin
     auto& plugin_manager = nixlPluginManager::getInstance();
     auto plugin_handle = plugin_manager.loadPlugin(type);
+    init_params.factory = plugin_manager.getEngineFactory();
 
     if (plugin_handle) {
         // Plugin found, use it to create the backend
@@ -235,6 +657,8 @@ nixlAgent::createBackend(const nixl_backend_t &type,
             return NIXL_ERR_BACKEND;
         }
 
+        backend->setCompletionSink(&data->completionQueue);
+
         data->backendEngines[type] = backend;
         data->backendHandles[type] = bknd_hndl;
         mems = backend->getSupportedMems();
@@ -280,36 +704,195 @@ nixlAgent::registerMem(const nixl_reg_dlist_t &descs,
     // Can become more sophisticated to have a soft error case
     for (size_t i=0; i<backend_list->size(); ++i) {
         nixlBackendEngine* backend = (*backend_list)[i];
+        // Allowed for compatibility, transfers within the overlap can use either
+        if (data->memorySection->hasOverlaps(descs, backend))
+            NIXL_WARN << "Registering memory that overlaps memory already registered "
+                      << "with backend " << backend->getType();
         // meta_descs use to be passed to loadLocalData
         nixl_sec_dlist_t sec_descs(descs.getType(), false);
-        ret = data->memorySection->addDescList(descs, backend, sec_descs);
+        ret = data->memorySection->addDescList(descs, backend, sec_descs,
+                                               data->getRegThreads());
         if (ret == NIXL_SUCCESS) {
-            if (backend->supportsLocal()) {
-                if (data->remoteSections.count(data->name) == 0)
-                    data->remoteSections[data->name] =
-                          new nixlRemoteSection(data->name);
-
-                ret = data->remoteSections[data->name]->loadLocalData(
-                                                        sec_descs, backend);
-                if (ret == NIXL_SUCCESS)
-                    count++;
-                else
-                    data->memorySection->remDescList(descs, backend);
-            } else {
+            if (data->loadSelfDescs(descs, backend, sec_descs) == NIXL_SUCCESS)
                 count++;
-            }
         } // a bad_ret can be saved in an else
     }
 
     if (extra_params && extra_params->backends.size() > 0)
         delete backend_list;
 
+    data->updateXferCandidates();
+
     if (count > 0)
         return NIXL_SUCCESS;
     else
         return NIXL_ERR_BACKEND;
 }
 
+nixl_status_t
+nixlAgentData::loadSelfDescs(const nixl_reg_dlist_t &descs,
+                             nixlBackendEngine* backend,
+                             nixl_sec_dlist_t &self_descs) {
+    if (!backend->supportsLocal())
+        return NIXL_SUCCESS;
+
+    if (remoteSections.count(name) == 0)
+        setRemoteSection(name, new nixlRemoteSection(name));
+
+    nixl_status_t ret = remoteSections[name]->loadLocalData(self_descs, backend);
+    if (ret != NIXL_SUCCESS)
+        memorySection->remDescList(descs, backend);
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::registerMemAsync(const nixl_reg_dlist_t &descs,
+                            nixlRegReqH* &reg_hndl,
+                            const nixl_opt_args_t* extra_params) {
+    nixl_status_t ret;
+
+    reg_hndl = nullptr;
+
+    // No lock to register in the background with, done here instead
+    if (data->config.syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE) {
+        ret = registerMem(descs, extra_params);
+        if (ret == NIXL_ERR_NOT_FOUND)
+            return ret;
+
+        reg_hndl = new nixlRegReqH(descs);
+        reg_hndl->status = ret;
+        if (extra_params && extra_params->regCallback)
+            extra_params->regCallback(reg_hndl, ret, extra_params->regCallbackCtx);
+        return ret;
+    }
+
+    reg_hndl = new nixlRegReqH(descs);
+    if (extra_params) {
+        reg_hndl->callback    = extra_params->regCallback;
+        reg_hndl->callbackCtx = extra_params->regCallbackCtx;
+    }
+
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        if (!extra_params || extra_params->backends.size() == 0) {
+            reg_hndl->backends = data->memToBackend[descs.getType()];
+        } else {
+            for (auto & elm : extra_params->backends)
+                reg_hndl->backends.push_back(elm->engine);
+        }
+
+        for (auto & backend : reg_hndl->backends)
+            if (data->memorySection->hasOverlaps(descs, backend))
+                NIXL_WARN << "Registering memory that overlaps memory already registered "
+                          << "with backend " << backend->getType();
+    }
+
+    if (reg_hndl->backends.empty()) {
+        delete reg_hndl;
+        reg_hndl = nullptr;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    data->enqueueRegistration(reg_hndl);
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t
+nixlAgent::getRegStatus(const nixlRegReqH* reg_hndl) const {
+    if (!reg_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+    return reg_hndl->status.load(std::memory_order_acquire);
+}
+
+nixl_status_t
+nixlAgent::releaseRegReq(nixlRegReqH* reg_hndl) const {
+    if (!reg_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+    if (reg_hndl->status.load(std::memory_order_acquire) == NIXL_IN_PROG)
+        return NIXL_ERR_NOT_ALLOWED;
+    delete reg_hndl;
+    return NIXL_SUCCESS;
+}
+
+void nixlAgentData::enqueueRegistration(nixlRegReqH* reg_hndl) {
+    std::lock_guard<std::mutex> guard(regLock);
+
+    // Started on first use, most agents register synchronously
+    if (regThreads.empty()) {
+        size_t n_threads = std::max<size_t>(config.asyncRegThreads, 1);
+        for (size_t i = 0; i < n_threads; ++i)
+            regThreads.emplace_back(&nixlAgentData::regWorker, this);
+    }
+    regQueue.push_back(reg_hndl);
+    regCv.notify_one();
+}
+
+void nixlAgentData::regWorker() {
+    std::unique_lock<std::mutex> guard(regLock);
+
+    while (true) {
+        regCv.wait(guard, [this]() { return regStop || !regQueue.empty(); });
+        if (regQueue.empty())
+            return;
+
+        nixlRegReqH* reg_hndl = regQueue.front();
+        regQueue.pop_front();
+        guard.unlock();
+        runRegistration(reg_hndl);
+        guard.lock();
+    }
+}
+
+void nixlAgentData::stopRegWorkers() {
+    {
+        std::lock_guard<std::mutex> guard(regLock);
+        regStop = true;
+    }
+    regCv.notify_all();
+    for (auto & t : regThreads)
+        t.join();
+    regThreads.clear();
+}
+
+void nixlAgentData::runRegistration(nixlRegReqH* reg_hndl) {
+    const nixl_reg_dlist_t &descs = reg_hndl->descs;
+    size_t                  count = reg_hndl->backends.size();
+    std::vector<nixl_sec_dlist_t> added(count, nixl_sec_dlist_t(descs.getType()));
+    std::vector<nixl_sec_dlist_t> self_descs(count, nixl_sec_dlist_t(descs.getType(), false));
+    std::vector<nixl_status_t>    rets(count);
+    unsigned int                  done = 0;
+    size_t                        max_threads = getRegThreads();
+
+    // The slow part, pinning and mapping, without the agent lock if possible
+    for (size_t i = 0; i < count; ++i) {
+        nixlBackendEngine* backend = reg_hndl->backends[i];
+        if (backend->supportsConcurrentReg()) {
+            rets[i] = nixlLocalSection::regDescs(descs, backend, added[i], self_descs[i],
+                                                 max_threads);
+        } else {
+            NIXL_LOCK_GUARD(lock);
+            rets[i] = nixlLocalSection::regDescs(descs, backend, added[i], self_descs[i]);
+        }
+    }
+
+    {
+        NIXL_LOCK_GUARD(lock);
+        for (size_t i = 0; i < count; ++i) {
+            if (rets[i] != NIXL_SUCCESS)
+                continue;
+            memorySection->commitDescs(reg_hndl->backends[i], added[i]);
+            if (loadSelfDescs(descs, reg_hndl->backends[i], self_descs[i]) == NIXL_SUCCESS)
+                done++;
+        }
+        updateXferCandidates();
+    }
+
+    nixl_status_t ret = (done > 0) ? NIXL_SUCCESS : NIXL_ERR_BACKEND;
+    if (reg_hndl->callback)
+        reg_hndl->callback(reg_hndl, ret, reg_hndl->callbackCtx);
+    reg_hndl->status.store(ret, std::memory_order_release);
+}
+
 nixl_status_t
 nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
                          const nixl_opt_args_t* extra_params) {
@@ -339,6 +922,8 @@ nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
             bad_ret = ret;
     }
 
+    data->updateXferCandidates();
+
     return bad_ret;
 }
 
@@ -383,11 +968,71 @@ nixlAgent::makeConnection(const std::string &remote_agent,
         return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::makeConnections(const std::vector<std::string> &remote_agents,
+                           std::vector<nixl_status_t> &statuses,
+                           const nixl_opt_args_t* extra_params) {
+    // Agents connected by each backend, and their index in remote_agents
+    std::map<nixl_backend_t, std::pair<std::vector<std::string>,
+                                       std::vector<size_t>>> backend_agents;
+    std::vector<nixl_status_t> backend_statuses;
+    std::vector<int> counts(remote_agents.size(), 0);
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    NIXL_LOCK_GUARD(data->lock);
+    statuses.assign(remote_agents.size(), NIXL_SUCCESS);
+
+    for (size_t i = 0; i < remote_agents.size(); ++i) {
+        auto remote = data->remoteBackends.find(remote_agents[i]);
+        if ((remote == data->remoteBackends.end()) ||
+            (remote->second.empty() && (!extra_params || extra_params->backends.empty()))) {
+            statuses[i] = NIXL_ERR_NOT_FOUND;
+            continue;
+        }
+
+        if (!extra_params || extra_params->backends.size() == 0) {
+            for (auto & [r_bknd, conn_info] : remote->second) {
+                backend_agents[r_bknd].first.push_back(remote_agents[i]);
+                backend_agents[r_bknd].second.push_back(i);
+            }
+        } else {
+            for (auto & elm : extra_params->backends) {
+                nixl_backend_t r_bknd = elm->engine->getType();
+                backend_agents[r_bknd].first.push_back(remote_agents[i]);
+                backend_agents[r_bknd].second.push_back(i);
+            }
+        }
+    }
+
+    for (auto & [backend, agents] : backend_agents) {
+        auto eng = data->backendEngines.find(backend);
+        if (eng == data->backendEngines.end())
+            continue;
+
+        eng->second->connectAgents(agents.first, backend_statuses);
+        for (size_t j = 0; j < agents.second.size(); ++j) {
+            size_t idx = agents.second[j];
+            if ((backend_statuses[j] < 0) && (statuses[idx] == NIXL_SUCCESS))
+                statuses[idx] = backend_statuses[j];
+            counts[idx]++;
+        }
+    }
+
+    for (size_t i = 0; i < remote_agents.size(); ++i) {
+        if ((statuses[i] == NIXL_SUCCESS) && (counts[i] == 0)) // No common backend
+            statuses[i] = NIXL_ERR_BACKEND;
+        if ((statuses[i] < 0) && (ret == NIXL_SUCCESS))
+            ret = statuses[i];
+    }
+    return ret;
+}
+
 nixl_status_t
 nixlAgent::prepXferDlist (const std::string &agent_name,
                           const nixl_xfer_dlist_t &descs,
                           nixlDlistH* &dlist_hndl,
                           const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("prepXferDlist");
 
     // Using a set as order is not important to revert the operation
     backend_set_t* backend_set;
@@ -395,16 +1040,28 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
     int            count = 0;
     bool           init_side = (agent_name == NIXL_INIT_AGENT);
 
-    NIXL_LOCK_GUARD(data->lock);
-    // When central KV is supported, still it should return error,
-    // just we can add a call to fetchRemoteMD for next time
-    if (!init_side && (data->remoteSections.count(agent_name) == 0))
-        return NIXL_ERR_NOT_FOUND;
+    if (!init_side && data->config.lazyMDFetch) {
+        ret = data->lazyFetch(agent_name);
+        if (ret != NIXL_SUCCESS)
+            return ret;
+    }
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    nixlRemoteSection* remote_section = nullptr;
+    nixl_agent_id_t    remote_id      = NIXL_INVALID_AGENT_ID;
+    if (!init_side) {
+        auto it = data->remoteAgentIds.find(agent_name);
+        if (it != data->remoteAgentIds.end()) {
+            remote_id      = it->second;
+            remote_section = data->getRemoteSection(remote_id);
+        }
+        if (!remote_section)
+            return NIXL_ERR_NOT_FOUND;
+    }
 
     if (!extra_params || extra_params->backends.size() == 0) {
         if (!init_side)
-            backend_set = data->remoteSections[agent_name]->
-                                queryBackends(descs.getType());
+            backend_set = remote_section->queryBackends(descs.getType());
         else
             backend_set = data->memorySection->
                                 queryBackends(descs.getType());
@@ -426,6 +1083,7 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
     } else {
         handle->isLocal     = false;
         handle->remoteAgent = agent_name;
+        handle->remoteId    = remote_id;
     }
 
     for (auto & backend : *backend_set) {
@@ -436,7 +1094,7 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
             ret = data->memorySection->populate(
                        descs, backend, *(handle->descs[backend]));
         else
-            ret = data->remoteSections[agent_name]->populate(
+            ret = remote_section->populate(
                        descs, backend, *(handle->descs[backend]));
         if (ret == NIXL_SUCCESS) {
             count++;
@@ -454,11 +1112,73 @@ nixlAgent::prepXferDlist (const std::string &agent_name,
         dlist_hndl = nullptr;
         return NIXL_ERR_NOT_FOUND;
     } else {
+        if (!init_side && data->config.lazyMDFetch)
+            data->lazyMDRef(agent_name);
         dlist_hndl = handle;
         return NIXL_SUCCESS;
     }
 }
 
+// Indices selected by makeXferReq, walked in order
+class nixlIndexVecCursor {
+    private:
+        const std::vector<int> &indices;
+        size_t                 pos = 0;
+
+    public:
+        nixlIndexVecCursor(const std::vector<int> &indices) : indices(indices) { }
+
+        size_t count() const { return indices.size(); }
+
+        bool inRange(const int &size) const {
+            for (auto & idx : indices)
+                if ((idx < 0) || (idx >= size))
+                    return false;
+            return true;
+        }
+
+        int next() { return indices[pos++]; }
+};
+
+// Same for index ranges, checked per range instead of per index
+class nixlIndexRangeCursor {
+    private:
+        const nixl_index_ranges_t &ranges;
+        size_t                    total = 0;
+        size_t                    range = 0;
+        int                       pos   = 0;
+
+    public:
+        nixlIndexRangeCursor(const nixl_index_ranges_t &ranges) : ranges(ranges) {
+            for (auto & r : ranges)
+                if (r.count > 0)
+                    total += r.count;
+        }
+
+        size_t count() const { return total; }
+
+        bool inRange(const int &size) const {
+            for (auto & r : ranges) {
+                if (r.count < 0)
+                    return false;
+                if (r.count == 0)
+                    continue;
+                int64_t last = (int64_t) r.start + (int64_t) (r.count - 1) * r.stride;
+                if ((r.start < 0) || (r.start >= size) || (last < 0) || (last >= size))
+                    return false;
+            }
+            return true;
+        }
+
+        int next() {
+            while (pos >= ranges[range].count) {
+                range++;
+                pos = 0;
+            }
+            return ranges[range].start + (pos++) * ranges[range].stride;
+        }
+};
+
 nixl_status_t
 nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
                         const nixlDlistH* local_side,
@@ -467,11 +1187,9 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
                         const std::vector<int> &remote_indices,
                         nixlXferReqH* &req_hndl,
                         const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("makeXferReq");
 
-    nixl_opt_b_args_t  opt_args;
-    nixl_status_t      ret;
-    int                desc_count = (int) local_indices.size();
-    nixlBackendEngine* backend    = nullptr;
+    nixlIndexVecCursor local_idx(local_indices), remote_idx(remote_indices);
 
     req_hndl = nullptr;
 
@@ -481,12 +1199,61 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
     if ((!local_side->isLocal) || (remote_side->isLocal))
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    nixl_status_t ret = data->makeXferReq(operation, local_side, local_idx, remote_side,
+                                          remote_idx, req_hndl, extra_params);
+    if ((ret == NIXL_SUCCESS) && data->config.lazyMDFetch)
+        data->lazyMDRef(req_hndl->remoteAgent);
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
+                        const nixlDlistH* local_side,
+                        const nixl_index_ranges_t &local_ranges,
+                        const nixlDlistH* remote_side,
+                        const nixl_index_ranges_t &remote_ranges,
+                        nixlXferReqH* &req_hndl,
+                        const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("makeXferReq");
+
+    nixlIndexRangeCursor local_idx(local_ranges), remote_idx(remote_ranges);
+
+    req_hndl = nullptr;
+
+    if (!local_side || !remote_side)
+        return NIXL_ERR_INVALID_PARAM;
+
+    if ((!local_side->isLocal) || (remote_side->isLocal))
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    nixl_status_t ret = data->makeXferReq(operation, local_side, local_idx, remote_side,
+                                          remote_idx, req_hndl, extra_params);
+    if ((ret == NIXL_SUCCESS) && data->config.lazyMDFetch)
+        data->lazyMDRef(req_hndl->remoteAgent);
+    return ret;
+}
+
+// Called with the lock held, shared or exclusively
+template <class LocalIdx, class RemoteIdx>
+nixl_status_t
+nixlAgentData::makeXferReq(const nixl_xfer_op_t &operation,
+                           const nixlDlistH* local_side,
+                           LocalIdx &local_idx,
+                           const nixlDlistH* remote_side,
+                           RemoteIdx &remote_idx,
+                           nixlXferReqH* &req_hndl,
+                           const nixl_opt_args_t* extra_params) {
+
+    nixl_opt_b_args_t  opt_args;
+    nixl_status_t      ret;
+    size_t             desc_count = local_idx.count();
+    nixlBackendEngine* backend    = nullptr;
+
     // The remote was invalidated in between prepXferDlist and this call
-    if (data->remoteSections.count(remote_side->remoteAgent) == 0) {
-        delete req_hndl;
+    if (!getRemoteSection(remote_side->remoteId))
         return NIXL_ERR_NOT_FOUND;
-    }
 
     if (extra_params && extra_params->backends.size() > 0) {
         for (auto & elm : extra_params->backends) {
@@ -515,21 +1282,12 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
     nixl_meta_dlist_t* local_descs  = local_side->descs.at(backend);
     nixl_meta_dlist_t* remote_descs = remote_side->descs.at(backend);
 
-    if ((desc_count == 0) || (remote_indices.size() == 0) ||
-        (desc_count != (int) remote_indices.size()))
+    if ((desc_count == 0) || (desc_count != remote_idx.count()))
         return NIXL_ERR_INVALID_PARAM;
 
-    for (int i=0; i<desc_count; ++i) {
-        if ((local_indices[i] >= local_descs->descCount())
-               || (local_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((remote_indices[i] >= remote_descs->descCount())
-               || (remote_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((*local_descs )[local_indices [i]].len !=
-            (*remote_descs)[remote_indices[i]].len)
-            return NIXL_ERR_INVALID_PARAM;
-    }
+    if (!local_idx.inRange(local_descs->descCount()) ||
+        !remote_idx.inRange(remote_descs->descCount()))
+        return NIXL_ERR_INVALID_PARAM;
 
     if (extra_params && extra_params->hasNotif) {
         opt_args.notifMsg = extra_params->notifMsg;
@@ -542,66 +1300,65 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
 
     // Populate has been already done, no benefit in having sorted descriptors
     // which will be overwritten by [] assignment operator.
-    nixlXferReqH* handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs->getType(),
-                                     false, desc_count);
-
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs->getType(),
-                                     false, desc_count);
-
-    if (extra_params && extra_params->skipDescMerge) {
-        for (int i=0; i<desc_count; ++i) {
-            (*handle->initiatorDescs)[i] =
-                                     (*local_descs)[local_indices[i]];
-            (*handle->targetDescs)[i] =
-                                     (*remote_descs)[remote_indices[i]];
+    nixlXferReqH* handle = xferReqPool.get(local_descs->getType(), false,
+                                           remote_descs->getType(), false);
+    handle->initiatorDescs->resize(desc_count);
+    handle->targetDescs->resize(desc_count);
+
+    // Consecutive descriptors are merged into the previous one, unless skipped
+    bool         skip_merge = extra_params && extra_params->skipDescMerge;
+    nixlMetaDesc local_desc, remote_desc;
+    int          j = 0; //final list size
+    for (size_t i = 0; i < desc_count; ++i) {
+        const nixlMetaDesc &local_next  = (*local_descs) [local_idx.next()];
+        const nixlMetaDesc &remote_next = (*remote_descs)[remote_idx.next()];
+
+        if (local_next.len != remote_next.len) {
+            xferReqPool.put(handle);
+            return NIXL_ERR_INVALID_PARAM;
         }
-    } else {
-        int i = 0, j = 0; //final list size
-        while (i<(desc_count)) {
-            nixlMetaDesc local_desc1  = (*local_descs) [local_indices[i]];
-            nixlMetaDesc remote_desc1 = (*remote_descs)[remote_indices[i]];
-
-            if(i != (desc_count-1) ) {
-                nixlMetaDesc* local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                nixlMetaDesc* remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
-
-              while (((local_desc1.addr + local_desc1.len) == local_desc2->addr)
-                  && ((remote_desc1.addr + remote_desc1.len) == remote_desc2->addr)
-                  && (local_desc1.metadataP == local_desc2->metadataP)
-                  && (remote_desc1.metadataP == remote_desc2->metadataP)
-                  && (local_desc1.devId == local_desc2->devId)
-                  && (remote_desc1.devId == remote_desc2->devId)) {
-
-                    local_desc1.len += local_desc2->len;
-                    remote_desc1.len += remote_desc2->len;
-
-                    i++;
-                    if(i == (desc_count-1)) break;
-
-                    local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                    remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
-                }
-            }
 
-            (*handle->initiatorDescs)[j] = local_desc1;
-            (*handle->targetDescs)   [j] = remote_desc1;
+        if ((i > 0) && !skip_merge
+            && ((local_desc.addr + local_desc.len) == local_next.addr)
+            && ((remote_desc.addr + remote_desc.len) == remote_next.addr)
+            && (local_desc.metadataP == local_next.metadataP)
+            && (remote_desc.metadataP == remote_next.metadataP)
+            && (local_desc.devId == local_next.devId)
+            && (remote_desc.devId == remote_next.devId)) {
+            local_desc.len  += local_next.len;
+            remote_desc.len += remote_next.len;
+            continue;
+        }
+
+        if (i > 0) {
+            (*handle->initiatorDescs)[j] = local_desc;
+            (*handle->targetDescs)   [j] = remote_desc;
             j++;
-            i++;
         }
-        NIXL_DEBUG << "reqH descList size down to " << j;
-        handle->initiatorDescs->resize(j);
-        handle->targetDescs->resize(j);
+        local_desc  = local_next;
+        remote_desc = remote_next;
     }
+    (*handle->initiatorDescs)[j] = local_desc;
+    (*handle->targetDescs)   [j] = remote_desc;
+    j++;
+
+    NIXL_DEBUG << "reqH descList size down to " << j;
+    handle->initiatorDescs->resize(j);
+    handle->targetDescs->resize(j);
 
     handle->engine      = backend;
     handle->remoteAgent = remote_side->remoteAgent;
+    handle->remoteId    = remote_side->remoteId;
     handle->notifMsg    = opt_args.notifMsg;
     handle->hasNotif    = opt_args.hasNotif;
     handle->backendOp   = operation;
     handle->status      = NIXL_ERR_NOT_POSTED;
+    handle->callback    = extra_params ? extra_params->xferCallback : nullptr;
+    handle->callbackCtx = extra_params ? extra_params->xferCallbackCtx : nullptr;
+    handle->priority    = extra_params ? extra_params->priority :
+                                         nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
+    handle->useCq       = (extra_params && extra_params->useCompletionQueue) || handle->callback;
+    opt_args.priority   = handle->priority;
 
     ret = handle->engine->prepXfer (handle->backendOp,
                                     *handle->initiatorDescs,
@@ -610,7 +1367,7 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
                                     handle->backendHandle,
                                     &opt_args);
     if (ret != NIXL_SUCCESS) {
-        delete handle;
+        xferReqPool.put(handle);
         return ret;
     }
 
@@ -618,108 +1375,137 @@ nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
     return NIXL_SUCCESS;
 }
 
+// Called with the lock held, shared or exclusively
 nixl_status_t
-nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
-                         const nixl_xfer_dlist_t &local_descs,
-                         const nixl_xfer_dlist_t &remote_descs,
-                         const std::string &remote_agent,
-                         nixlXferReqH* &req_hndl,
-                         const nixl_opt_args_t* extra_params) const {
+nixlAgentData::createXferReq(const nixl_xfer_op_t &operation,
+                             const nixl_xfer_dlist_t &local_descs,
+                             const nixl_xfer_dlist_t &remote_descs,
+                             const nixl_agent_id_t &remote_id,
+                             nixlXferReqH* &req_hndl,
+                             const nixl_opt_args_t* extra_params) {
     nixl_status_t     ret1, ret2;
-    nixl_opt_b_args_t opt_args;
-    backend_set_t*    backend_set = new backend_set_t();
-
-    req_hndl = nullptr;
+    nixl_opt_b_args_t     opt_args;
+    backend_list_t        backend_list;
+    backend_list_t        ordered_list;
+    const backend_list_t* backend_cands;
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (data->remoteSections.count(remote_agent) == 0)
+    nixlRemoteSection* remote_section = getRemoteSection(remote_id);
+    if (!remote_section)
         return NIXL_ERR_NOT_FOUND;
+    const std::string &remote_agent = remoteAgents[remote_id].name;
 
     // Check the correspondence between descriptor lists
     if (local_descs.descCount() != remote_descs.descCount())
         return NIXL_ERR_INVALID_PARAM;
-    for (int i=0; i<local_descs.descCount(); ++i)
-        if (local_descs[i].len != remote_descs[i].len)
-            return NIXL_ERR_INVALID_PARAM;
+    if (!local_descs.isEmpty() &&
+        (nixlDescLenMismatch(&local_descs[0], &remote_descs[0], local_descs.descCount()) !=
+         (size_t) local_descs.descCount()))
+        return NIXL_ERR_INVALID_PARAM;
 
     if (!extra_params || extra_params->backends.size() == 0) {
-        // Finding backends that support the corresponding memories
-        // locally and remotely, and find the common ones.
-        backend_set_t* local_set =
-            data->memorySection->queryBackends(local_descs.getType());
-        backend_set_t* remote_set =
-            data->remoteSections[remote_agent]->queryBackends(
-                                                remote_descs.getType());
-        if (!local_set || !remote_set) {
-            delete backend_set;
-            return NIXL_ERR_NOT_FOUND;
-        }
-
-        for (auto & elm : *local_set)
-            if (remote_set->count(elm) != 0)
-                backend_set->insert(elm);
-
-        if (backend_set->empty()) {
-            delete backend_set;
+        // Backends that have the corresponding memories registered locally
+        // and remotely, computed once until memory or metadata changes.
+        backend_cands = getXferCandidates(local_descs.getType(),
+                                          remote_id,
+                                          remote_descs.getType());
+        if (!backend_cands || backend_cands->empty())
             return NIXL_ERR_NOT_FOUND;
-        }
     } else {
         for (auto & elm : extra_params->backends)
-            backend_set->insert(elm->engine);
+            backend_list.push_back(elm->engine);
+        backend_cands = &backend_list;
     }
 
-    // TODO: when central KV is supported, add a call to fetchRemoteMD
-    // TODO: merge descriptors back to back in memory (like makeXferReq).
-    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
-
-    nixlXferReqH *handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs.getType(),
-                                     local_descs.isSorted());
+    if (extra_params && (extra_params->backendPolicy !=
+                         nixl_backend_policy_t::NIXL_BACKEND_POLICY_FIRST)) {
+        orderBackends(extra_params, *backend_cands, local_descs,
+                      remote_descs.getType(), remote_agent, ordered_list);
+        backend_cands = &ordered_list;
+    }
 
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs.getType(),
-                                     remote_descs.isSorted());
+    nixlXferReqH *handle = xferReqPool.get(local_descs.getType(),
+                                                 local_descs.isSorted(),
+                                                 remote_descs.getType(),
+                                                 remote_descs.isSorted());
 
-    // Currently we loop through and find first local match. Can use a
-    // preference list or more exhaustive search.
-    for (auto & backend : *backend_set) {
+    // First match in the order set by the selection policy
+    size_t idx = 0;
+    while ((idx < backend_cands->size()) && !handle->engine) {
+        nixlBackendEngine* backend = (*backend_cands)[idx++];
         // If populate fails, it clears the resp before return
-        ret1 = data->memorySection->populate(
+        ret1 = memorySection->populate(
                      local_descs, backend, *handle->initiatorDescs);
-        ret2 = data->remoteSections[remote_agent]->populate(
+        ret2 = remote_section->populate(
                      remote_descs, backend, *handle->targetDescs);
 
         if ((ret1 == NIXL_SUCCESS) && (ret2 == NIXL_SUCCESS)) {
             // For Logging:
             // std::cout << "Selected backend: " << backend->getType() << "\n";
             handle->engine = backend;
-            break;
         }
     }
 
-    delete backend_set;
-
     if (!handle->engine) {
-        delete handle;
+        xferReqPool.put(handle);
         return NIXL_ERR_NOT_FOUND;
     }
 
+    // The next matches take a piece of the transfer each, if requested
+    size_t split_count = extra_params ? extra_params->splitCount : 1;
+    while ((handle->parts.size() + 1 < split_count) &&
+           (idx < backend_cands->size())) {
+        nixlBackendEngine* backend = (*backend_cands)[idx++];
+        nixlXferReqH* part = xferReqPool.get(local_descs.getType(),
+                                                   local_descs.isSorted(),
+                                                   remote_descs.getType(),
+                                                   remote_descs.isSorted());
+        ret1 = memorySection->populate(
+                     local_descs, backend, *part->initiatorDescs);
+        ret2 = remote_section->populate(
+                     remote_descs, backend, *part->targetDescs);
+
+        if ((ret1 == NIXL_SUCCESS) && (ret2 == NIXL_SUCCESS)) {
+            part->engine = backend;
+            handle->parts.push_back(part);
+        } else {
+            xferReqPool.put(part);
+        }
+    }
+
+    if (!handle->parts.empty())
+        splitXferBytes(handle);
+
+    // Merging after populate, so the metadata of both sides is also compared
+    if (!extra_params || !extra_params->skipDescMerge) {
+        int j = mergeContiguousDescs(*handle->initiatorDescs,
+                                     *handle->targetDescs);
+        NIXL_DEBUG << "reqH descList size down to " << j;
+        for (auto & part : handle->parts)
+            mergeContiguousDescs(*part->initiatorDescs, *part->targetDescs);
+    }
+
     if (extra_params && extra_params->hasNotif) {
         opt_args.notifMsg = extra_params->notifMsg;
         opt_args.hasNotif = true;
     }
 
     if (opt_args.hasNotif && (!handle->engine->supportsNotif())) {
-        delete handle;
+        xferReqPool.put(handle);
         return NIXL_ERR_BACKEND;
     }
 
     handle->remoteAgent = remote_agent;
+    handle->remoteId    = remote_id;
     handle->backendOp   = operation;
     handle->status      = NIXL_ERR_NOT_POSTED;
     handle->notifMsg    = opt_args.notifMsg;
     handle->hasNotif    = opt_args.hasNotif;
+    handle->callback    = extra_params ? extra_params->xferCallback : nullptr;
+    handle->callbackCtx = extra_params ? extra_params->xferCallbackCtx : nullptr;
+    handle->priority    = extra_params ? extra_params->priority :
+                                         nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
+    handle->useCq       = (extra_params && extra_params->useCompletionQueue) || handle->callback;
+    opt_args.priority   = handle->priority;
 
     ret1 = handle->engine->prepXfer (handle->backendOp,
                                      *handle->initiatorDescs,
@@ -728,17 +1514,127 @@ nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
                                      handle->backendHandle,
                                      &opt_args);
     if (ret1 != NIXL_SUCCESS) {
-        delete handle;
+        xferReqPool.put(handle);
         return ret1;
     }
 
+    // Pieces don't carry the notification, it's sent after all are done
+    for (auto & part : handle->parts) {
+        nixl_opt_b_args_t part_args;
+
+        part->remoteAgent = remote_agent;
+        part->remoteId    = remote_id;
+        part->backendOp   = operation;
+        part->status      = NIXL_ERR_NOT_POSTED;
+
+        ret1 = part->engine->prepXfer (part->backendOp,
+                                       *part->initiatorDescs,
+                                       *part->targetDescs,
+                                       part->remoteAgent,
+                                       part->backendHandle,
+                                       &part_args);
+        if (ret1 != NIXL_SUCCESS) {
+            xferReqPool.put(handle);
+            return ret1;
+        }
+    }
+
     req_hndl = handle;
     return NIXL_SUCCESS;
 }
 
+nixl_status_t
+nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
+                         const nixl_xfer_dlist_t &local_descs,
+                         const nixl_xfer_dlist_t &remote_descs,
+                         const std::string &remote_agent,
+                         nixlXferReqH* &req_hndl,
+                         const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("createXferReq");
+    nixl_status_t ret;
+
+    req_hndl = nullptr;
+
+    if (data->config.lazyMDFetch) {
+        ret = data->lazyFetch(remote_agent);
+        if (ret != NIXL_SUCCESS)
+            return ret;
+    }
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto it = data->remoteAgentIds.find(remote_agent);
+    if (it == data->remoteAgentIds.end())
+        return NIXL_ERR_NOT_FOUND;
+
+    ret = data->createXferReq(operation, local_descs, remote_descs,
+                              it->second, req_hndl, extra_params);
+    if ((ret == NIXL_SUCCESS) && data->config.lazyMDFetch)
+        data->lazyMDRef(req_hndl->remoteAgent);
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
+                         const nixl_xfer_dlist_t &local_descs,
+                         const nixl_xfer_dlist_t &remote_descs,
+                         const nixl_agent_id_t &remote_id,
+                         nixlXferReqH* &req_hndl,
+                         const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("createXferReq");
+    nixl_status_t ret;
+
+    req_hndl = nullptr;
+
+    if (data->config.lazyMDFetch) {
+        std::string remote_agent;
+        {
+            NIXL_SHARED_LOCK_GUARD(data->lock);
+            if (remote_id >= data->remoteAgents.size())
+                return NIXL_ERR_NOT_FOUND;
+            remote_agent = data->remoteAgents[remote_id].name;
+        }
+        ret = data->lazyFetch(remote_agent);
+        if (ret != NIXL_SUCCESS)
+            return ret;
+    }
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    ret = data->createXferReq(operation, local_descs, remote_descs,
+                              remote_id, req_hndl, extra_params);
+    if ((ret == NIXL_SUCCESS) && data->config.lazyMDFetch)
+        data->lazyMDRef(req_hndl->remoteAgent);
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::getRemoteAgentId(const std::string &remote_agent,
+                            nixl_agent_id_t &agent_id) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto it = data->remoteAgentIds.find(remote_agent);
+    if ((it == data->remoteAgentIds.end()) || !data->getRemoteSection(it->second))
+        return NIXL_ERR_NOT_FOUND;
+    agent_id = it->second;
+    return NIXL_SUCCESS;
+}
+
+static void fillSubmission(nixlXferSubmission &sub, nixlXferReqH* req_hndl,
+                           const nixl_opt_args_t* extra_params) {
+    sub.req = req_hndl;
+    if (extra_params) {
+        sub.hasArgs    = true;
+        sub.hasNotif   = extra_params->hasNotif;
+        sub.useCq      = extra_params->useCompletionQueue;
+        sub.cudaStream = extra_params->cudaStream;
+        sub.cudaEvent  = extra_params->cudaEvent;
+        if (extra_params->hasNotif)
+            sub.notifMsg = extra_params->notifMsg;
+    }
+}
+
 nixl_status_t
 nixlAgent::postXferReq(nixlXferReqH *req_hndl,
                        const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("postXferReq");
     nixl_status_t ret;
     nixl_opt_b_args_t opt_args;
 
@@ -747,21 +1643,68 @@ nixlAgent::postXferReq(nixlXferReqH *req_hndl,
     if (!req_hndl)
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
-    // Check if the remote was invalidated before post/repost
-    if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-        delete req_hndl;
-        return NIXL_ERR_NOT_FOUND;
+    bool queued_post = req_hndl->submitState.load(std::memory_order_relaxed) ==
+                       nixlXferReqH::SUBMIT_POSTING;
+
+    // Fails the post. The request is released if the error goes to the caller,
+    // otherwise the caller got NIXL_IN_PROG, still owns it and finds the error
+    // through getXferStatus or the completion queue.
+    auto fail_post = [&](const nixl_status_t &err) {
+        data->completionQueue.remove(req_hndl);
+        data->xferScheduler.release(req_hndl);
+        if (!queued_post) {
+            data->xferReqPool.put(req_hndl);
+            return err;
+        }
+        req_hndl->submitErr = err;
+        if (req_hndl->useCq)
+            data->completionQueue.addCompleted(req_hndl, err);
+        req_hndl->submitState.store(nixlXferReqH::SUBMIT_NONE, std::memory_order_release);
+        return err;
+    };
+
+    // Deferred requests go first, unless this is one of them being posted
+    if (!queued_post) {
+        req_hndl->submitErr = NIXL_SUCCESS;
+        data->checkDeferred(const_cast<nixlAgent*>(this));
     }
 
-    // We can't repost while a request is in progress
-    if (req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
-        if (req_hndl->status == NIXL_IN_PROG) {
-            delete req_hndl;
+    // Queued for the progress thread without the agent lock, unless full
+    if (data->submitQueue && !data->progressDriver->isProgressThread()) {
+        uint8_t state = nixlXferReqH::SUBMIT_NONE;
+        if (!req_hndl->submitState.compare_exchange_strong(state, nixlXferReqH::SUBMIT_QUEUED,
+                                                           std::memory_order_acquire))
             return NIXL_ERR_REPOST_ACTIVE;
+
+        nixlXferSubmission sub;
+        fillSubmission(sub, req_hndl, extra_params);
+        if (data->submitQueue->push(sub)) {
+            data->progressDriver->wake();
+            return NIXL_IN_PROG;
         }
+        req_hndl->submitState.store(nixlXferReqH::SUBMIT_NONE, std::memory_order_relaxed);
+    }
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // Check if the remote was invalidated before post/repost
+    if (!data->getRemoteSection(req_hndl->remoteId))
+        return fail_post(NIXL_ERR_NOT_FOUND);
+
+    // We can't repost while a request is in progress
+    if (req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->checkXfer();
+        if (req_hndl->status == NIXL_IN_PROG)
+            return fail_post(NIXL_ERR_REPOST_ACTIVE);
+        data->finishXfer(req_hndl, req_hndl->status);
+    }
+
+    // Beyond the bytes in flight of its class, posted once some finish
+    if (data->xferScheduler.isEnabled() && !data->xferScheduler.reserve(req_hndl)) {
+        nixlXferSubmission sub;
+        fillSubmission(sub, req_hndl, extra_params);
+        req_hndl->submitState.store(nixlXferReqH::SUBMIT_QUEUED, std::memory_order_release);
+        data->xferScheduler.defer(std::move(sub));
+        return NIXL_IN_PROG;
     }
 
     // Carrying over notification from xfer handle creation time
@@ -783,57 +1726,382 @@ nixlAgent::postXferReq(nixlXferReqH *req_hndl,
         }
     }
 
-    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif())) {
-        delete req_hndl;
-        return NIXL_ERR_BACKEND;
+    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif()))
+        return fail_post(NIXL_ERR_BACKEND);
+
+    if (extra_params && extra_params->useCompletionQueue)
+        req_hndl->useCq = true;
+    data->prepCompletion(req_hndl, opt_args);
+
+    if (extra_params) {
+        opt_args.cudaStream = extra_params->cudaStream;
+        opt_args.cudaEvent  = extra_params->cudaEvent;
     }
+    opt_args.priority = req_hndl->priority;
 
     // If status is not NIXL_IN_PROG we can repost,
-    ret = req_hndl->engine->postXfer (req_hndl->backendOp,
-                                     *req_hndl->initiatorDescs,
-                                     *req_hndl->targetDescs,
-                                      req_hndl->remoteAgent,
-                                      req_hndl->backendHandle,
-                                      &opt_args);
+    data->startXfer(req_hndl);
+    ret = req_hndl->postXfer(opt_args);
     req_hndl->status = ret;
+    if (ret != NIXL_IN_PROG)
+        data->finishXfer(req_hndl, ret);
+
+    // Posted from the submission queue, errors are reported as completions,
+    // as the caller did not get them. The caller can check it once done.
+    if (queued_post) {
+        if (ret < 0)
+            req_hndl->submitErr = ret;
+        if ((ret < 0) && req_hndl->useCq)
+            data->completionQueue.addCompleted(req_hndl, ret);
+        else
+            data->postCompletion(req_hndl, opt_args, ret);
+        req_hndl->submitState.store(nixlXferReqH::SUBMIT_NONE, std::memory_order_release);
+        return ret;
+    }
+
+    data->postCompletion(req_hndl, opt_args, ret);
     return ret;
 }
 
+void nixlAgentData::postSubmission(nixlAgent* myAgent, nixlXferSubmission &sub) {
+    sub.req->submitState.store(nixlXferReqH::SUBMIT_POSTING, std::memory_order_relaxed);
+    if (!sub.hasArgs) {
+        myAgent->postXferReq(sub.req);
+    } else {
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif           = sub.hasNotif;
+        extra_params.notifMsg           = std::move(sub.notifMsg);
+        extra_params.useCompletionQueue = sub.useCq;
+        extra_params.cudaStream         = sub.cudaStream;
+        extra_params.cudaEvent          = sub.cudaEvent;
+        myAgent->postXferReq(sub.req, &extra_params);
+    }
+}
+
+bool nixlAgentData::postSubmissions(nixlAgent* myAgent) {
+    nixlXferSubmission sub;
+    bool               posted = false;
+
+    // Bounded, so the engines are progressed while posts keep coming
+    for (size_t i = 0; (i < submitQueue->capacity()) && submitQueue->pop(sub); ++i) {
+        postSubmission(myAgent, sub);
+        posted = true;
+    }
+    return posted;
+}
+
+bool nixlAgentData::postDeferred(nixlAgent* myAgent) {
+    std::vector<nixlXferSubmission> ready;
+
+    xferScheduler.takeReady(ready);
+    for (auto & sub : ready)
+        postSubmission(myAgent, sub);
+    return !ready.empty();
+}
+
+nixl_status_t
+nixlAgent::postXferReqs(const std::vector<nixlXferReqH*> &req_hndls,
+                        std::vector<nixl_status_t> &statuses,
+                        const nixl_opt_args_t* extra_params) const {
+    NIXL_TRACE_SPAN("postXferReqs");
+    // One batch per backend, and the index of each element in req_hndls
+    std::vector<nixlBackendEngine*>  engines;
+    std::vector<nixl_b_xfer_batch_t> batches;
+    std::vector<std::vector<size_t>> indices;
+
+    statuses.assign(req_hndls.size(), NIXL_ERR_NOT_POSTED);
+    data->checkDeferred(const_cast<nixlAgent*>(this));
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    for (size_t i=0; i<req_hndls.size(); ++i) {
+        nixlXferReqH* req_hndl = req_hndls[i];
+        nixlBackendXferArgs xfer;
+
+        if (!req_hndl) {
+            statuses[i] = NIXL_ERR_INVALID_PARAM;
+            continue;
+        }
+
+        if (req_hndl->submitPending()) {
+            statuses[i] = NIXL_ERR_REPOST_ACTIVE;
+            continue;
+        }
+
+        // Check if the remote was invalidated before post/repost
+        if (!data->getRemoteSection(req_hndl->remoteId)) {
+            statuses[i] = NIXL_ERR_NOT_FOUND;
+            continue;
+        }
+
+        // We can't repost while a request is in progress
+        if (req_hndl->status == NIXL_IN_PROG) {
+            req_hndl->status = req_hndl->checkXfer();
+            if (req_hndl->status == NIXL_IN_PROG) {
+                statuses[i] = NIXL_ERR_REPOST_ACTIVE;
+                continue;
+            }
+            data->finishXfer(req_hndl, req_hndl->status);
+        }
+
+        // Same deferral as postXferReq, posted with the optional args given here
+        if (data->xferScheduler.isEnabled() && !data->xferScheduler.reserve(req_hndl)) {
+            nixlXferSubmission sub;
+            fillSubmission(sub, req_hndl, extra_params);
+            req_hndl->submitState.store(nixlXferReqH::SUBMIT_QUEUED, std::memory_order_release);
+            data->xferScheduler.defer(std::move(sub));
+            statuses[i] = NIXL_IN_PROG;
+            continue;
+        }
+
+        // Same notification handling as postXferReq
+        if (extra_params) {
+            req_hndl->hasNotif = extra_params->hasNotif;
+            if (extra_params->hasNotif)
+                req_hndl->notifMsg = extra_params->notifMsg;
+        }
+        xfer.optArgs.hasNotif = req_hndl->hasNotif;
+        if (req_hndl->hasNotif)
+            xfer.optArgs.notifMsg = req_hndl->notifMsg;
+
+        if (xfer.optArgs.hasNotif && (!req_hndl->engine->supportsNotif())) {
+            data->xferScheduler.release(req_hndl);
+            statuses[i] = NIXL_ERR_BACKEND;
+            continue;
+        }
+
+        if (extra_params && extra_params->useCompletionQueue)
+            req_hndl->useCq = true;
+        data->prepCompletion(req_hndl, xfer.optArgs);
+        xfer.optArgs.priority = req_hndl->priority;
+
+        // Split transfers are posted on their own, over several backends
+        if (!req_hndl->parts.empty()) {
+            data->startXfer(req_hndl);
+            req_hndl->status = req_hndl->postXfer(xfer.optArgs);
+            statuses[i]      = req_hndl->status;
+            if (req_hndl->status != NIXL_IN_PROG)
+                data->finishXfer(req_hndl, req_hndl->status);
+            data->postCompletion(req_hndl, xfer.optArgs, req_hndl->status);
+            continue;
+        }
+
+        xfer.operation   = req_hndl->backendOp;
+        xfer.local       = req_hndl->initiatorDescs;
+        xfer.remote      = req_hndl->targetDescs;
+        xfer.remoteAgent = &req_hndl->remoteAgent;
+        xfer.handle      = req_hndl->backendHandle;
+        xfer.status      = NIXL_ERR_NOT_POSTED;
+
+        size_t j = 0;
+        while ((j < engines.size()) && (engines[j] != req_hndl->engine))
+            j++;
+        if (j == engines.size()) {
+            engines.push_back(req_hndl->engine);
+            batches.emplace_back();
+            indices.emplace_back();
+        }
+        batches[j].push_back(std::move(xfer));
+        indices[j].push_back(i);
+        data->startXfer(req_hndl);
+    }
+
+    for (size_t j=0; j<engines.size(); ++j) {
+        {
+            NIXL_TRACE_SPAN("backend.postXfers");
+            engines[j]->postXfers(batches[j]);
+        }
+
+        for (size_t k=0; k<batches[j].size(); ++k) {
+            nixlXferReqH* req_hndl  = req_hndls[indices[j][k]];
+            req_hndl->backendHandle = batches[j][k].handle;
+            req_hndl->status        = batches[j][k].status;
+            statuses[indices[j][k]] = batches[j][k].status;
+            if (req_hndl->status != NIXL_IN_PROG)
+                data->finishXfer(req_hndl, req_hndl->status);
+            data->postCompletion(req_hndl, batches[j][k].optArgs,
+                           batches[j][k].status);
+        }
+    }
+
+    return mergeStatuses(statuses);
+}
+
 nixl_status_t
 nixlAgent::getXferStatus (nixlXferReqH *req_hndl) {
+    NIXL_TRACE_SPAN("getXferStatus");
 
-    NIXL_LOCK_GUARD(data->lock);
+    data->checkDeferred(this);
+
+    // Not posted yet by the progress thread, or deferred by the scheduler
+    if (req_hndl->submitPending())
+        return NIXL_IN_PROG;
+    // The progress thread failed to post it
+    if (req_hndl->submitErr != NIXL_SUCCESS)
+        return req_hndl->submitErr;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     // If the status is done, no need to recheck.
     if (req_hndl->status != NIXL_SUCCESS) {
         // Check if the remote was invalidated before completion
-        if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-            delete req_hndl;
+        if (!data->getRemoteSection(req_hndl->remoteId)) {
+            data->completionQueue.remove(req_hndl);
+            data->xferScheduler.release(req_hndl);
+            data->xferReqPool.put(req_hndl);
             return NIXL_ERR_NOT_FOUND;
         }
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
+        req_hndl->status = req_hndl->checkXfer();
+        if (req_hndl->status != NIXL_IN_PROG)
+            data->finishXfer(req_hndl, req_hndl->status);
     }
 
     return req_hndl->status;
 }
 
 
+nixl_status_t
+nixlAgent::getXferStatus (const std::vector<nixlXferReqH*> &req_hndls,
+                          std::vector<nixl_status_t> &statuses) {
+    NIXL_TRACE_SPAN("getXferStatus");
+
+    statuses.resize(req_hndls.size());
+    data->checkDeferred(this);
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    for (size_t i=0; i<req_hndls.size(); ++i) {
+        nixlXferReqH* req_hndl = req_hndls[i];
+
+        if (!req_hndl) {
+            statuses[i] = NIXL_ERR_INVALID_PARAM;
+            continue;
+        }
+
+        if (req_hndl->submitPending()) {
+            statuses[i] = NIXL_IN_PROG;
+            continue;
+        }
+
+        if (req_hndl->submitErr != NIXL_SUCCESS) {
+            statuses[i] = req_hndl->submitErr;
+            continue;
+        }
+
+        // If the status is done, no need to recheck.
+        if (req_hndl->status != NIXL_SUCCESS) {
+            // Check if the remote was invalidated before completion
+            if (!data->getRemoteSection(req_hndl->remoteId)) {
+                statuses[i] = NIXL_ERR_NOT_FOUND;
+                continue;
+            }
+            req_hndl->status = req_hndl->checkXfer();
+            if (req_hndl->status != NIXL_IN_PROG)
+                data->finishXfer(req_hndl, req_hndl->status);
+        }
+        statuses[i] = req_hndl->status;
+    }
+
+    return mergeStatuses(statuses);
+}
+
 nixl_status_t
 nixlAgent::queryXferBackend(const nixlXferReqH* req_hndl,
                             nixlBackendH* &backend) const {
-    NIXL_LOCK_GUARD(data->lock);
-    backend = data->backendHandles[req_hndl->engine->getType()];
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    backend = data->backendHandles.at(req_hndl->engine->getType());
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getXferStats(const nixlXferReqH* req_hndl,
+                        nixl_b_params_t &stats) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    stats.clear();
+    return req_hndl->engine->getXferStats(req_hndl->backendHandle, stats);
+}
+
+nixl_status_t
+nixlAgent::getProgressStats(nixlProgressStats &stats) const {
+    if (!data->progressDriver)
+        return NIXL_ERR_NOT_SUPPORTED;
+    data->progressDriver->getStats(stats);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getXferQueueStats(nixlXferQueueStats &stats,
+                             const std::string &remote_agent) const {
+    if (!data->xferScheduler.isEnabled())
+        return NIXL_ERR_NOT_SUPPORTED;
+    data->xferScheduler.getStats(stats, remote_agent);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getTelemetry(nixl_xfer_telemetry_t &telemetry) const {
+    nixlTelemetry::counter_map_t counters;
+
+    if (!data->telemetry.isEnabled())
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    data->telemetry.snapshot(counters);
+    telemetry.clear();
+    telemetry.reserve(counters.size());
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    for (auto & elm : counters) {
+        nixlXferTelemetry entry;
+        entry.backend     = elm.first.engine->getType();
+        entry.op          = elm.first.op;
+        if (elm.first.remoteId < data->remoteAgents.size())
+            entry.remoteAgent = data->remoteAgents[elm.first.remoteId].name;
+        entry.posts       = elm.second.posts;
+        entry.bytes       = elm.second.bytes;
+        entry.completions = elm.second.completions;
+        entry.errors      = elm.second.errors;
+        entry.latencyUs   = elm.second.latencyUs;
+        telemetry.push_back(std::move(entry));
+    }
+
+    std::sort(telemetry.begin(), telemetry.end(),
+              [](const nixlXferTelemetry &a, const nixlXferTelemetry &b) {
+                  return std::tie(a.backend, a.remoteAgent, a.op) <
+                         std::tie(b.backend, b.remoteAgent, b.op);
+              });
     return NIXL_SUCCESS;
 }
 
+void nixlAgentData::telemetryWorker(nixlAgent* myAgent) {
+    std::unique_lock<std::mutex> guard(telemetryLock);
+    nixl_xfer_telemetry_t        telemetry;
+
+    while (!telemetryCv.wait_for(guard, std::chrono::milliseconds(config.telemetryDumpMs),
+                                 [this]() { return telemetryStop; })) {
+        guard.unlock();
+        myAgent->getTelemetry(telemetry);
+        for (auto & elm : telemetry)
+            NIXL_INFO << "Telemetry of " << name << ": " << elm.backend << " "
+                      << nixlEnumStrings::xferOpStr(elm.op) << " to " << elm.remoteAgent
+                      << ", " << elm.posts << " posts, " << elm.bytes << " bytes, "
+                      << elm.completions << " completions, " << elm.errors << " errors, "
+                      << "p50 " << elm.getLatencyUs(0.5) << "us, p99 "
+                      << elm.getLatencyUs(0.99) << "us";
+        guard.lock();
+    }
+}
+
 nixl_status_t
 nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) {
 
-    NIXL_LOCK_GUARD(data->lock);
+    // Still referenced by the submission queue, deferred ones are dropped
+    if (req_hndl->submitPending()) {
+        if (!data->xferScheduler.cancel(req_hndl))
+            return NIXL_ERR_REPOST_ACTIVE;
+        req_hndl->submitState.store(nixlXferReqH::SUBMIT_NONE, std::memory_order_relaxed);
+    }
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     //attempt to cancel request
     if(req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
+        req_hndl->status = req_hndl->checkXfer();
 
         if(req_hndl->status == NIXL_IN_PROG) {
 
@@ -848,13 +2116,38 @@ nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) {
             req_hndl->backendHandle = nullptr;
         }
     }
-    delete req_hndl;
+    data->completionQueue.remove(req_hndl);
+    data->xferScheduler.release(req_hndl);
+    if (data->config.lazyMDFetch)
+        data->lazyMDUnref(req_hndl->remoteAgent);
+    data->xferReqPool.put(req_hndl);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::pollCompletions(const size_t &max,
+                           std::vector<nixlXferReqH*> &completed) {
+    NIXL_TRACE_SPAN("pollCompletions");
+    data->checkDeferred(this);
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->completionQueue.poll(max, completed);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getCompletionFd(int &fd) const {
+    fd = data->completionQueue.getFd();
+    if (fd < 0)
+        return NIXL_ERR_BACKEND;
     return NIXL_SUCCESS;
 }
 
 nixl_status_t
 nixlAgent::releasedDlistH (nixlDlistH* dlist_hndl) const {
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (data->config.lazyMDFetch && dlist_hndl && !dlist_hndl->isLocal)
+        data->lazyMDUnref(dlist_hndl->remoteAgent);
     delete dlist_hndl;
     return NIXL_SUCCESS;
 }
@@ -862,11 +2155,12 @@ nixlAgent::releasedDlistH (nixlDlistH* dlist_hndl) const {
 nixl_status_t
 nixlAgent::getNotifs(nixl_notifs_t &notif_map,
                      const nixl_opt_args_t* extra_params) {
+    NIXL_TRACE_SPAN("getNotifs");
     notif_list_t    bknd_notif_list;
     nixl_status_t   ret, bad_ret=NIXL_SUCCESS;
     backend_list_t* backend_list;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     if (!extra_params || extra_params->backends.size() == 0) {
         backend_list = &data->notifEngines;
         if (backend_list->empty())
@@ -895,12 +2189,8 @@ nixlAgent::getNotifs(nixl_notifs_t &notif_map,
         if (bknd_notif_list.size() == 0)
             continue;
 
-        for (auto & elm: bknd_notif_list) {
-            if (notif_map.count(elm.first) == 0)
-                notif_map[elm.first] = std::vector<nixl_blob_t>();
-
-            notif_map[elm.first].push_back(elm.second);
-        }
+        for (auto & elm: bknd_notif_list)
+            notif_map[elm.first].push_back(std::move(elm.second));
     }
 
     if (extra_params && extra_params->backends.size() > 0)
@@ -909,6 +2199,39 @@ nixlAgent::getNotifs(nixl_notifs_t &notif_map,
     return bad_ret;
 }
 
+nixl_status_t
+nixlAgent::getNotifs(nixl_notif_list_t &notif_list,
+                     const nixl_opt_args_t* extra_params) {
+    NIXL_TRACE_SPAN("getNotifs");
+    nixl_status_t ret, bad_ret=NIXL_SUCCESS;
+    bool          found=false;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        for (auto & eng: data->notifEngines) {
+            ret = eng->appendNotifs(notif_list);
+            if (ret < 0)
+                bad_ret=ret;
+            found = true;
+        }
+    } else {
+        // Same best effort as above, without building a new backend list
+        for (auto & elm : extra_params->backends) {
+            if (!elm->engine->supportsNotif())
+                continue;
+            ret = elm->engine->appendNotifs(notif_list);
+            if (ret < 0)
+                bad_ret=ret;
+            found = true;
+        }
+    }
+
+    if (!found)
+        return NIXL_ERR_BACKEND;
+
+    return bad_ret;
+}
+
 nixl_status_t
 nixlAgent::genNotif(const std::string &remote_agent,
                     const nixl_blob_t &msg,
@@ -917,7 +2240,12 @@ nixlAgent::genNotif(const std::string &remote_agent,
     nixlBackendEngine* backend = nullptr;
     backend_list_t*    backend_list;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // Only looked up, inserting would modify the map under a shared lock
+    auto remote = data->remoteBackends.find(remote_agent);
+    if (remote == data->remoteBackends.end())
+        return NIXL_ERR_NOT_FOUND;
+
     if (!extra_params || extra_params->backends.size() == 0) {
         backend_list = &data->notifEngines;
         if (backend_list->empty())
@@ -935,8 +2263,7 @@ nixlAgent::genNotif(const std::string &remote_agent,
     }
 
     for (auto & eng: *backend_list) {
-        if (data->remoteBackends[remote_agent].count(
-                                 eng->getType()) != 0) {
+        if (remote->second.count(eng->getType()) != 0) {
             backend = eng;
             break;
         }
@@ -951,13 +2278,105 @@ nixlAgent::genNotif(const std::string &remote_agent,
         return NIXL_ERR_NOT_FOUND;
 }
 
+// With a codec, the sections are packed into their own serializer, which is
+// compressed into a single field
+static nixl_status_t
+addMemSections(nixlSerDes &sd, const std::string &codec_name,
+               const std::function<nixl_status_t(nixlSerDes*, bool)> &serialize) {
+    nixl_status_t ret;
+
+    if (codec_name.empty()) {
+        ret = sd.addStr("", "MemSection");
+        if(ret)
+            return ret;
+        return serialize(&sd, false);
+    }
+
+#ifdef HAVE_NIXL_CODEC
+    auto codec = nixlCompressCodecCreate(codec_name, 0);
+    if (!codec)
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    nixlSerDes sections;
+    ret = serialize(&sections, true);
+    if(ret)
+        return ret;
+
+    std::string raw = sections.releaseStr();
+    size_t bound = codec->getBound(raw.size());
+    if (bound == 0)
+        return NIXL_ERR_NOT_SUPPORTED;
+    std::string packed(bound, '\0');
+    size_t packed_len = codec->compress(raw.data(), raw.size(), &packed[0], bound);
+    if (packed_len == 0)
+        return NIXL_ERR_UNKNOWN;
+    packed.resize(packed_len);
+
+    uint8_t codec_id = codec->getId();
+    uint64_t raw_len = raw.size();
+    ret = sd.addStr("", "MemSectionZ");
+    if(ret)
+        return ret;
+    ret = sd.addBuf("Codec", &codec_id, sizeof(codec_id));
+    if(ret)
+        return ret;
+    ret = sd.addBuf("Raw", &raw_len, sizeof(raw_len));
+    if(ret)
+        return ret;
+    return sd.addStr("Sections", packed);
+#else
+    return NIXL_ERR_NOT_SUPPORTED;
+#endif
+}
+
+// Compressed sections are bounded, rather than trusting the sender: by what
+// the packed bytes can decode to, and by a fixed cap
+#define NIXL_MD_MAX_SECTIONS_SIZE (1ULL << 30)
+
+static nixl_status_t
+getMemSections(nixlSerDes &sd, nixlSerDes &sections) {
+#ifdef HAVE_NIXL_CODEC
+    uint8_t codec_id;
+    uint64_t raw_len;
+    nixl_status_t ret;
+
+    ret = sd.getBuf("Codec", &codec_id, sizeof(codec_id));
+    if(ret)
+        return ret;
+    ret = sd.getBuf("Raw", &raw_len, sizeof(raw_len));
+    if(ret)
+        return ret;
+    std::string_view packed = sd.getStrView("Sections");
+
+    auto codec = nixlCompressCodecCreate(codec_id);
+    if (!codec) {
+        NIXL_ERROR << "Metadata codec " << (int) codec_id << " is not built in";
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+    if (packed.empty() || (raw_len > NIXL_MD_MAX_SECTIONS_SIZE) ||
+        (raw_len / codec->getMaxRatio() > packed.size())) {
+        NIXL_ERROR << "Compressed metadata claims " << raw_len << " bytes from "
+                   << packed.size();
+        return NIXL_ERR_MISMATCH;
+    }
+
+    std::string raw(raw_len, '\0');
+    if (!codec->decompress(packed.data(), packed.size(), &raw[0], raw_len))
+        return NIXL_ERR_MISMATCH;
+    return sections.importStr(std::move(raw));
+#else
+    NIXL_ERROR << "Compressed metadata cannot be loaded without a codec built in";
+    return NIXL_ERR_NOT_SUPPORTED;
+#endif
+}
+
 nixl_status_t
 nixlAgent::getLocalMD (nixl_blob_t &str) const {
     size_t conn_cnt;
     nixl_backend_t nixl_backend;
     nixl_status_t ret;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
     // data->connMD was populated when the backend was created
     conn_cnt = data->connMD.size();
 
@@ -983,15 +2402,87 @@ nixlAgent::getLocalMD (nixl_blob_t &str) const {
             return ret;
     }
 
-    ret = sd.addStr("", "MemSection");
+    ret = addMemSections(sd, data->config.mdCodec,
+                         [this](nixlSerDes* sections, bool packed) {
+                             return data->memorySection->serialize(sections, packed);
+                         });
     if(ret)
         return ret;
 
-    ret = data->memorySection->serialize(&sd);
+    // After the sections, so older agents that stop reading there can load it
+    uint64_t version = data->memorySection->getVersion();
+    ret = sd.addBuf("Version", &version, sizeof(version));
     if(ret)
         return ret;
 
-    str = sd.exportStr();
+    str = sd.releaseStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getLocalMDDelta (const uint64_t &since_version,
+                            nixl_blob_t &str) const {
+    size_t conn_cnt;
+    nixl_status_t ret;
+
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        conn_cnt = data->connMD.size();
+
+        if (conn_cnt == 0) // Error, no backend supports remote
+            return NIXL_ERR_INVALID_PARAM;
+
+        nixlSerDes sd;
+        ret = sd.addStr("Agent", data->name);
+        if(ret)
+            return ret;
+
+        // Conn info is small and lets a delta reach agents that lost it
+        ret = sd.addBuf("Conns", &conn_cnt, sizeof(conn_cnt));
+        if(ret)
+            return ret;
+
+        for (auto &c : data->connMD) {
+            ret = sd.addStr("t", c.first);
+            if(ret)
+                return ret;
+            ret = sd.addStr("c", c.second);
+            if(ret)
+                return ret;
+        }
+
+        ret = sd.addStr("", "MemDelta");
+        if(ret)
+            return ret;
+
+        ret = data->memorySection->serializeDelta(&sd, since_version);
+        if (ret == NIXL_SUCCESS) {
+            str = sd.releaseStr();
+            return NIXL_SUCCESS;
+        }
+        if (ret != NIXL_ERR_NOT_FOUND)
+            return ret;
+    }
+
+    // Changes since that version are no longer kept
+    return getLocalMD(str);
+}
+
+nixl_status_t
+nixlAgent::getLocalMDVersion (uint64_t &version) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    version = data->memorySection->getVersion();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getRemoteMDVersion (const std::string &remote_agent,
+                               uint64_t &version) const {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    auto it = data->remoteSections.find(remote_agent);
+    if (it == data->remoteSections.end())
+        return NIXL_ERR_NOT_FOUND;
+    version = it->second->getVersion();
     return NIXL_SUCCESS;
 }
 
@@ -1003,7 +2494,7 @@ nixlAgent::getLocalPartialMD(nixl_reg_dlist_t &descs,
     backend_list_t *backend_list;
     nixl_status_t ret;
 
-    NIXL_LOCK_GUARD(data->lock);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
 
     if (!extra_params || extra_params->backends.size() == 0) {
         if (descs.descCount() != 0) {
@@ -1060,30 +2551,48 @@ nixlAgent::getLocalPartialMD(nixl_reg_dlist_t &descs,
     if (selected_engines.size() == 0 && descs.descCount() > 0)
         return NIXL_ERR_BACKEND;
 
-    ret = sd.addStr("", "MemSection");
-    if(ret)
-        return ret;
-
-    ret = data->memorySection->serializePartial(&sd, selected_engines, descs);
+    ret = addMemSections(sd, data->config.mdCodec,
+                         [&](nixlSerDes* sections, bool packed) {
+                             return data->memorySection->serializePartial(
+                                        sections, selected_engines, descs, packed);
+                         });
     if(ret)
         return ret;
 
-    str = sd.exportStr();
+    str = sd.releaseStr();
     return NIXL_SUCCESS;
 }
 
 nixl_status_t
 nixlAgent::sendLocalMD (const nixl_opt_args_t* extra_params) const {
 
-    if(extra_params->ipAddr.size() == 0){
-        NIXL_ERROR << "ETCD not supported yet, please specify IP";
-        return NIXL_ERR_NOT_SUPPORTED;
-    }
-
     nixl_blob_t myMD;
     nixl_status_t ret = getLocalMD(myMD);
     if(ret < 0) return ret;
 
+    if(extra_params && !extra_params->mdPeers.empty()) {
+        if(extra_params->ipAddr.size() != 0) {
+            NIXL_ERROR << "Metadata can be sent to either one peer or a list of them";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        if(extra_params->mdPeers.size() > NIXL_MD_TREE_MAX_PEERS) {
+            NIXL_ERROR << "Metadata can be broadcast to at most "
+                       << NIXL_MD_TREE_MAX_PEERS << " peers";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        data->enqueueMDTree(myMD, extra_params->mdPeers, extra_params->mdFanout);
+        return NIXL_SUCCESS;
+    }
+
+    if(!extra_params || extra_params->ipAddr.size() == 0){
+        if(!data->metadataKV) {
+            NIXL_ERROR << "No metadata server configured, please specify IP";
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+        data->enqueueCommWork(std::make_tuple(KV_SEND, data->name, 0, myMD));
+        return NIXL_SUCCESS;
+    }
+
     data->enqueueCommWork(std::make_tuple(SOCK_SEND, extra_params->ipAddr, extra_params->port, myMD));
 
     return NIXL_SUCCESS;
@@ -1092,8 +2601,9 @@ nixlAgent::sendLocalMD (const nixl_opt_args_t* extra_params) const {
 nixl_status_t
 nixlAgent::sendLocalPartialMD(nixl_reg_dlist_t &descs,
                               const nixl_opt_args_t* extra_params) const {
-    if(extra_params->ipAddr.size() == 0){
-        NIXL_ERROR << "ETCD not supported yet, please specify IP";
+    // The server keeps one metadata per agent, that a part would replace
+    if(!extra_params || extra_params->ipAddr.size() == 0){
+        NIXL_ERROR << "Partial metadata can only be sent to a peer, please specify IP";
         return NIXL_ERR_NOT_SUPPORTED;
     }
 
@@ -1107,13 +2617,50 @@ nixlAgent::sendLocalPartialMD(nixl_reg_dlist_t &descs,
 
 }
 
+nixl_status_t
+nixlAgent::sendLocalMDDelta (const nixl_opt_args_t* extra_params) const {
+
+    // The server keeps the full metadata, and watchers get all of it
+    if(!extra_params || extra_params->ipAddr.size() == 0)
+        return sendLocalMD(extra_params);
+
+    nixl_socket_peer_t peer = std::make_pair(extra_params->ipAddr, extra_params->port);
+    nixl_blob_t myMD;
+    uint64_t version;
+    nixl_status_t ret;
+
+    const std::lock_guard<std::mutex> lock(data->sentMDLock);
+    ret = getLocalMDVersion(version);
+    if(ret < 0) return ret;
+
+    auto it = data->sentMDVersions.find(peer);
+    if (it == data->sentMDVersions.end())
+        ret = getLocalMD(myMD);
+    else if (it->second == version)
+        return NIXL_SUCCESS; // Nothing changed since
+    else
+        ret = getLocalMDDelta(it->second, myMD);
+    if(ret < 0) return ret;
+
+    // Registrations between reading the version and the metadata are sent again
+    data->sentMDVersions[peer] = version;
+    data->enqueueCommWork(std::make_tuple(SOCK_SEND, extra_params->ipAddr, extra_params->port, myMD));
+
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t
 nixlAgent::fetchRemoteMD (const std::string remote_name,
                           const nixl_opt_args_t* extra_params) {
 
-    if(extra_params->ipAddr.size() == 0){
-        NIXL_ERROR << "ETCD not supported yet, please specify IP";
-        return NIXL_ERR_NOT_SUPPORTED;
+    if(!extra_params || extra_params->ipAddr.size() == 0){
+        if(!data->metadataKV) {
+            NIXL_ERROR << "No metadata server configured, please specify IP";
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+        // Loaded when found, and then kept up to date by a watch
+        data->enqueueCommWork(std::make_tuple(KV_FETCH, remote_name, 0, ""));
+        return NIXL_SUCCESS;
     }
 
     data->enqueueCommWork(std::make_tuple(SOCK_FETCH, extra_params->ipAddr, extra_params->port, ""));
@@ -1124,9 +2671,14 @@ nixlAgent::fetchRemoteMD (const std::string remote_name,
 nixl_status_t
 nixlAgent::invalidateLocalMD (const nixl_opt_args_t* extra_params) const {
 
-    if(extra_params->ipAddr.size() == 0){
-        NIXL_ERROR << "ETCD not supported yet, please specify IP";
-        return NIXL_ERR_NOT_SUPPORTED;
+    if(!extra_params || extra_params->ipAddr.size() == 0){
+        if(!data->metadataKV) {
+            NIXL_ERROR << "No metadata server configured, please specify IP";
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+        // Watchers of this agent invalidate it when the key is removed
+        data->enqueueCommWork(std::make_tuple(KV_INVAL, data->name, 0, ""));
+        return NIXL_SUCCESS;
     }
 
     data->enqueueCommWork(std::make_tuple(SOCK_INVAL, extra_params->ipAddr, extra_params->port, ""));
@@ -1137,6 +2689,7 @@ nixlAgent::invalidateLocalMD (const nixl_opt_args_t* extra_params) const {
 nixl_status_t
 nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
                          std::string &agent_name) {
+    NIXL_TRACE_SPAN("loadRemoteMD");
     int count = 0;
     nixlSerDes sd;
     size_t conn_cnt;
@@ -1145,8 +2698,8 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     nixlBackendEngine* eng;
     nixl_status_t ret;
 
-    NIXL_LOCK_GUARD(data->lock);
-    ret = sd.importStr(remote_metadata);
+    // Read in place, remote_metadata outlives sd
+    ret = sd.importView(remote_metadata);
     if(ret)
         return ret;
 
@@ -1157,6 +2710,9 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     if (remote_agent == data->name)
         return NIXL_ERR_INVALID_PARAM;
 
+    nixlImportSlot slot(data, remote_agent);
+    std::unique_lock<nixlLock> guard(data->lock);
+
     ret = sd.getBuf("Conns", &conn_cnt, sizeof(conn_cnt));
     if(ret)
         return ret;
@@ -1184,6 +2740,9 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
             eng = data->backendEngines[nixl_backend];
             if (eng->supportsRemote()) {
                 ret = eng->loadRemoteConnInfo(remote_agent, conn_info);
+                // Backend cannot reach this agent, e.g. a same host backend
+                if (ret == NIXL_ERR_NOT_SUPPORTED)
+                    continue;
                 if (ret)
                     return ret; // Error in load
                 count++;
@@ -1200,22 +2759,109 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
     if (count == 0 && conn_cnt > 0)
         return NIXL_ERR_BACKEND;
 
-    if (sd.getStr("") != "MemSection")
+    std::string section_type = sd.getStr("");
+    if ((section_type != "MemSection") && (section_type != "MemSectionZ") &&
+        (section_type != "MemDelta"))
         return NIXL_ERR_MISMATCH;
+    bool is_delta = (section_type == "MemDelta");
 
-    if (data->remoteSections.count(remote_agent) == 0)
-        data->remoteSections[remote_agent] = new nixlRemoteSection(
-                                                  remote_agent);
+    nixlSerDes sections;
+    nixlSerDes *section_sd = &sd;
+    if (section_type == "MemSectionZ") {
+        ret = getMemSections(sd, sections);
+        if(ret)
+            return ret;
+        section_sd = &sections;
+    }
+
+    uint64_t held_version = 0;
+    auto sec = data->remoteSections.find(remote_agent);
+    if (sec != data->remoteSections.end())
+        held_version = sec->second->getVersion();
+
+    uint64_t from_version = 0, to_version = 0;
+    if (is_delta) {
+        ret = sd.getBuf("From", &from_version, sizeof(from_version));
+        if(ret)
+            return ret;
+        ret = sd.getBuf("To", &to_version, sizeof(to_version));
+        if(ret)
+            return ret;
+
+        agent_name = remote_agent;
+        // Older than the loaded metadata, e.g. reordered after a full resync
+        if ((held_version > 0) && (to_version <= held_version))
+            return NIXL_SUCCESS;
+        // Some changes were missed, the full metadata is needed
+        if ((held_version == 0) || (from_version > held_version))
+            return NIXL_ERR_NOT_FOUND;
+    }
+
+    // A new agent is only added once its descriptors are loaded
+    bool created = (sec == data->remoteSections.end());
+    nixlRemoteSection *section = created ? new nixlRemoteSection(remote_agent) : sec->second;
 
-    ret = data->remoteSections[remote_agent]->loadRemoteData(&sd,
-                                                  data->backendEngines);
+    // Only the backends that loaded the conn info of the agent
+    backend_map_t remote_engines;
+    for (auto & elm : data->remoteBackends[remote_agent])
+        remote_engines[elm.first] = data->backendEngines[elm.first];
+
+    nixlRemoteImport import;
+    bool versioned = false;
+    if (is_delta) {
+        ret = section->loadRemoteDelta(&sd, remote_engines);
+    } else {
+        ret = section->prepRemoteData(section_sd, remote_engines, import);
+        // The version follows the sections, absent from unversioned agents
+        if ((ret == NIXL_SUCCESS) && (sd.getBufLen("Version") == sizeof(to_version)))
+            versioned = (sd.getBuf("Version", &to_version, sizeof(to_version)) == NIXL_SUCCESS);
+        // Older than the loaded metadata, same as a stale delta
+        if ((ret == NIXL_SUCCESS) && versioned && (to_version < held_version)) {
+            if (created)
+                delete section;
+            agent_name = remote_agent;
+            return NIXL_SUCCESS;
+        }
+        if (ret == NIXL_SUCCESS) {
+            size_t max_threads = data->config.mdImportThreads;
+            if (max_threads == 0)
+                max_threads = std::max(1u, std::thread::hardware_concurrency());
+            // Descriptors are loaded alongside readers and other imports, the
+            // section is only changed by this import, and not read by it
+            bool concurrent = import.isConcurrent();
+            if (concurrent) {
+                guard.unlock();
+                data->lock.lock_shared();
+            }
+            ret = import.load(max_threads);
+            if (concurrent) {
+                data->lock.unlock_shared();
+                guard.lock();
+            }
+            if (ret == NIXL_SUCCESS)
+                section->mergeRemoteData(import);
+        }
+    }
 
     // TODO: can be more graceful, if just the new MD blob was improper
     if (ret) {
-        delete data->remoteSections[remote_agent];
-        data->remoteSections.erase(remote_agent);
-        return ret;
+        delete section;
+        data->setRemoteSection(remote_agent, nullptr);
+        // A delta is not applied partially, the full metadata is loaded instead
+        return is_delta ? NIXL_ERR_NOT_FOUND : ret;
     }
+    if (created)
+        data->setRemoteSection(remote_agent, section);
+
+    if (is_delta) {
+        section->setVersion(to_version);
+    } else if (versioned && (to_version > held_version)) {
+        // Full metadata of a newer version, deregistrations are dropped
+        section->prune(import.loaded);
+        section->setVersion(to_version);
+    }
+
+    data->updateXferCandidates(data->remoteAgents[data->remoteAgentIds.at(remote_agent)]);
 
     agent_name = remote_agent;
     return NIXL_SUCCESS;
@@ -1223,6 +2869,7 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
 
 nixl_status_t
 nixlAgent::invalidateRemoteMD(const std::string &remote_agent) {
+    nixlImportSlot slot(data, remote_agent);
     NIXL_LOCK_GUARD(data->lock);
 
     if (remote_agent == data->name)
@@ -1231,7 +2878,7 @@ nixlAgent::invalidateRemoteMD(const std::string &remote_agent) {
     nixl_status_t ret = NIXL_ERR_NOT_FOUND;
     if (data->remoteSections.count(remote_agent)!=0) {
         delete data->remoteSections[remote_agent];
-        data->remoteSections.erase(remote_agent);
+        data->setRemoteSection(remote_agent, nullptr);
         ret = NIXL_SUCCESS;
     }
 
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include "agent_progress.h"
+#include "common/nixl_log.h"
+#include "common/nixl_trace.h"
+
+void nixlAgentProgress::signal() {
+    uint64_t one = 1;
+
+    if (write(wakeFd, &one, sizeof(one)) != sizeof(one) && errno != EAGAIN)
+        NIXL_ERROR << "Cannot wake up the agent progress thread";
+}
+
+void nixlAgentProgress::addEngine(nixlBackendEngine* engine) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        engines.push_back(engine);
+        hasEngines = true;
+    }
+
+    // The thread waits for events without a timeout while it has no engines
+    signal();
+}
+
+// Waits for a round in progress, so the engine is not called once it returns
+void nixlAgentProgress::removeEngine(nixlBackendEngine* engine) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    engines.erase(std::remove(engines.begin(), engines.end(), engine), engines.end());
+    hasEngines = !engines.empty();
+}
+
+void nixlAgentProgress::wake() {
+    if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false))
+        signal();
+}
+
+bool nixlAgentProgress::progressEngines() {
+    NIXL_TRACE_SPAN("progressRound");
+    bool active = agentWork && agentWork();
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto & engine : engines)
+        active |= engine->progressRound();
+    iterations.fetch_add(1, std::memory_order_relaxed);
+    return active;
+}
+
+int nixlAgentProgress::run() {
+    if (!hasEngines && !agentWork)
+        return -1;
+
+    nixlTime::us_t now = nixlTime::getUs();
+    if (progressEngines() || (lastActive == 0)) {
+        lastActive = now;
+        return 0;
+    }
+
+    nixlTime::us_t idle = now - lastActive;
+    if (idle < spinUs)
+        return 0;
+
+    if ((idleUs == 0) || (idle < idleUs)) {
+        // Same delay as the progress threads of the backends
+        while ((now + delay) > nixlTime::getUs())
+            std::this_thread::yield();
+        idleTime.fetch_add(nixlTime::getUs() - now, std::memory_order_relaxed);
+        return 0;
+    }
+
+    // Engines wake the thread from here on. Anything queued before they
+    // could see the flag is picked up by the last round.
+    sleeping = true;
+    if (progressEngines()) {
+        sleeping = false;
+        lastActive = nixlTime::getUs();
+        return 0;
+    }
+    sleepStart = nixlTime::getUs();
+    sleeps.fetch_add(1, std::memory_order_relaxed);
+    return std::max<int>(1, (sleepUs + 999) / 1000);
+}
+
+void nixlAgentProgress::waited(const int &n_events) {
+    if (sleepStart == 0)
+        return;
+
+    nixlTime::us_t now = nixlTime::getUs();
+    idleTime.fetch_add(now - sleepStart, std::memory_order_relaxed);
+    if (n_events > 0)
+        wakeups.fetch_add(1, std::memory_order_relaxed);
+    sleeping   = false;
+    sleepStart = 0;
+    lastActive = now;
+}
+
+void nixlAgentProgress::getStats(nixlProgressStats &stats) const {
+    stats.iterations = iterations.load(std::memory_order_relaxed);
+    stats.idleUs     = idleTime.load(std::memory_order_relaxed);
+    stats.sleeps     = sleeps.load(std::memory_order_relaxed);
+    stats.wakeups    = wakeups.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include "completion_queue.h"
+#include "transfer_request.h"
+#include "common/nixl_log.h"
+
+nixlXferCompletionQueue::nixlXferCompletionQueue() {
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0)
+        NIXL_ERROR << "Failed to create the completion queue eventfd";
+}
+
+nixlXferCompletionQueue::~nixlXferCompletionQueue() {
+    if (eventFd >= 0)
+        close(eventFd);
+}
+
+void nixlXferCompletionQueue::signal() {
+    uint64_t one = 1;
+
+    if (eventFd < 0)
+        return;
+    // Only fails if the counter would overflow, it's still readable then
+    if (write(eventFd, &one, sizeof(one)) != sizeof(one))
+        NIXL_DEBUG << "Completion queue eventfd was not signaled";
+}
+
+void nixlXferCompletionQueue::expect(nixlXferReqH* req) {
+    std::lock_guard<std::mutex> guard(lock);
+    tracked.insert(req);
+}
+
+void nixlXferCompletionQueue::addPending(nixlXferReqH* req) {
+    std::lock_guard<std::mutex> guard(lock);
+    pending.push_back(req);
+}
+
+void nixlXferCompletionQueue::addCompleted(nixlXferReqH* req,
+                                          const nixl_status_t &status) {
+    finished(req, status);
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tracked.erase(req);
+        if (!req->callback)
+            completed.emplace_back(req, status);
+    }
+
+    if (req->callback)
+        req->callback(req, status, req->callbackCtx);
+    else
+        signal();
+}
+
+void nixlXferCompletionQueue::remove(nixlXferReqH* req) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    tracked.erase(req);
+    pending.erase(std::remove(pending.begin(), pending.end(), req),
+                  pending.end());
+    completed.erase(std::remove_if(completed.begin(), completed.end(),
+                                   [req](const std::pair<nixlXferReqH*, nixl_status_t> &elm) {
+                                       return elm.first == req;
+                                   }),
+                    completed.end());
+}
+
+void nixlXferCompletionQueue::xferDone(void* completion_ctx, nixl_status_t status) {
+    nixlXferReqH*  req = (nixlXferReqH*) completion_ctx;
+    nixl_xfer_cb_t callback;
+    void*          callback_ctx;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        // Released or reposted without being reported, nothing to do
+        if (tracked.erase(req) == 0)
+            return;
+        // Read while tracked, the request can be released once it's not
+        callback     = req->callback;
+        callback_ctx = req->callbackCtx;
+        finished(req, status);
+        if (!callback)
+            completed.emplace_back(req, status);
+    }
+
+    if (callback)
+        callback(req, status, callback_ctx);
+    else
+        signal();
+}
+
+void nixlXferCompletionQueue::poll(const size_t &max, std::vector<nixlXferReqH*> &out) {
+    uint64_t count;
+    // Requests with a callback, called after unlocking
+    std::vector<std::pair<nixlXferReqH*, nixl_status_t>> callbacks;
+
+    out.clear();
+
+    std::unique_lock<std::mutex> guard(lock);
+
+    // Backends in pending never call xferDone, so checking them here
+    // can't deadlock with a backend thread reporting a completion.
+    size_t j = 0;
+    for (size_t i=0; i<pending.size(); ++i) {
+        nixlXferReqH* req = pending[i];
+        nixl_status_t ret = req->checkXfer();
+
+        if (ret == NIXL_IN_PROG) {
+            pending[j++] = req;
+            continue;
+        }
+
+        finished(req, ret);
+        if (req->callback) {
+            req->status = ret;
+            callbacks.emplace_back(req, ret);
+        } else {
+            completed.emplace_back(req, ret);
+        }
+    }
+    pending.resize(j);
+
+    while (!completed.empty() && (out.size() < max)) {
+        nixlXferReqH* req = completed.front().first;
+        req->status = completed.front().second;
+        out.push_back(req);
+        completed.pop_front();
+    }
+
+    // Reset the eventfd once everything reported is consumed
+    if (completed.empty() && (eventFd >= 0))
+        while (read(eventFd, &count, sizeof(count)) == sizeof(count));
+
+    guard.unlock();
+    for (auto &elm : callbacks)
+        elm.first->callback(elm.first, elm.second, elm.first->callbackCtx);
+}
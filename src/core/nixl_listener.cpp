@@ -16,9 +16,12 @@
  */
 
 #include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include "nixl.h"
-#include "common/nixl_time.h"
 #include "common/str_tools.h"
 #include "agent_data.h"
 
@@ -58,43 +61,245 @@ int connectToIP(std::string ip_addr, int port) {
     return ret_fd;
 }
 
-size_t sendCommMessage(int fd, std::string msg){
-    size_t bytes;
-    bytes = send(fd, msg.c_str(), msg.size(), 0);
-    if(bytes < 0) {
-        std::cerr << "Cannot send on socket to fd " << fd << std::endl;
+// Types of the frames between listeners
+enum { NIXL_COMM_LOAD = 1, NIXL_COMM_SEND, NIXL_COMM_INVL, NIXL_COMM_FWD };
+
+// Payload of a forwarded frame: fanout, depth of the receiver in the tree,
+// peers of its subtree as port and IP address, then the metadata
+static void appendU32(std::string &str, uint32_t val) {
+    str.append((const char*) &val, sizeof(val));
+}
+
+static bool readU32(const std::string &str, size_t &offset, uint32_t &val) {
+    if (str.size() - offset < sizeof(val))
+        return false;
+    memcpy(&val, str.data() + offset, sizeof(val));
+    offset += sizeof(val);
+    return true;
+}
+
+static nixl_status_t decodeMDTree(const std::string &payload, uint32_t &fanout,
+                                  uint32_t &depth, std::vector<nixl_socket_peer_t> &peers,
+                                  nixl_blob_t &md) {
+    size_t offset = 0;
+    uint32_t count, port, len;
+
+    if (!readU32(payload, offset, fanout) || !readU32(payload, offset, depth) ||
+        !readU32(payload, offset, count) || (count > NIXL_MD_TREE_MAX_PEERS))
+        return NIXL_ERR_MISMATCH;
+
+    peers.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        if (!readU32(payload, offset, port) || !readU32(payload, offset, len) ||
+            (payload.size() - offset < len))
+            return NIXL_ERR_MISMATCH;
+        peers.emplace_back(payload.substr(offset, len), (int) port);
+        offset += len;
     }
-    return bytes;
+
+    md = payload.substr(offset);
+    return NIXL_SUCCESS;
 }
 
-ssize_t recvCommMessage(int fd, std::string &msg){
-    char buffer[16384];
-    ssize_t one_recv_bytes = 0;
-    ssize_t recv_bytes = 0;
-    msg = std::string("");
-
-    do {
-        one_recv_bytes = recv(fd, buffer, sizeof(buffer), 0);
-        if (one_recv_bytes == -1){
-            if(errno == EAGAIN || errno == EWOULDBLOCK) return recv_bytes;
-            std::cerr << "Cannot recv on socket fd " << fd << std::endl;
-            return one_recv_bytes;
+void nixlAgentData::enqueueMDTree(const nixl_blob_t &md,
+                                  const std::vector<nixl_socket_peer_t> &peers,
+                                  uint32_t fanout, uint32_t depth) {
+    fanout = std::clamp<uint32_t>(fanout, 1, NIXL_MD_TREE_MAX_FANOUT);
+    size_t children = std::min<size_t>(fanout, peers.size());
+
+    // Contiguous parts of the list, each led by the child receiving it
+    size_t start = 0;
+    for (size_t i = 0; i < children; i++) {
+        size_t end = start + (peers.size() - start) / (children - i);
+        std::string payload;
+
+        appendU32(payload, fanout);
+        appendU32(payload, depth + 1);
+        appendU32(payload, end - start - 1);
+        for (size_t j = start + 1; j < end; j++) {
+            appendU32(payload, peers[j].second);
+            appendU32(payload, peers[j].first.size());
+            payload += peers[j].first;
         }
-        msg.append(buffer, one_recv_bytes);
-        recv_bytes += one_recv_bytes;
-    } while(one_recv_bytes > 0);
+        payload += md;
+
+        enqueueCommWork(std::make_tuple(SOCK_FWD, peers[start].first, peers[start].second,
+                                        std::move(payload)));
+        start = end;
+    }
+}
+
+// Passes a forwarded payload on to the peers of its subtree, loading it first if
+// it was received, instead of it being for a peer that could not be reached.
+// A received payload is only forwarded to the peers this agent is connected to
+// or configured with in mdForwardPeers, so a sender cannot direct it elsewhere.
+void nixlAgentData::forwardMDTree(nixlAgent* myAgent, const std::string &payload, bool load) {
+    std::vector<nixl_socket_peer_t> peers;
+    uint32_t fanout, depth;
+    nixl_blob_t md;
+
+    if (decodeMDTree(payload, fanout, depth, peers, md) != NIXL_SUCCESS) {
+        std::cerr << "Received corrupt metadata to forward, dropping it" << std::endl;
+        return;
+    }
+
+    if (load) {
+        size_t count = peers.size();
+        peers.erase(std::remove_if(peers.begin(), peers.end(),
+                                   [this](const nixl_socket_peer_t &peer) {
+                                       return (remoteSockets.count(peer) == 0) &&
+                                              (std::find(config.mdForwardPeers.begin(),
+                                                         config.mdForwardPeers.end(),
+                                                         peer) == config.mdForwardPeers.end());
+                                   }),
+                    peers.end());
+        if (peers.size() != count)
+            std::cerr << "Not forwarding metadata to " << count - peers.size()
+                      << " unknown peers" << std::endl;
+    }
+
+    // Forwarded before loading, so the children do not wait on it
+    if (!peers.empty()) {
+        if (depth < NIXL_MD_TREE_MAX_DEPTH)
+            enqueueMDTree(md, peers, fanout, depth);
+        else
+            std::cerr << "Metadata forwarded too deep, dropping its subtree" << std::endl;
+    }
+
+    if (load) {
+        std::string remote_agent;
+        if (myAgent->loadRemoteMD(md, remote_agent) != NIXL_SUCCESS)
+            std::cerr << "Could not load forwarded metadata" << std::endl;
+    }
+}
+
+void nixlAgentData::setCommEvents(int fd, uint32_t events) {
+    struct epoll_event ev = {};
+    ev.events  = events;
+    ev.data.fd = fd;
+
+    if (epoll_ctl(commEpollFd, EPOLL_CTL_MOD, fd, &ev) == -1)
+        throw std::runtime_error("epoll_ctl modify socket");
+}
+
+void nixlAgentData::addCommSocket(const nixl_socket_peer_t &peer, int fd) {
+    struct epoll_event ev = {};
+    ev.events  = EPOLLIN;
+    ev.data.fd = fd;
+
+    if (epoll_ctl(commEpollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+        throw std::runtime_error("epoll_ctl add socket");
+    remoteSockets[peer] = fd;
+    commReaders[fd];
+    commWriters[fd];
+}
 
-    return recv_bytes;
+void nixlAgentData::closeCommFd(int fd) {
+    epoll_ctl(commEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    commReaders.erase(fd);
+    commWriters.erase(fd);
+    commClosing.erase(fd);
+}
+
+// Frames still queued are sent before the socket is closed
+void nixlAgentData::closeCommSocket(const nixl_socket_peer_t &peer) {
+    auto it = remoteSockets.find(peer);
+    if (it == remoteSockets.end())
+        return;
+    int fd = it->second;
+    remoteSockets.erase(it);
+
+    if (commWriters[fd].empty()) {
+        closeCommFd(fd);
+    } else {
+        commReaders.erase(fd);
+        commClosing.insert(fd);
+        setCommEvents(fd, EPOLLOUT);
+    }
+}
+
+// Closes a peer socket that failed, or that does not read what is queued for it
+void nixlAgentData::dropCommFd(int fd) {
+    auto it = std::find_if(remoteSockets.begin(), remoteSockets.end(),
+                           [fd](const auto &elm) { return elm.second == fd; });
+    if (it != remoteSockets.end())
+        remoteSockets.erase(it);
+    closeCommFd(fd);
+}
+
+void nixlAgentData::sendCommFrame(int fd, uint32_t type, std::string &&data) {
+    nixlMDFrameWriter &writer = commWriters[fd];
+    bool was_empty = writer.empty();
+
+    nixl_status_t ret = writer.push(type, std::move(data));
+    if (ret != NIXL_SUCCESS) {
+        std::cerr << "Cannot queue a frame on socket fd " << fd << ": "
+                  << nixlEnumStrings::statusStr(ret) << std::endl;
+        dropCommFd(fd);
+        return;
+    }
+    if (!was_empty)
+        return; // Sent after the earlier ones, when the socket is writable
+    flushCommSocket(fd);
+}
+
+void nixlAgentData::flushCommSocket(int fd) {
+    nixl_status_t ret = commWriters[fd].flush(fd);
+
+    if (ret == NIXL_IN_PROG) {
+        setCommEvents(fd, commClosing.count(fd) ? EPOLLOUT : EPOLLIN | EPOLLOUT);
+        return;
+    }
+
+    if ((ret != NIXL_SUCCESS) || commClosing.count(fd)) {
+        dropCommFd(fd);
+    } else {
+        setCommEvents(fd, EPOLLIN);
+    }
 }
 
 void nixlAgentData::commWorker(nixlAgent* myAgent){
+    // Listener socket, command queue and peer sockets are all waited on, so
+    // the thread sleeps until one of them is ready, unless it progresses engines
+    const int max_events = 64;
+    struct epoll_event events[max_events];
+
+    // Before a round can ask whether it runs on the progress thread
+    if (progressDriver)
+        progressDriver->setThread(std::this_thread::get_id());
 
     while(!(commThreadStop)) {
 
-        std::vector<nixl_comm_req_t> work_queue;
+        // Checked for events between the rounds of engines to progress, or
+        // waited on with a timeout once they are idle
+        int timeout = progressDriver ? progressDriver->run() : -1;
+        int n_events = epoll_wait(commEpollFd, events, max_events, timeout);
+        if (progressDriver)
+            progressDriver->waited(n_events);
+        if (n_events == -1) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("epoll_wait in listener thread failed");
+        }
+
+        bool accept_ready = false, work_ready = false;
+        std::vector<int> ready_fds, writable_fds;
+        for (int i = 0; i < n_events; i++) {
+            if (listener && (events[i].data.fd == listener->getSocketFd())) {
+                accept_ready = true;
+            } else if (events[i].data.fd == commEventFd) {
+                work_ready = true;
+            } else {
+                if (events[i].events & EPOLLOUT)
+                    writable_fds.push_back(events[i].data.fd);
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                    ready_fds.push_back(events[i].data.fd);
+            }
+        }
 
         // first, accept new connections
-        int new_fd = 0;
+        int new_fd = accept_ready ? 0 : -1;
 
         while(new_fd != -1) {
             new_fd = listener->acceptClient();
@@ -112,7 +317,6 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
                 } else {
                     throw std::runtime_error("getpeername failed");
                 }
-                remoteSockets[accepted_client] = new_fd;
 
                 // make new socket nonblocking
                 int new_flags = fcntl(new_fd, F_GETFL, 0) | O_NONBLOCK;
@@ -120,18 +324,35 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
                 if (fcntl(new_fd, F_SETFL, new_flags) == -1)
                     throw std::runtime_error("fcntl accept");
 
+                addCommSocket(accepted_client, new_fd);
             }
         }
 
+        // Sockets that can take the rest of their frames
+        for (int fd : writable_fds) {
+            if (commWriters.count(fd))
+                flushCommSocket(fd);
+        }
+
         // second, do agent commands
-        getCommWork(work_queue);
+        std::vector<nixl_comm_req_t> work_queue;
+        if (work_ready) {
+            uint64_t count;
+            if (read(commEventFd, &count, sizeof(count)) != sizeof(count) && errno != EAGAIN)
+                throw std::runtime_error("read of listener eventfd failed");
+            getCommWork(work_queue);
+        }
 
-        for(nixl_comm_req_t request: work_queue) {
+        for(nixl_comm_req_t &request: work_queue) {
 
             nixl_comm_t req_command = std::get<0>(request);
+            if (req_command >= KV_SEND) {
+                doKVWork(myAgent, request);
+                continue;
+            }
+
             std::string req_ip = std::get<1>(request);
             int req_port = std::get<2>(request);
-            std::string my_MD = std::get<3>(request);
 
             nixl_socket_peer_t req_sock = std::make_pair(req_ip, req_port);
 
@@ -141,21 +362,27 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
 
             switch(req_command) {
                 case SOCK_SEND:
+                case SOCK_FWD:
                 {
                     // not connected
                     if(client == remoteSockets.end()) {
                         int new_client = connectToIP(req_ip, req_port);
                         if(new_client == -1) {
                             std::cerr << "Listener thread could not connect to IP " << req_ip << " and port " << req_port << std::endl;
+                            // The peers below an unreachable one get it from the others
+                            if (req_command == SOCK_FWD)
+                                forwardMDTree(myAgent, std::get<3>(request), false);
                             break;
                         }
-                        remoteSockets[req_sock] = new_client;
+                        addCommSocket(req_sock, new_client);
                         client_fd = new_client;
                     } else {
                         client_fd = client->second;
                     }
 
-                    sendCommMessage(client_fd, std::string("NIXLCOMM:LOAD" + my_MD));
+                    sendCommFrame(client_fd,
+                                  (req_command == SOCK_FWD) ? NIXL_COMM_FWD : NIXL_COMM_LOAD,
+                                  std::move(std::get<3>(request)));
                     break;
                 }
                 case SOCK_FETCH:
@@ -166,12 +393,12 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
                             std::cerr << "Listener thread could not connect to IP " << req_ip;
                             break;
                         }
-                        remoteSockets[req_sock] = new_client;
+                        addCommSocket(req_sock, new_client);
                         client_fd = new_client;
                     } else
                         client_fd = client->second;
 
-                    sendCommMessage(client_fd, std::string("NIXLCOMM:SEND"));
+                    sendCommFrame(client_fd, NIXL_COMM_SEND, "");
                     break;
                 }
                 case SOCK_INVAL:
@@ -181,9 +408,8 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
                         throw std::runtime_error("invalidate on closed socket\n");
                     }
                     client_fd = client->second;
-                    sendCommMessage(client_fd, std::string("NIXLCOMM:INVL"));
-                    close(client_fd);
-                    remoteSockets.erase(req_sock);
+                    sendCommFrame(client_fd, NIXL_COMM_INVL, "");
+                    closeCommSocket(req_sock);
                     break;
                 }
                 default:
@@ -194,69 +420,217 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
             }
         }
 
-        // third, do remote commands
-        auto socket_iter = remoteSockets.begin();
-        while (socket_iter != remoteSockets.end()) {
-            std::string commands;
-            std::vector<std::string> command_list;
-            nixl_status_t ret;
-
-            ssize_t recv_bytes = recvCommMessage(socket_iter->second, commands);
-
-            if(recv_bytes == 0 || recv_bytes == -1) {
-                socket_iter++;
+        // third, do remote commands of the sockets with data
+        for (int fd : ready_fds) {
+            auto socket_iter = std::find_if(remoteSockets.begin(), remoteSockets.end(),
+                                            [fd](const auto &elm) { return elm.second == fd; });
+            // Closed by an invalidation of this round
+            if (socket_iter == remoteSockets.end())
                 continue;
-            }
 
-            command_list = str_split_substr(commands, "NIXLCOMM:");
+            nixlMDFrameReader &reader = commReaders[fd];
+            nixl_status_t ret;
+            uint32_t type;
+            std::string payload;
 
+            // Frames arrive in parts, the reader keeps what came until the rest does
             bool invl = false;
-            for(std::string command : command_list) {
-
-                if(command.size() < 4) continue;
-
-                // always just 4 chars:
-                std::string header = command.substr(0, 4);
-
-                if(header == "LOAD") {
-                    std::string remote_md = command.substr(4);
+            while (!invl && ((ret = reader.recvFrame(fd, type, payload)) == NIXL_SUCCESS)) {
+                if(type == NIXL_COMM_LOAD) {
                     std::string remote_agent;
-                    ret = myAgent->loadRemoteMD(remote_md, remote_agent);
-                    if(ret != NIXL_SUCCESS) {
+                    ret = myAgent->loadRemoteMD(payload, remote_agent);
+                    if(ret == NIXL_ERR_NOT_FOUND) {
+                        // Metadata delta with missed changes, ask for all of it
+                        sendCommFrame(fd, NIXL_COMM_SEND, "");
+                    } else if(ret != NIXL_SUCCESS) {
                         throw std::runtime_error("loadRemoteMD in listener thread failed, critically failing\n");
                     }
                     // not sure what to do with remote_agent
-                } else if(header == "SEND") {
+                } else if(type == NIXL_COMM_SEND) {
                     nixl_blob_t my_MD;
                     myAgent->getLocalMD(my_MD);
 
-                    sendCommMessage(socket_iter->second, std::string("NIXLCOMM:LOAD" + my_MD));
-                } else if(header == "INVL") {
+                    sendCommFrame(fd, NIXL_COMM_LOAD, std::move(my_MD));
+                } else if(type == NIXL_COMM_FWD) {
+                    forwardMDTree(myAgent, payload, true);
+                } else if(type == NIXL_COMM_INVL) {
                     invl = true;
-                    break;
                 } else {
-                    throw std::runtime_error("Received socket message with bad header" + header + ", critically failing\n");
+                    throw std::runtime_error("Received socket message with bad type " + std::to_string(type) + ", critically failing\n");
                 }
+                // Closed after a failed send
+                if (commReaders.count(fd) == 0)
+                    break;
             }
 
-            if (invl) {
-                close(socket_iter->second);
-                socket_iter = remoteSockets.erase(socket_iter);
-            } else {
-                socket_iter++;
+            // A socket the peer closed would be ready forever
+            if (invl || (ret == NIXL_ERR_BACKEND))
+                closeCommSocket(socket_iter->first);
+        }
+    }
+}
+
+// Failures are logged only, as the API call that queued the work returned
+void nixlAgentData::doKVWork(nixlAgent* myAgent, const nixl_comm_req_t &request) {
+    const std::string &agent = std::get<1>(request);
+    const nixl_blob_t &md    = std::get<3>(request);
+    nixl_status_t ret        = NIXL_SUCCESS;
+    std::string remote_agent;
+    nixl_blob_t remote_md;
+
+    switch(std::get<0>(request)) {
+        case KV_SEND:
+            ret = metadataKV->put(agent, md);
+            break;
+        case KV_FETCH:
+        {
+            bool loaded = false;
+            uint64_t revision = 0;
+            ret = metadataKV->get(agent, remote_md, revision);
+            if (ret == NIXL_SUCCESS) {
+                ret = myAgent->loadRemoteMD(remote_md, remote_agent);
+                loaded = (ret == NIXL_SUCCESS);
+            // Not published yet is loaded when the watch sees it
+            } else if (ret == NIXL_ERR_NOT_FOUND) {
+                ret = NIXL_SUCCESS;
             }
+
+            // From the revision after the get, so changes in between are
+            // replayed. Called on a thread of the store, the work is done here.
+            if (ret == NIXL_SUCCESS)
+                ret = metadataKV->watch(agent, revision ? revision + 1 : 0,
+                    [this](const std::string &name, const std::string *value) {
+                        if (value)
+                            enqueueCommWork(std::make_tuple(KV_UPDATE, name, 0, *value));
+                        else
+                            enqueueCommWork(std::make_tuple(KV_REMOVE, name, 0, ""));
+                    });
+            lazyFetchDone(myAgent, agent, loaded);
+            break;
         }
+        case KV_INVAL:
+            ret = metadataKV->remove(agent);
+            break;
+        case KV_UPDATE:
+            ret = myAgent->loadRemoteMD(md, remote_agent);
+            break;
+        case KV_REMOVE:
+        {
+            // Still watched, to load it again if the agent comes back
+            {
+                const std::lock_guard<std::mutex> guard(lazyMDLock);
+                auto it = lazyMDAgents.find(agent);
+                if (it != lazyMDAgents.end()) {
+                    lazyMDLru.erase(it->second);
+                    lazyMDAgents.erase(it);
+                }
+            }
+            ret = myAgent->invalidateRemoteMD(agent);
+            // Invalidated already through another channel
+            if (ret == NIXL_ERR_NOT_FOUND)
+                ret = NIXL_SUCCESS;
+            break;
+        }
+        default:
+            throw std::runtime_error("Impossible command\n");
+    }
+
+    if (ret != NIXL_SUCCESS)
+        std::cerr << "Metadata server request for agent " << agent << " failed: "
+                  << nixlEnumStrings::statusStr(ret) << std::endl;
+}
+
+nixl_status_t nixlAgentData::lazyFetch(const std::string &agent) {
+    bool known;
+    {
+        NIXL_SHARED_LOCK_GUARD(lock);
+        known = (remoteSections.count(agent) != 0);
+    }
 
-        nixlTime::us_t start = nixlTime::getUs();
-        while( (start + config.lthrDelay) > nixlTime::getUs()) {
-            std::this_thread::yield();
+    std::unique_lock<std::mutex> guard(lazyMDLock);
+    if (known) {
+        auto it = lazyMDAgents.find(agent);
+        if (it != lazyMDAgents.end())
+            lazyMDLru.splice(lazyMDLru.begin(), lazyMDLru, it->second);
+        return NIXL_SUCCESS;
+    }
+    if (!metadataKV)
+        return NIXL_ERR_NOT_FOUND;
+
+    if (lazyMDPending.insert(agent).second)
+        enqueueCommWork(std::make_tuple(KV_FETCH, agent, 0, ""));
+    if (config.lazyMDTimeoutUs == 0)
+        return NIXL_IN_PROG;
+
+    if (!lazyMDCond.wait_for(guard, std::chrono::microseconds(config.lazyMDTimeoutUs),
+                             [&]() { return lazyMDPending.count(agent) == 0; }))
+        return NIXL_IN_PROG;
+    // Not published by the agent
+    return lazyMDAgents.count(agent) ? NIXL_SUCCESS : NIXL_ERR_NOT_FOUND;
+}
+
+void nixlAgentData::lazyFetchDone(nixlAgent* myAgent, const std::string &agent, bool loaded) {
+    std::string evicted;
+    {
+        const std::lock_guard<std::mutex> guard(lazyMDLock);
+        // Fetched by the application, not cached
+        if (lazyMDPending.erase(agent) == 0)
+            return;
+
+        if (loaded && !lazyMDAgents.count(agent)) {
+            lazyMDLru.push_front(agent);
+            lazyMDAgents[agent] = lazyMDLru.begin();
+            // Agents in use stay, the cache shrinks back on a later fetch
+            if ((config.lazyMDCacheSize > 0) && (lazyMDLru.size() > config.lazyMDCacheSize)) {
+                for (auto it = lazyMDLru.rbegin(); it != lazyMDLru.rend(); ++it) {
+                    if (lazyMDRefs.count(*it) == 0) {
+                        evicted = *it;
+                        lazyMDAgents.erase(evicted);
+                        lazyMDLru.erase(std::next(it).base());
+                        break;
+                    }
+                }
+            }
         }
     }
+    lazyMDCond.notify_all();
+
+    // Fetched again on its next use
+    if (!evicted.empty()) {
+        metadataKV->unwatch(evicted);
+        myAgent->invalidateRemoteMD(evicted);
+    }
+}
+
+void nixlAgentData::lazyMDRef(const std::string &agent) {
+    const std::lock_guard<std::mutex> guard(lazyMDLock);
+    lazyMDRefs[agent]++;
+}
+
+void nixlAgentData::lazyMDUnref(const std::string &agent) {
+    const std::lock_guard<std::mutex> guard(lazyMDLock);
+    auto it = lazyMDRefs.find(agent);
+    if ((it != lazyMDRefs.end()) && (--it->second == 0))
+        lazyMDRefs.erase(it);
 }
 
 void nixlAgentData::enqueueCommWork(std::tuple<nixl_comm_t, std::string, int, std::string> request){
-    std::lock_guard<std::mutex> lock(commLock);
-    commQueue.push_back(request);
+    {
+        std::lock_guard<std::mutex> lock(commLock);
+        commQueue.push_back(std::move(request));
+    }
+    wakeCommWorker();
+}
+
+void nixlAgentData::wakeCommWorker(){
+    uint64_t one = 1;
+
+    // Without the listener thread, requests stay queued
+    if (commEventFd == -1)
+        return;
+    // Only fails when the counter is saturated, and then it is readable anyway
+    if (write(commEventFd, &one, sizeof(one)) != sizeof(one) && errno != EAGAIN)
+        std::cerr << "Cannot signal the listener thread" << std::endl;
 }
 
 
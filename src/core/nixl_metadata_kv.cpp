@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include "metadata_kv.h"
+#include "common/nixl_log.h"
+
+#ifdef HAVE_ETCD
+#include <etcd/Client.hpp>
+#include <etcd/KeepAlive.hpp>
+#include <etcd/Response.hpp>
+#include <etcd/Watcher.hpp>
+
+#define NIXL_ETCD_DEFAULT_NAMESPACE "/nixl/agents/"
+// Metadata of an agent that stopped refreshing its lease expires after this
+#define NIXL_ETCD_DEFAULT_LEASE_TTL 10
+
+class nixlEtcdMetadataKV : public nixlMetadataKV {
+    private:
+        std::string                                        prefix;
+        int                                                leaseTtl;
+        etcd::Client                                       client;
+        int64_t                                            leaseId = 0;
+        std::shared_ptr<etcd::KeepAlive>                   keepAlive;
+
+        std::mutex                                         watchLock;
+        std::map<std::string, std::unique_ptr<etcd::Watcher>> watchers;
+
+        std::string getKey(const std::string &agent) const { return prefix + agent; }
+
+        // Granted on the first put, so agents that only fetch hold none
+        nixl_status_t getLease() {
+            if (leaseId)
+                return NIXL_SUCCESS;
+
+            etcd::Response resp = client.leasegrant(leaseTtl).get();
+            if (!resp.is_ok()) {
+                NIXL_ERROR << "etcd lease grant failed: " << resp.error_message();
+                return NIXL_ERR_BACKEND;
+            }
+            leaseId   = resp.value().lease();
+            keepAlive = std::make_shared<etcd::KeepAlive>(client, leaseTtl, leaseId);
+            return NIXL_SUCCESS;
+        }
+
+    public:
+        nixlEtcdMetadataKV(const std::string &endpoints, const std::string &key_prefix,
+                           int lease_ttl) :
+            prefix(key_prefix), leaseTtl(lease_ttl), client(endpoints) { }
+
+        ~nixlEtcdMetadataKV() {
+            {
+                std::lock_guard<std::mutex> lock(watchLock);
+                for (auto & elm : watchers)
+                    elm.second->Cancel();
+                watchers.clear();
+            }
+            if (leaseId) {
+                // Removes the published metadata now rather than at expiry
+                keepAlive->Cancel();
+                client.leaserevoke(leaseId).get();
+            }
+        }
+
+        nixl_status_t put(const std::string &agent, const std::string &value) {
+            nixl_status_t ret = getLease();
+            if (ret)
+                return ret;
+
+            etcd::Response resp = client.put(getKey(agent), value, leaseId).get();
+            if (!resp.is_ok()) {
+                NIXL_ERROR << "etcd put of " << agent << " failed: " << resp.error_message();
+                return NIXL_ERR_BACKEND;
+            }
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t get(const std::string &agent, std::string &value, uint64_t &revision) {
+            etcd::Response resp = client.get(getKey(agent)).get();
+            // Revision of the store in the response header
+            revision = (resp.index() > 0) ? resp.index() : 0;
+            if (resp.error_code() == etcdv3::ERROR_KEY_NOT_FOUND)
+                return NIXL_ERR_NOT_FOUND;
+            if (!resp.is_ok()) {
+                NIXL_ERROR << "etcd get of " << agent << " failed: " << resp.error_message();
+                return NIXL_ERR_BACKEND;
+            }
+            value = resp.value().as_string();
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t remove(const std::string &agent) {
+            etcd::Response resp = client.rm(getKey(agent)).get();
+            if (!resp.is_ok() && (resp.error_code() != etcdv3::ERROR_KEY_NOT_FOUND)) {
+                NIXL_ERROR << "etcd remove of " << agent << " failed: " << resp.error_message();
+                return NIXL_ERR_BACKEND;
+            }
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t watch(const std::string &agent, const uint64_t &from_revision,
+                            const watch_cb_t &cb) {
+            std::lock_guard<std::mutex> lock(watchLock);
+            if (watchers.count(agent))
+                return NIXL_SUCCESS;
+
+            // A start revision of 0 is taken by etcd as the current one
+            watchers[agent] = std::make_unique<etcd::Watcher>(client, getKey(agent),
+                (int64_t) from_revision,
+                [agent, cb](etcd::Response resp) {
+                    for (const auto & event : resp.events()) {
+                        if (event.event_type() == etcd::Event::EventType::PUT) {
+                            std::string value = event.kv().as_string();
+                            cb(agent, &value);
+                        } else if (event.event_type() == etcd::Event::EventType::DELETE_) {
+                            cb(agent, nullptr);
+                        }
+                    }
+                });
+            return NIXL_SUCCESS;
+        }
+
+        void unwatch(const std::string &agent) {
+            std::lock_guard<std::mutex> lock(watchLock);
+            auto it = watchers.find(agent);
+            if (it == watchers.end())
+                return;
+            it->second->Cancel();
+            watchers.erase(it);
+        }
+};
+#endif
+
+std::unique_ptr<nixlMetadataKV> nixlMetadataKVCreate() {
+    const char *endpoints = getenv("NIXL_ETCD_ENDPOINTS");
+    if (!endpoints || !endpoints[0])
+        return nullptr;
+
+#ifdef HAVE_ETCD
+    const char *ns  = getenv("NIXL_ETCD_NAMESPACE");
+    const char *ttl = getenv("NIXL_ETCD_LEASE_TTL");
+    std::string prefix = (ns && ns[0]) ? ns : NIXL_ETCD_DEFAULT_NAMESPACE;
+    if (prefix.back() != '/')
+        prefix += '/';
+    int lease_ttl = ttl ? atoi(ttl) : NIXL_ETCD_DEFAULT_LEASE_TTL;
+    if (lease_ttl <= 0)
+        lease_ttl = NIXL_ETCD_DEFAULT_LEASE_TTL;
+
+    try {
+        return std::make_unique<nixlEtcdMetadataKV>(endpoints, prefix, lease_ttl);
+    } catch (const std::exception &e) {
+        NIXL_ERROR << "Cannot connect to etcd at " << endpoints << ": " << e.what();
+        return nullptr;
+    }
+#else
+    NIXL_WARN << "NIXL_ETCD_ENDPOINTS is set, but etcd support is not built in";
+    return nullptr;
+#endif
+}
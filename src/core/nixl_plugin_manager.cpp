@@ -27,7 +27,9 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <sstream>
 #include <map>
+#include <set>
 
 using lock_guard = const std::lock_guard<std::mutex>;
 
@@ -116,6 +118,91 @@ std::map<nixl_backend_t, std::string> loadPluginList(const std::string& filename
     return plugins;
 }
 
+// Extracts the plugin name from a libplugin_<name>.so file name
+static bool pluginNameFromFile(const std::string& filename, std::string& name) {
+    if (filename.size() < 14 ||
+        filename.compare(0, 10, "libplugin_") != 0 ||
+        filename.compare(filename.size() - 3, 3, ".so") != 0)
+        return false;
+
+    name = filename.substr(10, filename.size() - 13);
+    return true;
+}
+
+static std::string memListStr(const nixl_mem_list_t& mems) {
+    std::string str;
+
+    for (const auto& mem : mems) {
+        if (!str.empty())
+            str += ",";
+        str += nixlEnumStrings::memTypeStr(mem);
+    }
+    return str.empty() ? "-" : str;
+}
+
+static bool parseMemList(const std::string& str, nixl_mem_list_t& mems) {
+    std::istringstream stream(str);
+    std::string        token;
+
+    mems.clear();
+    if (str == "-")
+        return true;
+
+    while (std::getline(stream, token, ',')) {
+        int mem = DRAM_SEG;
+        for (; mem <= FILE_SEG; mem++)
+            if (nixlEnumStrings::memTypeStr((nixl_mem_t) mem) == token)
+                break;
+        if (mem > FILE_SEG)
+            return false;
+        mems.push_back((nixl_mem_t) mem);
+    }
+    return true;
+}
+
+// Reads the index file of a directory, one "<name> <version> <mems> <path>" line per
+// plugin, where mems are comma separated or "-" and the path is relative to the directory.
+static std::vector<nixlPluginIndexEntry> readPluginIndex(const std::string& dirpath) {
+    std::vector<nixlPluginIndexEntry> entries;
+    std::filesystem::path dir_path(dirpath);
+    std::ifstream file(dir_path / NIXL_PLUGIN_INDEX_FILE);
+
+    if (!file.is_open())
+        return entries;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream   stream(line);
+        nixlPluginIndexEntry entry;
+        std::string          mems;
+
+        if (!(stream >> entry.name >> entry.version >> mems >> entry.path) ||
+            !parseMemList(mems, entry.mems)) {
+            NIXL_WARN << "Skipping malformed line in plugin index of " << dirpath
+                      << ": " << line;
+            continue;
+        }
+
+        entry.path = (dir_path / entry.path).string();
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+void nixlPluginManager::addIndexEntries(const std::vector<nixlPluginIndexEntry>& entries) {
+    lock_guard lg(lock);
+
+    // The first entry of a name is kept, as the first discovered plugin was kept loaded
+    for (const auto& entry : entries) {
+        if (indexed_plugins_.emplace(entry.name, entry).second)
+            NIXL_DEBUG << "Indexed plugin " << entry.name << " at " << entry.path;
+    }
+}
+
 std::shared_ptr<const nixlPluginHandle> nixlPluginManager::loadPluginFromPath(const std::string& plugin_path) {
     // Open the plugin file
     void* handle = dlopen(plugin_path.c_str(), RTLD_NOW | RTLD_LOCAL);
@@ -157,19 +244,16 @@ std::shared_ptr<const nixlPluginHandle> nixlPluginManager::loadPluginFromPath(co
 }
 
 void nixlPluginManager::loadPluginsFromList(const std::string& filename) {
-    auto plugins = loadPluginList(filename);
-
-    lock_guard lg(lock);
-
-    for (const auto& pair : plugins) {
-        const std::string& name = pair.first;
-        const std::string& path = pair.second;
+    std::vector<nixlPluginIndexEntry> entries;
 
-        auto plugin_handle = loadPluginFromPath(path);
-        if (plugin_handle) {
-            loaded_plugins_[name] = plugin_handle;
-        }
+    for (const auto& pair : loadPluginList(filename)) {
+        nixlPluginIndexEntry entry;
+        entry.name = pair.first;
+        entry.path = pair.second;
+        entries.push_back(entry);
     }
+
+    addIndexEntries(entries);
 }
 
 // PluginManager implementation
@@ -242,6 +326,16 @@ std::shared_ptr<const nixlPluginHandle> nixlPluginManager::loadPlugin(const std:
         return it->second;
     }
 
+    // Indexed plugins are loaded from where they were found
+    auto entry = indexed_plugins_.find(plugin_name);
+    if (entry != indexed_plugins_.end()) {
+        auto plugin_handle = loadPluginFromPath(entry->second.path);
+        if (plugin_handle) {
+            loaded_plugins_[plugin_name] = plugin_handle;
+            return plugin_handle;
+        }
+    }
+
     // Try to load the plugin from all registered directories
     for (const auto& dir : plugin_dirs_) {
         // Handle path joining correctly with or without trailing slash
@@ -281,24 +375,78 @@ void nixlPluginManager::discoverPluginsFromDir(const std::string& dirpath) {
         return;
     }
 
+    // Nothing is loaded here, so the lock is not held while reading the directory
+    std::vector<nixlPluginIndexEntry> entries = readPluginIndex(dirpath);
+    std::set<nixl_backend_t> indexed;
+    for (const auto& entry : entries)
+        indexed.insert(entry.name);
+
+    // Plugins missing from the index file are still found, without version and mems
+    for (const auto& entry : dir_iter) {
+        nixlPluginIndexEntry plugin;
+
+        if (!pluginNameFromFile(entry.path().filename().string(), plugin.name) ||
+            indexed.count(plugin.name))
+            continue;
+
+        plugin.path = entry.path().string();
+        entries.push_back(plugin);
+    }
+
+    addIndexEntries(entries);
+}
+
+nixl_status_t nixlPluginManager::writePluginIndex(const std::string& dirpath) {
+    std::filesystem::path dir_path(dirpath);
+    std::error_code ec;
+    std::filesystem::directory_iterator dir_iter(dir_path, ec);
+    if (ec) {
+        NIXL_ERROR << "Error accessing directory " << dirpath << ": " << ec.message();
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    std::map<nixl_backend_t, std::string> lines;
     for (const auto& entry : dir_iter) {
         std::string filename = entry.path().filename().string();
+        std::string name;
 
-        if(filename.size() < 11) continue;
-        // Check if this is a plugin file
-        if (filename.substr(0, 10) == "libplugin_" &&
-            filename.substr(filename.size() - 3) == ".so") {
+        if (!pluginNameFromFile(filename, name))
+            continue;
 
-            // Extract plugin name
-            std::string plugin_name = filename.substr(10, filename.size() - 13);
+        auto plugin_handle = getPlugin(name);
+        if (!plugin_handle)
+            plugin_handle = loadPluginFromPath(entry.path().string());
+        if (!plugin_handle) {
+            NIXL_WARN << "Plugin " << name << " is not indexed as it failed to load";
+            continue;
+        }
 
-            // Try to load the plugin
-            auto plugin = loadPlugin(plugin_name);
-            if (plugin) {
-                NIXL_INFO << "Discovered and loaded plugin: " << plugin_name;
-            }
+        lines[name] = name + " " + plugin_handle->getVersion() + " " +
+                      memListStr(plugin_handle->getBackendMems()) + " " + filename;
+    }
+
+    // Written aside and renamed, so readers never see a partial index
+    std::filesystem::path index_path = dir_path / NIXL_PLUGIN_INDEX_FILE;
+    std::filesystem::path tmp_path   = index_path.string() + ".tmp";
+    {
+        std::ofstream file(tmp_path);
+        file << "# name version mems path\n";
+        for (const auto& line : lines)
+            file << line.second << "\n";
+        if (!file) {
+            NIXL_ERROR << "Failed to write plugin index " << tmp_path;
+            return NIXL_ERR_BACKEND;
         }
     }
+
+    std::filesystem::rename(tmp_path, index_path, ec);
+    if (ec) {
+        NIXL_ERROR << "Failed to write plugin index " << index_path << ": " << ec.message();
+        std::filesystem::remove(tmp_path, ec);
+        return NIXL_ERR_BACKEND;
+    }
+
+    return NIXL_SUCCESS;
 }
 
 void nixlPluginManager::unloadPlugin(const nixl_backend_t& plugin_name) {
@@ -350,6 +498,41 @@ std::vector<nixl_backend_t> nixlPluginManager::getLoadedPluginNames() {
     return names;
 }
 
+std::vector<nixl_backend_t> nixlPluginManager::getAvailablePluginNames() {
+    lock_guard lg(lock);
+
+    std::set<nixl_backend_t> names;
+    for (const auto& pair : loaded_plugins_)
+        names.insert(pair.first);
+    for (const auto& pair : indexed_plugins_)
+        names.insert(pair.first);
+
+    return std::vector<nixl_backend_t>(names.begin(), names.end());
+}
+
+nixl_status_t nixlPluginManager::getPluginIndexEntry(const nixl_backend_t& plugin_name,
+                                                     nixlPluginIndexEntry& entry) {
+    lock_guard lg(lock);
+
+    auto it = indexed_plugins_.find(plugin_name);
+    if (it != indexed_plugins_.end()) {
+        entry = it->second;
+        return NIXL_SUCCESS;
+    }
+
+    // Static plugins are not indexed, but are loaded already
+    auto loaded = loaded_plugins_.find(plugin_name);
+    if (loaded != loaded_plugins_.end()) {
+        entry.name    = plugin_name;
+        entry.version = loaded->second->getVersion();
+        entry.mems    = loaded->second->getBackendMems();
+        entry.path.clear();
+        return NIXL_SUCCESS;
+    }
+
+    return NIXL_ERR_NOT_FOUND;
+}
+
 void nixlPluginManager::registerStaticPlugin(const char* name, nixlStaticPluginCreatorFunc creator) {
     lock_guard lg(lock);
 
@@ -371,6 +554,26 @@ const std::vector<nixlStaticPluginInfo>& nixlPluginManager::getStaticPlugins() {
     return static_plugins_;
 }
 
+class nixlPluginEngineFactory : public nixlBackendFactory {
+    public:
+        nixlBackendEngine* createEngine(const nixlBackendInitParams* init_params) {
+            auto plugin_handle = nixlPluginManager::getInstance().loadPlugin(init_params->type);
+            if (!plugin_handle)
+                return nullptr;
+            return plugin_handle->createEngine(init_params);
+        }
+
+        // The plugin stays loaded, as for the engines of the agent
+        void destroyEngine(nixlBackendEngine* engine) {
+            delete engine;
+        }
+};
+
+nixlBackendFactory* nixlPluginManager::getEngineFactory() {
+    static nixlPluginEngineFactory factory;
+    return &factory;
+}
+
 void nixlPluginManager::registerBuiltinPlugins() {
     #ifdef STATIC_PLUGIN_UCX
         extern nixlBackendPlugin* createStaticUcxPlugin();
@@ -388,4 +591,44 @@ void nixlPluginManager::registerBuiltinPlugins() {
         registerStaticPlugin("GDS", createStaticGdsPlugin);
     #endif
     #endif
+
+    #ifdef STATIC_PLUGIN_CMA
+        extern nixlBackendPlugin* createStaticCmaPlugin();
+        registerStaticPlugin("CMA", createStaticCmaPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_LOCAL_COPY
+        extern nixlBackendPlugin* createStaticLocalCopyPlugin();
+        registerStaticPlugin("LOCAL_COPY", createStaticLocalCopyPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_CUDA_IPC
+        extern nixlBackendPlugin* createStaticCudaIpcPlugin();
+        registerStaticPlugin("CUDA_IPC", createStaticCudaIpcPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_POSIX
+        extern nixlBackendPlugin* createStaticPosixPlugin();
+        registerStaticPlugin("POSIX", createStaticPosixPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_BLK
+        extern nixlBackendPlugin* createStaticBlkPlugin();
+        registerStaticPlugin("BLK", createStaticBlkPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_OBJ
+        extern nixlBackendPlugin* createStaticObjPlugin();
+        registerStaticPlugin("OBJ", createStaticObjPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_COMPRESS
+        extern nixlBackendPlugin* createStaticCompressPlugin();
+        registerStaticPlugin("COMPRESS", createStaticCompressPlugin);
+    #endif
+
+    #ifdef STATIC_PLUGIN_PIPELINE
+        extern nixlBackendPlugin* createStaticPipelinePlugin();
+        registerStaticPlugin("PIPELINE", createStaticPipelinePlugin);
+    #endif
 }
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include "telemetry.h"
+#include "common/nixl_time.h"
+
+// Entries of destroyed agents are not looked up again, as ids are not reused
+static constexpr size_t shard_cache_size = 8;
+static std::atomic<uint64_t> telemetry_ids{0};
+
+thread_local std::vector<std::pair<uint64_t, nixlTelemetry::shard*>> nixlTelemetry::shardCache;
+
+void nixlTelemetry::counters::add(const counters &other) {
+    posts       += other.posts;
+    bytes       += other.bytes;
+    completions += other.completions;
+    errors      += other.errors;
+    for (size_t i = 0; i < nixl_telemetry_buckets; ++i)
+        latencyUs[i] += other.latencyUs[i];
+}
+
+nixlTelemetry::nixlTelemetry(const bool &enable)
+    : id(telemetry_ids.fetch_add(1, std::memory_order_relaxed)), enabled(enable) { }
+
+nixlTelemetry::shard &nixlTelemetry::getShard() {
+    for (auto & elm : shardCache)
+        if (elm.first == id)
+            return *elm.second;
+
+    shard* shrd = new shard;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        shards.emplace_back(shrd);
+    }
+
+    // Dropping an entry only makes the thread use a new shard if it comes back
+    if (shardCache.size() >= shard_cache_size)
+        shardCache.erase(shardCache.begin());
+    shardCache.emplace_back(id, shrd);
+    return *shrd;
+}
+
+size_t nixlTelemetry::getBucket(const uint64_t &latency_us) {
+    size_t bucket = 0;
+
+    while ((bucket < nixl_telemetry_buckets - 1) && (latency_us >= (1ULL << bucket)))
+        bucket++;
+    return bucket;
+}
+
+void nixlTelemetry::posted(nixlXferReqH* req) {
+    shard &shrd = getShard();
+
+    // Set before the post, as the backend can report it done before returning
+    req->postUs.store(std::max<uint64_t>(nixlTime::getUs(), 1), std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(shrd.lock);
+    counters &cnt = shrd.entries[{req->engine, req->backendOp, req->remoteId}];
+    cnt.posts++;
+    cnt.bytes += req->getDescBytes();
+
+    for (auto & part : req->parts) {
+        counters &part_cnt = shrd.entries[{part->engine, part->backendOp, part->remoteId}];
+        part_cnt.posts++;
+        part_cnt.bytes += part->getDescBytes();
+    }
+}
+
+void nixlTelemetry::finished(nixlXferReqH* req, const nixl_status_t &status) {
+    // Found done by several threads, or released without a post
+    uint64_t start = req->postUs.exchange(0, std::memory_order_relaxed);
+    if (start == 0)
+        return;
+
+    uint64_t now   = nixlTime::getUs();
+    shard    &shrd = getShard();
+
+    std::lock_guard<std::mutex> guard(shrd.lock);
+    counters &cnt = shrd.entries[{req->engine, req->backendOp, req->remoteId}];
+    cnt.completions++;
+    if (status < 0)
+        cnt.errors++;
+    else
+        cnt.latencyUs[getBucket((now > start) ? now - start : 0)]++;
+}
+
+void nixlTelemetry::snapshot(counter_map_t &out) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    out.clear();
+    for (auto & shrd : shards) {
+        std::lock_guard<std::mutex> shard_guard(shrd->lock);
+        for (auto & elm : shrd->entries)
+            out[elm.first].add(elm.second);
+    }
+}
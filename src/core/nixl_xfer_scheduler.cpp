@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include "xfer_scheduler.h"
+
+size_t nixlXferScheduler::xferBytes(nixlXferReqH* req) {
+    size_t total = req->getDescBytes();
+
+    for (auto & part : req->parts)
+        total += part->getDescBytes();
+    return total;
+}
+
+nixlXferScheduler::nixlXferScheduler(const nixlAgentConfig &cfg)
+    : peerMaxBytes(cfg.peerMaxBytes), peerRateBytes(cfg.peerRateBytes) {
+    for (size_t cls = 0; cls < nixl_xfer_priority_count; ++cls) {
+        classes[cls].maxBytes = cfg.priorityMaxBytes[cls];
+        enabled = enabled || (cfg.priorityMaxBytes[cls] > 0);
+    }
+    enabled = enabled || (peerMaxBytes > 0) || (peerRateBytes > 0);
+
+    // 10ms at the rate by default
+    peerBurstBytes = cfg.peerBurstBytes ? cfg.peerBurstBytes :
+                     std::max<double>(peerRateBytes / 100, 1);
+}
+
+// A request larger than a limit still goes once nothing else is in flight
+bool nixlXferScheduler::fitsClass(const classState &cls, const size_t &bytes) const {
+    return (cls.maxBytes == 0) || (cls.inflight == 0) ||
+           (cls.inflight + bytes <= cls.maxBytes);
+}
+
+bool nixlXferScheduler::fitsPeer(peerState &peer, const size_t &bytes,
+                                 const nixlTime::us_t &now) {
+    if (peerMaxBytes && peer.inflight && (peer.inflight + bytes > peerMaxBytes))
+        return false;
+    if (peerRateBytes == 0)
+        return true;
+
+    peer.tokens = std::min(peerBurstBytes, peer.tokens +
+                           (double) (now - peer.refillUs) * peerRateBytes / 1000000);
+    peer.refillUs = now;
+    return peer.tokens > 0;
+}
+
+nixlXferScheduler::peerState &
+nixlXferScheduler::getPeer(const std::string &remote_agent, const nixlTime::us_t &now) {
+    auto res = peers.try_emplace(remote_agent);
+    if (res.second) {
+        res.first->second.tokens   = peerBurstBytes;
+        res.first->second.refillUs = now;
+    }
+    return res.first->second;
+}
+
+void nixlXferScheduler::take(classState &cls, peerState &peer, nixlXferReqH* req,
+                             const size_t &bytes) {
+    cls.inflight  += bytes;
+    peer.inflight += bytes;
+    if (peerRateBytes)
+        peer.tokens -= bytes;
+    req->schedBytes.store(bytes, std::memory_order_relaxed);
+}
+
+bool nixlXferScheduler::reserve(nixlXferReqH* req) {
+    // Taken from the deferred ones with its bytes
+    if (req->schedBytes.load(std::memory_order_relaxed) > 0)
+        return true;
+
+    size_t bytes = xferBytes(req);
+    if (bytes == 0)
+        return true;
+
+    nixlTime::us_t now = peerRateBytes ? nixlTime::getUs() : 0;
+    classState &cls = classes[(size_t) req->priority];
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (cls.deferred.count(req->remoteAgent) || !fitsClass(cls, bytes))
+        return false;
+
+    peerState &peer = getPeer(req->remoteAgent, now);
+    if (!fitsPeer(peer, bytes, now))
+        return false;
+    take(cls, peer, req, bytes);
+    return true;
+}
+
+void nixlXferScheduler::release(nixlXferReqH* req) {
+    if (req->schedBytes.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // Finished requests can be seen by several threads at once
+    size_t bytes = req->schedBytes.exchange(0);
+    if (bytes == 0)
+        return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    classes[(size_t) req->priority].inflight -= bytes;
+    peers[req->remoteAgent].inflight -= bytes;
+}
+
+void nixlXferScheduler::defer(nixlXferSubmission &&sub) {
+    nixlTime::us_t now = peerRateBytes ? nixlTime::getUs() : 0;
+    nixlXferReqH* req = sub.req;
+    classState &cls = classes[(size_t) req->priority];
+
+    sub.bytes = xferBytes(req);
+
+    std::lock_guard<std::mutex> guard(lock);
+    peerState &peer = getPeer(req->remoteAgent, now);
+    peer.queued += sub.bytes;
+    peer.queuedReqs++;
+
+    auto &queue = cls.deferred[req->remoteAgent];
+    if (queue.empty())
+        cls.turns.push_back(req->remoteAgent);
+    queue.push_back(std::move(sub));
+    deferredCount++;
+}
+
+bool nixlXferScheduler::cancel(nixlXferReqH* req) {
+    classState &cls = classes[(size_t) req->priority];
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto q_it = cls.deferred.find(req->remoteAgent);
+    if (q_it == cls.deferred.end())
+        return false;
+
+    auto &queue = q_it->second;
+    auto it = std::find_if(queue.begin(), queue.end(),
+                           [req](const nixlXferSubmission &sub) { return sub.req == req; });
+    if (it == queue.end())
+        return false;
+
+    peerState &peer = peers[req->remoteAgent];
+    peer.queued -= it->bytes;
+    peer.queuedReqs--;
+    queue.erase(it);
+    deferredCount--;
+
+    if (queue.empty()) {
+        cls.deferred.erase(q_it);
+        cls.turns.erase(std::find(cls.turns.begin(), cls.turns.end(), req->remoteAgent));
+    }
+    return true;
+}
+
+void nixlXferScheduler::takeReady(std::vector<nixlXferSubmission> &out) {
+    nixlTime::us_t now = peerRateBytes ? nixlTime::getUs() : 0;
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto & cls : classes) {
+        // A request per remote agent in turn, until none of them fits
+        size_t misses = 0;
+
+        while (!cls.turns.empty() && (misses < cls.turns.size())) {
+            std::string remote_agent = std::move(cls.turns.front());
+            cls.turns.pop_front();
+
+            auto &queue = cls.deferred[remote_agent];
+            nixlXferSubmission &sub = queue.front();
+            if (!fitsClass(cls, sub.bytes)) {
+                cls.turns.push_front(std::move(remote_agent));
+                break;
+            }
+
+            peerState &peer = peers[remote_agent];
+            if (!fitsPeer(peer, sub.bytes, now)) {
+                cls.turns.push_back(std::move(remote_agent));
+                misses++;
+                continue;
+            }
+
+            take(cls, peer, sub.req, sub.bytes);
+            peer.queued -= sub.bytes;
+            peer.queuedReqs--;
+            out.push_back(std::move(sub));
+            queue.pop_front();
+            deferredCount--;
+            misses = 0;
+
+            if (queue.empty())
+                cls.deferred.erase(remote_agent);
+            else
+                cls.turns.push_back(std::move(remote_agent));
+        }
+    }
+}
+
+void nixlXferScheduler::getStats(nixlXferQueueStats &stats, const std::string &remote_agent) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    stats = nixlXferQueueStats();
+    for (auto & elm : peers) {
+        if (!remote_agent.empty() && (elm.first != remote_agent))
+            continue;
+        stats.queuedBytes   += elm.second.queued;
+        stats.queuedReqs    += elm.second.queuedReqs;
+        stats.inflightBytes += elm.second.inflight;
+    }
+}
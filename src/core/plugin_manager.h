@@ -52,6 +52,18 @@ public:
     nixl_mem_list_t getBackendMems() const;
 };
 
+// A plugin known from a directory or an index file, which is not necessarily loaded.
+// Version and mems are only known when the plugin is listed in an index file.
+struct nixlPluginIndexEntry {
+    nixl_backend_t  name;
+    std::string     version;
+    nixl_mem_list_t mems;
+    std::string     path;
+};
+
+// Name of the index file, which lists the plugins of a directory without loading them
+#define NIXL_PLUGIN_INDEX_FILE "nixl_plugins.index"
+
 // Creator Function for static plugins
 typedef nixlBackendPlugin* (*nixlStaticPluginCreatorFunc)();
 
@@ -66,8 +78,11 @@ private:
     std::map<nixl_backend_t, std::shared_ptr<const nixlPluginHandle>> loaded_plugins_;
     std::vector<std::string> plugin_dirs_;
     std::vector<nixlStaticPluginInfo> static_plugins_;
+    std::map<nixl_backend_t, nixlPluginIndexEntry> indexed_plugins_;
     std::mutex lock;
 
+    void addIndexEntries(const std::vector<nixlPluginIndexEntry>& entries);
+
     void registerBuiltinPlugins();
     void registerStaticPlugin(const char* name, nixlStaticPluginCreatorFunc creator);
 
@@ -84,14 +99,19 @@ public:
 
     std::shared_ptr<const nixlPluginHandle> loadPluginFromPath(const std::string& plugin_path);
 
+    // Index the plugins of a list file, they are loaded on first use
     void loadPluginsFromList(const std::string& filename);
 
     // Load a specific plugin
     std::shared_ptr<const nixlPluginHandle> loadPlugin(const nixl_backend_t& plugin_name);
 
-    // Search a directory for plugins
+    // Search a directory for plugins and index them, without loading. Name, version
+    // and mems are read from the index file of the directory if there is one.
     void discoverPluginsFromDir(const std::string& dirpath);
 
+    // Load the plugins of a directory to write its index file
+    nixl_status_t writePluginIndex(const std::string& dirpath);
+
     // Unload a plugin
     void unloadPlugin(const nixl_backend_t& plugin_name);
 
@@ -101,6 +121,13 @@ public:
     // Get all loaded plugin names
     std::vector<nixl_backend_t> getLoadedPluginNames();
 
+    // Get the names of loaded and indexed plugins
+    std::vector<nixl_backend_t> getAvailablePluginNames();
+
+    // Get the index entry of a plugin, without loading it
+    nixl_status_t getPluginIndexEntry(const nixl_backend_t& plugin_name,
+                                      nixlPluginIndexEntry& entry);
+
     // Get backend options
     nixl_b_params_t getBackendOptions(const nixl_backend_t& type);
 
@@ -109,6 +136,9 @@ public:
 
     // Static Plugin Helpers
     const std::vector<nixlStaticPluginInfo>& getStaticPlugins();
+
+    // Creates engines of the loaded plugins, for backends wrapping others
+    nixlBackendFactory* getEngineFactory();
 };
 
 #endif // __PLUGIN_MANAGER_H
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __REG_REQUEST_H_
+#define __REG_REQUEST_H_
+
+#include <atomic>
+#include <vector>
+#include "nixl.h"
+#include "backend/backend_engine.h"
+
+// Registration by registerMemAsync, with a copy of the descriptors and the
+// backends to register them with, run by the registration threads of the agent
+class nixlRegReqH {
+    private:
+        nixl_reg_dlist_t                descs;
+        std::vector<nixlBackendEngine*> backends;
+        nixl_reg_cb_t                   callback    = nullptr;
+        void*                           callbackCtx = nullptr;
+        std::atomic<nixl_status_t>      status{NIXL_IN_PROG};
+
+    public:
+        nixlRegReqH(const nixl_reg_dlist_t &descs) : descs(descs) { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+#endif
@@ -19,29 +19,57 @@
 #include "common/util.h"
 #include "nixl_params.h"
 #include <mutex>
+#include <shared_mutex>
 
 class nixlLock {
     public:
         nixlLock(const nixl_thread_sync_t sync_mode): syncMode(sync_mode)
         {}
 
+        // Exclusive access, for calls that modify the agent state
         void lock() {
             if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
                 m.lock();
+            } else if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_RW) {
+                rwm.lock();
             }
         }
 
         void unlock() {
             if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
                 m.unlock();
+            } else if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_RW) {
+                rwm.unlock();
             }
         }
 
+        // Shared access, for calls that only read the agent state.
+        // Still exclusive in strict mode.
+        void lock_shared() {
+            if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
+                m.lock();
+            } else if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_RW) {
+                rwm.lock_shared();
+            }
+        }
+
+        void unlock_shared() {
+            if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
+                m.unlock();
+            } else if (syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_RW) {
+                rwm.unlock_shared();
+            }
+        }
+
+        nixl_thread_sync_t getSyncMode() const { return syncMode; }
+
     private:
         nixl_thread_sync_t syncMode;
         std::mutex m;
+        std::shared_mutex rwm;
 };
 
 #define NIXL_LOCK_GUARD(lock) const std::lock_guard<nixlLock> UNIQUE_NAME(lock_guard) (lock)
+#define NIXL_SHARED_LOCK_GUARD(lock) const std::shared_lock<nixlLock> UNIQUE_NAME(shared_lock_guard) (lock)
 
 #endif /* SYNC_H */
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __TELEMETRY_H_
+#define __TELEMETRY_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "nixl.h"
+#include "transfer_request.h"
+
+// Counters and latency histograms of the transfers of an agent, per backend engine,
+// operation and remote agent. Each thread records into its own shard, which only
+// snapshot contends on, and the shards are summed by snapshot. Built with
+// DISABLE_TELEMETRY, isEnabled is a constant false and the agent skips the calls.
+class nixlTelemetry {
+    public:
+        struct key {
+            const nixlBackendEngine* engine;
+            nixl_xfer_op_t           op;
+            nixl_agent_id_t          remoteId;
+
+            bool operator==(const key &other) const {
+                return (engine == other.engine) && (op == other.op) &&
+                       (remoteId == other.remoteId);
+            }
+        };
+
+        struct keyHash {
+            size_t operator()(const key &k) const {
+                return std::hash<const void*>()(k.engine) ^
+                       (std::hash<uint64_t>()(((uint64_t) k.remoteId << 1) | k.op) << 1);
+            }
+        };
+
+        struct counters {
+            uint64_t posts       = 0;
+            uint64_t bytes       = 0;
+            uint64_t completions = 0;
+            uint64_t errors      = 0;
+            std::array<uint64_t, nixl_telemetry_buckets> latencyUs = {};
+
+            void add(const counters &other);
+        };
+
+        typedef std::unordered_map<key, counters, keyHash> counter_map_t;
+
+    private:
+        struct shard {
+            std::mutex    lock;
+            counter_map_t entries;
+        };
+
+        // Unique per instance, the shards each thread uses are cached by it
+        const uint64_t                      id;
+        bool                                enabled;
+        std::mutex                          lock;
+        std::vector<std::unique_ptr<shard>> shards;
+
+        // Agents the thread recorded for lately, and its shard in each of them
+        static thread_local std::vector<std::pair<uint64_t, shard*>> shardCache;
+
+        shard &getShard();
+
+    public:
+        nixlTelemetry(const bool &enable);
+
+        bool isEnabled() const {
+#ifdef DISABLE_TELEMETRY
+            return false;
+#else
+            return enabled;
+#endif
+        }
+
+        // Counts the post of a request and of its pieces, which starts its latency
+        void posted(nixlXferReqH* req);
+        // Records the latency of a request found done, once per post
+        void finished(nixlXferReqH* req, const nixl_status_t &status);
+
+        // Sums of the shards at the time of the call
+        void snapshot(counter_map_t &out);
+
+        static size_t getBucket(const uint64_t &latency_us);
+};
+
+#endif
@@ -17,6 +17,15 @@
 #ifndef __TRANSFER_REQUEST_H_
 #define __TRANSFER_REQUEST_H_
 
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "nixl.h"
+#include "backend/backend_engine.h"
+#include "sync.h"
+#include "common/nixl_trace.h"
+
 // Contains pointers to corresponding backend engine and its handler, and populated
 // and verified DescLists, and other state and metadata needed for a NIXL transfer
 class nixlXferReqH {
@@ -28,12 +37,116 @@ class nixlXferReqH {
         nixl_meta_dlist_t* targetDescs    = nullptr;
 
         std::string        remoteAgent;
+        nixl_agent_id_t    remoteId       = NIXL_INVALID_AGENT_ID;
         nixl_blob_t        notifMsg;
         bool               hasNotif       = false;
 
         nixl_xfer_op_t     backendOp;
         nixl_status_t      status;
 
+        // Reported through the agent completion queue once posted
+        bool               useCq          = false;
+        // Called instead of adding to the completion queue, implies useCq
+        nixl_xfer_cb_t     callback       = nullptr;
+        void*              callbackCtx    = nullptr;
+
+        // Where the request is in the submission queue, queued by postXferReq
+        // and then being posted by the progress thread
+        enum : uint8_t { SUBMIT_NONE, SUBMIT_QUEUED, SUBMIT_POSTING };
+        std::atomic<uint8_t> submitState{SUBMIT_NONE};
+        // Error of the last post by the progress thread, which its caller did not get
+        nixl_status_t      submitErr      = NIXL_SUCCESS;
+
+        // Priority class, and the bytes reserved in it by the scheduler while posted
+        nixl_xfer_priority_t priority     = nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
+        std::atomic<size_t>  schedBytes{0};
+
+        // Time in us of the last post, taken back by the telemetry once done
+        std::atomic<uint64_t> postUs{0};
+
+        // Bytes of the initiator descriptors, counted on first use
+        size_t             descBytes      = SIZE_MAX;
+
+        inline size_t getDescBytes() {
+            if (descBytes == SIZE_MAX) {
+                descBytes = 0;
+                for (int i = 0; i < initiatorDescs->descCount(); ++i)
+                    descBytes += (*initiatorDescs)[i].len;
+            }
+            return descBytes;
+        }
+
+        // Waits for a post by the progress thread to be done, as it can report
+        // the request finished before. Returns whether it's still queued.
+        inline bool submitPending() const {
+            uint8_t state;
+
+            while ((state = submitState.load(std::memory_order_acquire)) == SUBMIT_POSTING)
+                std::this_thread::yield();
+            return state == SUBMIT_QUEUED;
+        }
+
+        // Pieces of the transfer on other backends, posted alongside this one.
+        // With pieces, the notification is sent by the agent after all are done.
+        std::vector<nixlXferReqH*> parts;
+        bool               notifPending   = false;
+
+        // Posts this request and its pieces, opt_args apply to the whole transfer
+        inline nixl_status_t postXfer(const nixl_opt_b_args_t &opt_args) {
+            NIXL_TRACE_SPAN("backend.postXfer");
+            nixl_opt_b_args_t part_args;
+            nixl_status_t     ret;
+
+            if (parts.empty())
+                return engine->postXfer(backendOp, *initiatorDescs, *targetDescs,
+                                        remoteAgent, backendHandle, &opt_args);
+
+            notifPending = false;
+            ret = engine->postXfer(backendOp, *initiatorDescs, *targetDescs,
+                                   remoteAgent, backendHandle, &part_args);
+            if (ret < 0)
+                return ret;
+
+            for (auto & part : parts) {
+                part->status = part->engine->postXfer(part->backendOp,
+                                                      *part->initiatorDescs,
+                                                      *part->targetDescs,
+                                                      part->remoteAgent,
+                                                      part->backendHandle,
+                                                      &part_args);
+                if (part->status < 0)
+                    return part->status;
+            }
+
+            notifPending = opt_args.hasNotif;
+            return checkXfer();
+        }
+
+        // Status of this request and its pieces, sending the deferred
+        // notification when the last piece is done
+        inline nixl_status_t checkXfer() {
+            NIXL_TRACE_SPAN("backend.checkXfer");
+            nixl_status_t ret = engine->checkXfer(backendHandle);
+
+            if (parts.empty() || (ret < 0))
+                return ret;
+
+            for (auto & part : parts) {
+                if (part->status == NIXL_IN_PROG)
+                    part->status = part->engine->checkXfer(part->backendHandle);
+                if (part->status < 0)
+                    return part->status;
+                if (part->status == NIXL_IN_PROG)
+                    ret = NIXL_IN_PROG;
+            }
+
+            if ((ret == NIXL_SUCCESS) && notifPending) {
+                notifPending = false;
+                ret = engine->genNotif(remoteAgent, notifMsg);
+            }
+            return ret;
+        }
+
     public:
         inline nixlXferReqH() { }
 
@@ -43,9 +156,125 @@ class nixlXferReqH {
             delete targetDescs;
             if (backendHandle != nullptr)
                 engine->releaseReqH(backendHandle);
+            for (auto & part : parts)
+                delete part;
+        }
+
+        // Drops the backend state and empties the descriptor lists, keeping
+        // their capacity, so the handle can be handed out again by the pool
+        inline void recycle() {
+            if (backendHandle != nullptr)
+                engine->releaseReqH(backendHandle);
+            backendHandle = nullptr;
+            engine        = nullptr;
+            hasNotif      = false;
+            useCq         = false;
+            callback      = nullptr;
+            callbackCtx   = nullptr;
+            submitState.store(SUBMIT_NONE, std::memory_order_release);
+            submitErr     = NIXL_SUCCESS;
+            priority      = nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT;
+            postUs.store(0, std::memory_order_relaxed);
+            descBytes     = SIZE_MAX;
+            notifPending  = false;
+            notifMsg.clear();
+            remoteAgent.clear();
+            remoteId      = NIXL_INVALID_AGENT_ID;
         }
 
     friend class nixlAgent;
+    friend class nixlXferReqPool;
+    friend class nixlXferCompletionQueue;
+    friend class nixlXferScheduler;
+    friend class nixlTelemetry;
+    friend class nixlAgentData;
+};
+
+// Post of a request queued by postXferReq, with the optional args it uses
+struct nixlXferSubmission {
+    nixlXferReqH* req      = nullptr;
+    bool          hasArgs  = false;
+    bool          hasNotif = false;
+    bool          useCq    = false;
+    nixl_blob_t   notifMsg;
+    void*         cudaStream = nullptr;
+    void*         cudaEvent  = nullptr;
+    // Set when deferred by the scheduler
+    size_t        bytes      = 0;
+};
+
+// Per agent cache of released transfer handles and their meta dlists, to avoid
+// heap allocations on the datapath. Accesses are done while holding the agent
+// lock, and the pool's own lock is only needed when that one can be shared.
+class nixlXferReqPool {
+    private:
+        std::vector<nixlXferReqH*> freeList;
+        size_t                     maxCached;
+        nixlLock                   lock;
+
+        // Stats, to see the effect of the pool in benchmarks. Updated while
+        // the agent lock may only be held shared
+        std::atomic<uint64_t>      allocCount{0};
+        std::atomic<uint64_t>      reuseCount{0};
+
+    public:
+        inline nixlXferReqPool(const nixl_thread_sync_t &sync_mode,
+                               const size_t &max_cached = 1024) :
+            maxCached(max_cached), lock(sync_mode) { }
+
+        inline ~nixlXferReqPool() {
+            for (auto & req : freeList)
+                delete req;
+        }
+
+        inline nixlXferReqH* get(const nixl_mem_t &init_mem,
+                                 const bool &init_sorted,
+                                 const nixl_mem_t &target_mem,
+                                 const bool &target_sorted) {
+            nixlXferReqH* req;
+
+            NIXL_LOCK_GUARD(lock);
+            if (freeList.empty()) {
+                req = new nixlXferReqH;
+                req->initiatorDescs = new nixl_meta_dlist_t(init_mem, init_sorted);
+                req->targetDescs    = new nixl_meta_dlist_t(target_mem, target_sorted);
+                allocCount.fetch_add(1, std::memory_order_relaxed);
+                return req;
+            }
+
+            req = freeList.back();
+            freeList.pop_back();
+            req->initiatorDescs->reset(init_mem, init_sorted);
+            req->targetDescs->reset(target_mem, target_sorted);
+            reuseCount.fetch_add(1, std::memory_order_relaxed);
+            return req;
+        }
+
+        inline void put(nixlXferReqH* req) {
+            if (!req)
+                return;
+
+            for (auto & part : req->parts)
+                put(part);
+            req->parts.clear();
+
+            // Recycle outside of the lock, as it might call into the backend
+            req->recycle();
+
+            NIXL_LOCK_GUARD(lock);
+            if (freeList.size() >= maxCached) {
+                delete req;
+                return;
+            }
+            freeList.push_back(req);
+        }
+
+        inline uint64_t getAllocCount() const {
+            return allocCount.load(std::memory_order_relaxed);
+        }
+        inline uint64_t getReuseCount() const {
+            return reuseCount.load(std::memory_order_relaxed);
+        }
 };
 
 class nixlDlistH {
@@ -53,6 +282,7 @@ class nixlDlistH {
         std::unordered_map<nixlBackendEngine*, nixl_meta_dlist_t*> descs;
 
         std::string        remoteAgent;
+        nixl_agent_id_t    remoteId = NIXL_INVALID_AGENT_ID;
         bool               isLocal;
 
     public:
@@ -64,6 +294,7 @@ class nixlDlistH {
         }
 
     friend class nixlAgent;
+    friend class nixlAgentData;
 };
 
 #endif
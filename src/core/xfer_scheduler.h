@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __XFER_SCHEDULER_H_
+#define __XFER_SCHEDULER_H_
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nixl.h"
+#include "common/nixl_time.h"
+#include "transfer_request.h"
+
+// Limits the bytes in flight per priority class of the transfer requests of an
+// agent, and the bytes in flight and rate of the transfers to each remote agent.
+// Posts beyond the limits are deferred and handed back once they fit, higher
+// classes first, and the remote agents of a class taking turns.
+class nixlXferScheduler {
+    private:
+        struct peerState {
+            size_t         inflight   = 0;
+            size_t         queued     = 0;
+            size_t         queuedReqs = 0;
+            // Token bucket in bytes, in debt after a request larger than it
+            double         tokens     = 0;
+            nixlTime::us_t refillUs   = 0;
+        };
+
+        struct classState {
+            size_t maxBytes = 0;
+            size_t inflight = 0;
+            // Deferred requests per remote agent, and the agents in turn order
+            std::unordered_map<std::string, std::deque<nixlXferSubmission>> deferred;
+            std::deque<std::string> turns;
+        };
+
+        std::mutex lock;
+        std::array<classState, nixl_xfer_priority_count> classes;
+        std::unordered_map<std::string, peerState> peers;
+        size_t   peerMaxBytes;
+        uint64_t peerRateBytes;
+        double   peerBurstBytes;
+        // Checked without the lock, before taking deferred posts
+        std::atomic<size_t> deferredCount{0};
+        bool                enabled = false;
+
+        // Of the request and its pieces on other backends
+        static size_t xferBytes(nixlXferReqH* req);
+        // With the lock held
+        bool fitsClass(const classState &cls, const size_t &bytes) const;
+        bool fitsPeer(peerState &peer, const size_t &bytes, const nixlTime::us_t &now);
+        peerState &getPeer(const std::string &remote_agent, const nixlTime::us_t &now);
+        void take(classState &cls, peerState &peer, nixlXferReqH* req, const size_t &bytes);
+
+    public:
+        nixlXferScheduler(const nixlAgentConfig &cfg);
+
+        bool isEnabled() const { return enabled; }
+        bool hasDeferred() const {
+            return deferredCount.load(std::memory_order_relaxed) > 0;
+        }
+
+        // Reserves the bytes of a request about to be posted. Returns false if they
+        // don't fit, or its remote agent has deferred requests of the class already.
+        bool reserve(nixlXferReqH* req);
+        // Gives the bytes back once the request is done, once per reserve
+        void release(nixlXferReqH* req);
+
+        void defer(nixlXferSubmission &&sub);
+        // Drops a deferred request, returns whether it was deferred
+        bool cancel(nixlXferReqH* req);
+        // Deferred requests that fit now, with their bytes reserved
+        void takeReady(std::vector<nixlXferSubmission> &out);
+
+        // In total if remote_agent is empty
+        void getStats(nixlXferQueueStats &stats, const std::string &remote_agent);
+};
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_DESC_KERNELS_H
+#define _NIXL_DESC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "nixl_descriptors.h"
+
+// Checks over many descriptors at once, vectorized with the widest
+// instructions of the CPU found at runtime (AVX-512, AVX2 or NEON).
+
+// Index of the first pair of descriptors with different lengths, or count if
+// all of them have the same
+size_t nixlDescLenMismatch(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs,
+                           size_t count);
+
+// Number of leading query descriptors covered by base, such as the queries
+// of a transfer that fall in the same registered section descriptor
+size_t nixlDescCoveredRun(const nixlBasicDesc *queries, size_t count,
+                          const nixlBasicDesc &base);
+
+// Index of the first descriptor of a sorted list overlapping the next one, or
+// count if none does. Descriptors are stride bytes apart, a multiple of 8, so
+// lists of descriptor types derived from nixlBasicDesc are read in place.
+size_t nixlDescSortedOverlap(const nixlBasicDesc *descs, size_t count,
+                             size_t stride);
+
+#endif
@@ -23,6 +23,7 @@
 #include <array>
 #include <string>
 #include <set>
+#include <deque>
 #include "nixl_descriptors.h"
 #include "nixl.h"
 #include "backend/backend_engine.h"
@@ -40,6 +41,10 @@ typedef std::unordered_map<nixl_backend_t, nixlBackendEngine*> backend_map_t;
 class nixlSectionDesc : public nixlMetaDesc {
 public:
     nixl_blob_t metaBlob;
+    // Node of the max tree of the end addresses of a section list, so regions
+    // covering or overlapping a descriptor are found in O(log N) even when
+    // registrations are nested, see updateMaxEnds
+    uintptr_t   maxEnd = 0;
 
     using nixlMetaDesc::nixlMetaDesc;
 
@@ -60,6 +65,58 @@ public:
 
 typedef nixlDescList<nixlSectionDesc>               nixl_sec_dlist_t;
 typedef std::map<section_key_t, nixl_sec_dlist_t*>  section_map_t;
+typedef std::set<std::pair<section_key_t, nixlBasicDesc>> section_desc_set_t;
+
+// Changes of the local section kept for metadata deltas, at most this many
+#define NIXL_SECTION_MAX_CHANGES 4096
+
+/**
+ * @brief A registration or deregistration of the local section, sent to the
+ *        agents that hold an earlier version of the metadata.
+ */
+class nixlSectionChange {
+public:
+    uint64_t          version;
+    bool              added;
+    nixlBackendEngine *backend;
+    nixl_mem_t        mem;
+    nixlBlobDesc      desc;
+};
+
+// Descriptors loaded by the same thread during a metadata import, at least
+#define NIXL_IMPORT_CHUNK 1024
+// Descriptors registered by the same thread of a parallel registration
+#define NIXL_REG_CHUNK 64
+
+/**
+ * @brief Descriptors of a full remote metadata to be loaded by the backends.
+ *        Prepared from the remote section, loaded without changing it, so
+ *        that it can be done in parallel, and then merged into it.
+ */
+class nixlRemoteImport {
+public:
+    class entry {
+    public:
+        size_t            list;
+        int               index;
+        nixlBackendMD     *metadataP = nullptr;
+    };
+
+    std::string                      agentName;
+    std::vector<nixl_reg_dlist_t>    lists;
+    std::vector<nixlBackendEngine*>  listEngines;
+    // Descriptors of the lists that are new for the section, or changed
+    std::vector<entry>               entries;
+    section_desc_set_t               loaded;
+
+    // True if loading can be done while other agent calls read the state
+    bool isConcurrent() const;
+
+    // Per backend, and in chunks for the backends supporting concurrent
+    // loads, over up to max_threads threads. Nothing is kept on errors.
+    nixl_status_t load(const size_t &max_threads);
+    void unload();
+};
 
 class nixlMemSection {
     protected:
@@ -81,20 +138,63 @@ class nixlMemSection {
 
 
 class nixlLocalSection : public nixlMemSection {
+    private:
+        uint64_t                      version = 1;
+        // Changes after this version are all in changes
+        uint64_t                      deltaBase = 1;
+        std::deque<nixlSectionChange> changes;
+
+        void addChanges (const nixl_sec_dlist_t &descs, bool added,
+                         nixlBackendEngine* backend);
+
     public:
         nixl_status_t addDescList (const nixl_reg_dlist_t &mem_elms,
                                    nixlBackendEngine* backend,
-                                   nixl_sec_dlist_t &remote_self);
+                                   nixl_sec_dlist_t &remote_self,
+                                   const size_t &max_threads = 1);
+
+        // The two steps of addDescList. regDescs registers mem_elms with the backend
+        // without the section, and undoes it on errors. commitDescs adds them.
+        // Backends supporting concurrent registration get chunks of the descriptors
+        // from up to max_threads threads, merged in order once all are done.
+        static nixl_status_t regDescs (const nixl_reg_dlist_t &mem_elms,
+                                       nixlBackendEngine* backend,
+                                       nixl_sec_dlist_t &added,
+                                       nixl_sec_dlist_t &remote_self,
+                                       const size_t &max_threads = 1);
+        static nixl_status_t regRange (const nixl_reg_dlist_t &mem_elms,
+                                       const int &start, const int &end,
+                                       nixlBackendEngine* backend,
+                                       nixl_sec_dlist_t &added,
+                                       nixl_sec_dlist_t &remote_self);
+        static void unregDescs (nixlBackendEngine* backend,
+                                const nixl_sec_dlist_t &added,
+                                const nixl_sec_dlist_t &remote_self);
+        void commitDescs (nixlBackendEngine* backend, const nixl_sec_dlist_t &added);
+
+        // True if a descriptor of mem_elms overlaps another one of them, or one
+        // registered with backend, in O(log N) per descriptor
+        bool hasOverlaps (const nixl_reg_dlist_t &mem_elms,
+                          nixlBackendEngine* backend) const;
 
         // Each nixlBasicDesc should be same as original registration region
         nixl_status_t remDescList (const nixl_reg_dlist_t &mem_elms,
                                    nixlBackendEngine* backend);
 
-        nixl_status_t serialize(nixlSerDes* serializer) const;
+        // Packed lists are delta encoded, see nixlDescList::serialize
+        nixl_status_t serialize(nixlSerDes* serializer, const bool &packed=false) const;
 
         nixl_status_t serializePartial(nixlSerDes* serializer,
                                        const backend_set_t &backends,
-                                       const nixl_reg_dlist_t &mem_elms) const;
+                                       const nixl_reg_dlist_t &mem_elms,
+                                       const bool &packed=false) const;
+
+        // Changes since a version, NIXL_ERR_NOT_FOUND if they are not kept
+        nixl_status_t serializeDelta(nixlSerDes* serializer,
+                                     const uint64_t &since_version) const;
+
+        // Bumped by every change, starting from 1
+        uint64_t getVersion() const { return version; }
 
         ~nixlLocalSection();
 };
@@ -104,14 +204,45 @@ class nixlRemoteSection : public nixlMemSection {
     private:
         std::string agentName;
 
+        // Version of the agent metadata loaded, 0 if the agent sent none
+        uint64_t    version = 0;
+
+        nixl_status_t checkDesc (const nixlBlobDesc &desc,
+                                 const section_key_t &sec_key,
+                                 bool &changed) const;
+
         nixl_status_t addDescList (
+                           const nixl_reg_dlist_t &mem_elms,
+                           nixlBackendEngine *backend,
+                           section_desc_set_t *loaded = nullptr);
+        nixl_status_t remDescList (
                            const nixl_reg_dlist_t &mem_elms,
                            nixlBackendEngine *backend);
     public:
         nixlRemoteSection (const std::string &agent_name);
 
+        // Descriptors of the backends in the map are added, and listed in
+        // loaded when it is set
         nixl_status_t loadRemoteData (nixlSerDes* deserializer,
-                                      backend_map_t &backendToEngineMap);
+                                      backend_map_t &backendToEngineMap,
+                                      section_desc_set_t *loaded = nullptr);
+
+        // loadRemoteData in steps: the descriptors are read into an import,
+        // loaded by the backends, and then added to the section
+        nixl_status_t prepRemoteData (nixlSerDes* deserializer,
+                                      backend_map_t &backendToEngineMap,
+                                      nixlRemoteImport &import) const;
+        void mergeRemoteData (nixlRemoteImport &import);
+
+        // Removes the descriptors not listed, after loading the full metadata
+        void prune (const section_desc_set_t &loaded);
+
+        // Applies the changes of a metadata delta in order
+        nixl_status_t loadRemoteDelta (nixlSerDes* deserializer,
+                                       backend_map_t &backendToEngineMap);
+
+        uint64_t getVersion() const { return version; }
+        void setVersion(const uint64_t &new_version) { version = new_version; }
 
         // When adding self as a remote agent for local operations
         nixl_status_t loadLocalData (const nixl_sec_dlist_t& mem_elms,
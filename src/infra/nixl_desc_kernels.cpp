@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstddef>
+#include "desc_kernels.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// The vector versions read nixlBasicDesc arrays as groups of three 64-bit
+// words, addr, len and devId
+static_assert(sizeof(nixlBasicDesc) == 3 * sizeof(uint64_t));
+static_assert(offsetof(nixlBasicDesc, addr) == 0);
+static_assert(offsetof(nixlBasicDesc, len) == sizeof(uint64_t));
+static_assert(offsetof(nixlBasicDesc, devId) == 2 * sizeof(uint64_t));
+
+namespace {
+
+// End of a descriptor, saturated as for the sections up to the end of the
+// address space, such as the unbounded file segments
+inline uint64_t descEnd(const nixlBasicDesc &desc) {
+    return (desc.len > UINT64_MAX - desc.addr) ? UINT64_MAX : desc.addr + desc.len;
+}
+
+/*** Scalar versions, also finishing the last elements of the vector ones ***/
+
+size_t lenMismatchScalar(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs,
+                         size_t start, size_t count) {
+    for (size_t i = start; i < count; ++i)
+        if (lhs[i].len != rhs[i].len)
+            return i;
+    return count;
+}
+
+size_t coveredRunScalar(const nixlBasicDesc *queries, size_t start, size_t count,
+                        const nixlBasicDesc &base) {
+    const uint64_t end = descEnd(base);
+
+    for (size_t i = start; i < count; ++i)
+        if ((queries[i].devId != base.devId) || (queries[i].addr < base.addr) ||
+            (descEnd(queries[i]) > end))
+            return i;
+    return count;
+}
+
+inline const nixlBasicDesc &descAt(const nixlBasicDesc *descs, size_t stride, size_t i) {
+    return *(const nixlBasicDesc*) ((const char*) descs + i * stride);
+}
+
+// Confirms the candidates of the vector versions with the exact comparison
+size_t sortedOverlapScalar(const nixlBasicDesc *descs, size_t start, size_t count,
+                           size_t stride) {
+    for (size_t i = start; i + 1 < count; ++i)
+        if (descAt(descs, stride, i).overlaps(descAt(descs, stride, i + 1)))
+            return i;
+    return count;
+}
+
+#if defined(__x86_64__)
+
+/*** AVX2, 4 descriptors at a time ***/
+
+__attribute__((target("avx2")))
+size_t lenMismatchAvx2(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs, size_t count) {
+    // Words of 4 descriptors holding len, in each of the 3 vectors they span
+    const __m256i m0 = _mm256_set_epi64x(0, 0, -1, 0);
+    const __m256i m1 = _mm256_set_epi64x(-1, 0, 0, -1);
+    const __m256i m2 = _mm256_set_epi64x(0, -1, 0, 0);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const __m256i *l = (const __m256i*) (lhs + i);
+        const __m256i *r = (const __m256i*) (rhs + i);
+        __m256i diff = _mm256_or_si256(
+            _mm256_and_si256(_mm256_xor_si256(_mm256_loadu_si256(l),
+                                              _mm256_loadu_si256(r)), m0),
+            _mm256_or_si256(
+                _mm256_and_si256(_mm256_xor_si256(_mm256_loadu_si256(l + 1),
+                                                  _mm256_loadu_si256(r + 1)), m1),
+                _mm256_and_si256(_mm256_xor_si256(_mm256_loadu_si256(l + 2),
+                                                  _mm256_loadu_si256(r + 2)), m2)));
+        if (!_mm256_testz_si256(diff, diff))
+            return lenMismatchScalar(lhs, rhs, i, i + 4);
+    }
+    return lenMismatchScalar(lhs, rhs, i, count);
+}
+
+__attribute__((target("avx2")))
+size_t coveredRunAvx2(const nixlBasicDesc *queries, size_t count, const nixlBasicDesc &base) {
+    const __m256i sign  = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i idx   = _mm256_set_epi64x(9, 6, 3, 0);
+    const __m256i start = _mm256_xor_si256(_mm256_set1_epi64x(base.addr), sign);
+    const __m256i end   = _mm256_xor_si256(_mm256_set1_epi64x(descEnd(base)), sign);
+    const __m256i dev   = _mm256_set1_epi64x(base.devId);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const long long *q = (const long long*) (queries + i);
+        __m256i addr  = _mm256_i64gather_epi64(q, idx, 8);
+        __m256i qend  = _mm256_add_epi64(addr, _mm256_i64gather_epi64(q + 1, idx, 8));
+        __m256i qdev  = _mm256_i64gather_epi64(q + 2, idx, 8);
+        // Saturated where the end wraps, below the start
+        qend = _mm256_or_si256(qend, _mm256_cmpgt_epi64(_mm256_xor_si256(addr, sign),
+                                                        _mm256_xor_si256(qend, sign)));
+        // Not covered if on another device, starting before or ending after base
+        __m256i out = _mm256_or_si256(
+            _mm256_xor_si256(_mm256_cmpeq_epi64(qdev, dev), _mm256_set1_epi64x(-1)),
+            _mm256_or_si256(_mm256_cmpgt_epi64(start, _mm256_xor_si256(addr, sign)),
+                            _mm256_cmpgt_epi64(_mm256_xor_si256(qend, sign), end)));
+        if (!_mm256_testz_si256(out, out))
+            return coveredRunScalar(queries, i, i + 4, base);
+    }
+    return coveredRunScalar(queries, i, count, base);
+}
+
+__attribute__((target("avx2")))
+size_t sortedOverlapAvx2(const nixlBasicDesc *descs, size_t count, size_t stride) {
+    // Words of 4 consecutive descriptors, and of the ones after them
+    const long long s = stride / sizeof(uint64_t);
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i idx  = _mm256_set_epi64x(3 * s, 2 * s, s, 0);
+    size_t i = 0;
+
+    for (; i + 5 <= count; i += 4) {
+        const long long *d = (const long long*) &descAt(descs, stride, i);
+        __m256i addr = _mm256_i64gather_epi64(d, idx, 8);
+        __m256i end  = _mm256_add_epi64(addr, _mm256_i64gather_epi64(d + 1, idx, 8));
+        // Same device and ending after the next start, wrapping as overlaps
+        // does, a superset of the overlapping pairs
+        __m256i cand = _mm256_and_si256(
+            _mm256_cmpeq_epi64(_mm256_i64gather_epi64(d + 2, idx, 8),
+                               _mm256_i64gather_epi64(d + s + 2, idx, 8)),
+            _mm256_cmpgt_epi64(_mm256_xor_si256(end, sign),
+                               _mm256_xor_si256(_mm256_i64gather_epi64(d + s, idx, 8), sign)));
+        if (!_mm256_testz_si256(cand, cand)) {
+            size_t found = sortedOverlapScalar(descs, i, i + 5, stride);
+            if (found < i + 5)
+                return found;
+        }
+    }
+    return sortedOverlapScalar(descs, i, count, stride);
+}
+
+/*** AVX-512, 8 descriptors at a time ***/
+
+__attribute__((target("avx512f")))
+size_t lenMismatchAvx512(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs, size_t count) {
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const uint64_t *l = (const uint64_t*) (lhs + i);
+        const uint64_t *r = (const uint64_t*) (rhs + i);
+        // len is in words 1, 4, 7, then 10, 13, then 16, 19, 22
+        if (_mm512_mask_cmpneq_epu64_mask(0x92, _mm512_loadu_si512(l),
+                                          _mm512_loadu_si512(r)) |
+            _mm512_mask_cmpneq_epu64_mask(0x24, _mm512_loadu_si512(l + 8),
+                                          _mm512_loadu_si512(r + 8)) |
+            _mm512_mask_cmpneq_epu64_mask(0x49, _mm512_loadu_si512(l + 16),
+                                          _mm512_loadu_si512(r + 16)))
+            return lenMismatchScalar(lhs, rhs, i, i + 8);
+    }
+    return lenMismatchAvx2(lhs + i, rhs + i, count - i) + i;
+}
+
+__attribute__((target("avx512f")))
+size_t coveredRunAvx512(const nixlBasicDesc *queries, size_t count, const nixlBasicDesc &base) {
+    const __m512i idx   = _mm512_set_epi64(21, 18, 15, 12, 9, 6, 3, 0);
+    const __m512i start = _mm512_set1_epi64(base.addr);
+    const __m512i end   = _mm512_set1_epi64(descEnd(base));
+    const __m512i dev   = _mm512_set1_epi64(base.devId);
+    const __m512i zero  = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const long long *q = (const long long*) (queries + i);
+        __m512i addr = _mm512_mask_i64gather_epi64(zero, 0xff, idx, q, 8);
+        __m512i qend = _mm512_add_epi64(addr, _mm512_mask_i64gather_epi64(zero, 0xff, idx, q + 1, 8));
+        qend = _mm512_mask_mov_epi64(qend, _mm512_cmplt_epu64_mask(qend, addr),
+                                     _mm512_set1_epi64(-1));
+        __mmask8 in  = _mm512_cmpeq_epu64_mask(_mm512_mask_i64gather_epi64(zero, 0xff, idx, q + 2, 8), dev) &
+                       _mm512_cmpge_epu64_mask(addr, start) &
+                       _mm512_cmple_epu64_mask(qend, end);
+        if (in != 0xff)
+            return coveredRunScalar(queries, i, i + 8, base);
+    }
+    return coveredRunAvx2(queries + i, count - i, base) + i;
+}
+
+__attribute__((target("avx512f")))
+size_t sortedOverlapAvx512(const nixlBasicDesc *descs, size_t count, size_t stride) {
+    const long long s = stride / sizeof(uint64_t);
+    const __m512i idx  = _mm512_set_epi64(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+    const __m512i zero = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 9 <= count; i += 8) {
+        const long long *d = (const long long*) &descAt(descs, stride, i);
+        __m512i addr = _mm512_mask_i64gather_epi64(zero, 0xff, idx, d, 8);
+        __m512i end  = _mm512_add_epi64(addr, _mm512_mask_i64gather_epi64(zero, 0xff, idx, d + 1, 8));
+        __mmask8 cand = _mm512_cmpeq_epu64_mask(_mm512_mask_i64gather_epi64(zero, 0xff, idx, d + 2, 8),
+                                                _mm512_mask_i64gather_epi64(zero, 0xff, idx, d + s + 2, 8)) &
+                        _mm512_cmpgt_epu64_mask(end, _mm512_mask_i64gather_epi64(zero, 0xff, idx, d + s, 8));
+        if (cand) {
+            size_t found = sortedOverlapScalar(descs, i, i + 9, stride);
+            if (found < i + 9)
+                return found;
+        }
+    }
+    return sortedOverlapAvx2((const nixlBasicDesc*) &descAt(descs, stride, i),
+                             count - i, stride) + i;
+}
+
+#elif defined(__aarch64__)
+
+/*** NEON, 2 descriptors at a time, split into their members by vld3 ***/
+
+size_t lenMismatchNeon(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs, size_t count) {
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        uint64x2x3_t l = vld3q_u64((const uint64_t*) (lhs + i));
+        uint64x2x3_t r = vld3q_u64((const uint64_t*) (rhs + i));
+        if (vminvq_u32(vreinterpretq_u32_u64(vceqq_u64(l.val[1], r.val[1]))) == 0)
+            return lenMismatchScalar(lhs, rhs, i, i + 2);
+    }
+    return lenMismatchScalar(lhs, rhs, i, count);
+}
+
+size_t coveredRunNeon(const nixlBasicDesc *queries, size_t count, const nixlBasicDesc &base) {
+    const uint64x2_t start = vdupq_n_u64(base.addr);
+    const uint64x2_t end   = vdupq_n_u64(descEnd(base));
+    const uint64x2_t dev   = vdupq_n_u64(base.devId);
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        uint64x2x3_t q = vld3q_u64((const uint64_t*) (queries + i));
+        uint64x2_t qend = vaddq_u64(q.val[0], q.val[1]);
+        qend = vorrq_u64(qend, vcltq_u64(qend, q.val[0]));
+        uint64x2_t in  = vandq_u64(vceqq_u64(q.val[2], dev),
+                                   vandq_u64(vcgeq_u64(q.val[0], start),
+                                             vcleq_u64(qend, end)));
+        if (vminvq_u32(vreinterpretq_u32_u64(in)) == 0)
+            return coveredRunScalar(queries, i, i + 2, base);
+    }
+    return coveredRunScalar(queries, i, count, base);
+}
+
+// Only for nixlBasicDesc arrays, whose members vld3 splits
+size_t sortedOverlapNeon(const nixlBasicDesc *descs, size_t count, size_t stride) {
+    if (stride != sizeof(nixlBasicDesc))
+        return sortedOverlapScalar(descs, 0, count, stride);
+    size_t i = 0;
+
+    for (; i + 3 <= count; i += 2) {
+        uint64x2x3_t d = vld3q_u64((const uint64_t*) (descs + i));
+        uint64x2x3_t n = vld3q_u64((const uint64_t*) (descs + i + 1));
+        uint64x2_t cand = vandq_u64(vceqq_u64(d.val[2], n.val[2]),
+                                    vcgtq_u64(vaddq_u64(d.val[0], d.val[1]), n.val[0]));
+        if (vmaxvq_u32(vreinterpretq_u32_u64(cand)) != 0) {
+            size_t found = sortedOverlapScalar(descs, i, i + 3, stride);
+            if (found < i + 3)
+                return found;
+        }
+    }
+    return sortedOverlapScalar(descs, i, count, stride);
+}
+
+#endif
+
+/*** Selection of the versions, once per process ***/
+
+typedef size_t (*len_mismatch_fn_t)(const nixlBasicDesc*, const nixlBasicDesc*, size_t);
+typedef size_t (*covered_run_fn_t)(const nixlBasicDesc*, size_t, const nixlBasicDesc&);
+typedef size_t (*sorted_overlap_fn_t)(const nixlBasicDesc*, size_t, size_t);
+
+struct descKernels {
+    len_mismatch_fn_t   lenMismatch;
+    covered_run_fn_t    coveredRun;
+    sorted_overlap_fn_t sortedOverlap;
+};
+
+descKernels selectKernels() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {lenMismatchAvx512, coveredRunAvx512, sortedOverlapAvx512};
+    if (__builtin_cpu_supports("avx2"))
+        return {lenMismatchAvx2, coveredRunAvx2, sortedOverlapAvx2};
+#elif defined(__aarch64__)
+    return {lenMismatchNeon, coveredRunNeon, sortedOverlapNeon};
+#endif
+    return {[](const nixlBasicDesc *lhs, const nixlBasicDesc *rhs, size_t count) {
+                return lenMismatchScalar(lhs, rhs, 0, count); },
+            [](const nixlBasicDesc *queries, size_t count, const nixlBasicDesc &base) {
+                return coveredRunScalar(queries, 0, count, base); },
+            [](const nixlBasicDesc *descs, size_t count, size_t stride) {
+                return sortedOverlapScalar(descs, 0, count, stride); }};
+}
+
+const descKernels kernels = selectKernels();
+
+}
+
+size_t nixlDescLenMismatch(const nixlBasicDesc *lhs, const nixlBasicDesc *rhs,
+                           size_t count) {
+    return kernels.lenMismatch(lhs, rhs, count);
+}
+
+size_t nixlDescCoveredRun(const nixlBasicDesc *queries, size_t count,
+                          const nixlBasicDesc &base) {
+    return kernels.coveredRun(queries, count, base);
+}
+
+size_t nixlDescSortedOverlap(const nixlBasicDesc *descs, size_t count,
+                             size_t stride) {
+    return kernels.sortedOverlap(descs, count, stride);
+}
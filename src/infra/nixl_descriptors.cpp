@@ -21,6 +21,7 @@
 #include "nixl.h"
 #include "nixl_descriptors.h"
 #include "mem_section.h"
+#include "desc_kernels.h"
 #include "backend/backend_aux.h"
 #include "serdes/serdes.h"
 
@@ -145,8 +146,8 @@ void nixlBlobDesc::print(const std::string &suffix) const {
 // The template is used to select from nixlBasicDesc/nixlMetaDesc/nixlBlobDesc
 // There are no virtual functions, so the object is all data, no pointers.
 
-template <class T>
-nixlDescList<T>::nixlDescList (const nixl_mem_t &type,
+template <class T, size_t N>
+nixlDescList<T, N>::nixlDescList (const nixl_mem_t &type,
                                const bool &sorted,
                                const int &init_size) {
     static_assert (std::is_base_of<nixlBasicDesc, T>::value);
@@ -155,14 +156,61 @@ nixlDescList<T>::nixlDescList (const nixl_mem_t &type,
     this->descs.resize(init_size);
 }
 
+namespace {
+// Packed lists are a sequence of unsigned LEB128 varints per descriptor: the
+// zigzag delta of devId, the zigzag delta of addr to the end of the previous
+// descriptor of the same devId, len, and the size of the metadata blob
+// followed by the blob. Packed lists without blobs are runs of descriptors
+// with the same devId and len: the zigzag delta of devId, len and the run
+// length, followed by the zigzag delta of addr of each descriptor, so
+// contiguous blocks take a byte each.
+void packVarint(std::string &out, uint64_t val) {
+    while (val >= 0x80) {
+        out.push_back((char) ((val & 0x7f) | 0x80));
+        val >>= 7;
+    }
+    out.push_back((char) val);
+}
+
+bool unpackVarint(std::string_view &in, uint64_t &val) {
+    val = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in.empty())
+            return false;
+        uint8_t byte = in.front();
+        in.remove_prefix(1);
+        val |= (uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ (uint64_t) ((int64_t) delta >> 63);
+}
+
+inline uint64_t unzigzag(uint64_t val) {
+    return (val >> 1) ^ (~(val & 1) + 1);
+}
+
 template <class T>
-nixlDescList<T>::nixlDescList(nixlSerDes* deserializer) {
+inline const nixl_blob_t& descBlob(const T &desc) {
+    if constexpr (std::is_same<nixlSectionDesc, T>::value)
+        return desc.metaBlob;
+    else
+        return desc.metaInfo;
+}
+}
+
+template <class T, size_t N>
+nixlDescList<T, N>::nixlDescList(nixlSerDes* deserializer) {
     size_t n_desc;
-    std::string str;
+    std::string_view str;
 
     descs.clear();
 
-    str = deserializer->getStr("nixlDList"); // Object type
+    str = deserializer->getStrView("nixlDList"); // Object type
     if (str.size()==0)
         return;
 
@@ -177,30 +225,88 @@ nixlDescList<T>::nixlDescList(nixlSerDes* deserializer) {
     if (deserializer->getBuf("n", &n_desc, sizeof(n_desc)))
         return;
 
-    if (std::is_same<nixlBasicDesc, T>::value) {
+    if (std::is_same<nixlBasicDesc, T>::value && (str=="nixlPBList")) {
+        std::string_view in = deserializer->getStrView("");
+        uint64_t dev_id = 0, end = 0, delta, len, run;
+        size_t i = 0;
+
+        // At least a byte per descriptor
+        if (n_desc > in.size())
+            return;
+        descs.resize(n_desc);
+        while (i < n_desc) {
+            if (!unpackVarint(in, delta) || !unpackVarint(in, len) ||
+                !unpackVarint(in, run) || (run == 0) || (run > n_desc - i))
+                break;
+            if (delta)
+                end = 0;
+            dev_id += unzigzag(delta);
+            for (; run > 0; --run, ++i) {
+                if (!unpackVarint(in, delta))
+                    break;
+                descs[i].devId = dev_id;
+                descs[i].addr  = end + unzigzag(delta);
+                descs[i].len   = len;
+                end = descs[i].addr + len;
+            }
+            if (run > 0)
+                break;
+        }
+        if ((i < n_desc) || !in.empty())
+            descs.clear();
+
+    } else if (std::is_same<nixlBasicDesc, T>::value) {
         // Contiguous in memory, so no need for per elm deserialization
         if (str!="nixlBDList")
             return;
-        str = deserializer->getStr("");
+        str = deserializer->getStrView("");
         if (str.size()!= n_desc * sizeof(nixlBasicDesc))
             return;
         // If size is proper, deserializer cannot fail
         descs.resize(n_desc);
-        str.copy(reinterpret_cast<char*>(descs.data()), str.size());
+        memcpy(reinterpret_cast<char*>(descs.data()), str.data(), str.size());
 
+    } else if (std::is_same<nixlBlobDesc, T>::value && (str=="nixlPDList")) {
+        if constexpr (std::is_same<nixlBlobDesc, T>::value) {
+            std::string_view in = deserializer->getStrView("");
+            uint64_t dev_id = 0, end = 0, delta, len, blob_len;
+
+            // At least 4 bytes per descriptor
+            if (n_desc > in.size() / 4)
+                return;
+            descs.resize(n_desc);
+            for (auto & elm : descs) {
+                if (!unpackVarint(in, delta))
+                    break;
+                if (delta)
+                    end = 0;
+                dev_id += unzigzag(delta);
+                if (!unpackVarint(in, delta) || !unpackVarint(in, len) ||
+                    !unpackVarint(in, blob_len) || (blob_len > in.size()))
+                    break;
+                elm.devId = dev_id;
+                elm.addr  = end + unzigzag(delta);
+                elm.len   = len;
+                elm.metaInfo.assign(in.data(), blob_len);
+                in.remove_prefix(blob_len);
+                end = elm.addr + elm.len;
+                n_desc--;
+            }
+            if (n_desc || !in.empty())
+                descs.clear();
+        }
     } else if (std::is_same<nixlBlobDesc, T>::value) {
         if (str!="nixlSDList")
             return;
         for (size_t i=0; i<n_desc; ++i) {
-            str = deserializer->getStr("");
+            str = deserializer->getStrView("");
             // If size is proper, deserializer cannot fail
             // Allowing empty strings, might change later
             if (str.size() < sizeof(nixlBasicDesc)) {
                 descs.clear();
                 return;
             }
-            T elm(str);
-            descs.push_back(elm);
+            descs.emplace_back(nixl_blob_t(str));
         }
     } else {
         return; // Unknown type, error
@@ -208,8 +314,8 @@ nixlDescList<T>::nixlDescList(nixlSerDes* deserializer) {
 }
 
 // Getter
-template <class T>
-inline const T& nixlDescList<T>::operator[](unsigned int index) const {
+template <class T, size_t N>
+inline const T& nixlDescList<T, N>::operator[](unsigned int index) const {
     // To be added only in debug mode
     // if (index >= descs.size())
     //     throw std::out_of_range("Index is out of range");
@@ -217,8 +323,8 @@ inline const T& nixlDescList<T>::operator[](unsigned int index) const {
 }
 
 // Setter
-template <class T>
-inline T& nixlDescList<T>::operator[](unsigned int index) {
+template <class T, size_t N>
+inline T& nixlDescList<T, N>::operator[](unsigned int index) {
     // To be added only in debug mode
     // if (index >= descs.size())
     //     throw std::out_of_range("Index is out of range");
@@ -226,8 +332,8 @@ inline T& nixlDescList<T>::operator[](unsigned int index) {
     return descs[index];
 }
 
-template <class T>
-void nixlDescList<T>::addDesc (const T &desc) {
+template <class T, size_t N>
+void nixlDescList<T, N>::addDesc (const T &desc) {
     if (!sorted) {
         descs.push_back(desc);
     } else {
@@ -240,8 +346,38 @@ void nixlDescList<T>::addDesc (const T &desc) {
     }
 }
 
-template <class T>
-bool nixlDescList<T>::overlaps (const T &desc, int &index) const {
+template <class T, size_t N>
+void nixlDescList<T, N>::mergeAppended (const size_t &start) {
+    auto middle = descs.begin() + start;
+    // Stable, so equal descriptors stay after the ones already in the list
+    if (!std::is_sorted(middle, descs.end()))
+        std::stable_sort(middle, descs.end());
+    if ((start > 0) && (middle != descs.end()) && (*middle < *(middle - 1)))
+        std::inplace_merge(descs.begin(), middle, descs.end());
+}
+
+template <class T, size_t N>
+void nixlDescList<T, N>::addStridedDesc (const nixlStridedDesc &desc) {
+    if (desc.count == 0)
+        return;
+
+    descs.reserve(descs.size() + desc.count);
+    // With a stride of 0 or more the blocks are in order among themselves
+    if (!sorted || descs.empty() || !(desc.block(0) < descs[descs.size() - 1])) {
+        for (size_t i = 0; i < desc.count; ++i) {
+            nixlBasicDesc block = desc.block(i);
+            descs.push_back(T(block.addr, block.len, block.devId));
+        }
+    } else {
+        for (size_t i = 0; i < desc.count; ++i) {
+            nixlBasicDesc block = desc.block(i);
+            addDesc(T(block.addr, block.len, block.devId));
+        }
+    }
+}
+
+template <class T, size_t N>
+bool nixlDescList<T, N>::overlaps (const T &desc, int &index) const {
     if (!sorted) {
         for (size_t i=0; i<descs.size(); ++i) {
             if (descs[i].overlaps(desc)) {
@@ -265,42 +401,63 @@ bool nixlDescList<T>::overlaps (const T &desc, int &index) const {
     }
 }
 
-template <class T>
-bool nixlDescList<T>::hasOverlaps () const {
+template <class T, size_t N>
+bool nixlDescList<T, N>::hasOverlaps () const {
     if ((descs.size()==0) || (descs.size()==1))
         return false;
 
     if (!sorted) {
-        for (size_t i=0; i<descs.size()-1; ++i)
-            for (size_t j=i+1; j<descs.size(); ++j)
-                if (descs[i].overlaps(descs[j]))
-                    return true;
-    } else {
-        for (size_t i=0; i<descs.size()-1; ++i)
-            if (descs[i].overlaps(descs[i+1]))
-                return true;
+        // Sorted copy of the basic descs, where an overlap is between neighbors
+        std::vector<nixlBasicDesc> basic(descs.begin(), descs.end());
+        std::sort(basic.begin(), basic.end());
+        return nixlDescSortedOverlap(basic.data(), basic.size(),
+                                     sizeof(nixlBasicDesc)) < basic.size();
     }
 
-    return false;
+    // Read in place, descriptors of derived types are sizeof(T) apart
+    static_assert(sizeof(T) % sizeof(uint64_t) == 0);
+    return nixlDescSortedOverlap(&descs[0], descs.size(), sizeof(T)) < descs.size();
 }
 
-template <class T>
-void nixlDescList<T>::remDesc (const int &index){
+template <class T, size_t N>
+void nixlDescList<T, N>::remDesc (const int &index){
     if (((size_t) index >= descs.size()) || (index < 0))
         throw std::out_of_range("Index is out of range");
     descs.erase(descs.begin() + index);
 }
 
-template <class T>
-void nixlDescList<T>::resize (const size_t &count) {
+template <class T, size_t N>
+void nixlDescList<T, N>::remDescs (std::vector<int> indices) {
+    if (indices.empty())
+        return;
+
+    std::sort(indices.begin(), indices.end());
+    if ((indices.front() < 0) || ((size_t) indices.back() >= descs.size()))
+        throw std::out_of_range("Index is out of range");
+
+    size_t j = indices.front(), k = 0;
+    for (size_t i = j; i < descs.size(); ++i) {
+        while ((k < indices.size()) && ((size_t) indices[k] < i))
+            k++;
+        if ((k < indices.size()) && ((size_t) indices[k] == i))
+            continue;
+        if (i != j)
+            descs[j] = std::move(descs[i]);
+        j++;
+    }
+    descs.resize(j);
+}
+
+template <class T, size_t N>
+void nixlDescList<T, N>::resize (const size_t &count) {
     // To be added only in debug mode
     // if (count > descs.size())
     //     sorted = false;
     descs.resize(count);
 }
 
-template <class T>
-bool nixlDescList<T>::verifySorted() {
+template <class T, size_t N>
+bool nixlDescList<T, N>::verifySorted() {
     int size = (int) descs.size();
     if (size==0) {
         return false;
@@ -319,10 +476,10 @@ bool nixlDescList<T>::verifySorted() {
     return true;
 }
 
-template <class T>
-nixlDescList<nixlBasicDesc> nixlDescList<T>::trim() const {
+template <class T, size_t N>
+nixlDescList<nixlBasicDesc> nixlDescList<T, N>::trim() const {
 
-    if constexpr (std::is_same<nixlBasicDesc, T>::value) {
+    if constexpr (std::is_same<nixlDescList<nixlBasicDesc>, nixlDescList<T, N>>::value) {
         return *this;
     } else {
         nixlDescList<nixlBasicDesc> trimmed(type, sorted);
@@ -338,8 +495,8 @@ nixlDescList<nixlBasicDesc> nixlDescList<T>::trim() const {
     }
 }
 
-template <class T>
-int nixlDescList<T>::getIndex(const nixlBasicDesc &query) const {
+template <class T, size_t N>
+int nixlDescList<T, N>::getIndex(const nixlBasicDesc &query) const {
     if (!sorted) {
         auto itr = std::find(descs.begin(), descs.end(), query);
         if (itr == descs.end())
@@ -356,8 +513,8 @@ int nixlDescList<T>::getIndex(const nixlBasicDesc &query) const {
     return NIXL_ERR_NOT_FOUND;
 }
 
-template <class T>
-nixl_status_t nixlDescList<T>::serialize(nixlSerDes* serializer) const {
+template <class T, size_t N>
+nixl_status_t nixlDescList<T, N>::serialize(nixlSerDes* serializer, const bool &packed) const {
 
     nixl_status_t ret;
     size_t n_desc = descs.size();
@@ -369,10 +526,10 @@ nixl_status_t nixlDescList<T>::serialize(nixlSerDes* serializer) const {
     // For now very few descriptor types, if needed can add a name method to each
     // descriptor. std::string_view(typeid(T).name()) is compiler dependent
     if (std::is_same<nixlBasicDesc, T>::value)
-        ret = serializer->addStr("nixlDList", "nixlBDList");
+        ret = serializer->addStr("nixlDList", packed ? "nixlPBList" : "nixlBDList");
     // We serialize SectionDesc the same as BlobDesc so it will be deserialized as BlobDesc on the other side
     else if (std::is_same<nixlBlobDesc, T>::value || std::is_same<nixlSectionDesc, T>::value)
-        ret = serializer->addStr("nixlDList", "nixlSDList");
+        ret = serializer->addStr("nixlDList", packed ? "nixlPDList" : "nixlSDList");
     else
         return NIXL_ERR_INVALID_PARAM;
 
@@ -390,13 +547,61 @@ nixl_status_t nixlDescList<T>::serialize(nixlSerDes* serializer) const {
     if (n_desc==0)
         return NIXL_SUCCESS; // Unusual, but supporting it
 
-    // Optimization for nixlBasicDesc,
-    // contiguous in memory, so no need for per elm serialization
-    if (std::is_same<nixlBasicDesc, T>::value) {
+    if (std::is_same<nixlBasicDesc, T>::value && packed) {
+        std::string out;
+        uint64_t dev_id = 0, end = 0;
+        size_t i = 0;
+
+        out.reserve(n_desc + 16);
+        while (i < n_desc) {
+            const T &first = descs[i];
+            size_t run = 1;
+            while ((i + run < n_desc) && (descs[i + run].devId == first.devId) &&
+                   (descs[i + run].len == first.len))
+                run++;
+            if (first.devId != dev_id)
+                end = 0;
+            packVarint(out, zigzag(first.devId - dev_id));
+            packVarint(out, first.len);
+            packVarint(out, run);
+            for (size_t k = i; k < i + run; ++k) {
+                packVarint(out, zigzag(descs[k].addr - end));
+                end = descs[k].addr + descs[k].len;
+            }
+            dev_id = first.devId;
+            i += run;
+        }
+        ret = serializer->addStr("", out);
+        if (ret) return ret;
+    } else if (std::is_same<nixlBasicDesc, T>::value) {
+        // Optimization for nixlBasicDesc,
+        // contiguous in memory, so no need for per elm serialization
         ret = serializer->addStr("", std::string(
                                  reinterpret_cast<const char*>(descs.data()),
                                  n_desc * sizeof(nixlBasicDesc)));
         if (ret) return ret;
+    } else if (packed) {
+        if constexpr (std::is_same<nixlBlobDesc, T>::value ||
+                      std::is_same<nixlSectionDesc, T>::value) {
+            std::string out;
+            uint64_t dev_id = 0, end = 0;
+
+            out.reserve(n_desc * 8);
+            for (auto & elm : descs) {
+                const nixl_blob_t &blob = descBlob(elm);
+                if (elm.devId != dev_id)
+                    end = 0;
+                packVarint(out, zigzag(elm.devId - dev_id));
+                packVarint(out, zigzag(elm.addr - end));
+                packVarint(out, elm.len);
+                packVarint(out, blob.size());
+                out.append(blob);
+                dev_id = elm.devId;
+                end    = elm.addr + elm.len;
+            }
+            ret = serializer->addStr("", out);
+            if (ret) return ret;
+        }
     } else { // already checked it can be only nixlBlobDesc or nixlSectionDesc
         for (auto & elm : descs) {
             ret = serializer->addStr("", elm.serialize());
@@ -407,8 +612,8 @@ nixl_status_t nixlDescList<T>::serialize(nixlSerDes* serializer) const {
     return NIXL_SUCCESS;
 }
 
-template <class T>
-void nixlDescList<T>::print() const {
+template <class T, size_t N>
+void nixlDescList<T, N>::print() const {
     std::cout << "LOG: DescList of mem type " << type
               << (sorted ? "sorted" : "unsorted") << "\n";
     for (auto & elm : descs) {
@@ -417,8 +622,8 @@ void nixlDescList<T>::print() const {
     }
 }
 
-template <class T>
-bool operator==(const nixlDescList<T> &lhs, const nixlDescList<T> &rhs) {
+template <class T, size_t N>
+bool operator==(const nixlDescList<T, N> &lhs, const nixlDescList<T, N> &rhs) {
     if ((lhs.getType()       != rhs.getType())       ||
         (lhs.descCount()     != rhs.descCount())     ||
         (lhs.isSorted()      != rhs.isSorted()))
@@ -14,14 +14,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
 #include <map>
+#include <set>
 #include <iostream>
+#include <system_error>
+#include <thread>
+#include <algorithm>
+#include <iterator>
 #include "nixl.h"
 #include "nixl_descriptors.h"
 #include "mem_section.h"
+#include "desc_kernels.h"
 #include "backend/backend_engine.h"
 #include "nixl_types.h"
 #include "serdes/serdes.h"
+#include "common/nixl_trace.h"
 
 /*** Class nixlMemSection implementation ***/
 
@@ -35,9 +43,103 @@ backend_set_t* nixlMemSection::queryBackends (const nixl_mem_t &mem) {
         return &memToBackend[mem];
 }
 
+// End of a descriptor, saturated for the unbounded file segments
+static inline uintptr_t descEnd (const nixlBasicDesc &desc) {
+    return (desc.len > UINTPTR_MAX - desc.addr) ? UINTPTR_MAX : desc.addr + desc.len;
+}
+
+// Section lists keep a max tree of the descriptor end addresses in maxEnd,
+// in the layout of an iterative segment tree: node k < N is list[k].maxEnd,
+// with children 2k and 2k+1, and leaf N+i is the end of list[i]. Rebuilt in
+// O(N) after a list changes, like the insertion into the list itself.
+static inline uintptr_t maxEndNode (const nixl_sec_dlist_t &list, int node) {
+    int count = list.descCount();
+    return (node >= count) ? descEnd(list[node - count]) : list[node].maxEnd;
+}
+
+static void updateMaxEnds (nixl_sec_dlist_t &list) {
+    for (int k = list.descCount() - 1; k > 0; --k)
+        list[k].maxEnd = std::max(maxEndNode(list, 2 * k), maxEndNode(list, 2 * k + 1));
+}
+
+// Last index in [lo, hi) of a descriptor ending at or after end, or -1,
+// in O(log N)
+static int lastEndingAfter (const nixl_sec_dlist_t &list, int lo, int hi,
+                            uintptr_t end) {
+    int count = list.descCount();
+    // Nodes covering the range, from its right side in order, and from
+    // its left side in reverse order
+    int right[64], left[64];
+    int n_right = 0, n_left = 0;
+
+    for (lo += count, hi += count; lo < hi; lo >>= 1, hi >>= 1) {
+        if (lo & 1)
+            left[n_left++] = lo++;
+        if (hi & 1)
+            right[n_right++] = --hi;
+    }
+
+    int node = -1;
+    for (int i = 0; (i < n_right) && (node < 0); ++i)
+        if (maxEndNode(list, right[i]) >= end)
+            node = right[i];
+    for (int i = n_left - 1; (i >= 0) && (node < 0); --i)
+        if (maxEndNode(list, left[i]) >= end)
+            node = left[i];
+    if (node < 0)
+        return -1;
+
+    while (node < count)
+        node = (maxEndNode(list, 2 * node + 1) >= end) ? 2 * node + 1 : 2 * node;
+    return node - count;
+}
+
+// First index of the descriptors of a device in a sorted section list
+static inline int devStart (const nixl_sec_dlist_t &list, const uint64_t &dev_id) {
+    nixlBasicDesc first(0, 0, dev_id);
+    return std::lower_bound(list.begin(), list.end(), first) - list.begin();
+}
+
+// Section lists are kept sorted by (devId, addr, len), so the candidates to
+// cover a query descriptor are the first element not less than it and the
+// ones of the same devId before it, which all start at or before it. Of
+// those, one covers it if it ends at or after the query end, found with the
+// max tree in O(log N) even when registrations are nested.
+// When hint is set, the search starts from it, so sorted queries only
+// look at the part of the list after the previous match.
+typedef nixl_sec_dlist_t::const_iterator sec_desc_iter_t;
+
+static inline sec_desc_iter_t findCovering (const nixl_sec_dlist_t &base,
+                                            const nixlBasicDesc &query,
+                                            sec_desc_iter_t hint) {
+
+    auto itr = std::lower_bound(hint, base.end(), query);
+
+    // Same start address case
+    if ((itr != base.end()) && itr->covers(query))
+        return itr;
+
+    // query starts later, usually within the previous entry
+    if (itr == base.begin())
+        return base.end();
+    auto prev = std::prev(itr, 1);
+    if (prev->covers(query))
+        return prev;
+    if (prev->devId != query.devId)
+        return base.end();
+
+    int hi  = itr - base.begin();
+    int idx = lastEndingAfter(base, devStart(base, query.devId), hi, descEnd(query));
+    if ((idx >= 0) && base[idx].covers(query))
+        return base.begin() + idx;
+
+    return base.end();
+}
+
 nixl_status_t nixlMemSection::populate (const nixl_xfer_dlist_t &query,
                                         nixlBackendEngine* backend,
                                         nixl_meta_dlist_t &resp) const {
+    NIXL_TRACE_SPAN("populate");
 
     if (query.getType() != resp.getType())
         return NIXL_ERR_INVALID_PARAM;
@@ -51,9 +153,10 @@ nixl_status_t nixlMemSection::populate (const nixl_xfer_dlist_t &query,
         return NIXL_ERR_NOT_FOUND;
 
     nixlBasicDesc *p;
-    nixl_sec_dlist_t* base = it->second;
+    const nixl_sec_dlist_t* base = it->second;
     resp.resize(query.descCount());
 
+    // Sections are always created sorted, kept as a fallback
     if (!base->isSorted()) {
         int count = 0;
         for (int i=0; i<query.descCount(); ++i)
@@ -72,106 +175,60 @@ nixl_status_t nixlMemSection::populate (const nixl_xfer_dlist_t &query,
             resp.clear();
             return NIXL_ERR_UNKNOWN;
         }
-    } else {
-        const nixlBasicDesc *q;
-        bool found, q_sorted = query.isSorted();
-
-        if (q_sorted) {
-            int s_index, q_index, size;
-            const nixlSectionDesc *s;
-
-            size = base->descCount();
-            s_index = 0;
-            q_index = 0;
-
-            while (q_index<query.descCount()){
-                s = &(*base)[s_index];
-                q = &query[q_index];
-                if (s->covers(*q)) {
-                    p = &resp[q_index];
-                    *p = *q;
-                    resp[q_index].metadataP = s->metadataP;
-                    q_index++;
-                } else {
-                    s_index++;
-                    // TODO: add early termination if already (*q < *s),
-                    // but s was not properly covering q
-                    if (s_index==size) {
-                        resp.clear();
-                        return NIXL_ERR_UNKNOWN;
-                    }
-                }
-            }
+    }
 
-            // To be added only in debug mode
-            // resp.verifySorted();
-            return NIXL_SUCCESS;
+    // O(log N) search per query descriptor. For a sorted query the
+    // matches are monotonic, so the search window shrinks as we go.
+    bool q_sorted = query.isSorted();
+    auto hint = base->begin();
 
-        } else {
-            int last_found = 0;
-            for (int i=0; i<query.descCount(); ++i) {
-                found = false;
-                q = &query[i];
-                auto itr = std::lower_bound(base->begin() + last_found,
-                                            base->end(), *q);
-
-                // Same start address case
-                if (itr != base->end()){
-                    if (itr->covers(*q)) {
-                        found = true;
-                    }
-                }
+    for (int i=0; i<query.descCount(); ++i) {
+        const nixlBasicDesc &q = query[i];
+        auto itr = findCovering(*base, q, q_sorted ? hint : base->begin());
 
-                // query starts starts later, try previous entry
-                if ((!found) && (itr != base->begin())){
-                    itr = std::prev(itr , 1);
-                    if (itr->covers(*q)) {
-                        found = true;
-                    }
-                }
+        if (itr == base->end()) {
+            resp.clear();
+            return NIXL_ERR_UNKNOWN;
+        }
 
-                if (found) {
-                    p = &resp[i];
-                    *p = *q;
-                    resp[i].metadataP = itr->metadataP;
-                } else {
-                    resp.clear();
-                    return NIXL_ERR_UNKNOWN;
-                }
-            }
-            return NIXL_SUCCESS;
+        p = &resp[i];
+        *p = q;
+        resp[i].metadataP = itr->metadataP;
+        if (q_sorted)
+            hint = itr;
+
+        // The next queries are often in the same registered region, found
+        // without searching again
+        size_t run = nixlDescCoveredRun(&q + 1, query.descCount() - i - 1, *itr);
+        for (size_t j = 0; j < run; ++j) {
+            ++i;
+            p = &resp[i];
+            *p = query[i];
+            resp[i].metadataP = itr->metadataP;
         }
     }
+
+    // To be added only in debug mode
+    // resp.verifySorted();
+    return NIXL_SUCCESS;
 }
 
 /*** Class nixlLocalSection implementation ***/
 
 // Calls into backend engine to register the memories in the desc list
-nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
-                                             nixlBackendEngine* backend,
-                                             nixl_sec_dlist_t &remote_self) {
-
-    if (!backend)
-        return NIXL_ERR_INVALID_PARAM;
-    // Find the MetaDesc list, or add it to the map
-    nixl_mem_t     nixl_mem     = mem_elms.getType();
-    section_key_t  sec_key      = std::make_pair(nixl_mem, backend);
-
-    auto it = sectionMap.find(sec_key);
-    if (it==sectionMap.end()) { // New desc list
-        sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
-        memToBackend[nixl_mem].insert(backend);
-    }
-    nixl_sec_dlist_t *target = sectionMap[sec_key];
-
-    // Add entries to the target list
+nixl_status_t nixlLocalSection::regRange (const nixl_reg_dlist_t &mem_elms,
+                                          const int &start, const int &end,
+                                          nixlBackendEngine* backend,
+                                          nixl_sec_dlist_t &added,
+                                          nixl_sec_dlist_t &remote_self) {
+    nixl_mem_t      nixl_mem = mem_elms.getType();
     nixlSectionDesc local_sec, self_sec;
-    nixlBasicDesc *lp = &local_sec;
-    nixlBasicDesc *rp = &self_sec;
-    nixl_status_t ret;
+    nixlBasicDesc   *lp = &local_sec;
+    nixlBasicDesc   *rp = &self_sec;
+    nixl_status_t   ret = NIXL_SUCCESS;
 
-    int i;
-    for (i = 0; i < mem_elms.descCount(); ++i) {
+    added.reserve(added.descCount() + end - start);
+    for (int i = start; i < end; ++i) {
         // TODO: For now trusting the user, but there can be a more checks mode
         //       where we find overlaps and split the memories or warn the user
         ret = backend->registerMem(mem_elms[i], nixl_mem, local_sec.metadataP);
@@ -202,7 +259,7 @@ nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
              (nixl_mem == FILE_SEG)) && (lp->len==0))
             lp->len = SIZE_MAX; // File has no range limit
 
-        target->addDesc(local_sec);
+        added.addDesc(local_sec);
 
         if (backend->supportsLocal()) {
             *rp = *lp;
@@ -210,25 +267,169 @@ nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
         }
     }
 
-    // Abort in case of error
+    // Abort in case of error, nothing was added to the target yet
     if (ret != NIXL_SUCCESS) {
-        for (int j = 0; j < i; ++j) {
-            int index = target->getIndex(mem_elms[j]);
-
-            if (backend->supportsLocal()) {
-                int self_index = remote_self.getIndex(mem_elms[j]);
-                // Should never be negative, as we just added it in previous loop
-                if (self_index >= 0 && remote_self[self_index].metadataP != (*target)[index].metadataP)
-                    backend->unloadMD(remote_self[self_index].metadataP);
+        unregDescs(backend, added, remote_self);
+        added.clear();
+        remote_self.clear();
+    }
+    return ret;
+}
+
+nixl_status_t nixlLocalSection::regDescs (const nixl_reg_dlist_t &mem_elms,
+                                          nixlBackendEngine* backend,
+                                          nixl_sec_dlist_t &added,
+                                          nixl_sec_dlist_t &remote_self,
+                                          const size_t &max_threads) {
+    int    count    = mem_elms.descCount();
+    size_t n_chunks = (count + NIXL_REG_CHUNK - 1) / NIXL_REG_CHUNK;
+    size_t n_threads = backend->supportsConcurrentReg() ?
+                       std::min(max_threads, n_chunks) : 1;
+
+    if (n_threads <= 1)
+        return regRange(mem_elms, 0, count, backend, added, remote_self);
+
+    // Each chunk into its own lists, so the threads don't share any
+    nixl_mem_t nixl_mem = mem_elms.getType();
+    std::vector<nixl_sec_dlist_t> chunk_added(n_chunks, nixl_sec_dlist_t(nixl_mem));
+    std::vector<nixl_sec_dlist_t> chunk_self(n_chunks, nixl_sec_dlist_t(nixl_mem, false));
+    std::vector<nixl_status_t>    rets(n_chunks, NIXL_ERR_NOT_POSTED);
+
+    std::atomic<size_t>        next_chunk(0);
+    std::atomic<nixl_status_t> status(NIXL_SUCCESS);
+    auto worker = [&]() {
+        size_t c;
+        while (((c = next_chunk++) < n_chunks) && (status == NIXL_SUCCESS)) {
+            int start = c * NIXL_REG_CHUNK;
+            int end   = std::min(count, start + NIXL_REG_CHUNK);
+            rets[c] = regRange(mem_elms, start, end, backend, chunk_added[c], chunk_self[c]);
+            if (rets[c] != NIXL_SUCCESS) {
+                nixl_status_t expected = NIXL_SUCCESS;
+                status.compare_exchange_strong(expected, rets[c]);
             }
-            backend->deregisterMem((*target)[index].metadataP);
-            target->remDesc(index);
         }
-        remote_self.clear();
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        for (size_t i = 1; i < n_threads; ++i)
+            threads.emplace_back(worker);
+    } catch (const std::system_error &e) {
+        // Fewer threads than asked for, the rest is registered by those running
+    }
+    worker();
+    for (auto & t : threads)
+        t.join();
+
+    // Failed chunks were undone already
+    if (status != NIXL_SUCCESS) {
+        for (size_t c = 0; c < n_chunks; ++c)
+            if (rets[c] == NIXL_SUCCESS)
+                unregDescs(backend, chunk_added[c], chunk_self[c]);
+        return status;
+    }
+
+    added.reserve(added.descCount() + count);
+    for (size_t c = 0; c < n_chunks; ++c) {
+        for (auto & elm : chunk_added[c])
+            added.addDesc(elm);
+        for (auto & elm : chunk_self[c])
+            remote_self.addDesc(elm);
+    }
+    return NIXL_SUCCESS;
+}
+
+void nixlLocalSection::unregDescs (nixlBackendEngine* backend,
+                                   const nixl_sec_dlist_t &added,
+                                   const nixl_sec_dlist_t &remote_self) {
+    for (int j = 0; j < added.descCount(); ++j) {
+        // Added in the same order as to remote_self, when the backend supports local
+        if (backend->supportsLocal() && remote_self[j].metadataP != added[j].metadataP)
+            backend->unloadMD(remote_self[j].metadataP);
+        backend->deregisterMem(added[j].metadataP);
     }
+}
+
+void nixlLocalSection::commitDescs (nixlBackendEngine* backend,
+                                    const nixl_sec_dlist_t &added) {
+    // Find the MetaDesc list, or add it to the map
+    nixl_mem_t    nixl_mem = added.getType();
+    section_key_t sec_key  = std::make_pair(nixl_mem, backend);
+
+    auto it = sectionMap.find(sec_key);
+    if (it==sectionMap.end()) { // New desc list
+        sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
+        memToBackend[nixl_mem].insert(backend);
+    }
+    nixl_sec_dlist_t *target = sectionMap[sec_key];
+
+    // Sorted and merged once, instead of inserting each descriptor
+    target->addDescs(added.begin(), added.end());
+    updateMaxEnds(*target);
+    addChanges(added, true, backend);
+}
+
+nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
+                                             nixlBackendEngine* backend,
+                                             nixl_sec_dlist_t &remote_self,
+                                             const size_t &max_threads) {
+
+    if (!backend)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_sec_dlist_t added(mem_elms.getType());
+    nixl_status_t ret = regDescs(mem_elms, backend, added, remote_self, max_threads);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    commitDescs(backend, added);
     return ret;
 }
 
+bool nixlLocalSection::hasOverlaps (const nixl_reg_dlist_t &mem_elms,
+                                    nixlBackendEngine* backend) const {
+    nixl_mem_t nixl_mem = mem_elms.getType();
+    std::vector<nixlBasicDesc> descs(mem_elms.begin(), mem_elms.end());
+
+    for (auto & desc : descs)
+        if (((nixl_mem == BLK_SEG) || (nixl_mem == OBJ_SEG) ||
+             (nixl_mem == FILE_SEG)) && (desc.len == 0))
+            desc.len = SIZE_MAX; // Registered with no range limit
+
+    // Among themselves, each one starting before the end of the earlier ones
+    std::sort(descs.begin(), descs.end());
+    uintptr_t max_end = 0;
+    for (size_t i = 0; i < descs.size(); ++i) {
+        if ((i > 0) && (descs[i].devId == descs[i-1].devId)) {
+            if (descs[i].addr < max_end)
+                return true;
+            max_end = std::max(max_end, descEnd(descs[i]));
+        } else {
+            max_end = descEnd(descs[i]);
+        }
+    }
+
+    auto it = sectionMap.find(std::make_pair(nixl_mem, backend));
+    if (it == sectionMap.end())
+        return false;
+    const nixl_sec_dlist_t &base = *it->second;
+
+    // With the registered ones, starting within the descriptor, or before
+    // it and ending after its start
+    for (auto & desc : descs) {
+        auto itr = std::lower_bound(base.begin(), base.end(), desc);
+        if ((itr != base.end()) && (itr->devId == desc.devId) && (itr->addr < descEnd(desc)))
+            return true;
+        if ((desc.addr < UINTPTR_MAX) && (itr != base.begin()) &&
+            (std::prev(itr, 1)->devId == desc.devId)) {
+            int hi = itr - base.begin();
+            if (lastEndingAfter(base, devStart(base, desc.devId), hi, desc.addr + 1) >= 0)
+                return true;
+        }
+    }
+    return false;
+}
+
 nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
                                              nixlBackendEngine *backend) {
     if (!backend)
@@ -242,18 +443,27 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
 
     // First check if the mem_elms are present in the list,
     // don't deregister anything in case any is missing.
+    std::vector<int> indices;
+    indices.reserve(mem_elms.descCount());
     for (auto & elm : mem_elms) {
         int index = target->getIndex(elm);
         if (index < 0)
             return NIXL_ERR_NOT_FOUND;
+        indices.push_back(index);
     }
 
-    for (auto & elm : mem_elms) {
-        int index = target->getIndex(elm);
-        // Already checked, elm should always be found. Can add a check in debug mode.
+    nixl_sec_dlist_t removed(nixl_mem);
+    removed.reserve(indices.size());
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    for (auto & index : indices) {
+        removed.addDesc((*target)[index]);
         backend->deregisterMem((*target)[index].metadataP);
-        target->remDesc(index);
     }
+    // Removed in one pass, instead of moving the rest for each descriptor
+    target->remDescs(std::move(indices));
+    updateMaxEnds(*target);
+    addChanges(removed, false, backend);
 
     if (target->descCount()==0) {
         delete target;
@@ -266,7 +476,8 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
 
 namespace {
 nixl_status_t serializeSections(nixlSerDes* serializer,
-                                const section_map_t &sections) {
+                                const section_map_t &sections,
+                                const bool &packed) {
     nixl_status_t ret;
 
     size_t seg_count = sections.size();
@@ -280,7 +491,7 @@ nixl_status_t serializeSections(nixlSerDes* serializer,
 
         ret = serializer->addStr("bknd", eng->getType());
         if (ret) return ret;
-        ret = dlist->serialize(serializer);
+        ret = dlist->serialize(serializer, packed);
         if (ret) return ret;
     }
 
@@ -288,20 +499,22 @@ nixl_status_t serializeSections(nixlSerDes* serializer,
 }
 };
 
-nixl_status_t nixlLocalSection::serialize(nixlSerDes* serializer) const {
-    return serializeSections(serializer, sectionMap);
+nixl_status_t nixlLocalSection::serialize(nixlSerDes* serializer,
+                                          const bool &packed) const {
+    return serializeSections(serializer, sectionMap, packed);
 }
 
 nixl_status_t nixlLocalSection::serializePartial(nixlSerDes* serializer,
                                                  const backend_set_t &backends,
-                                                 const nixl_reg_dlist_t &mem_elms) const {
+                                                 const nixl_reg_dlist_t &mem_elms,
+                                                 const bool &packed) const {
     nixl_mem_t nixl_mem = mem_elms.getType();
     nixl_status_t ret = NIXL_SUCCESS;
     section_map_t mem_elms_to_serialize;
 
     // If there are no descriptors to serialize, just serialize empty list of sections
     if (mem_elms.descCount() == 0)
-        return serializeSections(serializer, mem_elms_to_serialize);
+        return serializeSections(serializer, mem_elms_to_serialize, packed);
 
     // TODO: consider concatenating 2 serializers instead of using mem_elms_to_serialize
     for (const auto &backend : backends) {
@@ -328,13 +541,81 @@ nixl_status_t nixlLocalSection::serializePartial(nixlSerDes* serializer,
     }
 
     if (ret == NIXL_SUCCESS)
-        ret = serializeSections(serializer, mem_elms_to_serialize);
+        ret = serializeSections(serializer, mem_elms_to_serialize, packed);
 
     for (auto &[sec_key, m_desc] : mem_elms_to_serialize)
         delete m_desc;
     return ret;
 }
 
+void nixlLocalSection::addChanges (const nixl_sec_dlist_t &descs, bool added,
+                                   nixlBackendEngine* backend) {
+    version++;
+    if (!backend->supportsRemote())
+        return;
+
+    for (auto & elm : descs) {
+        nixlSectionChange change;
+        change.version = version;
+        change.added   = added;
+        change.backend = backend;
+        change.mem     = descs.getType();
+        change.desc    = nixlBlobDesc(elm, elm.metaBlob);
+        changes.push_back(change);
+    }
+
+    // Whole versions are dropped, older agents get the full metadata instead
+    while (changes.size() > NIXL_SECTION_MAX_CHANGES) {
+        deltaBase = changes.front().version;
+        while (!changes.empty() && changes.front().version == deltaBase)
+            changes.pop_front();
+    }
+}
+
+nixl_status_t nixlLocalSection::serializeDelta(nixlSerDes* serializer,
+                                               const uint64_t &since_version) const {
+    nixl_status_t ret;
+
+    if ((since_version < deltaBase) || (since_version > version))
+        return NIXL_ERR_NOT_FOUND;
+
+    ret = serializer->addBuf("From", &since_version, sizeof(since_version));
+    if (ret) return ret;
+    ret = serializer->addBuf("To", &version, sizeof(version));
+    if (ret) return ret;
+
+    auto first = std::partition_point(changes.begin(), changes.end(),
+                                      [&](const nixlSectionChange &change) {
+                                          return change.version <= since_version;
+                                      });
+
+    // Runs of changes of the same kind to one section, applied in order
+    std::vector<std::pair<const nixlSectionChange*, nixl_reg_dlist_t>> runs;
+    for (auto it = first; it != changes.end(); ++it) {
+        if (runs.empty() || (runs.back().first->added != it->added) ||
+            (runs.back().first->backend != it->backend) ||
+            (runs.back().first->mem != it->mem))
+            runs.emplace_back(&*it, nixl_reg_dlist_t(it->mem));
+        runs.back().second.addDesc(it->desc);
+    }
+
+    size_t run_count = runs.size();
+    ret = serializer->addBuf("nixlSecChgs", &run_count, sizeof(run_count));
+    if (ret) return ret;
+
+    for (const auto &[change, dlist] : runs) {
+        uint8_t added = change->added;
+        ret = serializer->addBuf("add", &added, sizeof(added));
+        if (ret) return ret;
+        ret = serializer->addStr("bknd", change->backend->getType());
+        if (ret) return ret;
+        ret = dlist.serialize(serializer);
+        if (ret) return ret;
+    }
+
+    return NIXL_SUCCESS;
+}
+
 nixlLocalSection::~nixlLocalSection() {
     for (auto &[sec_key, dlist] : sectionMap) {
         nixlBackendEngine* eng = sec_key.second;
@@ -345,6 +626,79 @@ nixlLocalSection::~nixlLocalSection() {
     // nixlMemSection destructor will clean up the rest
 }
 
+/*** Class nixlRemoteImport implementation ***/
+
+bool nixlRemoteImport::isConcurrent() const {
+    for (auto & eng : listEngines)
+        if (!eng->supportsConcurrentLoad())
+            return false;
+    return true;
+}
+
+nixl_status_t nixlRemoteImport::load(const size_t &max_threads) {
+    NIXL_TRACE_SPAN("loadRemoteDescs");
+    // Entries of a backend are contiguous, chunks never span two of them
+    std::stable_sort(entries.begin(), entries.end(),
+                     [this](const entry &a, const entry &b) {
+                         return listEngines[a.list] < listEngines[b.list];
+                     });
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t start = 0; start < entries.size(); ) {
+        nixlBackendEngine* eng = listEngines[entries[start].list];
+        size_t end = start + 1;
+        while ((end < entries.size()) && (listEngines[entries[end].list] == eng) &&
+               (!eng->supportsConcurrentLoad() || (end - start < NIXL_IMPORT_CHUNK)))
+            ++end;
+        chunks.emplace_back(start, end);
+        start = end;
+    }
+
+    std::atomic<size_t>        next_chunk(0);
+    std::atomic<nixl_status_t> status(NIXL_SUCCESS);
+    auto worker = [&]() {
+        size_t c;
+        while (((c = next_chunk++) < chunks.size()) && (status == NIXL_SUCCESS)) {
+            for (size_t i = chunks[c].first; i < chunks[c].second; ++i) {
+                const nixl_reg_dlist_t &list = lists[entries[i].list];
+                nixl_status_t ret = listEngines[entries[i].list]->loadRemoteMD(
+                                        list[entries[i].index], list.getType(),
+                                        agentName, entries[i].metadataP);
+                if (ret < 0) {
+                    entries[i].metadataP = nullptr;
+                    nixl_status_t expected = NIXL_SUCCESS;
+                    status.compare_exchange_strong(expected, ret);
+                    break;
+                }
+            }
+        }
+    };
+
+    size_t n_threads = std::min(max_threads, chunks.size());
+    std::vector<std::thread> threads;
+    try {
+        for (size_t i = 1; i < n_threads; ++i)
+            threads.emplace_back(worker);
+    } catch (const std::system_error &e) {
+        // Fewer threads than asked for, the rest is loaded by those running
+    }
+    worker();
+    for (auto & t : threads)
+        t.join();
+
+    if (status != NIXL_SUCCESS)
+        unload();
+    return status;
+}
+
+void nixlRemoteImport::unload() {
+    for (auto & elm : entries) {
+        if (elm.metadataP)
+            listEngines[elm.list]->unloadMD(elm.metadataP);
+        elm.metadataP = nullptr;
+    }
+}
+
 /*** Class nixlRemoteSection implementation ***/
 
 nixlRemoteSection::nixlRemoteSection (const std::string &agent_name) {
@@ -353,7 +707,8 @@ nixlRemoteSection::nixlRemoteSection (const std::string &agent_name) {
 
 nixl_status_t nixlRemoteSection::addDescList (
                                  const nixl_reg_dlist_t& mem_elms,
-                                 nixlBackendEngine* backend) {
+                                 nixlBackendEngine* backend,
+                                 section_desc_set_t *loaded) {
     if (!backend->supportsRemote())
         return NIXL_ERR_UNKNOWN;
 
@@ -375,47 +730,255 @@ nixl_status_t nixlRemoteSection::addDescList (
     for (int i=0; i<mem_elms.descCount(); ++i) {
         // TODO: Can add overlap checks (erroneous)
         int idx = target->getIndex(mem_elms[i]);
-        if (idx < 0) {
-            ret = backend->loadRemoteMD(mem_elms[i], nixl_mem, agentName, out.metadataP);
-            // In case of errors, no need to remove the previous entries
-            // Agent will delete the full object.
-            if (ret<0)
-                return ret;
-            *p = mem_elms[i]; // Copy the basic desc part
-            out.metaBlob = mem_elms[i].metaInfo;
-            target->addDesc(out);
-        } else {
+        if (loaded)
+            loaded->emplace(sec_key, mem_elms[i]);
+
+        if (idx >= 0) {
             const nixl_blob_t &prev_meta_info = (*target)[idx].metaBlob;
-            // TODO: Support metadata updates
-            if (prev_meta_info != mem_elms[i].metaInfo)
+            if (prev_meta_info == mem_elms[i].metaInfo)
+                continue;
+            // A versioned agent registered the region again, and the
+            // versions in between were missed
+            if (!version)
                 return NIXL_ERR_NOT_ALLOWED;
+            backend->unloadMD((*target)[idx].metadataP);
+            target->remDesc(idx);
         }
+
+        ret = backend->loadRemoteMD(mem_elms[i], nixl_mem, agentName, out.metadataP);
+        // In case of errors, no need to remove the previous entries
+        // Agent will delete the full object.
+        if (ret<0)
+            return ret;
+        *p = mem_elms[i]; // Copy the basic desc part
+        out.metaBlob = mem_elms[i].metaInfo;
+        target->addDesc(out);
+    }
+    updateMaxEnds(*target);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlRemoteSection::remDescList (
+                                 const nixl_reg_dlist_t& mem_elms,
+                                 nixlBackendEngine* backend) {
+    nixl_mem_t nixl_mem   = mem_elms.getType();
+    section_key_t sec_key = std::make_pair(nixl_mem, backend);
+    auto it = sectionMap.find(sec_key);
+    if (it == sectionMap.end())
+        return NIXL_SUCCESS;
+    nixl_sec_dlist_t *target = it->second;
+
+    // Entries of a partial load may not be there
+    for (auto & elm : mem_elms) {
+        int idx = target->getIndex(elm);
+        if (idx < 0)
+            continue;
+        backend->unloadMD((*target)[idx].metadataP);
+        target->remDesc(idx);
+    }
+    updateMaxEnds(*target);
+
+    if (target->descCount()==0) {
+        delete target;
+        sectionMap.erase(it);
+        memToBackend[nixl_mem].erase(backend);
     }
     return NIXL_SUCCESS;
 }
 
 nixl_status_t nixlRemoteSection::loadRemoteData (nixlSerDes* deserializer,
-                                                 backend_map_t &backendToEngineMap) {
+                                                 backend_map_t &backendToEngineMap,
+                                                 section_desc_set_t *loaded) {
+    nixlRemoteImport import;
+
+    nixl_status_t ret = prepRemoteData(deserializer, backendToEngineMap, import);
+    if (ret) return ret;
+    ret = import.load(1);
+    if (ret) return ret;
+    mergeRemoteData(import);
+    if (loaded)
+        loaded->insert(import.loaded.begin(), import.loaded.end());
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlRemoteSection::checkDesc (const nixlBlobDesc &desc,
+                                            const section_key_t &sec_key,
+                                            bool &changed) const {
+    changed = true;
+    auto it = sectionMap.find(sec_key);
+    if (it == sectionMap.end())
+        return NIXL_SUCCESS;
+
+    int idx = it->second->getIndex(desc);
+    if (idx < 0)
+        return NIXL_SUCCESS;
+    if ((*it->second)[idx].metaBlob == desc.metaInfo) {
+        changed = false;
+        return NIXL_SUCCESS;
+    }
+    // A versioned agent registered the region again, and the
+    // versions in between were missed
+    return version ? NIXL_SUCCESS : NIXL_ERR_NOT_ALLOWED;
+}
+
+nixl_status_t nixlRemoteSection::prepRemoteData (nixlSerDes* deserializer,
+                                                 backend_map_t &backendToEngineMap,
+                                                 nixlRemoteImport &import) const {
     nixl_status_t ret;
     size_t seg_count;
     nixl_backend_t nixl_backend;
+    bool changed;
 
     ret = deserializer->getBuf("nixlSecElms", &seg_count, sizeof(seg_count));
     if (ret) return ret;
 
+    import.agentName = agentName;
     for (size_t i=0; i<seg_count; ++i) {
-        // In case of errors, no need to remove the previous entries
-        // Agent will delete the full object.
         nixl_backend = deserializer->getStr("bknd");
         if (nixl_backend.size()==0)
             return NIXL_ERR_INVALID_PARAM;
         nixl_reg_dlist_t s_desc(deserializer);
         if (s_desc.descCount()==0) // can be used for entry removal in future
             return NIXL_ERR_NOT_FOUND;
-        if (backendToEngineMap.count(nixl_backend) != 0) {
-            ret = addDescList(s_desc, backendToEngineMap[nixl_backend]);
+
+        auto eng = backendToEngineMap.find(nixl_backend);
+        if (eng == backendToEngineMap.end())
+            continue;
+        if (!eng->second->supportsRemote())
+            return NIXL_ERR_UNKNOWN;
+
+        section_key_t sec_key = std::make_pair(s_desc.getType(), eng->second);
+        for (int j=0; j<s_desc.descCount(); ++j) {
+            import.loaded.emplace(sec_key, s_desc[j]);
+            ret = checkDesc(s_desc[j], sec_key, changed);
             if (ret) return ret;
+            if (changed)
+                import.entries.push_back({import.lists.size(), j});
+        }
+        import.lists.push_back(std::move(s_desc));
+        import.listEngines.push_back(eng->second);
+    }
+    return NIXL_SUCCESS;
+}
+
+void nixlRemoteSection::mergeRemoteData (nixlRemoteImport &import) {
+    nixlSectionDesc out;
+    nixlBasicDesc *p = &out;
+    // New descriptors of each list, merged into it at once
+    std::map<section_key_t, std::vector<nixlSectionDesc>> added;
+    std::set<section_key_t> changed;
+
+    for (auto & elm : import.entries) {
+        const nixlBlobDesc &desc = import.lists[elm.list][elm.index];
+        nixl_mem_t nixl_mem      = import.lists[elm.list].getType();
+        nixlBackendEngine* eng   = import.listEngines[elm.list];
+        section_key_t sec_key    = std::make_pair(nixl_mem, eng);
+
+        if (sectionMap.count(sec_key) == 0)
+            sectionMap[sec_key] = new nixl_sec_dlist_t(nixl_mem, true);
+        memToBackend[nixl_mem].insert(eng); // Fine to overwrite, it's a set
+        nixl_sec_dlist_t *target = sectionMap[sec_key];
+        changed.insert(sec_key);
+
+        *p = desc; // Copy the basic desc part
+        out.metadataP = elm.metadataP;
+        out.metaBlob  = desc.metaInfo;
+        int idx = target->getIndex(desc);
+        if (idx >= 0) {
+            // Replaced in place, its position in the sorted list is the same
+            eng->unloadMD((*target)[idx].metadataP);
+            (*target)[idx] = out;
+        } else {
+            added[sec_key].push_back(out);
+        }
+        elm.metadataP = nullptr;
+    }
+    import.entries.clear();
+
+    for (auto & [sec_key, descs] : added) {
+        nixlBackendEngine* eng   = sec_key.second;
+        nixl_sec_dlist_t* target = sectionMap[sec_key];
+
+        // A descriptor repeated in the import replaces the earlier ones
+        std::stable_sort(descs.begin(), descs.end());
+        size_t j = 0;
+        for (size_t i = 0; i < descs.size(); ++i) {
+            if ((j > 0) && (static_cast<const nixlBasicDesc&>(descs[j - 1]) ==
+                            static_cast<const nixlBasicDesc&>(descs[i]))) {
+                eng->unloadMD(descs[j - 1].metadataP);
+                descs[j - 1] = std::move(descs[i]);
+            } else {
+                if (i != j)
+                    descs[j] = std::move(descs[i]);
+                j++;
+            }
+        }
+        descs.resize(j);
+        target->addDescs(descs.begin(), descs.end());
+    }
+
+    for (auto & sec_key : changed)
+        updateMaxEnds(*sectionMap[sec_key]);
+}
+
+void nixlRemoteSection::prune (const section_desc_set_t &loaded) {
+    auto it = sectionMap.begin();
+
+    while (it != sectionMap.end()) {
+        const section_key_t &sec_key = it->first;
+        nixl_sec_dlist_t *target = it->second;
+
+        std::vector<int> indices;
+        for (int i = 0; i < target->descCount(); ++i) {
+            const nixlBasicDesc &desc = (*target)[i];
+            if (loaded.count(std::make_pair(sec_key, desc)) == 0) {
+                sec_key.second->unloadMD((*target)[i].metadataP);
+                indices.push_back(i);
+            }
+        }
+        if (!indices.empty()) {
+            target->remDescs(std::move(indices));
+            updateMaxEnds(*target);
         }
+
+        if (target->descCount()==0) {
+            memToBackend[sec_key.first].erase(sec_key.second);
+            delete target;
+            it = sectionMap.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+nixl_status_t nixlRemoteSection::loadRemoteDelta (nixlSerDes* deserializer,
+                                                  backend_map_t &backendToEngineMap) {
+    nixl_status_t ret;
+    size_t run_count;
+    uint8_t added;
+    nixl_backend_t nixl_backend;
+
+    ret = deserializer->getBuf("nixlSecChgs", &run_count, sizeof(run_count));
+    if (ret) return ret;
+
+    for (size_t i=0; i<run_count; ++i) {
+        ret = deserializer->getBuf("add", &added, sizeof(added));
+        if (ret) return ret;
+        nixl_backend = deserializer->getStr("bknd");
+        if (nixl_backend.size()==0)
+            return NIXL_ERR_INVALID_PARAM;
+        nixl_reg_dlist_t s_desc(deserializer);
+        if (s_desc.descCount()==0)
+            return NIXL_ERR_INVALID_PARAM;
+
+        auto eng = backendToEngineMap.find(nixl_backend);
+        if (eng == backendToEngineMap.end())
+            continue;
+        if (added)
+            ret = addDescList(s_desc, eng->second);
+        else
+            ret = remDescList(s_desc, eng->second);
+        if (ret) return ret;
     }
     return NIXL_SUCCESS;
 }
@@ -435,8 +998,8 @@ nixl_status_t nixlRemoteSection::loadLocalData (
     memToBackend[nixl_mem].insert(backend); // Fine to overwrite, it's a set
     nixl_sec_dlist_t *target = sectionMap[sec_key];
 
-    for (auto & elm: mem_elms)
-        target->addDesc(elm);
+    target->addDescs(mem_elms.begin(), mem_elms.end());
+    updateMaxEnds(*target);
 
     return NIXL_SUCCESS;
 }
@@ -0,0 +1,431 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <climits>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/fs.h>
+#include <linux/nvme_ioctl.h>
+#include "blk_backend.h"
+
+/** Submission queue entries of each ring */
+#define DEFAULT_QUEUE_DEPTH 128
+/** Split transfers in requests of up to 128 KB, below the usual NVMe MDTS */
+#define DEFAULT_MAX_REQUEST_SIZE (128 * 1024)
+
+#define NVME_CMD_WRITE 0x01
+#define NVME_CMD_READ 0x02
+#define NVME_ADMIN_IDENTIFY 0x06
+#define NVME_IDENTIFY_DATA_SIZE 4096
+
+static bool getSizeParam(nixl_b_params_t* custom_params, const std::string &key,
+                         size_t &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool getBoolParam(nixl_b_params_t* custom_params, const std::string &key,
+                         bool &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    const std::string &str = (*custom_params)[key];
+    if ((str != "true") && (str != "false")) {
+        std::cerr << "Invalid " << key << " parameter: " << str << std::endl;
+        return false;
+    }
+    value = (str == "true");
+    return true;
+}
+
+nixlBlkEngine::nixlBlkEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    size_t num_queues = 0;
+    size_t queue_depth = DEFAULT_QUEUE_DEPTH;
+    bool passthrough = true;
+
+    maxRequestSize = DEFAULT_MAX_REQUEST_SIZE;
+    polled = false;
+    bigRings = false;
+
+    nixl_b_params_t* custom_params = init_params->customParams;
+    if (custom_params) {
+        if (!getSizeParam(custom_params, "queues", num_queues) ||
+            !getSizeParam(custom_params, "queue_depth", queue_depth) ||
+            !getSizeParam(custom_params, "max_request_size", maxRequestSize) ||
+            !getBoolParam(custom_params, "poll", polled) ||
+            !getBoolParam(custom_params, "passthrough", passthrough)) {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    if ((queue_depth == 0) || (maxRequestSize == 0) || (maxRequestSize > INT_MAX)) {
+        std::cerr << "queue_depth and max_request_size must be set" << std::endl;
+        this->initErr = true;
+        return;
+    }
+    if (num_queues == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_queues = (cpus > 0) ? cpus : 1;
+    }
+
+    unsigned int flags = polled ? IORING_SETUP_IOPOLL : 0;
+    for (size_t i = 0; i < num_queues; i++) {
+        std::unique_ptr<nixlBlkQueue> queue(new nixlBlkQueue("BLK", "end of device"));
+        int ret = -EINVAL;
+
+        // Kernels without passthrough reject the big entries, these rings
+        // still serve block devices
+        if (passthrough && (i == 0 || bigRings)) {
+            ret = queue->init(queue_depth,
+                              flags | IORING_SETUP_SQE128 | IORING_SETUP_CQE32);
+            bigRings = (ret == 0);
+        }
+        if (!bigRings) {
+            ret = queue->init(queue_depth, flags);
+        }
+        if (ret < 0) {
+            std::cerr << "io_uring_queue_init failed: " << strerror(-ret) << std::endl;
+            this->initErr = true;
+            return;
+        }
+        queues.push_back(std::move(queue));
+    }
+
+    this->initErr = false;
+}
+
+nixlBlkEngine::~nixlBlkEngine()
+{
+}
+
+// Namespace id, LBA size and capacity of an NVMe generic char device
+static bool identifyNamespace(int fd, nixlBlkMetadata *md)
+{
+    std::vector<unsigned char> id(NVME_IDENTIFY_DATA_SIZE);
+    struct nvme_admin_cmd cmd;
+
+    int nsid = ioctl(fd, NVME_IOCTL_ID);
+    if (nsid <= 0) {
+        return false;
+    }
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = NVME_ADMIN_IDENTIFY;
+    cmd.nsid = nsid;
+    cmd.addr = (uintptr_t) id.data();
+    cmd.data_len = id.size();
+    cmd.cdw10 = 0;  // CNS 0, the namespace data structure
+    if (ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd) != 0) {
+        return false;
+    }
+
+    // NSZE in blocks at byte 0, FLBAS at 26, LBA formats from 128
+    uint64_t nsze;
+    memcpy(&nsze, id.data(), sizeof(nsze));
+    unsigned int format = (id[26] & 0xf) | ((id[26] >> 1) & 0x30);
+    unsigned int lba_shift = id[128 + format * 4 + 2];
+    if ((lba_shift < 9) || (lba_shift > 16)) {
+        return false;
+    }
+
+    md->nsid = nsid;
+    md->lbaShift = lba_shift;
+    md->capacity = nsze << lba_shift;
+    md->align = 1UL << lba_shift;
+    return true;
+}
+
+nixl_status_t nixlBlkEngine::registerMem(const nixlBlobDesc &mem,
+                                         const nixl_mem_t &nixl_mem,
+                                         nixlBackendMD* &out)
+{
+    nixlBlkMetadata *md = new nixlBlkMetadata();
+
+    md->type = nixl_mem;
+
+    switch (nixl_mem) {
+        case BLK_SEG: {
+            struct stat st;
+
+            md->fd = mem.devId;
+            if (fstat(md->fd, &st) != 0) {
+                std::cerr << "BLK: invalid fd " << md->fd << std::endl;
+                delete md;
+                return NIXL_ERR_INVALID_PARAM;
+            }
+
+            if (S_ISCHR(st.st_mode)) {
+                if (!bigRings || !identifyNamespace(md->fd, md)) {
+                    std::cerr << "BLK: fd " << md->fd
+                              << " is not a usable NVMe generic device" << std::endl;
+                    delete md;
+                    return NIXL_ERR_NOT_SUPPORTED;
+                }
+                md->passthru = true;
+            } else {
+                int fl = fcntl(md->fd, F_GETFL);
+                unsigned int lba_size = 512;
+                uint64_t capacity = SIZE_MAX;
+
+                if (S_ISBLK(st.st_mode)) {
+                    ioctl(md->fd, BLKSSZGET, &lba_size);
+                    ioctl(md->fd, BLKGETSIZE64, &capacity);
+                } else if (!S_ISREG(st.st_mode)) {
+                    delete md;
+                    return NIXL_ERR_INVALID_PARAM;
+                }
+                md->capacity = capacity;
+                if (fl & O_DIRECT) {
+                    md->align = lba_size;
+                } else if (polled) {
+                    // Polled rings only complete direct IO
+                    std::cerr << "BLK: with poll, devices must be opened with O_DIRECT"
+                              << std::endl;
+                    delete md;
+                    return NIXL_ERR_INVALID_PARAM;
+                }
+            }
+            break;
+        }
+
+        case DRAM_SEG:
+            md->base = (void*) mem.addr;
+            md->size = mem.len;
+            break;
+
+        default:
+            delete md;
+            return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    out = (nixlBackendMD*) md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlBlkEngine::deregisterMem(nixlBackendMD* meta)
+{
+    delete (nixlBlkMetadata *) meta;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlBlkEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    size_t buf_cnt = local.descCount();
+
+    if ((buf_cnt != (size_t) remote.descCount()) ||
+        ((operation != NIXL_READ) && (operation != NIXL_WRITE))) {
+        std::cerr << "Error in count or operation selection\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    if ((local.getType() != DRAM_SEG) || (remote.getType() != BLK_SEG)) {
+        std::cerr << "Only support I/O between DRAM and block devices\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    nixlBlkBackendReqH *blk_handle = new nixlBlkBackendReqH();
+
+    for (size_t i = 0; i < buf_cnt; i++) {
+        nixlBlkMetadata *dev_md = (nixlBlkMetadata *) remote[i].metadataP;
+        size_t total_size = local[i].len;
+        size_t offset = remote[i].addr;
+
+        if (!local[i].addr || !dev_md) {
+            delete blk_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        // Whole blocks, inside the device
+        size_t align = dev_md->align;
+        if ((offset % align) || (total_size % align) ||
+            (!dev_md->passthru && (local[i].addr % align)) ||
+            (offset > dev_md->capacity) || (total_size > dev_md->capacity - offset)) {
+            std::cerr << "BLK: descriptor " << i << " is not block aligned "
+                      << "or past the device end" << std::endl;
+            delete blk_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        // Pieces stay whole blocks
+        size_t piece_max = std::max(maxRequestSize - maxRequestSize % align, align);
+        size_t current_offset = 0;
+
+        while (current_offset < total_size) {
+            nixlBlkIO io;
+
+            io.owner = blk_handle;
+            io.addr = (char*) local[i].addr + current_offset;
+            io.size = std::min(total_size - current_offset, piece_max);
+            io.offset = offset + current_offset;
+            io.dev = dev_md;
+            io.isRead = (operation == NIXL_READ);
+            io.done = 0;
+            blk_handle->ios.push_back(io);
+
+            current_offset += io.size;
+        }
+    }
+
+    if (blk_handle->ios.empty()) {
+        delete blk_handle;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    handle = blk_handle;
+    return NIXL_SUCCESS;
+}
+
+// Fills a submission entry for the rest of io, false if the ring is full
+bool nixlBlkEngine::prepIO(nixlBlkQueue *queue, nixlBlkIO *io)
+{
+    struct io_uring_sqe *sqe = queue->getSqe();
+    if (!sqe) {
+        return false;
+    }
+
+    char *pos = (char*) io->addr + io->done;
+    size_t len = io->size - io->done;
+    size_t offset = io->offset + io->done;
+    const nixlBlkMetadata *dev = io->dev;
+
+    if (dev->passthru) {
+        // The NVMe command goes straight to the device queue
+        uint64_t slba = offset >> dev->lbaShift;
+
+        io_uring_prep_rw(IORING_OP_URING_CMD, sqe, dev->fd, nullptr, 0, 0);
+        sqe->cmd_op = NVME_URING_CMD_IO;
+
+        struct nvme_uring_cmd *cmd = (struct nvme_uring_cmd *) sqe->cmd;
+        memset(cmd, 0, sizeof(*cmd));
+        cmd->opcode = io->isRead ? NVME_CMD_READ : NVME_CMD_WRITE;
+        cmd->nsid = dev->nsid;
+        cmd->addr = (uintptr_t) pos;
+        cmd->data_len = len;
+        cmd->cdw10 = slba & 0xffffffff;
+        cmd->cdw11 = slba >> 32;
+        cmd->cdw12 = (len >> dev->lbaShift) - 1;  // Zero based block count
+    } else if (io->isRead) {
+        io_uring_prep_read(sqe, dev->fd, pos, len, offset);
+    } else {
+        io_uring_prep_write(sqe, dev->fd, pos, len, offset);
+    }
+    queue->track(sqe, io);
+    return true;
+}
+
+void nixlBlkEngine::completeIO(nixlBlkQueue *queue, nixlBlkIO *io, int res)
+{
+    if (!io->dev->passthru) {
+        queue->complete(io, res);
+        return;
+    }
+
+    // 0, a negative errno, or a positive NVMe status
+    if (res != 0) {
+        std::cerr << "BLK NVMe command failed: "
+                  << (res < 0 ? strerror(-res) : "NVMe status ")
+                  << (res > 0 ? std::to_string(res) : "") << std::endl;
+        queue->fail(io);
+        return;
+    }
+    queue->complete(io, io->size - io->done);
+}
+
+nixl_status_t nixlBlkEngine::postXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    nixlBlkBackendReqH *blk_handle = (nixlBlkBackendReqH *) handle;
+
+    if (blk_handle->posted) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    // The queue of the posting core, checks of this handle stay on it
+    int cpu = sched_getcpu();
+    nixlBlkQueue *queue = queues[(cpu < 0 ? 0 : cpu) % queues.size()].get();
+    std::lock_guard<std::mutex> guard(queue->lock);
+
+    blk_handle->queue = queue;
+    queue->post(blk_handle, [this, queue](nixlBlkIO *io) { return prepIO(queue, io); });
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t nixlBlkEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlBlkBackendReqH *blk_handle = (nixlBlkBackendReqH *) handle;
+
+    if (!blk_handle->posted) {
+        return blk_handle->status;
+    }
+
+    nixlBlkQueue *queue = blk_handle->queue;
+    std::lock_guard<std::mutex> guard(queue->lock);
+
+    return queue->check(blk_handle,
+                        [this, queue](nixlBlkIO *io) { return prepIO(queue, io); },
+                        [this, queue](nixlBlkIO *io, int res) {
+                            completeIO(queue, io, res);
+                        });
+}
+
+nixl_status_t nixlBlkEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlBlkBackendReqH *blk_handle = (nixlBlkBackendReqH *) handle;
+
+    // Nothing is cancelled, submitted IOs still point into the handle
+    if (blk_handle->posted) {
+        nixlBlkQueue *queue = blk_handle->queue;
+        std::lock_guard<std::mutex> guard(queue->lock);
+
+        queue->release(blk_handle,
+                       [this, queue](nixlBlkIO *io, int res) {
+                           completeIO(queue, io, res);
+                       },
+                       [](nixlBlkIO *io) { });
+    }
+
+    delete blk_handle;
+    return NIXL_SUCCESS;
+}
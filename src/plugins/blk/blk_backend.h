@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __BLK_BACKEND_H
+#define __BLK_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <memory>
+#include <vector>
+#include "backend/backend_engine.h"
+#include "uring/uring_queue.h"
+
+class nixlBlkMetadata : public nixlBackendMD {
+    public:
+        nixl_mem_t type;
+        int fd;             // BLK_SEG
+        bool passthru;      // NVMe generic char device, IOs are NVMe commands
+        unsigned int nsid;
+        unsigned int lbaShift;
+        size_t capacity;    // SIZE_MAX for regular files
+        size_t align;       // Offsets and sizes, 1 without O_DIRECT
+        void *base;         // DRAM_SEG
+        size_t size;
+
+        nixlBlkMetadata() : nixlBackendMD(true) {
+            fd = -1;
+            passthru = false;
+            nsid = 0;
+            lbaShift = 0;
+            capacity = 0;
+            align = 1;
+            base = nullptr;
+            size = 0;
+        }
+        ~nixlBlkMetadata() { }
+};
+
+class nixlBlkBackendReqH;
+
+// One read or write of up to max_request_size bytes
+class nixlBlkIO {
+    public:
+        nixlBlkBackendReqH *owner;
+        void *addr;
+        size_t size;
+        size_t offset;
+        const nixlBlkMetadata *dev;
+        bool isRead;
+
+        // Set while posted
+        size_t done;
+};
+
+// A ring with its own lock, one per core, so posts from different cores
+// do not contend
+typedef nixlUringQueue<nixlBlkBackendReqH, nixlBlkIO> nixlBlkQueue;
+
+class nixlBlkBackendReqH : public nixlBackendReqH, public nixlUringReq {
+    public:
+        std::vector<nixlBlkIO> ios;
+        nixlBlkQueue *queue;  // Of the last post
+
+        nixlBlkBackendReqH() {
+            queue = nullptr;
+        }
+        ~nixlBlkBackendReqH() { }
+};
+
+class nixlBlkEngine : public nixlBackendEngine {
+    private:
+        std::vector<std::unique_ptr<nixlBlkQueue>> queues;
+        size_t maxRequestSize;
+        bool polled;
+        bool bigRings;        // SQE128/CQE32, as NVMe passthrough needs
+
+        bool prepIO(nixlBlkQueue *queue, nixlBlkIO *io);
+        void completeIO(nixlBlkQueue *queue, nixlBlkIO *io, int res);
+
+    public:
+        nixlBlkEngine(const nixlBackendInitParams* init_params);
+        ~nixlBlkEngine();
+
+        // Devices are local, there is nothing to connect to
+        bool supportsNotif() const {
+            return false;
+        }
+        bool supportsRemote() const {
+            return false;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(DRAM_SEG);
+            mems.push_back(BLK_SEG);
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if ((local_mem != DRAM_SEG) || (remote_mem != BLK_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // No filesystem or page cache in the way
+            hints.bandwidthGBps = 6;
+            hints.latencyUs     = polled ? 8 : 12;
+            hints.chunkSize     = maxRequestSize;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t connect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output) {
+            output = input;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t unloadMD(nixlBackendMD* input) {
+            return NIXL_SUCCESS;
+        }
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+};
+#endif
@@ -0,0 +1,400 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <sys/prctl.h>
+#include "cma_backend.h"
+#include "serdes/serdes.h"
+
+nixlCmaEngine::nixlCmaEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    nixl_b_params_t* custom_params = init_params->customParams;
+    std::string peer_access = "false";
+    long peer_pid = 0;
+
+    pid = getpid();
+    hostId = nixlLocalHostId();
+
+    if (custom_params && (custom_params->count("peer_access") > 0)) {
+        peer_access = (*custom_params)["peer_access"];
+        if ((peer_access != "true") && (peer_access != "false")) {
+            std::cerr << "Invalid peer_access parameter: " << peer_access << std::endl;
+            this->initErr = true;
+            return;
+        }
+    }
+
+    if (custom_params && (custom_params->count("peer_pid") > 0) &&
+        !(*custom_params)["peer_pid"].empty()) {
+        const std::string &val = (*custom_params)["peer_pid"];
+        char *end;
+        errno = 0;
+        peer_pid = strtol(val.c_str(), &end, 10);
+        if (errno || (*end != '\0') || (peer_pid <= 0)) {
+            std::cerr << "Invalid peer_pid parameter: " << val << std::endl;
+            this->initErr = true;
+            return;
+        }
+    }
+
+    // Under Yama ptrace_scope 1 only ancestors may read our memory. Others
+    // are only let in on request: one given process, or with peer_access any
+    // process of the same user.
+    int ret = 0;
+    if (peer_pid > 0) {
+        ret = prctl(PR_SET_PTRACER, (unsigned long) peer_pid, 0, 0, 0);
+    } else if (peer_access == "true") {
+        ret = prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
+    }
+    if (ret != 0) {
+        std::cerr << "Failed to set the CMA peer tracer: " << strerror(errno) << std::endl;
+        this->initErr = true;
+        return;
+    }
+
+    if ((notifier.init("nixl-cma") != NIXL_SUCCESS) ||
+        (notifier.addPeer(localAgent, notifier.getName()) != NIXL_SUCCESS)) {
+        this->initErr = true;
+        return;
+    }
+}
+
+nixlCmaEngine::~nixlCmaEngine()
+{
+}
+
+nixl_status_t nixlCmaEngine::getConnInfo(std::string &str) const
+{
+    nixlSerDes sd;
+
+    sd.addStr("HostId", hostId);
+    sd.addBuf("Pid", &pid, sizeof(pid));
+    sd.addStr("Sock", notifier.getName());
+    str = sd.exportStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                                const std::string &remote_conn_info)
+{
+    nixlSerDes sd;
+    nixlCmaPeer peer;
+
+    if (sd.importStr(remote_conn_info) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    std::string host_id = sd.getStr("HostId");
+    if (sd.getBuf("Pid", &peer.pid, sizeof(peer.pid)) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+    peer.sockName = sd.getStr("Sock");
+    if (host_id.empty() || peer.sockName.empty()) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    // Another host, or a process this one cannot name
+    if (host_id != hostId) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    if (notifier.addPeer(remote_agent, peer.sockName) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    const std::lock_guard<std::mutex> guard(peerLock);
+    peers[remote_agent] = peer;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::connect(const std::string &remote_agent)
+{
+    const std::lock_guard<std::mutex> guard(peerLock);
+    if ((remote_agent == localAgent) || (peers.count(remote_agent) > 0)) {
+        return NIXL_SUCCESS;
+    }
+    return NIXL_ERR_NOT_FOUND;
+}
+
+nixl_status_t nixlCmaEngine::disconnect(const std::string &remote_agent)
+{
+    if (remote_agent != localAgent) {
+        notifier.removePeer(remote_agent);
+        const std::lock_guard<std::mutex> guard(peerLock);
+        peers.erase(remote_agent);
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::registerMem(const nixlBlobDesc &mem,
+                                         const nixl_mem_t &nixl_mem,
+                                         nixlBackendMD* &out)
+{
+    if (nixl_mem != DRAM_SEG) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    // Nothing to pin or export, the peer reads the pages directly
+    nixlCmaMetadata *md = new nixlCmaMetadata(true);
+    md->base = (void*) mem.addr;
+    md->size = mem.len;
+    md->pid = pid;
+    out = md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::deregisterMem(nixlBackendMD* meta)
+{
+    delete (nixlCmaMetadata*) meta;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::getPublicData(const nixlBackendMD* meta,
+                                           std::string &str) const
+{
+    // The address in the descriptor and the pid in the conn info are enough
+    str.clear();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::loadLocalMD(nixlBackendMD* input,
+                                         nixlBackendMD* &output)
+{
+    output = input;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::loadRemoteMD(const nixlBlobDesc &input,
+                                          const nixl_mem_t &nixl_mem,
+                                          const std::string &remote_agent,
+                                          nixlBackendMD* &output)
+{
+    const std::lock_guard<std::mutex> guard(peerLock);
+    auto it = peers.find(remote_agent);
+
+    if (nixl_mem != DRAM_SEG) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+    if (it == peers.end()) {
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    nixlCmaMetadata *md = new nixlCmaMetadata(false);
+    md->base = (void*) input.addr;
+    md->size = input.len;
+    md->pid = it->second.pid;
+    output = md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::unloadMD(nixlBackendMD* input)
+{
+    nixlCmaMetadata *md = (nixlCmaMetadata*) input;
+
+    // Local ones are the registered objects, freed at deregisterMem
+    if (!md->isPrivate()) {
+        delete md;
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    size_t desc_cnt = local.descCount();
+
+    if ((desc_cnt != (size_t) remote.descCount()) ||
+        ((operation != NIXL_READ) && (operation != NIXL_WRITE))) {
+        std::cerr << "Error in count or operation selection\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    if ((local.getType() != DRAM_SEG) || (remote.getType() != DRAM_SEG)) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    pid_t remote_pid = 0;
+    if (remote_agent != localAgent) {
+        const std::lock_guard<std::mutex> guard(peerLock);
+        auto it = peers.find(remote_agent);
+        if (it == peers.end()) {
+            return NIXL_ERR_NOT_FOUND;
+        }
+        remote_pid = it->second.pid;
+    }
+
+    nixlCmaBackendReqH *cma_handle = new nixlCmaBackendReqH();
+    cma_handle->pid = remote_pid;
+    cma_handle->remoteAgent = remote_agent;
+    cma_handle->localIov.resize(desc_cnt);
+    cma_handle->remoteIov.resize(desc_cnt);
+
+    for (size_t i = 0; i < desc_cnt; i++) {
+        if (local[i].len != remote[i].len) {
+            delete cma_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        cma_handle->localIov[i].iov_base = (void*) local[i].addr;
+        cma_handle->localIov[i].iov_len = local[i].len;
+        cma_handle->remoteIov[i].iov_base = (void*) remote[i].addr;
+        cma_handle->remoteIov[i].iov_len = remote[i].len;
+    }
+
+    handle = cma_handle;
+    return NIXL_SUCCESS;
+}
+
+// Both lists have matching lengths, calls take up to IOV_MAX entries and
+// continue after a partial transfer
+static nixl_status_t cmaCopy(pid_t pid, bool is_write,
+                             std::vector<struct iovec> &local,
+                             std::vector<struct iovec> &remote)
+{
+    size_t cnt = local.size();
+    size_t idx = 0;
+    size_t off = 0;  // Bytes done of the entry at idx
+
+    while (true) {
+        while ((idx < cnt) && (off == local[idx].iov_len)) {
+            idx++;
+            off = 0;
+        }
+        if (idx == cnt) {
+            return NIXL_SUCCESS;
+        }
+
+        size_t n = std::min(cnt - idx, (size_t) IOV_MAX);
+        struct iovec local_first = local[idx];
+        struct iovec remote_first = remote[idx];
+
+        local[idx].iov_base = (char*) local_first.iov_base + off;
+        local[idx].iov_len -= off;
+        remote[idx].iov_base = (char*) remote_first.iov_base + off;
+        remote[idx].iov_len -= off;
+
+        ssize_t ret = is_write ?
+                      process_vm_writev(pid, &local[idx], n, &remote[idx], n, 0) :
+                      process_vm_readv(pid, &local[idx], n, &remote[idx], n, 0);
+        int err = errno;
+
+        local[idx] = local_first;
+        remote[idx] = remote_first;
+
+        if (ret < 0) {
+            if (err == EINTR) {
+                continue;
+            }
+            std::cerr << "CMA transfer with process " << pid << " failed: "
+                      << strerror(err) << std::endl;
+            return (err == EPERM) ? NIXL_ERR_NOT_ALLOWED : NIXL_ERR_BACKEND;
+        }
+        if (ret == 0) {
+            return NIXL_ERR_BACKEND;
+        }
+
+        size_t left = ret;
+        while (left > 0) {
+            size_t rem = local[idx].iov_len - off;
+            if (left < rem) {
+                off += left;
+                break;
+            }
+            left -= rem;
+            idx++;
+            off = 0;
+        }
+    }
+}
+
+nixl_status_t nixlCmaEngine::postXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    nixlCmaBackendReqH *cma_handle = (nixlCmaBackendReqH*) handle;
+    bool is_write = (operation == NIXL_WRITE);
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    if (cma_handle->pid == 0) {
+        for (size_t i = 0; i < cma_handle->localIov.size(); i++) {
+            const struct iovec &l = cma_handle->localIov[i];
+            const struct iovec &r = cma_handle->remoteIov[i];
+            if (is_write) {
+                memmove(r.iov_base, l.iov_base, l.iov_len);
+            } else {
+                memmove(l.iov_base, r.iov_base, l.iov_len);
+            }
+        }
+    } else {
+        ret = cmaCopy(cma_handle->pid, is_write,
+                      cma_handle->localIov, cma_handle->remoteIov);
+        if (ret != NIXL_SUCCESS) {
+            return ret;
+        }
+    }
+
+    // Done by the time the peer reads the notification
+    if (opt_args && opt_args->hasNotif) {
+        ret = genNotif(remote_agent, opt_args->notifMsg);
+    }
+    return ret;
+}
+
+nixl_status_t nixlCmaEngine::checkXfer(nixlBackendReqH* handle)
+{
+    // Transfers complete within postXfer
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    delete (nixlCmaBackendReqH*) handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCmaEngine::genNotif(const std::string &remote_agent,
+                                      const std::string &msg)
+{
+    if (remote_agent == localAgent) {
+        return notifier.send(notifier.getName(), localAgent, msg);
+    }
+
+    std::string sock_name;
+    {
+        const std::lock_guard<std::mutex> guard(peerLock);
+        auto it = peers.find(remote_agent);
+        if (it == peers.end()) {
+            return NIXL_ERR_NOT_FOUND;
+        }
+        sock_name = it->second.sockName;
+    }
+    return notifier.send(sock_name, localAgent, msg);
+}
+
+nixl_status_t nixlCmaEngine::getNotifs(notif_list_t &notif_list)
+{
+    return notifier.recv(notif_list);
+}
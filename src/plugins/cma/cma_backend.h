@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __CMA_BACKEND_H
+#define __CMA_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include "backend/backend_engine.h"
+#include "local/local_utils.h"
+
+class nixlCmaMetadata : public nixlBackendMD {
+    public:
+        // Registered range for local memory, owner process for remote memory
+        void *base;
+        size_t size;
+        pid_t pid;
+
+        nixlCmaMetadata(bool is_private) : nixlBackendMD(is_private) {
+            base = nullptr;
+            size = 0;
+            pid = 0;
+        }
+        ~nixlCmaMetadata() { }
+
+        bool isPrivate() const { return isPrivateMD; }
+};
+
+// An agent in another process of this host
+class nixlCmaPeer {
+    public:
+        pid_t pid;
+        std::string sockName;  // Notification socket, abstract namespace
+};
+
+class nixlCmaBackendReqH : public nixlBackendReqH {
+    public:
+        std::vector<struct iovec> localIov;
+        std::vector<struct iovec> remoteIov;
+        pid_t pid;      // 0 for transfers within this process
+        std::string remoteAgent;
+
+        nixlCmaBackendReqH() {
+            pid = 0;
+        }
+        ~nixlCmaBackendReqH() { }
+};
+
+class nixlCmaEngine : public nixlBackendEngine {
+    private:
+        pid_t pid;
+        std::string hostId;
+        nixlLocalNotifier notifier;
+
+        std::unordered_map<std::string, nixlCmaPeer> peers;
+        // Peers are loaded by the listener thread while transfers are prepared
+        mutable std::mutex peerLock;
+
+    public:
+        nixlCmaEngine(const nixlBackendInitParams* init_params);
+        ~nixlCmaEngine();
+
+        // Any agent of this host, through process_vm_readv/writev
+        bool supportsNotif() const {
+            return true;
+        }
+        bool supportsRemote() const {
+            return true;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+        bool supportsConcurrentLoad() const {
+            return true;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(DRAM_SEG);
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if ((local_mem != DRAM_SEG) || (remote_mem != DRAM_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // One copy by the CPU, ahead of the network backends
+            hints.bandwidthGBps = 16;
+            hints.latencyUs     = 1;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t getConnInfo(std::string &str) const;
+        nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                         const std::string &remote_conn_info);
+
+        nixl_status_t connect(const std::string &remote_agent);
+        nixl_status_t disconnect(const std::string &remote_agent);
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t getPublicData(const nixlBackendMD* meta,
+                                    std::string &str) const;
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output);
+        nixl_status_t loadRemoteMD(const nixlBlobDesc &input,
+                                   const nixl_mem_t &nixl_mem,
+                                   const std::string &remote_agent,
+                                   nixlBackendMD* &output);
+        nixl_status_t unloadMD(nixlBackendMD* input);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+
+        nixl_status_t getNotifs(notif_list_t &notif_list);
+        nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
+};
+#endif
@@ -0,0 +1,648 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "compress_backend.h"
+
+/** Descriptors below 16 KB are sent as they are */
+#define DEFAULT_MIN_SIZE (16 * 1024)
+/** Compressing the first 64 KB tells whether the rest is worth it */
+#define DEFAULT_SAMPLE_SIZE (64 * 1024)
+/** Compression buffers registered with the inner engine, in total */
+#define DEFAULT_POOL_SIZE (256 * 1024 * 1024)
+#define DEFAULT_MIN_RATIO 1.2
+#define BUFFER_ALIGN (1024 * 1024)
+
+// First byte of every notification, so the receiver knows which ones
+// carry compressed descriptors
+#define NOTIF_PLAIN      'P'
+#define NOTIF_COMPRESSED 'C'
+
+// After the tag of a compressed notification, followed by the user message
+// and the blocks
+struct nixlCompressNotifHdr {
+    uint32_t blockCount;
+    uint32_t msgLen;
+    uint8_t  hasMsg;
+} __attribute__((packed));
+
+// The compressed form of a block is written at the start of its target
+// range, and decompressed in place by the receiver
+struct nixlCompressBlockHdr {
+    uint64_t addr;
+    uint64_t len;
+    uint64_t compLen;
+    uint8_t  codec;
+} __attribute__((packed));
+
+static const char *ownParams[] = {
+    "backend", "codec", "level", "min_ratio", "min_size", "sample_size", "pool_size"
+};
+
+static bool getSizeParam(nixl_b_params_t* custom_params, const std::string &key,
+                         size_t &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+nixlCompressEngine::nixlCompressEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    nixl_b_params_t* custom_params = init_params->customParams;
+    nixl_b_params_t inner_params;
+    std::string inner_type = "UCX";
+    std::string codec_name = nixlCompressCodecDefault();
+    size_t level = 0;
+
+    inner = nullptr;
+    factory = nullptr;
+    minRatio = DEFAULT_MIN_RATIO;
+    minSize = DEFAULT_MIN_SIZE;
+    sampleSize = DEFAULT_SAMPLE_SIZE;
+    poolSize = DEFAULT_POOL_SIZE;
+    poolUsed = 0;
+    this->initErr = true;
+
+    if (custom_params) {
+        if (!getSizeParam(custom_params, "level", level) ||
+            !getSizeParam(custom_params, "min_size", minSize) ||
+            !getSizeParam(custom_params, "sample_size", sampleSize) ||
+            !getSizeParam(custom_params, "pool_size", poolSize)) {
+            return;
+        }
+        if (custom_params->count("backend")) {
+            inner_type = (*custom_params)["backend"];
+        }
+        if (custom_params->count("codec")) {
+            codec_name = (*custom_params)["codec"];
+        }
+        if (custom_params->count("min_ratio")) {
+            try {
+                minRatio = std::stod((*custom_params)["min_ratio"]);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid min_ratio parameter: " << e.what() << std::endl;
+                return;
+            }
+        }
+
+        // The rest is for the inner engine
+        inner_params = *custom_params;
+        for (auto key : ownParams) {
+            inner_params.erase(key);
+        }
+    }
+
+    if (minRatio <= 1) {
+        std::cerr << "min_ratio must be above 1" << std::endl;
+        return;
+    }
+
+    if ((codec_name != "none") && !codec_name.empty()) {
+        codec = nixlCompressCodecCreate(codec_name, level);
+        if (!codec) {
+            std::cerr << "COMPRESS: codec " << codec_name << " is not built in" << std::endl;
+            return;
+        }
+    }
+
+    if (inner_type == init_params->type) {
+        std::cerr << "COMPRESS: cannot wrap itself" << std::endl;
+        return;
+    }
+    factory = init_params->factory;
+    if (!factory) {
+        std::cerr << "COMPRESS: no engine factory to create " << inner_type << std::endl;
+        return;
+    }
+
+    nixlBackendInitParams inner_init = *init_params;
+    inner_init.type = inner_type;
+    inner_init.customParams = &inner_params;
+    inner = factory->createEngine(&inner_init);
+    if (!inner) {
+        std::cerr << "COMPRESS: failed to create backend " << inner_type << std::endl;
+        return;
+    }
+    if (inner->getInitErr()) {
+        factory->destroyEngine(inner);
+        inner = nullptr;
+        return;
+    }
+
+    this->initErr = false;
+}
+
+nixlCompressEngine::~nixlCompressEngine()
+{
+    if (!inner) {
+        return;
+    }
+    for (auto &buffer : buffers) {
+        inner->deregisterMem(buffer->md);
+        free(buffer->addr);
+    }
+    factory->destroyEngine(inner);
+}
+
+nixl_status_t nixlCompressEngine::getXferHints(const nixl_mem_t &local_mem,
+                                               const nixl_mem_t &remote_mem,
+                                               nixlBackendXferHints &hints) const
+{
+    nixl_status_t ret = inner->getXferHints(local_mem, remote_mem, hints);
+
+    if ((ret == NIXL_SUCCESS) && codec &&
+        (local_mem == DRAM_SEG) && (remote_mem == DRAM_SEG)) {
+        hints.bandwidthGBps *= minRatio;
+    }
+    return ret;
+}
+
+nixl_status_t nixlCompressEngine::getPeerXferHints(const nixl_mem_t &local_mem,
+                                                   const nixl_mem_t &remote_mem,
+                                                   const std::string &remote_agent,
+                                                   nixlBackendXferHints &hints) const
+{
+    nixl_status_t ret = inner->getPeerXferHints(local_mem, remote_mem, remote_agent, hints);
+
+    if ((ret == NIXL_SUCCESS) && codec &&
+        (local_mem == DRAM_SEG) && (remote_mem == DRAM_SEG)) {
+        hints.bandwidthGBps *= minRatio;
+    }
+    return ret;
+}
+
+nixl_status_t nixlCompressEngine::registerMem(const nixlBlobDesc &mem,
+                                              const nixl_mem_t &nixl_mem,
+                                              nixlBackendMD* &out)
+{
+    nixl_status_t ret = inner->registerMem(mem, nixl_mem, out);
+
+    if ((ret == NIXL_SUCCESS) && (nixl_mem == DRAM_SEG)) {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        dramRanges.emplace(mem.addr, mem.addr + mem.len);
+        dramByMD[out] = mem.addr;
+    }
+    return ret;
+}
+
+nixl_status_t nixlCompressEngine::deregisterMem(nixlBackendMD *meta)
+{
+    {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        auto it = dramByMD.find(meta);
+        if (it != dramByMD.end()) {
+            auto range = dramRanges.find(it->second);
+            if (range != dramRanges.end()) {
+                dramRanges.erase(range);
+            }
+            dramByMD.erase(it);
+        }
+    }
+    return inner->deregisterMem(meta);
+}
+
+// Peers only decompress into memory registered here
+bool nixlCompressEngine::isLocalDram(uintptr_t addr, size_t len)
+{
+    std::lock_guard<std::mutex> guard(rangeLock);
+    auto it = dramRanges.upper_bound(addr);
+
+    while (it != dramRanges.begin()) {
+        --it;
+        if ((it->second >= addr) && (it->second - addr >= len)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+nixlCompressBuffer *nixlCompressEngine::getBuffer(size_t size)
+{
+    std::lock_guard<std::mutex> guard(poolLock);
+    nixlCompressBuffer *best = nullptr;
+
+    for (auto &buffer : buffers) {
+        if (!buffer->inUse && (buffer->size >= size) &&
+            (!best || (buffer->size < best->size))) {
+            best = buffer.get();
+        }
+    }
+    if (best) {
+        best->inUse = true;
+        return best;
+    }
+
+    size = (size + BUFFER_ALIGN - 1) / BUFFER_ALIGN * BUFFER_ALIGN;
+    if (poolUsed + size > poolSize) {
+        // Make room with the idle buffers
+        for (auto it = buffers.begin(); it != buffers.end();) {
+            if ((*it)->inUse) {
+                ++it;
+                continue;
+            }
+            inner->deregisterMem((*it)->md);
+            free((*it)->addr);
+            poolUsed -= (*it)->size;
+            it = buffers.erase(it);
+        }
+        if (poolUsed + size > poolSize) {
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<nixlCompressBuffer> buffer(new nixlCompressBuffer());
+    nixlBlobDesc mem;
+
+    if (posix_memalign((void**) &buffer->addr, 4096, size) != 0) {
+        return nullptr;
+    }
+    mem.addr = (uintptr_t) buffer->addr;
+    mem.len = size;
+    mem.devId = 0;
+    if (inner->registerMem(mem, DRAM_SEG, buffer->md) != NIXL_SUCCESS) {
+        free(buffer->addr);
+        return nullptr;
+    }
+    buffer->size = size;
+    buffer->inUse = true;
+    poolUsed += size;
+    buffers.push_back(std::move(buffer));
+    return buffers.back().get();
+}
+
+void nixlCompressEngine::putBuffer(nixlCompressBuffer *buffer)
+{
+    std::lock_guard<std::mutex> guard(poolLock);
+    buffer->inUse = false;
+}
+
+nixl_status_t nixlCompressEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t* opt_args)
+{
+    nixlCompressBackendReqH *comp_handle = new nixlCompressBackendReqH();
+    nixl_status_t ret;
+
+    ret = inner->prepXfer(operation, local, remote, remote_agent,
+                          comp_handle->innerAll, opt_args);
+    if (ret != NIXL_SUCCESS) {
+        delete comp_handle;
+        return ret;
+    }
+
+    // Only the CPU decompresses, on a peer that fetches its notifications
+    comp_handle->compressible = codec && (operation == NIXL_WRITE) &&
+                                (local.getType() == DRAM_SEG) &&
+                                (remote.getType() == DRAM_SEG) &&
+                                (remote_agent != localAgent) &&
+                                inner->supportsNotif();
+
+    handle = comp_handle;
+    return NIXL_SUCCESS;
+}
+
+static void appendBytes(std::string &str, const void *data, size_t len)
+{
+    str.append((const char*) data, len);
+}
+
+nixl_status_t nixlCompressEngine::postCompressed(const nixl_meta_dlist_t &local,
+                                                 const nixl_meta_dlist_t &remote,
+                                                 const std::string &remote_agent,
+                                                 nixlCompressBackendReqH *handle,
+                                                 const nixl_opt_b_args_t* opt_args)
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t need = 0;
+
+    for (int i = 0; i < local.descCount(); i++) {
+        if (local[i].len >= minSize) {
+            need += codec->getBound(local[i].len);
+        }
+    }
+    if (need == 0) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+    if (handle->buffer && (handle->buffer->size < need)) {
+        putBuffer(handle->buffer);
+        handle->buffer = nullptr;
+    }
+    if (!handle->buffer) {
+        handle->buffer = getBuffer(need);
+    }
+    if (!handle->buffer) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    nixlCompressBuffer *buffer = handle->buffer;
+    nixlCompressNotifHdr hdr;
+    std::string blocks;
+    size_t pos = 0;
+
+    handle->partLocal.clear();
+    handle->partRemote.clear();
+    handle->origBytes = 0;
+    handle->wireBytes = 0;
+    handle->compressedDescs = 0;
+    handle->skippedDescs = 0;
+
+    for (int i = 0; i < local.descCount(); i++) {
+        nixlMetaDesc l = local[i];
+        nixlMetaDesc r = remote[i];
+        const char *src = (const char*) l.addr;
+        size_t len = l.len;
+        size_t comp = 0;
+
+        if (len >= minSize) {
+            // Skip data that does not compress with a look at its start
+            if (len > 2 * sampleSize) {
+                comp = codec->compress(src, sampleSize, buffer->addr + pos,
+                                       buffer->size - pos);
+                if ((comp == 0) || (comp * minRatio > sampleSize)) {
+                    comp = 0;
+                    len = 0;
+                }
+            }
+            if (len) {
+                comp = codec->compress(src, len, buffer->addr + pos, buffer->size - pos);
+                if (comp * minRatio > len) {
+                    comp = 0;
+                }
+            }
+        }
+
+        handle->origBytes += l.len;
+        if (comp) {
+            nixlCompressBlockHdr block;
+
+            block.addr = r.addr;
+            block.len = l.len;
+            block.compLen = comp;
+            block.codec = codec->getId();
+            appendBytes(blocks, &block, sizeof(block));
+
+            l.addr = (uintptr_t) (buffer->addr + pos);
+            l.len = comp;
+            l.metadataP = buffer->md;
+            r.len = comp;
+            pos += comp;
+            handle->compressedDescs++;
+        } else {
+            handle->skippedDescs++;
+        }
+        handle->wireBytes += l.len;
+        handle->partLocal.addDesc(l);
+        handle->partRemote.addDesc(r);
+    }
+
+    handle->compressUs = std::chrono::duration<double, std::micro>(
+                             std::chrono::steady_clock::now() - start).count();
+
+    if (handle->compressedDescs == 0) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    nixl_opt_b_args_t args = *opt_args;
+    nixl_status_t ret;
+
+    hdr.blockCount = handle->compressedDescs;
+    hdr.msgLen = opt_args->notifMsg.size();
+    hdr.hasMsg = opt_args->hasNotif;
+    args.notifMsg.clear();
+    args.notifMsg.push_back(NOTIF_COMPRESSED);
+    appendBytes(args.notifMsg, &hdr, sizeof(hdr));
+    args.notifMsg += opt_args->notifMsg;
+    args.notifMsg += blocks;
+    args.hasNotif = true;
+
+    if (handle->innerPart) {
+        inner->releaseReqH(handle->innerPart);
+        handle->innerPart = nullptr;
+    }
+    ret = inner->prepXfer(NIXL_WRITE, handle->partLocal, handle->partRemote,
+                          remote_agent, handle->innerPart, &args);
+    if (ret != NIXL_SUCCESS) {
+        handle->innerPart = nullptr;
+        return ret;
+    }
+
+    handle->active = handle->innerPart;
+    return inner->postXfer(NIXL_WRITE, handle->partLocal, handle->partRemote,
+                           remote_agent, handle->active, &args);
+}
+
+nixl_status_t nixlCompressEngine::postXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t* opt_args)
+{
+    nixlCompressBackendReqH *comp_handle = (nixlCompressBackendReqH *) handle;
+    nixl_opt_b_args_t args;
+
+    // Without a notification the receiver would not know when to decompress
+    if (comp_handle->compressible && opt_args && opt_args->hasNotif) {
+        nixl_status_t ret = postCompressed(local, remote, remote_agent,
+                                           comp_handle, opt_args);
+        if (ret != NIXL_ERR_NOT_SUPPORTED) {
+            return ret;
+        }
+    }
+
+    // Sent as it is
+    comp_handle->origBytes = 0;
+    for (auto &desc : local) {
+        comp_handle->origBytes += desc.len;
+    }
+    comp_handle->wireBytes = comp_handle->origBytes;
+    comp_handle->compressedDescs = 0;
+    comp_handle->skippedDescs = local.descCount();
+
+    if (opt_args) {
+        args = *opt_args;
+    }
+    if (args.hasNotif) {
+        args.notifMsg = NOTIF_PLAIN + args.notifMsg;
+    }
+    comp_handle->active = comp_handle->innerAll;
+    return inner->postXfer(operation, local, remote, remote_agent,
+                           comp_handle->active, &args);
+}
+
+nixl_status_t nixlCompressEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlCompressBackendReqH *comp_handle = (nixlCompressBackendReqH *) handle;
+
+    if (!comp_handle->active) {
+        return NIXL_ERR_NOT_POSTED;
+    }
+    return inner->checkXfer(comp_handle->active);
+}
+
+nixl_status_t nixlCompressEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlCompressBackendReqH *comp_handle = (nixlCompressBackendReqH *) handle;
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    if (comp_handle->innerAll) {
+        ret = inner->releaseReqH(comp_handle->innerAll);
+    }
+    if (comp_handle->innerPart) {
+        nixl_status_t part_ret = inner->releaseReqH(comp_handle->innerPart);
+        if (ret == NIXL_SUCCESS) {
+            ret = part_ret;
+        }
+    }
+    if (comp_handle->buffer) {
+        putBuffer(comp_handle->buffer);
+    }
+
+    delete comp_handle;
+    return ret;
+}
+
+nixl_status_t nixlCompressEngine::getXferStats(const nixlBackendReqH* handle,
+                                               nixl_b_params_t &stats) const
+{
+    const nixlCompressBackendReqH *comp_handle = (const nixlCompressBackendReqH *) handle;
+    double ratio = comp_handle->wireBytes ?
+                   (double) comp_handle->origBytes / comp_handle->wireBytes : 1;
+    double gbps = comp_handle->compressUs ?
+                  comp_handle->origBytes / (comp_handle->compressUs * 1000) : 0;
+
+    stats["orig_bytes"] = std::to_string(comp_handle->origBytes);
+    stats["wire_bytes"] = std::to_string(comp_handle->wireBytes);
+    stats["ratio"] = std::to_string(ratio);
+    stats["compress_us"] = std::to_string(comp_handle->compressUs);
+    stats["compress_gbps"] = std::to_string(gbps);
+    stats["compressed_descs"] = std::to_string(comp_handle->compressedDescs);
+    stats["skipped_descs"] = std::to_string(comp_handle->skippedDescs);
+    return NIXL_SUCCESS;
+}
+
+bool nixlCompressEngine::decompressNotif(const std::string &msg, std::string &user_msg,
+                                         bool &has_user_msg)
+{
+    nixlCompressNotifHdr hdr;
+    size_t pos = 1;
+
+    if (msg.size() < pos + sizeof(hdr)) {
+        return false;
+    }
+    memcpy(&hdr, msg.data() + pos, sizeof(hdr));
+    pos += sizeof(hdr);
+    if (msg.size() - pos < hdr.msgLen) {
+        return false;
+    }
+    user_msg = msg.substr(pos, hdr.msgLen);
+    has_user_msg = hdr.hasMsg;
+    pos += hdr.msgLen;
+
+    for (uint32_t i = 0; i < hdr.blockCount; i++) {
+        nixlCompressBlockHdr block;
+
+        if (msg.size() - pos < sizeof(block)) {
+            return false;
+        }
+        memcpy(&block, msg.data() + pos, sizeof(block));
+        pos += sizeof(block);
+
+        if ((block.compLen > block.len) || !isLocalDram(block.addr, block.len)) {
+            return false;
+        }
+
+        if (decoders.size() <= block.codec) {
+            decoders.resize(block.codec + 1);
+        }
+        if (!decoders[block.codec]) {
+            decoders[block.codec] = nixlCompressCodecCreate(block.codec);
+            if (!decoders[block.codec]) {
+                std::cerr << "COMPRESS: codec " << (int) block.codec
+                          << " is not built in" << std::endl;
+                return false;
+            }
+        }
+
+        // The compressed form sits where the data goes
+        char *dst = (char*) block.addr;
+        scratch.resize(block.compLen);
+        memcpy(scratch.data(), dst, block.compLen);
+        if (!decoders[block.codec]->decompress(scratch.data(), block.compLen,
+                                               dst, block.len)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+nixl_status_t nixlCompressEngine::getNotifs(notif_list_t &notif_list)
+{
+    notif_list_t inner_list;
+    nixl_status_t ret = inner->getNotifs(inner_list);
+
+    if ((ret != NIXL_SUCCESS) || inner_list.empty()) {
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> guard(notifLock);
+    for (auto &notif : inner_list) {
+        std::string &msg = notif.second;
+
+        if (msg.empty()) {
+            continue;
+        }
+        if (msg[0] == NOTIF_PLAIN) {
+            notif_list.emplace_back(notif.first, msg.substr(1));
+            continue;
+        }
+
+        std::string user_msg;
+        bool has_user_msg = false;
+        if ((msg[0] != NOTIF_COMPRESSED) ||
+            !decompressNotif(msg, user_msg, has_user_msg)) {
+            // The data is not usable, so the transfer is not reported
+            std::cerr << "COMPRESS: dropped a malformed notification from "
+                      << notif.first << std::endl;
+            continue;
+        }
+        if (has_user_msg) {
+            notif_list.emplace_back(notif.first, std::move(user_msg));
+        }
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCompressEngine::genNotif(const std::string &remote_agent,
+                                           const std::string &msg)
+{
+    return inner->genNotif(remote_agent, NOTIF_PLAIN + msg);
+}
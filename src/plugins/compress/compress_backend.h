@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COMPRESS_BACKEND_H
+#define __COMPRESS_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "backend/backend_engine.h"
+#include "compress/compress_codec.h"
+
+// Registered with the inner engine, holds the compressed form of a post
+class nixlCompressBuffer {
+    public:
+        char *addr;
+        size_t size;
+        nixlBackendMD *md;
+        bool inUse;
+};
+
+class nixlCompressBackendReqH : public nixlBackendReqH {
+    public:
+        // Prepared at prepXfer for the whole lists, posted when nothing is
+        // compressed
+        nixlBackendReqH *innerAll;
+        // Prepared at each compressed post, with the compressed sizes
+        nixlBackendReqH *innerPart;
+        nixlBackendReqH *active;
+        nixl_meta_dlist_t partLocal;
+        nixl_meta_dlist_t partRemote;
+        nixlCompressBuffer *buffer;
+        bool compressible;
+
+        // Of the last post
+        size_t origBytes;
+        size_t wireBytes;
+        size_t compressedDescs;
+        size_t skippedDescs;
+        double compressUs;
+
+        nixlCompressBackendReqH() : partLocal(DRAM_SEG), partRemote(DRAM_SEG) {
+            innerAll = nullptr;
+            innerPart = nullptr;
+            active = nullptr;
+            buffer = nullptr;
+            compressible = false;
+            origBytes = 0;
+            wireBytes = 0;
+            compressedDescs = 0;
+            skippedDescs = 0;
+            compressUs = 0;
+        }
+        ~nixlCompressBackendReqH() { }
+};
+
+class nixlCompressEngine : public nixlBackendEngine {
+    private:
+        nixlBackendFactory *factory;
+        nixlBackendEngine *inner;
+
+        std::unique_ptr<nixlCompressCodec> codec;
+        double minRatio;
+        size_t minSize;
+        size_t sampleSize;
+        size_t poolSize;
+
+        // Compression buffers, kept registered for later posts
+        std::vector<std::unique_ptr<nixlCompressBuffer>> buffers;
+        size_t poolUsed;
+        std::mutex poolLock;
+
+        // Local DRAM the peers may decompress into, base -> end
+        std::map<uintptr_t, uintptr_t> dramRanges;
+        std::map<nixlBackendMD*, uintptr_t> dramByMD;
+        std::mutex rangeLock;
+
+        std::vector<std::unique_ptr<nixlCompressCodec>> decoders;
+        std::vector<char> scratch;
+        std::mutex notifLock;
+
+        nixlCompressBuffer *getBuffer(size_t size);
+        void putBuffer(nixlCompressBuffer *buffer);
+        bool isLocalDram(uintptr_t addr, size_t len);
+        bool decompressNotif(const std::string &msg, std::string &user_msg,
+                             bool &has_user_msg);
+        nixl_status_t postCompressed(const nixl_meta_dlist_t &local,
+                                     const nixl_meta_dlist_t &remote,
+                                     const std::string &remote_agent,
+                                     nixlCompressBackendReqH *handle,
+                                     const nixl_opt_b_args_t* opt_args);
+
+    public:
+        nixlCompressEngine(const nixlBackendInitParams* init_params);
+        ~nixlCompressEngine();
+
+        bool supportsRemote() const {
+            return inner && inner->supportsRemote();
+        }
+        bool supportsLocal() const {
+            return inner && inner->supportsLocal();
+        }
+        bool supportsNotif() const {
+            return inner && inner->supportsNotif();
+        }
+        bool supportsProgTh() const {
+            return inner && inner->supportsProgTh();
+        }
+        bool supportsConcurrentLoad() const {
+            return inner && inner->supportsConcurrentLoad();
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            return inner ? inner->getSupportedMems() : nixl_mem_list_t();
+        }
+
+        // Bandwidth as seen by the application, for data that compresses
+        // at min_ratio
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const;
+        nixl_status_t getPeerXferHints(const nixl_mem_t &local_mem,
+                                       const nixl_mem_t &remote_mem,
+                                       const std::string &remote_agent,
+                                       nixlBackendXferHints &hints) const;
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t connect(const std::string &remote_agent) {
+            return inner->connect(remote_agent);
+        }
+        nixl_status_t connectAgents(const std::vector<std::string> &remote_agents,
+                                    std::vector<nixl_status_t> &statuses) {
+            return inner->connectAgents(remote_agents, statuses);
+        }
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return inner->disconnect(remote_agent);
+        }
+
+        nixl_status_t getPublicData(const nixlBackendMD* meta,
+                                    std::string &str) const {
+            return inner->getPublicData(meta, str);
+        }
+        nixl_status_t getConnInfo(std::string &str) const {
+            return inner->getConnInfo(str);
+        }
+        nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                         const std::string &remote_conn_info) {
+            return inner->loadRemoteConnInfo(remote_agent, remote_conn_info);
+        }
+        nixl_status_t loadRemoteMD(const nixlBlobDesc &input,
+                                   const nixl_mem_t &nixl_mem,
+                                   const std::string &remote_agent,
+                                   nixlBackendMD* &output) {
+            return inner->loadRemoteMD(input, nixl_mem, remote_agent, output);
+        }
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output) {
+            return inner->loadLocalMD(input, output);
+        }
+        nixl_status_t unloadMD(nixlBackendMD* input) {
+            return inner->unloadMD(input);
+        }
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+
+        nixl_status_t getXferStats(const nixlBackendReqH* handle,
+                                   nixl_b_params_t &stats) const;
+
+        nixl_status_t getNotifs(notif_list_t &notif_list);
+        nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
+
+        int progress() {
+            return inner->progress();
+        }
+};
+#endif
@@ -15,7 +15,10 @@
  * limitations under the License.
  */
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
 #include <cufile.h>
 #include "gds_backend.h"
 #include "common/str_tools.h"
@@ -26,6 +29,8 @@
 #define DEFAULT_MAX_REQUEST_SIZE (16 * 1024 * 1024)  // 16MB
 /** Create a batch pool of size 32 */
 #define DEFAULT_BATCH_POOL_SIZE 32
+/** Direct IO alignment of file offsets and sizes */
+#define DEFAULT_IO_ALIGNMENT 4096
 
 nixlGdsEngine::nixlGdsEngine(const nixlBackendInitParams* init_params)
     : nixlBackendEngine(init_params)
@@ -36,6 +41,12 @@ nixlGdsEngine::nixlGdsEngine(const nixlBackendInitParams* init_params)
     batch_pool_size = DEFAULT_BATCH_POOL_SIZE;
     batch_limit = DEFAULT_BATCH_LIMIT;
     max_request_size = DEFAULT_MAX_REQUEST_SIZE;
+    submit_threads = 0;
+    submit_stop = false;
+    io_alignment = DEFAULT_IO_ALIGNMENT;
+    bounce_pool_size = 0;
+    bounce_area = nullptr;
+    size_t file_cache_size = 0;
 
     // Read custom parameters if available
     nixl_b_params_t* custom_params = init_params->customParams;
@@ -72,6 +83,55 @@ nixlGdsEngine::nixlGdsEngine(const nixlBackendInitParams* init_params)
                 return;
             }
         }
+
+        // Configure file_cache_size, unused file handles kept registered
+        if (custom_params->count("file_cache_size") > 0) {
+            try {
+                file_cache_size = std::stoul((*custom_params)["file_cache_size"]);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid file_cache_size parameter: " << e.what() << std::endl;
+                this->initErr = true;
+                return;
+            }
+        }
+
+        // Configure submit_threads
+        if (custom_params->count("submit_threads") > 0) {
+            try {
+                submit_threads = std::stoul((*custom_params)["submit_threads"]);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid submit_threads parameter: " << e.what() << std::endl;
+                this->initErr = true;
+                return;
+            }
+        }
+
+        // Configure bounce_pool_size, slots for unaligned request edges
+        if (custom_params->count("bounce_pool_size") > 0) {
+            try {
+                bounce_pool_size = std::stoul((*custom_params)["bounce_pool_size"]);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid bounce_pool_size parameter: " << e.what() << std::endl;
+                this->initErr = true;
+                return;
+            }
+        }
+
+        // Configure io_alignment, a power of two
+        if (custom_params->count("io_alignment") > 0) {
+            try {
+                io_alignment = std::stoul((*custom_params)["io_alignment"]);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid io_alignment parameter: " << e.what() << std::endl;
+                this->initErr = true;
+                return;
+            }
+            if ((io_alignment == 0) || (io_alignment & (io_alignment - 1))) {
+                std::cerr << "Invalid io_alignment parameter: not a power of two" << std::endl;
+                this->initErr = true;
+                return;
+            }
+        }
     }
 
     this->initErr = false;
@@ -79,12 +139,64 @@ nixlGdsEngine::nixlGdsEngine(const nixlBackendInitParams* init_params)
         this->initErr = true;
         return;
     }
+    gds_utils->setFileCacheSize(file_cache_size);
 
     // Initialize the batch pool
     for (unsigned int i = 0; i < batch_pool_size; i++) {
         batch_pool.push_back(new nixlGdsIOBatch(batch_limit));
     }
 
+    if (bounce_pool_size > 0) {
+        size_t slot_size = 2 * io_alignment;
+        void* area = nullptr;
+
+        if (posix_memalign(&area, io_alignment, bounce_pool_size * slot_size) != 0) {
+            std::cerr << "Failed to allocate the bounce pool" << std::endl;
+            this->initErr = true;
+            return;
+        }
+        bounce_area = (char*) area;
+        if (gds_utils->registerBufHandle(bounce_area, bounce_pool_size * slot_size,
+                                         0) != NIXL_SUCCESS) {
+            std::cerr << "Failed to register the bounce pool" << std::endl;
+            free(bounce_area);
+            bounce_area = nullptr;
+            this->initErr = true;
+            return;
+        }
+        for (unsigned int i = 0; i < bounce_pool_size; i++) {
+            bounce_free.push_back(bounce_area + i * slot_size);
+        }
+    }
+
+    for (unsigned int i = 0; i < submit_threads; i++) {
+        submit_pool.emplace_back(&nixlGdsEngine::submitFunc, this);
+    }
+}
+
+void nixlGdsEngine::submitFunc()
+{
+    std::unique_lock<std::mutex> lock(submit_lock);
+
+    while (true) {
+        submit_cv.wait(lock, [this]() {
+            return submit_stop || !submit_queue.empty();
+        });
+        if (submit_queue.empty()) {
+            return;
+        }
+
+        auto job = submit_queue.front();
+        submit_queue.pop_front();
+        lock.unlock();
+
+        if (job.second->submitBatch(0) != NIXL_SUCCESS) {
+            job.first->submit_err = true;
+        }
+        job.first->submit_pending--;
+
+        lock.lock();
+    }
 }
 
 nixl_status_t nixlGdsEngine::registerMem(const nixlBlobDesc &mem,
@@ -104,13 +216,16 @@ nixl_status_t nixlGdsEngine::registerMem(const nixlBlobDesc &mem,
                 md->handle = it->second;
                 md->handle.size = mem.len;
                 md->handle.metadata = mem.metaInfo;
+                gds_file_refs[mem.devId]++;
                 break;
             }
 
+            // Files registered before, even through another fd, are shared
             status = gds_utils->registerFileHandle(mem.devId, mem.len,
                                                    mem.metaInfo, md->handle);
             if (status == NIXL_SUCCESS) {
                 gds_file_map[mem.devId] = md->handle;
+                gds_file_refs[mem.devId] = 1;
             }
             break;
         }
@@ -158,8 +273,12 @@ nixl_status_t nixlGdsEngine::deregisterMem (nixlBackendMD* meta)
 {
     nixlGdsMetadata *md = (nixlGdsMetadata *)meta;
     if (md->type == FILE_SEG) {
-        gds_utils->deregisterFileHandle(md->handle);
-	gds_file_map.erase(md->handle.fd);
+        // The cuFile handle is dropped with the last registration of the fd
+        if (--gds_file_refs[md->handle.fd] == 0) {
+            gds_utils->deregisterFileHandle(md->handle);
+            gds_file_map.erase(md->handle.fd);
+            gds_file_refs.erase(md->handle.fd);
+        }
     } else {
         gds_utils->deregisterBufHandle(md->buf.base);
     }
@@ -209,6 +328,7 @@ nixl_status_t nixlGdsEngine::prepXfer (const nixl_xfer_op_t &operation,
         if (is_local_file) {
             base_addr = (void*)remote[i].addr;
             if (!base_addr) {
+                releaseBounces(gds_handle);
                 delete gds_handle;
                 return NIXL_ERR_INVALID_PARAM;
             }
@@ -218,6 +338,7 @@ nixl_status_t nixlGdsEngine::prepXfer (const nixl_xfer_op_t &operation,
             auto it = gds_file_map.find(local[i].devId);
             if (it == gds_file_map.end()) {
                 std::cerr << "File handle not found\n";
+                releaseBounces(gds_handle);
                 delete gds_handle;
                 return NIXL_ERR_NOT_FOUND;
             }
@@ -225,6 +346,7 @@ nixl_status_t nixlGdsEngine::prepXfer (const nixl_xfer_op_t &operation,
         } else {
             base_addr = (void*)local[i].addr;
             if (!base_addr) {
+                releaseBounces(gds_handle);
                 delete gds_handle;
                 return NIXL_ERR_INVALID_PARAM;
             }
@@ -234,38 +356,55 @@ nixl_status_t nixlGdsEngine::prepXfer (const nixl_xfer_op_t &operation,
             auto it = gds_file_map.find(remote[i].devId);
             if (it == gds_file_map.end()) {
                 std::cerr << "File handle not found\n";
+                releaseBounces(gds_handle);
                 delete gds_handle;
                 return NIXL_ERR_NOT_FOUND;
             }
             fh = it->second;
         }
 
-        // Split large transfers into multiple requests
-        size_t remaining_size = total_size;
-        size_t current_offset = 0;
+        addRequests(gds_handle, base_addr, total_size, base_offset, fh.cu_fhandle,
+                    (operation == NIXL_READ) ? CUFILE_READ : CUFILE_WRITE,
+                    (is_local_file ? remote.getType() : local.getType()) == VRAM_SEG);
+    }
 
-        while (remaining_size > 0) {
-            size_t request_size = std::min(remaining_size,
-                                       (size_t)max_request_size);
+    // Validate that we have requests before proceeding
+    if (gds_handle->request_list.empty() && gds_handle->edges.empty()) {
+        delete gds_handle;
+        return NIXL_ERR_INVALID_PARAM;
+    }
 
-            GdsTransferRequestH req;
-            req.addr = (char*)base_addr + current_offset;
-            req.size = request_size;
-            req.file_offset = base_offset + current_offset;
-            req.fh = fh.cu_fhandle;
-            req.op = (operation == NIXL_READ) ? CUFILE_READ : CUFILE_WRITE;
+    // Fill the batches once, every post of this handle submits them as is
+    const auto& request_list = gds_handle->request_list;
+    size_t current_req = 0;
+    size_t max_batch = batch_limit;
 
-            gds_handle->request_list.push_back(req);
+    // With submission threads, make at least one batch per thread
+    if (submit_threads > 0) {
+        max_batch = (request_list.size() + submit_threads - 1) / submit_threads;
+        max_batch = std::max((size_t)1, std::min(max_batch, (size_t)batch_limit));
+    }
 
-            remaining_size -= request_size;
-            current_offset += request_size;
+    while (current_req < request_list.size()) {
+        size_t batch_size = std::min(request_list.size() - current_req,
+                                     max_batch);
+        nixl_status_t status = createBatch(request_list, current_req,
+                                           batch_size, gds_handle->batch_io_list);
+        if (status != NIXL_SUCCESS) {
+            releaseBatches(gds_handle);
+            releaseBounces(gds_handle);
+            delete gds_handle;
+            return status;
         }
+        current_req += batch_size;
     }
 
-    // Validate that we have requests before proceeding
-    if (gds_handle->request_list.empty()) {
+    nixl_status_t status = createEdgeRounds(gds_handle);
+    if (status != NIXL_SUCCESS) {
+        releaseBatches(gds_handle);
+        releaseBounces(gds_handle);
         delete gds_handle;
-        return NIXL_ERR_INVALID_PARAM;
+        return status;
     }
 
     gds_handle->needs_prep = false;  // Just prepared, no need for prep
@@ -273,21 +412,336 @@ nixl_status_t nixlGdsEngine::prepXfer (const nixl_xfer_op_t &operation,
     return NIXL_SUCCESS;
 }
 
+bool nixlGdsEngine::getBounceSlots(size_t cnt, char** slots)
+{
+    std::lock_guard<std::mutex> guard(bounce_lock);
+
+    if (bounce_free.size() < cnt) {
+        return false;
+    }
+    for (size_t i = 0; i < cnt; i++) {
+        slots[i] = bounce_free.back();
+        bounce_free.pop_back();
+    }
+    return true;
+}
+
+void nixlGdsEngine::releaseBounces(nixlGdsBackendReqH* gds_handle)
+{
+    std::lock_guard<std::mutex> guard(bounce_lock);
+
+    for (auto& edge : gds_handle->edges) {
+        bounce_free.push_back(edge.bounce);
+    }
+    gds_handle->edges.clear();
+}
+
+void nixlGdsEngine::addRequests(nixlGdsBackendReqH* gds_handle, void* addr,
+                                size_t size, size_t file_offset,
+                                CUfileHandle_t fh, CUfileOpcode_t op,
+                                bool is_vram)
+{
+    size_t mask = io_alignment - 1;
+    size_t head = 0;
+    size_t tail = 0;
+    size_t max_size = max_request_size;
+    char* slots[2];
+
+    if (bounce_area && (size > 0)) {
+        size_t body_start = (file_offset + mask) & ~mask;
+        size_t body_end = (file_offset + size) & ~mask;
+
+        if (body_start >= body_end) {
+            // Within two blocks, all of it goes through one slot
+            head = size;
+        } else {
+            head = body_start - file_offset;
+            tail = file_offset + size - body_end;
+        }
+
+        size_t cnt = (head > 0) + (tail > 0);
+        if ((cnt > 0) && !getBounceSlots(cnt, slots)) {
+            // Out of slots, the driver deals with the unaligned request
+            head = 0;
+            tail = 0;
+        }
+        // Body pieces stay aligned
+        max_size = std::max(io_alignment, max_size & ~mask);
+    }
+
+    size_t slot = 0;
+    auto add_edge = [&](size_t offset, size_t len) {
+        GdsBounceEdgeH edge;
+
+        edge.addr = (char*)addr + offset;
+        edge.size = len;
+        edge.file_offset = file_offset + offset;
+        edge.win_offset = edge.file_offset & ~mask;
+        edge.win_size = ((edge.file_offset + len + mask) & ~mask) - edge.win_offset;
+        edge.bounce = slots[slot++];
+        edge.fh = fh;
+        edge.op = op;
+        edge.is_vram = is_vram;
+        gds_handle->edges.push_back(edge);
+
+        if (op == CUFILE_READ) {
+            gds_handle->request_list.emplace_back(edge.bounce, edge.win_size,
+                                                  edge.win_offset, fh, op);
+        }
+    };
+
+    if (head > 0) {
+        add_edge(0, head);
+    }
+
+    // Split large transfers into multiple requests
+    size_t current_offset = head;
+    size_t remaining_size = size - head - tail;
+
+    while (remaining_size > 0) {
+        size_t request_size = std::min(remaining_size, max_size);
+
+        gds_handle->request_list.emplace_back((char*)addr + current_offset,
+                                              request_size,
+                                              file_offset + current_offset,
+                                              fh, op);
+        remaining_size -= request_size;
+        current_offset += request_size;
+    }
+
+    if (tail > 0) {
+        add_edge(size - tail, tail);
+    }
+}
+
+static nixl_status_t copyEdge(void* dst, const void* src, size_t size, bool is_vram)
+{
+    if (!is_vram) {
+        memcpy(dst, src, size);
+        return NIXL_SUCCESS;
+    }
+
+    cudaError_t error_id = cudaMemcpy(dst, src, size, cudaMemcpyDefault);
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaMemcpy returned " << cudaGetErrorString(error_id) << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+    return NIXL_SUCCESS;
+}
+
+// Groups the write edges in rounds of one batch. An edge goes after the
+// rounds of the edges before it sharing one of its blocks, so writes of
+// the same block land in the order of the descriptors.
+nixl_status_t nixlGdsEngine::createEdgeRounds(nixlGdsBackendReqH* gds_handle)
+{
+    // One past the last round writing each block of a file
+    std::map<std::pair<CUfileHandle_t, size_t>, size_t> block_round;
+    auto& rounds = gds_handle->edge_rounds;
+
+    for (size_t i = 0; i < gds_handle->edges.size(); i++) {
+        const auto& edge = gds_handle->edges[i];
+        size_t win_end = edge.win_offset + edge.win_size;
+        size_t round = 0;
+
+        if (edge.op != CUFILE_WRITE) {
+            continue;
+        }
+
+        for (size_t block = edge.win_offset; block < win_end; block += io_alignment) {
+            auto it = block_round.find(std::make_pair(edge.fh, block));
+            if (it != block_round.end()) {
+                round = std::max(round, it->second);
+            }
+        }
+        while ((round < rounds.size()) && (rounds[round].edges.size() >= batch_limit)) {
+            round++;
+        }
+        if (round == rounds.size()) {
+            GdsEdgeRoundH new_round;
+
+            new_round.read_batch = getBatchFromPool(batch_limit);
+            new_round.write_batch = getBatchFromPool(batch_limit);
+            rounds.push_back(new_round);
+        }
+
+        if (rounds[round].read_batch->addToBatch(edge.fh, edge.bounce, edge.win_size,
+                                                 edge.win_offset, 0,
+                                                 CUFILE_READ) != NIXL_SUCCESS) {
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        rounds[round].edges.push_back(i);
+        rounds[round].lens.push_back(0);
+
+        for (size_t block = edge.win_offset; block < win_end; block += io_alignment) {
+            block_round[std::make_pair(edge.fh, block)] = round + 1;
+        }
+    }
+    return NIXL_SUCCESS;
+}
+
+// Steps the write edges through their rounds without blocking. The blocks
+// around an edge are read, patched and written back. Nothing is undone on
+// an error, the blocks of the failed round may be partially written.
+nixl_status_t nixlGdsEngine::writeEdges(nixlGdsBackendReqH* gds_handle)
+{
+    auto& rounds = gds_handle->edge_rounds;
+
+    while (gds_handle->edge_round < rounds.size()) {
+        GdsEdgeRoundH& round = rounds[gds_handle->edge_round];
+        nixlGdsIOBatch* batch = gds_handle->edge_writing ? round.write_batch :
+                                                           round.read_batch;
+        nixl_status_t status = batch->checkStatus();
+
+        if (status == NIXL_IN_PROG) {
+            return status;
+        }
+        if (status < 0) {
+            std::cerr << "Error in the blocks of an unaligned write" << std::endl;
+            return NIXL_ERR_BACKEND;
+        }
+
+        if (gds_handle->edge_writing) {
+            for (size_t i = 0; i < round.edges.size(); i++) {
+                if (batch->getResult(i) != (ssize_t) round.lens[i]) {
+                    std::cerr << "Error writing the blocks of an unaligned write"
+                              << std::endl;
+                    return NIXL_ERR_BACKEND;
+                }
+            }
+
+            gds_handle->edge_writing = false;
+            gds_handle->edge_round++;
+            if (gds_handle->edge_round < rounds.size()) {
+                nixlGdsIOBatch* next = rounds[gds_handle->edge_round].read_batch;
+
+                next->rearm();
+                if (next->submitBatch(0) != NIXL_SUCCESS) {
+                    gds_handle->edge_round = rounds.size();
+                    return NIXL_ERR_BACKEND;
+                }
+            }
+            continue;
+        }
+
+        round.write_batch->reset();
+        for (size_t i = 0; i < round.edges.size(); i++) {
+            const GdsBounceEdgeH& edge = gds_handle->edges[round.edges[i]];
+            ssize_t ret = batch->getResult(i);
+
+            if (ret < 0) {
+                std::cerr << "Error reading the blocks of an unaligned write" << std::endl;
+                gds_handle->edge_round = rounds.size();
+                return NIXL_ERR_BACKEND;
+            }
+            size_t valid = ret;
+            if (valid < edge.win_size) {
+                memset(edge.bounce + valid, 0, edge.win_size - valid);
+            }
+
+            size_t pos = edge.file_offset - edge.win_offset;
+            if (copyEdge(edge.bounce + pos, edge.addr, edge.size,
+                         edge.is_vram) != NIXL_SUCCESS) {
+                gds_handle->edge_round = rounds.size();
+                return NIXL_ERR_BACKEND;
+            }
+
+            // Past the end of file only the new data is written, to not grow
+            // the file by the padding
+            size_t len = edge.win_size;
+            if (valid < edge.win_size) {
+                len = std::max(valid, pos + edge.size);
+            }
+            round.lens[i] = len;
+            round.write_batch->addToBatch(edge.fh, edge.bounce, len,
+                                          edge.win_offset, 0, CUFILE_WRITE);
+        }
+
+        if (round.write_batch->submitBatch(0) != NIXL_SUCCESS) {
+            gds_handle->edge_round = rounds.size();
+            return NIXL_ERR_BACKEND;
+        }
+        gds_handle->edge_writing = true;
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlGdsEngine::readEdges(nixlGdsBackendReqH* gds_handle)
+{
+    for (auto& edge : gds_handle->edges) {
+        if (edge.op != CUFILE_READ) {
+            continue;
+        }
+
+        size_t pos = edge.file_offset - edge.win_offset;
+        if (copyEdge(edge.addr, edge.bounce + pos, edge.size,
+                     edge.is_vram) != NIXL_SUCCESS) {
+            return NIXL_ERR_BACKEND;
+        }
+    }
+    return NIXL_SUCCESS;
+}
+
 nixlGdsIOBatch* nixlGdsEngine::getBatchFromPool(unsigned int size) {
     // Use a pre-allocated batch if available
-    if (!batch_pool.empty()) {
-        nixlGdsIOBatch* batch = batch_pool.back();
-        batch_pool.pop_back();
-        batch->reset();
-        return batch;
-    }
-    // Return nullptr if pool is empty - don't create new batches in the data path
-    return nullptr;
+    {
+        std::lock_guard<std::mutex> guard(batch_pool_lock);
+        if (!batch_pool.empty()) {
+            nixlGdsIOBatch* batch = batch_pool.back();
+            batch_pool.pop_back();
+            batch->reset();
+            return batch;
+        }
+    }
+    // Batches are only taken at prepXfer, out of the data path
+    return new nixlGdsIOBatch(batch_limit);
 }
 
 void nixlGdsEngine::returnBatchToPool(nixlGdsIOBatch* batch) {
     // Only keep up to batch_pool_size batches
-        batch_pool.push_back(batch);
+    {
+        std::lock_guard<std::mutex> guard(batch_pool_lock);
+        if (batch_pool.size() < batch_pool_size) {
+            batch_pool.push_back(batch);
+            return;
+        }
+    }
+    delete batch;
+}
+
+void nixlGdsEngine::releaseBatches(nixlGdsBackendReqH* gds_handle) {
+    // The submission threads must be done with this handle
+    while (gds_handle->submit_pending > 0) {
+        std::this_thread::yield();
+    }
+
+    if (gds_handle->posted) {
+        cancelXfer(gds_handle);
+    }
+
+    for (auto* batch : gds_handle->batch_io_list) {
+        returnBatchToPool(batch);
+    }
+    gds_handle->batch_io_list.clear();
+    for (auto& round : gds_handle->edge_rounds) {
+        returnBatchToPool(round.read_batch);
+        returnBatchToPool(round.write_batch);
+    }
+    gds_handle->edge_rounds.clear();
+}
+
+// Stops the batches of a post not completed yet
+void nixlGdsEngine::cancelXfer(nixlGdsBackendReqH* gds_handle)
+{
+    auto& batches = gds_handle->batch_io_list;
+
+    for (size_t i = gds_handle->batch_done; i < batches.size(); i++) {
+        batches[i]->cancelBatch();
+    }
+    if (gds_handle->edge_round < gds_handle->edge_rounds.size()) {
+        GdsEdgeRoundH& round = gds_handle->edge_rounds[gds_handle->edge_round];
+        (gds_handle->edge_writing ? round.write_batch : round.read_batch)->cancelBatch();
+    }
+    gds_handle->posted = false;
 }
 
 nixl_status_t nixlGdsEngine::postXfer(const nixl_xfer_op_t &operation,
@@ -300,46 +754,167 @@ nixl_status_t nixlGdsEngine::postXfer(const nixl_xfer_op_t &operation,
     nixlGdsBackendReqH* gds_handle = (nixlGdsBackendReqH*)handle;
 
     // Validate request_list before proceeding
-    if (gds_handle->request_list.empty()) {
+    if (gds_handle->request_list.empty() && gds_handle->edges.empty()) {
         std::cerr << "Empty request list" << std::endl;
         return NIXL_ERR_INVALID_PARAM;
     }
 
-    // Process requests in batches
-    const auto& request_list = gds_handle->request_list;
-    size_t current_req = 0;
+    if (gds_handle->posted || gds_handle->async_posted) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
 
-    while (current_req < request_list.size()) {
-        size_t batch_size = std::min(request_list.size() - current_req,
-                                     (size_t)batch_limit);
-        nixl_status_t status = createAndSubmitBatch(request_list, current_req,
-                                                    batch_size, gds_handle->batch_io_list);
+    if (opt_args && opt_args->cudaStream) {
+        if (!gds_handle->edges.empty()) {
+            std::cerr << "Stream ordered GDS transfers need aligned requests" << std::endl;
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+        return postXferAsync(gds_handle, (cudaStream_t) opt_args->cudaStream,
+                             (cudaEvent_t) opt_args->cudaEvent);
+    }
 
-        if (status != NIXL_SUCCESS) {
-            // Clean up on error
+    gds_handle->batch_done = 0;
+    gds_handle->edge_writing = false;
+    gds_handle->edge_round = gds_handle->edge_rounds.size();
+
+    // The edge windows do not overlap the body, both go out at once
+    if (!gds_handle->edge_rounds.empty()) {
+        nixlGdsIOBatch* batch = gds_handle->edge_rounds[0].read_batch;
+
+        batch->rearm();
+        if (batch->submitBatch(0) != NIXL_SUCCESS) {
+            return NIXL_ERR_BACKEND;
+        }
+        gds_handle->edge_round = 0;
+    }
+
+    if (!submit_pool.empty()) {
+        gds_handle->submit_err = false;
+        gds_handle->submit_pending = gds_handle->batch_io_list.size();
+        {
+            std::lock_guard<std::mutex> guard(submit_lock);
             for (auto* batch : gds_handle->batch_io_list) {
-                batch->cancelBatch();
-                returnBatchToPool(batch);
+                batch->rearm();
+                submit_queue.emplace_back(gds_handle, batch);
             }
-            gds_handle->batch_io_list.clear();
-            return status;
         }
-        current_req += batch_size;
+        submit_cv.notify_all();
+        gds_handle->posted = true;
+        return NIXL_IN_PROG;
     }
 
+    for (size_t i = 0; i < gds_handle->batch_io_list.size(); i++) {
+        nixlGdsIOBatch* batch = gds_handle->batch_io_list[i];
+
+        batch->rearm();
+        if (batch->submitBatch(0) != NIXL_SUCCESS) {
+            // Stop the batches already in flight
+            for (size_t j = 0; j < i; j++) {
+                gds_handle->batch_io_list[j]->cancelBatch();
+            }
+            if (!gds_handle->edge_rounds.empty()) {
+                gds_handle->edge_rounds[0].read_batch->cancelBatch();
+            }
+            return NIXL_ERR_BACKEND;
+        }
+    }
+
+    gds_handle->posted = true;
     return NIXL_IN_PROG;
 }
 
-nixl_status_t nixlGdsEngine::createAndSubmitBatch(const std::vector<GdsTransferRequestH>& requests,
-                                                  size_t start_idx, size_t batch_size,
-                                                  std::vector<nixlGdsIOBatch*>& batch_list)
+nixl_status_t nixlGdsEngine::postXferAsync(nixlGdsBackendReqH* gds_handle,
+                                           cudaStream_t stream, cudaEvent_t event)
 {
-    nixlGdsIOBatch* batch = getBatchFromPool(batch_size);
-    if (!batch) {
-        std::cerr << "GDS batch pool exhausted" << std::endl;
+#ifdef HAVE_CUFILE_ASYNC
+    const auto& request_list = gds_handle->request_list;
+    size_t cnt = request_list.size();
+    cudaError_t error_id;
+
+    if (!gds_handle->async_event) {
+        error_id = cudaEventCreateWithFlags(&gds_handle->async_event,
+                                            cudaEventDisableTiming);
+        if (error_id != cudaSuccess) {
+            std::cerr << "cudaEventCreate returned " << cudaGetErrorString(error_id) << std::endl;
+            gds_handle->async_event = nullptr;
+            return NIXL_ERR_BACKEND;
+        }
+    }
+
+    gds_handle->async_size.resize(cnt);
+    gds_handle->async_file_offset.resize(cnt);
+    gds_handle->async_buf_offset.resize(cnt);
+    gds_handle->async_done.assign(cnt, 0);
+
+    for (size_t i = 0; i < cnt; i++) {
+        const auto& req = request_list[i];
+        CUfileError_t err;
+
+        gds_handle->async_size[i] = req.size;
+        gds_handle->async_file_offset[i] = req.file_offset;
+        gds_handle->async_buf_offset[i] = 0;
+
+        if (req.op == CUFILE_READ) {
+            err = cuFileReadAsync(req.fh, req.addr, &gds_handle->async_size[i],
+                                  &gds_handle->async_file_offset[i],
+                                  &gds_handle->async_buf_offset[i],
+                                  &gds_handle->async_done[i], (CUstream) stream);
+        } else {
+            err = cuFileWriteAsync(req.fh, req.addr, &gds_handle->async_size[i],
+                                   &gds_handle->async_file_offset[i],
+                                   &gds_handle->async_buf_offset[i],
+                                   &gds_handle->async_done[i], (CUstream) stream);
+        }
+        if (err.err != CU_FILE_SUCCESS) {
+            // IOs already queued still run, wait for them to not leave
+            // the stream reading released parameters
+            std::cerr << "Error in cuFile async submission" << std::endl;
+            cudaStreamSynchronize(stream);
+            return NIXL_ERR_BACKEND;
+        }
+    }
+
+    cudaEventRecord(gds_handle->async_event, stream);
+    if (event) {
+        cudaEventRecord(event, stream);
+    }
+
+    gds_handle->async_posted = true;
+    return NIXL_IN_PROG;
+#else
+    std::cerr << "Stream ordered GDS transfers need cuFile async support" << std::endl;
+    return NIXL_ERR_NOT_SUPPORTED;
+#endif
+}
+
+nixl_status_t nixlGdsEngine::checkXferAsync(nixlGdsBackendReqH* gds_handle)
+{
+    cudaError_t error_id = cudaEventQuery(gds_handle->async_event);
+
+    if (error_id == cudaErrorNotReady) {
+        return NIXL_IN_PROG;
+    }
+
+    gds_handle->async_posted = false;
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaEventQuery returned " << cudaGetErrorString(error_id) << std::endl;
         return NIXL_ERR_BACKEND;
     }
 
+    for (size_t i = 0; i < gds_handle->async_done.size(); i++) {
+        if ((gds_handle->async_done[i] < 0) ||
+            ((size_t) gds_handle->async_done[i] != gds_handle->async_size[i])) {
+            return NIXL_ERR_BACKEND;
+        }
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlGdsEngine::createBatch(const std::vector<GdsTransferRequestH>& requests,
+                                         size_t start_idx, size_t batch_size,
+                                         std::vector<nixlGdsIOBatch*>& batch_list)
+{
+    nixlGdsIOBatch* batch = getBatchFromPool(batch_size);
+
     // Add all requests to batch
     for (size_t i = 0; i < batch_size; i++) {
         const auto& req = requests[start_idx + i];
@@ -356,12 +931,6 @@ nixl_status_t nixlGdsEngine::createAndSubmitBatch(const std::vector<GdsTransferR
         }
     }
 
-    nixl_status_t status = batch->submitBatch(0);
-    if (status != NIXL_SUCCESS) {
-        returnBatchToPool(batch);
-        return NIXL_ERR_BACKEND;
-    }
-
     batch_list.push_back(batch);
     return NIXL_SUCCESS;
 }
@@ -370,28 +939,52 @@ nixl_status_t nixlGdsEngine::checkXfer(nixlBackendReqH* handle)
 {
     nixlGdsBackendReqH *gds_handle = (nixlGdsBackendReqH *)handle;
 
-    if (gds_handle->batch_io_list.empty()) {
-        gds_handle->needs_prep = true;
+    if (gds_handle->async_posted) {
+        return checkXferAsync(gds_handle);
+    }
+
+    if (!gds_handle->posted) {
         return NIXL_SUCCESS;
     }
 
-    nixl_status_t status = NIXL_SUCCESS;
-    for (auto* batch : gds_handle->batch_io_list) {
-        status = batch->checkStatus();
+    // Nothing to poll before every batch is submitted
+    if (gds_handle->submit_pending > 0) {
+        return NIXL_IN_PROG;
+    }
+    if (gds_handle->submit_err) {
+        cancelXfer(gds_handle);
+        return NIXL_ERR_BACKEND;
+    }
+
+    nixl_status_t edge_status = writeEdges(gds_handle);
+    if (edge_status < 0) {
+        cancelXfer(gds_handle);
+        return edge_status;
+    }
+
+    // Batches complete in any order, but only the first pending one is
+    // polled until it is done, completed ones are never polled again
+    auto& batches = gds_handle->batch_io_list;
+    while (gds_handle->batch_done < batches.size()) {
+        nixl_status_t status = batches[gds_handle->batch_done]->checkStatus();
 
         if (status == NIXL_IN_PROG) {
             return status;
         }
 
         if (status < 0) {
-            batch->cancelBatch();
+            cancelXfer(gds_handle);
+            return status;
         }
-        returnBatchToPool(batch);
+        gds_handle->batch_done++;
     }
 
-    gds_handle->batch_io_list.clear();
-    gds_handle->needs_prep = true;
-    return status;
+    if (edge_status == NIXL_IN_PROG) {
+        return edge_status;
+    }
+
+    gds_handle->posted = false;
+    return readEdges(gds_handle);
 }
 
 nixl_status_t nixlGdsEngine::releaseReqH(nixlBackendReqH* handle)
@@ -399,6 +992,13 @@ nixl_status_t nixlGdsEngine::releaseReqH(nixlBackendReqH* handle)
 
     nixlGdsBackendReqH *gds_handle = (nixlGdsBackendReqH *) handle;
 
+    releaseBatches(gds_handle);
+    releaseBounces(gds_handle);
+    if (gds_handle->async_event) {
+        // The stream may still be running IOs pointing into the handle
+        cudaEventSynchronize(gds_handle->async_event);
+        cudaEventDestroy(gds_handle->async_event);
+    }
     delete gds_handle;
     gds_handle = nullptr;
 
@@ -406,6 +1006,15 @@ nixl_status_t nixlGdsEngine::releaseReqH(nixlBackendReqH* handle)
 }
 
 nixlGdsEngine::~nixlGdsEngine() {
+    {
+        std::lock_guard<std::mutex> guard(submit_lock);
+        submit_stop = true;
+    }
+    submit_cv.notify_all();
+    for (auto& t : submit_pool) {
+        t.join();
+    }
+
     // Clean up the batch pool
     for (auto* batch : batch_pool) {
         if (batch) {
@@ -415,6 +1024,11 @@ nixlGdsEngine::~nixlGdsEngine() {
     }
     batch_pool.clear();
 
+    if (bounce_area) {
+        gds_utils->deregisterBufHandle(bounce_area);
+        free(bounce_area);
+    }
+
     if (gds_utils) {
         gds_utils->closeGdsDriver();
         delete gds_utils;
@@ -25,6 +25,11 @@
 #include <fcntl.h>
 #include <list>
 #include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include "gds_utils.h"
 #include "backend/backend_engine.h"
 
@@ -66,13 +71,68 @@ class GdsTransferRequestH {
         }
 };
 
+// Unaligned head or tail of a request, staged through a bounce slot that
+// holds the aligned file window around it
+class GdsBounceEdgeH {
+    public:
+        void*           addr;
+        size_t          size;
+        size_t          file_offset;
+        size_t          win_offset;
+        size_t          win_size;
+        char*           bounce;
+        CUfileHandle_t  fh;
+        CUfileOpcode_t  op;
+        bool            is_vram;
+};
+
+// Write edges whose windows do not share a block, read, patched and
+// written back together. The rounds of a handle run one after the other.
+class GdsEdgeRoundH {
+    public:
+        std::vector<size_t>  edges;     // Indices in the edges of the handle
+        std::vector<size_t>  lens;      // Written back, set once read
+        nixlGdsIOBatch*      read_batch;
+        nixlGdsIOBatch*      write_batch;
+};
+
 class nixlGdsBackendReqH : public nixlBackendReqH {
     public:
         std::vector<GdsTransferRequestH> request_list;
+        // Reads copy out of the bounce slots on completion, writes read,
+        // patch and write back their windows while the body is in flight
+        std::vector<GdsBounceEdgeH> edges;
+        std::vector<GdsEdgeRoundH> edge_rounds;
+        // Round in progress since the last post, and its step
+        size_t edge_round;
+        bool edge_writing;
+        // Filled at prepXfer and kept with the handle, a repost resubmits them
         std::vector<nixlGdsIOBatch*> batch_io_list;
+        // Batches before this index completed since the last post
+        size_t batch_done;
+        bool posted;
         bool needs_prep;
+        // Batches handed to the submission threads and not submitted yet
+        std::atomic<size_t> submit_pending;
+        std::atomic<bool> submit_err;
+        // Stream ordered posts, cuFile reads the parameters when the stream
+        // runs the IO, so they live with the handle
+        std::vector<size_t> async_size;
+        std::vector<off_t> async_file_offset;
+        std::vector<off_t> async_buf_offset;
+        std::vector<ssize_t> async_done;
+        cudaEvent_t async_event;
+        bool async_posted;
 
         nixlGdsBackendReqH() {
+            async_event = nullptr;
+            async_posted = false;
+            submit_pending = 0;
+            submit_err = false;
+            batch_done = 0;
+            edge_round = 0;
+            edge_writing = false;
+            posted = false;
             needs_prep = true;
         }
         ~nixlGdsBackendReqH() {
@@ -87,16 +147,49 @@ class nixlGdsEngine : public nixlBackendEngine {
     private:
         gdsUtil *gds_utils;
         std::unordered_map<int, gdsFileHandle> gds_file_map;
+        std::unordered_map<int, unsigned int> gds_file_refs; // Registrations per fd
         std::list<nixlGdsIOBatch*> batch_pool;
+        std::mutex batch_pool_lock;    // Transfers can be posted concurrently
         unsigned int batch_pool_size;  // Renamed from pool_size
         unsigned int batch_limit;      // Added for configurable batch limit
         unsigned int max_request_size; // Added for configurable request size
 
+        // Bounce slots of two aligned blocks for the unaligned edges of
+        // requests, one registered area. Disabled when bounce_area is null.
+        size_t io_alignment;
+        unsigned int bounce_pool_size;
+        char* bounce_area;
+        std::vector<char*> bounce_free;
+        std::mutex bounce_lock;
+        bool getBounceSlots(size_t cnt, char** slots);
+        void releaseBounces(nixlGdsBackendReqH* gds_handle);
+        void addRequests(nixlGdsBackendReqH* gds_handle, void* addr, size_t size,
+                         size_t file_offset, CUfileHandle_t fh,
+                         CUfileOpcode_t op, bool is_vram);
+        nixl_status_t createEdgeRounds(nixlGdsBackendReqH* gds_handle);
+        nixl_status_t writeEdges(nixlGdsBackendReqH* gds_handle);
+        nixl_status_t readEdges(nixlGdsBackendReqH* gds_handle);
+
+        // Optional submission threads, a post spreads its batches over them
+        unsigned int submit_threads;
+        std::vector<std::thread> submit_pool;
+        std::deque<std::pair<nixlGdsBackendReqH*, nixlGdsIOBatch*>> submit_queue;
+        std::mutex submit_lock;
+        std::condition_variable submit_cv;
+        bool submit_stop;
+        void submitFunc();
+
+        nixl_status_t postXferAsync(nixlGdsBackendReqH* gds_handle,
+                                    cudaStream_t stream, cudaEvent_t event);
+        nixl_status_t checkXferAsync(nixlGdsBackendReqH* gds_handle);
+
         nixlGdsIOBatch* getBatchFromPool(unsigned int size);
         void returnBatchToPool(nixlGdsIOBatch* batch);
-        nixl_status_t createAndSubmitBatch(const std::vector<GdsTransferRequestH>& requests,
-                                           size_t start_idx, size_t batch_size,
-                                           std::vector<nixlGdsIOBatch*>& batch_list);
+        void releaseBatches(nixlGdsBackendReqH* gds_handle);
+        void cancelXfer(nixlGdsBackendReqH* gds_handle);
+        nixl_status_t createBatch(const std::vector<GdsTransferRequestH>& requests,
+                                  size_t start_idx, size_t batch_size,
+                                  std::vector<nixlGdsIOBatch*>& batch_list);
         nixl_status_t createBatches(const nixl_xfer_op_t &operation,
                                    const nixl_meta_dlist_t &local,
                                    const nixl_meta_dlist_t &remote,
@@ -130,6 +223,17 @@ class nixlGdsEngine : public nixlBackendEngine {
             return mems;
         }
 
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if (((local_mem != DRAM_SEG) && (local_mem != VRAM_SEG)) ||
+                (remote_mem != FILE_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            hints.bandwidthGBps = (local_mem == VRAM_SEG) ? 10 : 6;
+            hints.latencyUs     = 50;
+            return NIXL_SUCCESS;
+        }
+
         nixl_status_t connect(const std::string &remote_agent) {
             return NIXL_SUCCESS;
         }
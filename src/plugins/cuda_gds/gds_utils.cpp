@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <cstring>
 #include "gds_utils.h"
 
 nixl_status_t gdsUtil::registerFileHandle(int fd,
@@ -22,17 +23,11 @@ nixl_status_t gdsUtil::registerFileHandle(int fd,
                                           std::string metaInfo,
                                           gdsFileHandle& gds_handle)
 {
-    CUfileError_t status;
-    CUfileDescr_t descr;
     CUfileHandle_t handle;
 
-    descr.handle.fd = fd;
-    descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
-
-    status = cuFileHandleRegister(&handle, &descr);
-    if (status.err != CU_FILE_SUCCESS) {
-        std::cerr << "file register error:" << std::endl;
-        return NIXL_ERR_BACKEND;
+    nixl_status_t status = fileCache.acquire(fd, handle);
+    if (status != NIXL_SUCCESS) {
+        return status;
     }
 
     gds_handle.cu_fhandle = handle;
@@ -70,12 +65,14 @@ nixl_status_t gdsUtil::openGdsDriver()
 
 void gdsUtil::closeGdsDriver()
 {
+    // Idle cached handles go before the driver
+    fileCache.setMaxIdle(0);
     cuFileDriverClose();
 }
 
 void gdsUtil::deregisterFileHandle(gdsFileHandle& handle)
 {
-    cuFileHandleDeregister(handle.cu_fhandle);
+    fileCache.release(handle.cu_fhandle);
 }
 
 nixl_status_t gdsUtil::deregisterBufHandle(void *ptr)
@@ -90,6 +87,101 @@ nixl_status_t gdsUtil::deregisterBufHandle(void *ptr)
     return NIXL_SUCCESS;
 }
 
+gdsFileCache::~gdsFileCache()
+{
+    evict(0);
+}
+
+void gdsFileCache::setMaxIdle(size_t max_idle)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    maxIdle = max_idle;
+    evict(maxIdle);
+}
+
+nixl_status_t gdsFileCache::acquire(int fd, CUfileHandle_t &cu_fhandle)
+{
+    struct stat st;
+    int flags = fcntl(fd, F_GETFL);
+
+    if ((fstat(fd, &st) != 0) || (flags < 0)) {
+        std::cerr << "Cannot stat file descriptor " << fd << std::endl;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    fileKey key(st.st_dev, st.st_ino, flags & (O_ACCMODE | O_DIRECT));
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        if (it->second.refcnt++ == 0) {
+            idle.erase(it->second.idlePos);
+        }
+        cu_fhandle = it->second.cu_fhandle;
+        return NIXL_SUCCESS;
+    }
+
+    // The caller may close its fd while the entry is cached
+    int own_fd = dup(fd);
+    CUfileDescr_t descr;
+    CUfileError_t status;
+    entry e;
+
+    if (own_fd < 0) {
+        return NIXL_ERR_BACKEND;
+    }
+
+    memset(&descr, 0, sizeof(descr));
+    descr.handle.fd = own_fd;
+    descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+
+    status = cuFileHandleRegister(&e.cu_fhandle, &descr);
+    if (status.err != CU_FILE_SUCCESS) {
+        std::cerr << "file register error:" << std::endl;
+        close(own_fd);
+        return NIXL_ERR_BACKEND;
+    }
+
+    e.fd = own_fd;
+    e.refcnt = 1;
+    e.idlePos = idle.end();
+    entries[key] = e;
+    byHandle[e.cu_fhandle] = key;
+    cu_fhandle = e.cu_fhandle;
+    return NIXL_SUCCESS;
+}
+
+void gdsFileCache::release(CUfileHandle_t cu_fhandle)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto key_it = byHandle.find(cu_fhandle);
+    if (key_it == byHandle.end()) {
+        return;
+    }
+
+    entry &e = entries[key_it->second];
+    if (--e.refcnt > 0) {
+        return;
+    }
+
+    e.idlePos = idle.insert(idle.end(), key_it->second);
+    evict(maxIdle);
+}
+
+void gdsFileCache::evict(size_t keep)
+{
+    while (idle.size() > keep) {
+        auto it = entries.find(idle.front());
+        idle.pop_front();
+
+        cuFileHandleDeregister(it->second.cu_fhandle);
+        close(it->second.fd);
+        byHandle.erase(it->second.cu_fhandle);
+        entries.erase(it);
+    }
+}
+
 nixlGdsIOBatch::nixlGdsIOBatch(unsigned int size)
     : max_reqs(size)
 {
@@ -97,6 +189,7 @@ nixlGdsIOBatch::nixlGdsIOBatch(unsigned int size)
 
     io_batch_events = new CUfileIOEvents_t[size];
     io_batch_params = new CUfileIOParams_t[size];
+    io_results = new ssize_t[size];
 
     err = cuFileBatchIOSetUp(&batch_handle, size);
     if (err.err != 0) {
@@ -111,6 +204,7 @@ nixlGdsIOBatch::~nixlGdsIOBatch()
         current_status == NIXL_ERR_NOT_POSTED) {
             delete[] io_batch_events;
             delete[] io_batch_params;
+            delete[] io_results;
             cuFileBatchIODestroy(batch_handle);
     } else {
             std::cerr<<"Attempting to delete a batch before completion\n";
@@ -183,6 +277,12 @@ nixl_status_t nixlGdsIOBatch::checkStatus()
         current_status = NIXL_ERR_BACKEND;
     }
 
+    for (unsigned int i = 0; (errBatch.err == 0) && (i < nr); i++) {
+        size_t idx = (CUfileIOParams_t *) io_batch_events[i].cookie - io_batch_params;
+        io_results[idx] = (io_batch_events[i].status == CUFILE_COMPLETE) ?
+                          (ssize_t) io_batch_events[i].ret : -1;
+    }
+
     entries_completed += nr;
     if (entries_completed < (unsigned int)batch_size)
         current_status = NIXL_IN_PROG;
@@ -199,3 +299,8 @@ void nixlGdsIOBatch::reset() {
     batch_size = 0;
     current_status = NIXL_ERR_NOT_POSTED;
 }
+
+void nixlGdsIOBatch::rearm() {
+    entries_completed = 0;
+    current_status = NIXL_ERR_NOT_POSTED;
+}
@@ -19,6 +19,11 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <nixl.h>
 #include <cufile.h>
 
@@ -50,11 +55,17 @@ class nixlGdsIOBatch {
         nixl_status_t cancelBatch();
         void destroyBatch();
         void reset();
+        // Keeps the filled parameters so the batch can be submitted again
+        void rearm();
+        unsigned int getSize() const { return batch_size; }
+        // Bytes moved by an entry, negative if it failed, once completed
+        ssize_t getResult(unsigned int idx) const { return io_results[idx]; }
 
     private:
         CUfileBatchHandle_t batch_handle;
         CUfileIOEvents_t *io_batch_events = nullptr;
         CUfileIOParams_t *io_batch_params = nullptr;
+        ssize_t *io_results = nullptr;
         CUfileError_t init_err = {CU_FILE_SUCCESS};
         unsigned int max_reqs = 0;
         unsigned int batch_size = 0;
@@ -62,6 +73,39 @@ class nixlGdsIOBatch {
         nixl_status_t current_status = NIXL_ERR_NOT_POSTED;
 };
 
+// cuFile handles shared by every registration of the same file (device,
+// inode and open mode), so reopening a file does not register it again.
+// Entries hold their own dup of the fd, and up to maxIdle unused entries
+// are kept, least recently used first out.
+class gdsFileCache {
+    public:
+        gdsFileCache() {}
+        ~gdsFileCache();
+
+        void setMaxIdle(size_t max_idle);
+        nixl_status_t acquire(int fd, CUfileHandle_t &cu_fhandle);
+        void release(CUfileHandle_t cu_fhandle);
+
+    private:
+        typedef std::tuple<dev_t, ino_t, int> fileKey;
+
+        class entry {
+            public:
+                CUfileHandle_t cu_fhandle;
+                int fd;
+                size_t refcnt;
+                std::list<fileKey>::iterator idlePos;
+        };
+
+        std::mutex lock;
+        std::map<fileKey, entry> entries;
+        std::map<CUfileHandle_t, fileKey> byHandle;
+        std::list<fileKey> idle;
+        size_t maxIdle = 0;
+
+        void evict(size_t keep);
+};
+
 class gdsUtil {
     public:
         gdsUtil() {}
@@ -74,5 +118,9 @@ class gdsUtil {
         nixl_status_t deregisterBufHandle(void *ptr);
         nixl_status_t openGdsDriver();
         void closeGdsDriver();
+        void setFileCacheSize(size_t size) { fileCache.setMaxIdle(size); }
+
+    private:
+        gdsFileCache fileCache;
 };
 #endif
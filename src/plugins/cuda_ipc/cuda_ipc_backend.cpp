@@ -0,0 +1,382 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cstring>
+#include <cuda.h>
+#include "cuda_ipc_backend.h"
+#include "serdes/serdes.h"
+
+#define DEFAULT_NUM_STREAMS 4
+
+nixlCudaIpcEngine::nixlCudaIpcEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    nixl_b_params_t* custom_params = init_params->customParams;
+    size_t num_streams = DEFAULT_NUM_STREAMS;
+
+    hostId = nixlLocalHostId();
+
+    if (custom_params && (custom_params->count("num_streams") > 0)) {
+        try {
+            num_streams = std::stoul((*custom_params)["num_streams"]);
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid num_streams parameter: " << e.what() << std::endl;
+            this->initErr = true;
+            return;
+        }
+        if (num_streams == 0) {
+            std::cerr << "Invalid num_streams parameter: 0" << std::endl;
+            this->initErr = true;
+            return;
+        }
+    }
+    streams.setCount(num_streams);
+
+    if ((notifier.init("nixl-cuda-ipc") != NIXL_SUCCESS) ||
+        (notifier.addPeer(localAgent, notifier.getName()) != NIXL_SUCCESS)) {
+        this->initErr = true;
+        return;
+    }
+}
+
+nixlCudaIpcEngine::~nixlCudaIpcEngine()
+{
+    // Left by remote sections not unloaded
+    for (auto &elm : ipcCache) {
+        cudaIpcCloseMemHandle(elm.second.ptr);
+    }
+}
+
+nixl_status_t nixlCudaIpcEngine::getConnInfo(std::string &str) const
+{
+    nixlSerDes sd;
+
+    sd.addStr("HostId", hostId);
+    sd.addStr("Sock", notifier.getName());
+    str = sd.exportStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                                    const std::string &remote_conn_info)
+{
+    nixlSerDes sd;
+
+    if (sd.importStr(remote_conn_info) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    std::string host_id = sd.getStr("HostId");
+    std::string sock_name = sd.getStr("Sock");
+    if (host_id.empty() || sock_name.empty()) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    // IPC handles only open on the same host
+    if (host_id != hostId) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    if (notifier.addPeer(remote_agent, sock_name) != NIXL_SUCCESS) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    std::lock_guard<std::mutex> guard(peerLock);
+    peers[remote_agent] = sock_name;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::connect(const std::string &remote_agent)
+{
+    std::lock_guard<std::mutex> guard(peerLock);
+    if ((remote_agent == localAgent) || (peers.count(remote_agent) > 0)) {
+        return NIXL_SUCCESS;
+    }
+    return NIXL_ERR_NOT_FOUND;
+}
+
+nixl_status_t nixlCudaIpcEngine::disconnect(const std::string &remote_agent)
+{
+    if (remote_agent != localAgent) {
+        notifier.removePeer(remote_agent);
+        std::lock_guard<std::mutex> guard(peerLock);
+        peers.erase(remote_agent);
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::registerMem(const nixlBlobDesc &mem,
+                                             const nixl_mem_t &nixl_mem,
+                                             nixlBackendMD* &out)
+{
+    nixlCudaDeviceGuard device_guard;
+    cudaError_t error_id;
+    CUdeviceptr base;
+    size_t size;
+
+    if (nixl_mem != VRAM_SEG) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    error_id = cudaSetDevice(mem.devId);
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaSetDevice returned " << cudaGetErrorString(error_id)
+                  << " for device ID " << mem.devId << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+
+    // Handles are of whole allocations, the descriptors are offsets in them
+    if (cuMemGetAddressRange(&base, &size, (CUdeviceptr) mem.addr) != CUDA_SUCCESS) {
+        std::cerr << "Failed to find the allocation of a VRAM registration" << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+
+    nixlCudaIpcMetadata *md = new nixlCudaIpcMetadata(true);
+    md->base = (void*) base;
+    error_id = cudaIpcGetMemHandle(&md->ipcHandle, md->base);
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaIpcGetMemHandle returned " << cudaGetErrorString(error_id) << std::endl;
+        delete md;
+        return NIXL_ERR_BACKEND;
+    }
+
+    out = md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::deregisterMem(nixlBackendMD* meta)
+{
+    delete (nixlCudaIpcMetadata*) meta;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::getPublicData(const nixlBackendMD* meta,
+                                               std::string &str) const
+{
+    const nixlCudaIpcMetadata *md = (const nixlCudaIpcMetadata*) meta;
+    uintptr_t base = (uintptr_t) md->base;
+    nixlSerDes sd;
+
+    sd.addBuf("Handle", &md->ipcHandle, sizeof(md->ipcHandle));
+    sd.addBuf("Base", &base, sizeof(base));
+    str = sd.exportStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::loadLocalMD(nixlBackendMD* input,
+                                             nixlBackendMD* &output)
+{
+    output = input;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::loadRemoteMD(const nixlBlobDesc &input,
+                                              const nixl_mem_t &nixl_mem,
+                                              const std::string &remote_agent,
+                                              nixlBackendMD* &output)
+{
+    cudaIpcMemHandle_t ipc_handle;
+    uintptr_t remote_base;
+    nixlSerDes sd;
+
+    if (nixl_mem != VRAM_SEG) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+    {
+        std::lock_guard<std::mutex> guard(peerLock);
+        if (peers.count(remote_agent) == 0) {
+            return NIXL_ERR_NOT_FOUND;
+        }
+    }
+    if ((sd.importStr(input.metaInfo) != NIXL_SUCCESS) ||
+        (sd.getBuf("Handle", &ipc_handle, sizeof(ipc_handle)) != NIXL_SUCCESS) ||
+        (sd.getBuf("Base", &remote_base, sizeof(remote_base)) != NIXL_SUCCESS)) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    // Descriptors of one allocation share its mapping
+    auto key = std::make_pair(remote_agent,
+                              std::string((char*) &ipc_handle, sizeof(ipc_handle)));
+    std::lock_guard<std::mutex> guard(cacheLock);
+    auto it = ipcCache.find(key);
+    if (it == ipcCache.end()) {
+        nixlCudaIpcMapping mapping;
+
+        cudaError_t error_id = cudaIpcOpenMemHandle(&mapping.ptr, ipc_handle,
+                                                    cudaIpcMemLazyEnablePeerAccess);
+        if (error_id != cudaSuccess) {
+            std::cerr << "cudaIpcOpenMemHandle returned " << cudaGetErrorString(error_id) << std::endl;
+            return NIXL_ERR_BACKEND;
+        }
+        mapping.refcnt = 0;
+        it = ipcCache.emplace(key, mapping).first;
+    }
+    it->second.refcnt++;
+
+    nixlCudaIpcMetadata *md = new nixlCudaIpcMetadata(false);
+    md->remoteBase = remote_base;
+    md->mapping = it;
+    output = md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::unloadMD(nixlBackendMD* input)
+{
+    nixlCudaIpcMetadata *md = (nixlCudaIpcMetadata*) input;
+
+    // Local ones are the registered objects, freed at deregisterMem
+    if (md->isPrivate()) {
+        return NIXL_SUCCESS;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+        if (--md->mapping->second.refcnt == 0) {
+            cudaIpcCloseMemHandle(md->mapping->second.ptr);
+            ipcCache.erase(md->mapping);
+        }
+    }
+    delete md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                          const nixl_meta_dlist_t &local,
+                                          const nixl_meta_dlist_t &remote,
+                                          const std::string &remote_agent,
+                                          nixlBackendReqH* &handle,
+                                          const nixl_opt_b_args_t* opt_args)
+{
+    size_t desc_cnt = local.descCount();
+
+    if ((desc_cnt != (size_t) remote.descCount()) ||
+        ((operation != NIXL_READ) && (operation != NIXL_WRITE))) {
+        std::cerr << "Error in count or operation selection\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    if ((local.getType() != VRAM_SEG) || (remote.getType() != VRAM_SEG)) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    nixlCudaIpcBackendReqH *ipc_handle = new nixlCudaIpcBackendReqH();
+    ipc_handle->remoteAgent = remote_agent;
+    ipc_handle->copies.resize(desc_cnt);
+
+    for (size_t i = 0; i < desc_cnt; i++) {
+        nixlCudaIpcMetadata *md = (nixlCudaIpcMetadata*) remote[i].metadataP;
+        nixlCudaIpcCopy &copy = ipc_handle->copies[i];
+        void *remote_ptr;
+
+        if (local[i].len != remote[i].len) {
+            delete ipc_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        // Same process, or translated into the mapping of the allocation
+        if (md->isPrivate()) {
+            remote_ptr = (void*) remote[i].addr;
+        } else {
+            remote_ptr = (char*) md->mapping->second.ptr +
+                         (remote[i].addr - md->remoteBase);
+        }
+
+        if (operation == NIXL_WRITE) {
+            copy.dst = remote_ptr;
+            copy.src = (void*) local[i].addr;
+        } else {
+            copy.dst = (void*) local[i].addr;
+            copy.src = remote_ptr;
+        }
+        copy.size = local[i].len;
+        copy.dev = local[i].devId;
+    }
+
+    handle = ipc_handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::postXfer(const nixl_xfer_op_t &operation,
+                                          const nixl_meta_dlist_t &local,
+                                          const nixl_meta_dlist_t &remote,
+                                          const std::string &remote_agent,
+                                          nixlBackendReqH* &handle,
+                                          const nixl_opt_b_args_t* opt_args)
+{
+    nixlCudaIpcBackendReqH *ipc_handle = (nixlCudaIpcBackendReqH*) handle;
+
+    nixl_status_t ret = ipc_handle->copyEvents.post(streams, ipc_handle->copies);
+    if (ret < 0) {
+        return ret;
+    }
+
+    // Sent once the copies are done
+    ipc_handle->hasNotif = opt_args && opt_args->hasNotif;
+    if (ipc_handle->hasNotif) {
+        ipc_handle->notifMsg = opt_args->notifMsg;
+    }
+
+    return checkXfer(ipc_handle);
+}
+
+nixl_status_t nixlCudaIpcEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlCudaIpcBackendReqH *ipc_handle = (nixlCudaIpcBackendReqH*) handle;
+
+    nixl_status_t ret = ipc_handle->copyEvents.check();
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    if (ipc_handle->hasNotif) {
+        ipc_handle->hasNotif = false;
+        return genNotif(ipc_handle->remoteAgent, ipc_handle->notifMsg);
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlCudaIpcBackendReqH *ipc_handle = (nixlCudaIpcBackendReqH*) handle;
+
+    // Waits for the copies that may still be running
+    delete ipc_handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaIpcEngine::genNotif(const std::string &remote_agent,
+                                          const std::string &msg)
+{
+    if (remote_agent == localAgent) {
+        return notifier.send(notifier.getName(), localAgent, msg);
+    }
+
+    std::string sock_name;
+    {
+        std::lock_guard<std::mutex> guard(peerLock);
+        auto it = peers.find(remote_agent);
+        if (it == peers.end()) {
+            return NIXL_ERR_NOT_FOUND;
+        }
+        sock_name = it->second;
+    }
+    return notifier.send(sock_name, localAgent, msg);
+}
+
+nixl_status_t nixlCudaIpcEngine::getNotifs(notif_list_t &notif_list)
+{
+    return notifier.recv(notif_list);
+}
@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __CUDA_IPC_BACKEND_H
+#define __CUDA_IPC_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <cuda_runtime.h>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include "backend/backend_engine.h"
+#include "local/local_utils.h"
+#include "cuda/cuda_copy.h"
+
+// Opened IPC handle of a remote allocation, shared by the descriptors in it
+class nixlCudaIpcMapping {
+    public:
+        void *ptr;
+        size_t refcnt;
+};
+
+typedef std::map<std::pair<std::string, std::string>, nixlCudaIpcMapping> cuda_ipc_cache_t;
+
+class nixlCudaIpcMetadata : public nixlBackendMD {
+    public:
+        // Local: the allocation holding the registered range, and its handle
+        void *base;
+        cudaIpcMemHandle_t ipcHandle;
+
+        // Remote: the allocation base in the owner process, and where it
+        // is mapped in this one
+        uintptr_t remoteBase;
+        cuda_ipc_cache_t::iterator mapping;
+
+        nixlCudaIpcMetadata(bool is_private) : nixlBackendMD(is_private) {
+            base = nullptr;
+            remoteBase = 0;
+        }
+        ~nixlCudaIpcMetadata() { }
+
+        bool isPrivate() const { return isPrivateMD; }
+};
+
+class nixlCudaIpcCopy {
+    public:
+        void *dst;
+        const void *src;
+        size_t size;
+        int dev;  // Local device, whose streams run the copy
+};
+
+class nixlCudaIpcBackendReqH : public nixlBackendReqH {
+    public:
+        std::vector<nixlCudaIpcCopy> copies;
+        nixlCudaCopyEvents copyEvents;
+        std::string remoteAgent;
+        nixl_blob_t notifMsg;
+        bool hasNotif;
+
+        nixlCudaIpcBackendReqH() {
+            hasNotif = false;
+        }
+        ~nixlCudaIpcBackendReqH() { }
+};
+
+class nixlCudaIpcEngine : public nixlBackendEngine {
+    private:
+        std::string hostId;
+        nixlLocalNotifier notifier;
+        std::unordered_map<std::string, std::string> peers; // Agent -> socket
+        mutable std::mutex peerLock;
+
+        // Remote sections of different agents load and unload concurrently
+        cuda_ipc_cache_t ipcCache;
+        std::mutex cacheLock;
+
+        // Copies of a transfer are spread over the streams of their device
+        nixlCudaStreams streams;
+
+    public:
+        nixlCudaIpcEngine(const nixlBackendInitParams* init_params);
+        ~nixlCudaIpcEngine();
+
+        // Any agent of this host, through CUDA IPC handles
+        bool supportsNotif() const {
+            return true;
+        }
+        bool supportsRemote() const {
+            return true;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(VRAM_SEG);
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if ((local_mem != VRAM_SEG) || (remote_mem != VRAM_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // NVLink/PCIe peer copies, ahead of the network backends
+            hints.bandwidthGBps = 100;
+            hints.latencyUs     = 4;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t getConnInfo(std::string &str) const;
+        nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                         const std::string &remote_conn_info);
+
+        nixl_status_t connect(const std::string &remote_agent);
+        nixl_status_t disconnect(const std::string &remote_agent);
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t getPublicData(const nixlBackendMD* meta,
+                                    std::string &str) const;
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output);
+        nixl_status_t loadRemoteMD(const nixlBlobDesc &input,
+                                   const nixl_mem_t &nixl_mem,
+                                   const std::string &remote_agent,
+                                   nixlBackendMD* &output);
+        nixl_status_t unloadMD(nixlBackendMD* input);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+
+        nixl_status_t getNotifs(notif_list_t &notif_list);
+        nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
+};
+#endif
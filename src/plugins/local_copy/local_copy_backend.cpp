@@ -0,0 +1,319 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cstring>
+#include "local_copy_backend.h"
+
+#define DEFAULT_COPY_THREADS 4
+#define DEFAULT_CHUNK_SIZE (1024 * 1024)
+#define DEFAULT_THREAD_MIN_SIZE (256 * 1024)
+#define DEFAULT_NUM_STREAMS 4
+
+static bool parseSize(nixl_b_params_t* custom_params, const std::string &key,
+                      size_t &value)
+{
+    if (!custom_params || (custom_params->count(key) == 0)) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+nixlLocalCopyEngine::nixlLocalCopyEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    nixl_b_params_t* custom_params = init_params->customParams;
+    size_t copy_threads = DEFAULT_COPY_THREADS;
+    size_t num_streams = DEFAULT_NUM_STREAMS;
+    std::string pin_dram = "true";
+
+    chunkSize = DEFAULT_CHUNK_SIZE;
+    threadMinSize = DEFAULT_THREAD_MIN_SIZE;
+    stop = false;
+
+    if (!parseSize(custom_params, "copy_threads", copy_threads) ||
+        !parseSize(custom_params, "chunk_size", chunkSize) ||
+        !parseSize(custom_params, "thread_min_size", threadMinSize) ||
+        !parseSize(custom_params, "num_streams", num_streams)) {
+        this->initErr = true;
+        return;
+    }
+    if ((chunkSize == 0) || (num_streams == 0)) {
+        std::cerr << "Invalid chunk_size or num_streams parameter: 0" << std::endl;
+        this->initErr = true;
+        return;
+    }
+#ifdef HAVE_CUDA
+    streams.setCount(num_streams);
+#endif
+
+    if (custom_params && (custom_params->count("pin_dram") > 0)) {
+        pin_dram = (*custom_params)["pin_dram"];
+        if ((pin_dram != "true") && (pin_dram != "false")) {
+            std::cerr << "Invalid pin_dram parameter: " << pin_dram << std::endl;
+            this->initErr = true;
+            return;
+        }
+    }
+    pinDram = (pin_dram == "true");
+
+    for (size_t i = 0; i < copy_threads; i++) {
+        threads.emplace_back(&nixlLocalCopyEngine::threadFunc, this);
+    }
+}
+
+nixlLocalCopyEngine::~nixlLocalCopyEngine()
+{
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        stop = true;
+    }
+    queueCv.notify_all();
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+void nixlLocalCopyEngine::threadFunc()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+
+    while (true) {
+        queueCv.wait(lock, [this]() {
+            return stop || !queue.empty();
+        });
+        if (queue.empty()) {
+            return;
+        }
+
+        nixlLocalCopyChunk chunk = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        memcpy(chunk.dst, chunk.src, chunk.size);
+        chunk.owner->pending--;
+
+        lock.lock();
+    }
+}
+
+nixl_status_t nixlLocalCopyEngine::connect(const std::string &remote_agent)
+{
+    return (remote_agent == localAgent) ? NIXL_SUCCESS : NIXL_ERR_NOT_SUPPORTED;
+}
+
+nixl_status_t nixlLocalCopyEngine::registerMem(const nixlBlobDesc &mem,
+                                               const nixl_mem_t &nixl_mem,
+                                               nixlBackendMD* &out)
+{
+    nixlLocalCopyMetadata *md = new nixlLocalCopyMetadata();
+    md->type = nixl_mem;
+    md->base = (void*) mem.addr;
+
+    switch (nixl_mem) {
+        case DRAM_SEG:
+#ifdef HAVE_CUDA
+            // Pinned, so copies with VRAM are DMA and run asynchronously
+            if (pinDram && (mem.len > 0)) {
+                if (cudaHostRegister(md->base, mem.len, cudaHostRegisterDefault) == cudaSuccess) {
+                    md->pinned = true;
+                } else {
+                    // Already pinned, or not allowed, copies still work
+                    cudaGetLastError();
+                }
+            }
+#endif
+            break;
+
+#ifdef HAVE_CUDA
+        case VRAM_SEG: {
+            nixlCudaDeviceGuard device_guard;
+            cudaError_t error_id = cudaSetDevice(mem.devId);
+            if (error_id != cudaSuccess) {
+                std::cerr << "cudaSetDevice returned " << cudaGetErrorString(error_id)
+                          << " for device ID " << mem.devId << std::endl;
+                delete md;
+                return NIXL_ERR_BACKEND;
+            }
+            break;
+        }
+#endif
+
+        default:
+            delete md;
+            return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    out = md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlLocalCopyEngine::deregisterMem(nixlBackendMD* meta)
+{
+    nixlLocalCopyMetadata *md = (nixlLocalCopyMetadata*) meta;
+
+#ifdef HAVE_CUDA
+    if (md->pinned) {
+        cudaHostUnregister(md->base);
+    }
+#endif
+    delete md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlLocalCopyEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                            const nixl_meta_dlist_t &local,
+                                            const nixl_meta_dlist_t &remote,
+                                            const std::string &remote_agent,
+                                            nixlBackendReqH* &handle,
+                                            const nixl_opt_b_args_t* opt_args)
+{
+    size_t desc_cnt = local.descCount();
+
+    if ((desc_cnt != (size_t) remote.descCount()) ||
+        ((operation != NIXL_READ) && (operation != NIXL_WRITE))) {
+        std::cerr << "Error in count or operation selection\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    if (remote_agent != localAgent) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    nixlLocalCopyBackendReqH *copy_handle = new nixlLocalCopyBackendReqH();
+    bool local_vram = (local.getType() == VRAM_SEG);
+    copy_handle->useCuda = local_vram || (remote.getType() == VRAM_SEG);
+
+    for (size_t i = 0; i < desc_cnt; i++) {
+        nixlLocalCopyChunk copy;
+
+        if (local[i].len != remote[i].len) {
+            delete copy_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        if (operation == NIXL_WRITE) {
+            copy.dst = (void*) remote[i].addr;
+            copy.src = (void*) local[i].addr;
+        } else {
+            copy.dst = (void*) local[i].addr;
+            copy.src = (void*) remote[i].addr;
+        }
+        copy.size = local[i].len;
+        copy.dev = local_vram ? local[i].devId : remote[i].devId;
+        copy.owner = copy_handle;
+
+        // Neighbouring descriptors, e.g. consecutive KV blocks, are one copy
+        if (!copy_handle->copies.empty()) {
+            nixlLocalCopyChunk &prev = copy_handle->copies.back();
+            if (((char*) prev.dst + prev.size == copy.dst) &&
+                ((const char*) prev.src + prev.size == copy.src) &&
+                (prev.dev == copy.dev)) {
+                prev.size += copy.size;
+                continue;
+            }
+        }
+        copy_handle->copies.push_back(copy);
+    }
+
+    handle = copy_handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlLocalCopyEngine::postXfer(const nixl_xfer_op_t &operation,
+                                            const nixl_meta_dlist_t &local,
+                                            const nixl_meta_dlist_t &remote,
+                                            const std::string &remote_agent,
+                                            nixlBackendReqH* &handle,
+                                            const nixl_opt_b_args_t* opt_args)
+{
+    nixlLocalCopyBackendReqH *copy_handle = (nixlLocalCopyBackendReqH*) handle;
+
+    if (copy_handle->pending > 0) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+#ifdef HAVE_CUDA
+    if (copy_handle->useCuda) {
+        return copy_handle->copyEvents.post(streams, copy_handle->copies);
+    }
+#endif
+
+    size_t total_size = 0;
+    for (auto &copy : copy_handle->copies) {
+        total_size += copy.size;
+    }
+
+    // Small ones are done before the threads would even wake up
+    if (threads.empty() || (total_size < threadMinSize)) {
+        for (auto &copy : copy_handle->copies) {
+            memcpy(copy.dst, copy.src, copy.size);
+        }
+        return NIXL_SUCCESS;
+    }
+
+    size_t chunk_cnt = 0;
+    for (auto &copy : copy_handle->copies) {
+        chunk_cnt += (copy.size + chunkSize - 1) / chunkSize;
+    }
+    copy_handle->pending = chunk_cnt;
+
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        for (auto &copy : copy_handle->copies) {
+            for (size_t off = 0; off < copy.size; off += chunkSize) {
+                nixlLocalCopyChunk chunk = copy;
+                chunk.dst = (char*) copy.dst + off;
+                chunk.src = (const char*) copy.src + off;
+                chunk.size = std::min(chunkSize, copy.size - off);
+                queue.push_back(chunk);
+            }
+        }
+    }
+    queueCv.notify_all();
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t nixlLocalCopyEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlLocalCopyBackendReqH *copy_handle = (nixlLocalCopyBackendReqH*) handle;
+
+#ifdef HAVE_CUDA
+    if (copy_handle->useCuda) {
+        return copy_handle->copyEvents.check();
+    }
+#endif
+    return (copy_handle->pending > 0) ? NIXL_IN_PROG : NIXL_SUCCESS;
+}
+
+nixl_status_t nixlLocalCopyEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlLocalCopyBackendReqH *copy_handle = (nixlLocalCopyBackendReqH*) handle;
+
+    // The threads must be done with its chunks
+    while (copy_handle->pending > 0) {
+        std::this_thread::yield();
+    }
+
+    // And the CUDA copies, waited for by its events
+    delete copy_handle;
+    return NIXL_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LOCAL_COPY_BACKEND_H
+#define __LOCAL_COPY_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <unordered_map>
+#include "backend/backend_engine.h"
+
+#ifdef HAVE_CUDA
+#include "cuda/cuda_copy.h"
+#endif
+
+class nixlLocalCopyMetadata : public nixlBackendMD {
+    public:
+        nixl_mem_t type;
+        void *base;
+        bool pinned;  // DRAM registered with the CUDA driver
+
+        nixlLocalCopyMetadata() : nixlBackendMD(true) {
+            base = nullptr;
+            pinned = false;
+        }
+        ~nixlLocalCopyMetadata() { }
+};
+
+class nixlLocalCopyBackendReqH;
+
+// A contiguous copy, and for the threads a piece of it
+class nixlLocalCopyChunk {
+    public:
+        void *dst;
+        const void *src;
+        size_t size;
+        int dev;  // Device whose streams run it, if VRAM is involved
+        nixlLocalCopyBackendReqH *owner;
+};
+
+class nixlLocalCopyBackendReqH : public nixlBackendReqH {
+    public:
+        std::vector<nixlLocalCopyChunk> copies;
+        bool useCuda;
+
+        // CPU copies: chunks not done yet
+        std::atomic<size_t> pending;
+
+#ifdef HAVE_CUDA
+        // CUDA copies
+        nixlCudaCopyEvents copyEvents;
+#endif
+
+        nixlLocalCopyBackendReqH() {
+            useCuda = false;
+            pending = 0;
+        }
+        ~nixlLocalCopyBackendReqH() { }
+};
+
+class nixlLocalCopyEngine : public nixlBackendEngine {
+    private:
+        // DRAM copies above threadMinSize are cut in chunkSize pieces,
+        // copied by the threads
+        size_t chunkSize;
+        size_t threadMinSize;
+        std::vector<std::thread> threads;
+        std::deque<nixlLocalCopyChunk> queue;
+        std::mutex queueLock;
+        std::condition_variable queueCv;
+        bool stop;
+        void threadFunc();
+
+        bool pinDram;
+#ifdef HAVE_CUDA
+        nixlCudaStreams streams;
+#endif
+
+    public:
+        nixlLocalCopyEngine(const nixlBackendInitParams* init_params);
+        ~nixlLocalCopyEngine();
+
+        // Copies within this agent only
+        bool supportsNotif() const {
+            return false;
+        }
+        bool supportsRemote() const {
+            return false;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(DRAM_SEG);
+#ifdef HAVE_CUDA
+            mems.push_back(VRAM_SEG);
+#endif
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if (((local_mem != DRAM_SEG) && (local_mem != VRAM_SEG)) ||
+                ((remote_mem != DRAM_SEG) && (remote_mem != VRAM_SEG)))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // No loopback through a network stack
+            if ((local_mem == DRAM_SEG) && (remote_mem == DRAM_SEG)) {
+                hints.bandwidthGBps = 20;
+                hints.latencyUs     = 1;
+            } else {
+                hints.bandwidthGBps = 25;
+                hints.latencyUs     = 4;
+            }
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t connect(const std::string &remote_agent);
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output) {
+            output = input;
+            return NIXL_SUCCESS;
+        }
+        nixl_status_t unloadMD(nixlBackendMD* input) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+};
+#endif
@@ -0,0 +1,454 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include "obj_backend.h"
+
+/** Ranged GETs and upload parts of up to 8 MB */
+#define DEFAULT_PART_SIZE (8 * 1024 * 1024)
+/** S3 multipart limits, the last part alone may be smaller */
+#define MIN_UPLOAD_PART_SIZE (5 * 1024 * 1024)
+#define MAX_UPLOAD_PART_SIZE (5ULL * 1024 * 1024 * 1024)
+#define MAX_UPLOAD_PARTS 10000
+/** Requests in flight, each on its own connection */
+#define DEFAULT_PARALLELISM 16
+#define DEFAULT_REGION "us-east-1"
+
+static bool getSizeParam(nixl_b_params_t* custom_params, const std::string &key,
+                         size_t &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Backend parameter, else the usual AWS environment variable
+static std::string getStrParam(nixl_b_params_t* custom_params, const std::string &key,
+                               const char *env, const std::string &def = "")
+{
+    if (custom_params && custom_params->count(key) &&
+        !(*custom_params)[key].empty()) {
+        return (*custom_params)[key];
+    }
+    const char *val = env ? getenv(env) : nullptr;
+    return val ? val : def;
+}
+
+// Text of an XML element, with its predefined entities replaced
+static std::string xmlUnescape(const std::string &str)
+{
+    static const std::pair<const char*, char> entities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+    std::string out;
+
+    for (size_t i = 0; i < str.size(); i++) {
+        bool replaced = false;
+        if (str[i] == '&') {
+            for (auto &[name, c] : entities) {
+                if (str.compare(i, strlen(name), name) == 0) {
+                    out.push_back(c);
+                    i += strlen(name) - 1;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced)
+            out.push_back(str[i]);
+    }
+    return out;
+}
+
+nixlObjEngine::nixlObjEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    static std::once_flag curl_init;
+    nixl_b_params_t* custom_params = init_params->customParams;
+    nixlObjS3Config config;
+
+    std::call_once(curl_init, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    partSize = DEFAULT_PART_SIZE;
+    uploadPartSize = DEFAULT_PART_SIZE;
+    config.parallelism = DEFAULT_PARALLELISM;
+    if (custom_params) {
+        if (!getSizeParam(custom_params, "part_size", partSize) ||
+            !getSizeParam(custom_params, "upload_part_size", uploadPartSize) ||
+            !getSizeParam(custom_params, "parallelism", config.parallelism)) {
+            this->initErr = true;
+            return;
+        }
+    }
+    if ((partSize == 0) || (config.parallelism == 0)) {
+        std::cerr << "part_size and parallelism must be set" << std::endl;
+        this->initErr = true;
+        return;
+    }
+    if ((uploadPartSize < MIN_UPLOAD_PART_SIZE) || (uploadPartSize > MAX_UPLOAD_PART_SIZE)) {
+        std::cerr << "upload_part_size must be between 5 MB and 5 GB" << std::endl;
+        this->initErr = true;
+        return;
+    }
+
+    config.region = getStrParam(custom_params, "region", "AWS_REGION", DEFAULT_REGION);
+    config.endpoint = getStrParam(custom_params, "endpoint", "AWS_ENDPOINT_URL",
+                                  "https://s3." + config.region + ".amazonaws.com");
+    config.accessKey = getStrParam(custom_params, "access_key", "AWS_ACCESS_KEY_ID");
+    config.secretKey = getStrParam(custom_params, "secret_key", "AWS_SECRET_ACCESS_KEY");
+    config.sessionToken = getStrParam(custom_params, "session_token", "AWS_SESSION_TOKEN");
+    defaultBucket = getStrParam(custom_params, "bucket", nullptr);
+
+#ifdef HAVE_CUDA
+    config.stageSize = std::max(partSize, uploadPartSize);
+#else
+    config.stageSize = 0;
+#endif
+
+    client.reset(new nixlObjS3Client());
+    if (!client->init(config)) {
+        client.reset();
+        this->initErr = true;
+        return;
+    }
+
+    this->initErr = false;
+}
+
+nixlObjEngine::~nixlObjEngine()
+{
+}
+
+nixl_status_t nixlObjEngine::registerMem(const nixlBlobDesc &mem,
+                                         const nixl_mem_t &nixl_mem,
+                                         nixlBackendMD* &out)
+{
+    nixlObjMetadata *md = new nixlObjMetadata();
+
+    md->type = nixl_mem;
+    switch (nixl_mem) {
+        case OBJ_SEG: {
+            // metaInfo holds the key, or s3://bucket/key for another bucket
+            std::string name(mem.metaInfo.begin(), mem.metaInfo.end());
+            if (name.compare(0, 5, "s3://") == 0) {
+                size_t slash = name.find('/', 5);
+                if (slash != std::string::npos) {
+                    md->bucket = name.substr(5, slash - 5);
+                    md->key = name.substr(slash + 1);
+                }
+            } else {
+                md->bucket = defaultBucket;
+                md->key = name.empty() ? std::to_string(mem.devId) : name;
+            }
+            if (md->bucket.empty() || md->key.empty()) {
+                std::cerr << "OBJ: no bucket or key for object " << mem.devId << std::endl;
+                delete md;
+                return NIXL_ERR_INVALID_PARAM;
+            }
+            break;
+        }
+        case DRAM_SEG:
+#ifdef HAVE_CUDA
+        case VRAM_SEG:
+#endif
+            md->base = (void*) mem.addr;
+            md->size = mem.len;
+            break;
+        default:
+            delete md;
+            return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    out = (nixlBackendMD*) md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlObjEngine::deregisterMem(nixlBackendMD *meta)
+{
+    delete (nixlObjMetadata*) meta;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlObjEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    nixl_mem_t local_type = local.getType();
+
+    if (((local_type != DRAM_SEG) && (local_type != VRAM_SEG)) ||
+        (remote.getType() != OBJ_SEG) || (local.descCount() != remote.descCount())) {
+        std::cerr << "OBJ: transfers are from DRAM or VRAM to OBJ descriptors" << std::endl;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    if (remote_agent != localAgent) {
+        std::cerr << "OBJ: objects are reached through the local agent only" << std::endl;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    nixlObjBackendReqH *obj_handle = new nixlObjBackendReqH();
+    bool staged = (local_type == VRAM_SEG);
+
+    for (int i = 0; i < local.descCount(); i++) {
+        nixlObjMetadata *obj_md = (nixlObjMetadata*) remote[i].metadataP;
+        char *addr = (char*) local[i].addr;
+        size_t len = local[i].len;
+        size_t offset = remote[i].addr;
+
+        if (len != remote[i].len) {
+            delete obj_handle;
+            return NIXL_ERR_MISMATCH;
+        }
+        if (len == 0) {
+            continue;
+        }
+
+        if (operation == NIXL_READ) {
+            // Parts are fetched in parallel, each streamed to its place
+            for (size_t done = 0; done < len; done += partSize) {
+                size_t size = std::min(partSize, len - done);
+
+                obj_handle->requests.emplace_back();
+                nixlObjS3Request &req = obj_handle->requests.back();
+                req.bucket = obj_md->bucket;
+                req.key = obj_md->key;
+                req.range = "bytes=" + std::to_string(offset + done) + "-" +
+                            std::to_string(offset + done + size - 1);
+                req.dst = addr + done;
+                req.dstSize = size;
+                req.staged = staged;
+                req.done = [this, obj_handle](nixlObjS3Request *r) {
+                    unitDone(obj_handle, r->ok);
+                };
+            }
+            continue;
+        }
+
+        // Objects cannot be written in place, a WRITE replaces the object
+        if (offset != 0) {
+            std::cerr << "OBJ: writes replace whole objects, offset must be 0" << std::endl;
+            delete obj_handle;
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
+        if (len > uploadPartSize * MAX_UPLOAD_PARTS) {
+            std::cerr << "OBJ: an object of " << len << " bytes takes more than "
+                      << MAX_UPLOAD_PARTS << " parts, raise upload_part_size" << std::endl;
+            delete obj_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        if (len <= uploadPartSize) {
+            obj_handle->requests.emplace_back();
+            nixlObjS3Request &req = obj_handle->requests.back();
+            req.method = "PUT";
+            req.bucket = obj_md->bucket;
+            req.key = obj_md->key;
+            req.body = addr;
+            req.bodySize = len;
+            req.staged = staged;
+            req.done = [this, obj_handle](nixlObjS3Request *r) {
+                unitDone(obj_handle, r->ok);
+            };
+            continue;
+        }
+
+        obj_handle->uploads.emplace_back();
+        nixlObjUpload &upload = obj_handle->uploads.back();
+        nixlObjUpload *up = &upload;
+        upload.owner = obj_handle;
+
+        upload.create.method = "POST";
+        upload.create.params["uploads"] = "";
+        upload.create.done = [this, up](nixlObjS3Request *r) { uploadCreated(up); };
+        upload.complete.method = "POST";
+        upload.complete.done = [this, up](nixlObjS3Request *r) {
+            if (!r->ok || (r->text.find("<Error>") != std::string::npos)) {
+                uploadFailed(up);
+            } else {
+                unitDone(up->owner, true);
+            }
+        };
+        upload.abort.method = "DELETE";
+        upload.abort.done = [this, up](nixlObjS3Request *r) {
+            unitDone(up->owner, false);
+        };
+
+        for (size_t done = 0; done < len; done += uploadPartSize) {
+            upload.parts.emplace_back();
+            nixlObjS3Request &part = upload.parts.back();
+            part.method = "PUT";
+            part.body = addr + done;
+            part.bodySize = std::min(uploadPartSize, len - done);
+            part.staged = staged;
+            part.done = [this, up](nixlObjS3Request *r) { uploadPartDone(up, r); };
+        }
+
+        for (auto req : {&upload.create, &upload.complete, &upload.abort}) {
+            req->bucket = obj_md->bucket;
+            req->key = obj_md->key;
+        }
+        for (auto &part : upload.parts) {
+            part.bucket = obj_md->bucket;
+            part.key = obj_md->key;
+        }
+    }
+
+    handle = obj_handle;
+    return NIXL_SUCCESS;
+}
+
+void nixlObjEngine::unitDone(nixlObjBackendReqH *handle, bool ok)
+{
+    if (!ok) {
+        handle->failed = true;
+    }
+    // Last access, the handle may be released right after
+    handle->pending--;
+}
+
+void nixlObjEngine::uploadCreated(nixlObjUpload *upload)
+{
+    const std::string &text = upload->create.text;
+    size_t start = text.find("<UploadId>");
+    size_t end = text.find("</UploadId>");
+
+    if (!upload->create.ok || (start == std::string::npos) || (end == std::string::npos)) {
+        unitDone(upload->owner, false);
+        return;
+    }
+    start += strlen("<UploadId>");
+    upload->uploadId = xmlUnescape(text.substr(start, end - start));
+
+    // Encoded by the client, in the URL and in the signature alike
+    size_t part_num = 1;
+    for (auto &part : upload->parts) {
+        part.params["partNumber"] = std::to_string(part_num++);
+        part.params["uploadId"] = upload->uploadId;
+    }
+    upload->complete.params["uploadId"] = upload->uploadId;
+    upload->abort.params["uploadId"] = upload->uploadId;
+
+    for (auto &part : upload->parts) {
+        client->submit(&part);
+    }
+}
+
+void nixlObjEngine::uploadPartDone(nixlObjUpload *upload, nixlObjS3Request *part)
+{
+    if (!part->ok || part->etag.empty()) {
+        upload->failed = true;
+    }
+    if (--upload->partsLeft > 0) {
+        return;
+    }
+
+    if (upload->failed) {
+        uploadFailed(upload);
+        return;
+    }
+
+    std::string &body = upload->completeBody;
+    size_t part_num = 1;
+    body = "<CompleteMultipartUpload>";
+    for (auto &p : upload->parts) {
+        body += "<Part><PartNumber>" + std::to_string(part_num++) +
+                "</PartNumber><ETag>" + p.etag + "</ETag></Part>";
+    }
+    body += "</CompleteMultipartUpload>";
+
+    upload->complete.body = body.data();
+    upload->complete.bodySize = body.size();
+    client->submit(&upload->complete);
+}
+
+// Drop the uploaded parts, the transfer fails either way
+void nixlObjEngine::uploadFailed(nixlObjUpload *upload)
+{
+    client->submit(&upload->abort);
+}
+
+nixl_status_t nixlObjEngine::postXfer(const nixl_xfer_op_t &operation,
+                                      const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      const std::string &remote_agent,
+                                      nixlBackendReqH* &handle,
+                                      const nixl_opt_b_args_t* opt_args)
+{
+    nixlObjBackendReqH *obj_handle = (nixlObjBackendReqH *) handle;
+
+    if (obj_handle->posted) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    obj_handle->failed = false;
+    obj_handle->pending = obj_handle->requests.size() + obj_handle->uploads.size();
+    if (obj_handle->pending == 0) {
+        return NIXL_SUCCESS;
+    }
+    obj_handle->posted = true;
+
+    for (auto &upload : obj_handle->uploads) {
+        upload.partsLeft = upload.parts.size();
+        upload.failed = false;
+        upload.uploadId.clear();
+        client->submit(&upload.create);
+    }
+    for (auto &req : obj_handle->requests) {
+        client->submit(&req);
+    }
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t nixlObjEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlObjBackendReqH *obj_handle = (nixlObjBackendReqH *) handle;
+
+    if (obj_handle->posted) {
+        if (obj_handle->pending > 0) {
+            return NIXL_IN_PROG;
+        }
+        obj_handle->posted = false;
+    }
+    return obj_handle->failed ? NIXL_ERR_BACKEND : NIXL_SUCCESS;
+}
+
+nixl_status_t nixlObjEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlObjBackendReqH *obj_handle = (nixlObjBackendReqH *) handle;
+
+    // Requests in flight still point into the handle
+    while (obj_handle->posted && (obj_handle->pending > 0)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    delete obj_handle;
+    return NIXL_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __OBJ_BACKEND_H
+#define __OBJ_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/backend_engine.h"
+#include "obj_s3.h"
+
+class nixlObjMetadata : public nixlBackendMD {
+    public:
+        nixl_mem_t type;
+        std::string bucket;   // OBJ_SEG
+        std::string key;
+        void *base;           // DRAM_SEG/VRAM_SEG
+        size_t size;
+
+        nixlObjMetadata() : nixlBackendMD(true) {
+            base = nullptr;
+            size = 0;
+        }
+        ~nixlObjMetadata() { }
+};
+
+class nixlObjBackendReqH;
+
+// Whole object write of more than part_size, as a multipart upload
+class nixlObjUpload {
+    public:
+        nixlObjBackendReqH *owner;
+        std::string uploadId;
+        std::string completeBody;
+        nixlObjS3Request create;
+        std::deque<nixlObjS3Request> parts;
+        nixlObjS3Request complete;
+        nixlObjS3Request abort;
+        std::atomic<size_t> partsLeft;
+        std::atomic<bool> failed;
+};
+
+class nixlObjBackendReqH : public nixlBackendReqH {
+    public:
+        // Ranged GETs and single PUTs, one pending unit each
+        std::deque<nixlObjS3Request> requests;
+        // Multipart uploads, one pending unit each
+        std::deque<nixlObjUpload> uploads;
+
+        std::atomic<size_t> pending;
+        std::atomic<bool> failed;
+        bool posted;
+
+        nixlObjBackendReqH() {
+            pending = 0;
+            failed = false;
+            posted = false;
+        }
+        ~nixlObjBackendReqH() { }
+};
+
+class nixlObjEngine : public nixlBackendEngine {
+    private:
+        std::unique_ptr<nixlObjS3Client> client;
+        std::string defaultBucket;
+        size_t partSize;
+        size_t uploadPartSize;
+
+        void unitDone(nixlObjBackendReqH *handle, bool ok);
+        void uploadCreated(nixlObjUpload *upload);
+        void uploadPartDone(nixlObjUpload *upload, nixlObjS3Request *part);
+        void uploadFailed(nixlObjUpload *upload);
+
+    public:
+        nixlObjEngine(const nixlBackendInitParams* init_params);
+        ~nixlObjEngine();
+
+        // Objects live in the store, there is nothing to connect to
+        bool supportsNotif() const {
+            return false;
+        }
+        bool supportsRemote() const {
+            return false;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(DRAM_SEG);
+#ifdef HAVE_CUDA
+            mems.push_back(VRAM_SEG);
+#endif
+            mems.push_back(OBJ_SEG);
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if (((local_mem != DRAM_SEG) && (local_mem != VRAM_SEG)) ||
+                (remote_mem != OBJ_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // A network round trip per part, VRAM through pinned staging
+            hints.bandwidthGBps = (local_mem == VRAM_SEG) ? 1 : 2;
+            hints.latencyUs     = 2000;
+            hints.chunkSize     = partSize;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t connect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output) {
+            output = input;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t unloadMD(nixlBackendMD* input) {
+            return NIXL_SUCCESS;
+        }
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+};
+#endif
@@ -0,0 +1,436 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cstring>
+#include <ctime>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include "obj_s3.h"
+
+#ifdef HAVE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+#define UNSIGNED_PAYLOAD "UNSIGNED-PAYLOAD"
+
+/****************************************
+ * SigV4 helpers
+*****************************************/
+
+static std::string toHex(const unsigned char *data, size_t len)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+
+    out.reserve(len * 2);
+    for (size_t i = 0; i < len; i++) {
+        out.push_back(digits[data[i] >> 4]);
+        out.push_back(digits[data[i] & 0xf]);
+    }
+    return out;
+}
+
+static std::string sha256Hex(const std::string &data)
+{
+    unsigned char md[SHA256_DIGEST_LENGTH];
+
+    SHA256((const unsigned char*) data.data(), data.size(), md);
+    return toHex(md, sizeof(md));
+}
+
+static std::string hmacSha256(const std::string &key, const std::string &data)
+{
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int md_len = 0;
+
+    HMAC(EVP_sha256(), key.data(), key.size(),
+         (const unsigned char*) data.data(), data.size(), md, &md_len);
+    return std::string((const char*) md, md_len);
+}
+
+std::string nixlObjS3Client::uriEncode(const std::string &str, bool keep_slash)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    std::string out;
+
+    for (unsigned char c : str) {
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' ||
+            (keep_slash && c == '/')) {
+            out.push_back(c);
+        } else {
+            out.push_back('%');
+            out.push_back(digits[c >> 4]);
+            out.push_back(digits[c & 0xf]);
+        }
+    }
+    return out;
+}
+
+std::string nixlObjS3Client::canonicalQuery(const nixlObjS3Request *req)
+{
+    std::string out;
+
+    for (auto &[name, value] : req->params) {
+        if (!out.empty())
+            out += "&";
+        out += uriEncode(name, false) + "=" + uriEncode(value, false);
+    }
+    return out;
+}
+
+void nixlObjS3Client::sign(const nixlObjS3Request *req,
+                           std::vector<std::string> &headers) const
+{
+    char amz_date[17], date_stamp[9];
+    time_t now = time(nullptr);
+    struct tm tm;
+
+    gmtime_r(&now, &tm);
+    strftime(amz_date, sizeof(amz_date), "%Y%m%dT%H%M%SZ", &tm);
+    strftime(date_stamp, sizeof(date_stamp), "%Y%m%d", &tm);
+
+    headers.push_back("x-amz-content-sha256: " UNSIGNED_PAYLOAD);
+    headers.push_back(std::string("x-amz-date: ") + amz_date);
+    if (!config.sessionToken.empty())
+        headers.push_back("x-amz-security-token: " + config.sessionToken);
+
+    if (config.accessKey.empty())
+        return;
+
+    std::string canonical_headers = "host:" + host + "\n" +
+                                    "x-amz-content-sha256:" UNSIGNED_PAYLOAD "\n" +
+                                    "x-amz-date:" + amz_date + "\n";
+    std::string signed_headers = "host;x-amz-content-sha256;x-amz-date";
+    if (!config.sessionToken.empty()) {
+        canonical_headers += "x-amz-security-token:" + config.sessionToken + "\n";
+        signed_headers += ";x-amz-security-token";
+    }
+
+    std::string canonical_request = req->method + "\n" +
+                                    "/" + uriEncode(req->bucket, false) +
+                                    "/" + uriEncode(req->key, true) + "\n" +
+                                    canonicalQuery(req) + "\n" +
+                                    canonical_headers + "\n" +
+                                    signed_headers + "\n" +
+                                    UNSIGNED_PAYLOAD;
+
+    std::string scope = std::string(date_stamp) + "/" + config.region + "/s3/aws4_request";
+    std::string string_to_sign = std::string("AWS4-HMAC-SHA256\n") + amz_date + "\n" +
+                                 scope + "\n" + sha256Hex(canonical_request);
+
+    std::string key = hmacSha256("AWS4" + config.secretKey, date_stamp);
+    key = hmacSha256(key, config.region);
+    key = hmacSha256(key, "s3");
+    key = hmacSha256(key, "aws4_request");
+    std::string sig = hmacSha256(key, string_to_sign);
+
+    headers.push_back("Authorization: AWS4-HMAC-SHA256 Credential=" +
+                      config.accessKey + "/" + scope +
+                      ", SignedHeaders=" + signed_headers +
+                      ", Signature=" + toHex((const unsigned char*) sig.data(), sig.size()));
+}
+
+/****************************************
+ * libcurl callbacks
+*****************************************/
+
+static size_t writeCb(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    nixlObjS3Request *req = (nixlObjS3Request*) userdata;
+    size_t len = size * nmemb;
+
+    if (!req->dst || req->httpCode >= 300) {
+        req->text.append(ptr, len);
+        return len;
+    }
+
+    // Stop on a larger body than asked for, e.g. a server ignoring Range
+    if (req->pos + len > req->dstSize)
+        return 0;
+
+    char *dst = req->staged ? req->stage : req->dst;
+    memcpy(dst + req->pos, ptr, len);
+    req->pos += len;
+    return len;
+}
+
+static size_t readCb(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    nixlObjS3Request *req = (nixlObjS3Request*) userdata;
+    size_t len = std::min(size * nmemb, req->bodySize - req->pos);
+    const char *src = req->staged ? req->stage : req->body;
+
+    memcpy(ptr, src + req->pos, len);
+    req->pos += len;
+    return len;
+}
+
+static size_t headerCb(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    nixlObjS3Request *req = (nixlObjS3Request*) userdata;
+    size_t len = size * nmemb;
+    std::string line(ptr, len);
+
+    if (line.compare(0, 5, "HTTP/") == 0) {
+        size_t sp = line.find(' ');
+        if (sp != std::string::npos)
+            req->httpCode = strtol(line.c_str() + sp + 1, nullptr, 10);
+    } else if (strncasecmp(line.c_str(), "etag:", 5) == 0) {
+        size_t start = line.find_first_not_of(" \t", 5);
+        size_t end = line.find_last_not_of("\r\n");
+        if (start != std::string::npos && end >= start)
+            req->etag = line.substr(start, end - start + 1);
+    }
+    return len;
+}
+
+/****************************************
+ * Client
+*****************************************/
+
+bool nixlObjS3Client::init(const nixlObjS3Config &cfg)
+{
+    config = cfg;
+    while (!config.endpoint.empty() && config.endpoint.back() == '/')
+        config.endpoint.pop_back();
+
+    size_t start = config.endpoint.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    host = config.endpoint.substr(start);
+    host = host.substr(0, host.find('/'));
+    if (host.empty() || config.parallelism == 0) {
+        std::cerr << "OBJ: invalid endpoint " << config.endpoint << std::endl;
+        return false;
+    }
+
+    multi = curl_multi_init();
+    if (!multi)
+        return false;
+
+    // Connections are kept alive across requests in the multi cache
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long) config.parallelism);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, (long) config.parallelism);
+
+    slots.resize(config.parallelism);
+    for (auto &s : slots) {
+        s.easy = curl_easy_init();
+        if (!s.easy)
+            return false;
+#ifdef HAVE_CUDA
+        if (config.stageSize &&
+            cudaMallocHost((void**) &s.stage, config.stageSize) != cudaSuccess) {
+            std::cerr << "OBJ: failed to allocate pinned staging" << std::endl;
+            s.stage = nullptr;
+            return false;
+        }
+#endif
+        freeSlots.push_back(&s);
+    }
+
+    worker = std::thread(&nixlObjS3Client::workerFunc, this);
+    return true;
+}
+
+nixlObjS3Client::~nixlObjS3Client()
+{
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            stop = true;
+        }
+        curl_multi_wakeup(multi);
+        worker.join();
+    }
+
+    for (auto &s : slots) {
+        if (s.req) {
+            curl_multi_remove_handle(multi, s.easy);
+            curl_slist_free_all(s.req->headers);
+        }
+        if (s.easy)
+            curl_easy_cleanup(s.easy);
+#ifdef HAVE_CUDA
+        if (s.stage)
+            cudaFreeHost(s.stage);
+#endif
+    }
+    if (multi)
+        curl_multi_cleanup(multi);
+}
+
+void nixlObjS3Client::submit(nixlObjS3Request *req)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        queue.push_back(req);
+    }
+    curl_multi_wakeup(multi);
+}
+
+bool nixlObjS3Client::startRequest(slot *s, nixlObjS3Request *req)
+{
+    CURL *easy = s->easy;
+    std::vector<std::string> headers;
+    std::string url = config.endpoint + "/" + uriEncode(req->bucket, false) +
+                      "/" + uriEncode(req->key, true);
+
+    if (!req->params.empty())
+        url += "?" + canonicalQuery(req);
+
+    req->pos = 0;
+    req->httpCode = 0;
+    req->ok = false;
+    req->text.clear();
+    req->etag.clear();
+    req->stage = s->stage;
+    if (req->staged && (!s->stage ||
+        std::max(req->bodySize, req->dstSize) > config.stageSize))
+        return false;
+
+#ifdef HAVE_CUDA
+    if (req->staged && req->body &&
+        cudaMemcpy(s->stage, req->body, req->bodySize,
+                   cudaMemcpyDeviceToHost) != cudaSuccess)
+        return false;
+#endif
+
+    if (!req->range.empty())
+        headers.push_back("Range: " + req->range);
+    // No 100-continue round trip before bodies
+    if (req->method == "PUT" || req->method == "POST")
+        headers.push_back("Expect:");
+    sign(req, headers);
+
+    req->headers = nullptr;
+    for (auto &h : headers)
+        req->headers = curl_slist_append(req->headers, h.c_str());
+
+    curl_easy_reset(easy);
+    curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, req->headers);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeCb);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, req);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, headerCb);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, req);
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, s);
+
+    if (req->method == "PUT") {
+        curl_easy_setopt(easy, CURLOPT_UPLOAD, 1L);
+        curl_easy_setopt(easy, CURLOPT_READFUNCTION, readCb);
+        curl_easy_setopt(easy, CURLOPT_READDATA, req);
+        curl_easy_setopt(easy, CURLOPT_INFILESIZE_LARGE, (curl_off_t) req->bodySize);
+    } else if (req->method == "POST") {
+        curl_easy_setopt(easy, CURLOPT_POST, 1L);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, req->body ? req->body : "");
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t) req->bodySize);
+    } else if (req->method != "GET") {
+        curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, req->method.c_str());
+    }
+
+    s->req = req;
+    if (curl_multi_add_handle(multi, easy) != CURLM_OK) {
+        s->req = nullptr;
+        curl_slist_free_all(req->headers);
+        req->headers = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void nixlObjS3Client::finishRequest(slot *s, CURLcode res)
+{
+    nixlObjS3Request *req = s->req;
+
+    curl_multi_remove_handle(multi, s->easy);
+    curl_easy_getinfo(s->easy, CURLINFO_RESPONSE_CODE, &req->httpCode);
+    curl_slist_free_all(req->headers);
+    req->headers = nullptr;
+    s->req = nullptr;
+
+    const char *err = nullptr;
+    if (res != CURLE_OK)
+        err = curl_easy_strerror(res);
+    else if ((req->httpCode < 200) || (req->httpCode >= 300))
+        err = "HTTP error";
+    else if (req->dst && (req->pos != req->dstSize))
+        err = "short body, past the object end";
+
+    req->ok = !err;
+    if (err) {
+        std::cerr << "OBJ: " << req->method << " " << req->bucket << "/" << req->key
+                  << " failed: " << err << " (" << req->httpCode << ")" << std::endl;
+    }
+
+#ifdef HAVE_CUDA
+    if (req->ok && req->staged && req->dst &&
+        cudaMemcpy(req->dst, s->stage, req->dstSize,
+                   cudaMemcpyHostToDevice) != cudaSuccess)
+        req->ok = false;
+#endif
+
+    freeSlots.push_back(s);
+    // The callback may end the transfer and free the request
+    auto done = req->done;
+    done(req);
+}
+
+void nixlObjS3Client::workerFunc()
+{
+    while (true) {
+        std::deque<nixlObjS3Request*> failed;
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            if (stop)
+                return;
+            // Every connection has its own staging buffer, so staged requests
+            // never wait on anything but a free connection.
+            while (!queue.empty() && !freeSlots.empty()) {
+                nixlObjS3Request *req = queue.front();
+                slot *s = freeSlots.back();
+                queue.pop_front();
+                freeSlots.pop_back();
+                if (!startRequest(s, req)) {
+                    freeSlots.push_back(s);
+                    failed.push_back(req);
+                }
+            }
+        }
+
+        for (auto req : failed) {
+            auto done = req->done;
+            req->ok = false;
+            done(req);
+        }
+
+        int running;
+        curl_multi_perform(multi, &running);
+
+        CURLMsg *msg;
+        int left;
+        while ((msg = curl_multi_info_read(multi, &left))) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            slot *s;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**) &s);
+            finishRequest(s, msg->data.result);
+        }
+
+        curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __OBJ_S3_H
+#define __OBJ_S3_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <curl/curl.h>
+
+class nixlObjS3Config {
+    public:
+        std::string endpoint;   // e.g. http://localhost:9000, path style URLs
+        std::string region;
+        std::string accessKey;  // Unsigned requests if empty
+        std::string secretKey;
+        std::string sessionToken;
+        size_t parallelism;
+        size_t stageSize;       // Pinned staging per connection, 0 without CUDA
+};
+
+// One HTTP request to the object store. The completion callback runs on the
+// client thread, and may submit more requests.
+class nixlObjS3Request {
+    public:
+        std::string method = "GET";
+        std::string bucket;
+        std::string key;
+        // Query parameters with their raw values, encoded by the client
+        std::map<std::string, std::string> params;
+        std::string range;      // "bytes=a-b" for ranged GETs
+
+        // Request body, from DRAM, or from VRAM through the staging buffer
+        const char *body = nullptr;
+        size_t bodySize = 0;
+        // Response body, into DRAM, or into VRAM through the staging buffer.
+        // Without dst it is kept in text.
+        char *dst = nullptr;
+        size_t dstSize = 0;
+        bool staged = false;
+
+        std::function<void(nixlObjS3Request*)> done;
+
+        // Set on completion
+        std::string text;
+        std::string etag;
+        long httpCode = 0;
+        bool ok = false;
+
+        // Internal
+        size_t pos = 0;
+        char *stage = nullptr;
+        struct curl_slist *headers = nullptr;
+};
+
+class nixlObjS3Client {
+    private:
+        class slot {
+            public:
+                CURL *easy = nullptr;
+                char *stage = nullptr;
+                nixlObjS3Request *req = nullptr;
+        };
+
+        nixlObjS3Config config;
+        std::string host;
+
+        CURLM *multi = nullptr;
+        std::vector<slot> slots;
+        std::vector<slot*> freeSlots;
+
+        std::deque<nixlObjS3Request*> queue;
+        std::mutex queueLock;
+        std::condition_variable queueCv;
+        bool stop = false;
+        std::thread worker;
+
+        void workerFunc();
+        bool startRequest(slot *s, nixlObjS3Request *req);
+        void finishRequest(slot *s, CURLcode res);
+        void sign(const nixlObjS3Request *req, std::vector<std::string> &headers) const;
+
+    public:
+        nixlObjS3Client() { }
+        ~nixlObjS3Client();
+
+        bool init(const nixlObjS3Config &cfg);
+        void submit(nixlObjS3Request *req);
+
+        static std::string uriEncode(const std::string &str, bool keep_slash);
+        // Encoded and sorted by name, as in the URL and the SigV4 canonical request
+        static std::string canonicalQuery(const nixlObjS3Request *req);
+};
+
+#endif
@@ -0,0 +1,1235 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "serdes/serdes.h"
+#include "pipeline_backend.h"
+
+/** Chunks of a transfer, and slots of the staging rings */
+#define DEFAULT_CHUNK_SIZE (2 * 1024 * 1024)
+#define DEFAULT_SLOT_COUNT 8
+/** Smaller transfers of registered VRAM go through the inner engine as they are */
+#define DEFAULT_MIN_SIZE (1024 * 1024)
+
+// First byte of every notification. Application notifications are sent as
+// they are, the others drive the pipelined transfers.
+#define NOTIF_PLAIN  'P'
+#define NOTIF_REQ    'R'    // Sender: chunks coming to an agent ring
+#define NOTIF_GRANT  'G'    // Receiver: slots of its ring to write them to
+#define NOTIF_CHUNK  'D'    // Sender: a slot is written, copy it to VRAM
+#define NOTIF_FINISH 'F'    // Receiver: all chunks are in VRAM
+#define NOTIF_CANCEL 'X'    // Sender: the request is released
+#define NOTIF_ERROR  'E'    // Receiver: the request is dropped
+
+// Public data of the descriptors, telling the loading peer which ones are
+// registered with the inner engine
+#define MD_INNER 'I'
+#define MD_OWN   'V'
+
+// After the tag of a request notification, followed by the user message
+struct nixlPipeReqHdr {
+    uint64_t reqId;
+    uint32_t chunkCount;
+    uint32_t msgLen;
+    uint8_t  hasMsg;
+} __attribute__((packed));
+
+// After the tag of a grant notification, followed by the slot indexes
+struct nixlPipeGrantHdr {
+    uint64_t reqId;
+    uint32_t count;
+} __attribute__((packed));
+
+struct nixlPipeChunkHdr {
+    uint64_t reqId;
+    uint32_t slot;
+    uint64_t addr;
+    uint64_t len;
+} __attribute__((packed));
+
+// Finish, cancel and error notifications
+struct nixlPipeReqIdHdr {
+    uint64_t reqId;
+} __attribute__((packed));
+
+static const char *ownParams[] = {
+    "backend", "chunk_size", "chunks", "min_size"
+};
+
+static bool getSizeParam(nixl_b_params_t* custom_params, const std::string &key,
+                         size_t &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+nixlPipelineEngine::nixlPipelineEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params)
+{
+    nixl_b_params_t* custom_params = init_params->customParams;
+    nixl_b_params_t inner_params;
+    std::string inner_type = "UCX";
+
+    inner = nullptr;
+    factory = nullptr;
+    innerVram = false;
+    chunkSize = DEFAULT_CHUNK_SIZE;
+    slotCount = DEFAULT_SLOT_COUNT;
+    minSize = DEFAULT_MIN_SIZE;
+    d2hStream = nullptr;
+    h2dStream = nullptr;
+    stageRing = nullptr;
+    stageMD = nullptr;
+    recvRing = nullptr;
+    recvMD = nullptr;
+    nextReqId = 1;
+    this->initErr = true;
+
+    if (custom_params) {
+        if (!getSizeParam(custom_params, "chunk_size", chunkSize) ||
+            !getSizeParam(custom_params, "chunks", slotCount) ||
+            !getSizeParam(custom_params, "min_size", minSize)) {
+            return;
+        }
+        if (custom_params->count("backend")) {
+            inner_type = (*custom_params)["backend"];
+        }
+
+        // The rest is for the inner engine
+        inner_params = *custom_params;
+        for (auto key : ownParams) {
+            inner_params.erase(key);
+        }
+    }
+
+    if ((chunkSize == 0) || (slotCount == 0) || (slotCount > UINT32_MAX)) {
+        std::cerr << "PIPELINE: chunk_size and chunks must be above 0" << std::endl;
+        return;
+    }
+
+    if (inner_type == init_params->type) {
+        std::cerr << "PIPELINE: cannot wrap itself" << std::endl;
+        return;
+    }
+    factory = init_params->factory;
+    if (!factory) {
+        std::cerr << "PIPELINE: no engine factory to create " << inner_type << std::endl;
+        return;
+    }
+
+    nixlBackendInitParams inner_init = *init_params;
+    inner_init.type = inner_type;
+    inner_init.customParams = &inner_params;
+    inner = factory->createEngine(&inner_init);
+    if (!inner) {
+        std::cerr << "PIPELINE: failed to create backend " << inner_type << std::endl;
+        return;
+    }
+    if (inner->getInitErr()) {
+        factory->destroyEngine(inner);
+        inner = nullptr;
+        return;
+    }
+
+    for (auto &mem : inner->getSupportedMems()) {
+        if (mem == VRAM_SEG) {
+            innerVram = true;
+        }
+    }
+
+    // Copies of both directions overlap each other and the inner transfers
+    if ((cudaStreamCreateWithFlags(&d2hStream, cudaStreamNonBlocking) != cudaSuccess) ||
+        (cudaStreamCreateWithFlags(&h2dStream, cudaStreamNonBlocking) != cudaSuccess)) {
+        std::cerr << "PIPELINE: failed to create CUDA streams" << std::endl;
+        return;
+    }
+
+    if (!initRing(slotCount, stageRing, stageMD, stageSlots) ||
+        !initRing(slotCount, recvRing, recvMD, recvSlots)) {
+        return;
+    }
+    if (inner->supportsRemote() &&
+        (inner->getPublicData(recvMD, ringPublic) != NIXL_SUCCESS)) {
+        std::cerr << "PIPELINE: failed to get public data of the ring" << std::endl;
+        return;
+    }
+    for (uint32_t i = slotCount; i > 0; i--) {
+        freeStageSlots.push_back(i - 1);
+        freeRecvSlots.push_back(i - 1);
+    }
+
+    this->initErr = false;
+}
+
+bool nixlPipelineEngine::initRing(size_t count, char* &ring, nixlBackendMD* &md,
+                                  std::vector<nixlPipeSlot> &slots)
+{
+    nixlBlobDesc mem;
+
+    if (cudaMallocHost((void**) &ring, count * chunkSize) != cudaSuccess) {
+        std::cerr << "PIPELINE: failed to allocate " << count * chunkSize
+                  << " bytes of pinned memory" << std::endl;
+        ring = nullptr;
+        return false;
+    }
+    mem.addr = (uintptr_t) ring;
+    mem.len = count * chunkSize;
+    mem.devId = 0;
+    if (inner->registerMem(mem, DRAM_SEG, md) != NIXL_SUCCESS) {
+        std::cerr << "PIPELINE: failed to register the ring" << std::endl;
+        md = nullptr;
+        return false;
+    }
+
+    slots.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        slots[i].addr = ring + i * chunkSize;
+        if (cudaEventCreateWithFlags(&slots[i].event, cudaEventDisableTiming) != cudaSuccess) {
+            std::cerr << "PIPELINE: failed to create CUDA events" << std::endl;
+            slots.resize(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+void nixlPipelineEngine::finiRing(char *ring, nixlBackendMD *md,
+                                  std::vector<nixlPipeSlot> &slots)
+{
+    for (auto &slot : slots) {
+        cudaEventDestroy(slot.event);
+    }
+    if (md) {
+        inner->deregisterMem(md);
+    }
+    if (ring) {
+        cudaFreeHost(ring);
+    }
+}
+
+nixlPipelineEngine::~nixlPipelineEngine()
+{
+    if (!inner) {
+        return;
+    }
+
+    // Nothing may still copy into the rings
+    if (d2hStream) {
+        cudaStreamSynchronize(d2hStream);
+    }
+    if (h2dStream) {
+        cudaStreamSynchronize(h2dStream);
+    }
+    for (auto &drain : drains) {
+        for (auto &write : drain.writes) {
+            inner->releaseReqH(write.first);
+        }
+    }
+    for (auto &peer : peers) {
+        if (peer.second.ringMD) {
+            inner->unloadMD(peer.second.ringMD);
+        }
+    }
+    finiRing(stageRing, stageMD, stageSlots);
+    finiRing(recvRing, recvMD, recvSlots);
+    if (d2hStream) {
+        cudaStreamDestroy(d2hStream);
+    }
+    if (h2dStream) {
+        cudaStreamDestroy(h2dStream);
+    }
+    for (auto md : ownMDs) {
+        delete md;
+    }
+    factory->destroyEngine(inner);
+}
+
+nixl_mem_list_t nixlPipelineEngine::getSupportedMems() const
+{
+    nixl_mem_list_t mems = inner->getSupportedMems();
+
+    if (!innerVram) {
+        mems.push_back(VRAM_SEG);
+    }
+    return mems;
+}
+
+nixl_status_t nixlPipelineEngine::getXferHints(const nixl_mem_t &local_mem,
+                                               const nixl_mem_t &remote_mem,
+                                               nixlBackendXferHints &hints) const
+{
+    return getPeerXferHints(local_mem, remote_mem, "", hints);
+}
+
+nixl_status_t nixlPipelineEngine::getPeerXferHints(const nixl_mem_t &local_mem,
+                                                   const nixl_mem_t &remote_mem,
+                                                   const std::string &remote_agent,
+                                                   nixlBackendXferHints &hints) const
+{
+    if ((local_mem != VRAM_SEG) && (remote_mem != VRAM_SEG)) {
+        return inner->getPeerXferHints(local_mem, remote_mem, remote_agent, hints);
+    }
+
+    // Pipelined transfers move at the rate of the inner DRAM path, and take
+    // a chunk of copy to fill the pipeline and another to drain it
+    nixl_status_t ret = inner->getPeerXferHints(DRAM_SEG, DRAM_SEG, remote_agent, hints);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+    if (hints.bandwidthGBps > 0) {
+        hints.latencyUs += 2 * chunkSize / (hints.bandwidthGBps * 1000);
+    }
+    hints.chunkSize = chunkSize;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPipelineEngine::registerMem(const nixlBlobDesc &mem,
+                                              const nixl_mem_t &nixl_mem,
+                                              nixlBackendMD* &out)
+{
+    nixl_status_t ret;
+
+    if ((nixl_mem == VRAM_SEG) && !innerVram) {
+        out = new nixlPipeVramMD(true);
+        ret = NIXL_SUCCESS;
+    } else {
+        ret = inner->registerMem(mem, nixl_mem, out);
+    }
+
+    if ((ret == NIXL_SUCCESS) && (nixl_mem == VRAM_SEG)) {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        if (!innerVram) {
+            ownMDs.insert(out);
+        }
+        vramRanges.emplace(mem.addr, mem.addr + mem.len);
+        vramByMD[out] = mem.addr;
+    }
+    return ret;
+}
+
+nixl_status_t nixlPipelineEngine::deregisterMem(nixlBackendMD *meta)
+{
+    {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        auto it = vramByMD.find(meta);
+        if (it != vramByMD.end()) {
+            auto range = vramRanges.find(it->second);
+            if (range != vramRanges.end()) {
+                vramRanges.erase(range);
+            }
+            vramByMD.erase(it);
+        }
+        if (ownMDs.erase(meta)) {
+            delete meta;
+            return NIXL_SUCCESS;
+        }
+    }
+    return inner->deregisterMem(meta);
+}
+
+// Peers only copy into VRAM registered here
+bool nixlPipelineEngine::isLocalVram(uintptr_t addr, size_t len)
+{
+    std::lock_guard<std::mutex> guard(rangeLock);
+    auto it = vramRanges.upper_bound(addr);
+
+    while (it != vramRanges.begin()) {
+        --it;
+        if ((it->second >= addr) && (it->second - addr >= len)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool nixlPipelineEngine::isOwn(const nixl_meta_dlist_t &descs)
+{
+    std::lock_guard<std::mutex> guard(rangeLock);
+
+    for (auto &desc : descs) {
+        if (ownMDs.count(desc.metadataP)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+nixl_status_t nixlPipelineEngine::getPublicData(const nixlBackendMD* meta,
+                                                std::string &str) const
+{
+    std::string inner_str;
+    nixl_status_t ret;
+
+    {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        if (ownMDs.count((nixlBackendMD*) meta)) {
+            str = MD_OWN;
+            return NIXL_SUCCESS;
+        }
+    }
+    ret = inner->getPublicData(meta, inner_str);
+    if (ret == NIXL_SUCCESS) {
+        str = MD_INNER + inner_str;
+    }
+    return ret;
+}
+
+nixl_status_t nixlPipelineEngine::loadRemoteMD(const nixlBlobDesc &input,
+                                               const nixl_mem_t &nixl_mem,
+                                               const std::string &remote_agent,
+                                               nixlBackendMD* &output)
+{
+    if (input.metaInfo.empty()) {
+        return NIXL_ERR_MISMATCH;
+    }
+    if (input.metaInfo[0] == MD_OWN) {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        output = new nixlPipeVramMD(false);
+        ownMDs.insert(output);
+        return NIXL_SUCCESS;
+    }
+    if (input.metaInfo[0] != MD_INNER) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    nixlBlobDesc inner_input = input;
+    inner_input.metaInfo = input.metaInfo.substr(1);
+    return inner->loadRemoteMD(inner_input, nixl_mem, remote_agent, output);
+}
+
+nixl_status_t nixlPipelineEngine::loadLocalMD(nixlBackendMD* input,
+                                              nixlBackendMD* &output)
+{
+    {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        if (ownMDs.count(input)) {
+            output = input;
+            return NIXL_SUCCESS;
+        }
+    }
+    return inner->loadLocalMD(input, output);
+}
+
+nixl_status_t nixlPipelineEngine::unloadMD(nixlBackendMD* input)
+{
+    {
+        std::lock_guard<std::mutex> guard(rangeLock);
+        if (ownMDs.count(input)) {
+            // Local ones are the registered object, released by deregisterMem
+            if (!vramByMD.count(input)) {
+                ownMDs.erase(input);
+                delete input;
+            }
+            return NIXL_SUCCESS;
+        }
+    }
+    return inner->unloadMD(input);
+}
+
+nixl_status_t nixlPipelineEngine::getConnInfo(std::string &str) const
+{
+    nixlSerDes sd;
+    std::string inner_str;
+    nixl_status_t ret;
+    uint64_t ring_addr = (uintptr_t) recvRing;
+    uint32_t slot_count = recvSlots.size();
+    uint64_t slot_size = chunkSize;
+
+    ret = inner->getConnInfo(inner_str);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+    sd.addStr("Inner", inner_str);
+    sd.addStr("Ring", ringPublic);
+    sd.addBuf("RingAddr", &ring_addr, sizeof(ring_addr));
+    sd.addBuf("SlotCount", &slot_count, sizeof(slot_count));
+    sd.addBuf("SlotSize", &slot_size, sizeof(slot_size));
+    str = sd.exportStr();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPipelineEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                                     const std::string &remote_conn_info)
+{
+    nixlSerDes sd;
+    nixlPipePeer peer;
+    nixlBlobDesc ring;
+    uint64_t ring_addr;
+    uint32_t slot_count;
+    uint64_t slot_size;
+    nixl_status_t ret;
+
+    ret = sd.importStr(remote_conn_info);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+    std::string inner_str = sd.getStr("Inner");
+    ring.metaInfo = sd.getStr("Ring");
+    if ((sd.getBuf("RingAddr", &ring_addr, sizeof(ring_addr)) != NIXL_SUCCESS) ||
+        (sd.getBuf("SlotCount", &slot_count, sizeof(slot_count)) != NIXL_SUCCESS) ||
+        (sd.getBuf("SlotSize", &slot_size, sizeof(slot_size)) != NIXL_SUCCESS)) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    ret = inner->loadRemoteConnInfo(remote_agent, inner_str);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    // Where the chunks for remote VRAM are written
+    ring.addr = ring_addr;
+    ring.len = slot_count * slot_size;
+    ring.devId = 0;
+    ret = inner->loadRemoteMD(ring, DRAM_SEG, remote_agent, peer.ringMD);
+    if (ret != NIXL_SUCCESS) {
+        std::cerr << "PIPELINE: failed to load the ring of " << remote_agent << std::endl;
+        return ret;
+    }
+    peer.ringAddr = ring_addr;
+    peer.slotCount = slot_count;
+    peer.slotSize = slot_size;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = peers.find(remote_agent);
+    if (it != peers.end()) {
+        inner->unloadMD(it->second.ringMD);
+    }
+    peers[remote_agent] = peer;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPipelineEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t* opt_args)
+{
+    bool vram = (local.getType() == VRAM_SEG) || (remote.getType() == VRAM_SEG);
+    bool own = isOwn(local) || isOwn(remote);
+    size_t size = 0;
+    bool pipelined = false;
+
+    for (auto &desc : local) {
+        size += desc.len;
+    }
+
+    // Only writes, as the receiver takes the chunks in as their notifications come
+    if (vram && (operation == NIXL_WRITE) && (remote_agent != localAgent) &&
+        inner->supportsNotif() && (own || (size >= minSize))) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = peers.find(remote_agent);
+        pipelined = (it != peers.end()) &&
+                    ((remote.getType() != VRAM_SEG) || (it->second.slotCount > 0));
+    }
+    if (own && !pipelined) {
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    nixlPipeBackendReqH *pipe_handle = new nixlPipeBackendReqH();
+
+    if (!pipelined) {
+        nixl_status_t ret = inner->prepXfer(operation, local, remote, remote_agent,
+                                            pipe_handle->inner, opt_args);
+        if (ret != NIXL_SUCCESS) {
+            delete pipe_handle;
+            return ret;
+        }
+    }
+
+    pipe_handle->pipelined = pipelined;
+    pipe_handle->viaReceiver = (remote.getType() == VRAM_SEG);
+    pipe_handle->localVram = (local.getType() == VRAM_SEG);
+    pipe_handle->remoteAgent = remote_agent;
+    handle = pipe_handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPipelineEngine::sendCtrl(const std::string &remote_agent, char tag,
+                                           const void *hdr, size_t len,
+                                           const std::string &extra)
+{
+    std::string msg(1, tag);
+
+    msg.append((const char*) hdr, len);
+    msg += extra;
+    return inner->genNotif(remote_agent, msg);
+}
+
+nixl_status_t nixlPipelineEngine::postXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t* opt_args)
+{
+    nixlPipeBackendReqH *pipe_handle = (nixlPipeBackendReqH *) handle;
+    nixl_opt_b_args_t args;
+
+    if (opt_args) {
+        args = *opt_args;
+    }
+
+    if (!pipe_handle->pipelined) {
+        if (args.hasNotif) {
+            args.notifMsg = NOTIF_PLAIN + args.notifMsg;
+        }
+        pipe_handle->bytes = 0;
+        for (auto &desc : local) {
+            pipe_handle->bytes += desc.len;
+        }
+        return inner->postXfer(operation, local, remote, remote_agent,
+                               pipe_handle->inner, &args);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (pipe_handle->status == NIXL_IN_PROG) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    // A slot of the receiver ring takes a chunk
+    size_t chunk_size = chunkSize;
+    if (pipe_handle->viaReceiver) {
+        chunk_size = std::min<size_t>(chunk_size, peers[remote_agent].slotSize);
+    }
+
+    pipe_handle->chunks.clear();
+    pipe_handle->bytes = 0;
+    for (int i = 0; i < local.descCount(); i++) {
+        const nixlMetaDesc &l = local[i];
+        const nixlMetaDesc &r = remote[i];
+
+        for (size_t off = 0; off < l.len; off += chunk_size) {
+            nixlPipeChunk chunk;
+
+            chunk.local = l.addr + off;
+            chunk.remote = r.addr + off;
+            chunk.len = std::min(chunk_size, l.len - off);
+            chunk.localMD = l.metadataP;
+            chunk.remoteMD = r.metadataP;
+            chunk.state = pipe_handle->viaReceiver ? PIPE_CHUNK_WAIT : PIPE_CHUNK_READY;
+            chunk.slot = -1;
+            chunk.stage = -1;
+            chunk.write = nullptr;
+            pipe_handle->chunks.push_back(chunk);
+        }
+        pipe_handle->bytes += l.len;
+    }
+    pipe_handle->granted = 0;
+    pipe_handle->done = 0;
+    pipe_handle->finished = false;
+    pipe_handle->hasNotif = args.hasNotif;
+    pipe_handle->notifMsg = args.notifMsg;
+    pipe_handle->reqId = nextReqId++;
+    pipe_handle->status = NIXL_IN_PROG;
+    active[pipe_handle->reqId] = pipe_handle;
+
+    if (pipe_handle->viaReceiver) {
+        nixlPipeReqHdr hdr;
+
+        hdr.reqId = pipe_handle->reqId;
+        hdr.chunkCount = pipe_handle->chunks.size();
+        hdr.msgLen = args.notifMsg.size();
+        hdr.hasMsg = args.hasNotif;
+        nixl_status_t ret = sendCtrl(remote_agent, NOTIF_REQ, &hdr, sizeof(hdr),
+                                     args.notifMsg);
+        if (ret != NIXL_SUCCESS) {
+            fail(pipe_handle, ret, false);
+            return ret;
+        }
+    }
+
+    advance(pipe_handle);
+    return pipe_handle->status;
+}
+
+nixl_status_t nixlPipelineEngine::postChunk(nixlPipeBackendReqH *handle,
+                                            nixlPipeChunk &chunk)
+{
+    nixl_meta_dlist_t local(DRAM_SEG);
+    nixl_meta_dlist_t remote(DRAM_SEG);
+    nixlMetaDesc l, r;
+    nixl_opt_b_args_t args;
+    nixl_status_t ret;
+
+    l.len = r.len = chunk.len;
+    l.devId = r.devId = 0;
+    if (handle->localVram) {
+        l.addr = (uintptr_t) stageSlots[chunk.stage].addr;
+        l.metadataP = stageMD;
+    } else {
+        l.addr = chunk.local;
+        l.metadataP = chunk.localMD;
+    }
+
+    if (handle->viaReceiver) {
+        const nixlPipePeer &peer = peers[handle->remoteAgent];
+        nixlPipeChunkHdr hdr;
+
+        r.addr = peer.ringAddr + chunk.slot * peer.slotSize;
+        r.metadataP = peer.ringMD;
+
+        hdr.reqId = handle->reqId;
+        hdr.slot = chunk.slot;
+        hdr.addr = chunk.remote;
+        hdr.len = chunk.len;
+        args.notifMsg.push_back(NOTIF_CHUNK);
+        args.notifMsg.append((const char*) &hdr, sizeof(hdr));
+        args.hasNotif = true;
+    } else {
+        r.addr = chunk.remote;
+        r.metadataP = chunk.remoteMD;
+    }
+    local.addDesc(l);
+    remote.addDesc(r);
+
+    ret = inner->prepXfer(NIXL_WRITE, local, remote, handle->remoteAgent,
+                          chunk.write, &args);
+    if (ret != NIXL_SUCCESS) {
+        chunk.write = nullptr;
+        return ret;
+    }
+    return inner->postXfer(NIXL_WRITE, local, remote, handle->remoteAgent,
+                           chunk.write, &args);
+}
+
+void nixlPipelineEngine::advance(nixlPipeBackendReqH *handle)
+{
+    for (auto &chunk : handle->chunks) {
+        nixl_status_t ret = NIXL_IN_PROG;
+
+        if ((chunk.state == PIPE_CHUNK_READY) && handle->localVram) {
+            if (freeStageSlots.empty()) {
+                continue;
+            }
+            chunk.stage = freeStageSlots.back();
+            freeStageSlots.pop_back();
+
+            nixlPipeSlot &stage = stageSlots[chunk.stage];
+            if ((cudaMemcpyAsync(stage.addr, (void*) chunk.local, chunk.len,
+                                 cudaMemcpyDeviceToHost, d2hStream) != cudaSuccess) ||
+                (cudaEventRecord(stage.event, d2hStream) != cudaSuccess)) {
+                std::cerr << "PIPELINE: failed to copy from VRAM" << std::endl;
+                fail(handle, NIXL_ERR_BACKEND, true);
+                return;
+            }
+            chunk.state = PIPE_CHUNK_COPY;
+        }
+
+        if (chunk.state == PIPE_CHUNK_COPY) {
+            cudaError_t err = cudaEventQuery(stageSlots[chunk.stage].event);
+            if (err == cudaErrorNotReady) {
+                continue;
+            }
+            if (err != cudaSuccess) {
+                std::cerr << "PIPELINE: failed to copy from VRAM" << std::endl;
+                fail(handle, NIXL_ERR_BACKEND, true);
+                return;
+            }
+            chunk.state = PIPE_CHUNK_READY;
+        }
+
+        if (chunk.state == PIPE_CHUNK_READY) {
+            ret = postChunk(handle, chunk);
+            chunk.state = PIPE_CHUNK_WRITE;
+        } else if (chunk.state == PIPE_CHUNK_WRITE) {
+            ret = inner->checkXfer(chunk.write);
+        } else {
+            continue;
+        }
+
+        if (ret < 0) {
+            fail(handle, ret, true);
+            return;
+        }
+        if (ret == NIXL_SUCCESS) {
+            inner->releaseReqH(chunk.write);
+            chunk.write = nullptr;
+            if (chunk.stage >= 0) {
+                freeStageSlots.push_back(chunk.stage);
+                chunk.stage = -1;
+            }
+            chunk.state = PIPE_CHUNK_DONE;
+            handle->done++;
+        }
+    }
+
+    if ((handle->done < handle->chunks.size()) ||
+        (handle->viaReceiver && !handle->finished)) {
+        return;
+    }
+
+    // Remote DRAM is written directly, the notification follows the last chunk
+    nixl_status_t ret = NIXL_SUCCESS;
+    if (!handle->viaReceiver && handle->hasNotif) {
+        ret = inner->genNotif(handle->remoteAgent, NOTIF_PLAIN + handle->notifMsg);
+    }
+    active.erase(handle->reqId);
+    handle->status = ret;
+}
+
+void nixlPipelineEngine::cancel(nixlPipeBackendReqH *handle, bool notify_peer)
+{
+    nixlPipeDrain drain;
+
+    for (auto &chunk : handle->chunks) {
+        if (chunk.state == PIPE_CHUNK_COPY) {
+            cudaEventSynchronize(stageSlots[chunk.stage].event);
+        }
+        if (chunk.write && (inner->checkXfer(chunk.write) == NIXL_IN_PROG)) {
+            drain.writes.emplace_back(chunk.write, chunk.stage);
+            chunk.write = nullptr;
+            chunk.stage = -1;
+        }
+        if (chunk.write) {
+            inner->releaseReqH(chunk.write);
+            chunk.write = nullptr;
+        }
+        if (chunk.stage >= 0) {
+            freeStageSlots.push_back(chunk.stage);
+            chunk.stage = -1;
+        }
+    }
+    handle->chunks.clear();
+
+    drain.remoteAgent = handle->remoteAgent;
+    drain.reqId = handle->reqId;
+    drain.notifyPeer = notify_peer && handle->viaReceiver && !handle->finished;
+    active.erase(handle->reqId);
+
+    // The receiver frees its slots on the cancel, so it waits for the writes
+    if (drain.writes.empty()) {
+        if (drain.notifyPeer) {
+            nixlPipeReqIdHdr hdr;
+
+            hdr.reqId = drain.reqId;
+            sendCtrl(drain.remoteAgent, NOTIF_CANCEL, &hdr, sizeof(hdr));
+        }
+        return;
+    }
+    drains.push_back(std::move(drain));
+}
+
+void nixlPipelineEngine::checkDrains()
+{
+    for (auto it = drains.begin(); it != drains.end();) {
+        auto &writes = it->writes;
+
+        for (auto w = writes.begin(); w != writes.end();) {
+            if (inner->checkXfer(w->first) == NIXL_IN_PROG) {
+                w++;
+                continue;
+            }
+            inner->releaseReqH(w->first);
+            if (w->second >= 0) {
+                freeStageSlots.push_back(w->second);
+            }
+            w = writes.erase(w);
+        }
+        if (!writes.empty()) {
+            it++;
+            continue;
+        }
+
+        if (it->notifyPeer) {
+            nixlPipeReqIdHdr hdr;
+
+            hdr.reqId = it->reqId;
+            sendCtrl(it->remoteAgent, NOTIF_CANCEL, &hdr, sizeof(hdr));
+        }
+        it = drains.erase(it);
+    }
+}
+
+void nixlPipelineEngine::fail(nixlPipeBackendReqH *handle, nixl_status_t err,
+                              bool notify_peer)
+{
+    cancel(handle, notify_peer);
+    handle->status = err;
+}
+
+nixl_status_t nixlPipelineEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlPipeBackendReqH *pipe_handle = (nixlPipeBackendReqH *) handle;
+
+    if (!pipe_handle->pipelined) {
+        return inner->checkXfer(pipe_handle->inner);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (pipe_handle->status == NIXL_IN_PROG) {
+        pump();
+    }
+    return pipe_handle->status;
+}
+
+nixl_status_t nixlPipelineEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlPipeBackendReqH *pipe_handle = (nixlPipeBackendReqH *) handle;
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    if (pipe_handle->inner) {
+        ret = inner->releaseReqH(pipe_handle->inner);
+    }
+    if (pipe_handle->pipelined) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (pipe_handle->status == NIXL_IN_PROG) {
+            cancel(pipe_handle, true);
+        }
+    }
+
+    delete pipe_handle;
+    return ret;
+}
+
+nixl_status_t nixlPipelineEngine::getXferStats(const nixlBackendReqH* handle,
+                                               nixl_b_params_t &stats) const
+{
+    const nixlPipeBackendReqH *pipe_handle = (const nixlPipeBackendReqH *) handle;
+
+    stats["pipelined"] = pipe_handle->pipelined ? "1" : "0";
+    stats["via_receiver"] = (pipe_handle->pipelined && pipe_handle->viaReceiver) ? "1" : "0";
+    stats["chunks"] = std::to_string(pipe_handle->chunks.size());
+    stats["bytes"] = std::to_string(pipe_handle->bytes);
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Receiver side
+*****************************************/
+
+void nixlPipelineEngine::dropRecv(const nixl_pipe_req_key_t &key, bool notify_peer)
+{
+    auto it = recvReqs.find(key);
+
+    if (it == recvReqs.end()) {
+        return;
+    }
+    // Slots being copied out are freed with their copy
+    for (auto slot : it->second.slots) {
+        freeRecvSlots.push_back(slot);
+    }
+    recvReqs.erase(it);
+
+    if (notify_peer) {
+        nixlPipeReqIdHdr hdr;
+
+        hdr.reqId = key.second;
+        sendCtrl(key.first, NOTIF_ERROR, &hdr, sizeof(hdr));
+    }
+}
+
+// Round robin over the requests, so one large transfer does not hold back the others
+void nixlPipelineEngine::grantSlots()
+{
+    while (!freeRecvSlots.empty() && !grantQueue.empty()) {
+        nixl_pipe_req_key_t key = grantQueue.front();
+        grantQueue.pop_front();
+
+        auto it = recvReqs.find(key);
+        if ((it == recvReqs.end()) || (it->second.ungranted == 0)) {
+            continue;
+        }
+
+        nixlPipeRecvReq &req = it->second;
+        nixlPipeGrantHdr hdr;
+        std::string slots;
+
+        hdr.reqId = key.second;
+        hdr.count = std::min<size_t>(req.ungranted, freeRecvSlots.size());
+        for (uint32_t i = 0; i < hdr.count; i++) {
+            uint32_t slot = freeRecvSlots.back();
+
+            freeRecvSlots.pop_back();
+            req.slots.insert(slot);
+            slots.append((const char*) &slot, sizeof(slot));
+        }
+        req.ungranted -= hdr.count;
+
+        if (sendCtrl(key.first, NOTIF_GRANT, &hdr, sizeof(hdr), slots) != NIXL_SUCCESS) {
+            std::cerr << "PIPELINE: failed to grant slots to " << key.first << std::endl;
+            dropRecv(key, false);
+            continue;
+        }
+        if (req.ungranted) {
+            grantQueue.push_back(key);
+        }
+    }
+}
+
+// The copies of a stream complete in order
+void nixlPipelineEngine::checkCopies()
+{
+    while (!copies.empty()) {
+        uint32_t slot = copies.front().first;
+        nixl_pipe_req_key_t key = copies.front().second;
+        cudaError_t err = cudaEventQuery(recvSlots[slot].event);
+
+        if (err == cudaErrorNotReady) {
+            return;
+        }
+        copies.pop_front();
+        freeRecvSlots.push_back(slot);
+
+        auto it = recvReqs.find(key);
+        if (it == recvReqs.end()) {
+            continue;
+        }
+        if (err != cudaSuccess) {
+            std::cerr << "PIPELINE: failed to copy to VRAM" << std::endl;
+            dropRecv(key, true);
+            continue;
+        }
+
+        nixlPipeRecvReq &req = it->second;
+        if (++req.copied < req.chunkCount) {
+            continue;
+        }
+
+        nixlPipeReqIdHdr hdr;
+        hdr.reqId = key.second;
+        sendCtrl(key.first, NOTIF_FINISH, &hdr, sizeof(hdr));
+        if (req.hasMsg) {
+            userNotifs.emplace_back(key.first, std::move(req.msg));
+        }
+        recvReqs.erase(it);
+    }
+}
+
+void nixlPipelineEngine::handleChunk(const std::string &remote_agent,
+                                     const std::string &msg)
+{
+    nixlPipeChunkHdr hdr;
+
+    if (msg.size() != 1 + sizeof(hdr)) {
+        std::cerr << "PIPELINE: dropped a malformed chunk from " << remote_agent << std::endl;
+        return;
+    }
+    memcpy(&hdr, msg.data() + 1, sizeof(hdr));
+
+    nixl_pipe_req_key_t key(remote_agent, (uint64_t) hdr.reqId);
+    auto it = recvReqs.find(key);
+    if ((it == recvReqs.end()) || !it->second.slots.count(hdr.slot)) {
+        // Of a cancelled request
+        return;
+    }
+    it->second.slots.erase(hdr.slot);
+
+    if ((hdr.len > chunkSize) || !isLocalVram(hdr.addr, hdr.len)) {
+        std::cerr << "PIPELINE: " << remote_agent << " wrote to unregistered VRAM" << std::endl;
+        freeRecvSlots.push_back(hdr.slot);
+        dropRecv(key, true);
+        return;
+    }
+
+    nixlPipeSlot &slot = recvSlots[hdr.slot];
+    if ((cudaMemcpyAsync((void*) hdr.addr, slot.addr, hdr.len,
+                         cudaMemcpyHostToDevice, h2dStream) != cudaSuccess) ||
+        (cudaEventRecord(slot.event, h2dStream) != cudaSuccess)) {
+        std::cerr << "PIPELINE: failed to copy to VRAM" << std::endl;
+        freeRecvSlots.push_back(hdr.slot);
+        dropRecv(key, true);
+        return;
+    }
+    copies.emplace_back((uint32_t) hdr.slot, key);
+}
+
+/****************************************
+ * Notifications
+*****************************************/
+
+void nixlPipelineEngine::handleGrant(const std::string &msg)
+{
+    nixlPipeGrantHdr hdr;
+
+    if (msg.size() < 1 + sizeof(hdr)) {
+        return;
+    }
+    memcpy(&hdr, msg.data() + 1, sizeof(hdr));
+    if (msg.size() != 1 + sizeof(hdr) + hdr.count * sizeof(uint32_t)) {
+        return;
+    }
+
+    // Released requests are cancelled at the receiver already
+    auto it = active.find(hdr.reqId);
+    if (it == active.end()) {
+        return;
+    }
+
+    nixlPipeBackendReqH *handle = it->second;
+    auto peer = peers.find(handle->remoteAgent);
+    uint32_t slot_count = (peer != peers.end()) ? peer->second.slotCount : 0;
+    const char *slots = msg.data() + 1 + sizeof(hdr);
+    for (uint32_t i = 0; (i < hdr.count) && (handle->granted < handle->chunks.size()); i++) {
+        nixlPipeChunk &chunk = handle->chunks[handle->granted++];
+        uint32_t slot;
+
+        memcpy(&slot, slots + i * sizeof(slot), sizeof(slot));
+        // Written at the slot offset of the peer ring, so it has to be in it
+        if (slot >= slot_count) {
+            std::cerr << "PIPELINE: " << handle->remoteAgent << " granted slot "
+                      << slot << " out of its ring" << std::endl;
+            fail(handle, NIXL_ERR_BACKEND, true);
+            return;
+        }
+        chunk.slot = slot;
+        chunk.state = PIPE_CHUNK_READY;
+    }
+}
+
+void nixlPipelineEngine::handleNotif(const std::string &remote_agent,
+                                     const std::string &msg)
+{
+    nixlPipeReqHdr req_hdr;
+    nixlPipeReqIdHdr id_hdr;
+
+    switch (msg[0]) {
+    case NOTIF_PLAIN:
+        userNotifs.emplace_back(remote_agent, msg.substr(1));
+        return;
+
+    case NOTIF_REQ:
+        if (msg.size() < 1 + sizeof(req_hdr)) {
+            break;
+        }
+        memcpy(&req_hdr, msg.data() + 1, sizeof(req_hdr));
+        if (msg.size() != 1 + sizeof(req_hdr) + req_hdr.msgLen) {
+            break;
+        }
+        {
+            nixl_pipe_req_key_t key(remote_agent, (uint64_t) req_hdr.reqId);
+            nixlPipeRecvReq &req = recvReqs[key];
+
+            req.chunkCount = req_hdr.chunkCount;
+            req.ungranted = req_hdr.chunkCount;
+            req.copied = 0;
+            req.hasMsg = req_hdr.hasMsg;
+            req.msg = msg.substr(1 + sizeof(req_hdr));
+            if (req.chunkCount) {
+                grantQueue.push_back(key);
+                return;
+            }
+
+            // Nothing to copy, only the message
+            id_hdr.reqId = req_hdr.reqId;
+            sendCtrl(remote_agent, NOTIF_FINISH, &id_hdr, sizeof(id_hdr));
+            if (req.hasMsg) {
+                userNotifs.emplace_back(remote_agent, std::move(req.msg));
+            }
+            recvReqs.erase(key);
+        }
+        return;
+
+    case NOTIF_GRANT:
+        handleGrant(msg);
+        return;
+
+    case NOTIF_CHUNK:
+        handleChunk(remote_agent, msg);
+        return;
+
+    case NOTIF_FINISH:
+    case NOTIF_CANCEL:
+    case NOTIF_ERROR:
+        if (msg.size() != 1 + sizeof(id_hdr)) {
+            break;
+        }
+        memcpy(&id_hdr, msg.data() + 1, sizeof(id_hdr));
+        if (msg[0] == NOTIF_CANCEL) {
+            dropRecv(nixl_pipe_req_key_t(remote_agent, (uint64_t) id_hdr.reqId), false);
+        } else {
+            auto it = active.find(id_hdr.reqId);
+            if (it == active.end()) {
+                return;
+            }
+            if (msg[0] == NOTIF_FINISH) {
+                it->second->finished = true;
+            } else {
+                std::cerr << "PIPELINE: " << remote_agent << " dropped a transfer" << std::endl;
+                fail(it->second, NIXL_ERR_BACKEND, false);
+            }
+        }
+        return;
+
+    default:
+        break;
+    }
+    std::cerr << "PIPELINE: dropped a malformed notification from "
+              << remote_agent << std::endl;
+}
+
+void nixlPipelineEngine::pump()
+{
+    notif_list_t inner_list;
+
+    if (inner->getNotifs(inner_list) == NIXL_SUCCESS) {
+        for (auto &notif : inner_list) {
+            if (!notif.second.empty()) {
+                handleNotif(notif.first, notif.second);
+            }
+        }
+    }
+
+    checkCopies();
+    checkDrains();
+    grantSlots();
+
+    // Advancing can complete and remove requests
+    std::vector<nixlPipeBackendReqH*> handles;
+    for (auto &req : active) {
+        handles.push_back(req.second);
+    }
+    for (auto handle : handles) {
+        advance(handle);
+    }
+}
+
+nixl_status_t nixlPipelineEngine::getNotifs(notif_list_t &notif_list)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    pump();
+    for (auto &notif : userNotifs) {
+        notif_list.push_back(std::move(notif));
+    }
+    userNotifs.clear();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPipelineEngine::genNotif(const std::string &remote_agent,
+                                           const std::string &msg)
+{
+    return inner->genNotif(remote_agent, NOTIF_PLAIN + msg);
+}
+
+int nixlPipelineEngine::progress()
+{
+    int ret = inner->progress();
+
+    std::lock_guard<std::mutex> guard(lock);
+    pump();
+    return ret;
+}
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __PIPELINE_BACKEND_H
+#define __PIPELINE_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <cuda_runtime.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "backend/backend_engine.h"
+
+// One chunk of pinned host memory, in the staging ring of a sender or a receiver
+class nixlPipeSlot {
+    public:
+        char *addr;
+        // Of the copy between the slot and VRAM
+        cudaEvent_t event;
+};
+
+// Receiver ring of a peer, where the chunks it granted are written
+class nixlPipePeer {
+    public:
+        nixlBackendMD *ringMD = nullptr;
+        uintptr_t ringAddr = 0;
+        uint32_t slotCount = 0;
+        size_t slotSize = 0;
+};
+
+// VRAM registered while the inner engine has no VRAM support, so it can
+// only go through pipelined transfers
+class nixlPipeVramMD : public nixlBackendMD {
+    public:
+        nixlPipeVramMD(bool is_private) : nixlBackendMD(is_private) {}
+};
+
+typedef enum {
+    PIPE_CHUNK_WAIT,     // For a slot of the receiver ring
+    PIPE_CHUNK_READY,    // To be staged or written
+    PIPE_CHUNK_COPY,     // VRAM to a local stage slot
+    PIPE_CHUNK_WRITE,    // Inner write to the remote agent
+    PIPE_CHUNK_DONE
+} nixl_pipe_chunk_state_t;
+
+class nixlPipeChunk {
+    public:
+        uintptr_t local;
+        uintptr_t remote;
+        size_t len;
+        // Inner metadata of local DRAM and of remote DRAM, when they are
+        // written from or to directly
+        nixlBackendMD *localMD;
+        nixlBackendMD *remoteMD;
+        nixl_pipe_chunk_state_t state;
+        int32_t slot;
+        int32_t stage;
+        nixlBackendReqH *write;
+};
+
+// Inner writes of a cancelled request still in flight. Their stage slots, and
+// the receiver slots they write to, are only given back once they end.
+class nixlPipeDrain {
+    public:
+        std::vector<std::pair<nixlBackendReqH*, int32_t>> writes;
+        std::string remoteAgent;
+        uint64_t reqId;
+        bool notifyPeer;
+};
+
+class nixlPipeBackendReqH : public nixlBackendReqH {
+    public:
+        // Transfers that are not pipelined go straight to the inner engine
+        nixlBackendReqH *inner;
+        bool pipelined;
+        // Remote VRAM, written through the receiver ring. Remote DRAM is
+        // written directly from the local stage slots.
+        bool viaReceiver;
+        bool localVram;
+        std::string remoteAgent;
+
+        // Of the current post
+        uint64_t reqId;
+        std::vector<nixlPipeChunk> chunks;
+        size_t granted;
+        size_t done;
+        bool finished;
+        bool hasNotif;
+        nixl_blob_t notifMsg;
+        nixl_status_t status;
+        size_t bytes;
+
+        nixlPipeBackendReqH() {
+            inner = nullptr;
+            pipelined = false;
+            viaReceiver = false;
+            localVram = false;
+            reqId = 0;
+            granted = 0;
+            done = 0;
+            finished = false;
+            hasNotif = false;
+            status = NIXL_ERR_NOT_POSTED;
+            bytes = 0;
+        }
+        ~nixlPipeBackendReqH() { }
+};
+
+// A pipelined write the receiver takes in, keyed by sender and request ID
+class nixlPipeRecvReq {
+    public:
+        uint32_t chunkCount;
+        uint32_t ungranted;
+        uint32_t copied;
+        bool hasMsg;
+        nixl_blob_t msg;
+        // Granted and not written yet, given back if the sender cancels
+        std::set<uint32_t> slots;
+};
+
+typedef std::pair<std::string, uint64_t> nixl_pipe_req_key_t;
+
+class nixlPipelineEngine : public nixlBackendEngine {
+    private:
+        nixlBackendFactory *factory;
+        nixlBackendEngine *inner;
+        bool innerVram;
+
+        size_t chunkSize;
+        size_t slotCount;
+        size_t minSize;
+
+        cudaStream_t d2hStream;
+        cudaStream_t h2dStream;
+
+        // Chunks of VRAM on their way out, and on their way in
+        char *stageRing;
+        nixlBackendMD *stageMD;
+        std::vector<nixlPipeSlot> stageSlots;
+        char *recvRing;
+        nixlBackendMD *recvMD;
+        std::vector<nixlPipeSlot> recvSlots;
+        std::vector<uint32_t> freeRecvSlots;
+
+        std::vector<uint32_t> freeStageSlots;
+        std::string ringPublic;
+
+        std::map<std::string, nixlPipePeer> peers;
+        std::set<nixlBackendMD*> ownMDs;
+
+        // Local VRAM the peers may copy into, base -> end
+        std::map<uintptr_t, uintptr_t> vramRanges;
+        std::map<nixlBackendMD*, uintptr_t> vramByMD;
+        mutable std::mutex rangeLock;
+
+        // Sender side
+        uint64_t nextReqId;
+        std::map<uint64_t, nixlPipeBackendReqH*> active;
+        std::vector<nixlPipeDrain> drains;
+
+        // Receiver side
+        std::map<nixl_pipe_req_key_t, nixlPipeRecvReq> recvReqs;
+        std::deque<nixl_pipe_req_key_t> grantQueue;
+        std::deque<std::pair<uint32_t, nixl_pipe_req_key_t>> copies;
+
+        // Notifications of the inner engine meant for the application
+        notif_list_t userNotifs;
+
+        std::mutex lock;
+
+        bool initRing(size_t count, char* &ring, nixlBackendMD* &md,
+                      std::vector<nixlPipeSlot> &slots);
+        void finiRing(char *ring, nixlBackendMD *md, std::vector<nixlPipeSlot> &slots);
+        bool isLocalVram(uintptr_t addr, size_t len);
+        bool isOwn(const nixl_meta_dlist_t &descs);
+        nixl_status_t sendCtrl(const std::string &remote_agent, char tag,
+                               const void *hdr, size_t len,
+                               const std::string &extra = "");
+
+        // Everything below runs with the lock held
+        void pump();
+        void handleNotif(const std::string &remote_agent, const std::string &msg);
+        void handleGrant(const std::string &msg);
+        void handleChunk(const std::string &remote_agent, const std::string &msg);
+        void dropRecv(const nixl_pipe_req_key_t &key, bool notify_peer);
+        void grantSlots();
+        void checkCopies();
+        void checkDrains();
+        nixl_status_t postChunk(nixlPipeBackendReqH *handle, nixlPipeChunk &chunk);
+        void advance(nixlPipeBackendReqH *handle);
+        void cancel(nixlPipeBackendReqH *handle, bool notify_peer);
+        void fail(nixlPipeBackendReqH *handle, nixl_status_t err, bool notify_peer);
+
+    public:
+        nixlPipelineEngine(const nixlBackendInitParams* init_params);
+        ~nixlPipelineEngine();
+
+        bool supportsRemote() const {
+            return inner && inner->supportsRemote();
+        }
+        bool supportsLocal() const {
+            return inner && inner->supportsLocal();
+        }
+        bool supportsNotif() const {
+            return inner && inner->supportsNotif();
+        }
+        bool supportsProgTh() const {
+            return inner && inner->supportsProgTh();
+        }
+        bool supportsConcurrentLoad() const {
+            return inner && inner->supportsConcurrentLoad();
+        }
+
+        nixl_mem_list_t getSupportedMems() const;
+
+        // Inner DRAM performance, bounded by the PCIe copies
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const;
+        nixl_status_t getPeerXferHints(const nixl_mem_t &local_mem,
+                                       const nixl_mem_t &remote_mem,
+                                       const std::string &remote_agent,
+                                       nixlBackendXferHints &hints) const;
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t connect(const std::string &remote_agent) {
+            return inner->connect(remote_agent);
+        }
+        nixl_status_t connectAgents(const std::vector<std::string> &remote_agents,
+                                    std::vector<nixl_status_t> &statuses) {
+            return inner->connectAgents(remote_agents, statuses);
+        }
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return inner->disconnect(remote_agent);
+        }
+
+        nixl_status_t getPublicData(const nixlBackendMD* meta,
+                                    std::string &str) const;
+        nixl_status_t getConnInfo(std::string &str) const;
+        nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                         const std::string &remote_conn_info);
+        nixl_status_t loadRemoteMD(const nixlBlobDesc &input,
+                                   const nixl_mem_t &nixl_mem,
+                                   const std::string &remote_agent,
+                                   nixlBackendMD* &output);
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output);
+        nixl_status_t unloadMD(nixlBackendMD* input);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+
+        nixl_status_t getXferStats(const nixlBackendReqH* handle,
+                                   nixl_b_params_t &stats) const;
+
+        nixl_status_t getNotifs(notif_list_t &notif_list);
+        nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
+
+        int progress();
+};
+#endif
@@ -0,0 +1,449 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <sys/uio.h>
+#include "posix_backend.h"
+
+#ifdef HAVE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+/** Submission and completion queue depth */
+#define DEFAULT_RING_SIZE 256
+/** Split transfers in requests of up to 16 MB */
+#define DEFAULT_MAX_REQUEST_SIZE (16 * 1024 * 1024)
+/** Fixed file and buffer table sizes */
+#define DEFAULT_FIXED_SLOTS 1024
+/** The kernel limits a fixed buffer to 1 GB */
+#define MAX_FIXED_BUF_SIZE (1UL << 30)
+/** VRAM bounce buffers, count and size */
+#define DEFAULT_BOUNCE_COUNT 16
+#define DEFAULT_BOUNCE_SIZE (4 * 1024 * 1024)
+
+static bool getSizeParam(nixl_b_params_t* custom_params, const std::string &key,
+                         size_t &value)
+{
+    if (custom_params->count(key) == 0) {
+        return true;
+    }
+    try {
+        value = std::stoul((*custom_params)[key]);
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid " << key << " parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+nixlPosixEngine::nixlPosixEngine(const nixlBackendInitParams* init_params)
+    : nixlBackendEngine(init_params), queue("POSIX", "end of file")
+{
+    size_t ring_size = DEFAULT_RING_SIZE;
+    size_t fixed_slots = DEFAULT_FIXED_SLOTS;
+    size_t bounce_count = DEFAULT_BOUNCE_COUNT;
+    int ret;
+
+    maxRequestSize = DEFAULT_MAX_REQUEST_SIZE;
+    bounceSize = DEFAULT_BOUNCE_SIZE;
+
+    nixl_b_params_t* custom_params = init_params->customParams;
+    if (custom_params) {
+        if (!getSizeParam(custom_params, "ring_size", ring_size) ||
+            !getSizeParam(custom_params, "max_request_size", maxRequestSize) ||
+            !getSizeParam(custom_params, "fixed_slots", fixed_slots) ||
+            !getSizeParam(custom_params, "bounce_count", bounce_count) ||
+            !getSizeParam(custom_params, "bounce_size", bounceSize)) {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    if ((ring_size == 0) || (maxRequestSize == 0) || (bounceSize == 0)) {
+        std::cerr << "ring_size, max_request_size and bounce_size must be set" << std::endl;
+        this->initErr = true;
+        return;
+    }
+
+    ret = queue.init(ring_size, 0);
+    if (ret < 0) {
+        std::cerr << "io_uring_queue_init failed: " << strerror(-ret) << std::endl;
+        this->initErr = true;
+        return;
+    }
+
+    // Fixed files and buffers save the per-IO lookups and page pinning,
+    // without them IOs are still posted with plain fds and addresses
+    if (fixed_slots > 0) {
+        if (io_uring_register_files_sparse(&queue.ring, fixed_slots) == 0) {
+            fileSlots.assign(fixed_slots, -1);
+        }
+        if (io_uring_register_buffers_sparse(&queue.ring, fixed_slots) == 0) {
+            bufSlots.assign(fixed_slots, false);
+        }
+    }
+
+#ifdef HAVE_CUDA
+    for (size_t i = 0; i < bounce_count; i++) {
+        nixlPosixBounce bounce;
+
+        if (cudaMallocHost(&bounce.buf, bounceSize) != cudaSuccess) {
+            std::cerr << "Failed to allocate VRAM bounce buffers" << std::endl;
+            this->initErr = true;
+            return;
+        }
+        bounce.bufIdx = getSlot(bufSlots);
+        if (bounce.bufIdx >= 0) {
+            struct iovec iov = {bounce.buf, bounceSize};
+            __u64 tag = 0;
+            if (io_uring_register_buffers_update_tag(&queue.ring, bounce.bufIdx,
+                                                     &iov, &tag, 1) != 1) {
+                bufSlots[bounce.bufIdx] = false;
+                bounce.bufIdx = -1;
+            }
+        }
+        bounces.push_back(bounce);
+    }
+    for (auto &bounce : bounces) {
+        freeBounces.push_back(&bounce);
+    }
+#else
+    (void) bounce_count;
+#endif
+
+    this->initErr = false;
+}
+
+nixlPosixEngine::~nixlPosixEngine()
+{
+#ifdef HAVE_CUDA
+    for (auto &bounce : bounces) {
+        cudaFreeHost(bounce.buf);
+    }
+#endif
+}
+
+int nixlPosixEngine::getSlot(std::vector<bool> &slots)
+{
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (!slots[i]) {
+            slots[i] = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+nixl_status_t nixlPosixEngine::registerMem(const nixlBlobDesc &mem,
+                                           const nixl_mem_t &nixl_mem,
+                                           nixlBackendMD* &out)
+{
+    nixlPosixMetadata *md = new nixlPosixMetadata();
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    md->type = nixl_mem;
+
+    switch (nixl_mem) {
+        case FILE_SEG: {
+            md->fd = mem.devId;
+
+            // Every registration of an fd shares its slot
+            auto it = fileByFd.find(md->fd);
+            if (it != fileByFd.end()) {
+                md->fileIdx = it->second.first;
+                it->second.second++;
+                break;
+            }
+
+            for (size_t i = 0; i < fileSlots.size(); i++) {
+                if (fileSlots[i] != -1) {
+                    continue;
+                }
+                int fd = md->fd;
+                if (io_uring_register_files_update(&queue.ring, i, &fd, 1) == 1) {
+                    fileSlots[i] = fd;
+                    md->fileIdx = i;
+                }
+                break;
+            }
+            fileByFd[md->fd] = std::make_pair(md->fileIdx, 1U);
+            break;
+        }
+
+        case DRAM_SEG: {
+            md->base = (void*) mem.addr;
+            md->size = mem.len;
+
+            if (mem.len <= MAX_FIXED_BUF_SIZE) {
+                md->bufIdx = getSlot(bufSlots);
+            }
+            if (md->bufIdx >= 0) {
+                struct iovec iov = {md->base, md->size};
+                __u64 tag = 0;
+                if (io_uring_register_buffers_update_tag(&queue.ring, md->bufIdx,
+                                                         &iov, &tag, 1) != 1) {
+                    bufSlots[md->bufIdx] = false;
+                    md->bufIdx = -1;
+                }
+            }
+            break;
+        }
+
+#ifdef HAVE_CUDA
+        case VRAM_SEG:
+            // Staged through the bounce buffers, nothing to pin
+            md->base = (void*) mem.addr;
+            md->size = mem.len;
+            break;
+#endif
+
+        default:
+            delete md;
+            return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    out = (nixlBackendMD*) md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPosixEngine::deregisterMem(nixlBackendMD* meta)
+{
+    nixlPosixMetadata *md = (nixlPosixMetadata *) meta;
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (md->type == FILE_SEG) {
+        auto it = fileByFd.find(md->fd);
+        if ((it != fileByFd.end()) && (--it->second.second == 0)) {
+            if (md->fileIdx >= 0) {
+                int fd = -1;
+                io_uring_register_files_update(&queue.ring, md->fileIdx, &fd, 1);
+                fileSlots[md->fileIdx] = -1;
+            }
+            fileByFd.erase(it);
+        }
+    } else if (md->bufIdx >= 0) {
+        struct iovec iov = {nullptr, 0};
+        __u64 tag = 0;
+        io_uring_register_buffers_update_tag(&queue.ring, md->bufIdx, &iov, &tag, 1);
+        bufSlots[md->bufIdx] = false;
+    }
+
+    delete md;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPosixEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                        const nixl_meta_dlist_t &local,
+                                        const nixl_meta_dlist_t &remote,
+                                        const std::string &remote_agent,
+                                        nixlBackendReqH* &handle,
+                                        const nixl_opt_b_args_t* opt_args)
+{
+    size_t buf_cnt = local.descCount();
+    size_t file_cnt = remote.descCount();
+
+    // Basic validation
+    if ((buf_cnt != file_cnt) ||
+        ((operation != NIXL_READ) && (operation != NIXL_WRITE))) {
+        std::cerr << "Error in count or operation selection\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    if ((remote.getType() != FILE_SEG) && (local.getType() != FILE_SEG)) {
+        std::cerr << "Only support I/O between memory (DRAM/VRAM) and file type\n";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    bool is_local_file = (local.getType() == FILE_SEG);
+    const nixl_meta_dlist_t &bufs = is_local_file ? remote : local;
+    const nixl_meta_dlist_t &files = is_local_file ? local : remote;
+    bool is_vram = (bufs.getType() == VRAM_SEG);
+    nixlPosixBackendReqH *posix_handle = new nixlPosixBackendReqH();
+
+    for (size_t i = 0; i < buf_cnt; i++) {
+        nixlPosixMetadata *buf_md = (nixlPosixMetadata *) bufs[i].metadataP;
+        nixlPosixMetadata *file_md = (nixlPosixMetadata *) files[i].metadataP;
+
+        if (!bufs[i].addr || !buf_md || !file_md) {
+            delete posix_handle;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        // VRAM pieces have to fit in a bounce buffer
+        size_t piece_max = is_vram ? std::min(maxRequestSize, bounceSize) :
+                                     maxRequestSize;
+        size_t total_size = bufs[i].len;
+        size_t current_offset = 0;
+
+        while (current_offset < total_size) {
+            nixlPosixIO io;
+
+            io.owner = posix_handle;
+            io.addr = (char*) bufs[i].addr + current_offset;
+            io.size = std::min(total_size - current_offset, piece_max);
+            io.offset = (size_t) files[i].addr + current_offset;
+            io.fd = file_md->fd;
+            io.fileIdx = file_md->fileIdx;
+            io.bufIdx = buf_md->bufIdx;
+            io.isRead = (operation == NIXL_READ);
+            io.isVram = is_vram;
+            io.done = 0;
+            io.bounce = nullptr;
+            posix_handle->ios.push_back(io);
+
+            current_offset += io.size;
+        }
+    }
+
+    if (posix_handle->ios.empty()) {
+        delete posix_handle;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    handle = posix_handle;
+    return NIXL_SUCCESS;
+}
+
+// Fills a submission entry for the rest of io, false if the ring or the
+// bounce buffers are exhausted
+bool nixlPosixEngine::prepIO(nixlPosixIO *io)
+{
+    if (!queue.hasRoom()) {
+        return false;
+    }
+
+    if (io->isVram && !io->bounce) {
+        if (freeBounces.empty()) {
+            return false;
+        }
+        io->bounce = freeBounces.back();
+        freeBounces.pop_back();
+
+#ifdef HAVE_CUDA
+        if (!io->isRead &&
+            (cudaMemcpy(io->bounce->buf, io->addr, io->size,
+                        cudaMemcpyDeviceToHost) != cudaSuccess)) {
+            freeBounces.push_back(io->bounce);
+            io->bounce = nullptr;
+            io->owner->status = NIXL_ERR_BACKEND;
+            io->owner->completed++;
+            return true;
+        }
+#endif
+    }
+
+    struct io_uring_sqe *sqe = queue.getSqe();
+    if (!sqe) {
+        return false;
+    }
+
+    void *buf = io->bounce ? io->bounce->buf : io->addr;
+    int buf_idx = io->bounce ? io->bounce->bufIdx : io->bufIdx;
+    int fd = (io->fileIdx >= 0) ? io->fileIdx : io->fd;
+    char *pos = (char*) buf + io->done;
+    size_t len = io->size - io->done;
+    size_t offset = io->offset + io->done;
+
+    if (buf_idx >= 0) {
+        if (io->isRead) {
+            io_uring_prep_read_fixed(sqe, fd, pos, len, offset, buf_idx);
+        } else {
+            io_uring_prep_write_fixed(sqe, fd, pos, len, offset, buf_idx);
+        }
+    } else {
+        if (io->isRead) {
+            io_uring_prep_read(sqe, fd, pos, len, offset);
+        } else {
+            io_uring_prep_write(sqe, fd, pos, len, offset);
+        }
+    }
+    if (io->fileIdx >= 0) {
+        sqe->flags |= IOSQE_FIXED_FILE;
+    }
+    queue.track(sqe, io);
+    return true;
+}
+
+// Unstages a finished VRAM IO
+void nixlPosixEngine::completeIO(nixlPosixIO *io, int res)
+{
+    if (!queue.complete(io, res) || !io->bounce) {
+        return;
+    }
+#ifdef HAVE_CUDA
+    if (io->isRead && (io->owner->status == NIXL_SUCCESS) &&
+        (cudaMemcpy(io->addr, io->bounce->buf, io->size,
+                    cudaMemcpyHostToDevice) != cudaSuccess)) {
+        io->owner->status = NIXL_ERR_BACKEND;
+    }
+#endif
+    freeBounces.push_back(io->bounce);
+    io->bounce = nullptr;
+}
+
+nixl_status_t nixlPosixEngine::postXfer(const nixl_xfer_op_t &operation,
+                                        const nixl_meta_dlist_t &local,
+                                        const nixl_meta_dlist_t &remote,
+                                        const std::string &remote_agent,
+                                        nixlBackendReqH* &handle,
+                                        const nixl_opt_b_args_t* opt_args)
+{
+    nixlPosixBackendReqH *posix_handle = (nixlPosixBackendReqH *) handle;
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (posix_handle->posted) {
+        return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    queue.post(posix_handle, [this](nixlPosixIO *io) { return prepIO(io); });
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t nixlPosixEngine::checkXfer(nixlBackendReqH* handle)
+{
+    nixlPosixBackendReqH *posix_handle = (nixlPosixBackendReqH *) handle;
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (!posix_handle->posted) {
+        return posix_handle->status;
+    }
+
+    return queue.check(posix_handle,
+                       [this](nixlPosixIO *io) { return prepIO(io); },
+                       [this](nixlPosixIO *io, int res) { completeIO(io, res); });
+}
+
+nixl_status_t nixlPosixEngine::releaseReqH(nixlBackendReqH* handle)
+{
+    nixlPosixBackendReqH *posix_handle = (nixlPosixBackendReqH *) handle;
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (posix_handle->posted) {
+        queue.release(posix_handle,
+                      [this](nixlPosixIO *io, int res) { completeIO(io, res); },
+                      [this](nixlPosixIO *io) {
+                          if (io->bounce) {
+                              freeBounces.push_back(io->bounce);
+                          }
+                      });
+    }
+
+    delete posix_handle;
+    return NIXL_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __POSIX_BACKEND_H
+#define __POSIX_BACKEND_H
+
+#include <nixl.h>
+#include <nixl_types.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <vector>
+#include <unordered_map>
+#include "backend/backend_engine.h"
+#include "uring/uring_queue.h"
+
+class nixlPosixMetadata : public nixlBackendMD {
+    public:
+        nixl_mem_t type;
+        int fd;         // FILE_SEG
+        int fileIdx;    // Slot in the fixed file table, -1 if not fixed
+        void *base;     // DRAM_SEG/VRAM_SEG
+        size_t size;
+        int bufIdx;     // Slot in the fixed buffer table, -1 if not fixed
+
+        nixlPosixMetadata() : nixlBackendMD(true) {
+            fd = -1;
+            fileIdx = -1;
+            base = nullptr;
+            size = 0;
+            bufIdx = -1;
+        }
+        ~nixlPosixMetadata() { }
+};
+
+class nixlPosixBackendReqH;
+
+// Pinned host buffer VRAM is staged through
+class nixlPosixBounce {
+    public:
+        void *buf;
+        int bufIdx;
+};
+
+// One read or write of up to max_request_size bytes
+class nixlPosixIO {
+    public:
+        nixlPosixBackendReqH *owner;
+        void *addr;
+        size_t size;
+        size_t offset;
+        int fd;
+        int fileIdx;
+        int bufIdx;
+        bool isRead;
+        bool isVram;
+
+        // Set while posted
+        size_t done;
+        nixlPosixBounce *bounce;
+};
+
+class nixlPosixBackendReqH : public nixlBackendReqH, public nixlUringReq {
+    public:
+        std::vector<nixlPosixIO> ios;
+
+        nixlPosixBackendReqH() { }
+        ~nixlPosixBackendReqH() { }
+};
+
+class nixlPosixEngine : public nixlBackendEngine {
+    private:
+        // Posts and checks of all handles share the ring
+        nixlUringQueue<nixlPosixBackendReqH, nixlPosixIO> queue;
+        size_t maxRequestSize;
+
+        // Fixed file and buffer tables, registered sparse at init and
+        // filled at registerMem. Empty if the kernel does not support it.
+        std::vector<int> fileSlots;
+        std::unordered_map<int, std::pair<int, unsigned int>> fileByFd; // fd -> slot, refs
+        std::vector<bool> bufSlots;
+        int getSlot(std::vector<bool> &slots);
+
+        // VRAM staging
+        std::vector<nixlPosixBounce> bounces;
+        std::vector<nixlPosixBounce*> freeBounces;
+        size_t bounceSize;
+
+        bool prepIO(nixlPosixIO *io);
+        void completeIO(nixlPosixIO *io, int res);
+
+    public:
+        nixlPosixEngine(const nixlBackendInitParams* init_params);
+        ~nixlPosixEngine();
+
+        // Files are local, there is nothing to connect to
+        bool supportsNotif() const {
+            return false;
+        }
+        bool supportsRemote() const {
+            return false;
+        }
+        bool supportsLocal() const {
+            return true;
+        }
+        bool supportsProgTh() const {
+            return false;
+        }
+
+        nixl_mem_list_t getSupportedMems() const {
+            nixl_mem_list_t mems;
+            mems.push_back(DRAM_SEG);
+#ifdef HAVE_CUDA
+            mems.push_back(VRAM_SEG);
+#endif
+            mems.push_back(FILE_SEG);
+            return mems;
+        }
+
+        nixl_status_t getXferHints(const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   nixlBackendXferHints &hints) const {
+            if (((local_mem != DRAM_SEG) && (local_mem != VRAM_SEG)) ||
+                (remote_mem != FILE_SEG))
+                return NIXL_ERR_NOT_SUPPORTED;
+            // Below GDS, VRAM goes through host bounce buffers
+            hints.bandwidthGBps = (local_mem == VRAM_SEG) ? 3 : 5;
+            hints.latencyUs     = 20;
+            hints.chunkSize     = maxRequestSize;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t connect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t disconnect(const std::string &remote_agent) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t loadLocalMD(nixlBackendMD* input,
+                                  nixlBackendMD* &output) {
+            output = input;
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t unloadMD(nixlBackendMD* input) {
+            return NIXL_SUCCESS;
+        }
+        nixl_status_t registerMem(const nixlBlobDesc &mem,
+                                  const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out);
+        nixl_status_t deregisterMem(nixlBackendMD *meta);
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                               const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args=nullptr);
+
+        nixl_status_t checkXfer(nixlBackendReqH* handle);
+        nixl_status_t releaseReqH(nixlBackendReqH* handle);
+};
+#endif
@@ -16,6 +16,14 @@
  */
 #include "ucx_backend.h"
 #include "serdes/serdes.h"
+#include "common/cpu_affinity.h"
+#include "common/nixl_trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sys/epoll.h>
+#include <unistd.h>
 
 #ifdef HAVE_CUDA
 
@@ -33,17 +41,53 @@
 class nixlUcxCudaCtx {
 public:
 #ifdef HAVE_CUDA
-    CUcontext pthrCudaCtx;
-    int myDevId;
-
-    nixlUcxCudaCtx() {
-        pthrCudaCtx = NULL;
-        myDevId = -1;
-    }
+    // Context of each device memory was registered from, one per device
+    std::mutex lock;
+    std::map<int, CUcontext> devCtx;
+    // Copy of devCtx owned by the progress thread, which progresses the
+    // workers under each of them in turn
+    std::vector<CUcontext> pthrCtxs;
 #endif
-    void cudaResetCtxPtr();
+    // Bumped when a device is added, the progress thread takes it up on
+    // its next round instead of being restarted
+    std::atomic<uint64_t> updates{0};
+    uint64_t applied = 0;
+
     int cudaUpdateCtxPtr(void *address, int expected_dev, bool &was_updated);
-    int cudaSetCtx();
+    void cudaRefreshCtxs();
+    size_t cudaCtxCount() const;
+    int cudaSetCtx(size_t idx = 0);
+    bool cudaPushDevCtx(int dev);
+    void cudaPopCtx();
+};
+
+// Keeps the context of a device current on the posting thread while its
+// descriptors are posted, the thread's own one is restored once done
+class nixlUcxCudaCtxGuard {
+private:
+    nixlUcxCudaCtx *ctx;
+    bool pushed = false;
+    int dev = -1;
+
+public:
+    nixlUcxCudaCtxGuard(nixlUcxCudaCtx *_ctx) : ctx(_ctx) {}
+
+    ~nixlUcxCudaCtxGuard() {
+        if (pushed) {
+            ctx->cudaPopCtx();
+        }
+    }
+
+    void set(int _dev) {
+        if (!ctx || (_dev == dev)) {
+            return;
+        }
+        if (pushed) {
+            ctx->cudaPopCtx();
+        }
+        pushed = ctx->cudaPushDevCtx(_dev);
+        dev = _dev;
+    }
 };
 
 #ifdef HAVE_CUDA
@@ -87,10 +131,6 @@ int nixlUcxCudaCtx::cudaUpdateCtxPtr(void *address, int expected_dev, bool &was_
     if (expected_dev == -1)
         return -1;
 
-    // incorrect dev id from first registration
-    if (myDevId != -1 && expected_dev != myDevId)
-        return -1;
-
     ret = cudaQueryAddr(address, is_dev, dev, ctx);
     if (ret) {
         return ret;
@@ -105,33 +145,76 @@ int nixlUcxCudaCtx::cudaUpdateCtxPtr(void *address, int expected_dev, bool &was_
         return -1;
     }
 
-    if (pthrCudaCtx) {
-        // Context was already set previously, and does not match new context
-        if (pthrCudaCtx != ctx) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto search = devCtx.find(expected_dev);
+    if (search != devCtx.end()) {
+        // Device was seen before, with a different context
+        if (search->second != ctx) {
             return -1;
         }
         return 0;
     }
+    devCtx[expected_dev] = ctx;
 
-    pthrCudaCtx = ctx;
     was_updated = true;
-    myDevId = expected_dev;
+    updates.fetch_add(1, std::memory_order_release);
 
     return 0;
 }
 
-int nixlUcxCudaCtx::cudaSetCtx()
+// Called by the progress thread only
+void nixlUcxCudaCtx::cudaRefreshCtxs()
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    pthrCtxs.clear();
+    for (auto &[dev, ctx] : devCtx) {
+        pthrCtxs.push_back(ctx);
+    }
+}
+
+size_t nixlUcxCudaCtx::cudaCtxCount() const
+{
+    return pthrCtxs.size();
+}
+
+int nixlUcxCudaCtx::cudaSetCtx(size_t idx)
 {
     CUresult result;
-    if (NULL == pthrCudaCtx) {
+
+    if (idx >= pthrCtxs.size()) {
         return 0;
     }
 
-    result = cuCtxSetCurrent(pthrCudaCtx);
+    result = cuCtxSetCurrent(pthrCtxs[idx]);
 
     return (CUDA_SUCCESS == result);
 }
 
+bool nixlUcxCudaCtx::cudaPushDevCtx(int dev)
+{
+    CUcontext ctx;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto search = devCtx.find(dev);
+        if (search == devCtx.end()) {
+            return false;
+        }
+        ctx = search->second;
+    }
+
+    return (CUDA_SUCCESS == cuCtxPushCurrent(ctx));
+}
+
+void nixlUcxCudaCtx::cudaPopCtx()
+{
+    CUcontext ctx;
+
+    cuCtxPopCurrent(&ctx);
+}
+
 #else
 
 int nixlUcxCudaCtx::cudaUpdateCtxPtr(void *address, int expected_dev, bool &was_updated)
@@ -140,10 +223,24 @@ int nixlUcxCudaCtx::cudaUpdateCtxPtr(void *address, int expected_dev, bool &was_
     return 0;
 }
 
-int nixlUcxCudaCtx::cudaSetCtx() {
+void nixlUcxCudaCtx::cudaRefreshCtxs() {
+}
+
+size_t nixlUcxCudaCtx::cudaCtxCount() const {
+    return 0;
+}
+
+int nixlUcxCudaCtx::cudaSetCtx(size_t idx) {
     return 0;
 }
 
+bool nixlUcxCudaCtx::cudaPushDevCtx(int dev) {
+    return false;
+}
+
+void nixlUcxCudaCtx::cudaPopCtx() {
+}
+
 #endif
 
 
@@ -152,26 +249,16 @@ void nixlUcxEngine::vramInitCtx()
     cudaCtx = new nixlUcxCudaCtx;
 }
 
-int nixlUcxEngine::vramUpdateCtx(void *address, uint64_t  devId, bool &restart_reqd)
+int nixlUcxEngine::vramUpdateCtx(void *address, uint64_t  devId)
 {
-    int ret;
     bool was_updated;
 
-    restart_reqd = false;
-
     if(!cuda_addr_wa) {
         // Nothing to do
         return 0;
     }
 
-    ret = cudaCtx->cudaUpdateCtxPtr(address, devId, was_updated);
-    if (ret) {
-        return ret;
-    }
-
-    restart_reqd = was_updated;
-
-    return 0;
+    return cudaCtx->cudaUpdateCtxPtr(address, devId, was_updated);
 }
 
 int nixlUcxEngine::vramApplyCtx()
@@ -184,6 +271,18 @@ int nixlUcxEngine::vramApplyCtx()
     return cudaCtx->cudaSetCtx();
 }
 
+// Called by the progress thread every round, cheap unless a device was added
+void nixlUcxEngine::vramRefreshCtx()
+{
+    uint64_t updates = cudaCtx->updates.load(std::memory_order_acquire);
+
+    if (updates != cudaCtx->applied) {
+        cudaCtx->applied = updates;
+        cudaCtx->cudaRefreshCtxs();
+        vramApplyCtx();
+    }
+}
+
 void nixlUcxEngine::vramFiniCtx()
 {
     delete cudaCtx;
@@ -239,25 +338,119 @@ static void _internalRequestReset(nixlUcxIntReq *req) {
  * Backend request management
 *****************************************/
 
+// Flush request shared by the transfers of a postXfers batch that go to the
+// same endpoint. Freed when the last of these transfers lets go of it.
+class nixlUcxSharedFlush {
+private:
+    nixlUcxWorker*    uw;
+    nixlUcxReq        req;
+    std::atomic<int>  refCount;
+    std::atomic<bool> done;
+
+public:
+    nixlUcxSharedFlush(nixlUcxWorker* _uw, nixlUcxReq _req, int refs) :
+        uw(_uw), req(_req), refCount(refs), done(false) {}
+
+    nixl_status_t status()
+    {
+        if (done) {
+            return NIXL_SUCCESS;
+        }
+
+        nixl_status_t ret = uw->test(req);
+        if (ret == NIXL_SUCCESS) {
+            done = true;
+        }
+        return ret;
+    }
+
+    void put()
+    {
+        if (--refCount > 0) {
+            return;
+        }
+
+        if (!done) {
+            uw->reqCancel(req);
+        }
+        _internalRequestReset((nixlUcxIntReq*)req);
+        uw->reqRelease(req);
+        delete this;
+    }
+};
+
 class nixlUcxBackendH : public nixlBackendReqH {
 private:
     nixlUcxIntReq head;
     nixlUcxWorker* uw;
+    size_t workerIdx;
+    nixlUcxSharedFlush* sharedFlush;
 
 public:
+    // Set while the progress thread reports this handle's completion,
+    // cqCtx and the list of such handles are protected by nixlUcxEngine::cqMtx
+    std::atomic<bool> cqTracked;
+    void* cqCtx;
+
+    // Link in the engine's list of released handles
+    nixlUcxBackendH* poolNext;
 
-    nixlUcxBackendH(nixlUcxWorker* _uw){
+    // Endpoint flushes and grouped descriptors of the last post, for getXferStats
+    size_t flushes;
+    size_t groupedDescs;
+
+    nixlUcxBackendH(nixlUcxWorker* _uw, size_t _worker_idx){
+        reset(_uw, _worker_idx);
+    }
+
+    // Brings a released handle back to its freshly constructed state,
+    // the request list is already empty after release()
+    void reset(nixlUcxWorker* _uw, size_t _worker_idx) {
         uw = _uw;
+        workerIdx = _worker_idx;
+        sharedFlush = nullptr;
+        cqTracked = false;
+        cqCtx = nullptr;
+        poolNext = nullptr;
+        flushes = 0;
+        groupedDescs = 0;
+    }
+
+    size_t getWorkerIdx() const {
+        return workerIdx;
+    }
+
+    // Moves the handle to the worker of the posting thread, unless requests
+    // of a previous post are still attached to the current one
+    void rebind(nixlUcxWorker* _uw, size_t _worker_idx) {
+        if ((head.next() == nullptr) && (sharedFlush == nullptr)) {
+            uw = _uw;
+            workerIdx = _worker_idx;
+        }
     }
 
     void append(nixlUcxIntReq *req) {
         head.link(req);
     }
 
+    void setSharedFlush(nixlUcxSharedFlush *flush) {
+        releaseSharedFlush();
+        sharedFlush = flush;
+    }
+
+    void releaseSharedFlush() {
+        if (sharedFlush) {
+            sharedFlush->put();
+            sharedFlush = nullptr;
+        }
+    }
+
     nixl_status_t release()
     {
         nixlUcxIntReq *req = head.next();
 
+        releaseSharedFlush();
+
         if (!req) {
             return NIXL_SUCCESS;
         }
@@ -284,9 +477,16 @@ public:
         nixlUcxIntReq *req = head.next();
         nixl_status_t out_ret = NIXL_SUCCESS;
 
+        if (sharedFlush) {
+            out_ret = sharedFlush->status();
+            if (out_ret < 0) {
+                return out_ret;
+            }
+        }
+
         if (NULL == req) {
             /* No pending transmissions */
-            return NIXL_SUCCESS;
+            return out_ret;
         }
 
         /* Go over all request updating their status */
@@ -338,14 +538,25 @@ void nixlUcxEngine::progressFunc()
     using namespace nixlTime;
     pthrActive = 1;
 
+    vramRefreshCtx();
     vramApplyCtx();
 
     while (!pthrStop) {
-        int i;
-        for(i = 0; i < noSyncIters; i++) {
-            uw->progress();
+        bool active = false;
+        {
+            NIXL_TRACE_SPAN("ucx.progressRound");
+            for(int i = 0; i < noSyncIters; i++) {
+                active |= progressWorkers();
+            }
+            notifProgress();
+            completionProgress();
+        }
+        vramRefreshCtx();
+
+        // No delay while transfers keep progressing
+        if (active) {
+            continue;
         }
-        notifProgress();
         // TODO: once NIXL thread infrastructure is available - move it there!!!
 
         // {
@@ -364,6 +575,147 @@ void nixlUcxEngine::progressFunc()
     }
 }
 
+// Single progress round, returns whether anything was progressed. With
+// memory of several devices, the workers get a pass under each context.
+bool nixlUcxEngine::progressWorkers()
+{
+    size_t ctx_cnt = cuda_addr_wa ? cudaCtx->cudaCtxCount() : 0;
+    int ret = 0;
+
+    for (size_t c = 0; c < std::max<size_t>(ctx_cnt, 1); c++) {
+        if (ctx_cnt > 1) {
+            cudaCtx->cudaSetCtx(c);
+        }
+        for (auto &w : uws) {
+            ret += w->progress();
+        }
+    }
+    return ret > 0;
+}
+
+// Same work as a round of progressFunc, from the thread of the agent
+bool nixlUcxEngine::progressRound()
+{
+    bool active = false;
+
+    // The thread is shared with engines that can use other contexts
+    NIXL_TRACE_SPAN("ucx.progressRound");
+    vramRefreshCtx();
+    vramApplyCtx();
+
+    for (int i = 0; i < noSyncIters; i++) {
+        active |= progressWorkers();
+    }
+    notifProgress();
+    completionProgress();
+    return active || (notifBatched != 0);
+}
+
+void nixlUcxEngine::progressFuncEvent()
+{
+    using namespace nixlTime;
+    const int max_events = 16;
+    // Upper bound of a sleep, in case a wakeup was missed
+    const int sleep_timeout_ms = 100;
+    struct epoll_event events[max_events];
+
+    pthrActive = 1;
+
+    vramRefreshCtx();
+    vramApplyCtx();
+
+    us_t last_active = getUs();
+    while (!pthrStop) {
+        bool active = false;
+        {
+            NIXL_TRACE_SPAN("ucx.progressRound");
+            for(int i = 0; i < noSyncIters; i++) {
+                active |= progressWorkers();
+            }
+            notifProgress();
+            completionProgress();
+        }
+        vramRefreshCtx();
+
+        // Don't sleep past the coalescing window of a queued notification
+        active |= (notifBatched != 0);
+        if (active) {
+            last_active = getUs();
+            continue;
+        }
+
+        if ((last_active + pthrSpin) > getUs()) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Submitters wake the thread from here on. Anything posted before
+        // they could see the flag is picked up by the last progress round.
+        pthrSleeping = true;
+        bool armed = !progressWorkers();
+        for (size_t i = 0; armed && (i < uws.size()); i++) {
+            armed = (uws[i]->arm() == NIXL_SUCCESS);
+        }
+
+        if (armed && !pthrStop) {
+            epoll_wait(pthrEpfd, events, max_events, sleep_timeout_ms);
+        }
+        pthrSleeping = false;
+        last_active = getUs();
+    }
+}
+
+void nixlUcxEngine::progressThreadWake(size_t worker_idx)
+{
+    if (pthrDriver) {
+        pthrDriver->wake();
+    } else if (pthrEvent && pthrSleeping) {
+        uws[worker_idx]->signal();
+    }
+}
+
+void nixlUcxEngine::completionTrack(nixlUcxBackendH *intHandle, void *ctx)
+{
+    std::lock_guard<std::mutex> lock(cqMtx);
+    intHandle->cqCtx = ctx;
+    intHandle->cqTracked = true;
+    cqList.push_back(intHandle);
+}
+
+// With cqMtx held
+void nixlUcxEngine::completionUntrack(nixlUcxBackendH *intHandle)
+{
+    for (size_t i = 0; i < cqList.size(); i++) {
+        if (cqList[i] == intHandle) {
+            cqList[i] = cqList.back();
+            cqList.pop_back();
+            break;
+        }
+    }
+    intHandle->cqTracked = false;
+    intHandle->cqCtx = nullptr;
+}
+
+void nixlUcxEngine::completionProgress()
+{
+    std::lock_guard<std::mutex> lock(cqMtx);
+    size_t i = 0;
+
+    while (i < cqList.size()) {
+        nixlUcxBackendH *intHandle = cqList[i];
+        nixl_status_t ret = intHandle->status();
+
+        if (ret == NIXL_IN_PROG) {
+            i++;
+            continue;
+        }
+
+        void *ctx = intHandle->cqCtx;
+        completionUntrack(intHandle);
+        completionSink->xferDone(ctx, ret);
+    }
+}
+
 void nixlUcxEngine::progressThreadStart()
 {
     pthrStop = pthrActive = 0;
@@ -374,9 +726,22 @@ void nixlUcxEngine::progressThreadStart()
         return;
     }
 
+    if (pthrDriver) {
+        pthrDriver->addEngine(this);
+        return;
+    }
+
     // Start the thread
     // TODO [Relaxed mem] mem barrier to ensure pthr_x updates are complete
-    new (&pthr) std::thread(&nixlUcxEngine::progressFunc, this);
+    if (pthrEvent) {
+        new (&pthr) std::thread(&nixlUcxEngine::progressFuncEvent, this);
+    } else {
+        new (&pthr) std::thread(&nixlUcxEngine::progressFunc, this);
+    }
+    if (!nixlPinThread(pthr.native_handle(), pthrCpus)) {
+        std::cout << "WARNING: cannot pin the UCX progress thread to CPUs "
+                  << pthrCpus << std::endl;
+    }
 
     // Wait for the thread to be started
     while(!pthrActive){
@@ -391,7 +756,13 @@ void nixlUcxEngine::progressThreadStop()
         return;
     }
 
+    if (pthrDriver) {
+        pthrDriver->removeEngine(this);
+        return;
+    }
+
     pthrStop = 1;
+    progressThreadWake(0);
     pthr.join();
 }
 
@@ -409,6 +780,8 @@ nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
 : nixlBackendEngine (init_params) {
     std::vector<std::string> devs; /* Empty vector */
     uint64_t                 n_addr;
+    size_t                   n_size;
+    size_t                   num_workers = 1;
     nixl_b_params_t* custom_params = init_params->customParams;
 
     if (init_params->enableProgTh) {
@@ -421,19 +794,155 @@ nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
     if (custom_params->count("device_list")!=0)
         devs = str_split((*custom_params)["device_list"], ", ");
 
+    // CPUs of the progress thread: a CPU list, numa:<node>, or auto for the
+    // NUMA node of the first device
+    if (custom_params->count("progress_cpus")!=0) {
+        pthrCpus = (*custom_params)["progress_cpus"];
+        if (pthrCpus == "auto") {
+            int node = -1;
+            if (!devs.empty()) {
+                // Devices can be given with a port, e.g. mlx5_0:1
+                std::string dev = devs[0].substr(0, devs[0].find(':'));
+                node = nixlDevNumaNode("/sys/class/infiniband/" + dev + "/device");
+            }
+            pthrCpus = (node < 0) ? "" : "numa:" + std::to_string(node);
+        }
+    }
+
+    if (custom_params->count("num_workers")!=0) {
+        num_workers = std::stoul((*custom_params)["num_workers"]);
+        if (num_workers == 0) {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    if (custom_params->count("completion_mode")!=0) {
+        const std::string &mode = (*custom_params)["completion_mode"];
+        if (mode == "ops") {
+            opCompletion = true;
+        } else if (mode != "flush") {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    size_t notif_ring_size = 4096;
+    if (custom_params->count("notif_ring_size")!=0) {
+        notif_ring_size = std::stoul((*custom_params)["notif_ring_size"]);
+    }
+    notifRing.reset(new nixlRing<std::pair<std::string, std::string>>(notif_ring_size));
+
+    if (custom_params->count("notif_coalesce_us")!=0) {
+        notifCoalesce = std::stoul((*custom_params)["notif_coalesce_us"]);
+    }
+
+    if (custom_params->count("rkey_cache_size")!=0) {
+        rkeyIdleMax = std::stoul((*custom_params)["rkey_cache_size"]);
+    }
+
+    if (custom_params->count("group_min_descs")!=0) {
+        groupMinDescs = std::stoul((*custom_params)["group_min_descs"]);
+    }
+
+    if (custom_params->count("priority_lanes")!=0) {
+        const std::string &lanes = (*custom_params)["priority_lanes"];
+        if (lanes == "on") {
+            priorityLanes = true;
+        } else if (lanes != "off") {
+            this->initErr = true;
+            return;
+        }
+        if (priorityLanes && (num_workers < 2)) {
+            std::cout << "WARNING: priority_lanes needs num_workers of 2 or more, not used"
+                      << std::endl;
+            priorityLanes = false;
+        }
+    }
+
+    if (custom_params->count("progress_mode")!=0) {
+        const std::string &mode = (*custom_params)["progress_mode"];
+        if (mode == "event") {
+            pthrEvent = init_params->enableProgTh;
+        } else if (mode != "poll") {
+            this->initErr = true;
+            return;
+        }
+    }
+
+    pthrSpin = init_params->pthrDelay;
+    // Empty keeps the thread delay
+    if ((custom_params->count("progress_spin_us")!=0) &&
+        !(*custom_params)["progress_spin_us"].empty()) {
+        pthrSpin = std::stoul((*custom_params)["progress_spin_us"]);
+    }
+
     uc = new nixlUcxContext(devs, sizeof(nixlUcxIntReq),
-                           _internalRequestInit, _internalRequestFini, NIXL_UCX_MT_WORKER);
-    uw = new nixlUcxWorker(uc);
-    uw->epAddr(n_addr, workerSize);
-    workerAddr = (void*) n_addr;
+                           _internalRequestInit, _internalRequestFini, NIXL_UCX_MT_WORKER,
+                           pthrEvent);
+
+    // A single worker keeps its raw address as connection info, several are
+    // serialized by index. Remotes connect worker i to our worker i % count.
+    nixlSerDes ser_des;
+    ser_des.addStr("num_workers", std::to_string(num_workers));
+    for (size_t i = 0; i < num_workers; i++) {
+        nixlUcxWorker *w = new nixlUcxWorker(uc);
+        w->epAddr(n_addr, n_size);
+        if (num_workers == 1) {
+            connInfo = nixlSerDes::_bytesToString((void*) n_addr, n_size);
+        } else {
+            ser_des.addBuf("w" + std::to_string(i), (void*) n_addr, n_size);
+        }
+        free((void*) n_addr);
+
+        // Notifications from a remote arrive on the worker it's connected to
+        w->regAmCallback(CONN_CHECK, connectionCheckAmCb, this);
+        w->regAmCallback(DISCONNECT, connectionTermAmCb, this);
+        w->regAmCallback(NOTIF_STR, notifAmCb, this);
+        uws.push_back(w);
+    }
+    if (num_workers > 1) {
+        connInfo = ser_des.exportStr();
+    }
+    uw = uws[0];
 
-    uw->regAmCallback(CONN_CHECK, connectionCheckAmCb, this);
-    uw->regAmCallback(DISCONNECT, connectionTermAmCb, this);
-    uw->regAmCallback(NOTIF_STR, notifAmCb, this);
+    // Registrations all go through the first worker
+    if ((custom_params->count("reg_cache_size")!=0) &&
+        !(*custom_params)["reg_cache_size"].empty()) {
+        if (uw->regCacheEnable(std::stoull((*custom_params)["reg_cache_size"]))) {
+            std::cout << "ERROR: reg_cache_size needs the UCM memory events" << std::endl;
+            this->initErr = true;
+            return;
+        }
+    }
+
+    // Without the event fds the thread keeps polling
+    if (pthrEvent) {
+        pthrEpfd = epoll_create1(EPOLL_CLOEXEC);
+        for (size_t i = 0; (pthrEpfd >= 0) && (i < uws.size()); i++) {
+            struct epoll_event ev = {};
+            int fd;
+
+            ev.events = EPOLLIN;
+            if ((uws[i]->getEfd(fd) != 0) ||
+                (epoll_ctl(pthrEpfd, EPOLL_CTL_ADD, fd, &ev) != 0)) {
+                close(pthrEpfd);
+                pthrEpfd = -1;
+            }
+        }
+        if (pthrEpfd < 0) {
+            std::cout << "WARNING: UCX event progress is not available, polling instead" << std::endl;
+            pthrEvent = false;
+        }
+    }
 
     if (init_params->enableProgTh) {
         pthrOn = true;
         pthrDelay = init_params->pthrDelay;
+        // Event mode keeps its own thread, which sleeps on the worker event fds
+        if (!pthrEvent) {
+            pthrDriver = init_params->progressDriver;
+        }
     } else {
         pthrOn = false;
     }
@@ -456,56 +965,142 @@ nixl_mem_list_t nixlUcxEngine::getSupportedMems () const {
     return mems;
 }
 
-// Through parent destructor the unregister will be called.
-nixlUcxEngine::~nixlUcxEngine () {
-    // per registered memory deregisters it, which removes the corresponding metadata too
-    // parent destructor takes care of the desc list
-    // For remote metadata, they should be removed here
-    if (this->initErr) {
-        // Nothing to do
-        return;
+nixl_status_t nixlUcxEngine::getXferHints (const nixl_mem_t &local_mem,
+                                           const nixl_mem_t &remote_mem,
+                                           nixlBackendXferHints &hints) const {
+    if (((local_mem != DRAM_SEG) && (local_mem != VRAM_SEG)) ||
+        ((remote_mem != DRAM_SEG) && (remote_mem != VRAM_SEG))) {
+        return NIXL_ERR_NOT_SUPPORTED;
     }
 
-    progressThreadStop();
-    vramFiniCtx();
-    delete uw;
-    delete uc;
-    free(workerAddr);
+    // Declared values for a single rail
+    if ((local_mem == DRAM_SEG) && (remote_mem == DRAM_SEG)) {
+        hints.bandwidthGBps = 12;
+        hints.latencyUs = 3;
+    } else {
+        hints.bandwidthGBps = 20;
+        hints.latencyUs = 5;
+    }
+    return NIXL_SUCCESS;
 }
 
-/****************************************
- * Connection management
-*****************************************/
+nixl_status_t nixlUcxEngine::getPeerXferHints (const nixl_mem_t &local_mem,
+                                               const nixl_mem_t &remote_mem,
+                                               const std::string &remote_agent,
+                                               nixlBackendXferHints &hints) const {
+    nixl_status_t ret = getXferHints(local_mem, remote_mem, hints);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
 
-nixl_status_t nixlUcxEngine::checkConn(const std::string &remote_agent) {
-     if(remoteConnMap.find(remote_agent) == remoteConnMap.end()) {
-        return NIXL_ERR_NOT_FOUND;
+    std::lock_guard<std::mutex> lock(connMapMtx);
+    auto search = remoteConnMap.find(remote_agent);
+    if ((search == remoteConnMap.end()) ||
+        (search->second.hints.bandwidthGBps == 0)) {
+        return NIXL_SUCCESS;
+    }
+
+    // The probe doesn't know about the memory types, so VRAM keeps declared values
+    if ((local_mem == DRAM_SEG) && (remote_mem == DRAM_SEG)) {
+        hints.bandwidthGBps = search->second.hints.bandwidthGBps;
+        hints.latencyUs     = search->second.hints.latencyUs;
     }
     return NIXL_SUCCESS;
 }
 
-nixl_status_t nixlUcxEngine::endConn(const std::string &remote_agent) {
+// Latency from the estimated time of a small put and bandwidth from the
+// difference to a large one, as UCX sees the lanes of the first endpoint.
+// Done once the connection check went through, when those lanes are wired up.
+void nixlUcxEngine::probeConnHints(const std::string &remote_agent) {
+    const size_t small_size = 4096;
+    const size_t large_size = 64 * 1024 * 1024;
+    double small_time, large_time;
 
+    std::lock_guard<std::mutex> lock(connMapMtx);
     auto search = remoteConnMap.find(remote_agent);
-
-    if(search == remoteConnMap.end()) {
-        return NIXL_ERR_NOT_FOUND;
+    if (search == remoteConnMap.end()) {
+        return;
+    }
+
+    nixlUcxConnection &conn = search->second;
+    if (uws[0]->estimateTime(conn.eps[0], small_size, small_time) ||
+        uws[0]->estimateTime(conn.eps[0], large_size, large_time) ||
+        (large_time <= small_time)) {
+        return;
+    }
+
+    conn.hints.latencyUs     = small_time * 1e6;
+    conn.hints.bandwidthGBps = (large_size - small_size) / (large_time - small_time) / 1e9;
+}
+
+// Through parent destructor the unregister will be called.
+nixlUcxEngine::~nixlUcxEngine () {
+    // per registered memory deregisters it, which removes the corresponding metadata too
+    // parent destructor takes care of the desc list
+    // For remote metadata, they should be removed here
+    if (this->initErr) {
+        // Nothing to do
+        return;
+    }
+
+    progressThreadStop();
+    while (!rkeyCache.empty()) {
+        rkeyCacheDrop(rkeyCache.begin()->first);
+    }
+    if (pthrEpfd >= 0) {
+        close(pthrEpfd);
+    }
+    reqhPoolFini();
+    vramFiniCtx();
+    for (auto &w : uws) {
+        delete w;
+    }
+    delete uc;
+}
+
+/****************************************
+ * Connection management
+*****************************************/
+
+nixl_status_t nixlUcxEngine::checkConn(const std::string &remote_agent) {
+    // Called from the AM callback, alongside connections being loaded
+    std::lock_guard<std::mutex> lock(connMapMtx);
+    if(remoteConnMap.find(remote_agent) == remoteConnMap.end()) {
+        return NIXL_ERR_NOT_FOUND;
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUcxEngine::endConn(const std::string &remote_agent) {
+
+    auto search = remoteConnMap.find(remote_agent);
+
+    if(search == remoteConnMap.end()) {
+        return NIXL_ERR_NOT_FOUND;
     }
 
     nixlUcxConnection &conn = remoteConnMap[remote_agent];
 
-    if(uw->disconnect_nb(conn.ep) < 0) {
-        return NIXL_ERR_BACKEND;
+    // Queued notifications go out before the endpoints are closed
+    notifBatchFlush(true);
+
+    // Unpacked on the endpoints being closed
+    rkeyCacheDrop(remote_agent);
+
+    for (size_t i = 0; i < conn.eps.size(); i++) {
+        if(uws[i]->disconnect_nb(conn.eps[i]) < 0) {
+            return NIXL_ERR_BACKEND;
+        }
     }
 
-    //thread safety?
+    std::lock_guard<std::mutex> lock(connMapMtx);
     remoteConnMap.erase(remote_agent);
 
     return NIXL_SUCCESS;
 }
 
 nixl_status_t nixlUcxEngine::getConnInfo(std::string &str) const {
-    str = nixlSerDes::_bytesToString(workerAddr, workerSize);
+    str = connInfo;
     return NIXL_SUCCESS;
 }
 
@@ -577,8 +1172,7 @@ nixl_status_t nixlUcxEngine::connect(const std::string &remote_agent) {
     nixlUcxReq req;
 
     if (remote_agent == localAgent)
-        return loadRemoteConnInfo (remote_agent,
-                   nixlSerDes::_bytesToString(workerAddr, workerSize));
+        return loadRemoteConnInfo (remote_agent, connInfo);
 
     auto search = remoteConnMap.find(remote_agent);
 
@@ -592,7 +1186,7 @@ nixl_status_t nixlUcxEngine::connect(const std::string &remote_agent) {
     //agent names should never be long enough to need RNDV
     flags |= UCP_AM_SEND_FLAG_EAGER;
 
-    ret = uw->sendAm(conn.ep, CONN_CHECK,
+    ret = uw->sendAm(conn.eps[0], CONN_CHECK,
                      &hdr, sizeof(struct nixl_ucx_am_hdr),
                      (void*) localAgent.data(), localAgent.size(),
                      flags, req);
@@ -606,9 +1200,71 @@ nixl_status_t nixlUcxEngine::connect(const std::string &remote_agent) {
         ret = uw->test(req);
     }
 
+    probeConnHints(remote_agent);
+
     return NIXL_SUCCESS;
 }
 
+// The checks of all the agents are sent before waiting for any, so the
+// wire-up of their endpoints overlaps
+nixl_status_t nixlUcxEngine::connectAgents(const std::vector<std::string> &remote_agents,
+                                           std::vector<nixl_status_t> &statuses)
+{
+    struct nixl_ucx_am_hdr hdr;
+    std::vector<nixlUcxReq> reqs(remote_agents.size(), nullptr);
+    nixl_status_t ret = NIXL_SUCCESS;
+    size_t pending = 0;
+
+    hdr.op = CONN_CHECK;
+    statuses.assign(remote_agents.size(), NIXL_SUCCESS);
+
+    for (size_t i = 0; i < remote_agents.size(); i++) {
+        if (remote_agents[i] == localAgent) {
+            statuses[i] = connect(remote_agents[i]);
+            continue;
+        }
+
+        auto search = remoteConnMap.find(remote_agents[i]);
+        if (search == remoteConnMap.end()) {
+            statuses[i] = NIXL_ERR_NOT_FOUND;
+            continue;
+        }
+
+        //agent names should never be long enough to need RNDV
+        statuses[i] = uw->sendAm(search->second.eps[0], CONN_CHECK,
+                                 &hdr, sizeof(struct nixl_ucx_am_hdr),
+                                 (void*) localAgent.data(), localAgent.size(),
+                                 UCP_AM_SEND_FLAG_EAGER, reqs[i]);
+        if (statuses[i] == NIXL_IN_PROG) {
+            pending++;
+        }
+    }
+
+    while (pending > 0) {
+        for (size_t i = 0; i < remote_agents.size(); i++) {
+            if (statuses[i] != NIXL_IN_PROG) {
+                continue;
+            }
+            statuses[i] = uw->test(reqs[i]);
+            if (statuses[i] != NIXL_IN_PROG) {
+                uw->reqRelease(reqs[i]);
+                pending--;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < remote_agents.size(); i++) {
+        if (statuses[i] < 0) {
+            if (ret == NIXL_SUCCESS) {
+                ret = statuses[i];
+            }
+        } else if (remote_agents[i] != localAgent) {
+            probeConnHints(remote_agents[i]);
+        }
+    }
+    return ret;
+}
+
 nixl_status_t nixlUcxEngine::disconnect(const std::string &remote_agent) {
 
     static struct nixl_ucx_am_hdr hdr;
@@ -629,7 +1285,7 @@ nixl_status_t nixlUcxEngine::disconnect(const std::string &remote_agent) {
         //agent names should never be long enough to need RNDV
         flags |= UCP_AM_SEND_FLAG_EAGER;
 
-        ret = uw->sendAm(conn.ep, DISCONNECT,
+        ret = uw->sendAm(conn.eps[0], DISCONNECT,
                         &hdr, sizeof(struct nixl_ucx_am_hdr),
                         (void*) localAgent.data(), localAgent.size(),
                         flags, req);
@@ -648,29 +1304,54 @@ nixl_status_t nixlUcxEngine::disconnect(const std::string &remote_agent) {
 nixl_status_t nixlUcxEngine::loadRemoteConnInfo (const std::string &remote_agent,
                                                  const std::string &remote_conn_info)
 {
-    size_t size = remote_conn_info.size();
     nixlUcxConnection conn;
+    nixlSerDes ser_des;
+    std::vector<std::string> addrs;
     int ret;
-    //TODO: eventually std::byte?
-    char* addr = new char[size];
 
     if(remoteConnMap.find(remote_agent) != remoteConnMap.end()) {
         return NIXL_ERR_INVALID_PARAM;
     }
 
-    nixlSerDes::_stringToBytes((void*) addr, remote_conn_info, size);
-    ret = uw->connect(addr, size, conn.ep);
-    if (ret) {
-        return NIXL_ERR_BACKEND;
+    if (ser_des.importStr(remote_conn_info) != NIXL_SUCCESS) {
+        // Raw address of a single worker
+        addrs.push_back(remote_conn_info);
+    } else {
+        size_t count = std::stoul(ser_des.getStr("num_workers"));
+        for (size_t i = 0; i < count; i++) {
+            std::string tag = "w" + std::to_string(i);
+            ssize_t len = ser_des.getBufLen(tag);
+            if (len <= 0) {
+                return NIXL_ERR_MISMATCH;
+            }
+            std::string addr(len, '\0');
+            ser_des.getBuf(tag, &addr[0], len);
+            addrs.push_back(addr);
+        }
+    }
+
+    if (addrs.empty()) {
+        return NIXL_ERR_MISMATCH;
+    }
+
+    conn.eps.resize(uws.size());
+    for (size_t i = 0; i < uws.size(); i++) {
+        std::string &addr = addrs[i % addrs.size()];
+        ret = uws[i]->connect((void*) addr.data(), addr.size(), conn.eps[i]);
+        if (ret) {
+            for (size_t j = 0; j < i; j++) {
+                uws[j]->disconnect_nb(conn.eps[j]);
+            }
+            return NIXL_ERR_BACKEND;
+        }
     }
 
     conn.remoteAgent = remote_agent;
     conn.connected = false;
 
+    std::lock_guard<std::mutex> lock(connMapMtx);
     remoteConnMap[remote_agent] = conn;
 
-    delete[] addr;
-
     return NIXL_SUCCESS;
 }
 
@@ -686,15 +1367,12 @@ nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
     uint64_t rkey_addr;
     size_t rkey_size;
 
+    // The progress thread picks a new context up by itself
     if (nixl_mem == VRAM_SEG) {
-        bool need_restart;
-        if (vramUpdateCtx((void*)mem.addr, mem.devId, need_restart)) {
+        if (vramUpdateCtx((void*)mem.addr, mem.devId)) {
             return NIXL_ERR_NOT_SUPPORTED;
             //TODO Add to logging
         }
-        if (need_restart) {
-            progressThreadRestart();
-        }
     }
 
     // TODO: Add nixl_mem check?
@@ -735,9 +1413,7 @@ nixl_status_t
 nixlUcxEngine::internalMDHelper (const nixl_blob_t &blob,
                                  const std::string &agent,
                                  nixlBackendMD* &output) {
-    nixlUcxConnection conn;
-    nixlUcxPublicMetadata *md = new nixlUcxPublicMetadata;
-     size_t size = blob.size();
+    nixlUcxRkeyEntry *entry;
 
     auto search = remoteConnMap.find(agent);
 
@@ -745,26 +1421,157 @@ nixlUcxEngine::internalMDHelper (const nixl_blob_t &blob,
         //TODO: err: remote connection not found
         return NIXL_ERR_NOT_FOUND;
     }
-    conn = (nixlUcxConnection) search->second;
+
+    nixl_status_t ret = rkeyGet(blob, agent, search->second, entry);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    nixlUcxPublicMetadata *md = new nixlUcxPublicMetadata;
 
     //directly copy underlying conn struct
-    md->conn = conn;
+    md->conn = search->second;
+    md->rkeys = entry->rkeys;
+    md->rkeyEntry = entry;
+    output = (nixlBackendMD*) md;
+
+    return NIXL_SUCCESS;
+}
 
+// Returns a referenced entry of the packed rkey, unpacking it on a miss.
+// Unpacked without the cache lock, so that loads of several threads overlap.
+nixl_status_t nixlUcxEngine::rkeyGet (const nixl_blob_t &blob,
+                                      const std::string &agent,
+                                      nixlUcxConnection &conn,
+                                      nixlUcxRkeyEntry* &entry)
+{
+    {
+        std::lock_guard<std::mutex> lock(rkeyCacheMtx);
+        auto &agent_cache = rkeyCache[agent];
+
+        auto search = agent_cache.find(blob);
+        if (search != agent_cache.end()) {
+            entry = search->second;
+            if (entry->idle) {
+                rkeyIdle.erase(entry->idlePos);
+                entry->idle = false;
+            }
+            entry->refCnt++;
+            return NIXL_SUCCESS;
+        }
+    }
+
+    size_t size = blob.size();
     char *addr = new char[size];
     nixlSerDes::_stringToBytes(addr, blob, size);
 
-    int ret = uw->rkeyImport(conn.ep, addr, size, md->rkey);
-    if (ret) {
-        // TODO: error out. Should we indicate which desc failed or unroll everything prior
-        return NIXL_ERR_BACKEND;
+    entry = new nixlUcxRkeyEntry;
+    for (size_t i = 0; i < uws.size(); i++) {
+        entry->rkeys.emplace_back();
+        if (uws[i]->rkeyImport(conn.eps[i], addr, size, entry->rkeys[i])) {
+            // TODO: Should we indicate which desc failed
+            entry->rkeys.pop_back();
+            rkeyFree(entry);
+            delete[] addr;
+            return NIXL_ERR_BACKEND;
+        }
     }
-    output = (nixlBackendMD*) md;
-
     delete[] addr;
 
+    entry->agent = agent;
+    entry->blob = blob;
+    entry->refCnt = 1;
+
+    std::lock_guard<std::mutex> lock(rkeyCacheMtx);
+    auto res = rkeyCache[agent].emplace(blob, entry);
+    if (!res.second) {
+        // Unpacked by another thread meanwhile
+        rkeyFree(entry);
+        entry = res.first->second;
+        if (entry->idle) {
+            rkeyIdle.erase(entry->idlePos);
+            entry->idle = false;
+        }
+        entry->refCnt++;
+    }
+
     return NIXL_SUCCESS;
 }
 
+void nixlUcxEngine::rkeyPut (nixlUcxRkeyEntry *entry)
+{
+    std::lock_guard<std::mutex> lock(rkeyCacheMtx);
+
+    if (--entry->refCnt != 0) {
+        return;
+    }
+
+    if (!entry->cached) {
+        rkeyFree(entry);
+        return;
+    }
+
+    // Cached ones stay for later loads, until the connection ends or the
+    // least recently released ones are evicted
+    if (rkeyIdleMax == 0) {
+        rkeyEvict(entry);
+        return;
+    }
+    entry->idlePos = rkeyIdle.insert(rkeyIdle.end(), entry);
+    entry->idle = true;
+    if (rkeyIdle.size() > rkeyIdleMax) {
+        rkeyEvict(rkeyIdle.front());
+    }
+}
+
+// Removes an unreferenced entry from the cache and frees it, with the cache lock
+void nixlUcxEngine::rkeyEvict (nixlUcxRkeyEntry *entry)
+{
+    if (entry->idle) {
+        rkeyIdle.erase(entry->idlePos);
+    }
+
+    auto search = rkeyCache.find(entry->agent);
+    if (search != rkeyCache.end()) {
+        search->second.erase(entry->blob);
+        if (search->second.empty()) {
+            rkeyCache.erase(search);
+        }
+    }
+    rkeyFree(entry);
+}
+
+void nixlUcxEngine::rkeyFree (nixlUcxRkeyEntry *entry)
+{
+    for (size_t i = 0; i < entry->rkeys.size(); i++) {
+        uws[i]->rkeyDestroy(entry->rkeys[i]);
+    }
+    delete entry;
+}
+
+// Frees the unreferenced rkeys of the agent, the rest on their last unload
+void nixlUcxEngine::rkeyCacheDrop (const std::string &agent)
+{
+    std::lock_guard<std::mutex> lock(rkeyCacheMtx);
+
+    auto search = rkeyCache.find(agent);
+    if (search == rkeyCache.end()) {
+        return;
+    }
+
+    for (auto &[blob, entry] : search->second) {
+        if (entry->refCnt == 0) {
+            if (entry->idle) {
+                rkeyIdle.erase(entry->idlePos);
+            }
+            rkeyFree(entry);
+        } else {
+            entry->cached = false;
+        }
+    }
+    rkeyCache.erase(search);
+}
+
 nixl_status_t
 nixlUcxEngine::loadLocalMD (nixlBackendMD* input,
                             nixlBackendMD* &output)
@@ -786,7 +1593,7 @@ nixl_status_t nixlUcxEngine::unloadMD (nixlBackendMD* input) {
 
     nixlUcxPublicMetadata *md = (nixlUcxPublicMetadata*) input; //typecast?
 
-    uw->rkeyDestroy(md->rkey);
+    rkeyPut(md->rkeyEntry);
     delete md;
 
     return NIXL_SUCCESS;
@@ -796,6 +1603,34 @@ nixl_status_t nixlUcxEngine::unloadMD (nixlBackendMD* input) {
  * Data movement
 *****************************************/
 
+// Wire format of a notification active message: the sender name followed
+// by one or more messages, each string prefixed with its 32 bit length
+static void _notifPack(std::string &buf, const std::string &str)
+{
+    uint32_t len = str.size();
+
+    buf.append((const char*) &len, sizeof(len));
+    buf.append(str);
+}
+
+static bool _notifUnpack(const char* &pos, const char *end, std::string &str)
+{
+    uint32_t len;
+
+    if ((size_t) (end - pos) < sizeof(len)) {
+        return false;
+    }
+    memcpy(&len, pos, sizeof(len));
+    pos += sizeof(len);
+
+    if ((size_t) (end - pos) < len) {
+        return false;
+    }
+    str.assign(pos, len);
+    pos += len;
+    return true;
+}
+
 static nixl_status_t _retHelper(nixl_status_t ret,  nixlUcxBackendH *hndl, nixlUcxReq &req)
 {
     /* if transfer wasn't immediately completed */
@@ -820,35 +1655,65 @@ nixl_status_t nixlUcxEngine::prepXfer (const nixl_xfer_op_t &operation,
                                        nixlBackendReqH* &handle,
                                        const nixl_opt_b_args_t* opt_args)
 {
-    /* TODO: try to get from a pool first */
-    nixlUcxBackendH *intHandle = new nixlUcxBackendH(uw);
+    size_t worker_idx = getWorkerIdx(opt_args ? opt_args->priority :
+                                     nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT);
+    nixlUcxBackendH *intHandle = reqhGet(worker_idx);
 
     handle = (nixlBackendReqH*)intHandle;
     return NIXL_SUCCESS;
 }
 
-nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
-                                       const nixl_meta_dlist_t &local,
-                                       const nixl_meta_dlist_t &remote,
-                                       const std::string &remote_agent,
-                                       nixlBackendReqH* &handle,
-                                       const nixl_opt_b_args_t* opt_args)
+// Posts the data operations of a transfer, without the flush and notification
+nixl_status_t nixlUcxEngine::postXferOps (const nixl_xfer_op_t &operation,
+                                          const nixl_meta_dlist_t &local,
+                                          const nixl_meta_dlist_t &remote,
+                                          nixlUcxBackendH *intHandle,
+                                          nixl_xfer_priority_t priority)
 {
     size_t lcnt = local.descCount();
     size_t rcnt = remote.descCount();
     size_t i;
     nixl_status_t ret;
-    nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
     nixlUcxPrivateMetadata *lmd;
     nixlUcxPublicMetadata *rmd;
     nixlUcxReq req;
 
+    if ((lcnt != rcnt) || (lcnt == 0)) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
 
-    if (lcnt != rcnt) {
+    if ((operation != NIXL_READ) && (operation != NIXL_WRITE)) {
         return NIXL_ERR_INVALID_PARAM;
     }
 
+    // Previous shared flush, if any, has completed before a repost
+    intHandle->releaseSharedFlush();
+    intHandle->flushes = 0;
+    intHandle->groupedDescs = 0;
+
+    size_t worker_idx = getWorkerIdx(priority);
+    intHandle->rebind(uws[worker_idx], worker_idx);
+    worker_idx = intHandle->getWorkerIdx();
+    nixlUcxWorker *w = uws[worker_idx];
+
+    // Device memory is posted under the context of its device
+    bool vram = cuda_addr_wa && (local.getType() == VRAM_SEG);
+    nixlUcxCudaCtxGuard ctx_guard(vram ? cudaCtx : nullptr);
+
     for(i = 0; i < lcnt; i++) {
+        size_t run = groupMinDescs ? groupRunLength(local, remote, i) : 1;
+
+        ctx_guard.set(local[i].devId);
+
+        if (run >= groupMinDescs && run > 1) {
+            ret = postGroup(operation, local, remote, i, run, w, worker_idx, intHandle);
+            if (ret != NIXL_SUCCESS) {
+                return ret;
+            }
+            i += run - 1;
+            continue;
+        }
+
         void *laddr = (void*) local[i].addr;
         size_t lsize = local[i].len;
         void *raddr = (void*) remote[i].addr;
@@ -865,10 +1730,12 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
 
         switch (operation) {
         case NIXL_READ:
-            ret = uw->read(rmd->conn.ep, (uint64_t) raddr, rmd->rkey, laddr, lmd->mem, lsize, req);
+            ret = w->read(rmd->conn.eps[worker_idx], (uint64_t) raddr,
+                          rmd->rkeys[worker_idx], laddr, lmd->mem, lsize, req);
             break;
         case NIXL_WRITE:
-            ret = uw->write(rmd->conn.ep, laddr, lmd->mem, (uint64_t) raddr, rmd->rkey, lsize, req);
+            ret = w->write(rmd->conn.eps[worker_idx], laddr, lmd->mem,
+                           (uint64_t) raddr, rmd->rkeys[worker_idx], lsize, req);
             break;
         default:
             return NIXL_ERR_INVALID_PARAM;
@@ -879,43 +1746,392 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
         }
     }
 
-    rmd = (nixlUcxPublicMetadata*) remote[0].metadataP;
-    ret = uw->flushEp(rmd->conn.ep, req);
+    return NIXL_SUCCESS;
+}
+
+// Number of descriptors from start that go to the same remote registration
+// from the same local device, with matching local and remote sizes, so they
+// can be posted as one group
+size_t nixlUcxEngine::groupRunLength (const nixl_meta_dlist_t &local,
+                                      const nixl_meta_dlist_t &remote,
+                                      size_t start) const
+{
+    size_t cnt = local.descCount();
+    size_t i;
+
+    if (local[start].len != remote[start].len) {
+        return 1;
+    }
+
+    for (i = start + 1; i < cnt; i++) {
+        if ((local[i].len != remote[i].len) ||
+            (local[i].devId != local[start].devId) ||
+            (remote[i].metadataP != remote[start].metadataP)) {
+            break;
+        }
+    }
+
+    return i - start;
+}
+
+// Posts a run of descriptors as plain contiguous operations, UCX RMA takes
+// no other datatype. Their requests are let go right away and the whole run
+// completes with one endpoint flush, the trailing flush of the transfer when
+// the operation needs one anyway.
+nixl_status_t nixlUcxEngine::postGroup (const nixl_xfer_op_t &operation,
+                                        const nixl_meta_dlist_t &local,
+                                        const nixl_meta_dlist_t &remote,
+                                        size_t start, size_t cnt,
+                                        nixlUcxWorker *w, size_t worker_idx,
+                                        nixlUcxBackendH *intHandle)
+{
+    nixlUcxPublicMetadata *rmd = (nixlUcxPublicMetadata*) remote[start].metadataP;
+    nixlUcxPrivateMetadata *lmd;
+    nixl_status_t ret;
+    nixlUcxReq req;
+
+    for (size_t i = start; i < start + cnt; i++) {
+        lmd = (nixlUcxPrivateMetadata*) local[i].metadataP;
+
+        if (operation == NIXL_READ) {
+            ret = w->read(rmd->conn.eps[worker_idx], (uint64_t) remote[i].addr,
+                          rmd->rkeys[worker_idx], (void*) local[i].addr, lmd->mem,
+                          local[i].len, req);
+        } else {
+            ret = w->write(rmd->conn.eps[worker_idx], (void*) local[i].addr, lmd->mem,
+                           (uint64_t) remote[i].addr, rmd->rkeys[worker_idx],
+                           local[i].len, req);
+        }
+
+        if (ret == NIXL_IN_PROG) {
+            // Freed by UCX once done, the flush below covers its completion
+            _internalRequestReset((nixlUcxIntReq*) req);
+            w->reqRelease(req);
+        } else if (ret != NIXL_SUCCESS) {
+            intHandle->release();
+            return NIXL_ERR_BACKEND;
+        }
+    }
+    intHandle->groupedDescs += cnt;
+
+    if (needsFlush(operation)) {
+        return NIXL_SUCCESS;
+    }
+
+    ret = w->flushEp(rmd->conn.eps[worker_idx], req);
     if (_retHelper(ret, intHandle, req)) {
         return ret;
     }
+    intHandle->flushes++;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
+                                       const nixl_meta_dlist_t &local,
+                                       const nixl_meta_dlist_t &remote,
+                                       const std::string &remote_agent,
+                                       nixlBackendReqH* &handle,
+                                       const nixl_opt_b_args_t* opt_args)
+{
+    nixl_status_t ret;
+    nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
+    nixlUcxPublicMetadata *rmd;
+    nixlUcxReq req;
+
+    ret = postXferOps(operation, local, remote, intHandle,
+                      opt_args ? opt_args->priority :
+                                 nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    // Flush and notification go through the worker used for the data
+    size_t worker_idx = intHandle->getWorkerIdx();
+    if (needsFlush(operation)) {
+        rmd = (nixlUcxPublicMetadata*) remote[0].metadataP;
+        ret = uws[worker_idx]->flushEp(rmd->conn.eps[worker_idx], req);
+        if (_retHelper(ret, intHandle, req)) {
+            return ret;
+        }
+        intHandle->flushes++;
+    }
 
     if(opt_args && opt_args->hasNotif) {
-        ret = notifSendPriv(remote_agent, opt_args->notifMsg, req);
+        // Without a flush the notification is only ordered after the data
+        if (!needsFlush(operation)) {
+            ret = uws[worker_idx]->fence();
+            if (ret != NIXL_SUCCESS) {
+                return ret;
+            }
+        }
+        ret = notifSendPriv(remote_agent, opt_args->notifMsg, req, worker_idx);
         if (_retHelper(ret, intHandle, req)) {
             return ret;
         }
     }
 
-    return intHandle->status();
+    ret = intHandle->status();
+    if ((ret == NIXL_IN_PROG) && opt_args && opt_args->completionCtx) {
+        completionTrack(intHandle, opt_args->completionCtx);
+    }
+    progressThreadWake(worker_idx);
+    return ret;
+}
+
+nixl_status_t nixlUcxEngine::postXfers (nixl_b_xfer_batch_t &xfers)
+{
+    size_t i, j, count = xfers.size();
+    nixl_status_t ret, out_ret = NIXL_SUCCESS;
+    nixlUcxPublicMetadata *rmd;
+    nixlUcxReq req;
+
+    // Post the data operations of the whole batch first
+    for (i = 0; i < count; i++) {
+        xfers[i].status = postXferOps(xfers[i].operation, *xfers[i].local,
+                                      *xfers[i].remote,
+                                      (nixlUcxBackendH*) xfers[i].handle,
+                                      xfers[i].optArgs.priority);
+    }
+
+    // Flush each endpoint once, for all the transfers of the batch going to it
+    std::vector<bool> flushed(count, false);
+    std::vector<size_t> group;
+    for (i = 0; i < count; i++) {
+        if ((xfers[i].status != NIXL_SUCCESS) || flushed[i] ||
+            !needsFlush(xfers[i].operation)) {
+            continue;
+        }
+
+        // Endpoints are per worker, a handle can stay on its previous one
+        size_t worker_idx = ((nixlUcxBackendH*) xfers[i].handle)->getWorkerIdx();
+
+        group.clear();
+        for (j = i; j < count; j++) {
+            if ((xfers[j].status == NIXL_SUCCESS) && !flushed[j] &&
+                needsFlush(xfers[j].operation) &&
+                (((nixlUcxBackendH*) xfers[j].handle)->getWorkerIdx() == worker_idx) &&
+                (*xfers[j].remoteAgent == *xfers[i].remoteAgent)) {
+                flushed[j] = true;
+                group.push_back(j);
+            }
+        }
+
+        rmd = (nixlUcxPublicMetadata*) (*xfers[i].remote)[0].metadataP;
+        ret = uws[worker_idx]->flushEp(rmd->conn.eps[worker_idx], req);
+
+        if ((ret == NIXL_IN_PROG) && (group.size() > 1)) {
+            nixlUcxSharedFlush *flush = new nixlUcxSharedFlush(uws[worker_idx], req, group.size());
+            for (auto & idx : group) {
+                ((nixlUcxBackendH*) xfers[idx].handle)->setSharedFlush(flush);
+                ((nixlUcxBackendH*) xfers[idx].handle)->flushes++;
+            }
+        } else {
+            for (auto & idx : group) {
+                if (_retHelper(ret, (nixlUcxBackendH*) xfers[idx].handle, req)) {
+                    xfers[idx].status = NIXL_ERR_BACKEND;
+                } else {
+                    ((nixlUcxBackendH*) xfers[idx].handle)->flushes++;
+                }
+            }
+        }
+    }
+
+    // Notifications go after the flush of their endpoint, same as postXfer.
+    // The ones to the same agent through the same worker are packed into
+    // one message, tracked by the last transfer of the group. Unflushed ones
+    // need a fence on their worker, once for the batch.
+    std::vector<bool> fenced(uws.size(), false);
+    std::vector<bool> notified(count, false);
+    for (i = 0; i < count; i++) {
+        if ((xfers[i].status != NIXL_SUCCESS) || !xfers[i].optArgs.hasNotif || notified[i]) {
+            continue;
+        }
+
+        size_t worker_idx = ((nixlUcxBackendH*) xfers[i].handle)->getWorkerIdx();
+        bool need_fence = false;
+        std::string *buf = new std::string;
+
+        notifBatchInit(*buf);
+        group.clear();
+        for (j = i; j < count; j++) {
+            if ((xfers[j].status == NIXL_SUCCESS) && xfers[j].optArgs.hasNotif &&
+                !notified[j] &&
+                (((nixlUcxBackendH*) xfers[j].handle)->getWorkerIdx() == worker_idx) &&
+                (*xfers[j].remoteAgent == *xfers[i].remoteAgent)) {
+                notified[j] = true;
+                need_fence |= !needsFlush(xfers[j].operation);
+                _notifPack(*buf, xfers[j].optArgs.notifMsg);
+                group.push_back(j);
+            }
+        }
+
+        ret = NIXL_SUCCESS;
+        if (need_fence && !fenced[worker_idx]) {
+            ret = uws[worker_idx]->fence();
+            fenced[worker_idx] = (ret == NIXL_SUCCESS);
+        }
+
+        if (ret == NIXL_SUCCESS) {
+            ret = notifSendBuf(*xfers[i].remoteAgent, buf, req, worker_idx);
+            if (_retHelper(ret, (nixlUcxBackendH*) xfers[group.back()].handle, req)) {
+                ret = NIXL_ERR_BACKEND;
+            }
+        } else {
+            delete buf;
+        }
+
+        if (ret < 0) {
+            for (auto & idx : group) {
+                xfers[idx].status = ret;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        nixlUcxBackendH *intHandle = (nixlUcxBackendH*) xfers[i].handle;
+
+        if (xfers[i].status == NIXL_SUCCESS) {
+            xfers[i].status = intHandle->status();
+            if ((xfers[i].status == NIXL_IN_PROG) && xfers[i].optArgs.completionCtx) {
+                completionTrack(intHandle, xfers[i].optArgs.completionCtx);
+            }
+        }
+
+        if ((xfers[i].status < 0) && (out_ret == NIXL_SUCCESS)) {
+            out_ret = xfers[i].status;
+        }
+    }
+
+    for (i = 0; i < uws.size(); i++) {
+        progressThreadWake(i);
+    }
+
+    return out_ret;
 }
 
 nixl_status_t nixlUcxEngine::checkXfer (nixlBackendReqH* handle)
 {
     nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
 
-    return intHandle->status();
+    if (!intHandle->cqTracked) {
+        return intHandle->status();
+    }
+
+    // The progress thread might be checking it as well. If found done here
+    // first, it is reported from here, so it's reported only once.
+    std::lock_guard<std::mutex> lock(cqMtx);
+    nixl_status_t ret = intHandle->status();
+    if (intHandle->cqTracked && (ret != NIXL_IN_PROG)) {
+        void *ctx = intHandle->cqCtx;
+        completionUntrack(intHandle);
+        completionSink->xferDone(ctx, ret);
+    }
+    return ret;
 }
 
 nixl_status_t nixlUcxEngine::releaseReqH(nixlBackendReqH* handle)
 {
     nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
+
+    if (intHandle->cqTracked) {
+        std::lock_guard<std::mutex> lock(cqMtx);
+        completionUntrack(intHandle);
+    }
+
     nixl_status_t status = intHandle->release();
 
-    /* TODO: return to a pool instead. */
-    delete intHandle;
+    reqhPut(intHandle);
 
     return status;
 }
 
+// Of the last post: the worker it went through, its endpoint flushes and
+// how many of its descriptors were posted in groups
+nixl_status_t nixlUcxEngine::getXferStats(const nixlBackendReqH* handle,
+                                          nixl_b_params_t &stats) const
+{
+    const nixlUcxBackendH *intHandle = (const nixlUcxBackendH *) handle;
+
+    stats["worker"] = std::to_string(intHandle->getWorkerIdx());
+    stats["flushes"] = std::to_string(intHandle->flushes);
+    stats["grouped_descs"] = std::to_string(intHandle->groupedDescs);
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Request handle pool
+*****************************************/
+
+nixlUcxBackendH* nixlUcxEngine::reqhGet(size_t worker_idx)
+{
+    nixlUcxBackendH *intHandle = nullptr;
+
+    // Only one submitter pops at a time, the others allocate instead of waiting
+    std::unique_lock<std::mutex> lock(reqhCacheMtx, std::try_to_lock);
+    if (lock.owns_lock()) {
+        if (!reqhCache) {
+            reqhCache = reqhReturned.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (reqhCache) {
+            intHandle = reqhCache;
+            reqhCache = intHandle->poolNext;
+        }
+    }
+
+    if (!intHandle) {
+        return new nixlUcxBackendH(uws[worker_idx], worker_idx);
+    }
+
+    intHandle->reset(uws[worker_idx], worker_idx);
+    return intHandle;
+}
+
+void nixlUcxEngine::reqhPut(nixlUcxBackendH *intHandle)
+{
+    // Pushing only is ABA safe, as the list is only ever taken as a whole
+    nixlUcxBackendH *top = reqhReturned.load(std::memory_order_relaxed);
+    do {
+        intHandle->poolNext = top;
+    } while (!reqhReturned.compare_exchange_weak(top, intHandle,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
+
+void nixlUcxEngine::reqhPoolFini()
+{
+    nixlUcxBackendH *lists[] = {reqhCache, reqhReturned.exchange(nullptr)};
+
+    for (nixlUcxBackendH *intHandle : lists) {
+        while (intHandle) {
+            nixlUcxBackendH *next = intHandle->poolNext;
+            delete intHandle;
+            intHandle = next;
+        }
+    }
+    reqhCache = nullptr;
+}
+
 int nixlUcxEngine::progress() {
+    int ret = 0;
+
     // TODO: add listen for connection handling if necessary
-    return uw->progress();
+    for (auto &w : uws) {
+        ret += w->progress();
+    }
+    notifBatchFlush(false);
+    return ret;
+}
+
+size_t nixlUcxEngine::getWorkerIdx(nixl_xfer_priority_t priority) const {
+    // Threads are numbered on first use, the same for every engine
+    static std::atomic<size_t> thread_count{0};
+    static thread_local size_t thread_idx = thread_count++;
+
+    if (!priorityLanes)
+        return thread_idx % uws.size();
+    if (priority == nixl_xfer_priority_t::NIXL_XFER_PRIORITY_HIGH)
+        return 0;
+    return 1 + thread_idx % (uws.size() - 1);
 }
 
 /****************************************
@@ -923,12 +2139,29 @@ int nixlUcxEngine::progress() {
 *****************************************/
 
 //agent will provide cached msg
+void nixlUcxEngine::notifBatchInit(std::string &buf) const
+{
+    _notifPack(buf, localAgent);
+}
+
 nixl_status_t nixlUcxEngine::notifSendPriv(const std::string &remote_agent,
-                                           const std::string &msg, nixlUcxReq &req)
+                                           const std::string &msg, nixlUcxReq &req,
+                                           size_t worker_idx)
+{
+    // TODO: replace with mpool for performance
+    std::string *buf = new std::string;
+
+    notifBatchInit(*buf);
+    _notifPack(*buf, msg);
+
+    return notifSendBuf(remote_agent, buf, req, worker_idx);
+}
+
+// Takes ownership of buf, which is kept with req until it completes
+nixl_status_t nixlUcxEngine::notifSendBuf(const std::string &remote_agent,
+                                          std::string *buf, nixlUcxReq &req,
+                                          size_t worker_idx)
 {
-    nixlSerDes ser_des;
-    std::string *ser_msg;
-    nixlUcxConnection conn;
     // TODO - temp fix, need to have an mpool
     static struct nixl_ucx_am_hdr hdr;
     uint32_t flags = 0;
@@ -938,33 +2171,93 @@ nixl_status_t nixlUcxEngine::notifSendPriv(const std::string &remote_agent,
 
     if(search == remoteConnMap.end()) {
         //TODO: err: remote connection not found
+        delete buf;
         return NIXL_ERR_NOT_FOUND;
     }
 
-    conn = remoteConnMap[remote_agent];
+    nixlUcxConnection &conn = search->second;
 
     hdr.op = NOTIF_STR;
     flags |= UCP_AM_SEND_FLAG_EAGER;
 
-    ser_des.addStr("name", localAgent);
-    ser_des.addStr("msg", msg);
-    // TODO: replace with mpool for performance
-    ser_msg = new std::string(ser_des.exportStr());
-
-    ret = uw->sendAm(conn.ep, NOTIF_STR,
+    ret = uws[worker_idx]->sendAm(conn.eps[worker_idx], NOTIF_STR,
                      &hdr, sizeof(struct nixl_ucx_am_hdr),
-                     (void*) ser_msg->data(), ser_msg->size(),
+                     (void*) buf->data(), buf->size(),
                      flags, req);
 
     if (ret == NIXL_IN_PROG) {
         nixlUcxIntReq* nReq = (nixlUcxIntReq*)req;
-        nReq->amBuffer = ser_msg;
+        nReq->amBuffer = buf;
     } else {
-        delete ser_msg;
+        delete buf;
     }
     return ret;
 }
 
+/* Coalescing of genNotif messages */
+
+// Past this size a batch is sent right away, to stay within eager limits
+static const size_t notifBatchMaxSize = 8192;
+
+nixl_status_t nixlUcxEngine::notifBatchQueue(const std::string &remote_agent,
+                                             const std::string &msg)
+{
+    if (remoteConnMap.find(remote_agent) == remoteConnMap.end()) {
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(notifBatchMtx);
+        nixlUcxNotifBatch &batch = notifBatches[remote_agent];
+
+        if (batch.buf.empty()) {
+            notifBatchInit(batch.buf);
+            batch.start = nixlTime::getUs();
+            notifBatched++;
+        }
+        _notifPack(batch.buf, msg);
+
+        if (batch.buf.size() >= notifBatchMaxSize) {
+            notifBatchSend(remote_agent, batch);
+        }
+    }
+
+    // Also sends the batches of other agents that waited long enough
+    notifBatchFlush(false);
+    return NIXL_SUCCESS;
+}
+
+// With notifBatchMtx held
+void nixlUcxEngine::notifBatchSend(const std::string &remote_agent, nixlUcxNotifBatch &batch)
+{
+    nixlUcxReq req;
+    std::string *buf = new std::string(std::move(batch.buf));
+
+    batch.buf.clear();
+    notifBatched--;
+
+    // Same as genNotif, the request is not tracked
+    if (notifSendBuf(remote_agent, buf, req, 0) == NIXL_IN_PROG) {
+        uw->reqRelease(req);
+    }
+}
+
+void nixlUcxEngine::notifBatchFlush(bool force)
+{
+    if (notifBatched == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(notifBatchMtx);
+    nixlTime::us_t now = nixlTime::getUs();
+
+    for (auto &[agent, batch] : notifBatches) {
+        if (!batch.buf.empty() && (force || (batch.start + notifCoalesce <= now))) {
+            notifBatchSend(agent, batch);
+        }
+    }
+}
+
 ucs_status_t
 nixlUcxEngine::notifAmCb(void *arg, const void *header,
                          size_t header_length, void *data,
@@ -972,11 +2265,10 @@ nixlUcxEngine::notifAmCb(void *arg, const void *header,
                          const ucp_am_recv_param_t *param)
 {
     struct nixl_ucx_am_hdr* hdr = (struct nixl_ucx_am_hdr*) header;
-    nixlSerDes ser_des;
-
-    std::string ser_str( (char*) data, length);
     nixlUcxEngine* engine = (nixlUcxEngine*) arg;
-    std::string remote_name, msg;
+    const char *pos = (const char*) data;
+    const char *end = pos + length;
+    std::string remote_name;
 
     if(hdr->op != NOTIF_STR) {
         //is this the best way to ERR?
@@ -989,32 +2281,39 @@ nixlUcxEngine::notifAmCb(void *arg, const void *header,
         return UCS_ERR_INVALID_PARAM;
     }
 
-    ser_des.importStr(ser_str);
-    remote_name = ser_des.getStr("name");
-    msg = ser_des.getStr("msg");
+    // Parsed in place, the messages are only copied into their own strings
+    if (!_notifUnpack(pos, end, remote_name) || (pos == end)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
 
     if (engine->isProgressThread()) {
         /* Append to the private list to allow batching */
-        engine->notifPthrPriv.push_back(std::make_pair(remote_name, msg));
+        while (pos < end) {
+            engine->notifPthrPriv.emplace_back(remote_name, std::string());
+            if (!_notifUnpack(pos, end, engine->notifPthrPriv.back().second)) {
+                engine->notifPthrPriv.pop_back();
+                return UCS_ERR_INVALID_PARAM;
+            }
+        }
     } else {
-        engine->notifMainList.push_back(std::make_pair(remote_name, msg));
+        notif_list_t batch;
+        while (pos < end) {
+            batch.emplace_back(remote_name, std::string());
+            if (!_notifUnpack(pos, end, batch.back().second)) {
+                return UCS_ERR_INVALID_PARAM;
+            }
+        }
+
+        // Progress can be driven by several user threads at once
+        engine->notifMtx.lock();
+        move(batch.begin(), batch.end(), back_inserter(engine->notifMainList));
+        engine->notifMtx.unlock();
     }
 
     return UCS_OK;
 }
 
 
-void nixlUcxEngine::notifCombineHelper(notif_list_t &src, notif_list_t &tgt)
-{
-    if (!src.size()) {
-        // Nothing to do. Exit
-        return;
-    }
-
-    move(src.begin(), src.end(), back_inserter(tgt));
-    src.erase(src.begin(), src.end());
-}
-
 void nixlUcxEngine::notifProgressCombineHelper(notif_list_t &src, notif_list_t &tgt)
 {
     notifMtx.lock();
@@ -1029,7 +2328,29 @@ void nixlUcxEngine::notifProgressCombineHelper(notif_list_t &src, notif_list_t &
 
 void nixlUcxEngine::notifProgress()
 {
-    notifProgressCombineHelper(notifPthrPriv, notifPthr);
+    size_t i;
+
+    for (i = 0; i < notifPthrPriv.size(); i++) {
+        if (!notifRing->push(notifPthrPriv[i])) {
+            break;
+        }
+    }
+
+    if (i) {
+        notifPthrPriv.erase(notifPthrPriv.begin(), notifPthrPriv.begin() + i);
+    }
+
+    notifBatchFlush(false);
+}
+
+template <typename F>
+void nixlUcxEngine::notifRingDrain(F &&consume)
+{
+    std::pair<std::string, std::string> elm;
+
+    while (notifRing->pop(elm)) {
+        consume(elm);
+    }
 }
 
 nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
@@ -1039,8 +2360,30 @@ nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
 
     if(!pthrOn) while(progress());
 
-    notifCombineHelper(notifMainList, notif_list);
-    notifProgressCombineHelper(notifPthr, notif_list);
+    notifProgressCombineHelper(notifMainList, notif_list);
+    notifRingDrain([&notif_list](std::pair<std::string, std::string> &elm) {
+        notif_list.push_back(std::move(elm));
+    });
+
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUcxEngine::appendNotifs(nixl_notif_list_t &notif_list)
+{
+    if(!pthrOn) while(progress());
+
+    notifMtx.lock();
+
+    for (auto &elm : notifMainList) {
+        notif_list.add(elm.first, std::move(elm.second));
+    }
+    notifMainList.clear();
+
+    notifMtx.unlock();
+
+    notifRingDrain([&notif_list](std::pair<std::string, std::string> &elm) {
+        notif_list.add(elm.first, std::move(elm.second));
+    });
 
     return NIXL_SUCCESS;
 }
@@ -1050,7 +2393,14 @@ nixl_status_t nixlUcxEngine::genNotif(const std::string &remote_agent, const std
     nixl_status_t ret;
     nixlUcxReq req;
 
+    if (notifCoalesce) {
+        ret = notifBatchQueue(remote_agent, msg);
+        progressThreadWake(0);
+        return ret;
+    }
+
     ret = notifSendPriv(remote_agent, msg, req);
+    progressThreadWake(0);
 
     switch(ret) {
     case NIXL_IN_PROG:
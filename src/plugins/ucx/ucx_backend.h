@@ -17,6 +17,8 @@
 #ifndef __UCX_BACKEND_H
 #define __UCX_BACKEND_H
 
+#include <atomic>
+#include <list>
 #include <vector>
 #include <cstring>
 #include <iostream>
@@ -31,6 +33,7 @@
 #include "common/nixl_time.h"
 #include "ucx/ucx_utils.h"
 #include "common/list_elem.h"
+#include "common/ring.h"
 
 typedef enum {CONN_CHECK, NOTIF_STR, DISCONNECT} ucx_cb_op_t;
 
@@ -41,8 +44,12 @@ struct nixl_ucx_am_hdr {
 class nixlUcxConnection : public nixlBackendConnMD {
     private:
         std::string remoteAgent;
-        nixlUcxEp ep;
+        // One endpoint per local worker, the first one is used for control
+        std::vector<nixlUcxEp> eps;
         volatile bool connected;
+        // Host memory estimates of UCX for the peer once it's connected,
+        // bandwidth is 0 if not known. Guarded by connMapMtx
+        nixlBackendXferHints hints;
 
     public:
         // Extra information required for UCX connections
@@ -70,11 +77,31 @@ class nixlUcxPrivateMetadata : public nixlBackendMD {
     friend class nixlUcxEngine;
 };
 
+// Unpacked rkeys of a remote agent's packed key, shared by all the public
+// metadata loaded from the same blob. Up to rkeyIdleMax unreferenced entries
+// are kept, least recently released first out, so reloading the agent's
+// metadata doesn't unpack again. All are dropped when the connection ends.
+class nixlUcxRkeyEntry {
+    public:
+        // Unpacked on the endpoint of each local worker
+        std::vector<nixlUcxRkey> rkeys;
+        std::string agent;
+        nixl_blob_t blob;
+        size_t refCnt = 0;
+        // Cleared when the connection ends while still referenced
+        bool cached = true;
+        // Place among the unreferenced entries kept for later loads
+        bool idle = false;
+        std::list<nixlUcxRkeyEntry*>::iterator idlePos;
+};
+
 // A public metadata has to implement put, and only has the remote metadata
 class nixlUcxPublicMetadata : public nixlBackendMD {
 
     public:
-        nixlUcxRkey rkey;
+        // Copy of the shared entry's rkeys, for the data path
+        std::vector<nixlUcxRkey> rkeys;
+        nixlUcxRkeyEntry* rkeyEntry = nullptr;
         nixlUcxConnection conn;
 
         nixlUcxPublicMetadata() : nixlBackendMD(false) {}
@@ -90,14 +117,38 @@ class nixlUcxPublicMetadata : public nixlBackendMD {
 // will be part of NIXL installation - we can have
 // HAVE_CUDA in h-files
 class nixlUcxCudaCtx;
+class nixlUcxBackendH;
+
+// Notifications waiting to be sent to one agent, already in wire format
+class nixlUcxNotifBatch {
+    public:
+        std::string buf;
+        nixlTime::us_t start;
+};
+
 class nixlUcxEngine : public nixlBackendEngine {
     private:
 
         /* UCX data */
         nixlUcxContext* uc;
+        // Submitting threads are spread over the workers, the first one
+        // also takes the control operations
+        std::vector<nixlUcxWorker*> uws;
         nixlUcxWorker* uw;
-        void* workerAddr;
-        size_t workerSize;
+        std::string connInfo;
+
+        // Completion of a read is taken from its own operations, instead of
+        // a trailing endpoint flush. Writes still need the flush, as a put
+        // completes locally before it is visible at the target.
+        bool opCompletion = false;
+
+        // Runs of at least this many descriptors to one remote registration
+        // are posted as a group that completes with one flush, 0 disables it
+        size_t groupMinDescs = 16;
+
+        // With several workers, high priority transfers get worker 0 to
+        // themselves, and the other classes share the rest
+        bool priorityLanes = false;
 
         /* Progress thread data */
         volatile bool pthrStop, pthrActive, pthrOn;
@@ -105,6 +156,20 @@ class nixlUcxEngine : public nixlBackendEngine {
         std::thread pthr;
         nixlTime::us_t pthrDelay;
 
+        // Event mode: the thread spins pthrSpin after its last progress,
+        // then sleeps in epoll on the worker event fds until woken
+        bool pthrEvent = false;
+        nixlTime::us_t pthrSpin;
+        int pthrEpfd = -1;
+        std::atomic<bool> pthrSleeping{false};
+
+        // Set when the agent progresses its engines from one thread, which
+        // then runs progressRound instead of this engine starting pthr
+        nixlProgressDriver *pthrDriver = nullptr;
+
+        // CPUs to pin pthr to, see nixlPinThread, empty leaves it unpinned
+        std::string pthrCpus;
+
         /* CUDA data*/
         nixlUcxCudaCtx *cudaCtx;
         bool cuda_addr_wa;
@@ -112,17 +177,54 @@ class nixlUcxEngine : public nixlBackendEngine {
         /* Notifications */
         notif_list_t notifMainList;
         std::mutex  notifMtx;
-        notif_list_t notifPthrPriv, notifPthr;
+        // Received by the progress thread, handed to getNotifs through a
+        // lock-free ring. What doesn't fit waits in notifPthrPriv for the
+        // next round.
+        notif_list_t notifPthrPriv;
+        std::unique_ptr<nixlRing<std::pair<std::string, std::string>>> notifRing;
+
+        // genNotif messages to the same agent are packed into one active
+        // message, sent once the oldest is notifCoalesce old (0 disables)
+        nixlTime::us_t notifCoalesce = 0;
+        std::unordered_map<std::string, nixlUcxNotifBatch> notifBatches;
+        std::atomic<size_t> notifBatched{0};
+        std::mutex notifBatchMtx;
+
+        /* Posted handles whose completion is reported to completionSink */
+        std::vector<nixlUcxBackendH*> cqList;
+        std::mutex cqMtx;
+
+        /* Released request handles kept for reuse. Releasers push onto
+         * reqhReturned, the submitter owning reqhCacheMtx pops from reqhCache
+         * and refills it by taking the whole returned list at once. */
+        std::atomic<nixlUcxBackendH*> reqhReturned{nullptr};
+        nixlUcxBackendH* reqhCache = nullptr;
+        std::mutex reqhCacheMtx;
 
         // Map of agent name to saved nixlUcxConnection info
         std::unordered_map<std::string, nixlUcxConnection,
                            std::hash<std::string>, strEqual> remoteConnMap;
+        // Held when adding or removing connections, when looking them up off
+        // the agent's calls, and for their hints
+        mutable std::mutex connMapMtx;
+
+        // Remote agent name to its packed rkeys and their unpacked entries
+        std::unordered_map<std::string,
+                           std::unordered_map<nixl_blob_t, nixlUcxRkeyEntry*>> rkeyCache;
+        // Unreferenced entries, least recently released first, at most
+        // rkeyIdleMax of them are kept
+        std::list<nixlUcxRkeyEntry*> rkeyIdle;
+        size_t rkeyIdleMax = 1024;
+        std::mutex rkeyCacheMtx;
+
 
+        void probeConnHints(const std::string &remote_agent);
 
         void vramInitCtx();
         void vramFiniCtx();
-        int vramUpdateCtx(void *address, uint64_t devId, bool &restart_reqd);
+        int vramUpdateCtx(void *address, uint64_t devId);
         int vramApplyCtx();
+        void vramRefreshCtx();
 
         // Threading infrastructure
         //   TODO: move the thread management one outside of NIXL common infra
@@ -130,7 +232,13 @@ class nixlUcxEngine : public nixlBackendEngine {
         void progressThreadStart();
         void progressThreadStop();
         void progressThreadRestart();
+        void progressFuncEvent();
+        bool progressWorkers();
+        void progressThreadWake(size_t worker_idx);
         bool isProgressThread(){
+            if (pthrDriver) {
+                return pthrDriver->isProgressThread();
+            }
             return (std::this_thread::get_id() == pthr.get_id());
         }
 
@@ -147,10 +255,37 @@ class nixlUcxEngine : public nixlBackendEngine {
                            size_t length,
                            const ucp_am_recv_param_t *param);
 
+        // Data transfer helpers
+        bool needsFlush(const nixl_xfer_op_t &operation) const {
+            return !opCompletion || (operation != NIXL_READ);
+        }
+        nixl_status_t postXferOps (const nixl_xfer_op_t &operation,
+                                   const nixl_meta_dlist_t &local,
+                                   const nixl_meta_dlist_t &remote,
+                                   nixlUcxBackendH *intHandle,
+                                   nixl_xfer_priority_t priority);
+        size_t groupRunLength (const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote,
+                               size_t start) const;
+        nixl_status_t postGroup (const nixl_xfer_op_t &operation,
+                                 const nixl_meta_dlist_t &local,
+                                 const nixl_meta_dlist_t &remote,
+                                 size_t start, size_t cnt,
+                                 nixlUcxWorker *w, size_t worker_idx,
+                                 nixlUcxBackendH *intHandle);
+
         // Memory management helpers
         nixl_status_t internalMDHelper (const nixl_blob_t &blob,
                                         const std::string &agent,
                                         nixlBackendMD* &output);
+        nixl_status_t rkeyGet (const nixl_blob_t &blob,
+                               const std::string &agent,
+                               nixlUcxConnection &conn,
+                               nixlUcxRkeyEntry* &entry);
+        void rkeyPut (nixlUcxRkeyEntry *entry);
+        void rkeyFree (nixlUcxRkeyEntry *entry);
+        void rkeyEvict (nixlUcxRkeyEntry *entry);
+        void rkeyCacheDrop (const std::string &agent);
 
         // Notifications
         static ucs_status_t notifAmCb(void *arg, const void *header,
@@ -158,10 +293,31 @@ class nixlUcxEngine : public nixlBackendEngine {
                                       size_t length,
                                       const ucp_am_recv_param_t *param);
         nixl_status_t notifSendPriv(const std::string &remote_agent,
-                                    const std::string &msg, nixlUcxReq &req);
+                                    const std::string &msg, nixlUcxReq &req,
+                                    size_t worker_idx = 0);
+        nixl_status_t notifSendBuf(const std::string &remote_agent,
+                                   std::string *buf, nixlUcxReq &req,
+                                   size_t worker_idx);
+        void notifBatchInit(std::string &buf) const;
+        nixl_status_t notifBatchQueue(const std::string &remote_agent,
+                                      const std::string &msg);
+        void notifBatchSend(const std::string &remote_agent, nixlUcxNotifBatch &batch);
+        void notifBatchFlush(bool force);
+
+        // Worker of the calling thread, within the lane of the priority class
+        size_t getWorkerIdx(nixl_xfer_priority_t priority =
+                                nixl_xfer_priority_t::NIXL_XFER_PRIORITY_DEFAULT) const;
         void notifProgress();
-        void notifCombineHelper(notif_list_t &src, notif_list_t &tgt);
         void notifProgressCombineHelper(notif_list_t &src, notif_list_t &tgt);
+        template <typename F> void notifRingDrain(F &&consume);
+
+        void completionTrack(nixlUcxBackendH *intHandle, void *ctx);
+        void completionUntrack(nixlUcxBackendH *intHandle);
+        void completionProgress();
+
+        nixlUcxBackendH* reqhGet(size_t worker_idx);
+        void reqhPut(nixlUcxBackendH *intHandle);
+        void reqhPoolFini();
 
     public:
         nixlUcxEngine(const nixlBackendInitParams* init_params);
@@ -171,8 +327,21 @@ class nixlUcxEngine : public nixlBackendEngine {
         bool supportsLocal () const { return true; }
         bool supportsNotif () const { return true; }
         bool supportsProgTh () const { return pthrOn; }
+        // Completions are found by the progress thread, if there is one
+        bool supportsXferCompletion () const { return pthrOn; }
+        // Workers are thread safe, and rkeys are unpacked outside of the cache lock
+        bool supportsConcurrentLoad () const { return true; }
+        // Mapping takes the cache lock, only the CUDA context workaround isn't safe
+        bool supportsConcurrentReg () const { return !cuda_addr_wa; }
 
         nixl_mem_list_t getSupportedMems () const;
+        nixl_status_t getXferHints (const nixl_mem_t &local_mem,
+                                    const nixl_mem_t &remote_mem,
+                                    nixlBackendXferHints &hints) const;
+        nixl_status_t getPeerXferHints (const nixl_mem_t &local_mem,
+                                        const nixl_mem_t &remote_mem,
+                                        const std::string &remote_agent,
+                                        nixlBackendXferHints &hints) const;
 
         /* Object management */
         nixl_status_t getPublicData (const nixlBackendMD* meta,
@@ -182,6 +351,8 @@ class nixlUcxEngine : public nixlBackendEngine {
                                           const std::string &remote_conn_info);
 
         nixl_status_t connect(const std::string &remote_agent);
+        nixl_status_t connectAgents(const std::vector<std::string> &remote_agents,
+                                    std::vector<nixl_status_t> &statuses);
         nixl_status_t disconnect(const std::string &remote_agent);
 
         nixl_status_t registerMem (const nixlBlobDesc &mem,
@@ -213,12 +384,18 @@ class nixlUcxEngine : public nixlBackendEngine {
                                 nixlBackendReqH* &handle,
                                 const nixl_opt_b_args_t* opt_args=nullptr);
 
+        nixl_status_t postXfers (nixl_b_xfer_batch_t &xfers);
+
         nixl_status_t checkXfer (nixlBackendReqH* handle);
         nixl_status_t releaseReqH(nixlBackendReqH* handle);
+        nixl_status_t getXferStats(const nixlBackendReqH* handle,
+                                   nixl_b_params_t &stats) const;
 
         int progress();
+        bool progressRound();
 
         nixl_status_t getNotifs(notif_list_t &notif_list);
+        nixl_status_t appendNotifs(nixl_notif_list_t &notif_list);
         nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
 
         //public function for UCX worker to mark connections as connected
@@ -45,6 +45,17 @@ static const char* get_plugin_version() {
 static nixl_b_params_t get_backend_options() {
     nixl_b_params_t params;
     params["ucx_devices"] = "";
+    params["num_workers"] = "1";
+    params["completion_mode"] = "flush";
+    params["group_min_descs"] = "16";
+    params["notif_coalesce_us"] = "0";
+    params["notif_ring_size"] = "4096";
+    params["reg_cache_size"] = "0";
+    params["rkey_cache_size"] = "1024";
+    params["progress_mode"] = "poll";
+    params["progress_spin_us"] = "";
+    params["progress_cpus"] = "";
+    params["priority_lanes"] = "off";
     return params;
 }
 
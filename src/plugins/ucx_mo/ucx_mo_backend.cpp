@@ -16,6 +16,9 @@
  */
 #include <stdlib.h>
 #include <cassert>
+#include <atomic>
+#include <algorithm>
+#include <set>
 
 
 // Local includes
@@ -55,6 +58,24 @@ static uint32_t _getNumVramDevices(){
 
 #endif
 
+static bool _parseUint(nixl_b_params_t* custom_params, const std::string &key,
+                       uint64_t &out)
+{
+    if (!custom_params->count(key)) {
+        return true;
+    }
+
+    const std::string &val = (*custom_params)[key];
+    const char *cptr = val.c_str();
+    char *eptr;
+    uint64_t tmp = strtoull(cptr, &eptr, 0);
+    if (val.empty() || ((size_t)(eptr - cptr) != val.length())) {
+        return false;
+    }
+    out = tmp;
+    return true;
+}
+
 /****************************************
  * UCX/MO Request management
 *****************************************/
@@ -62,50 +83,52 @@ static uint32_t _getNumVramDevices(){
 class nixlUcxMoRequestH : public nixlBackendReqH {
 private:
 
-    class dlMatrixElem {
+    // Descriptors moved between one local and one remote engine
+    class xferGroup {
     public:
-        bool in_use, in_progress;
-        nixl_meta_dlist_t *ldescs;
-        nixl_meta_dlist_t *rdescs;
+        size_t lidx, ridx;
+        std::string rname;
+        nixl_meta_dlist_t ldescs;
+        nixl_meta_dlist_t rdescs;
         nixlBackendReqH *ucx_req;
-
-        dlMatrixElem() {
-            in_use = false;
-            in_progress = false;
-            ldescs = nullptr;
-            rdescs = nullptr;
+        bool in_progress;
+        // Thread of the group's last post
+        std::thread::id postThread;
+
+        xferGroup(size_t l, size_t r, const std::string &name,
+                  const nixl_meta_dlist_t &local,
+                  const nixl_meta_dlist_t &remote) :
+            lidx(l), ridx(r), rname(name),
+            ldescs(local.getType(), local.isSorted()),
+            rdescs(remote.getType(), remote.isSorted())
+        {
             ucx_req = nullptr;
+            in_progress = false;
         }
     };
 
-    typedef std::vector<std::vector<dlMatrixElem>> dl_matrix_t;
-
-    dl_matrix_t dlMatrix;
+    // Only the engine pairs in use, ordered by local engine: the groups of
+    // local engine l are [rowStart[l], rowStart[l + 1])
+    std::vector<xferGroup> groups;
+    std::vector<size_t> rowStart;
+    std::vector<bool> rowMask;
 
     std::string remoteAgent;
     bool notifNeed;
     std::string notifMsg;
+
+    // Descriptors after the split of the striped ones
+    size_t pieceCnt = 0;
+
+    // Thread that called the last postXfer
+    std::thread::id postThread;
 public:
-    nixlUcxMoRequestH(size_t l_eng_cnt, size_t r_eng_cnt) :
-        dlMatrix(l_eng_cnt, std::vector<dlMatrixElem>(r_eng_cnt, dlMatrixElem()))
+    nixlUcxMoRequestH(size_t l_eng_cnt) :
+        rowStart(l_eng_cnt + 1, 0), rowMask(l_eng_cnt, false)
     {
         notifNeed = false;
     }
 
-    ~nixlUcxMoRequestH()
-    {
-        for (auto &row : dlMatrix) {
-            for (auto &p : row) {
-                if (p.ldescs) {
-                    delete p.ldescs;
-                }
-                if (p.rdescs) {
-                    delete p.rdescs;
-                }
-            }
-        }
-    }
-
     friend class nixlUcxMoEngine;
 };
 
@@ -130,7 +153,7 @@ nixlUcxMoEngine::getEngCnt()
 }
 
 int32_t
-nixlUcxMoEngine::getEngIdx(nixl_mem_t type, uint64_t devId)
+nixlUcxMoEngine::getEngIdx(nixl_mem_t type, uint64_t devId, uintptr_t addr)
 {
     switch (type) {
     case VRAM_SEG:
@@ -138,8 +161,23 @@ nixlUcxMoEngine::getEngIdx(nixl_mem_t type, uint64_t devId)
         if (!(devId < _gpuCnt)) {
             return -1;
         }
-    case DRAM_SEG:
         break;
+    case DRAM_SEG: {
+        // Keep host memory on a rail local to the NUMA node of its pages
+        int node = engNuma.empty() ? -1 :
+                   nixlUcxMoTopology::getMemNumaNode((void*) addr);
+        std::vector<int32_t> local;
+
+        for (uint32_t i = 0; (node >= 0) && (i < engNuma.size()); i++) {
+            if (engNuma[i] == node) {
+                local.push_back(i);
+            }
+        }
+        if (!local.empty()) {
+            return local[devId % local.size()];
+        }
+        break;
+    }
     default:
         return -1;
     }
@@ -147,8 +185,32 @@ nixlUcxMoEngine::getEngIdx(nixl_mem_t type, uint64_t devId)
     return (devId < _engineCnt) ? devId : -1;
 }
 
+// Engines a buffer of engine eidx is striped over, besides eidx itself:
+// the ones on the same NUMA node first, then the nearest by index
+std::vector<uint32_t>
+nixlUcxMoEngine::getStripeEngs(uint32_t eidx) const
+{
+    std::vector<uint32_t> out;
+    uint32_t cnt = engines.size();
+
+    for (uint32_t d = 1; d < cnt; d++) {
+        out.push_back((eidx + d) % cnt);
+    }
+
+    if (!engNuma.empty()) {
+        std::stable_sort(out.begin(), out.end(), [&](uint32_t a, uint32_t b) {
+            return (engNuma[a] == engNuma[eidx]) && (engNuma[b] != engNuma[eidx]);
+        });
+    }
+
+    if (out.size() > stripeWidth - 1) {
+        out.resize(stripeWidth - 1);
+    }
+    return out;
+}
+
 string
-nixlUcxMoEngine::getEngName(const string &baseName, uint32_t eidx)
+nixlUcxMoEngine::getEngName(const string &baseName, uint32_t eidx) const
 {
     return baseName + ":" + to_string(eidx);
 }
@@ -187,10 +249,64 @@ nixlUcxMoEngine::nixlUcxMoEngine(const nixlBackendInitParams* init_params):
     }
 
     setEngCnt(num_ucx_engines);
+
+    uint64_t stripe_threshold = 0;
+    uint64_t stripe_width = 0;
+    if (!_parseUint(custom_params, "stripe_threshold", stripe_threshold) ||
+        !_parseUint(custom_params, "stripe_width", stripe_width)) {
+        this->initErr = true;
+        // TODO: Log error
+        return;
+    }
+    stripeThreshold = stripe_threshold;
+    stripeWidth = (stripe_width && (stripe_width < getEngCnt())) ?
+                  stripe_width : getEngCnt();
+
+    // Bind every engine to the NIC closest to its GPU, unless told otherwise
+    bool use_topology = !custom_params->count("device_list");
+    if (custom_params->count("topology")) {
+        const string &mode = (*custom_params)["topology"];
+        if (mode == "none") {
+            use_topology = false;
+        } else if (mode != "auto") {
+            this->initErr = true;
+            // TODO: Log error
+            return;
+        }
+    }
+
+    vector<size_t> eng_nics;
+    if (use_topology) {
+        topology.discover(_gpuCnt);
+        eng_nics = topology.assignNics(getEngCnt());
+        for (size_t nic : eng_nics) {
+            engNuma.push_back(topology.getNic(nic).numaNode);
+        }
+    }
+
+    if (custom_params->count("rail_threads")) {
+        const string &mode = (*custom_params)["rail_threads"];
+        if (mode == "true") {
+            railOn = true;
+        } else if (mode != "false") {
+            this->initErr = true;
+            // TODO: Log error
+            return;
+        }
+    }
+
     // Initialize required number of engines
     for (uint32_t i = 0; i < getEngCnt(); i++) {
         nixlBackendEngine *e;
-        e = (nixlBackendEngine *)new nixlUcxEngine(init_params);
+        if (eng_nics.empty()) {
+            e = (nixlBackendEngine *)new nixlUcxEngine(init_params);
+        } else {
+            nixl_b_params_t eng_params = *custom_params;
+            nixlBackendInitParams eng_init = *init_params;
+            eng_params["device_list"] = topology.getNic(eng_nics[i]).name;
+            eng_init.customParams = &eng_params;
+            e = (nixlBackendEngine *)new nixlUcxEngine(&eng_init);
+        }
         engines.push_back(e);
         if (engines[0]->getInitErr()) {
             this->initErr = true;
@@ -198,6 +314,8 @@ nixlUcxMoEngine::nixlUcxMoEngine(const nixlBackendInitParams* init_params):
             return;
         }
     }
+
+    railStart();
 }
 
 nixl_mem_list_t
@@ -208,13 +326,151 @@ nixlUcxMoEngine::getSupportedMems () const {
     return mems;
 }
 
+nixl_status_t
+nixlUcxMoEngine::getXferHints (const nixl_mem_t &local_mem,
+                               const nixl_mem_t &remote_mem,
+                               nixlBackendXferHints &hints) const
+{
+    nixl_status_t ret = engines[0]->getXferHints(local_mem, remote_mem, hints);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    // Large transfers spread over all rails, at the cost of splitting them
+    hints.bandwidthGBps *= engines.size();
+    hints.latencyUs += 2;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlUcxMoEngine::getPeerXferHints (const nixl_mem_t &local_mem,
+                                   const nixl_mem_t &remote_mem,
+                                   const string &remote_agent,
+                                   nixlBackendXferHints &hints) const
+{
+    nixl_status_t ret = engines[0]->getPeerXferHints(local_mem, remote_mem,
+                                                     getEngName(remote_agent, 0),
+                                                     hints);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    hints.bandwidthGBps *= engines.size();
+    hints.latencyUs += 2;
+    return NIXL_SUCCESS;
+}
+
 nixlUcxMoEngine::~nixlUcxMoEngine()
 {
+    railStop();
     for( auto &e : engines ) {
         delete e;
     }
 }
 
+/****************************************
+ * Rail threads
+*****************************************/
+
+void
+nixlUcxMoEngine::railStart()
+{
+    if (!railOn) {
+        return;
+    }
+
+    railMask.assign(engines.size(), false);
+    for (size_t i = 1; i < engines.size(); i++) {
+        railThreads.emplace_back(&nixlUcxMoEngine::railFunc, this, i);
+    }
+}
+
+void
+nixlUcxMoEngine::railStop()
+{
+    {
+        std::lock_guard<std::mutex> lk(railMtx);
+        railExit = true;
+    }
+    railCv.notify_all();
+
+    for (auto &t : railThreads) {
+        t.join();
+    }
+    railThreads.clear();
+}
+
+void
+nixlUcxMoEngine::railFunc(size_t idx)
+{
+    uint64_t seen = 0;
+
+    // Stay next to the NIC of this rail
+    if (idx < engNuma.size()) {
+        nixlUcxMoTopology::pinToNumaNode(engNuma[idx]);
+    }
+
+    std::unique_lock<std::mutex> lk(railMtx);
+    while (true) {
+        railCv.wait(lk, [&]() { return railExit || (railGen != seen); });
+        if (railExit) {
+            return;
+        }
+        seen = railGen;
+        if (!railMask[idx]) {
+            continue;
+        }
+
+        const std::function<void(size_t)> *job = railJob;
+        lk.unlock();
+        (*job)(idx);
+        lk.lock();
+
+        if (--railPending == 0) {
+            railDoneCv.notify_one();
+        }
+    }
+}
+
+// Runs job(i) for every engine set in mask, concurrently when rail threads
+// are on, and returns once all of them are done
+void
+nixlUcxMoEngine::railRun(const std::vector<bool> &mask,
+                         const std::function<void(size_t)> &job)
+{
+    size_t cnt = 0;
+
+    for (size_t i = 1; i < mask.size(); i++) {
+        cnt += mask[i];
+    }
+
+    if (!railOn || (cnt == 0)) {
+        for (size_t i = 0; i < mask.size(); i++) {
+            if (mask[i]) {
+                job(i);
+            }
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lk(railRunMtx);
+    {
+        std::lock_guard<std::mutex> lk(railMtx);
+        railJob = &job;
+        railMask = mask;
+        railPending = cnt;
+        railGen++;
+    }
+    railCv.notify_all();
+
+    if (mask[0]) {
+        job(0);
+    }
+
+    std::unique_lock<std::mutex> lk(railMtx);
+    railDoneCv.wait(lk, [&]() { return railPending == 0; });
+}
+
 /****************************************
  * Connection management
 *****************************************/
@@ -352,7 +608,7 @@ nixlUcxMoEngine::registerMem (const nixlBlobDesc &mem,
                               nixlBackendMD* &out)
 {
     nixlUcxMoPrivateMetadata *priv = new nixlUcxMoPrivateMetadata;
-    int32_t eidx = getEngIdx(nixl_mem, mem.devId);
+    int32_t eidx = getEngIdx(nixl_mem, mem.devId, mem.addr);
     nixlSerDes sd;
     string str;
     nixl_status_t status;
@@ -371,6 +627,33 @@ nixlUcxMoEngine::registerMem (const nixlBlobDesc &mem,
         return status;
     }
     sd.addStr("RkeyStr", str);
+
+    if (stripeThreshold && (mem.len >= stripeThreshold)) {
+        for (uint32_t sidx : getStripeEngs(eidx)) {
+            nixlBackendMD *smd;
+
+            if (NIXL_SUCCESS != engines[sidx]->registerMem(mem, nixl_mem, smd)) {
+                // Striping is best effort, the buffer is still usable
+                continue;
+            }
+            priv->stripeEidx.push_back(sidx);
+            priv->stripeMds.push_back(smd);
+        }
+    }
+
+    // Appended after the base fields, peers without striping ignore them
+    if (!priv->stripeEidx.empty()) {
+        uint32_t stripe_cnt = priv->stripeEidx.size();
+        sd.addBuf("StripeCnt", &stripe_cnt, sizeof(stripe_cnt));
+        for (uint32_t k = 0; k < stripe_cnt; k++) {
+            status = engines[priv->stripeEidx[k]]->getPublicData(priv->stripeMds[k], str);
+            if (NIXL_SUCCESS != status) {
+                return status;
+            }
+            sd.addBuf("StripeIdx", &priv->stripeEidx[k], sizeof(uint32_t));
+            sd.addStr("StripeRkey", str);
+        }
+    }
     priv->rkeyStr = sd.exportStr();
     out = (nixlBackendMD*) priv;
 
@@ -392,6 +675,9 @@ nixlUcxMoEngine::deregisterMem (nixlBackendMD* meta)
     nixlUcxMoPrivateMetadata *priv = (nixlUcxMoPrivateMetadata*) meta;
 
     engines[priv->eidx]->deregisterMem(priv->md);
+    for (size_t k = 0; k < priv->stripeEidx.size(); k++) {
+        engines[priv->stripeEidx[k]]->deregisterMem(priv->stripeMds[k]);
+    }
     delete priv;
     return NIXL_SUCCESS;
 }
@@ -448,6 +734,37 @@ nixlUcxMoEngine::internalMDHelper (const nixl_blob_t &blob,
         md->int_mds.push_back(int_md);
     }
 
+    uint32_t stripe_cnt = 0;
+    if (sd.getBufLen("StripeCnt") == sizeof(stripe_cnt)) {
+        status = sd.getBuf("StripeCnt", &stripe_cnt, sizeof(stripe_cnt));
+        if (status != NIXL_SUCCESS) {
+            return status;
+        }
+    }
+
+    for (uint32_t k = 0; k < stripe_cnt; k++) {
+        uint32_t sidx;
+
+        status = sd.getBuf("StripeIdx", &sidx, sizeof(sidx));
+        if (status != NIXL_SUCCESS) {
+            return status;
+        }
+        input_int.metaInfo = sd.getStr("StripeRkey");
+
+        md->stripeEidx.push_back(sidx);
+        md->stripeMds.emplace_back();
+        for (auto &e : engines) {
+            nixlBackendMD *int_md;
+            status = e->loadRemoteMD(input_int, nixl_mem,
+                                     getEngName(agent, sidx),
+                                     int_md);
+            if (status != NIXL_SUCCESS) {
+                return status;
+            }
+            md->stripeMds.back().push_back(int_md);
+        }
+    }
+
     output = (nixlBackendMD*)md;
     return NIXL_SUCCESS;
 }
@@ -481,6 +798,14 @@ nixlUcxMoEngine::unloadMD (nixlBackendMD* input)
             return status;
         }
     }
+    for (auto &smds : md->stripeMds) {
+        for (size_t i = 0; i < smds.size(); i++) {
+            status = engines[i]->unloadMD(smds[i]);
+            if (NIXL_SUCCESS != status) {
+                return status;
+            }
+        }
+    }
     return NIXL_SUCCESS;
 }
 
@@ -496,9 +821,6 @@ nixlUcxMoEngine::prepXfer (const nixl_xfer_op_t &operation,
                            nixlBackendReqH* &handle,
                            const nixl_opt_b_args_t *opt_args)
 {
-    size_t lidx, ridx;
-    size_t lidx_max, ridx_max;
-
     // Number of local and remote descriptors must match
     int des_cnt = local.descCount();
     if (des_cnt != remote.descCount()) {
@@ -521,16 +843,21 @@ nixlUcxMoEngine::prepXfer (const nixl_xfer_op_t &operation,
     }
     nixlUcxMoConnection &conn = it->second;
 
-    /* Allocate request and fill communication distribution matrix */
+    /* Split the descriptors by the pair of engines they go through */
     size_t l_eng_cnt = engines.size();
     size_t r_eng_cnt = conn.num_engines;
+    std::vector<size_t> cell_group(l_eng_cnt * r_eng_cnt, SIZE_MAX);
 
-    nixlUcxMoRequestH *req = new nixlUcxMoRequestH(l_eng_cnt, r_eng_cnt);
+    class xferPiece {
+    public:
+        size_t cell;
+        nixlMetaDesc ldesc;
+        nixlMetaDesc rdesc;
+    };
+    std::vector<xferPiece> pieces;
+    pieces.reserve(des_cnt);
 
-    /* Go over all input */
     for(int i = 0; i < des_cnt; i++) {
-        size_t lsize = local[i].len;
-        size_t rsize = remote[i].len;
         nixlUcxMoPrivateMetadata *lmd;
         lmd = (nixlUcxMoPrivateMetadata *)local[i].metadataP;
         nixlUcxMoPublicMetadata *rmd;
@@ -540,81 +867,99 @@ nixlUcxMoEngine::prepXfer (const nixl_xfer_op_t &operation,
 
         if (!((lidx < l_eng_cnt) && (ridx < r_eng_cnt))) {
             // TODO: err output
-            goto err_clean_req;
+            return NIXL_ERR_INVALID_PARAM;
         }
-        if (lsize != rsize) {
+        if (local[i].len != remote[i].len) {
             // TODO: err output
-            goto err_clean_req;
+            return NIXL_ERR_INVALID_PARAM;
         }
 
-        /* Allocate internal dlists if needed */
-        if (!req->dlMatrix[lidx][ridx].in_use) {
-            req->dlMatrix[lidx][ridx].in_use = true;
-            req->dlMatrix[lidx][ridx].ldescs = new nixl_meta_dlist_t (
-                                                local.getType(),
-                                                local.isSorted());
-
-            req->dlMatrix[lidx][ridx].rdescs = new nixl_meta_dlist_t (
-                                                remote.getType(),
-                                                remote.isSorted());
+        // Large descriptors registered on several engines on both sides
+        // are split in one chunk per engine pair
+        size_t width = 1;
+        if (stripeThreshold && (local[i].len >= stripeThreshold)) {
+            width = 1 + std::min(lmd->stripeEidx.size(), rmd->stripeEidx.size());
         }
+        size_t chunk = (local[i].len + width - 1) / width;
 
-        nixlMetaDesc ldesc = local[i];
-        ldesc.metadataP = lmd->md;
-        req->dlMatrix[lidx][ridx].ldescs->addDesc(ldesc);
+        for (size_t k = 0; (k < width) && (k * chunk < local[i].len); k++) {
+            xferPiece piece;
+            size_t offset = k * chunk;
+            size_t l = k ? lmd->stripeEidx[k - 1] : lidx;
+            size_t r = k ? rmd->stripeEidx[k - 1] : ridx;
 
-        nixlMetaDesc rdesc = remote[i];
-        rdesc.metadataP = rmd->int_mds[lidx];
-        req->dlMatrix[lidx][ridx].rdescs->addDesc(rdesc);
+            if (!((l < l_eng_cnt) && (r < r_eng_cnt))) {
+                // TODO: err output
+                return NIXL_ERR_INVALID_PARAM;
+            }
+
+            piece.cell = l * r_eng_cnt + r;
+            piece.ldesc = local[i];
+            piece.ldesc.addr += offset;
+            piece.ldesc.len = std::min(chunk, local[i].len - offset);
+            piece.ldesc.metadataP = k ? lmd->stripeMds[k - 1] : lmd->md;
+            piece.rdesc = remote[i];
+            piece.rdesc.addr += offset;
+            piece.rdesc.len = piece.ldesc.len;
+            piece.rdesc.metadataP = k ? rmd->stripeMds[k - 1][l] : rmd->int_mds[l];
+
+            cell_group[piece.cell] = 0;
+            pieces.push_back(piece);
+        }
     }
 
-    // Prepare UCX requests!
-    for(lidx = 0; lidx < req->dlMatrix.size(); lidx++) {
-        for(ridx = 0; ridx < req->dlMatrix[lidx].size(); ridx++) {
-            nixl_status_t ret;
+    nixlUcxMoRequestH *req = new nixlUcxMoRequestH(l_eng_cnt);
+    size_t group_cnt = 0;
 
-            if (!req->dlMatrix[lidx][ridx].in_use) {
-                // Skip unused matrix elements
+    for (size_t cell = 0; cell < cell_group.size(); cell++) {
+        group_cnt += (cell_group[cell] != SIZE_MAX);
+    }
+    // Groups are not movable, keep them in place
+    req->groups.reserve(group_cnt);
+
+    for (size_t lidx = 0; lidx < l_eng_cnt; lidx++) {
+        req->rowStart[lidx] = req->groups.size();
+        for (size_t ridx = 0; ridx < r_eng_cnt; ridx++) {
+            size_t cell = lidx * r_eng_cnt + ridx;
+            if (cell_group[cell] == SIZE_MAX) {
                 continue;
             }
-            ret = engines[lidx]->prepXfer(operation,
-                                          *req->dlMatrix[lidx][ridx].ldescs,
-                                          *req->dlMatrix[lidx][ridx].rdescs,
-                                          getEngName(remote_agent, ridx),
-                                          req->dlMatrix[lidx][ridx].ucx_req);
-            if (NIXL_SUCCESS != ret) {
-                goto err_clean_sub_req;
-            }
+            cell_group[cell] = req->groups.size();
+            req->groups.emplace_back(lidx, ridx, getEngName(remote_agent, ridx),
+                                     local, remote);
+            req->rowMask[lidx] = true;
         }
     }
+    req->rowStart[l_eng_cnt] = req->groups.size();
+    req->pieceCnt = pieces.size();
 
-    handle = req;
+    for (auto &piece : pieces) {
+        nixlUcxMoRequestH::xferGroup &group = req->groups[cell_group[piece.cell]];
 
-    return NIXL_SUCCESS;
-
-err_clean_sub_req:
-    /* Release only allocated requests */
-    lidx_max = lidx + 1;
-    ridx_max = ridx;
-    for(lidx = 0; lidx < lidx_max; lidx++) {
-        for(ridx = 0; ridx < ridx_max; ridx++) {
-            nixl_status_t ret;
+        group.ldescs.addDesc(piece.ldesc);
+        group.rdescs.addDesc(piece.rdesc);
+    }
 
-            if (!req->dlMatrix[lidx][ridx].in_use) {
-                // Skip unused matrix elements
-                continue;
-            }
+    // Prepare UCX requests once, reposting the handle reuses them
+    for (size_t g = 0; g < req->groups.size(); g++) {
+        nixlUcxMoRequestH::xferGroup &group = req->groups[g];
+        nixl_status_t ret;
 
-            engines[lidx]->releaseReqH(req->dlMatrix[lidx][ridx].ucx_req);
-            if (NIXL_SUCCESS != ret) {
-                // TODO: Output error, but still continue trying to fix others
+        ret = engines[group.lidx]->prepXfer(operation, group.ldescs, group.rdescs,
+                                            group.rname, group.ucx_req);
+        if (NIXL_SUCCESS != ret) {
+            /* Release only allocated requests */
+            for (size_t j = 0; j < g; j++) {
+                engines[req->groups[j].lidx]->releaseReqH(req->groups[j].ucx_req);
             }
+            delete req;
+            return ret;
         }
     }
 
-err_clean_req:
-    delete req;
-    return NIXL_ERR_INVALID_PARAM;
+    handle = req;
+
+    return NIXL_SUCCESS;
 }
 
 
@@ -629,51 +974,59 @@ nixlUcxMoEngine::postXfer (const nixl_xfer_op_t &operation,
 {
     nixlUcxMoRequestH *req = (nixlUcxMoRequestH *)handle;
     bool in_progress = false;
+    std::vector<nixl_status_t> rets(req->rowMask.size(), NIXL_SUCCESS);
 
-    for(size_t lidx = 0; lidx < req->dlMatrix.size(); lidx++) {
-        for(size_t ridx = 0; ridx < req->dlMatrix[lidx].size(); ridx++) {
-            nixl_status_t ret;
+    // Only the priority is passed down, notifications are sent by this engine
+    nixl_opt_b_args_t eng_args;
+    if (opt_args)
+        eng_args.priority = opt_args->priority;
 
-            if (!req->dlMatrix[lidx][ridx].in_use) {
-                // Skip unused matrix elements
-                continue;
-            }
+    req->postThread = std::this_thread::get_id();
 
-            ret = engines[lidx]->postXfer(operation,
-                                          *req->dlMatrix[lidx][ridx].ldescs,
-                                          *req->dlMatrix[lidx][ridx].rdescs,
-                                          getEngName(remote_agent, ridx),
-                                          req->dlMatrix[lidx][ridx].ucx_req);
+    // Each local engine posts its groups, engines go to the rails in parallel
+    railRun(req->rowMask, [&](size_t lidx) {
+        for (size_t g = req->rowStart[lidx]; g < req->rowStart[lidx + 1]; g++) {
+            nixlUcxMoRequestH::xferGroup &group = req->groups[g];
+            nixl_status_t ret;
+
+            group.postThread = std::this_thread::get_id();
+            ret = engines[lidx]->postXfer(operation, group.ldescs, group.rdescs,
+                                          group.rname, group.ucx_req, &eng_args);
 
             /* if transfer wasn't immediately completed */
             switch(ret) {
             case NIXL_IN_PROG:
-                req->dlMatrix[lidx][ridx].in_progress = true;
-                in_progress = true;
+                group.in_progress = true;
+                rets[lidx] = NIXL_IN_PROG;
             case NIXL_SUCCESS:
                 // Nothing to do
                 break;
             default:
                 // Error.
-                return ret;
+                rets[lidx] = ret;
+                return;
             }
         }
+    });
+
+    for (nixl_status_t ret : rets) {
+        if (NIXL_IN_PROG == ret) {
+            in_progress = true;
+        } else if (NIXL_SUCCESS != ret) {
+            return ret;
+        }
     }
 
-    if (opt_args->hasNotif) {
+    req->notifNeed = false;
+    if (opt_args && opt_args->hasNotif) {
         // The transfers are performed via parallel UCX workers (read QPs)
         // This doesn't allows piggybacking the notification command in postXfer
         // as we need to chose one of the workers to send it,
         // but we can only be sent after all workers are flushed.
         // Instead, we will initiate Notification from the CheckXfer
-
-        if (!in_progress) {
-
-        } else {
-            req->notifNeed = true;
-            req->notifMsg = opt_args->notifMsg;
-            req->remoteAgent = remote_agent;
-        }
+        req->notifNeed = true;
+        req->notifMsg = opt_args->notifMsg;
+        req->remoteAgent = remote_agent;
     }
 
     if (in_progress) {
@@ -682,6 +1035,7 @@ nixlUcxMoEngine::postXfer (const nixl_xfer_op_t &operation,
         if(req->notifNeed) {
             nixl_status_t ret;
 
+            req->notifNeed = false;
             ret = engines[0]->genNotif(getEngName(req->remoteAgent, 0), req->notifMsg);
             if (NIXL_SUCCESS != ret) {
                 /* Return error, TODO: add output */
@@ -697,30 +1051,47 @@ nixlUcxMoEngine::checkXfer (nixlBackendReqH *handle)
 {
     nixlUcxMoRequestH *req = (nixlUcxMoRequestH *)handle;
     nixl_status_t out_ret = NIXL_SUCCESS;
+    std::vector<bool> mask(req->rowMask.size(), false);
+    std::vector<nixl_status_t> rets(req->rowMask.size(), NIXL_SUCCESS);
 
-    for(size_t lidx = 0; lidx < req->dlMatrix.size(); lidx++) {
-        for(size_t ridx = 0; ridx < req->dlMatrix[lidx].size(); ridx++) {
+    for (auto &group : req->groups) {
+        mask[group.lidx] = mask[group.lidx] || group.in_progress;
+    }
+
+    railRun(mask, [&](size_t lidx) {
+        for (size_t g = req->rowStart[lidx]; g < req->rowStart[lidx + 1]; g++) {
+            nixlUcxMoRequestH::xferGroup &group = req->groups[g];
             nixl_status_t ret;
 
-            if (!req->dlMatrix[lidx][ridx].in_progress) {
-                // Skip not-in-progress matrix elements
+            if (!group.in_progress) {
+                // Skip completed groups
                 continue;
             }
 
-            ret = engines[lidx]->checkXfer(req->dlMatrix[lidx][ridx].ucx_req);
+            ret = engines[lidx]->checkXfer(group.ucx_req);
             switch (ret) {
             case NIXL_SUCCESS:
                 /* Mark as completed */
-                req->dlMatrix[lidx][ridx].in_progress = false;
+                group.in_progress = false;
                 break;
             case NIXL_IN_PROG:
-                out_ret = NIXL_IN_PROG;
+                rets[lidx] = NIXL_IN_PROG;
                 break;
             default:
                 /* Any other ret value is unexpected */
-                return ret;
+                rets[lidx] = ret;
+                return;
             }
         }
+    });
+
+    for (nixl_status_t ret : rets) {
+        if ((NIXL_SUCCESS != ret) && (NIXL_IN_PROG != ret)) {
+            return ret;
+        }
+        if (NIXL_IN_PROG == ret) {
+            out_ret = NIXL_IN_PROG;
+        }
     }
 
     if ((NIXL_SUCCESS == out_ret) && req->notifNeed) {
@@ -728,6 +1099,7 @@ nixlUcxMoEngine::checkXfer (nixlBackendReqH *handle)
 
         // Now as all UCX backends (workers) have been flushed,
         // it is safe to send Notification
+        req->notifNeed = false;
         ret = engines[0]->genNotif(getEngName(req->remoteAgent, 0), req->notifMsg);
         if (NIXL_SUCCESS != ret) {
             /* Return error, TODO: add output */
@@ -744,34 +1116,56 @@ nixlUcxMoEngine::releaseReqH(nixlBackendReqH* handle)
     nixlUcxMoRequestH *req = (nixlUcxMoRequestH *)handle;
     nixl_status_t out_ret = NIXL_SUCCESS;
 
-    for(size_t lidx = 0; lidx < req->dlMatrix.size(); lidx++) {
-        for(size_t ridx = 0; ridx < req->dlMatrix[lidx].size(); ridx++) {
-            nixl_status_t ret;
-
-            if (!req->dlMatrix[lidx][ridx].in_use) {
-                // Skip unused matrix elements
-                continue;
-            }
+    for (auto &group : req->groups) {
+        nixl_status_t ret;
 
-            ret = engines[lidx]->releaseReqH(req->dlMatrix[lidx][ridx].ucx_req);
-            if (NIXL_SUCCESS != ret) {
-                // TODO: Output error, but still continue trying to fix others
-                out_ret = ret;
-            }
+        ret = engines[group.lidx]->releaseReqH(group.ucx_req);
+        if (NIXL_SUCCESS != ret) {
+            // TODO: Output error, but still continue trying to fix others
+            out_ret = ret;
         }
     }
+    delete req;
 
     return out_ret;
 }
 
+// The local and remote engine of each group, as l:r pairs, the descriptors
+// once the striped ones are split, and of the last post how many rail
+// threads, other than the caller, posted groups
+nixl_status_t
+nixlUcxMoEngine::getXferStats(const nixlBackendReqH* handle,
+                              nixl_b_params_t &stats) const
+{
+    const nixlUcxMoRequestH *req = (const nixlUcxMoRequestH *) handle;
+    std::set<std::thread::id> rails;
+    std::string groups;
+
+    for (auto &group : req->groups) {
+        if (!groups.empty()) {
+            groups += ",";
+        }
+        groups += to_string(group.lidx) + ":" + to_string(group.ridx);
+        if (group.postThread != req->postThread) {
+            rails.insert(group.postThread);
+        }
+    }
+
+    stats["groups"] = groups;
+    stats["pieces"] = to_string(req->pieceCnt);
+    stats["rail_threads"] = to_string(rails.size());
+    return NIXL_SUCCESS;
+}
+
 int
 nixlUcxMoEngine::progress()
 {
-    int ret = 0;
-    // Iterate over all elements cancelling each one
-    for ( auto &e : engines ) {
-        ret += e->progress();
-    }
+    std::vector<bool> mask(engines.size(), true);
+    std::atomic<int> ret{0};
+
+    railRun(mask, [&](size_t eidx) {
+        ret += engines[eidx]->progress();
+    });
     return ret;
 }
 
@@ -781,6 +1175,12 @@ nixlUcxMoEngine::getNotifs(notif_list_t &notif_list)
     return engines[0]->getNotifs(notif_list);
 }
 
+nixl_status_t
+nixlUcxMoEngine::appendNotifs(nixl_notif_list_t &notif_list)
+{
+    return engines[0]->appendNotifs(notif_list);
+}
+
 nixl_status_t
 nixlUcxMoEngine::genNotif(const string &remote_agent, const string &msg)
 {
@@ -22,10 +22,13 @@
 #include <iostream>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <cassert>
 
 #include "nixl.h"
 #include "ucx_backend.h"
+#include "ucx_mo_topology.h"
 
 // Local includes
 #include <common/nixl_time.h>
@@ -49,6 +52,9 @@ class nixlUcxMoPrivateMetadata : public nixlBackendMD
 private:
     uint32_t eidx;
     nixlBackendMD *md;
+    // Large buffers are also registered on the engines they are striped over
+    std::vector<uint32_t> stripeEidx;
+    std::vector<nixlBackendMD*> stripeMds;
     nixl_mem_t  memType;
     nixl_blob_t rkeyStr;
 public:
@@ -71,6 +77,9 @@ class nixlUcxMoPublicMetadata : public nixlBackendMD
     uint32_t eidx;
     nixlUcxMoConnection conn;
     std::vector<nixlBackendMD*> int_mds;
+    // Remote stripe engines, and their metadata as loaded on each local engine
+    std::vector<uint32_t> stripeEidx;
+    std::vector<std::vector<nixlBackendMD*>> stripeMds;
 
 public:
     nixlUcxMoPublicMetadata() : nixlBackendMD(false) {}
@@ -89,11 +98,41 @@ private:
     uint32_t _gpuCnt;
     int setEngCnt(uint32_t host_engines);
     uint32_t getEngCnt();
-    int32_t getEngIdx(nixl_mem_t type, uint64_t devId);
-    std::string getEngName(const std::string &baseName, uint32_t eidx);
+    int32_t getEngIdx(nixl_mem_t type, uint64_t devId, uintptr_t addr = 0);
+    std::string getEngName(const std::string &baseName, uint32_t eidx) const;
     std::string getEngBase(const std::string &engName);
     bool pthrOn;
 
+    // NIC each engine is bound to and its NUMA node, empty if unknown
+    nixlUcxMoTopology topology;
+    std::vector<int> engNuma;
+
+    // Rail threads: one per engine past the first (the caller takes engine 0),
+    // posts, checks and progress of the engines run on them concurrently
+    bool railOn = false;
+    std::vector<std::thread> railThreads;
+    std::mutex railRunMtx;
+    std::mutex railMtx;
+    std::condition_variable railCv;
+    std::condition_variable railDoneCv;
+    const std::function<void(size_t)> *railJob = nullptr;
+    std::vector<bool> railMask;
+    uint64_t railGen = 0;
+    size_t railPending = 0;
+    bool railExit = false;
+
+    void railStart();
+    void railStop();
+    void railFunc(size_t idx);
+    void railRun(const std::vector<bool> &mask,
+                 const std::function<void(size_t)> &job);
+
+    // Descriptors of stripeThreshold bytes or more are split over up to
+    // stripeWidth engines, 0 threshold disables striping
+    size_t stripeThreshold = 0;
+    uint32_t stripeWidth = 0;
+    std::vector<uint32_t> getStripeEngs(uint32_t eidx) const;
+
     // UCX backends data
     std::vector<nixlBackendEngine*> engines;
     // Map of agent name to saved nixlUcxConnection info
@@ -117,6 +156,13 @@ public:
     bool supportsProgTh () const { return pthrOn; }
 
     nixl_mem_list_t getSupportedMems () const;
+    nixl_status_t getXferHints (const nixl_mem_t &local_mem,
+                                const nixl_mem_t &remote_mem,
+                                nixlBackendXferHints &hints) const;
+    nixl_status_t getPeerXferHints (const nixl_mem_t &local_mem,
+                                    const nixl_mem_t &remote_mem,
+                                    const std::string &remote_agent,
+                                    nixlBackendXferHints &hints) const;
 
     /* Object management */
     nixl_status_t getPublicData (const nixlBackendMD* meta,
@@ -158,10 +204,13 @@ public:
                             const nixl_opt_b_args_t* opt_args=nullptr);
     nixl_status_t checkXfer (nixlBackendReqH* handle);
     nixl_status_t releaseReqH(nixlBackendReqH* handle);
+    nixl_status_t getXferStats(const nixlBackendReqH* handle,
+                               nixl_b_params_t &stats) const;
 
     int progress();
 
     nixl_status_t getNotifs(notif_list_t &notif_list);
+    nixl_status_t appendNotifs(nixl_notif_list_t &notif_list);
     nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg);
 
     //public function for UCX worker to mark connections as connected
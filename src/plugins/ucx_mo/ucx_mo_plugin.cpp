@@ -42,6 +42,12 @@
      nixl_b_params_t params;
      params["ucx_devices"] = "";
      params["num_ucx_engines"] = "8";
+     params["topology"] = "auto";
+     params["rail_threads"] = "false";
+     params["stripe_threshold"] = "0";
+     params["stripe_width"] = "0";
+     params["progress_cpus"] = "";
+     params["priority_lanes"] = "off";
      return params;
  }
  // Static plugin structure
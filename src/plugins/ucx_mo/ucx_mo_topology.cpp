@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "ucx_mo_topology.h"
+#include "common/cpu_affinity.h"
+
+#ifdef HAVE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+// From linux/mempolicy.h, to not depend on libnuma
+#define UCX_MO_MPOL_F_NODE (1 << 0)
+#define UCX_MO_MPOL_F_ADDR (1 << 1)
+
+static std::string resolvePath(const std::string &path)
+{
+    char buf[PATH_MAX];
+
+    if (!realpath(path.c_str(), buf)) {
+        return std::string();
+    }
+    return std::string(buf);
+}
+
+// Number of leading path components in common, i.e. shared PCIe bridges
+static size_t commonDepth(const std::string &a, const std::string &b)
+{
+    size_t depth = 0;
+    size_t i = 0;
+
+    while ((i < a.size()) && (i < b.size()) && (a[i] == b[i])) {
+        if (a[i] == '/') {
+            depth++;
+        }
+        i++;
+    }
+    return depth;
+}
+
+void nixlUcxMoTopology::discover(uint32_t gpu_cnt)
+{
+    const std::string ib_path = "/sys/class/infiniband";
+    DIR *dir = opendir(ib_path.c_str());
+
+    nics.clear();
+    gpus.clear();
+
+    if (dir) {
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != nullptr) {
+            if (ent->d_name[0] == '.') {
+                continue;
+            }
+            device nic;
+            std::string dev_path = ib_path + "/" + ent->d_name + "/device";
+            nic.name = ent->d_name;
+            nic.numaNode = nixlDevNumaNode(dev_path);
+            nic.pciPath = resolvePath(dev_path);
+            nics.push_back(nic);
+        }
+        closedir(dir);
+    }
+
+    // Same order on every run
+    std::sort(nics.begin(), nics.end(),
+              [](const device &a, const device &b) { return a.name < b.name; });
+
+#ifdef HAVE_CUDA
+    for (uint32_t i = 0; i < gpu_cnt; i++) {
+        char bus_id[32];
+        device gpu;
+
+        if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), i) == cudaSuccess) {
+            std::string bdf(bus_id);
+            std::transform(bdf.begin(), bdf.end(), bdf.begin(), ::tolower);
+            std::string dev_path = "/sys/bus/pci/devices/" + bdf;
+            gpu.name = bdf;
+            gpu.numaNode = nixlDevNumaNode(dev_path);
+            gpu.pciPath = resolvePath(dev_path);
+        }
+        gpus.push_back(gpu);
+    }
+#else
+    (void) gpu_cnt;
+#endif
+}
+
+std::vector<size_t> nixlUcxMoTopology::assignNics(uint32_t eng_cnt) const
+{
+    std::vector<size_t> out;
+    std::vector<size_t> uses(nics.size(), 0);
+
+    if (nics.empty()) {
+        return out;
+    }
+
+    for (uint32_t i = 0; i < eng_cnt; i++) {
+        size_t best = 0;
+        long best_score = LONG_MIN;
+
+        for (size_t n = 0; n < nics.size(); n++) {
+            long score = 0;
+
+            // Closest NIC to the GPU first, least used to break ties
+            if (i < gpus.size()) {
+                score += 1000 * commonDepth(gpus[i].pciPath, nics[n].pciPath);
+                if ((gpus[i].numaNode >= 0) && (gpus[i].numaNode == nics[n].numaNode)) {
+                    score += 100000;
+                }
+            }
+            score -= uses[n];
+
+            if (score > best_score) {
+                best_score = score;
+                best = n;
+            }
+        }
+
+        uses[best]++;
+        out.push_back(best);
+    }
+    return out;
+}
+
+int nixlUcxMoTopology::getMemNumaNode(const void *addr)
+{
+    int node = -1;
+
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, addr,
+                UCX_MO_MPOL_F_NODE | UCX_MO_MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+bool nixlUcxMoTopology::pinToNumaNode(int node)
+{
+    if (node < 0) {
+        return false;
+    }
+    return nixlPinThread(pthread_self(), "numa:" + std::to_string(node));
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __UCX_MO_TOPOLOGY_H
+#define __UCX_MO_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// PCIe/NUMA placement of the node's RDMA NICs and GPUs, read from sysfs
+class nixlUcxMoTopology {
+    public:
+        class device {
+            public:
+                std::string name;
+                int numaNode = -1;
+                // Resolved sysfs path, the PCIe switches above it come first
+                std::string pciPath;
+        };
+
+    private:
+        std::vector<device> nics;
+        std::vector<device> gpus;
+
+    public:
+        void discover(uint32_t gpu_cnt);
+
+        bool empty() const { return nics.empty(); }
+        const device &getNic(size_t idx) const { return nics[idx]; }
+
+        // NIC of each engine, engines below the GPU count get the one closest
+        // to their GPU, the rest are spread over the NICs
+        std::vector<size_t> assignNics(uint32_t eng_cnt) const;
+
+        // NUMA node the page of addr is on, -1 if unknown
+        static int getMemNumaNode(const void *addr);
+
+        // Restricts the calling thread to the CPUs of a NUMA node
+        static bool pinToNumaNode(int node);
+};
+
+#endif
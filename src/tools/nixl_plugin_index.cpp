@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "nixl.h"
+#include "plugin_manager.h"
+
+// Writes the index file of plugin directories, so that agents find the plugins
+// with their version and memory types without loading each of them at startup.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <plugin_directory>..." << std::endl;
+        return 1;
+    }
+
+    auto& plugin_manager = nixlPluginManager::getInstance();
+    int   ret = 0;
+
+    for (int i = 1; i < argc; i++) {
+        nixl_status_t status = plugin_manager.writePluginIndex(argv[i]);
+        if (status != NIXL_SUCCESS) {
+            std::cerr << "Failed to index " << argv[i] << ": "
+                      << nixlEnumStrings::statusStr(status) << std::endl;
+            ret = 1;
+        } else {
+            std::cout << "Indexed " << argv[i] << std::endl;
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __CPU_AFFINITY_H
+#define __CPU_AFFINITY_H
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <pthread.h>
+#include <sched.h>
+
+// Parses a CPU list as in sysfs, a comma separated list of CPUs and ranges,
+// e.g. "0-15,32-47". Returns whether any CPU was set.
+inline bool nixlParseCpuList(const std::string &list, cpu_set_t &set) {
+    std::stringstream ss(list);
+    std::string range;
+
+    CPU_ZERO(&set);
+    while (std::getline(ss, range, ',')) {
+        int first, last;
+        int n = sscanf(range.c_str(), "%d-%d", &first, &last);
+
+        if ((n < 1) || (first < 0)) {
+            continue;
+        }
+        if (n == 1) {
+            last = first;
+        }
+        for (int cpu = first; (cpu <= last) && (cpu < CPU_SETSIZE); cpu++) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0;
+}
+
+// CPU list of a NUMA node, empty if unknown
+inline std::string nixlNumaCpuList(int node) {
+    std::string list;
+
+    if (node < 0) {
+        return list;
+    }
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::getline(file, list);
+    return list;
+}
+
+// NUMA node of a device from its sysfs path, e.g. /sys/class/infiniband/mlx5_0/device.
+// Returns -1 if unknown.
+inline int nixlDevNumaNode(const std::string &dev_path) {
+    std::ifstream file(dev_path + "/numa_node");
+    int node = -1;
+
+    if (!(file >> node)) {
+        return -1;
+    }
+    return node;
+}
+
+// Pins a thread to the CPUs of spec, a CPU list or "numa:<node>" for the CPUs
+// of a NUMA node. An empty spec leaves the thread unpinned and succeeds.
+inline bool nixlPinThread(pthread_t thread, const std::string &spec) {
+    const std::string numa_prefix = "numa:";
+    std::string list = spec;
+    cpu_set_t   set;
+
+    if (spec.empty()) {
+        return true;
+    }
+    if (spec.compare(0, numa_prefix.size(), numa_prefix) == 0) {
+        int node = -1;
+
+        if (sscanf(spec.c_str() + numa_prefix.size(), "%d", &node) != 1) {
+            return false;
+        }
+        list = nixlNumaCpuList(node);
+    }
+    if (!nixlParseCpuList(list, set)) {
+        return false;
+    }
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_TRACE_H
+#define _NIXL_TRACE_H
+
+/*-----------------------------------------------------------------------------*
+ * Trace spans on the hot paths, built in with the trace meson option
+ *-----------------------------------------------------------------------------*
+ * A span covers the rest of the enclosing scope, and spans of a thread nest.
+ * With NVTX they are ranges of the NIXL domain in Nsight Systems, to line up
+ * the phases of transfers with the CUDA work around them. Otherwise they
+ * compile to nothing.
+ * Usage: NIXL_TRACE_SPAN("postXferReq");
+ */
+
+#ifdef NIXL_TRACE_NVTX
+
+#include <nvtx3/nvToolsExt.h>
+
+namespace nixlTrace {
+
+    inline nvtxDomainHandle_t getDomain() {
+        static nvtxDomainHandle_t domain = nvtxDomainCreateA("NIXL");
+        return domain;
+    }
+
+    // Names are registered once per span site, so a span doesn't copy its name
+    class span {
+        public:
+            explicit span(const nvtxStringHandle_t &name) {
+                nvtxEventAttributes_t attr = {};
+                attr.version            = NVTX_VERSION;
+                attr.size               = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+                attr.messageType        = NVTX_MESSAGE_TYPE_REGISTERED;
+                attr.message.registered = name;
+                nvtxDomainRangePushEx(getDomain(), &attr);
+            }
+
+            ~span() { nvtxDomainRangePop(getDomain()); }
+
+            span(const span &) = delete;
+            span &operator=(const span &) = delete;
+    };
+
+}
+
+#define NIXL_TRACE_CONCAT_(a, b) a##b
+#define NIXL_TRACE_CONCAT(a, b) NIXL_TRACE_CONCAT_(a, b)
+
+#define NIXL_TRACE_SPAN(name)                                                   \
+    static const nvtxStringHandle_t NIXL_TRACE_CONCAT(nixl_trace_name_, __LINE__) = \
+        nvtxDomainRegisterStringA(nixlTrace::getDomain(), name);                \
+    nixlTrace::span NIXL_TRACE_CONCAT(nixl_trace_span_, __LINE__)(              \
+        NIXL_TRACE_CONCAT(nixl_trace_name_, __LINE__))
+
+#else
+
+#define NIXL_TRACE_SPAN(name) do { } while (0)
+
+#endif
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_RING_H
+#define _NIXL_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/* Bounded lock-free queue, any number of producers and consumers.
+ * Each slot carries a sequence number telling whether it is free for the
+ * push of a given round or holds the value for the pop of that round, so
+ * neither side ever waits for the other. The capacity is rounded up to a
+ * power of 2. */
+template <typename T>
+class nixlRing {
+private:
+    struct slot {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<slot[]> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+
+public:
+    nixlRing(size_t capacity)
+    {
+        size_t size = 2;
+
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        slots.reset(new slot[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    nixlRing(const nixlRing&) = delete;
+    nixlRing& operator=(const nixlRing&) = delete;
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+    /* Returns false if the ring is full, value is left untouched then */
+    bool push(T &value)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            slot &s = slots[pos & mask];
+            size_t seq = s.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+                    s.value = std::move(value);
+                    s.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /* Returns false if the ring is empty */
+    bool pop(T &value)
+    {
+        size_t pos = head.load(std::memory_order_relaxed);
+
+        while (true) {
+            slot &s = slots[pos & mask];
+            size_t seq = s.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+                    value = std::move(s.value);
+                    s.seq.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+#endif
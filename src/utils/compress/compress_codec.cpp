@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "compress/compress_codec.h"
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_LZ4
+class nixlLz4Codec : public nixlCompressCodec {
+    private:
+        int acceleration;
+
+    public:
+        nixlLz4Codec(int level) : acceleration(level > 0 ? level : 1) { }
+
+        uint8_t getId() const { return NIXL_CODEC_LZ4; }
+
+        size_t getMaxRatio() const { return 255; }
+
+        size_t getBound(size_t len) const {
+            return (len > LZ4_MAX_INPUT_SIZE) ? 0 : LZ4_compressBound(len);
+        }
+
+        size_t compress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            if ((len > LZ4_MAX_INPUT_SIZE) || (dst_len > INT32_MAX))
+                return 0;
+            int ret = LZ4_compress_fast(src, dst, len, dst_len, acceleration);
+            return (ret > 0) ? ret : 0;
+        }
+
+        bool decompress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            if ((len > INT32_MAX) || (dst_len > INT32_MAX))
+                return false;
+            return LZ4_decompress_safe(src, dst, len, dst_len) == (int) dst_len;
+        }
+};
+#endif
+
+#ifdef HAVE_ZSTD
+class nixlZstdCodec : public nixlCompressCodec {
+    private:
+        int level;
+
+    public:
+        nixlZstdCodec(int lvl) : level(lvl > 0 ? lvl : 1) { }
+
+        uint8_t getId() const { return NIXL_CODEC_ZSTD; }
+
+        // RLE blocks, 4 bytes for up to 128KB
+        size_t getMaxRatio() const { return 32768; }
+
+        size_t getBound(size_t len) const {
+            return ZSTD_compressBound(len);
+        }
+
+        size_t compress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            size_t ret = ZSTD_compress(dst, dst_len, src, len, level);
+            return ZSTD_isError(ret) ? 0 : ret;
+        }
+
+        bool decompress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            size_t ret = ZSTD_decompress(dst, dst_len, src, len);
+            return !ZSTD_isError(ret) && (ret == dst_len);
+        }
+};
+#endif
+
+#ifdef HAVE_ZLIB
+class nixlDeflateCodec : public nixlCompressCodec {
+    private:
+        int level;
+
+    public:
+        nixlDeflateCodec(int lvl) : level(lvl > 0 ? lvl : 1) { }
+
+        uint8_t getId() const { return NIXL_CODEC_DEFLATE; }
+
+        size_t getMaxRatio() const { return 1032; }
+
+        size_t getBound(size_t len) const {
+            return compressBound(len);
+        }
+
+        size_t compress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            uLongf out_len = dst_len;
+            if (compress2((Bytef*) dst, &out_len, (const Bytef*) src, len, level) != Z_OK)
+                return 0;
+            return out_len;
+        }
+
+        bool decompress(const char *src, size_t len, char *dst, size_t dst_len) const {
+            uLongf out_len = dst_len;
+            if (uncompress((Bytef*) dst, &out_len, (const Bytef*) src, len) != Z_OK)
+                return false;
+            return out_len == dst_len;
+        }
+};
+#endif
+
+std::unique_ptr<nixlCompressCodec> nixlCompressCodecCreate(const std::string &name,
+                                                           int level)
+{
+#ifdef HAVE_LZ4
+    if (name == "lz4")
+        return std::unique_ptr<nixlCompressCodec>(new nixlLz4Codec(level));
+#endif
+#ifdef HAVE_ZSTD
+    if (name == "zstd")
+        return std::unique_ptr<nixlCompressCodec>(new nixlZstdCodec(level));
+#endif
+#ifdef HAVE_ZLIB
+    if (name == "deflate")
+        return std::unique_ptr<nixlCompressCodec>(new nixlDeflateCodec(level));
+#endif
+    (void) level;
+    return nullptr;
+}
+
+std::unique_ptr<nixlCompressCodec> nixlCompressCodecCreate(uint8_t id)
+{
+    switch (id) {
+        case NIXL_CODEC_LZ4:
+            return nixlCompressCodecCreate("lz4", 0);
+        case NIXL_CODEC_ZSTD:
+            return nixlCompressCodecCreate("zstd", 0);
+        case NIXL_CODEC_DEFLATE:
+            return nixlCompressCodecCreate("deflate", 0);
+        default:
+            return nullptr;
+    }
+}
+
+std::string nixlCompressCodecDefault()
+{
+#if defined(HAVE_LZ4)
+    return "lz4";
+#elif defined(HAVE_ZSTD)
+    return "zstd";
+#elif defined(HAVE_ZLIB)
+    return "deflate";
+#else
+    return "";
+#endif
+}
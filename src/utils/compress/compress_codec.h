@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COMPRESS_CODEC_H
+#define __COMPRESS_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Ids travel in the transfer notifications, so they never change
+#define NIXL_CODEC_LZ4     1
+#define NIXL_CODEC_ZSTD    2
+#define NIXL_CODEC_DEFLATE 3
+
+class nixlCompressCodec {
+    public:
+        virtual ~nixlCompressCodec() { }
+
+        virtual uint8_t getId() const = 0;
+        virtual size_t getBound(size_t len) const = 0;
+        // Largest raw size a compressed byte can decode to, to bound the
+        // size claimed by a sender before allocating for it
+        virtual size_t getMaxRatio() const = 0;
+
+        // Compressed size, 0 on failure or when dst is too small
+        virtual size_t compress(const char *src, size_t len,
+                                char *dst, size_t dst_len) const = 0;
+        // False unless exactly dst_len bytes are produced
+        virtual bool decompress(const char *src, size_t len,
+                                char *dst, size_t dst_len) const = 0;
+};
+
+// Codec by name (lz4, zstd or deflate) at a compression level, 0 for the
+// codec default. Null if it was not built in.
+std::unique_ptr<nixlCompressCodec> nixlCompressCodecCreate(const std::string &name,
+                                                           int level);
+std::unique_ptr<nixlCompressCodec> nixlCompressCodecCreate(uint8_t id);
+
+// Name of the first codec built in, empty without any
+std::string nixlCompressCodecDefault();
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include "cuda_copy.h"
+
+nixlCudaStreams::~nixlCudaStreams()
+{
+    nixlCudaDeviceGuard guard;
+
+    for (auto &elm : streams) {
+        cudaSetDevice(elm.first);
+        for (auto stream : elm.second) {
+            if (stream) {
+                cudaStreamDestroy(stream);
+            }
+        }
+    }
+}
+
+cudaStream_t nixlCudaStreams::get(int dev, size_t idx)
+{
+    std::lock_guard<std::mutex> guard(streamLock);
+    auto &dev_streams = streams[dev];
+
+    if (dev_streams.empty()) {
+        dev_streams.resize(numStreams, nullptr);
+    }
+    if (!dev_streams[idx]) {
+        cudaError_t error_id = cudaStreamCreateWithFlags(&dev_streams[idx],
+                                                         cudaStreamNonBlocking);
+        if (error_id != cudaSuccess) {
+            std::cerr << "cudaStreamCreate returned " << cudaGetErrorString(error_id) << std::endl;
+            dev_streams[idx] = nullptr;
+        }
+    }
+    return dev_streams[idx];
+}
+
+nixlCudaCopyEvents::~nixlCudaCopyEvents()
+{
+    for (auto &elm : events) {
+        if (elm.second) {
+            cudaEventSynchronize(elm.second);
+            cudaEventDestroy(elm.second);
+        }
+    }
+}
+
+nixl_status_t nixlCudaCopyEvents::queue(nixlCudaStreams &streams, int dev, size_t idx,
+                                        void *dst, const void *src, size_t size)
+{
+    cudaError_t error_id = cudaSetDevice(dev);
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaSetDevice returned " << cudaGetErrorString(error_id)
+                  << " for device ID " << dev << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+
+    cudaStream_t stream = streams.get(dev, idx);
+    if (!stream) {
+        return NIXL_ERR_BACKEND;
+    }
+
+    error_id = cudaMemcpyAsync(dst, src, size, cudaMemcpyDefault, stream);
+    if (error_id != cudaSuccess) {
+        std::cerr << "cudaMemcpyAsync returned " << cudaGetErrorString(error_id) << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+    queued[std::make_pair(dev, idx)] = stream;
+    return NIXL_SUCCESS;
+}
+
+// Copies already queued still run, after an error they are waited for
+void nixlCudaCopyEvents::waitQueued()
+{
+    for (auto &elm : queued) {
+        cudaStreamSynchronize(elm.second);
+    }
+    queued.clear();
+}
+
+nixl_status_t nixlCudaCopyEvents::record()
+{
+    for (auto &elm : queued) {
+        cudaEvent_t &event = events[elm.first];
+
+        cudaSetDevice(elm.first.first);
+        if (!event) {
+            cudaError_t error_id = cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+            if (error_id != cudaSuccess) {
+                std::cerr << "cudaEventCreate returned " << cudaGetErrorString(error_id) << std::endl;
+                event = nullptr;
+                waitQueued();
+                pending.clear();
+                return NIXL_ERR_BACKEND;
+            }
+        }
+        cudaEventRecord(event, elm.second);
+        pending.push_back(event);
+    }
+    queued.clear();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlCudaCopyEvents::check()
+{
+    while (!pending.empty()) {
+        cudaError_t error_id = cudaEventQuery(pending.back());
+
+        if (error_id == cudaErrorNotReady) {
+            return NIXL_IN_PROG;
+        }
+        if (error_id != cudaSuccess) {
+            std::cerr << "cudaEventQuery returned " << cudaGetErrorString(error_id) << std::endl;
+            pending.clear();
+            return NIXL_ERR_BACKEND;
+        }
+        pending.pop_back();
+    }
+    return NIXL_SUCCESS;
+}
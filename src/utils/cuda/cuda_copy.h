@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __CUDA_COPY_H
+#define __CUDA_COPY_H
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cuda_runtime.h>
+#include "nixl_types.h"
+
+// Restores the device current when it was created, so the backends calls
+// don't change the device of the calling thread
+class nixlCudaDeviceGuard {
+    private:
+        int prevDev;
+
+    public:
+        nixlCudaDeviceGuard() {
+            if (cudaGetDevice(&prevDev) != cudaSuccess) {
+                prevDev = -1;
+            }
+        }
+        ~nixlCudaDeviceGuard() {
+            if (prevDev >= 0) {
+                cudaSetDevice(prevDev);
+            }
+        }
+
+        nixlCudaDeviceGuard(const nixlCudaDeviceGuard&) = delete;
+        nixlCudaDeviceGuard& operator=(const nixlCudaDeviceGuard&) = delete;
+};
+
+// Streams of each device, created on first use and shared by the transfers
+// of a backend
+class nixlCudaStreams {
+    private:
+        size_t numStreams;
+        std::mutex streamLock;
+        std::unordered_map<int, std::vector<cudaStream_t>> streams;
+
+    public:
+        nixlCudaStreams(size_t num_streams = 1) : numStreams(num_streams) { }
+        ~nixlCudaStreams();
+
+        nixlCudaStreams(const nixlCudaStreams&) = delete;
+        nixlCudaStreams& operator=(const nixlCudaStreams&) = delete;
+
+        // Before any stream is used
+        void setCount(size_t num_streams) { numStreams = num_streams; }
+        size_t count() const { return numStreams; }
+
+        // With dev the current device, nullptr if it could not be created
+        cudaStream_t get(int dev, size_t idx);
+};
+
+// Copies of a transfer queued on the streams, and the events recorded after
+// them, one per stream used
+class nixlCudaCopyEvents {
+    private:
+        std::map<std::pair<int, size_t>, cudaEvent_t> events;
+        std::vector<cudaEvent_t> pending;
+        std::map<std::pair<int, size_t>, cudaStream_t> queued;
+
+        nixl_status_t queue(nixlCudaStreams &streams, int dev, size_t idx,
+                            void *dst, const void *src, size_t size);
+        nixl_status_t record();
+        void waitQueued();
+
+    public:
+        nixlCudaCopyEvents() { }
+        // Waits for the copies still running
+        ~nixlCudaCopyEvents();
+
+        nixlCudaCopyEvents(const nixlCudaCopyEvents&) = delete;
+        nixlCudaCopyEvents& operator=(const nixlCudaCopyEvents&) = delete;
+
+        bool active() const { return !pending.empty(); }
+
+        // Copies of type T, with dst, src, size and dev members, spread round
+        // robin over the streams of their device, so the copy engines work on
+        // several of them at once. The device of the thread is kept.
+        template <class T>
+        nixl_status_t post(nixlCudaStreams &streams, const std::vector<T> &copies) {
+            nixlCudaDeviceGuard guard;
+
+            if (active()) {
+                return NIXL_ERR_REPOST_ACTIVE;
+            }
+            queued.clear();
+            for (size_t i = 0; i < copies.size(); i++) {
+                const T &copy = copies[i];
+                if (queue(streams, copy.dev, i % streams.count(),
+                          copy.dst, copy.src, copy.size) != NIXL_SUCCESS) {
+                    waitQueued();
+                    return NIXL_ERR_BACKEND;
+                }
+            }
+            if (record() != NIXL_SUCCESS) {
+                return NIXL_ERR_BACKEND;
+            }
+            return check();
+        }
+
+        nixl_status_t check();
+};
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "local_utils.h"
+#include "serdes/serdes.h"
+
+static std::string readLinkStr(const std::string &path)
+{
+    char buf[PATH_MAX];
+    ssize_t len = readlink(path.c_str(), buf, sizeof(buf) - 1);
+
+    if (len < 0) {
+        return std::string();
+    }
+    return std::string(buf, len);
+}
+
+std::string nixlLocalHostId()
+{
+    std::ifstream file("/proc/sys/kernel/random/boot_id");
+    std::string boot_id;
+
+    std::getline(file, boot_id);
+    return boot_id + "/" + readLinkStr("/proc/self/ns/pid") + "/" +
+           readLinkStr("/proc/self/ns/net");
+}
+
+static socklen_t makeAddr(const std::string &name, struct sockaddr_un &addr)
+{
+    // Abstract namespace, the name starts with a null byte
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    size_t len = std::min(name.size(), sizeof(addr.sun_path) - 1);
+    memcpy(addr.sun_path + 1, name.data(), len);
+    return offsetof(struct sockaddr_un, sun_path) + 1 + len;
+}
+
+nixlLocalNotifier::~nixlLocalNotifier()
+{
+    if (sockFd >= 0) {
+        close(sockFd);
+    }
+}
+
+nixl_status_t nixlLocalNotifier::init(const std::string &prefix)
+{
+    static std::atomic<unsigned int> sock_cnt{0};
+    struct sockaddr_un addr;
+
+    sockFd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sockFd < 0) {
+        std::cerr << "Failed to create the notification socket: " << strerror(errno) << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+
+    sockName = prefix + "-" + std::to_string(getpid()) + "-" + std::to_string(sock_cnt++);
+    socklen_t addr_len = makeAddr(sockName, addr);
+    // The kernel attaches the credentials of the sender to each datagram
+    int pass_cred = 1;
+    if ((bind(sockFd, (struct sockaddr*) &addr, addr_len) != 0) ||
+        (setsockopt(sockFd, SOL_SOCKET, SO_PASSCRED, &pass_cred, sizeof(pass_cred)) != 0)) {
+        std::cerr << "Failed to bind the notification socket: " << strerror(errno) << std::endl;
+        close(sockFd);
+        sockFd = -1;
+        return NIXL_ERR_BACKEND;
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlLocalNotifier::addPeer(const std::string &agent,
+                                         const std::string &sock_name)
+{
+    // Named by init, the pid is in between the last two dashes
+    size_t last = sock_name.rfind('-');
+    size_t prev = (last == std::string::npos || last == 0) ?
+                  std::string::npos : sock_name.rfind('-', last - 1);
+    if (prev == std::string::npos) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    pid_t peer_pid;
+    try {
+        size_t pos;
+        peer_pid = std::stoi(sock_name.substr(prev + 1, last - prev - 1), &pos);
+        if ((pos != last - prev - 1) || (peer_pid <= 0)) {
+            return NIXL_ERR_INVALID_PARAM;
+        }
+    } catch (const std::exception &e) {
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    const std::lock_guard<std::mutex> guard(peerLock);
+    peerPids[agent] = peer_pid;
+    return NIXL_SUCCESS;
+}
+
+void nixlLocalNotifier::removePeer(const std::string &agent)
+{
+    const std::lock_guard<std::mutex> guard(peerLock);
+    peerPids.erase(agent);
+}
+
+nixl_status_t nixlLocalNotifier::send(const std::string &sock_name,
+                                      const std::string &agent,
+                                      const std::string &msg)
+{
+    struct sockaddr_un addr;
+    socklen_t addr_len = makeAddr(sock_name, addr);
+    nixlSerDes sd;
+
+    sd.addStr("Name", agent);
+    sd.addStr("Msg", msg);
+    std::string buf = sd.exportStr();
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::microseconds(NIXL_LOCAL_NOTIF_SEND_TIMEOUT_US);
+    while (true) {
+        ssize_t ret = sendto(sockFd, buf.data(), buf.size(), 0,
+                             (struct sockaddr*) &addr, addr_len);
+        if (ret >= 0) {
+            return NIXL_SUCCESS;
+        }
+        // The receiver queue is full until it reads its notifications
+        if (((errno == EAGAIN) || (errno == EINTR)) &&
+            (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::cerr << "Failed to send a notification: " << strerror(errno) << std::endl;
+        return NIXL_ERR_BACKEND;
+    }
+}
+
+nixl_status_t nixlLocalNotifier::recv(notif_list_t &notif_list)
+{
+    while (true) {
+        // Size of the next datagram, without taking it
+        ssize_t len = ::recv(sockFd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+        if (len < 0) {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                return NIXL_SUCCESS;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return NIXL_ERR_BACKEND;
+        }
+
+        if (recvBuf.size() < (size_t) len) {
+            recvBuf.resize(len);
+        }
+
+        char ctrl[CMSG_SPACE(sizeof(struct ucred))];
+        struct iovec iov = {recvBuf.data(), recvBuf.size()};
+        struct msghdr mh = {};
+        mh.msg_iov = &iov;
+        mh.msg_iovlen = 1;
+        mh.msg_control = ctrl;
+        mh.msg_controllen = sizeof(ctrl);
+        len = recvmsg(sockFd, &mh, 0);
+        if (len < 0) {
+            return NIXL_ERR_BACKEND;
+        }
+
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&mh);
+        if (!cmsg || (cmsg->cmsg_level != SOL_SOCKET) ||
+            (cmsg->cmsg_type != SCM_CREDENTIALS)) {
+            continue;
+        }
+        struct ucred cred;
+        memcpy(&cred, CMSG_DATA(cmsg), sizeof(cred));
+
+        nixlSerDes sd;
+        if (sd.importStr(std::string(recvBuf.data(), len)) != NIXL_SUCCESS) {
+            continue;
+        }
+        std::string name = sd.getStr("Name");
+        {
+            // The socket names are guessable, the sending process is not
+            const std::lock_guard<std::mutex> guard(peerLock);
+            auto it = peerPids.find(name);
+            if ((it == peerPids.end()) || (it->second != cred.pid)) {
+                std::cerr << "Dropped a notification of " << name << " sent by pid "
+                          << cred.pid << std::endl;
+                continue;
+            }
+        }
+        std::string msg = sd.getStr("Msg");
+        notif_list.emplace_back(std::move(name), std::move(msg));
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __LOCAL_UTILS_H
+#define __LOCAL_UTILS_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+#include "nixl.h"
+#include "backend/backend_aux.h"
+
+// Identifies the host and the PID and network namespaces of this process.
+// Agents with the same id can reach each other's memory through its PID,
+// and their notification sockets.
+std::string nixlLocalHostId();
+
+// Time a notification waits for room in the queue of the receiver
+#define NIXL_LOCAL_NOTIF_SEND_TIMEOUT_US 1000000
+
+// Notifications between agents of one host, as datagrams of the agent name
+// and message over a Unix socket in the abstract namespace. The name in a
+// datagram is checked against the pid the kernel reports for its sender.
+class nixlLocalNotifier {
+    private:
+        int sockFd = -1;
+        std::string sockName;
+        std::vector<char> recvBuf;
+
+        // Agent -> pid of its process, from the name of its socket
+        std::unordered_map<std::string, pid_t> peerPids;
+        std::mutex peerLock;
+
+    public:
+        nixlLocalNotifier() { }
+        ~nixlLocalNotifier();
+
+        nixlLocalNotifier(const nixlLocalNotifier&) = delete;
+        nixlLocalNotifier& operator=(const nixlLocalNotifier&) = delete;
+
+        // Binds a socket named after the prefix, this process and a counter
+        nixl_status_t init(const std::string &prefix);
+        const std::string &getName() const { return sockName; }
+
+        // Only notifications of the agents added are received
+        nixl_status_t addPeer(const std::string &agent, const std::string &sock_name);
+        void removePeer(const std::string &agent);
+
+        // Waits while the queue of the receiver is full, up to
+        // NIXL_LOCAL_NOTIF_SEND_TIMEOUT_US, and then fails with NIXL_ERR_BACKEND
+        nixl_status_t send(const std::string &sock_name,
+                           const std::string &agent, const std::string &msg);
+        nixl_status_t recv(notif_list_t &notif_list);
+};
+
+#endif
@@ -14,122 +14,224 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
 #include "serdes.h"
 
-nixlSerDes::nixlSerDes() {
-    workingStr = "nixlSerDes|";
-    des_offset = 11;
+#define TAGGED_HDR     "nixlSerDes|"
+#define TAGGED_HDR_LEN 11
+#define BINARY_HDR     "nixlSDB1"
+#define BINARY_HDR_LEN 8
+
+// Binary fields are the FNV-1a hash of their tag, then the length as a
+// varint, then the value
+static uint32_t fieldId(const std::string &tag) {
+    uint32_t id = 2166136261u;
+
+    for (unsigned char c : tag) {
+        id ^= c;
+        id *= 16777619u;
+    }
+    return id;
+}
+
+nixlSerDes::nixlSerDes() : nixlSerDes(defaultFormat()) {}
+
+nixlSerDes::nixlSerDes(ser_format_t ser_format) {
+    format = ser_format;
+    if (format == BINARY) {
+        workingStr = BINARY_HDR;
+        des_offset = BINARY_HDR_LEN;
+    } else {
+        workingStr = TAGGED_HDR;
+        des_offset = TAGGED_HDR_LEN;
+    }
 
     mode = SERIALIZE;
 }
 
+nixlSerDes::ser_format_t nixlSerDes::defaultFormat() {
+    static const ser_format_t def_format = []() {
+        const char *env = getenv("NIXL_SERDES_FORMAT");
+        return (env && (strcmp(env, "binary") == 0)) ? BINARY : TAGGED;
+    }();
+
+    return def_format;
+}
+
 std::string nixlSerDes::_bytesToString(const void *buf, ssize_t size) {
     std::string ret_str = std::string(reinterpret_cast<const char*>(buf), size);
     return ret_str;
 }
 
 void nixlSerDes::_stringToBytes(void* fill_buf, const std::string &s, ssize_t size){
-    s.copy(reinterpret_cast<char*>(fill_buf), size); 
+    s.copy(reinterpret_cast<char*>(fill_buf), size);
 }
 
-/* Ser/Des for Strings */
-nixl_status_t nixlSerDes::addStr(const std::string &tag, const std::string &str){
+void nixlSerDes::addField(const std::string &tag, const void* buf, size_t len) {
+    if (format == TAGGED) {
+        workingStr.append(tag);
+        workingStr.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        workingStr.append(reinterpret_cast<const char*>(buf), len);
+        workingStr.append("|");
+        return;
+    }
 
-    size_t len = str.size();
+    uint32_t id = fieldId(tag);
+    char varint[10];
+    size_t rest = len;
+    size_t n = 0;
+
+    workingStr.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    do {
+        varint[n++] = (rest & 0x7f) | ((rest > 0x7f) ? 0x80 : 0);
+        rest >>= 7;
+    } while (rest);
+    workingStr.append(varint, n);
+    workingStr.append(reinterpret_cast<const char*>(buf), len);
+}
 
-    workingStr.append(tag);
-    workingStr.append(_bytesToString(&len, sizeof(size_t)));
-    workingStr.append(str);
-    workingStr.append("|");
+// Finds the value of the next field, checking that it is whole
+bool nixlSerDes::peekField(const std::string &tag, size_t &offset, size_t &len) const {
+    std::string_view data = (mode == DESERIALIZE) ? des_view : std::string_view(workingStr);
+    size_t pos = des_offset;
+
+    if (format == TAGGED) {
+        if ((data.size() < pos + tag.size() + sizeof(len)) ||
+            (data.substr(pos, tag.size()) != tag)) {
+            return false;
+        }
+        pos += tag.size();
+        memcpy(&len, data.data() + pos, sizeof(len));
+        pos += sizeof(len);
+        // Followed by the | delimiter
+        if (data.size() - pos <= len) {
+            return false;
+        }
+        offset = pos;
+        return true;
+    }
 
+    uint32_t id;
+    if (data.size() < pos + sizeof(id)) {
+        return false;
+    }
+    memcpy(&id, data.data() + pos, sizeof(id));
+    if (id != fieldId(tag)) {
+        return false;
+    }
+    pos += sizeof(id);
+
+    len = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+        if ((pos == data.size()) || (shift > 63)) {
+            return false;
+        }
+        unsigned char c = data[pos++];
+        len |= (size_t) (c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            break;
+        }
+    }
+    if (data.size() - pos < len) {
+        return false;
+    }
+    offset = pos;
+    return true;
+}
+
+/* Ser/Des for Strings */
+nixl_status_t nixlSerDes::addStr(const std::string &tag, const std::string &str){
+    addField(tag, str.data(), str.size());
     return NIXL_SUCCESS;
 }
 
-std::string nixlSerDes::getStr(const std::string &tag){
+std::string_view nixlSerDes::getStrView(const std::string &tag){
+    std::string_view data = (mode == DESERIALIZE) ? des_view : std::string_view(workingStr);
+    size_t offset, len;
 
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return "";
-    } 
-    ssize_t len;
+    if (!peekField(tag, offset, len)) {
+        //incorrect tag
+        return std::string_view();
+    }
 
-    //skip tag
-    des_offset += tag.size();
-    
-    //get len
-    //_stringToBytes(&len, workingStr.data() + des_offset, sizeof(ssize_t));
-    _stringToBytes(&len, workingStr.substr(des_offset, sizeof(ssize_t)), sizeof(ssize_t));
-    des_offset += sizeof(ssize_t);
+    //move past string, plus | delimiter of the tagged format
+    des_offset = offset + len + ((format == TAGGED) ? 1 : 0);
 
-    //get string
-    std::string ret = workingStr.substr(des_offset, len);
-    
-    //move past string plus | delimiter
-    des_offset += len + 1;
+    return data.substr(offset, len);
+}
 
-    return ret;
+std::string nixlSerDes::getStr(const std::string &tag){
+    return std::string(getStrView(tag));
 }
 
 /* Ser/Des for Byte buffers */
 nixl_status_t nixlSerDes::addBuf(const std::string &tag, const void* buf, ssize_t len){
-
-    workingStr.append(tag);
-    workingStr.append(_bytesToString(&len, sizeof(ssize_t)));
-    workingStr.append(_bytesToString(buf, len));
-    workingStr.append("|");
-
+    addField(tag, buf, len);
     return NIXL_SUCCESS;
 }
 
 ssize_t nixlSerDes::getBufLen(const std::string &tag) const{
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return -1;
-    } 
-
-    ssize_t len;
-
-    //get len
-    //_stringToBytes(&len, workingStr.data() + des_offset + tag.size(), sizeof(ssize_t));
-    _stringToBytes(&len, workingStr.substr(des_offset + tag.size(), sizeof(ssize_t)), sizeof(ssize_t));
+    size_t offset, len;
 
+    if (!peekField(tag, offset, len)) {
+        //incorrect tag
+        return -1;
+    }
     return len;
 }
 
 nixl_status_t nixlSerDes::getBuf(const std::string &tag, void *buf, ssize_t len){
-    if(workingStr.compare(des_offset, tag.size(), tag) != 0){
-       //incorrect tag
-       return NIXL_ERR_MISMATCH;
-    }
-    
-    //skip over tag and size, which we assume has been read previously
-    des_offset += tag.size() + sizeof(ssize_t);
+    std::string_view data = (mode == DESERIALIZE) ? des_view : std::string_view(workingStr);
+    size_t offset, buf_len;
 
-    //_stringToBytes(buf, workingStr.data() + des_offset, len);
-    _stringToBytes(buf, workingStr.substr(des_offset, len), len);
+    if (!peekField(tag, offset, buf_len) || (buf_len != (size_t) len)) {
+        //incorrect tag or size
+        return NIXL_ERR_MISMATCH;
+    }
+    memcpy(buf, data.data() + offset, len);
 
-    //bytes in string form are twice as long, skip those plus | delimiter
-    des_offset += len + 1;
+    //move past buffer, plus | delimiter of the tagged format
+    des_offset = offset + len + ((format == TAGGED) ? 1 : 0);
 
     return NIXL_SUCCESS;
 }
 
 /* Ser/Des buffer management */
 std::string nixlSerDes::exportStr() const {
-	std::string ret_str = workingStr;
+    return workingStr;
+}
+
+std::string nixlSerDes::releaseStr() {
+    std::string ret_str = std::move(workingStr);
+
+    workingStr = (format == BINARY) ? BINARY_HDR : TAGGED_HDR;
     return ret_str;
 }
 
 nixl_status_t nixlSerDes::importStr(const std::string &sdbuf) {
- 
-    if(sdbuf.compare(0, 11, "nixlSerDes|") != 0){
-       //incorrect tag
-       return NIXL_ERR_MISMATCH;
-    }    
-
     workingStr = sdbuf;
+    return importView(workingStr);
+}
+
+nixl_status_t nixlSerDes::importStr(std::string &&sdbuf) {
+    workingStr = std::move(sdbuf);
+    return importView(workingStr);
+}
+
+nixl_status_t nixlSerDes::importView(std::string_view sdbuf) {
+    if (sdbuf.substr(0, BINARY_HDR_LEN) == BINARY_HDR) {
+        format = BINARY;
+        des_offset = BINARY_HDR_LEN;
+    } else if (sdbuf.substr(0, TAGGED_HDR_LEN) == TAGGED_HDR) {
+        format = TAGGED;
+        des_offset = TAGGED_HDR_LEN;
+    } else {
+        //incorrect tag
+        return NIXL_ERR_MISMATCH;
+    }
+
+    des_view = sdbuf;
     mode = DESERIALIZE;
-    des_offset = 11;
 
     return NIXL_SUCCESS;
 }
@@ -19,24 +19,43 @@
 
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 #include "nixl_types.h"
 
 class nixlSerDes {
+public:
+    // Tagged is the original text tagged format, the default as peers of older
+    // releases only read it. Binary is compact and read in place, selected with
+    // NIXL_SERDES_FORMAT=binary. Both are read, told apart by their header.
+    typedef enum { TAGGED, BINARY } ser_format_t;
+
 private:
     typedef enum { SERIALIZE, DESERIALIZE } ser_mode_t;
 
     std::string workingStr;
+    // What is deserialized, workingStr or a buffer of the caller
+    std::string_view des_view;
     ssize_t des_offset;
     ser_mode_t mode;
+    ser_format_t format;
+
+    void addField(const std::string &tag, const void* buf, size_t len);
+    bool peekField(const std::string &tag, size_t &offset, size_t &len) const;
 
 public:
     nixlSerDes();
+    nixlSerDes(ser_format_t ser_format);
+
+    // Of serializers created without a format
+    static ser_format_t defaultFormat();
 
     /* Ser/Des for Strings */
     nixl_status_t addStr(const std::string &tag, const std::string &str);
     std::string getStr(const std::string &tag);
+    // Points into the imported buffer, valid while it is
+    std::string_view getStrView(const std::string &tag);
 
     /* Ser/Des for Byte buffers */
     nixl_status_t addBuf(const std::string &tag, const void* buf, ssize_t len);
@@ -45,7 +64,12 @@ public:
 
     /* Ser/Des buffer management */
     std::string exportStr() const;
+    // Moves the buffer out, the serializer is empty after
+    std::string releaseStr();
     nixl_status_t importStr(const std::string &sdbuf);
+    nixl_status_t importStr(std::string &&sdbuf);
+    // Reads sdbuf in place, it has to outlive the deserializer
+    nixl_status_t importView(std::string_view sdbuf);
 
     static std::string _bytesToString(const void *buf, ssize_t size);
     static void _stringToBytes(void* fill_buf, const std::string &s, ssize_t size);
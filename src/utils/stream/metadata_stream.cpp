@@ -15,10 +15,12 @@
  * limitations under the License.
  */
 #include "metadata_stream.h"
+#include <algorithm>
 #include <iostream>
 #include <unistd.h>
 #include <cstring>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
@@ -48,6 +50,8 @@ bool nixlMetadataStream::setupStream() {
 void nixlMetadataStream::closeStream() {
    if (socketFd != -1) {
         close(socketFd);
+        // The agent doesn't wait on a listener that failed to set up
+        socketFd = -1;
    }
 }
 
@@ -65,7 +69,14 @@ nixlMDStreamListener::~nixlMDStreamListener() {
 }
 
 void nixlMDStreamListener::setupListener() {
-    setupStream();
+    int reuse = 1;
+
+    if (!setupStream())
+        return;
+
+    // Connections of a previous agent on the port can still be in TIME_WAIT
+    if (setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
+        std::cerr << "Cannot reuse the address of the listener for MD\n";
 
     if (bind(socketFd, (struct sockaddr*)&listenerAddr,
              sizeof(listenerAddr)) < 0) {
@@ -207,3 +218,104 @@ std::string nixlMDStreamClient::recvData() {
     }
     return "";
 }
+
+/*** Framing of the listener messages ***/
+
+nixl_status_t nixlMDFrameReader::recvFrame(int fd, uint32_t &type, std::string &data) {
+    ssize_t bytes;
+
+    while (headerBytes < sizeof(header)) {
+        bytes = recv(fd, (char*) &header + headerBytes, sizeof(header) - headerBytes, 0);
+        if (bytes == 0)
+            return NIXL_ERR_BACKEND;
+        if (bytes < 0)
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ?
+                   NIXL_IN_PROG : NIXL_ERR_BACKEND;
+        headerBytes += bytes;
+
+        if (headerBytes == sizeof(header)) {
+            if ((memcmp(header.magic, NIXL_MD_FRAME_MAGIC, sizeof(header.magic)) != 0) ||
+                (header.length > NIXL_MD_FRAME_MAX_SIZE)) {
+                std::cerr << "Corrupt frame on socket fd " << fd << std::endl;
+                return NIXL_ERR_BACKEND;
+            }
+            // A header alone doesn't make the full length allocated
+            payload.resize(std::min<uint64_t>(header.length, NIXL_MD_FRAME_MIN_BUF));
+            payloadBytes = 0;
+        }
+    }
+
+    while (payloadBytes < header.length) {
+        if (payloadBytes == payload.size())
+            payload.resize(std::min<uint64_t>(header.length, payload.size() * 2));
+        bytes = recv(fd, &payload[payloadBytes], payload.size() - payloadBytes, 0);
+        if (bytes == 0)
+            return NIXL_ERR_BACKEND;
+        if (bytes < 0)
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ?
+                   NIXL_IN_PROG : NIXL_ERR_BACKEND;
+        payloadBytes += bytes;
+    }
+
+    type = header.type;
+    data.swap(payload);
+    payload.clear();
+    headerBytes = 0;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlMDFrameWriter::push(uint32_t type, std::string &&data) {
+    nixlMDFrameHeader header = {};
+
+    if (data.size() > NIXL_MD_FRAME_MAX_SIZE)
+        return NIXL_ERR_INVALID_PARAM;
+    if (queuedBytes + data.size() > NIXL_MD_FRAME_QUEUE_MAX_SIZE)
+        return NIXL_ERR_NOT_ALLOWED;
+
+    memcpy(header.magic, NIXL_MD_FRAME_MAGIC, sizeof(header.magic));
+    header.type   = type;
+    header.length = data.size();
+    queuedBytes  += data.size();
+    frames.emplace_back(header, std::move(data));
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlMDFrameWriter::flush(int fd) {
+    while (!frames.empty()) {
+        const nixlMDFrameHeader &header = frames.front().first;
+        const std::string &data         = frames.front().second;
+        struct iovec iov[2];
+        int iov_cnt = 0;
+
+        if (sentBytes < sizeof(header)) {
+            iov[iov_cnt].iov_base = (char*) &header + sentBytes;
+            iov[iov_cnt].iov_len  = sizeof(header) - sentBytes;
+            iov_cnt++;
+        }
+        size_t data_sent = (sentBytes > sizeof(header)) ? sentBytes - sizeof(header) : 0;
+        if (data_sent < data.size()) {
+            iov[iov_cnt].iov_base = (char*) data.data() + data_sent;
+            iov[iov_cnt].iov_len  = data.size() - data_sent;
+            iov_cnt++;
+        }
+
+        struct msghdr msg = {};
+        msg.msg_iov    = iov;
+        msg.msg_iovlen = iov_cnt;
+        ssize_t bytes = (iov_cnt == 0) ? 0 : sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+                return NIXL_IN_PROG;
+            std::cerr << "Cannot send on socket fd " << fd << std::endl;
+            return NIXL_ERR_BACKEND;
+        }
+
+        sentBytes += bytes;
+        if (sentBytes == sizeof(header) + data.size()) {
+            queuedBytes -= data.size();
+            frames.pop_front();
+            sentBytes = 0;
+        }
+    }
+    return NIXL_SUCCESS;
+}
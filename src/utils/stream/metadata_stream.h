@@ -25,12 +25,62 @@
 #include <mutex>
 #include <string>
 #include <queue>
+#include <deque>
 #include <vector>
 #include <netinet/in.h>
 #include "nixl_types.h"
 
 #define RECV_BUFFER_SIZE 16384
 
+// Messages between the agent listeners are framed by this header, and the
+// payload is received into a buffer grown as its data arrives
+#define NIXL_MD_FRAME_MAGIC "NIXLMSG1"
+// Larger frames are considered corrupt
+#define NIXL_MD_FRAME_MAX_SIZE (1ULL << 30)
+// First payload buffer of a frame, doubled until it holds the frame length
+#define NIXL_MD_FRAME_MIN_BUF (1ULL << 20)
+// Bytes queued for a peer that does not read them, beyond which it is dropped
+#define NIXL_MD_FRAME_QUEUE_MAX_SIZE (2 * NIXL_MD_FRAME_MAX_SIZE)
+
+struct nixlMDFrameHeader {
+    char     magic[8];
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t length;
+};
+
+// Reads the frames of a nonblocking socket, as its data arrives
+class nixlMDFrameReader {
+    private:
+        nixlMDFrameHeader header;
+        size_t            headerBytes = 0;
+        std::string       payload;
+        size_t            payloadBytes = 0;
+
+    public:
+        // NIXL_SUCCESS with a frame, NIXL_IN_PROG until the socket has the rest
+        // of it, and NIXL_ERR_BACKEND when it is closed or the data is corrupt.
+        nixl_status_t recvFrame(int fd, uint32_t &type, std::string &data);
+};
+
+// Sends frames on a nonblocking socket, keeping what it could not take yet
+class nixlMDFrameWriter {
+    private:
+        std::deque<std::pair<nixlMDFrameHeader, std::string>> frames;
+        // Bytes of the first frame sent, header included
+        size_t                                                sentBytes = 0;
+        size_t                                                queuedBytes = 0;
+
+    public:
+        // NIXL_ERR_INVALID_PARAM for a frame over NIXL_MD_FRAME_MAX_SIZE, and
+        // NIXL_ERR_NOT_ALLOWED when NIXL_MD_FRAME_QUEUE_MAX_SIZE is queued already
+        nixl_status_t push(uint32_t type, std::string &&data);
+
+        // NIXL_IN_PROG when frames are left, to send when the socket is writable
+        nixl_status_t flush(int fd);
+        bool empty() const { return frames.empty(); }
+};
+
 class nixlMetadataStream {
     protected:
         int                 port;
@@ -44,6 +94,8 @@ class nixlMetadataStream {
     public:
         nixlMetadataStream(int port);
         ~nixlMetadataStream();
+
+        int getSocketFd() const { return socketFd; }
 };
 
 
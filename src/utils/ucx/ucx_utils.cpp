@@ -18,6 +18,7 @@
 #include <string>
 #include <cstring>
 #include <cassert>
+#include <algorithm>
 
 #include "ucx_utils.h"
 
@@ -47,7 +48,8 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
                                size_t req_size,
                                nixlUcxContext::req_cb_t init_cb,
                                nixlUcxContext::req_cb_t fini_cb,
-                               nixl_ucx_mt_t __mt_type)
+                               nixl_ucx_mt_t __mt_type,
+                               bool wakeup)
 {
     ucp_params_t ucp_params;
     ucp_config_t *ucp_config;
@@ -58,6 +60,9 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
     ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES | UCP_PARAM_FIELD_MT_WORKERS_SHARED |
                             UCP_PARAM_FIELD_ESTIMATED_NUM_EPS;
     ucp_params.features = UCP_FEATURE_RMA | UCP_FEATURE_AMO32 | UCP_FEATURE_AMO64 | UCP_FEATURE_AM;
+    if (wakeup) {
+        ucp_params.features |= UCP_FEATURE_WAKEUP;
+    }
     switch(mt_type) {
     case NIXL_UCX_MT_SINGLE:
     case NIXL_UCX_MT_WORKER:
@@ -151,6 +156,10 @@ nixlUcxWorker::nixlUcxWorker(nixlUcxContext *_ctx)
 
 nixlUcxWorker::~nixlUcxWorker()
 {
+    regCacheFlush();
+    if (regCacheHooked)
+        ucm_unset_event_handler(UCM_EVENT_VM_UNMAPPED | UCM_EVENT_MEM_TYPE_FREE,
+                                regCacheUnmapCb, this);
     ucp_worker_destroy(worker);
 }
 
@@ -216,6 +225,27 @@ int nixlUcxWorker::connect(void* addr, size_t size, nixlUcxEp &ep)
     return 0;
 }
 
+int nixlUcxWorker::estimateTime(nixlUcxEp &ep, size_t size, double &seconds)
+{
+#ifdef HAVE_UCP_EP_EVALUATE_PERF
+    ucp_ep_evaluate_perf_param_t param;
+    ucp_ep_evaluate_perf_attr_t attr;
+
+    param.field_mask   = UCP_EP_PERF_PARAM_FIELD_MESSAGE_SIZE;
+    param.message_size = size;
+    attr.field_mask    = UCP_EP_PERF_ATTR_FIELD_ESTIMATED_TIME;
+
+    if (ucp_ep_evaluate_perf(ep.eph, &param, &attr) != UCS_OK) {
+        return -1;
+    }
+
+    seconds = attr.estimated_time;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 int nixlUcxWorker::disconnect(nixlUcxEp &ep)
 {
     ucs_status_ptr_t request = ucp_ep_close_nb(ep.eph, UCP_EP_CLOSE_MODE_FLUSH);
@@ -274,6 +304,25 @@ int nixlUcxWorker::memReg(void *addr, size_t size, nixlUcxMem &mem)
     //mem.uw = this;
     mem.base = addr;
     mem.size = size;
+    mem.cacheEntry = nullptr;
+
+    std::unique_lock<std::mutex> lock(regCacheLock, std::defer_lock);
+    if (regCacheMax) {
+        lock.lock();
+        regCacheInvalidate();
+
+        nixlUcxRegEntry *entry = regCacheFind(addr, size);
+        if (entry) {
+            if (entry->refCnt++ == 0) {
+                regCacheLru.erase(entry->lruPos);
+                regCacheIdle -= entry->size;
+            }
+            mem.memh = entry->memh;
+            mem.cacheEntry = entry;
+            regCacheHitCnt++;
+            return 0;
+        }
+    }
 
     ucp_mem_map_params_t mem_params = {
         .field_mask = UCP_MEM_MAP_PARAM_FIELD_FLAGS |
@@ -289,6 +338,20 @@ int nixlUcxWorker::memReg(void *addr, size_t size, nixlUcxMem &mem)
         return -1;
     }
 
+    if (regCacheMax) {
+        nixlUcxRegEntry *entry = new nixlUcxRegEntry;
+        entry->base = addr;
+        entry->size = size;
+        entry->memh = mem.memh;
+        entry->refCnt = 1;
+        regCache.emplace((uintptr_t) addr, entry);
+        mem.cacheEntry = entry;
+        if ((uintptr_t) addr < regCacheLo)
+            regCacheLo = (uintptr_t) addr;
+        if ((uintptr_t) addr + size > regCacheHi)
+            regCacheHi = (uintptr_t) addr + size;
+    }
+
     return 0;
 }
 
@@ -319,7 +382,189 @@ size_t nixlUcxWorker::packRkey(nixlUcxMem &mem, uint64_t &addr, size_t &size)
 
 void nixlUcxWorker::memDereg(nixlUcxMem &mem)
 {
-    ucp_mem_unmap(ctx->ctx, mem.memh);
+    nixlUcxRegEntry *entry = mem.cacheEntry;
+
+    if (!entry) {
+        ucp_mem_unmap(ctx->ctx, mem.memh);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(regCacheLock);
+    mem.cacheEntry = nullptr;
+
+    if ((--entry->refCnt == 0) && !entry->valid) {
+        ucp_mem_unmap(ctx->ctx, entry->memh);
+        delete entry;
+        return;
+    }
+
+    // Kept mapped for the next registration it covers
+    if (entry->refCnt == 0) {
+        regCacheLru.push_front(entry);
+        entry->lruPos = regCacheLru.begin();
+        regCacheIdle += entry->size;
+        regCacheEvict(regCacheMax);
+    }
+}
+
+/* ===========================================
+ * Registration cache
+ * =========================================== */
+
+// How many registrations starting at or below an address are checked for
+// containment, a miss only costs a new registration
+static const size_t regCacheScanMax = 16;
+
+// With regCacheLock held
+nixlUcxRegEntry* nixlUcxWorker::regCacheFind(void *addr, size_t size)
+{
+    uintptr_t start = (uintptr_t) addr;
+    auto it = regCache.upper_bound(start);
+
+    for (size_t i = 0; (i < regCacheScanMax) && (it != regCache.begin()); i++) {
+        --it;
+        nixlUcxRegEntry *entry = it->second;
+        if ((uintptr_t) entry->base + entry->size >= start + size) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+// With regCacheLock held, unmaps idle registrations until at most max_idle bytes remain
+void nixlUcxWorker::regCacheEvict(size_t max_idle)
+{
+    while ((regCacheIdle > max_idle) && !regCacheLru.empty()) {
+        nixlUcxRegEntry *entry = regCacheLru.back();
+        regCacheLru.pop_back();
+        regCacheIdle -= entry->size;
+
+        regCacheRemove(entry);
+        ucp_mem_unmap(ctx->ctx, entry->memh);
+        delete entry;
+    }
+}
+
+// With regCacheLock held, the entry is not found by lookups anymore
+void nixlUcxWorker::regCacheRemove(nixlUcxRegEntry *entry)
+{
+    auto range = regCache.equal_range((uintptr_t) entry->base);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            regCache.erase(it);
+            break;
+        }
+    }
+
+    if (regCache.empty()) {
+        regCacheLo = UINTPTR_MAX;
+        regCacheHi = 0;
+    }
+}
+
+// May run within munmap or cudaFree of any thread, so only queues the range
+void nixlUcxWorker::regCacheUnmapCb(ucm_event_type_t type, ucm_event_t *event, void *arg)
+{
+    nixlUcxWorker *w = (nixlUcxWorker*) arg;
+    uintptr_t start, end;
+
+    if (type == UCM_EVENT_MEM_TYPE_FREE) {
+        start = (uintptr_t) event->mem_type.address;
+        end   = start + std::max<size_t>(event->mem_type.size, 1);
+    } else {
+        start = (uintptr_t) event->vm_unmapped.address;
+        end   = start + event->vm_unmapped.size;
+    }
+    if ((end <= w->regCacheLo) || (start >= w->regCacheHi))
+        return;
+
+    while (w->regCacheInvalBusy.test_and_set(std::memory_order_acquire));
+    if (w->regCacheInvalCnt < regCacheInvalMax)
+        w->regCacheInval[w->regCacheInvalCnt++] = std::make_pair(start, end);
+    else
+        w->regCacheInvalAll = true;
+    w->regCacheInvalBusy.clear(std::memory_order_release);
+}
+
+// With regCacheLock held, drops the entries overlapping the unmapped ranges.
+// The referenced ones stay mapped until their last memDereg.
+void nixlUcxWorker::regCacheInvalidate()
+{
+    std::pair<uintptr_t, uintptr_t> ranges[regCacheInvalMax];
+    size_t count;
+    bool all;
+
+    while (regCacheInvalBusy.test_and_set(std::memory_order_acquire));
+    count = regCacheInvalCnt;
+    all   = regCacheInvalAll;
+    std::copy(regCacheInval, regCacheInval + count, ranges);
+    regCacheInvalCnt = 0;
+    regCacheInvalAll = false;
+    regCacheInvalBusy.clear(std::memory_order_release);
+
+    if (!count && !all)
+        return;
+
+    auto it = regCache.begin();
+    while (it != regCache.end()) {
+        nixlUcxRegEntry *entry = it->second;
+        uintptr_t start = (uintptr_t) entry->base;
+        uintptr_t end   = start + entry->size;
+        bool unmapped = all;
+
+        for (size_t i = 0; (i < count) && !unmapped; i++)
+            unmapped = (ranges[i].first < end) && (start < ranges[i].second);
+        if (!unmapped) {
+            ++it;
+            continue;
+        }
+
+        it = regCache.erase(it);
+        entry->valid = false;
+        if (entry->refCnt == 0) {
+            regCacheLru.erase(entry->lruPos);
+            regCacheIdle -= entry->size;
+            ucp_mem_unmap(ctx->ctx, entry->memh);
+            delete entry;
+        }
+    }
+
+    if (regCache.empty()) {
+        regCacheLo = UINTPTR_MAX;
+        regCacheHi = 0;
+    }
+}
+
+int nixlUcxWorker::regCacheEnable(size_t max_idle_bytes)
+{
+    std::lock_guard<std::mutex> lock(regCacheLock);
+
+    if (max_idle_bytes && !regCacheHooked) {
+        ucs_status_t status = ucm_set_event_handler(UCM_EVENT_VM_UNMAPPED |
+                                                    UCM_EVENT_MEM_TYPE_FREE,
+                                                    0, regCacheUnmapCb, this);
+        if (status != UCS_OK)
+            return -1;
+        regCacheHooked = true;
+    }
+
+    regCacheMax = max_idle_bytes;
+    regCacheEvict(regCacheMax);
+    return 0;
+}
+
+// Unmaps all the unreferenced registrations
+void nixlUcxWorker::regCacheFlush()
+{
+    std::lock_guard<std::mutex> lock(regCacheLock);
+    regCacheInvalidate();
+    regCacheEvict(0);
+}
+
+size_t nixlUcxWorker::regCacheHits()
+{
+    std::lock_guard<std::mutex> lock(regCacheLock);
+    return regCacheHitCnt;
 }
 
 /* ===========================================
@@ -421,6 +666,39 @@ int nixlUcxWorker::progress()
     return ucp_worker_progress(worker);
 }
 
+/* ===========================================
+ * Event driven progress
+ * =========================================== */
+
+int nixlUcxWorker::getEfd(int &fd)
+{
+    if (ucp_worker_get_efd(worker, &fd) != UCS_OK) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Returns NIXL_IN_PROG if there are events to progress before sleeping */
+nixl_status_t nixlUcxWorker::arm()
+{
+    ucs_status_t status = ucp_worker_arm(worker);
+
+    if (status == UCS_OK) {
+        return NIXL_SUCCESS;
+    } else if (status == UCS_ERR_BUSY) {
+        return NIXL_IN_PROG;
+    }
+    return NIXL_ERR_BACKEND;
+}
+
+nixl_status_t nixlUcxWorker::signal()
+{
+    if (ucp_worker_signal(worker) != UCS_OK) {
+        return NIXL_ERR_BACKEND;
+    }
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t nixlUcxWorker::read(nixlUcxEp &ep,
                                   uint64_t raddr, nixlUcxRkey &rk,
                                   void *laddr, nixlUcxMem &mem,
@@ -513,6 +791,16 @@ nixl_status_t nixlUcxWorker::flushEp(nixlUcxEp &ep, nixlUcxReq &req)
     return NIXL_IN_PROG;
 }
 
+/* Operations posted by this thread after the fence start once the ones
+ * before it are done, without waiting for their completion locally */
+nixl_status_t nixlUcxWorker::fence()
+{
+    if (ucp_worker_fence(worker) != UCS_OK) {
+        return NIXL_ERR_BACKEND;
+    }
+    return NIXL_SUCCESS;
+}
+
 void nixlUcxWorker::reqRelease(nixlUcxReq req)
 {
     ucp_request_free((void*)req);
@@ -20,8 +20,14 @@
 extern "C"
 {
 #include <ucp/api/ucp.h>
+#include <ucm/api/ucm.h>
 }
 
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+
 #include "nixl.h"
 
 typedef enum {
@@ -38,15 +44,35 @@ public:
     friend class nixlUcxWorker;
 };
 
+class nixlUcxRegEntry;
+
 class nixlUcxMem {
 private:
     void *base;
     size_t size;
     ucp_mem_h memh;
+    // Set when memh is owned by the registration cache
+    nixlUcxRegEntry *cacheEntry = nullptr;
 public:
     friend class nixlUcxWorker;
 };
 
+/* Cached registration, shared by the regions it covers */
+class nixlUcxRegEntry {
+private:
+    void *base;
+    size_t size;
+    ucp_mem_h memh;
+    size_t refCnt;
+    // Cleared once the range is unmapped, not found again and unmapped
+    // when the last reference is dropped
+    bool valid = true;
+    // Position in the LRU list while unreferenced
+    std::list<nixlUcxRegEntry*>::iterator lruPos;
+
+    friend class nixlUcxWorker;
+};
+
 class nixlUcxRkey {
 private:
     ucp_rkey_h rkeyh;
@@ -68,7 +94,7 @@ public:
     typedef void req_cb_t(void *request);
     nixlUcxContext(std::vector<std::string> devices,
                    size_t req_size, req_cb_t init_cb, req_cb_t fini_cb,
-                   nixl_ucx_mt_t mt_type);
+                   nixl_ucx_mt_t mt_type, bool wakeup = false);
     ~nixlUcxContext();
 
     static bool mtLevelIsSupproted(nixl_ucx_mt_t mt_type);
@@ -82,6 +108,36 @@ private:
     nixlUcxContext *ctx;
     ucp_worker_h worker;
 
+    /* Registration cache, disabled while regCacheMax is 0. Unreferenced
+     * registrations stay mapped until more than regCacheMax bytes of them
+     * are kept, the least recently used are unmapped first. */
+    std::mutex regCacheLock;
+    size_t regCacheMax = 0;
+    size_t regCacheIdle = 0;
+    size_t regCacheHitCnt = 0;
+    std::multimap<uintptr_t, nixlUcxRegEntry*> regCache;
+    std::list<nixlUcxRegEntry*> regCacheLru;
+
+    /* Ranges unmapped or freed by the process, from the UCM events, queued
+     * under a spinlock as the callback can run within any allocation, and
+     * applied under regCacheLock before each lookup. Buffers at the address
+     * of a freed one are mapped again instead of getting the stale memh. */
+    static const size_t regCacheInvalMax = 64;
+    bool regCacheHooked = false;
+    std::atomic_flag regCacheInvalBusy = ATOMIC_FLAG_INIT;
+    std::pair<uintptr_t, uintptr_t> regCacheInval[regCacheInvalMax];
+    size_t regCacheInvalCnt = 0;
+    bool regCacheInvalAll = false;
+    // Bounds of the cached ranges, so the other unmaps are not queued
+    std::atomic<uintptr_t> regCacheLo{UINTPTR_MAX};
+    std::atomic<uintptr_t> regCacheHi{0};
+
+    nixlUcxRegEntry* regCacheFind(void *addr, size_t size);
+    void regCacheEvict(size_t max_idle);
+    void regCacheRemove(nixlUcxRegEntry *entry);
+    void regCacheInvalidate();
+    static void regCacheUnmapCb(ucm_event_type_t type, ucm_event_t *event, void *arg);
+
 public:
     nixlUcxWorker(nixlUcxContext *ctx);
     ~nixlUcxWorker();
@@ -91,12 +147,21 @@ public:
     int connect(void* addr, size_t size, nixlUcxEp &ep);
     int disconnect(nixlUcxEp &ep);
     int disconnect_nb(nixlUcxEp &ep);
+    /* UCX estimate of the time to put size bytes over the endpoint, -1 if unknown */
+    int estimateTime(nixlUcxEp &ep, size_t size, double &seconds);
 
     /* Memory management */
     int memReg(void *addr, size_t size, nixlUcxMem &mem);
     size_t packRkey(nixlUcxMem &mem, uint64_t &addr, size_t &size);
     void memDereg(nixlUcxMem &mem);
 
+    /* Fails if the UCM memory events are not available, as freed buffers
+     * could not be told from new ones at the same address */
+    int regCacheEnable(size_t max_idle_bytes);
+    void regCacheFlush();
+    // Registrations served by an existing mapping since the cache was enabled
+    size_t regCacheHits();
+
     /* Rkey */
     int rkeyImport(nixlUcxEp &ep, void* addr, size_t size, nixlUcxRkey &rkey);
     void rkeyDestroy(nixlUcxRkey &rkey);
@@ -110,9 +175,15 @@ public:
     int getRndvData(void* data_desc, void* buffer, size_t len,
                     const ucp_request_param_t *param, nixlUcxReq &req);
 
+    /* Event driven progress, needs a context created with wakeup */
+    int getEfd(int &fd);
+    nixl_status_t arm();
+    nixl_status_t signal();
+
     /* Data access */
     int progress();
     nixl_status_t flushEp(nixlUcxEp &ep, nixlUcxReq &req);
+    nixl_status_t fence();
     nixl_status_t read(nixlUcxEp &ep,
                        uint64_t raddr, nixlUcxRkey &rk,
                        void *laddr, nixlUcxMem &mem,
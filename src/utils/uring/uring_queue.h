@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __URING_QUEUE_H
+#define __URING_QUEUE_H
+
+#include <liburing.h>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include "nixl_types.h"
+
+// Progress of the IOs of a transfer handle posted to a nixlUringQueue
+class nixlUringReq {
+    public:
+        size_t nextIO = 0;      // First IO not submitted yet
+        size_t inflight = 0;    // Submitted and not completed
+        size_t completed = 0;
+        nixl_status_t status = NIXL_SUCCESS;
+        bool posted = false;
+};
+
+/* An io_uring shared by the transfer handles of a backend. H derives from
+ * nixlUringReq and has the vector ios of its IOs. IO has the owner handle,
+ * the size of the IO and the bytes done so far. The backends fill the
+ * submission entries, in a prep(io) callback returning false when the IO
+ * can't be submitted now, and interpret the results, in a done(io, res)
+ * callback calling complete or fail. All calls are made with lock held. */
+template <class H, class IO>
+class nixlUringQueue {
+    private:
+        const char *name;
+        const char *endName;    // What a read of 0 bytes hit
+        bool ringOn = false;
+        unsigned int depth = 0;
+        unsigned int inflight = 0;
+
+        // Handles with IOs left to submit, and short IOs to finish
+        std::deque<H*> waiting;
+        std::deque<IO*> retries;
+
+    public:
+        struct io_uring ring;
+        std::mutex lock;
+
+        nixlUringQueue(const char *name, const char *end_name)
+            : name(name), endName(end_name) { }
+        ~nixlUringQueue() {
+            if (ringOn) {
+                io_uring_queue_exit(&ring);
+            }
+        }
+
+        nixlUringQueue(const nixlUringQueue&) = delete;
+        nixlUringQueue& operator=(const nixlUringQueue&) = delete;
+
+        // 0, or a negative errno
+        int init(unsigned int queue_depth, unsigned int flags) {
+            int ret = io_uring_queue_init(queue_depth, &ring, flags);
+            if (ret == 0) {
+                ringOn = true;
+                depth = queue_depth;
+            }
+            return ret;
+        }
+
+        bool hasRoom() const {
+            return inflight < depth;
+        }
+
+        // An entry for the backend to fill, nullptr if the ring is full
+        struct io_uring_sqe *getSqe() {
+            return hasRoom() ? io_uring_get_sqe(&ring) : nullptr;
+        }
+
+        // The filled entry of io, in flight until its completion
+        void track(struct io_uring_sqe *sqe, IO *io) {
+            io_uring_sqe_set_data(sqe, io);
+            io->owner->inflight++;
+            inflight++;
+        }
+
+        template <class Prep>
+        void post(H *handle, Prep prep) {
+            for (auto &io : handle->ios) {
+                io.done = 0;
+            }
+            handle->nextIO = 0;
+            handle->completed = 0;
+            handle->status = NIXL_SUCCESS;
+            handle->posted = true;
+
+            waiting.push_back(handle);
+            submitPending(prep);
+        }
+
+        template <class Prep>
+        void submitPending(Prep prep) {
+            bool added = false;
+
+            while (!retries.empty() && prep(retries.front())) {
+                retries.pop_front();
+                added = true;
+            }
+
+            while (retries.empty() && !waiting.empty()) {
+                H *handle = waiting.front();
+
+                // Stop submitting for a failed handle
+                if ((handle->status != NIXL_SUCCESS) ||
+                    (handle->nextIO == handle->ios.size())) {
+                    handle->completed += handle->ios.size() - handle->nextIO;
+                    handle->nextIO = handle->ios.size();
+                    waiting.pop_front();
+                    continue;
+                }
+
+                if (!prep(&handle->ios[handle->nextIO])) {
+                    break;
+                }
+                handle->nextIO++;
+                added = true;
+            }
+
+            if (added) {
+                io_uring_submit(&ring);
+            }
+        }
+
+        // A read or write result of io. False if it was short, and the rest
+        // is queued to go out first.
+        bool complete(IO *io, int res) {
+            H *handle = io->owner;
+
+            handle->inflight--;
+            inflight--;
+
+            if (res <= 0) {
+                std::cerr << name << " IO failed: " << (res ? strerror(-res) : endName)
+                          << std::endl;
+                handle->status = NIXL_ERR_BACKEND;
+            } else {
+                io->done += res;
+                if ((io->done < io->size) && (handle->status == NIXL_SUCCESS)) {
+                    retries.push_back(io);
+                    return false;
+                }
+            }
+            handle->completed++;
+            return true;
+        }
+
+        // An IO failed in a way the backend reported
+        void fail(IO *io) {
+            io->owner->inflight--;
+            inflight--;
+            io->owner->status = NIXL_ERR_BACKEND;
+            io->owner->completed++;
+        }
+
+        // On polled rings peeking also polls the device for completions
+        template <class Done>
+        void reap(Done done) {
+            struct io_uring_cqe *cqe;
+
+            while ((inflight > 0) && (io_uring_peek_cqe(&ring, &cqe) == 0)) {
+                IO *io = (IO *) io_uring_cqe_get_data(cqe);
+                int res = cqe->res;
+
+                io_uring_cqe_seen(&ring, cqe);
+                done(io, res);
+            }
+        }
+
+        // NIXL_IN_PROG until all the IOs of the handle completed
+        template <class Prep, class Done>
+        nixl_status_t check(H *handle, Prep prep, Done done) {
+            reap(done);
+            submitPending(prep);
+
+            if (handle->completed < handle->ios.size()) {
+                return NIXL_IN_PROG;
+            }
+            handle->posted = false;
+            return handle->status;
+        }
+
+        // A posted handle being released. Nothing is cancelled, the IOs
+        // submitted still point into it and are waited for. The short ones
+        // not resubmitted are passed to drop.
+        template <class Done, class Drop>
+        void release(H *handle, Done done, Drop drop) {
+            handle->status = NIXL_ERR_BACKEND;
+            waiting.erase(std::remove(waiting.begin(), waiting.end(), handle),
+                          waiting.end());
+            retries.erase(std::remove_if(retries.begin(), retries.end(),
+                                         [&](IO *io) {
+                                             if (io->owner != handle) {
+                                                 return false;
+                                             }
+                                             drop(io);
+                                             return true;
+                                         }),
+                          retries.end());
+
+            while (handle->inflight > 0) {
+                struct io_uring_cqe *cqe = nullptr;
+                if (io_uring_wait_cqe(&ring, &cqe) != 0) {
+                    break;
+                }
+                IO *io = (IO *) io_uring_cqe_get_data(cqe);
+                int res = cqe->res;
+                io_uring_cqe_seen(&ring, cqe);
+                done(io, res);
+            }
+        }
+};
+
+#endif
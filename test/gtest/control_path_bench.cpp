@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmarks of the control path of the agent, over the MOCK_DRAM backend so
+// that only the bookkeeping of NIXL is measured. Besides the time, the heap
+// allocations per operation are reported, counted by a replaced operator new.
+#include <benchmark/benchmark.h>
+#include "nixl.h"
+#include "serdes/serdes.h"
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Per thread, so that counting does not add contention to multi-threaded runs
+thread_local uint64_t allocations = 0;
+
+void* countedAlloc(size_t size) {
+    allocations++;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+const size_t block_len = 64;
+
+// Allocations of the calling thread since start, reported averaged over the
+// iterations of all the threads
+class allocCounter {
+    private:
+        benchmark::State &state;
+        uint64_t          start;
+
+    public:
+        allocCounter(benchmark::State &state) : state(state), start(allocations) {}
+
+        ~allocCounter() {
+            state.counters["allocs/op"] = benchmark::Counter(
+                    allocations - start, benchmark::Counter::kAvgIterations);
+        }
+};
+
+// An agent over MOCK_DRAM with a section of the given number of regions, each of
+// block_len bytes, transfers of which are made to itself
+class benchAgent {
+    public:
+        std::string       name;
+        nixlAgent         agent;
+        nixl_opt_args_t   params;
+        std::vector<char> buffer;
+        nixl_status_t     status;
+
+        benchAgent(const std::string &agent_name, size_t regions)
+            : name(agent_name),
+              agent(agent_name, nixlAgentConfig(false, false, 0, 0, 100000,
+                                                nixl_thread_sync_t::NIXL_THREAD_SYNC_RW)),
+              buffer(regions * block_len) {
+            nixlBackendH*  backend = nullptr;
+            nixl_b_params_t b_params;
+
+            status = agent.createBackend("MOCK_DRAM", b_params, backend);
+            if (status != NIXL_SUCCESS)
+                return;
+            params.backends = {backend};
+
+            nixl_reg_dlist_t reg_list(DRAM_SEG);
+            for (size_t i = 0; i < regions; i++)
+                reg_list.addDesc(nixlBlobDesc(addr(i), block_len, 0, ""));
+            status = agent.registerMem(reg_list, &params);
+        }
+
+        uintptr_t addr(size_t region) const {
+            return reinterpret_cast<uintptr_t>(buffer.data()) + region * block_len;
+        }
+
+        // Descriptors spread over the whole section
+        nixl_xfer_dlist_t makeDlist(size_t count) const {
+            size_t            regions = buffer.size() / block_len;
+            nixl_xfer_dlist_t dlist(DRAM_SEG);
+            for (size_t i = 0; i < count; i++)
+                dlist.addDesc(nixlBasicDesc(addr((i * 7919) % regions), block_len, 0));
+            return dlist;
+        }
+};
+
+// Agents are kept across benchmarks and shared by their threads
+benchAgent& getAgent(size_t regions) {
+    static std::mutex                                     lock;
+    static std::map<size_t, std::unique_ptr<benchAgent>> agents;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto &agent = agents[regions];
+    if (!agent)
+        agent = std::make_unique<benchAgent>("bench_agent_" + std::to_string(regions),
+                                             regions);
+    return *agent;
+}
+
+bool checkStatus(benchmark::State &state, nixl_status_t status, const char* what) {
+    if (status == NIXL_SUCCESS)
+        return true;
+    state.SkipWithError((std::string(what) + " failed: " + nixlEnumStrings::statusStr(status))
+                        .c_str());
+    return false;
+}
+
+const size_t default_regions = 4096;
+
+void BM_CreateXferReq(benchmark::State &state) {
+    benchAgent&       bench = getAgent(default_regions);
+    nixl_xfer_dlist_t dlist = bench.makeDlist(state.range(0));
+    nixlXferReqH*     req   = nullptr;
+
+    if (!checkStatus(state, bench.status, "agent setup"))
+        return;
+
+    allocCounter counter(state);
+    for (auto _ : state) {
+        nixl_status_t ret = bench.agent.createXferReq(NIXL_WRITE, dlist, dlist, bench.name,
+                                                      req, &bench.params);
+        if (!checkStatus(state, ret, "createXferReq"))
+            break;
+        bench.agent.releaseXferReq(req);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateXferReq)->RangeMultiplier(16)->Range(1, 4096)->ThreadRange(1, 8)
+                           ->UseRealTime();
+
+void BM_MakeXferReq(benchmark::State &state) {
+    benchAgent&       bench = getAgent(default_regions);
+    nixl_xfer_dlist_t dlist = bench.makeDlist(state.range(0));
+    nixlDlistH*       local_hndl  = nullptr;
+    nixlDlistH*       remote_hndl = nullptr;
+    nixlXferReqH*     req   = nullptr;
+    std::vector<int>  indices(state.range(0));
+
+    if (!checkStatus(state, bench.status, "agent setup") ||
+        !checkStatus(state, bench.agent.prepXferDlist(NIXL_INIT_AGENT, dlist, local_hndl,
+                                                      &bench.params), "prepXferDlist") ||
+        !checkStatus(state, bench.agent.prepXferDlist(bench.name, dlist, remote_hndl,
+                                                      &bench.params), "prepXferDlist"))
+        return;
+
+    for (size_t i = 0; i < indices.size(); i++)
+        indices[i] = i;
+
+    {
+        allocCounter counter(state);
+        for (auto _ : state) {
+            nixl_status_t ret = bench.agent.makeXferReq(NIXL_WRITE, local_hndl, indices,
+                                                        remote_hndl, indices, req,
+                                                        &bench.params);
+            if (!checkStatus(state, ret, "makeXferReq"))
+                break;
+            bench.agent.releaseXferReq(req);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    bench.agent.releasedDlistH(local_hndl);
+    bench.agent.releasedDlistH(remote_hndl);
+}
+BENCHMARK(BM_MakeXferReq)->RangeMultiplier(16)->Range(1, 4096)->ThreadRange(1, 8)
+                         ->UseRealTime();
+
+// Looks the descriptors up in the section, through nixlMemSection::populate
+void BM_PrepXferDlist(benchmark::State &state) {
+    benchAgent&       bench = getAgent(state.range(0));
+    nixl_xfer_dlist_t dlist = bench.makeDlist(state.range(1));
+    nixlDlistH*       hndl  = nullptr;
+
+    if (!checkStatus(state, bench.status, "agent setup"))
+        return;
+
+    allocCounter counter(state);
+    for (auto _ : state) {
+        nixl_status_t ret = bench.agent.prepXferDlist(bench.name, dlist, hndl, &bench.params);
+        if (!checkStatus(state, ret, "prepXferDlist"))
+            break;
+        bench.agent.releasedDlistH(hndl);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_PrepXferDlist)->ArgNames({"regions", "descs"})
+                           ->ArgsProduct({{256, 4096, 65536}, {1, 16, 256, 4096}})
+                           ->ThreadRange(1, 8)->UseRealTime();
+
+void BM_SerDesDlist(benchmark::State &state) {
+    nixlSerDes::ser_format_t format = state.range(1) ? nixlSerDes::BINARY : nixlSerDes::TAGGED;
+    bool                     packed = state.range(1) > 1;
+    nixl_xfer_dlist_t        dlist  = getAgent(default_regions).makeDlist(state.range(0));
+    size_t                   bytes  = 0;
+
+    allocCounter counter(state);
+    for (auto _ : state) {
+        nixlSerDes ser(format);
+        if (!checkStatus(state, dlist.serialize(&ser, packed), "serialize"))
+            break;
+        std::string str = ser.exportStr();
+        bytes = str.size();
+
+        nixlSerDes des;
+        if (!checkStatus(state, des.importStr(std::move(str)), "importStr"))
+            break;
+        nixl_xfer_dlist_t copy(&des);
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = bytes;
+}
+// Format 0 is tagged, 1 binary and 2 binary with packed descriptors
+BENCHMARK(BM_SerDesDlist)->ArgNames({"descs", "format"})
+                         ->ArgsProduct({{1, 16, 256, 4096}, {0, 1, 2}});
+
+// Loads the metadata of an agent with the given number of regions
+void BM_LoadRemoteMD(benchmark::State &state) {
+    benchAgent& remote = getAgent(state.range(0));
+    benchAgent& local  = getAgent(1);
+    nixl_blob_t md;
+    std::string remote_name;
+
+    if (!checkStatus(state, remote.status, "agent setup") ||
+        !checkStatus(state, local.status, "agent setup") ||
+        !checkStatus(state, remote.agent.getLocalMD(md), "getLocalMD"))
+        return;
+
+    {
+        allocCounter counter(state);
+        for (auto _ : state) {
+            if (!checkStatus(state, local.agent.loadRemoteMD(md, remote_name), "loadRemoteMD") ||
+                !checkStatus(state, local.agent.invalidateRemoteMD(remote_name),
+                             "invalidateRemoteMD"))
+                break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * md.size());
+}
+BENCHMARK(BM_LoadRemoteMD)->ArgName("regions")->RangeMultiplier(16)->Range(256, 65536);
+
+// Polls without notifications pending, the common case of a busy loop
+void BM_GetNotifs(benchmark::State &state) {
+    benchAgent&       bench = getAgent(default_regions);
+    nixl_notif_list_t notif_list;
+
+    if (!checkStatus(state, bench.status, "agent setup"))
+        return;
+
+    allocCounter counter(state);
+    for (auto _ : state) {
+        notif_list.clear();
+        bench.agent.getNotifs(notif_list);
+    }
+}
+BENCHMARK(BM_GetNotifs)->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace
+
+// NIXL_PLUGIN_DIR is to point to the directory of the MOCK_DRAM plugin
+BENCHMARK_MAIN();
@@ -18,7 +18,10 @@
 
 namespace mocks {
 
-MockDramBackendEngine::~MockDramBackendEngine() {}
+MockDramBackendEngine::~MockDramBackendEngine() {
+  if (progressDriver)
+    progressDriver->removeEngine(this);
+}
 
 nixl_status_t MockDramBackendEngine::registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
                                                 nixlBackendMD *&out) {
@@ -63,11 +66,13 @@ nixl_status_t MockDramBackendEngine::postXfer(const nixl_xfer_op_t &operation,
                                              nixlBackendReqH *&handle,
                                              const nixl_opt_b_args_t *opt_args) {
   sharedState++;
-  return NIXL_SUCCESS;
+  return inProgChecks ? NIXL_IN_PROG : NIXL_SUCCESS;
 }
 
 nixl_status_t MockDramBackendEngine::checkXfer(nixlBackendReqH *handle) {
   sharedState++;
+  if (inProgChecks && (++checks % inProgChecks) != 0)
+    return NIXL_IN_PROG;
   return NIXL_SUCCESS;
 }
 
@@ -87,6 +92,7 @@ nixl_status_t MockDramBackendEngine::loadRemoteMD(const nixlBlobDesc &input,
                                                  const std::string &remote_agent,
                                                  nixlBackendMD *&output) {
   sharedState++;
+  output = nullptr;
   return NIXL_SUCCESS;
 }
 
@@ -107,8 +113,42 @@ nixl_status_t MockDramBackendEngine::genNotif(const std::string &remote_agent,
   return NIXL_SUCCESS;
 }
 
+nixl_status_t MockDramBackendEngine::getXferHints(const nixl_mem_t &local_mem,
+                                                  const nixl_mem_t &remote_mem,
+                                                  nixlBackendXferHints &hints) const {
+  assert(sharedState > 0);
+  if (bandwidthGBps == 0)
+    return NIXL_ERR_NOT_SUPPORTED;
+  hints.bandwidthGBps = bandwidthGBps;
+  hints.latencyUs = 1;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockDramBackendEngine::getPeerXferHints(const nixl_mem_t &local_mem,
+                                                      const nixl_mem_t &remote_mem,
+                                                      const std::string &remote_agent,
+                                                      nixlBackendXferHints &hints) const {
+  nixl_status_t ret = getXferHints(local_mem, remote_mem, hints);
+  if ((ret == NIXL_SUCCESS) && (peerBandwidthGBps > 0) && (remote_agent == hintPeer))
+    hints.bandwidthGBps = peerBandwidthGBps;
+  return ret;
+}
+
 int MockDramBackendEngine::progress() {
   sharedState++;
   return 0;
 }
+
+bool MockDramBackendEngine::progressRound() {
+  if (progressDriver->isProgressThread())
+    progressRounds++;
+  return false;
+}
+
+nixl_status_t MockDramBackendEngine::getXferStats(const nixlBackendReqH *handle,
+                                                  nixl_b_params_t &stats) const {
+  assert(sharedState > 0);
+  stats["progress_rounds"] = std::to_string(progressRounds);
+  return NIXL_SUCCESS;
+}
 } // namespace mocks
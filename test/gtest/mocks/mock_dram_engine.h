@@ -20,12 +20,27 @@
 #include "backend/backend_engine.h"
 #include "backend/backend_plugin.h"
 #include <cassert>
+#include <atomic>
+#include <string>
 
 namespace mocks {
 
 class MockDramBackendEngine : public nixlBackendEngine {
 public:
-  MockDramBackendEngine(const nixlBackendInitParams *init_params) : nixlBackendEngine(init_params), sharedState(1) {}
+  MockDramBackendEngine(const nixlBackendInitParams *init_params)
+      : nixlBackendEngine(init_params), sharedState(1),
+        progressDriver(init_params->enableProgTh ? init_params->progressDriver : nullptr) {
+    if (progressDriver)
+      progressDriver->addEngine(this);
+    if (init_params->customParams->count("in_prog_checks"))
+      inProgChecks = std::stoul(init_params->customParams->at("in_prog_checks"));
+    if (init_params->customParams->count("bandwidth_gbps"))
+      bandwidthGBps = std::stod(init_params->customParams->at("bandwidth_gbps"));
+    if (init_params->customParams->count("hint_peer"))
+      hintPeer = init_params->customParams->at("hint_peer");
+    if (init_params->customParams->count("peer_bandwidth_gbps"))
+      peerBandwidthGBps = std::stod(init_params->customParams->at("peer_bandwidth_gbps"));
+  }
   ~MockDramBackendEngine();
 
   bool supportsRemote() const override {
@@ -42,7 +57,7 @@ public:
   }
   bool supportsProgTh() const override {
     assert(sharedState > 0);
-    return false;
+    return progressDriver != nullptr;
   }
   nixl_mem_list_t getSupportedMems() const override {
     assert(sharedState > 0);
@@ -72,8 +87,17 @@ public:
     assert(sharedState > 0);
     return NIXL_SUCCESS;
   }
+  bool supportsConcurrentLoad() const override {
+    assert(sharedState > 0);
+    return true;
+  }
+  bool supportsConcurrentReg() const override {
+    assert(sharedState > 0);
+    return true;
+  }
   nixl_status_t getConnInfo(std::string &str) const override {
     assert(sharedState > 0);
+    str = "mock";
     return NIXL_SUCCESS;
   }
   nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
@@ -86,12 +110,33 @@ public:
   nixl_status_t getNotifs(notif_list_t &notif_list) override;
   nixl_status_t genNotif(const std::string &remote_agent,
                          const std::string &msg) override;
+  nixl_status_t getXferHints(const nixl_mem_t &local_mem, const nixl_mem_t &remote_mem,
+                             nixlBackendXferHints &hints) const override;
+  nixl_status_t getPeerXferHints(const nixl_mem_t &local_mem, const nixl_mem_t &remote_mem,
+                                 const std::string &remote_agent,
+                                 nixlBackendXferHints &hints) const override;
   int progress() override;
+  bool progressRound() override;
+  // Rounds run by the progress thread of the agent
+  nixl_status_t getXferStats(const nixlBackendReqH *handle,
+                             nixl_b_params_t &stats) const override;
 
 private:
   // This represents an engine shared state that is read in every const method and modified in non-cost ones
-  // The purpose is to trigger thread sanitizer in multi-threading tests
-  int sharedState;
+  // It is atomic as a thread safe backend is required by NIXL_THREAD_SYNC_RW, where the agent
+  // calls into the engine concurrently. Races in the agent are still caught by thread sanitizer.
+  std::atomic<int> sharedState;
+  nixlProgressDriver *progressDriver;
+  std::atomic<uint64_t> progressRounds{0};
+  // With in_prog_checks, transfers are posted in progress, and every
+  // in_prog_checks-th checkXfer completes one
+  unsigned inProgChecks = 0;
+  std::atomic<unsigned> checks{0};
+  // With bandwidth_gbps the mock declares hints, and with hint_peer and
+  // peer_bandwidth_gbps other ones for that peer
+  double bandwidthGBps = 0;
+  std::string hintPeer;
+  double peerBandwidthGBps = 0;
 };
 } // namespace mocks
 
@@ -25,7 +25,12 @@ static nixlBackendEngine *create_engine(const nixlBackendInitParams *params) {
 
 static void destroy_engine(nixlBackendEngine *engine) { delete engine; }
 
-static const char *get_plugin_name() { return "MOCK_DRAM"; }
+// Also built as a second plugin, to have several backends in an agent
+#ifndef MOCK_DRAM_PLUGIN_NAME
+#define MOCK_DRAM_PLUGIN_NAME "MOCK_DRAM"
+#endif
+
+static const char *get_plugin_name() { return MOCK_DRAM_PLUGIN_NAME; }
 
 static const char *get_plugin_version() { return "0.0.1"; }
 
@@ -17,20 +17,49 @@
 #include <gtest/gtest.h>
 #include "nixl.h"
 #include "plugin_manager.h"
+#include "nixl_coro.h"
 #include <thread>
+#include <chrono>
+#include <iostream>
 #include <filesystem>
+#include <sched.h>
+#include <atomic>
+#include <memory>
+#include <unistd.h>
 
 namespace gtest {
 namespace multi_threading {
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+// Coroutine that starts at once and frees itself when done
+struct detachedTask {
+    struct promise_type {
+        detachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+detachedTask awaitTransfers(nixlXferDispatcher &dispatcher, nixlXferReqH* req,
+                            size_t count, std::atomic<size_t> &done) {
+    for (size_t i = 0; i < count; i++) {
+        nixl_status_t ret = co_await dispatcher.transfer(req);
+        EXPECT_EQ(ret, NIXL_SUCCESS);
+        done++;
+    }
+}
+#endif
+
 class MultiThreadingTestFixture : public testing::Test {
 protected:
     uintptr_t addr = 0;
     size_t len = 1024;
     uint64_t dev_id = 0;
 
-    nixlAgent createAgent() {
-        nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT);
+    nixlAgent createAgent(nixl_thread_sync_t sync_mode = nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT) {
+        nixlAgentConfig cfg(false, false, 0, 0, 100000, sync_mode);
         return nixlAgent("test_agent", cfg);
     }
 
@@ -80,6 +109,22 @@ protected:
         status = agent.releaseXferReq(xfer_req);
         EXPECT_EQ(status, NIXL_SUCCESS);
     }
+
+    // Metadata exchanged through the listener or the metadata server is
+    // loaded on the listener thread, it is waited for here
+    bool waitForRemoteMD(nixlAgent& agent, const std::string &remote_agent,
+                         const nixlDescList<nixlBasicDesc> &descs, bool loaded = true) {
+        for (int i = 0; i < 500; i++) {
+            nixlDlistH* dlist_hndl = nullptr;
+            bool found = (agent.prepXferDlist(remote_agent, descs, dlist_hndl) == NIXL_SUCCESS);
+            if (found)
+                EXPECT_EQ(agent.releasedDlistH(dlist_hndl), NIXL_SUCCESS);
+            if (found == loaded)
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
 };
 
 TEST_F(MultiThreadingTestFixture, ConcurrentTransfersWithPerThreadAgent) {
@@ -156,6 +201,1178 @@ TEST_F(MultiThreadingTestFixture, ConcurrentTransfers) {
     t2.join();
 }
 
+TEST_F(MultiThreadingTestFixture, RegisterMemWithRwLockMixedWithTransfers) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(agent, extra_params);
+
+    // Registrations take the lock exclusively while transfers share it
+    std::thread t1([&]() {
+        for (int i = 0; i < 100; i++)
+            verifyTransfer(agent, extra_params);
+    });
+    std::thread t2([&]() {
+        for (int i = 0; i < 100; i++) {
+            nixlBlobDesc blob(addr + len * (i + 1), len, dev_id, "");
+            nixlDescList<nixlBlobDesc> desc_list(DRAM_SEG);
+            desc_list.addDesc(blob);
+            EXPECT_EQ(agent.registerMem(desc_list, &extra_params), NIXL_SUCCESS);
+        }
+    });
+
+    t1.join();
+    t2.join();
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentBatchedTransfers) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    const int batch_size = 16;
+
+    verifyMemoryRegistration(agent, extra_params);
+
+    auto transfer_sequence = [&]() {
+        std::vector<nixlXferReqH*> reqs(batch_size);
+        std::vector<nixl_status_t> statuses;
+        nixlDescList<nixlBasicDesc> src_list(DRAM_SEG);
+        nixlDescList<nixlBasicDesc> dst_list(DRAM_SEG);
+
+        src_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+        dst_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+        for (auto &req : reqs)
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, src_list, dst_list, "test_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+
+        EXPECT_EQ(agent.postXferReqs(reqs, statuses), NIXL_SUCCESS);
+        EXPECT_EQ(statuses.size(), reqs.size());
+
+        EXPECT_EQ(agent.getXferStatus(reqs, statuses), NIXL_SUCCESS);
+        for (auto status : statuses)
+            EXPECT_EQ(status, NIXL_SUCCESS);
+
+        for (auto &req : reqs)
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    };
+
+    std::thread t1(transfer_sequence);
+    std::thread t2(transfer_sequence);
+
+    t1.join();
+    t2.join();
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentTransfersWithCompletionQueue) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    const size_t per_thread = 64;
+    int fd = -1;
+
+    extra_params.useCompletionQueue = true;
+    verifyMemoryRegistration(agent, extra_params);
+    EXPECT_EQ(agent.getCompletionFd(fd), NIXL_SUCCESS);
+    EXPECT_GE(fd, 0);
+
+    auto transfer_sequence = [&]() {
+        nixlDescList<nixlBasicDesc> src_list(DRAM_SEG);
+        nixlDescList<nixlBasicDesc> dst_list(DRAM_SEG);
+
+        src_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+        dst_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+        for (size_t i = 0; i < per_thread; i++) {
+            nixlXferReqH* req = nullptr;
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, src_list, dst_list, "test_agent", req, &extra_params),
+                      NIXL_SUCCESS);
+            EXPECT_NE(agent.postXferReq(req), NIXL_IN_PROG);
+        }
+    };
+
+    std::thread t1(transfer_sequence);
+    std::thread t2(transfer_sequence);
+
+    std::vector<nixlXferReqH*> all;
+    std::vector<nixlXferReqH*> completed;
+    while (all.size() < 2 * per_thread) {
+        EXPECT_EQ(agent.pollCompletions(16, completed), NIXL_SUCCESS);
+        EXPECT_LE(completed.size(), size_t(16));
+        all.insert(all.end(), completed.begin(), completed.end());
+    }
+
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(agent.pollCompletions(16, completed), NIXL_SUCCESS);
+    EXPECT_TRUE(completed.empty());
+
+    for (auto &req : all) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+}
+
+TEST_F(MultiThreadingTestFixture, TransferCallbacks) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"in_prog_checks", "2"}};
+    EXPECT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    std::atomic<size_t> done{0};
+    extra_params.xferCallback = [](nixlXferReqH* req, nixl_status_t status, void* ctx) {
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        (*static_cast<std::atomic<size_t>*>(ctx))++;
+    };
+    extra_params.xferCallbackCtx = &done;
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    const size_t count = 16;
+    std::vector<nixlXferReqH*> reqs(count);
+    for (auto &req : reqs) {
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                      &extra_params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.postXferReq(req), NIXL_IN_PROG);
+    }
+
+    // Found done by polling, the requests are reported to the callback only
+    std::vector<nixlXferReqH*> completed;
+    while (done < count) {
+        EXPECT_EQ(agent.pollCompletions(count, completed), NIXL_SUCCESS);
+        EXPECT_TRUE(completed.empty());
+    }
+
+    EXPECT_EQ(done, count);
+    for (auto &req : reqs) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentGetNotifsIntoReusedList) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    verifyMockDramBackendCreation(agent);
+
+    auto notif_sequence = [&]() {
+        nixl_notif_list_t notif_list;
+
+        for (int i = 0; i < 1000; i++) {
+            notif_list.clear();
+            EXPECT_EQ(agent.getNotifs(notif_list), NIXL_SUCCESS);
+            EXPECT_TRUE(notif_list.empty());
+        }
+    };
+
+    std::thread t1(notif_sequence);
+    std::thread t2(notif_sequence);
+
+    t1.join();
+    t2.join();
+
+    nixl_notif_list_t notif_list;
+    notif_list.add("agent_a", "msg1");
+    notif_list.add("agent_b", "msg2");
+    notif_list.add("agent_a", "msg3");
+    EXPECT_EQ(notif_list.size(), size_t(3));
+    EXPECT_EQ(notif_list.agentCount(), size_t(2));
+    EXPECT_EQ(notif_list.getAgentId(0), notif_list.getAgentId(2));
+    EXPECT_EQ(notif_list.agentName(notif_list.getAgentId(1)), "agent_b");
+    EXPECT_EQ(notif_list.getMsg(2), "msg3");
+
+    notif_list.clear();
+    notif_list.add("agent_b", "msg4");
+    EXPECT_EQ(notif_list.size(), size_t(1));
+    EXPECT_EQ(notif_list.getAgentId(0), notif_list.agentId("agent_b"));
+    EXPECT_EQ(notif_list.getMsg(0), "msg4");
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentTransfersWithBackendPolicies) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* slow = nullptr;
+    nixlBackendH* fast = nullptr;
+    nixl_b_params_t slow_params = {{"bandwidth_gbps", "10"}};
+    nixl_b_params_t fast_params = {{"bandwidth_gbps", "100"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM", slow_params, slow), NIXL_SUCCESS);
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM_ALT", fast_params, fast), NIXL_SUCCESS);
+
+    // Registered with both backends
+    nixlDescList<nixlBlobDesc> desc_list(DRAM_SEG);
+    desc_list.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    ASSERT_EQ(agent.registerMem(desc_list), NIXL_SUCCESS);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    // No backends hint, so the candidates come from the registrations
+    nixl_opt_args_t first_params, pref_params, pref_slow_params, cost_params;
+    pref_params.backendPolicy = nixl_backend_policy_t::NIXL_BACKEND_POLICY_PREFERENCE;
+    pref_params.backendPreference = {"UNKNOWN", "MOCK_DRAM_ALT"};
+    pref_slow_params.backendPolicy = nixl_backend_policy_t::NIXL_BACKEND_POLICY_PREFERENCE;
+    pref_slow_params.backendPreference = {"MOCK_DRAM"};
+    cost_params.backendPolicy = nixl_backend_policy_t::NIXL_BACKEND_POLICY_COST;
+
+    auto selected = [&](const nixl_opt_args_t &params) {
+        nixlXferReqH* req = nullptr;
+        nixlBackendH* backend = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                      &params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.queryXferBackend(req, backend), NIXL_SUCCESS);
+        nixl_status_t ret = agent.postXferReq(req);
+        while (ret == NIXL_IN_PROG)
+            ret = agent.getXferStatus(req);
+        EXPECT_EQ(ret, NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        return backend;
+    };
+
+    // The default policy takes the first backend created, the others reorder
+    EXPECT_EQ(selected(first_params), slow);
+
+    std::thread t1([&]() {
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ(selected(pref_params), fast);
+            EXPECT_EQ(selected(pref_slow_params), slow);
+        }
+    });
+    std::thread t2([&]() {
+        for (int i = 0; i < 100; i++)
+            EXPECT_EQ(selected(cost_params), fast);
+    });
+
+    t1.join();
+    t2.join();
+}
+
+TEST_F(MultiThreadingTestFixture, SplitTransfersAcrossBackends) {
+#ifdef DISABLE_TELEMETRY
+    GTEST_SKIP() << "Telemetry is not built in";
+#endif
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.enableTelemetry = true;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* slow = nullptr;
+    nixlBackendH* fast = nullptr;
+    nixl_b_params_t slow_params = {{"bandwidth_gbps", "10"}};
+    nixl_b_params_t fast_params = {{"bandwidth_gbps", "100"}, {"in_prog_checks", "2"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM", slow_params, slow), NIXL_SUCCESS);
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM_ALT", fast_params, fast), NIXL_SUCCESS);
+
+    const size_t desc_count = 8;
+    nixlDescList<nixlBlobDesc> desc_list(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    desc_list.addDesc(nixlBlobDesc(addr, len * desc_count, dev_id, ""));
+    for (size_t i = 0; i < desc_count; i++)
+        xfer_list.addDesc(nixlBasicDesc(addr + i * len, len, dev_id));
+    ASSERT_EQ(agent.registerMem(desc_list), NIXL_SUCCESS);
+
+    // The cheaper backend leads, and the request is done when both pieces are
+    nixl_opt_args_t params;
+    params.backendPolicy = nixl_backend_policy_t::NIXL_BACKEND_POLICY_COST;
+    params.splitCount = 2;
+    const size_t posts = 16;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&]() {
+            nixlXferReqH* req = nullptr;
+            nixlBackendH* backend = nullptr;
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                          &params), NIXL_SUCCESS);
+            EXPECT_EQ(agent.queryXferBackend(req, backend), NIXL_SUCCESS);
+            EXPECT_EQ(backend, fast);
+            for (size_t i = 0; i < posts; i++) {
+                nixl_status_t ret = agent.postXferReq(req);
+                while (ret == NIXL_IN_PROG)
+                    ret = agent.getXferStatus(req);
+                EXPECT_EQ(ret, NIXL_SUCCESS);
+            }
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    // Equal shares of the bytes on each backend
+    nixl_xfer_telemetry_t telemetry;
+    ASSERT_EQ(agent.getTelemetry(telemetry), NIXL_SUCCESS);
+    ASSERT_EQ(telemetry.size(), 2);
+    for (auto &entry : telemetry) {
+        EXPECT_TRUE((entry.backend == "MOCK_DRAM") || (entry.backend == "MOCK_DRAM_ALT"));
+        EXPECT_EQ(entry.posts, 2 * posts);
+        EXPECT_EQ(entry.bytes, 2 * posts * len * desc_count / 2);
+    }
+    EXPECT_NE(telemetry[0].backend, telemetry[1].backend);
+}
+
+TEST_F(MultiThreadingTestFixture, BackendXferHints) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_xfer_hints_t hints;
+
+    EXPECT_EQ(agent.getBackendXferHints(nullptr, DRAM_SEG, DRAM_SEG, "", hints),
+              NIXL_ERR_INVALID_PARAM);
+    // The mock declares no hints, neither for a pair of memory types nor a peer
+    EXPECT_EQ(agent.getBackendXferHints(backend, DRAM_SEG, DRAM_SEG, "", hints),
+              NIXL_ERR_NOT_SUPPORTED);
+    EXPECT_EQ(agent.getBackendXferHints(backend, DRAM_SEG, DRAM_SEG, "peer", hints),
+              NIXL_ERR_NOT_SUPPORTED);
+    EXPECT_EQ(hints.bandwidthGBps, 0);
+    EXPECT_EQ(hints.chunkSize, size_t(0));
+}
+
+TEST_F(MultiThreadingTestFixture, BackendPeerXferHints) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"bandwidth_gbps", "10"}, {"hint_peer", "near"},
+                              {"peer_bandwidth_gbps", "50"}};
+    ASSERT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_xfer_hints_t hints;
+
+    // Declared for the memory types, and specific to one peer
+    EXPECT_EQ(agent.getBackendXferHints(backend, DRAM_SEG, DRAM_SEG, "", hints),
+              NIXL_SUCCESS);
+    EXPECT_EQ(hints.bandwidthGBps, 10);
+    EXPECT_EQ(hints.latencyUs, 1);
+    EXPECT_EQ(agent.getBackendXferHints(backend, DRAM_SEG, DRAM_SEG, "far", hints),
+              NIXL_SUCCESS);
+    EXPECT_EQ(hints.bandwidthGBps, 10);
+    EXPECT_EQ(agent.getBackendXferHints(backend, DRAM_SEG, DRAM_SEG, "near", hints),
+              NIXL_SUCCESS);
+    EXPECT_EQ(hints.bandwidthGBps, 50);
+    EXPECT_EQ(hints.latencyUs, 1);
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentRemoteMDImports) {
+    const int desc_count = 3000;
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.mdImportThreads = 4;
+    nixlAgent target("target", cfg);
+    verifyMockDramBackendCreation(target);
+
+    std::vector<nixl_blob_t> metadata;
+    nixlDescList<nixlBlobDesc> desc_list(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    for (int i = 0; i < desc_count; i++) {
+        desc_list.addDesc(nixlBlobDesc(addr + i * len, len, dev_id, ""));
+        xfer_list.addDesc(nixlBasicDesc(addr + i * len, len, dev_id));
+    }
+    for (int i = 0; i < 4; i++) {
+        nixlAgent source("source" + std::to_string(i), cfg);
+        verifyMockDramBackendCreation(source);
+        EXPECT_EQ(source.registerMem(desc_list), NIXL_SUCCESS);
+        metadata.emplace_back();
+        EXPECT_EQ(source.getLocalMD(metadata.back()), NIXL_SUCCESS);
+        EXPECT_EQ(source.deregisterMem(desc_list), NIXL_SUCCESS);
+    }
+
+    std::vector<std::thread> threads;
+    for (auto &md : metadata)
+        threads.emplace_back([&]() {
+            std::string name;
+            EXPECT_EQ(target.loadRemoteMD(md, name), NIXL_SUCCESS);
+        });
+    for (auto &t : threads)
+        t.join();
+
+    for (int i = 0; i < 4; i++) {
+        nixlDlistH* dlist_hndl = nullptr;
+        EXPECT_EQ(target.prepXferDlist("source" + std::to_string(i), xfer_list, dlist_hndl),
+                  NIXL_SUCCESS);
+        EXPECT_EQ(target.releasedDlistH(dlist_hndl), NIXL_SUCCESS);
+    }
+}
+
+TEST_F(MultiThreadingTestFixture, MakeConnectionsWithMockDram) {
+    nixlAgent target = createAgent();
+    verifyMockDramBackendCreation(target);
+
+    for (int i = 0; i < 2; i++) {
+        nixlAgentConfig cfg(false, false);
+        nixlAgent source("source" + std::to_string(i), cfg);
+        verifyMockDramBackendCreation(source);
+        nixl_blob_t md;
+        std::string name;
+        EXPECT_EQ(source.getLocalMD(md), NIXL_SUCCESS);
+        EXPECT_EQ(target.loadRemoteMD(md, name), NIXL_SUCCESS);
+    }
+
+    std::vector<nixl_status_t> statuses;
+    EXPECT_EQ(target.makeConnections({"source0", "source1"}, statuses), NIXL_SUCCESS);
+    EXPECT_EQ(statuses, std::vector<nixl_status_t>(2, NIXL_SUCCESS));
+
+    EXPECT_EQ(target.makeConnections({"source1", "unknown"}, statuses), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(statuses[0], NIXL_SUCCESS);
+    EXPECT_EQ(statuses[1], NIXL_ERR_NOT_FOUND);
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentGenNotifToUnknownAgent) {
+    nixlAgent agent = createAgent();
+    verifyMockDramBackendCreation(agent);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&agent, t]() {
+            for (int i = 0; i < 100; i++) {
+                EXPECT_EQ(agent.genNotif("unknown" + std::to_string(t), "msg"),
+                          NIXL_ERR_NOT_FOUND);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_F(MultiThreadingTestFixture, ConcurrentTransfersWithAgentIds) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    nixl_agent_id_t self_id, remote_id, reloaded_id;
+
+    EXPECT_EQ(agent.getRemoteAgentId("test_agent", self_id), NIXL_ERR_NOT_FOUND);
+    verifyMemoryRegistration(agent, extra_params);
+    EXPECT_EQ(agent.getRemoteAgentId("test_agent", self_id), NIXL_SUCCESS);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 100; j++) {
+                nixlXferReqH* xfer_req = nullptr;
+                EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, self_id,
+                                              xfer_req), NIXL_SUCCESS);
+                EXPECT_EQ(agent.postXferReq(xfer_req), NIXL_SUCCESS);
+                EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+            }
+        });
+    for (auto &t : threads)
+        t.join();
+
+    // A remote agent keeps its id when loaded again
+    nixlAgentConfig cfg(false, false);
+    nixlAgent source("source", cfg);
+    verifyMockDramBackendCreation(source);
+    nixl_blob_t md;
+    std::string name;
+    EXPECT_EQ(source.getLocalMD(md), NIXL_SUCCESS);
+    EXPECT_EQ(agent.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(agent.getRemoteAgentId("source", remote_id), NIXL_SUCCESS);
+    EXPECT_NE(remote_id, self_id);
+
+    nixlXferReqH* xfer_req = nullptr;
+    EXPECT_EQ(agent.invalidateRemoteMD("source"), NIXL_SUCCESS);
+    EXPECT_EQ(agent.getRemoteAgentId("source", reloaded_id), NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, remote_id, xfer_req),
+              NIXL_ERR_NOT_FOUND);
+    EXPECT_EQ(agent.loadRemoteMD(md, name), NIXL_SUCCESS);
+    EXPECT_EQ(agent.getRemoteAgentId("source", reloaded_id), NIXL_SUCCESS);
+    EXPECT_EQ(reloaded_id, remote_id);
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, NIXL_INVALID_AGENT_ID,
+                                  xfer_req), NIXL_ERR_NOT_FOUND);
+}
+
+TEST_F(MultiThreadingTestFixture, TransfersWithinNestedRegistrations) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    // An outer region, and a smaller one registered within it afterwards
+    nixlDescList<nixlBlobDesc> outer(DRAM_SEG), inner(DRAM_SEG), both(DRAM_SEG, false);
+    outer.addDesc(nixlBlobDesc(addr, 4 * len, dev_id, ""));
+    inner.addDesc(nixlBlobDesc(addr + len, len / 2, dev_id, ""));
+    both.addDesc(outer[0]);
+    both.addDesc(inner[0]);
+    EXPECT_TRUE(both.hasOverlaps());
+    EXPECT_EQ(agent.registerMem(outer, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.registerMem(inner, &extra_params), NIXL_SUCCESS);
+
+    // Within the inner region, and after it where only the outer one covers
+    for (uintptr_t offset : {len + len / 4, 2 * len, len / 2}) {
+        nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+        xfer_list.addDesc(nixlBasicDesc(addr + offset, len / 4, dev_id));
+        nixlXferReqH* xfer_req = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent",
+                                      xfer_req, &extra_params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+    }
+
+    // Not covered once the outer region is deregistered
+    EXPECT_EQ(agent.deregisterMem(outer, &extra_params), NIXL_SUCCESS);
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr + 2 * len, len / 4, dev_id));
+    nixlXferReqH* xfer_req = nullptr;
+    EXPECT_NE(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent",
+                                  xfer_req, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, TransfersWithinManyNestedRegistrations) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    // Small regions at the start of an outer one, so the one covering the
+    // queries past them is far before them in the section list
+    const size_t inner_count = 64, inner_len = len / (2 * inner_count);
+    nixlDescList<nixlBlobDesc> outer(DRAM_SEG), inner(DRAM_SEG);
+    outer.addDesc(nixlBlobDesc(addr, 4 * len, dev_id, ""));
+    for (size_t i = 0; i < inner_count; i++)
+        inner.addDesc(nixlBlobDesc(addr + i * 2 * inner_len, inner_len, dev_id, ""));
+    EXPECT_EQ(agent.registerMem(outer, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.registerMem(inner, &extra_params), NIXL_SUCCESS);
+
+    // Within an inner region, between two of them, and after all of them
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr + 2 * inner_len, inner_len, dev_id));
+    xfer_list.addDesc(nixlBasicDesc(addr + 3 * inner_len, inner_len, dev_id));
+    xfer_list.addDesc(nixlBasicDesc(addr + 3 * len, len, dev_id));
+    nixlXferReqH* xfer_req = nullptr;
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent",
+                                  xfer_req, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+    // Past the outer region, and only partly within it
+    for (uintptr_t offset : {4 * len, 3 * len + len / 2}) {
+        nixlDescList<nixlBasicDesc> outside(DRAM_SEG);
+        outside.addDesc(nixlBasicDesc(addr + offset, len, dev_id));
+        EXPECT_NE(agent.createXferReq(NIXL_WRITE, outside, outside, "test_agent",
+                                      xfer_req, &extra_params), NIXL_SUCCESS);
+    }
+
+    EXPECT_EQ(agent.deregisterMem(inner, &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(agent.deregisterMem(outer, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, MakeXferReqWithIndexRanges) {
+    nixlAgent agent = createAgent();
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    for (int i = 0; i < 8; i++)
+        xfer_list.addDesc(nixlBasicDesc(addr + i * len / 8, len / 8, dev_id));
+    nixlDlistH *local_side = nullptr, *remote_side = nullptr;
+    EXPECT_EQ(agent.prepXferDlist(NIXL_INIT_AGENT, xfer_list, local_side), NIXL_SUCCESS);
+    EXPECT_EQ(agent.prepXferDlist("test_agent", xfer_list, remote_side), NIXL_SUCCESS);
+
+    // Contiguous and strided runs, split differently on each side
+    nixl_index_ranges_t all = {{0, 8}}, split = {{0, 2}, {2, 6}};
+    nixl_index_ranges_t odd_down = {{7, 4, -2}}, even = {{0, 4, 2}};
+    nixlXferReqH* xfer_req = nullptr;
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, all, remote_side, split, xfer_req),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(xfer_req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, odd_down, remote_side, even, xfer_req),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+    // Out of the list, or selecting a different number of indices
+    nixl_index_ranges_t past_end = {{4, 8}}, half = {{0, 4}};
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, past_end, remote_side, all, xfer_req),
+              NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(agent.makeXferReq(NIXL_WRITE, local_side, half, remote_side, all, xfer_req),
+              NIXL_ERR_INVALID_PARAM);
+
+    EXPECT_EQ(agent.releasedDlistH(local_side), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releasedDlistH(remote_side), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, SharedProgressThread) {
+    nixlAgentConfig cfg(true, false);
+    cfg.sharedProgThread = true;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+    nixlXferReqH* xfer_req = nullptr;
+    EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", xfer_req),
+              NIXL_SUCCESS);
+    EXPECT_EQ(agent.postXferReq(xfer_req), NIXL_SUCCESS);
+
+    // The engine is progressed by the thread of the agent, not one of its own
+    nixl_b_params_t stats;
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(agent.getXferStats(xfer_req, stats), NIXL_SUCCESS);
+        if (stats["progress_rounds"] != "0")
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_NE(stats["progress_rounds"], "0");
+    EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, SharedProgressThreadBackoff) {
+    nixlProgressStats stats;
+    EXPECT_EQ(createAgent().getProgressStats(stats), NIXL_ERR_NOT_SUPPORTED);
+
+    nixlAgentConfig cfg(true, false);
+    cfg.sharedProgThread = true;
+    cfg.progIdleUs       = 1000;
+    cfg.progSleepUs      = 1000;
+    nixlAgent agent("test_agent", cfg);
+    verifyMockDramBackendCreation(agent);
+
+    // Nothing to progress, so the thread ends up sleeping between rounds
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(agent.getProgressStats(stats), NIXL_SUCCESS);
+        if (stats.sleeps > 1)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(stats.sleeps, 1u);
+    EXPECT_GT(stats.iterations, stats.sleeps);
+    EXPECT_GT(stats.idleUs, 0u);
+}
+
+TEST_F(MultiThreadingTestFixture, PostThroughSubmissionQueue) {
+    nixlAgentConfig cfg(true, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT);
+    cfg.sharedProgThread = true;
+    cfg.submitQueueSize  = 16;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    // More posts at once than the queue holds, some are posted by the callers
+    auto transfer_sequence = [&]() {
+        nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+        xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+        std::vector<nixlXferReqH*> reqs(16);
+
+        for (auto &req : reqs) {
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                          &extra_params), NIXL_SUCCESS);
+            EXPECT_GE(agent.postXferReq(req), NIXL_SUCCESS);
+        }
+
+        for (auto &req : reqs) {
+            nixl_status_t ret;
+            while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG)
+                std::this_thread::yield();
+            EXPECT_EQ(ret, NIXL_SUCCESS);
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.emplace_back(transfer_sequence);
+    for (auto &t : threads)
+        t.join();
+}
+
+// A post failed by the progress thread leaves the request with the caller, who
+// got NIXL_IN_PROG, to find the error and release it
+TEST_F(MultiThreadingTestFixture, FailedQueuedPostKeepsRequest) {
+    nixlAgentConfig cfg(true, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT);
+    cfg.sharedProgThread = true;
+    cfg.submitQueueSize  = 16;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+    nixlXferReqH* req   = nullptr;
+    nixlXferReqH* other = nullptr;
+    ASSERT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                  &extra_params), NIXL_SUCCESS);
+
+    // MOCK_DRAM does not support notifications
+    nixl_opt_args_t notif_params;
+    notif_params.hasNotif = true;
+    notif_params.notifMsg = "notification";
+    ASSERT_EQ(agent.postXferReq(req, &notif_params), NIXL_IN_PROG);
+
+    nixl_status_t ret;
+    while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG)
+        std::this_thread::yield();
+    EXPECT_EQ(ret, NIXL_ERR_BACKEND);
+
+    // Not handed out again while the caller holds it
+    ASSERT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", other,
+                                  &extra_params), NIXL_SUCCESS);
+    EXPECT_NE(other, req);
+
+    // Reposted without the notification, which otherwise stays set
+    notif_params.hasNotif = false;
+    EXPECT_EQ(agent.postXferReq(req, &notif_params), NIXL_IN_PROG);
+    while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG)
+        std::this_thread::yield();
+    EXPECT_EQ(ret, NIXL_SUCCESS);
+
+    EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    EXPECT_EQ(agent.releaseXferReq(other), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, DeferBulkTransfersBeyondLimit) {
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.priorityMaxBytes[(size_t) nixl_xfer_priority_t::NIXL_XFER_PRIORITY_BULK] = len;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"in_prog_checks", "1"}};
+    EXPECT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    struct doneCtx {
+        std::vector<size_t>* order;
+        size_t               idx;
+    };
+    std::vector<size_t> order;
+    extra_params.xferCallback = [](nixlXferReqH* req, nixl_status_t status, void* ctx) {
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        doneCtx* done = static_cast<doneCtx*>(ctx);
+        done->order->push_back(done->idx);
+    };
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    // Four bulk requests, then a high priority one, all posted at once
+    const size_t count = 5;
+    std::vector<doneCtx> ctxs(count);
+    std::vector<nixlXferReqH*> reqs(count);
+    for (size_t i = 0; i < count; i++) {
+        ctxs[i] = {&order, i};
+        extra_params.xferCallbackCtx = &ctxs[i];
+        extra_params.priority = (i < count - 1) ? nixl_xfer_priority_t::NIXL_XFER_PRIORITY_BULK :
+                                                  nixl_xfer_priority_t::NIXL_XFER_PRIORITY_HIGH;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", reqs[i],
+                                      &extra_params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.postXferReq(reqs[i]), NIXL_IN_PROG);
+    }
+
+    // One bulk request in flight at a time, the high one is not held by them
+    std::vector<nixlXferReqH*> completed;
+    while (order.size() < count)
+        EXPECT_EQ(agent.pollCompletions(count, completed), NIXL_SUCCESS);
+    EXPECT_EQ(order, std::vector<size_t>({0, 4, 1, 2, 3}));
+
+    for (auto &req : reqs) {
+        EXPECT_EQ(agent.getXferStatus(req), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+    }
+}
+
+TEST_F(MultiThreadingTestFixture, ShapeTransfersPerPeer) {
+    nixlXferQueueStats stats;
+    EXPECT_EQ(createAgent().getXferQueueStats(stats), NIXL_ERR_NOT_SUPPORTED);
+
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.peerMaxBytes = len;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"in_prog_checks", "2"}};
+    EXPECT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    const size_t count = 3;
+    std::vector<nixlXferReqH*> reqs(count);
+    for (auto &req : reqs) {
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                      &extra_params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.postXferReq(req), NIXL_IN_PROG);
+    }
+
+    // One request in flight to the agent, the others held back
+    EXPECT_EQ(agent.getXferQueueStats(stats, "test_agent"), NIXL_SUCCESS);
+    EXPECT_EQ(stats.inflightBytes, len);
+    EXPECT_EQ(stats.queuedBytes, (count - 1) * len);
+    EXPECT_EQ(stats.queuedReqs, count - 1);
+    EXPECT_EQ(agent.getXferQueueStats(stats, "other_agent"), NIXL_SUCCESS);
+    EXPECT_EQ(stats.inflightBytes, 0);
+
+    for (auto &req : reqs) {
+        nixl_status_t ret;
+        while ((ret = agent.getXferStatus(req)) == NIXL_IN_PROG)
+            std::this_thread::yield();
+        EXPECT_EQ(ret, NIXL_SUCCESS);
+    }
+
+    EXPECT_EQ(agent.getXferQueueStats(stats), NIXL_SUCCESS);
+    EXPECT_EQ(stats.inflightBytes, 0);
+    EXPECT_EQ(stats.queuedReqs, 0);
+    for (auto &req : reqs)
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, CountTransfersInTelemetry) {
+    nixl_xfer_telemetry_t telemetry;
+    EXPECT_EQ(createAgent().getTelemetry(telemetry), NIXL_ERR_NOT_SUPPORTED);
+#ifdef DISABLE_TELEMETRY
+    GTEST_SKIP() << "Telemetry is not built in";
+#endif
+
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.enableTelemetry = true;
+    cfg.telemetryDumpMs = 1;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    // Counted per thread, and summed by getTelemetry
+    const size_t threads = 4, posts = 16;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            nixlXferReqH* req = nullptr;
+            EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                          &extra_params), NIXL_SUCCESS);
+            for (size_t i = 0; i < posts; i++) {
+                nixl_status_t ret = agent.postXferReq(req);
+                while (ret == NIXL_IN_PROG)
+                    ret = agent.getXferStatus(req);
+                EXPECT_EQ(ret, NIXL_SUCCESS);
+            }
+            EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    EXPECT_EQ(agent.getTelemetry(telemetry), NIXL_SUCCESS);
+    ASSERT_EQ(telemetry.size(), 1);
+    EXPECT_EQ(telemetry[0].backend, "MOCK_DRAM");
+    EXPECT_EQ(telemetry[0].op, NIXL_WRITE);
+    EXPECT_EQ(telemetry[0].remoteAgent, "test_agent");
+    EXPECT_EQ(telemetry[0].posts, threads * posts);
+    EXPECT_EQ(telemetry[0].bytes, threads * posts * len);
+    EXPECT_EQ(telemetry[0].completions, threads * posts);
+    EXPECT_EQ(telemetry[0].errors, 0);
+
+    uint64_t latencies = 0;
+    for (auto &count : telemetry[0].latencyUs)
+        latencies += count;
+    EXPECT_EQ(latencies, threads * posts);
+    EXPECT_GT(telemetry[0].getLatencyUs(0.99), 0);
+}
+
+TEST_F(MultiThreadingTestFixture, RegisterMemInBackground) {
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.asyncRegThreads = 2;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    std::atomic<size_t> done{0};
+    extra_params.regCallback = [](nixlRegReqH* reg_hndl, nixl_status_t status, void* ctx) {
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        (*static_cast<std::atomic<size_t>*>(ctx))++;
+    };
+    extra_params.regCallbackCtx = &done;
+
+    // Registered by the agent threads, the calls return at once
+    const size_t count = 8;
+    std::vector<nixlRegReqH*> regs(count);
+    for (size_t i = 0; i < count; i++) {
+        nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+        reg_list.addDesc(nixlBlobDesc(addr + i * len, len, dev_id, ""));
+        EXPECT_GE(agent.registerMemAsync(reg_list, regs[i], &extra_params), NIXL_SUCCESS);
+        EXPECT_NE(regs[i], nullptr);
+    }
+
+    for (auto &reg : regs) {
+        nixl_status_t ret;
+        while ((ret = agent.getRegStatus(reg)) == NIXL_IN_PROG)
+            std::this_thread::yield();
+        EXPECT_EQ(ret, NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseRegReq(reg), NIXL_SUCCESS);
+    }
+    EXPECT_EQ(done, count);
+    verifyTransfer(agent, extra_params);
+
+    // Registered before returning without a lock to do it in the background
+    nixlAgent sync_agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE);
+    backend = verifyMockDramBackendCreation(sync_agent);
+    extra_params = createExtraParams(backend);
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    reg_list.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    EXPECT_EQ(sync_agent.registerMemAsync(reg_list, regs[0], &extra_params), NIXL_SUCCESS);
+    EXPECT_EQ(sync_agent.getRegStatus(regs[0]), NIXL_SUCCESS);
+    EXPECT_EQ(sync_agent.releaseRegReq(regs[0]), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, RegisterLargeListInParallel) {
+    nixlAgentConfig cfg(false, false, 0, 0, 100000, nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT);
+    cfg.regThreads = 4;
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    // Chunks over the threads, merged back in the order of the list
+    const size_t count = 4096;
+    nixlDescList<nixlBlobDesc> reg_list(DRAM_SEG);
+    for (size_t i = 0; i < count; i++)
+        reg_list.addDesc(nixlBlobDesc(addr + i * len, len, dev_id, ""));
+    EXPECT_EQ(agent.registerMem(reg_list, &extra_params), NIXL_SUCCESS);
+
+    for (size_t i : {(size_t) 0, count / 2, count - 1}) {
+        nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+        xfer_list.addDesc(nixlBasicDesc(addr + i * len, len, dev_id));
+        nixlXferReqH* xfer_req = nullptr;
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent",
+                                      xfer_req, &extra_params), NIXL_SUCCESS);
+        EXPECT_EQ(agent.releaseXferReq(xfer_req), NIXL_SUCCESS);
+    }
+
+    EXPECT_EQ(agent.deregisterMem(reg_list, &extra_params), NIXL_SUCCESS);
+}
+
+TEST_F(MultiThreadingTestFixture, PinnedSharedProgressThread) {
+    nixlAgentConfig cfg(true, false);
+    cfg.sharedProgThread = true;
+    cfg.commThreadCpus   = std::to_string(sched_getcpu());
+    nixlAgent agent("test_agent", cfg);
+    nixlBackendH* backend = verifyMockDramBackendCreation(agent);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+
+    verifyMemoryRegistration(agent, extra_params);
+    verifyTransfer(agent, extra_params);
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+TEST_F(MultiThreadingTestFixture, AwaitTransfersFromCoroutines) {
+    nixlAgent agent = createAgent(nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlBackendH* backend = nullptr;
+    nixl_b_params_t params = {{"in_prog_checks", "3"}};
+    EXPECT_EQ(agent.createBackend("MOCK_DRAM", params, backend), NIXL_SUCCESS);
+    nixl_opt_args_t extra_params = createExtraParams(backend);
+    verifyMemoryRegistration(agent, extra_params);
+
+    nixlDescList<nixlBasicDesc> xfer_list(DRAM_SEG);
+    xfer_list.addDesc(nixlBasicDesc(addr, len, dev_id));
+
+    const size_t coroutines = 32, per_coroutine = 8;
+    std::vector<nixlXferReqH*> reqs(coroutines);
+    for (auto &req : reqs)
+        EXPECT_EQ(agent.createXferReq(NIXL_WRITE, xfer_list, xfer_list, "test_agent", req,
+                                      &extra_params), NIXL_SUCCESS);
+
+    // The coroutines post again from the executor threads that resume them
+    nixlXferDispatcher dispatcher(agent);
+    std::atomic<size_t> done{0};
+    for (auto &req : reqs)
+        awaitTransfers(dispatcher, req, per_coroutine, done);
+    EXPECT_EQ(dispatcher.waiting(), coroutines);
+
+    auto executor = [&]() {
+        while (done < coroutines * per_coroutine)
+            dispatcher.progress(8);
+    };
+    std::thread t1(executor);
+    std::thread t2(executor);
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(dispatcher.waiting(), 0u);
+    for (auto &req : reqs)
+        EXPECT_EQ(agent.releaseXferReq(req), NIXL_SUCCESS);
+}
+#endif
+
+// Ports of the listener tests, per process so runs don't collide
+static int listenerTestPort(int i) {
+    return 20000 + (getpid() % 4000) * 8 + i;
+}
+
+TEST_F(MultiThreadingTestFixture, ExchangeMetadataThroughListeners) {
+    nixlAgentConfig cfg1(false, true, listenerTestPort(0));
+    nixlAgentConfig cfg2(false, true, listenerTestPort(1));
+    nixlAgent agent1("listener1", cfg1), agent2("listener2", cfg2);
+    verifyMockDramBackendCreation(agent1);
+    verifyMockDramBackendCreation(agent2);
+
+    // Enough descriptors for the frames to arrive in several reads
+    const int desc_count = 20000;
+    nixlDescList<nixlBlobDesc> descs(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> xfer_descs(DRAM_SEG);
+    for (int i = 0; i < desc_count; i++) {
+        descs.addDesc(nixlBlobDesc(addr + i * len, len, dev_id, ""));
+        xfer_descs.addDesc(nixlBasicDesc(addr + i * len, len, dev_id));
+    }
+    ASSERT_EQ(agent1.registerMem(descs), NIXL_SUCCESS);
+    ASSERT_EQ(agent2.registerMem(descs), NIXL_SUCCESS);
+
+    // Sent by one, fetched by the other, both over the same connection
+    nixl_opt_args_t to_agent1, to_agent2;
+    to_agent1.ipAddr = "127.0.0.1";
+    to_agent1.port = listenerTestPort(0);
+    to_agent2.ipAddr = "127.0.0.1";
+    to_agent2.port = listenerTestPort(1);
+
+    ASSERT_EQ(agent1.sendLocalMD(&to_agent2), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(agent2, "listener1", xfer_descs));
+    ASSERT_EQ(agent1.fetchRemoteMD("listener2", &to_agent2), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(agent1, "listener2", xfer_descs));
+
+    // The connection is closed on both sides, and made again by the next send
+    nixlDescList<nixlBlobDesc> more(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> more_xfer(DRAM_SEG);
+    more.addDesc(nixlBlobDesc(addr + desc_count * len, len, dev_id, ""));
+    more_xfer.addDesc(nixlBasicDesc(addr + desc_count * len, len, dev_id));
+    ASSERT_EQ(agent1.invalidateLocalMD(&to_agent2), NIXL_SUCCESS);
+    ASSERT_EQ(agent1.registerMem(more), NIXL_SUCCESS);
+    ASSERT_EQ(agent1.sendLocalMD(&to_agent2), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(agent2, "listener1", more_xfer));
+}
+
+TEST_F(MultiThreadingTestFixture, BroadcastMetadataAlongTree) {
+    const int peer_count = 3;
+    nixlAgentConfig root_cfg(false, true, listenerTestPort(0));
+    nixlAgent root("tree_root", root_cfg);
+    verifyMockDramBackendCreation(root);
+
+    nixlDescList<nixlBlobDesc> descs(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> xfer_descs(DRAM_SEG);
+    descs.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    xfer_descs.addDesc(nixlBasicDesc(addr, len, dev_id));
+    ASSERT_EQ(root.registerMem(descs), NIXL_SUCCESS);
+
+    // A chain from the root, each peer forwards the rest to the next one
+    std::vector<std::unique_ptr<nixlAgent>> peers;
+    nixl_opt_args_t args;
+    args.mdFanout = 1;
+    for (int i = 0; i < peer_count; i++) {
+        nixlAgentConfig cfg(false, true, listenerTestPort(i + 1));
+        for (int j = i + 1; j < peer_count; j++)
+            cfg.mdForwardPeers.emplace_back("127.0.0.1", listenerTestPort(j + 1));
+        peers.emplace_back(new nixlAgent("tree_peer" + std::to_string(i), cfg));
+        verifyMockDramBackendCreation(*peers.back());
+        args.mdPeers.emplace_back("127.0.0.1", listenerTestPort(i + 1));
+    }
+
+    ASSERT_EQ(root.sendLocalMD(&args), NIXL_SUCCESS);
+    for (auto &peer : peers)
+        EXPECT_TRUE(waitForRemoteMD(*peer, "tree_root", xfer_descs));
+
+    // Without a forwarding peer configured, the last one is left out
+    nixlAgentConfig last_cfg(false, true, listenerTestPort(peer_count + 1));
+    nixlAgent last("tree_last", last_cfg);
+    verifyMockDramBackendCreation(last);
+    nixlAgentConfig first_cfg(false, true, listenerTestPort(peer_count + 2));
+    nixlAgent first("tree_first", first_cfg);
+    verifyMockDramBackendCreation(first);
+
+    args.mdPeers = {{"127.0.0.1", listenerTestPort(peer_count + 2)},
+                    {"127.0.0.1", listenerTestPort(peer_count + 1)}};
+    ASSERT_EQ(root.sendLocalMD(&args), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(first, "tree_root", xfer_descs));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(waitForRemoteMD(last, "tree_root", xfer_descs, false));
+
+    // Too many peers for one broadcast
+    args.mdPeers.assign(65537, {"127.0.0.1", listenerTestPort(peer_count + 1)});
+    EXPECT_EQ(root.sendLocalMD(&args), NIXL_ERR_INVALID_PARAM);
+}
+
+// Runs against the etcd server in NIXL_ETCD_ENDPOINTS, when etcd support is built in
+TEST_F(MultiThreadingTestFixture, ExchangeMetadataThroughServer) {
+    if (!getenv("NIXL_ETCD_ENDPOINTS"))
+        GTEST_SKIP() << "No metadata server in NIXL_ETCD_ENDPOINTS";
+
+    // Unique names, as the server can be shared with other runs
+    const std::string source_name = "kv_source_" + std::to_string(getpid());
+    nixlAgentConfig cfg(false, false);
+    nixlAgent source(source_name, cfg);
+    nixlAgent target("kv_target_" + std::to_string(getpid()), cfg);
+    verifyMockDramBackendCreation(source);
+    verifyMockDramBackendCreation(target);
+
+    nixlDescList<nixlBlobDesc> first(DRAM_SEG), second(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> first_xfer(DRAM_SEG), second_xfer(DRAM_SEG);
+    first.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    first_xfer.addDesc(nixlBasicDesc(addr, len, dev_id));
+    second.addDesc(nixlBlobDesc(addr + len, len, dev_id, ""));
+    second_xfer.addDesc(nixlBasicDesc(addr + len, len, dev_id));
+
+    ASSERT_EQ(source.registerMem(first), NIXL_SUCCESS);
+    nixl_status_t ret = source.sendLocalMD();
+    if (ret == NIXL_ERR_NOT_SUPPORTED)
+        GTEST_SKIP() << "etcd support is not built in";
+    ASSERT_EQ(ret, NIXL_SUCCESS);
+
+    // Fetched once, then kept up to date through the watch
+    ASSERT_EQ(target.fetchRemoteMD(source_name), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(target, source_name, first_xfer));
+
+    ASSERT_EQ(source.registerMem(second), NIXL_SUCCESS);
+    ASSERT_EQ(source.sendLocalMD(), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(target, source_name, second_xfer));
+
+    ASSERT_EQ(source.invalidateLocalMD(), NIXL_SUCCESS);
+    EXPECT_TRUE(waitForRemoteMD(target, source_name, first_xfer, false));
+}
+
+// Runs against the etcd server in NIXL_ETCD_ENDPOINTS, when etcd support is built in
+TEST_F(MultiThreadingTestFixture, LazyFetchKeepsAgentsInUse) {
+    if (!getenv("NIXL_ETCD_ENDPOINTS"))
+        GTEST_SKIP() << "No metadata server in NIXL_ETCD_ENDPOINTS";
+
+    const std::string prefix = "lazy_" + std::to_string(getpid()) + "_";
+    nixlAgentConfig cfg(false, false);
+    nixlAgent first(prefix + "first", cfg);
+    nixlAgent second(prefix + "second", cfg);
+    verifyMockDramBackendCreation(first);
+    verifyMockDramBackendCreation(second);
+
+    nixlDescList<nixlBlobDesc> descs(DRAM_SEG);
+    nixlDescList<nixlBasicDesc> xfer_descs(DRAM_SEG);
+    descs.addDesc(nixlBlobDesc(addr, len, dev_id, ""));
+    xfer_descs.addDesc(nixlBasicDesc(addr, len, dev_id));
+    for (auto agent : {&first, &second}) {
+        ASSERT_EQ(agent->registerMem(descs), NIXL_SUCCESS);
+        nixl_status_t ret = agent->sendLocalMD();
+        if (ret == NIXL_ERR_NOT_SUPPORTED)
+            GTEST_SKIP() << "etcd support is not built in";
+        ASSERT_EQ(ret, NIXL_SUCCESS);
+    }
+
+    nixlAgentConfig lazy_cfg(false, false);
+    lazy_cfg.lazyMDFetch     = true;
+    lazy_cfg.lazyMDTimeoutUs = 5000000;
+    lazy_cfg.lazyMDCacheSize = 1;
+    nixlAgent target(prefix + "target", lazy_cfg);
+    verifyMockDramBackendCreation(target);
+    ASSERT_EQ(target.registerMem(descs), NIXL_SUCCESS);
+
+    // The first one is held by its handle when the second is fetched
+    nixlDlistH *local_hndl, *first_hndl, *second_hndl;
+    ASSERT_EQ(target.prepXferDlist(NIXL_INIT_AGENT, xfer_descs, local_hndl), NIXL_SUCCESS);
+    ASSERT_EQ(target.prepXferDlist(prefix + "first", xfer_descs, first_hndl), NIXL_SUCCESS);
+    ASSERT_EQ(target.prepXferDlist(prefix + "second", xfer_descs, second_hndl), NIXL_SUCCESS);
+
+    const std::vector<int> indices = {0};
+    nixlXferReqH *req_hndl;
+    ASSERT_EQ(target.makeXferReq(NIXL_WRITE, local_hndl, indices, first_hndl, indices,
+                                 req_hndl), NIXL_SUCCESS);
+    EXPECT_EQ(target.releaseXferReq(req_hndl), NIXL_SUCCESS);
+
+    ASSERT_EQ(target.releasedDlistH(local_hndl), NIXL_SUCCESS);
+    ASSERT_EQ(target.releasedDlistH(first_hndl), NIXL_SUCCESS);
+    ASSERT_EQ(target.releasedDlistH(second_hndl), NIXL_SUCCESS);
+}
+
 TEST_F(MultiThreadingTestFixture, RegisterMemWithMockDram) {
     nixlAgent agent = createAgent();
     nixlBackendH* backend = verifyMockDramBackendCreation(agent);
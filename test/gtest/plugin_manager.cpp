@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
 #include "nixl.h"
 #include "plugin_manager.h"
 
@@ -202,6 +207,80 @@ TEST_F(LoadedPluginTestFixture, LoadUnloadComplexPluginTest) {
   EXPECT_TRUE(HasOnlyLoadedPlugins());
 }
 
+class PluginIndexTestFixture : public testing::Test {
+protected:
+  nixlPluginManager &plugin_manager_ = nixlPluginManager::getInstance();
+  std::filesystem::path dir_;
+
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("nixl_plugin_index_" + std::to_string(getpid()));
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  bool IsAvailable(const std::string &name) {
+    const auto &names = plugin_manager_.getAvailablePluginNames();
+    return std::find(names.begin(), names.end(), name) != names.end();
+  }
+
+  bool IsLoaded(const std::string &name) {
+    const auto &names = plugin_manager_.getLoadedPluginNames();
+    return std::find(names.begin(), names.end(), name) != names.end();
+  }
+};
+
+TEST_F(PluginIndexTestFixture, DiscoverWithoutLoadingTest) {
+  std::ofstream(dir_ / NIXL_PLUGIN_INDEX_FILE)
+      << "# name version mems path\n"
+      << "MOCK_INDEXED 1.2.3 DRAM_SEG,VRAM_SEG libplugin_MOCK_INDEXED.so\n"
+      << "MOCK_MALFORMED 1.2.3\n";
+  std::ofstream(dir_ / "libplugin_MOCK_SCANNED.so");
+
+  plugin_manager_.addPluginDirectory(dir_.string());
+
+  EXPECT_TRUE(IsAvailable("MOCK_INDEXED"));
+  EXPECT_TRUE(IsAvailable("MOCK_SCANNED"));
+  EXPECT_FALSE(IsAvailable("MOCK_MALFORMED"));
+  EXPECT_FALSE(IsLoaded("MOCK_INDEXED"));
+  EXPECT_FALSE(IsLoaded("MOCK_SCANNED"));
+
+  nixlPluginIndexEntry entry;
+  ASSERT_EQ(plugin_manager_.getPluginIndexEntry("MOCK_INDEXED", entry),
+            NIXL_SUCCESS);
+  EXPECT_EQ(entry.version, "1.2.3");
+  EXPECT_EQ(entry.mems, (nixl_mem_list_t{DRAM_SEG, VRAM_SEG}));
+  EXPECT_EQ(entry.path, (dir_ / "libplugin_MOCK_INDEXED.so").string());
+
+  ASSERT_EQ(plugin_manager_.getPluginIndexEntry("MOCK_SCANNED", entry),
+            NIXL_SUCCESS);
+  EXPECT_TRUE(entry.version.empty());
+
+  // Neither is a valid plugin, which shows on first use only
+  EXPECT_EQ(plugin_manager_.loadPlugin("MOCK_INDEXED"), nullptr);
+  EXPECT_EQ(plugin_manager_.loadPlugin("MOCK_SCANNED"), nullptr);
+}
+
+TEST_F(PluginIndexTestFixture, WriteIndexTest) {
+  nixlPluginIndexEntry entry;
+  ASSERT_EQ(plugin_manager_.getPluginIndexEntry(mock_dram_plugin_name, entry),
+            NIXL_SUCCESS);
+  if (entry.path.empty())
+    GTEST_SKIP();
+
+  std::filesystem::create_symlink(entry.path,
+                                  dir_ / "libplugin_MOCK_DRAM.so");
+  ASSERT_EQ(plugin_manager_.writePluginIndex(dir_.string()), NIXL_SUCCESS);
+
+  std::ifstream index(dir_ / NIXL_PLUGIN_INDEX_FILE);
+  std::string line;
+  std::getline(index, line);
+  EXPECT_EQ(line[0], '#');
+  std::getline(index, line);
+  EXPECT_EQ(line, "MOCK_DRAM 0.0.1 - libplugin_MOCK_DRAM.so");
+}
+
 /* Load single plugins tests instantiations. */
 INSTANTIATE_TEST_SUITE_P(MockLoadPluginInstantiation,
                          LoadSinglePluginTestFixture,
@@ -369,6 +369,146 @@ nixl_status_t partialMdTest(nixlAgent* A1, nixlAgent* A2, nixlBackendH* backend1
     return NIXL_SUCCESS;
 }
 
+static bool remoteDescsLoaded(nixlAgent* A1, const nixl_reg_dlist_t &descs,
+                              nixl_opt_args_t* extra_params) {
+    nixlDlistH *dst_side;
+    nixl_status_t status = A1->prepXferDlist(agent2, descs.trim(), dst_side, extra_params);
+    if (status != NIXL_SUCCESS) {
+        assert(dst_side == nullptr);
+        return false;
+    }
+    status = A1->releasedDlistH(dst_side);
+    assert(status == NIXL_SUCCESS);
+    return true;
+}
+
+nixl_status_t mdDeltaTest(nixlAgent* A1, nixlAgent* A2, nixlBackendH* backend1, nixlBackendH* backend2) {
+    std::cout << "Starting mdDeltaTest\n";
+
+    nixl_status_t status;
+    nixl_opt_args_t extra_params1, extra_params2;
+    extra_params1.backends.push_back(backend1);
+    extra_params2.backends.push_back(backend2);
+
+    const int NUM_LISTS = 3;
+    const size_t BUF_SIZE = 1024;
+    void* bufs[NUM_LISTS];
+    std::vector<nixl_reg_dlist_t> mem_lists(NUM_LISTS, nixl_reg_dlist_t(DRAM_SEG));
+
+    for (int i = 0; i < NUM_LISTS; i++) {
+        bufs[i] = calloc(1, BUF_SIZE);
+        mem_lists[i].addDesc(nixlBlobDesc((uintptr_t)bufs[i], BUF_SIZE, 0));
+    }
+
+    A1->invalidateRemoteMD(agent2);
+
+    std::string meta, remote_name;
+    uint64_t local_version, remote_version, held_version;
+
+    // Full metadata carries the version
+    status = A2->registerMem(mem_lists[0], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->getLocalMD(meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    assert(remote_name == agent2);
+    status = A2->getLocalMDVersion(local_version);
+    assert(status == NIXL_SUCCESS);
+    status = A1->getRemoteMDVersion(agent2, remote_version);
+    assert(status == NIXL_SUCCESS);
+    assert(remote_version == local_version);
+    held_version = remote_version;
+
+    // Registration delta
+    status = A2->registerMem(mem_lists[1], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->getLocalMDDelta(held_version, meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    assert(remoteDescsLoaded(A1, mem_lists[0], &extra_params1));
+    assert(remoteDescsLoaded(A1, mem_lists[1], &extra_params1));
+    status = A1->getRemoteMDVersion(agent2, remote_version);
+    assert(status == NIXL_SUCCESS);
+    assert(remote_version == held_version + 1);
+
+    // Loading it again is ignored
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    held_version = remote_version;
+
+    // Deregistration delta
+    status = A2->deregisterMem(mem_lists[0], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->getLocalMDDelta(held_version, meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    assert(!remoteDescsLoaded(A1, mem_lists[0], &extra_params1));
+    assert(remoteDescsLoaded(A1, mem_lists[1], &extra_params1));
+    status = A1->getRemoteMDVersion(agent2, held_version);
+    assert(status == NIXL_SUCCESS);
+
+    // A delta after missed changes needs the full metadata
+    status = A2->registerMem(mem_lists[2], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->registerMem(mem_lists[0], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->getLocalMDDelta(held_version + 1, meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_ERR_NOT_FOUND);
+    assert(!remoteDescsLoaded(A1, mem_lists[2], &extra_params1));
+
+    status = A2->getLocalMD(meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    for (int i = 0; i < NUM_LISTS; i++)
+        assert(remoteDescsLoaded(A1, mem_lists[i], &extra_params1));
+
+    // Full metadata also drops what was deregistered since
+    std::string stale_meta;
+    status = A2->getLocalMD(stale_meta);
+    assert(status == NIXL_SUCCESS);
+    status = A2->deregisterMem(mem_lists[2], &extra_params2);
+    assert(status == NIXL_SUCCESS);
+    status = A2->getLocalMD(meta);
+    assert(status == NIXL_SUCCESS);
+    status = A1->loadRemoteMD(meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    assert(!remoteDescsLoaded(A1, mem_lists[2], &extra_params1));
+    assert(remoteDescsLoaded(A1, mem_lists[1], &extra_params1));
+    status = A2->getLocalMDVersion(local_version);
+    assert(status == NIXL_SUCCESS);
+    status = A1->getRemoteMDVersion(agent2, remote_version);
+    assert(status == NIXL_SUCCESS);
+    assert(remote_version == local_version);
+
+    // Older full metadata is ignored, like older deltas
+    status = A1->loadRemoteMD(stale_meta, remote_name);
+    assert(status == NIXL_SUCCESS);
+    assert(!remoteDescsLoaded(A1, mem_lists[2], &extra_params1));
+    status = A1->getRemoteMDVersion(agent2, remote_version);
+    assert(status == NIXL_SUCCESS);
+    assert(remote_version == local_version);
+
+    // Cleanup
+    for (int i = 0; i < 2; i++) {
+        status = A2->deregisterMem(mem_lists[i], &extra_params2);
+        assert(status == NIXL_SUCCESS);
+    }
+    status = A1->invalidateRemoteMD(agent2);
+    assert(status == NIXL_SUCCESS);
+
+    for (int i = 0; i < NUM_LISTS; i++)
+        free(bufs[i]);
+
+    std::cout << "mdDeltaTest completed successfully\n";
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t sideXferTest(nixlAgent* A1, nixlAgent* A2, nixlXferReqH* src_handle, nixlBackendH* dst_backend) {
     std::cout << "Starting sideXferTest\n";
 
@@ -728,6 +868,10 @@ int main()
     ret1 = partialMdTest(&A1, &A2, ucx1, ucx2);
     assert (ret1 == NIXL_SUCCESS);
 
+    std::cout << "performing mdDeltaTest with backends " << ucx1 << " " << ucx2 << "\n";
+    ret1 = mdDeltaTest(&A1, &A2, ucx1, ucx2);
+    assert (ret1 == NIXL_SUCCESS);
+
     std::cout << "performing sideXferTest with backends " << ucx1 << " " << ucx2 << "\n";
     ret1 = sideXferTest(&A1, &A2, req_handle, ucx2);
     assert (ret1 == NIXL_SUCCESS);
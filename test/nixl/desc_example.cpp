@@ -20,10 +20,200 @@
 #include "nixl.h"
 #include "serdes/serdes.h"
 #include "backend/backend_aux.h"
+#include "desc_kernels.h"
 
 #include <sys/time.h>
 
 
+// Vectorized checks against the descriptor methods, at every position of a
+// mismatch and for lengths around the vector widths
+void testKernels(){
+    for (size_t count = 0; count < 40; count++) {
+        std::vector<nixlBasicDesc> lhs, rhs;
+        nixlBasicDesc base(0x1000, 64 * 40, 3);
+
+        for (size_t i = 0; i < count; i++) {
+            lhs.push_back(nixlBasicDesc(0x1000 + i * 64, 64, 3));
+            rhs.push_back(nixlBasicDesc(0x9000 + i * 128, 64, 5));
+        }
+        assert(nixlDescLenMismatch(lhs.data(), rhs.data(), count) == count);
+        assert(nixlDescCoveredRun(lhs.data(), count, base) == count);
+
+        for (size_t i = 0; i < count; i++) {
+            rhs[i].len++;
+            assert(nixlDescLenMismatch(lhs.data(), rhs.data(), count) == i);
+            rhs[i].len--;
+
+            lhs[i].devId++;
+            assert(nixlDescCoveredRun(lhs.data(), count, base) == i);
+            lhs[i].devId--;
+            lhs[i].len = 64 * 40 + 1;
+            assert(nixlDescCoveredRun(lhs.data(), count, base) == i);
+            // Past the end of the address space, not wrapping into base
+            lhs[i].len = UINTPTR_MAX;
+            assert(nixlDescCoveredRun(lhs.data(), count, base) == i);
+            lhs[i].len = 64;
+        }
+    }
+
+    // Sorted overlap check against the pairwise descriptor method, in place
+    // over basic descriptors and over a list of a larger descriptor type
+    for (size_t count = 0; count < 40; count++) {
+        std::vector<nixlBasicDesc> descs;
+        nixl_reg_dlist_t blobs (DRAM_SEG, true);
+
+        for (size_t i = 0; i < count; i++) {
+            descs.push_back(nixlBasicDesc(0x1000 + i * 64, 64, 3));
+            blobs.addDesc(nixlBlobDesc(descs.back(), "meta"));
+        }
+        assert(nixlDescSortedOverlap(descs.data(), count, sizeof(nixlBasicDesc)) == count);
+        assert(!blobs.hasOverlaps());
+
+        for (size_t i = 0; i + 1 < count; i++) {
+            for (size_t len : {(size_t) 65, (size_t) 64, (size_t) UINTPTR_MAX}) {
+                descs[i].len = len;
+                size_t expected = count;
+                for (size_t j = 0; (j + 1 < count) && (expected == count); j++)
+                    if (descs[j].overlaps(descs[j + 1]))
+                        expected = j;
+                assert(nixlDescSortedOverlap(descs.data(), count,
+                                             sizeof(nixlBasicDesc)) == expected);
+            }
+            // Another device is never an overlap
+            descs[i].len = 65;
+            descs[i + 1].devId++;
+            assert(nixlDescSortedOverlap(descs.data(), count, sizeof(nixlBasicDesc)) == count);
+            descs[i + 1].devId--;
+            descs[i].len = 64;
+
+            blobs[i].len = 65;
+            assert(blobs.hasOverlaps());
+            blobs[i].len = 64;
+        }
+    }
+
+    // A section ending at the end of the address space, its end wraps to 0
+    for (size_t count = 0; count < 40; count++) {
+        std::vector<nixlBasicDesc> queries;
+        nixlBasicDesc base(UINTPTR_MAX - 64 * 40 + 1, 64 * 40, 3);
+
+        for (size_t i = 0; i < count; i++)
+            queries.push_back(nixlBasicDesc(base.addr + i * 64, 64, 3));
+        assert(nixlDescCoveredRun(queries.data(), count, base) == count);
+
+        for (size_t i = 0; i < count; i++) {
+            queries[i].addr = base.addr - 64;
+            assert(nixlDescCoveredRun(queries.data(), count, base) == i);
+            queries[i].addr = base.addr + i * 64;
+        }
+    }
+}
+
+// Lists growing past their inline descriptors, and copied or moved either way
+void testInline(){
+    nixl_xfer_dlist_t sorted (DRAM_SEG, true);
+    const nixlBasicDesc *inline_data;
+
+    for (int i = 7; i >= 0; i--) {
+        sorted.addDesc(nixlBasicDesc(0x1000 + i * 64, 64, 0));
+        if (i == 4)
+            inline_data = &sorted[0];
+    }
+    assert(&sorted[0] != inline_data);
+    assert(sorted.verifySorted());
+    assert(sorted.getIndex(nixlBasicDesc(0x1000 + 5 * 64, 64, 0)) == 5);
+
+    nixl_xfer_dlist_t copied = sorted, moved (DRAM_SEG);
+    assert(copied == sorted);
+    moved = std::move(copied);
+    assert(moved == sorted);
+
+    for (int i = 0; i < 6; i++)
+        moved.remDesc(0);
+    assert(moved.descCount() == 2);
+    assert(moved[0] == sorted[6]);
+
+    nixl_xfer_dlist_t small (DRAM_SEG);
+    small.addDesc(sorted[1]);
+    small.addDesc(sorted[0]);
+    nixl_xfer_dlist_t small_moved = std::move(small);
+    assert(small_moved.descCount() == 2);
+    assert(small_moved[1] == sorted[0]);
+    small_moved.resize(9);
+    small_moved.resize(1);
+    assert(small_moved[0] == sorted[1]);
+}
+
+// Blocks of a strided descriptor, appended in order or inserted into a sorted list
+void testStrided(){
+    nixl_xfer_dlist_t strided (DRAM_SEG, true);
+    strided.addStridedDesc(nixlStridedDesc(0x10000, 256, 4096, 1000, 2));
+    assert(strided.descCount() == 1000);
+    assert(strided[999] == nixlBasicDesc(0x10000 + 999 * 4096, 256, 2));
+    assert(strided.verifySorted());
+
+    // Interleaved with the blocks already added
+    strided.addStridedDesc(nixlStridedDesc(0x10000 + 2048, 256, 4096, 1000, 2));
+    assert(strided.descCount() == 2000);
+    assert(strided.verifySorted());
+    assert(strided[1] == nixlBasicDesc(0x10000 + 2048, 256, 2));
+    assert(!strided.hasOverlaps());
+
+    nixl_reg_dlist_t reg (DRAM_SEG);
+    reg.addStridedDesc(nixlStridedDesc(0x10000, 256, 4096, 0, 2));
+    assert(reg.isEmpty());
+}
+
+// Lists built in place, and moved without copying their descriptors
+void testEmplace(){
+    nixl_reg_dlist_t reg (DRAM_SEG);
+    reg.reserve(10000);
+    for (int i = 0; i < 10000; i++)
+        reg.emplaceDesc(0x10000 + i * 4096, 4096, 0, std::string(32, 'a' + i % 26));
+    assert(reg.descCount() == 10000);
+    assert(reg[25].metaInfo == std::string(32, 'z'));
+
+    const nixlBlobDesc *data = &reg[0];
+    nixl_reg_dlist_t moved = std::move(reg);
+    assert(&moved[0] == data);
+    assert(reg.isEmpty());
+
+    nixl_xfer_dlist_t sorted (DRAM_SEG, true);
+    for (int i = 9; i >= 0; i--)
+        sorted.emplaceDesc(0x1000 + i * 64, 64, 0);
+    assert(sorted.verifySorted());
+    assert(sorted[0] == nixlBasicDesc(0x1000, 64, 0));
+}
+
+// Bulk sorted insertion matching addDesc one by one, and bulk removal
+void testBulk(){
+    nixl_reg_dlist_t one_by_one (DRAM_SEG, true), bulk (DRAM_SEG, true), more (DRAM_SEG);
+
+    for (int i = 0; i < 1000; i++) {
+        nixlBlobDesc desc((i * 7919) % 500 * 64, 64, i % 3, std::to_string(i));
+        if (i < 300) {
+            one_by_one.addDesc(desc);
+            bulk.addDesc(desc);
+        } else {
+            one_by_one.addDesc(desc);
+            more.addDesc(desc);
+        }
+    }
+    bulk.addDescs(more.begin(), more.end());
+    assert(bulk == one_by_one);
+    // Equal descriptors are kept in the order they were added
+    for (int i = 0; i < bulk.descCount(); i++)
+        assert(bulk[i].metaInfo == one_by_one[i].metaInfo);
+
+    bulk.remDescs({999, 0, 500, 0, 1});
+    one_by_one.remDesc(999);
+    one_by_one.remDesc(500);
+    one_by_one.remDesc(1);
+    one_by_one.remDesc(0);
+    assert(bulk == one_by_one);
+    assert(bulk.verifySorted());
+}
+
 void testPerf(){
     int desc_count = 24*64*1024;
     void* buf = malloc(256);
@@ -291,6 +481,37 @@ int main()
     nixl_reg_dlist_t importSList (ser_des2);
     assert(importSList == dlist20);
 
+    // Packed lists are delta encoded, and compact for sorted regions
+    nixlSerDes ser_des3, ser_des4, ser_des5;
+    assert(dlist20.serialize(&ser_des3, true) == 0);
+    nixl_reg_dlist_t importPList (&ser_des3);
+    assert(importPList == dlist20);
+
+    nixl_reg_dlist_t dlist26 (VRAM_SEG, true);
+    for (int i = 0; i < 1024; i++)
+        dlist26.addDesc(nixlBlobDesc(0x10000 + i * 8192, 4096, i % 4,
+                                     "rkey" + std::to_string(i % 7)));
+    assert(dlist26.serialize(&ser_des4) == 0);
+    assert(dlist26.serialize(&ser_des5, true) == 0);
+    assert(ser_des5.exportStr().size() < ser_des4.exportStr().size() / 2);
+    nixl_reg_dlist_t importPList2 (&ser_des5);
+    assert(importPList2 == dlist26);
+
+    // Without blobs, runs of the same len and devId are encoded once
+    nixlSerDes ser_des6, ser_des7, ser_des8;
+    nixl_xfer_dlist_t dlist27 (VRAM_SEG, true);
+    for (int i = 0; i < 1024; i++)
+        dlist27.addDesc(nixlBasicDesc(0x10000 + (i % 512) * 4096, 4096, i / 512));
+    dlist27.addDesc(nixlBasicDesc(0x10000, 64, 3));
+    assert(dlist27.serialize(&ser_des6) == 0);
+    assert(dlist27.serialize(&ser_des7, true) == 0);
+    assert(ser_des7.exportStr().size() < ser_des6.exportStr().size() / 10);
+    nixl_xfer_dlist_t importPList3 (&ser_des7);
+    assert(importPList3 == dlist27);
+    assert(dlist10.serialize(&ser_des8, true) == 0);
+    nixl_xfer_dlist_t importPList4 (&ser_des8);
+    assert(importPList4 == dlist10);
+
     dlist10.print();
     std::cout << "this should be a copy:\n";
     importList.print();
@@ -306,6 +527,11 @@ int main()
     nixl_reg_dlist_t dlist24 (DRAM_SEG, false);
     nixl_reg_dlist_t dlist25 (DRAM_SEG, false);
 
+    testKernels();
+    testInline();
+    testStrided();
+    testEmplace();
+    testBulk();
     testPerf();
 
     delete ser_des;
@@ -13,6 +13,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import pickle
 
 import nixl._bindings as nixl
@@ -54,6 +55,18 @@ def test_list():
     test_list.addDesc((2000, 100, 0))
 
 
+def test_list_from_buffer():
+    descs = [(1000, 105, 0), (2000, 30, 0), (1010, 20, 0)]
+    flat = array.array("q", [field for desc in descs for field in desc])
+
+    xfer_list = nixl.nixlXferDList(nixl.DRAM_SEG, flat, False)
+    assert xfer_list == nixl.nixlXferDList(nixl.DRAM_SEG, descs, False)
+
+    reg_list = nixl.nixlRegDList(nixl.DRAM_SEG, memoryview(flat), False)
+    assert reg_list.descCount() == 3
+    assert reg_list[2] == (1010, 20, 0, "")
+
+
 def test_agent():
     name1 = "Agent1"
     name2 = "Agent2"
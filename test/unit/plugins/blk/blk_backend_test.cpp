@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "blk_backend.h"
+
+#define DESC_CNT 8
+#define DESC_SIZE (256 * 1024)
+
+static nixlBackendEngine *createEngine()
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    // Small requests and queues, so IOs are split and wait for the ring
+    custom_params["queues"] = "2";
+    custom_params["queue_depth"] = "8";
+    custom_params["max_request_size"] = "65536";
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = "Agent1";
+    init.customParams = &custom_params;
+    init.type         = "BLK";
+
+    nixlBackendEngine *blk = new nixlBlkEngine(&init);
+    assert(!blk->getInitErr());
+    if (blk->getInitErr()) {
+        std::cout << "Failed to initialize BLK engine" << std::endl;
+        exit(1);
+    }
+    return blk;
+}
+
+static nixl_status_t doTransfer(nixlBackendEngine *blk, nixl_xfer_op_t op,
+                                nixl_meta_dlist_t &bufs, nixl_meta_dlist_t &devs)
+{
+    nixlBackendReqH *handle;
+    nixl_status_t ret;
+
+    ret = blk->prepXfer(op, bufs, devs, "Agent1", handle);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    ret = blk->postXfer(op, bufs, devs, "Agent1", handle);
+    while (ret == NIXL_IN_PROG) {
+        ret = blk->checkXfer(handle);
+    }
+
+    blk->releaseReqH(handle);
+    return ret;
+}
+
+// A regular file stands in for the device, raw devices need privileges
+static void testDevRoundTrip()
+{
+    nixlBackendEngine *blk = createEngine();
+    char path[] = "/tmp/nixl_blk_testXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    unlink(path);
+
+    size_t len = DESC_CNT * DESC_SIZE;
+    char *src = (char*) aligned_alloc(4096, len);
+    char *dst = (char*) aligned_alloc(4096, len);
+    for (size_t i = 0; i < len; i++) {
+        src[i] = (char) (i * 13 + 5);
+    }
+    memset(dst, 0, len);
+
+    nixlBackendMD *src_md, *dst_md, *dev_md;
+    nixlBlobDesc mem;
+
+    mem.addr = (uintptr_t) src;
+    mem.len = len;
+    mem.devId = 0;
+    nixl_status_t ret = blk->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = blk->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = 0;
+    mem.devId = fd;
+    ret = blk->registerMem(mem, BLK_SEG, dev_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG), dev_list(BLK_SEG);
+    for (int i = 0; i < DESC_CNT; i++) {
+        nixlMetaDesc desc;
+
+        // Buffer chunks land on the device in reverse order
+        desc.addr = (uintptr_t) (src + i * DESC_SIZE);
+        desc.len = DESC_SIZE;
+        desc.devId = 0;
+        desc.metadataP = src_md;
+        src_list.addDesc(desc);
+
+        desc.addr = (uintptr_t) (dst + i * DESC_SIZE);
+        desc.metadataP = dst_md;
+        dst_list.addDesc(desc);
+
+        desc.addr = (DESC_CNT - 1 - i) * DESC_SIZE;
+        desc.devId = fd;
+        desc.metadataP = dev_md;
+        dev_list.addDesc(desc);
+    }
+
+    ret = doTransfer(blk, NIXL_WRITE, src_list, dev_list);
+    assert(ret == NIXL_SUCCESS);
+    ret = doTransfer(blk, NIXL_READ, dst_list, dev_list);
+    assert(ret == NIXL_SUCCESS);
+    assert(memcmp(src, dst, len) == 0);
+
+    char check[16];
+    ssize_t bytes = pread(fd, check, sizeof(check), (DESC_CNT - 1) * DESC_SIZE);
+    assert(bytes == sizeof(check));
+    assert(memcmp(check, src, sizeof(check)) == 0);
+
+    // Reading past the end of the file fails
+    dev_list[0].addr = len;
+    ret = doTransfer(blk, NIXL_READ, dst_list, dev_list);
+    assert(ret == NIXL_ERR_BACKEND);
+
+    blk->deregisterMem(src_md);
+    blk->deregisterMem(dst_md);
+    blk->deregisterMem(dev_md);
+    close(fd);
+    free(src);
+    free(dst);
+    delete blk;
+}
+
+static void testBadDevice()
+{
+    nixlBackendEngine *blk = createEngine();
+    nixlBackendMD *md;
+    nixlBlobDesc mem;
+    int fds[2];
+
+    int rc = pipe(fds);
+    assert(rc == 0);
+    mem.addr = 0;
+    mem.len = 0;
+    mem.devId = fds[0];
+    nixl_status_t ret = blk->registerMem(mem, BLK_SEG, md);
+    assert(ret == NIXL_ERR_INVALID_PARAM);
+
+    close(fds[0]);
+    close(fds[1]);
+    delete blk;
+}
+
+int main()
+{
+    testDevRoundTrip();
+    testBadDevice();
+
+    std::cout << "BLK backend test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "cma_backend.h"
+#include "serdes/serdes.h"
+
+#define BUF_SIZE (4 * 1024 * 1024)
+#define DESC_CNT 4
+
+static nixlBackendEngine *createEngine(const std::string &name)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = name;
+    init.customParams = &custom_params;
+    init.type         = "CMA";
+
+    nixlBackendEngine *cma = new nixlCmaEngine(&init);
+    assert(!cma->getInitErr());
+    if (cma->getInitErr()) {
+        std::cout << "Failed to initialize CMA engine" << std::endl;
+        exit(1);
+    }
+    return cma;
+}
+
+static void writeMsg(int fd, const std::string &str)
+{
+    size_t len = str.size();
+    ssize_t bytes = write(fd, &len, sizeof(len));
+    assert(bytes == sizeof(len));
+    bytes = write(fd, str.data(), len);
+    assert(bytes == (ssize_t) len);
+}
+
+static std::string readMsg(int fd)
+{
+    size_t len;
+    ssize_t bytes = read(fd, &len, sizeof(len));
+    assert(bytes == sizeof(len));
+    std::string str(len, '\0');
+    size_t done = 0;
+    while (done < len) {
+        ssize_t ret = read(fd, &str[done], len - done);
+        assert(ret > 0);
+        done += ret;
+    }
+    return str;
+}
+
+static std::string waitNotif(nixlBackendEngine *cma, const std::string &from)
+{
+    nixl_status_t ret;
+    notif_list_t notifs;
+
+    while (notifs.empty()) {
+        ret = cma->getNotifs(notifs);
+        assert(ret == NIXL_SUCCESS);
+    }
+    assert(notifs.size() == 1);
+    assert(notifs[0].first == from);
+    return notifs[0].second;
+}
+
+static void fillDescs(nixl_meta_dlist_t &list, char *base, nixlBackendMD *md)
+{
+    for (int i = 0; i < DESC_CNT; i++) {
+        nixlMetaDesc desc;
+        desc.addr = (uintptr_t) (base + i * (BUF_SIZE / DESC_CNT));
+        desc.len = BUF_SIZE / DESC_CNT;
+        desc.devId = 0;
+        desc.metadataP = md;
+        list.addDesc(desc);
+    }
+}
+
+// Target side: exposes a buffer, checks what Agent1 wrote and fills it for
+// the read back
+static int runTarget(int in_fd, int out_fd)
+{
+    nixlBackendEngine *cma = createEngine("Agent2");
+    char *buf = (char*) calloc(1, BUF_SIZE);
+    nixlBackendMD *md;
+    nixlBlobDesc mem;
+    std::string conn_info;
+
+    mem.addr = (uintptr_t) buf;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = cma->registerMem(mem, DRAM_SEG, md);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+
+    writeMsg(out_fd, conn_info);
+    writeMsg(out_fd, std::to_string((uintptr_t) buf));
+    ret = cma->loadRemoteConnInfo("Agent1", readMsg(in_fd));
+    assert(ret == NIXL_SUCCESS);
+
+    std::string msg = waitNotif(cma, "Agent1");
+    assert(msg == "written");
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        assert(buf[i] == (char) (i * 3 + 1));
+        buf[i] = (char) (i * 5 + 2);
+    }
+    ret = cma->genNotif("Agent1", "filled");
+    assert(ret == NIXL_SUCCESS);
+
+    msg = waitNotif(cma, "Agent1");
+    assert(msg == "done");
+    cma->deregisterMem(md);
+    free(buf);
+    delete cma;
+    return 0;
+}
+
+static void doTransfer(nixlBackendEngine *cma, nixl_xfer_op_t op,
+                       nixl_meta_dlist_t &local, nixl_meta_dlist_t &remote,
+                       const std::string &msg)
+{
+    nixlBackendReqH *handle;
+    nixl_opt_b_args_t opt_args;
+    nixl_status_t ret;
+
+    opt_args.notifMsg = msg;
+    opt_args.hasNotif = !msg.empty();
+
+    ret = cma->prepXfer(op, local, remote, "Agent2", handle, &opt_args);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->postXfer(op, local, remote, "Agent2", handle, &opt_args);
+    while (ret == NIXL_IN_PROG) {
+        ret = cma->checkXfer(handle);
+    }
+    assert(ret == NIXL_SUCCESS);
+    cma->releaseReqH(handle);
+}
+
+static void testLocal()
+{
+    nixlBackendEngine *cma = createEngine("Agent1");
+    char *src = (char*) malloc(BUF_SIZE);
+    char *dst = (char*) calloc(1, BUF_SIZE);
+    nixlBackendMD *src_md, *dst_md, *dst_local_md;
+    nixlBlobDesc mem;
+    nixlBackendReqH *handle;
+
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        src[i] = (char) (i * 7);
+    }
+
+    mem.addr = (uintptr_t) src;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = cma->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = cma->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->loadLocalMD(dst_md, dst_local_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG);
+    fillDescs(src_list, src, src_md);
+    fillDescs(dst_list, dst, dst_local_md);
+
+    ret = cma->prepXfer(NIXL_WRITE, src_list, dst_list, "Agent1", handle);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->postXfer(NIXL_WRITE, src_list, dst_list, "Agent1", handle);
+    assert(ret == NIXL_SUCCESS);
+    cma->releaseReqH(handle);
+    assert(memcmp(src, dst, BUF_SIZE) == 0);
+
+    cma->unloadMD(dst_local_md);
+    cma->deregisterMem(src_md);
+    cma->deregisterMem(dst_md);
+    free(src);
+    free(dst);
+    delete cma;
+}
+
+static void testRemote()
+{
+    int to_target[2], from_target[2];
+    int rc = pipe(to_target);
+    assert(rc == 0);
+    rc = pipe(from_target);
+    assert(rc == 0);
+
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        close(to_target[1]);
+        close(from_target[0]);
+        _exit(runTarget(to_target[0], from_target[1]));
+    }
+    close(to_target[0]);
+    close(from_target[1]);
+
+    nixlBackendEngine *cma = createEngine("Agent1");
+    char *buf = (char*) malloc(BUF_SIZE);
+    nixlBackendMD *local_md, *remote_md;
+    nixlBlobDesc mem;
+    std::string conn_info;
+
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        buf[i] = (char) (i * 3 + 1);
+    }
+    mem.addr = (uintptr_t) buf;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = cma->registerMem(mem, DRAM_SEG, local_md);
+    assert(ret == NIXL_SUCCESS);
+
+    std::string target_info = readMsg(from_target[0]);
+    ret = cma->loadRemoteConnInfo("Agent2", target_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->connect("Agent2");
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = std::stoull(readMsg(from_target[0]));
+    ret = cma->loadRemoteMD(mem, DRAM_SEG, "Agent2", remote_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = cma->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    writeMsg(to_target[1], conn_info);
+
+    nixl_meta_dlist_t local_list(DRAM_SEG), remote_list(DRAM_SEG);
+    fillDescs(local_list, buf, local_md);
+    fillDescs(remote_list, (char*) mem.addr, remote_md);
+
+    doTransfer(cma, NIXL_WRITE, local_list, remote_list, "written");
+    std::string msg = waitNotif(cma, "Agent2");
+    assert(msg == "filled");
+    doTransfer(cma, NIXL_READ, local_list, remote_list, "");
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        assert(buf[i] == (char) (i * 5 + 2));
+    }
+    // Another process naming itself Agent1 is not taken for it
+    int status;
+    pid_t forger = fork();
+    assert(forger >= 0);
+    if (forger == 0) {
+        nixlLocalNotifier notifier;
+        nixlSerDes sd;
+        pid_t target_pid;
+        if ((notifier.init("nixl-cma-test") != NIXL_SUCCESS) ||
+            (sd.importStr(target_info) != NIXL_SUCCESS)) {
+            _exit(1);
+        }
+        // Read in the order of getConnInfo
+        sd.getStr("HostId");
+        sd.getBuf("Pid", &target_pid, sizeof(target_pid));
+        _exit(notifier.send(sd.getStr("Sock"), "Agent1", "forged") == NIXL_SUCCESS ? 0 : 1);
+    }
+    pid_t waited = waitpid(forger, &status, 0);
+    assert(waited == forger);
+    assert(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    ret = cma->genNotif("Agent2", "done");
+    assert(ret == NIXL_SUCCESS);
+
+    waited = waitpid(child, &status, 0);
+    assert(waited == child);
+    assert(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    cma->unloadMD(remote_md);
+    cma->deregisterMem(local_md);
+    cma->disconnect("Agent2");
+    free(buf);
+    delete cma;
+}
+
+int main()
+{
+    testLocal();
+    testRemote();
+
+    std::cout << "CMA backend test passed" << std::endl;
+    return 0;
+}
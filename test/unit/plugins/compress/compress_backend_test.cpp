@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include "compress_backend.h"
+#include "plugin_manager.h"
+
+#define DESC_SIZE (1024 * 1024)
+#define SMALL_SIZE 1024
+#define DESC_CNT 3
+
+// Two agents of this process, over CMA as the inner backend
+static nixlBackendEngine *createEngine(const std::string &name)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    custom_params["backend"] = "CMA";
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = name;
+    init.customParams = &custom_params;
+    init.type         = "COMPRESS";
+    init.factory      = nixlPluginManager::getInstance().getEngineFactory();
+
+    nixlBackendEngine *comp = new nixlCompressEngine(&init);
+    assert(!comp->getInitErr());
+    if (comp->getInitErr()) {
+        std::cout << "Failed to initialize COMPRESS engine" << std::endl;
+        exit(1);
+    }
+    return comp;
+}
+
+static std::string waitNotif(nixlBackendEngine *comp, const std::string &from)
+{
+    nixl_status_t ret;
+    notif_list_t notifs;
+
+    while (notifs.empty()) {
+        ret = comp->getNotifs(notifs);
+        assert(ret == NIXL_SUCCESS);
+    }
+    assert(notifs.size() == 1);
+    assert(notifs[0].first == from);
+    return notifs[0].second;
+}
+
+static void doWrite(nixlBackendEngine *comp, nixl_meta_dlist_t &local,
+                    nixl_meta_dlist_t &remote, const std::string &msg,
+                    nixl_b_params_t &stats)
+{
+    nixlBackendReqH *handle;
+    nixl_opt_b_args_t opt_args;
+    nixl_status_t ret;
+
+    opt_args.notifMsg = msg;
+    opt_args.hasNotif = !msg.empty();
+
+    ret = comp->prepXfer(NIXL_WRITE, local, remote, "Agent2", handle, &opt_args);
+    assert(ret == NIXL_SUCCESS);
+    ret = comp->postXfer(NIXL_WRITE, local, remote, "Agent2", handle, &opt_args);
+    while (ret == NIXL_IN_PROG) {
+        ret = comp->checkXfer(handle);
+    }
+    assert(ret == NIXL_SUCCESS);
+    ret = comp->getXferStats(handle, stats);
+    assert(ret == NIXL_SUCCESS);
+    comp->releaseReqH(handle);
+}
+
+int main()
+{
+    nixlBackendEngine *sender = createEngine("Agent1");
+    nixlBackendEngine *receiver = createEngine("Agent2");
+    std::string conn_info;
+
+    nixl_status_t ret = sender->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = receiver->loadRemoteConnInfo("Agent1", conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = receiver->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = sender->loadRemoteConnInfo("Agent2", conn_info);
+    assert(ret == NIXL_SUCCESS);
+
+    size_t len = 2 * DESC_SIZE + SMALL_SIZE;
+    char *src = (char*) malloc(len);
+    char *dst = (char*) calloc(1, len);
+
+    // Text like data, random data, and a block below min_size
+    for (size_t i = 0; i < DESC_SIZE; i++) {
+        src[i] = "nixl compress "[i % 14];
+    }
+    srand(1);
+    for (size_t i = DESC_SIZE; i < len; i++) {
+        src[i] = (char) rand();
+    }
+    memset(src + 2 * DESC_SIZE, 'x', SMALL_SIZE);
+
+    nixlBackendMD *src_md, *dst_md, *remote_md;
+    nixlBlobDesc mem;
+    std::string blob;
+
+    mem.addr = (uintptr_t) src;
+    mem.len = len;
+    mem.devId = 0;
+    ret = sender->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = receiver->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = receiver->getPublicData(dst_md, blob);
+    assert(ret == NIXL_SUCCESS);
+    mem.metaInfo = blob;
+    ret = sender->loadRemoteMD(mem, DRAM_SEG, "Agent2", remote_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG);
+    size_t sizes[DESC_CNT] = {DESC_SIZE, DESC_SIZE, SMALL_SIZE};
+    size_t offset = 0;
+    for (int i = 0; i < DESC_CNT; i++) {
+        nixlMetaDesc desc;
+
+        desc.addr = (uintptr_t) (src + offset);
+        desc.len = sizes[i];
+        desc.devId = 0;
+        desc.metadataP = src_md;
+        src_list.addDesc(desc);
+
+        desc.addr = (uintptr_t) (dst + offset);
+        desc.metadataP = remote_md;
+        dst_list.addDesc(desc);
+        offset += sizes[i];
+    }
+
+    // Only the first block is worth compressing, and is in place before
+    // the notification shows up
+    nixl_b_params_t stats;
+    doWrite(sender, src_list, dst_list, "written", stats);
+    std::string msg = waitNotif(receiver, "Agent1");
+    assert(msg == "written");
+    assert(memcmp(src, dst, len) == 0);
+    assert(stats["compressed_descs"] == "1");
+    assert(stats["skipped_descs"] == "2");
+    assert(std::stoul(stats["wire_bytes"]) < std::stoul(stats["orig_bytes"]) - DESC_SIZE / 2);
+    std::cout << "Sent " << stats["orig_bytes"] << " bytes as " << stats["wire_bytes"]
+              << ", ratio " << stats["ratio"] << std::endl;
+
+    // Without a notification, nothing is compressed
+    memset(src, 'y', DESC_SIZE);
+    doWrite(sender, src_list, dst_list, "", stats);
+    assert(memcmp(src, dst, len) == 0);
+    assert(stats["compressed_descs"] == "0");
+
+    // Standalone notifications go through as they are
+    ret = sender->genNotif("Agent2", "plain");
+    assert(ret == NIXL_SUCCESS);
+    msg = waitNotif(receiver, "Agent1");
+    assert(msg == "plain");
+
+    sender->unloadMD(remote_md);
+    sender->deregisterMem(src_md);
+    receiver->deregisterMem(dst_md);
+    free(src);
+    free(dst);
+    delete sender;
+    delete receiver;
+
+    std::cout << "COMPRESS backend test passed" << std::endl;
+    return 0;
+}
@@ -26,6 +26,8 @@
 #include <cerrno>
 #include <cstring>
 #include <getopt.h>
+#include <dirent.h>
+#include <vector>
 #include "nixl_descriptors.h"
 #include "nixl_params.h"
 #include "nixl.h"
@@ -195,6 +197,319 @@ std::string format_duration(nixlTime::us_t us) {
     return ss.str();
 }
 
+// Backend feature checks. Each runs on its own agent and backend, with the
+// parameters it needs, and moves a seeded pattern through a file holding a
+// background pattern, checking the buffer or the whole file after every post.
+typedef struct {
+    const char*     name;
+    nixl_b_params_t params;
+    size_t          size;           // Of each descriptor
+    size_t          file_offset;    // Of the first descriptor
+    size_t          file_gap;       // Between descriptors, so they are not merged
+    int             descs;
+    int             reposts;        // Posts of the same request
+    bool            use_stream;
+} feature_check_t;
+
+static feature_check_t default_check(const char* name) {
+    feature_check_t check;
+
+    check.name = name;
+    check.size = 64 * 1024;
+    check.file_offset = 0;
+    check.file_gap = PAGE_SIZE;
+    check.descs = 4;
+    check.reposts = 1;
+    check.use_stream = false;
+    return check;
+}
+
+static void fill_seed_pattern(char* buf, size_t size, unsigned int seed) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = (char)(((i ^ (i >> 8) ^ (i >> 16)) * 31 + seed) & 0xff);
+    }
+}
+
+// On a stream the copy is queued, and ordered with the transfers on it
+static bool copy_mem(void* dst, const void* src, size_t size, bool use_vram,
+                     cudaStream_t stream) {
+    if (stream) {
+        return cudaMemcpyAsync(dst, src, size, cudaMemcpyDefault, stream) == cudaSuccess;
+    }
+    if (!use_vram) {
+        memcpy(dst, src, size);
+        return true;
+    }
+    return cudaMemcpy(dst, src, size, cudaMemcpyDefault) == cudaSuccess;
+}
+
+static nixl_status_t post_xfer(nixlAgent& agent, nixlXferReqH* req, cudaStream_t stream) {
+    nixl_opt_args_t extra_params;
+
+    extra_params.cudaStream = stream;
+    return agent.postXferReq(req, stream ? &extra_params : nullptr);
+}
+
+static bool wait_xfer(nixlAgent& agent, nixlXferReqH* req, nixl_status_t status,
+                      cudaStream_t stream) {
+    if (stream && (status >= 0) && (cudaStreamSynchronize(stream) != cudaSuccess)) {
+        return false;
+    }
+    while (status == NIXL_IN_PROG) {
+        status = agent.getXferStatus(req);
+    }
+    return status == NIXL_SUCCESS;
+}
+
+static bool run_feature_check(const feature_check_t& check, const std::string& dir_path,
+                              bool use_vram, bool use_direct) {
+    nixlAgentConfig cfg(true);
+    std::string agent_name = std::string("GDSCheck_") + check.name;
+    nixlAgent agent(agent_name, cfg);
+    nixlBackendH* gds = nullptr;
+    size_t total = check.size * check.descs;
+    size_t stride = check.size + check.file_gap;
+    // The background goes a block past the transfer, edges must keep it
+    size_t file_size = check.file_offset + stride * check.descs + PAGE_SIZE;
+    std::vector<char> expected(file_size), actual(file_size), pattern(total);
+    nixl_mem_t buf_type = use_vram ? VRAM_SEG : DRAM_SEG;
+    nixl_reg_dlist_t buf_reg(buf_type), file_reg(FILE_SEG);
+    nixl_xfer_dlist_t buf_list(buf_type), file_list(FILE_SEG);
+    nixlXferReqH* write_req = nullptr;
+    nixlXferReqH* read_req = nullptr;
+    cudaStream_t stream = nullptr;
+    std::string path = dir_path + "/" +
+                       generate_timestamped_filename(std::string("feature_") + check.name);
+    void* buf = nullptr;
+    int flags = O_RDWR | O_CREAT | O_TRUNC | (use_direct ? O_DIRECT : 0);
+    int fd = -1;
+    int io_fd = -1;     // Buffered, to set and check the file around the transfers
+    nixl_status_t status = NIXL_SUCCESS;
+    bool ok = false;
+
+    if ((agent.createBackend("GDS", check.params, gds) != NIXL_SUCCESS) || !gds) {
+        std::cerr << check.name << ": failed to create the GDS backend" << std::endl;
+        return false;
+    }
+    if (use_vram ? (cudaMalloc(&buf, total) != cudaSuccess) :
+                   (posix_memalign(&buf, PAGE_SIZE, total) != 0)) {
+        std::cerr << check.name << ": buffer allocation failed" << std::endl;
+        return false;
+    }
+    if (check.use_stream && (cudaStreamCreate(&stream) != cudaSuccess)) {
+        std::cerr << check.name << ": cudaStreamCreate failed" << std::endl;
+        stream = nullptr;
+        goto out;
+    }
+
+    fd = open(path.c_str(), flags, 0744);
+    io_fd = open(path.c_str(), O_RDWR);
+    if ((fd < 0) || (io_fd < 0)) {
+        std::cerr << check.name << ": failed to open " << path << std::endl;
+        goto out;
+    }
+
+    buf_reg.addDesc(nixlBlobDesc((uintptr_t) buf, total, 0, ""));
+    file_reg.addDesc(nixlBlobDesc(0, file_size, fd, ""));
+    if ((agent.registerMem(buf_reg) != NIXL_SUCCESS) ||
+        (agent.registerMem(file_reg) != NIXL_SUCCESS)) {
+        std::cerr << check.name << ": registration failed" << std::endl;
+        goto out;
+    }
+
+    for (int i = 0; i < check.descs; i++) {
+        buf_list.addDesc(nixlBasicDesc((uintptr_t) buf + i * check.size, check.size, 0));
+        file_list.addDesc(nixlBasicDesc(check.file_offset + i * stride,
+                                        check.size, fd));
+    }
+    if ((agent.createXferReq(NIXL_WRITE, buf_list, file_list, agent_name,
+                             write_req) != NIXL_SUCCESS) ||
+        (agent.createXferReq(NIXL_READ, buf_list, file_list, agent_name,
+                             read_req) != NIXL_SUCCESS)) {
+        std::cerr << check.name << ": failed to create the transfer requests" << std::endl;
+        goto out;
+    }
+
+    for (int post = 0; post < check.reposts; post++) {
+        unsigned int seed = 2 * post + 1;
+
+        // Write: the file changes in the descriptor ranges only
+        fill_seed_pattern(expected.data(), file_size, 0xa5);
+        if ((pwrite(io_fd, expected.data(), file_size, 0) != (ssize_t) file_size) ||
+            (fsync(io_fd) != 0)) {
+            std::cerr << check.name << ": failed to write the background" << std::endl;
+            goto out;
+        }
+        fill_seed_pattern(pattern.data(), total, seed);
+        for (int i = 0; i < check.descs; i++) {
+            memcpy(expected.data() + check.file_offset + i * stride,
+                   pattern.data() + i * check.size, check.size);
+        }
+        if (!copy_mem(buf, pattern.data(), total, use_vram, stream)) {
+            std::cerr << check.name << ": failed to fill the buffer" << std::endl;
+            goto out;
+        }
+        status = post_xfer(agent, write_req, stream);
+        if (stream && (status == NIXL_ERR_NOT_SUPPORTED)) {
+            // Built without the cuFile async API
+            std::cout << "- " << check.name << ": not supported, skipped" << std::endl;
+            ok = true;
+            goto out;
+        }
+        if (!wait_xfer(agent, write_req, status, stream)) {
+            std::cerr << check.name << ": write " << post << " failed" << std::endl;
+            goto out;
+        }
+        if ((pread(io_fd, actual.data(), file_size, 0) != (ssize_t) file_size) ||
+            (actual != expected)) {
+            std::cerr << check.name << ": file mismatch after write " << post << std::endl;
+            goto out;
+        }
+
+        // Read: the buffer gets another pattern, put in the file directly
+        fill_seed_pattern(pattern.data(), total, seed + 1);
+        for (int i = 0; i < check.descs; i++) {
+            memcpy(expected.data() + check.file_offset + i * stride,
+                   pattern.data() + i * check.size, check.size);
+        }
+        if ((pwrite(io_fd, expected.data(), file_size, 0) != (ssize_t) file_size) ||
+            (fsync(io_fd) != 0)) {
+            std::cerr << check.name << ": failed to write the file" << std::endl;
+            goto out;
+        }
+        std::fill(actual.begin(), actual.end(), 0);
+        if (!copy_mem(buf, actual.data(), total, use_vram, stream)) {
+            std::cerr << check.name << ": failed to clear the buffer" << std::endl;
+            goto out;
+        }
+        status = post_xfer(agent, read_req, stream);
+        // Queued behind the read, it must see the data
+        if (stream && !copy_mem(actual.data(), buf, total, use_vram, stream)) {
+            status = NIXL_ERR_BACKEND;
+        }
+        if (!wait_xfer(agent, read_req, status, stream) ||
+            (!stream && !copy_mem(actual.data(), buf, total, use_vram, nullptr))) {
+            std::cerr << check.name << ": read " << post << " failed" << std::endl;
+            goto out;
+        }
+        if (memcmp(actual.data(), pattern.data(), total) != 0) {
+            std::cerr << check.name << ": buffer mismatch after read " << post << std::endl;
+            goto out;
+        }
+    }
+    ok = true;
+
+out:
+    if (write_req) {
+        agent.releaseXferReq(write_req);
+    }
+    if (read_req) {
+        agent.releaseXferReq(read_req);
+    }
+    agent.deregisterMem(file_reg);
+    agent.deregisterMem(buf_reg);
+    if (io_fd >= 0) {
+        close(io_fd);
+    }
+    if (fd >= 0) {
+        close(fd);
+        unlink(path.c_str());
+    }
+    if (stream) {
+        cudaStreamDestroy(stream);
+    }
+    if (use_vram) {
+        cudaFree(buf);
+    } else {
+        free(buf);
+    }
+    if (!ok || (status != NIXL_ERR_NOT_SUPPORTED)) {
+        std::cout << "- " << check.name << ": " << (ok ? "passed" : "FAILED") << std::endl;
+    }
+    return ok;
+}
+
+// Descriptors of this process open on a file
+static int count_open_fds(const std::string& path) {
+    char real_path[PATH_MAX];
+    char link[PATH_MAX];
+    struct dirent* ent;
+    DIR* dir;
+    int count = 0;
+
+    if (!realpath(path.c_str(), real_path) || !(dir = opendir("/proc/self/fd"))) {
+        return -1;
+    }
+    while ((ent = readdir(dir)) != nullptr) {
+        std::string fd_path = std::string("/proc/self/fd/") + ent->d_name;
+        ssize_t len = readlink(fd_path.c_str(), link, sizeof(link) - 1);
+
+        if (len < 0) {
+            continue;
+        }
+        link[len] = '\0';
+        if (strcmp(link, real_path) == 0) {
+            count++;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+// The registrations of one file share a cuFile handle, on a dup of the
+// first fd, and up to file_cache_size unused handles stay open
+static bool run_file_cache_check(const std::string& dir_path, bool use_direct) {
+    nixlAgentConfig cfg(true);
+    std::string agent_name = "GDSCheck_file_cache";
+    nixlAgent agent(agent_name, cfg);
+    nixl_b_params_t params;
+    nixlBackendH* gds = nullptr;
+    nixl_reg_dlist_t first_reg(FILE_SEG), second_reg(FILE_SEG);
+    std::string path = dir_path + "/" + generate_timestamped_filename("feature_file_cache");
+    int flags = O_RDWR | O_CREAT | (use_direct ? O_DIRECT : 0);
+    int shared = -1;
+    int cached = -1;
+    bool ok;
+
+    params["file_cache_size"] = "4";
+    if ((agent.createBackend("GDS", params, gds) != NIXL_SUCCESS) || !gds) {
+        std::cerr << "file_cache: failed to create the GDS backend" << std::endl;
+        return false;
+    }
+
+    int first_fd = open(path.c_str(), flags, 0744);
+    int second_fd = open(path.c_str(), flags);
+    if ((first_fd >= 0) && (second_fd >= 0)) {
+        first_reg.addDesc(nixlBlobDesc(0, PAGE_SIZE, first_fd, ""));
+        second_reg.addDesc(nixlBlobDesc(0, PAGE_SIZE, second_fd, ""));
+        if ((agent.registerMem(first_reg) == NIXL_SUCCESS) &&
+            (agent.registerMem(second_reg) == NIXL_SUCCESS)) {
+            // The two fds of the test and the one of the shared handle
+            shared = count_open_fds(path);
+        }
+        agent.deregisterMem(first_reg);
+        agent.deregisterMem(second_reg);
+    }
+    if (first_fd >= 0) {
+        close(first_fd);
+    }
+    if (second_fd >= 0) {
+        close(second_fd);
+    }
+
+    // Nothing registered and the test fds closed, the cache still holds it
+    cached = count_open_fds(path);
+    unlink(path.c_str());
+
+    ok = (shared == 3) && (cached == 1);
+    if (!ok) {
+        std::cerr << "file_cache: " << shared << " then " << cached
+                  << " descriptors open on the file, expected 3 then 1" << std::endl;
+    }
+    std::cout << "- file_cache: " << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
+
 int main(int argc, char *argv[])
 {
     nixl_status_t               ret = NIXL_SUCCESS;
@@ -219,6 +534,7 @@ int main(int argc, char *argv[])
     double                      total_data_gb = 0;
     bool                        use_direct = false;
     unsigned int                iterations = DEFAULT_ITERATIONS;
+    bool                        checks_failed = false;
 
     // Parse command line options
     static struct option long_options[] = {
@@ -733,11 +1049,68 @@ cleanup:
     }
     delete[] ftrans;
 
+    std::cout << "\n============================================================" << std::endl;
+    std::cout << "PHASE 7: Backend feature checks" << std::endl;
+    std::cout << "============================================================" << std::endl;
+    {
+        std::vector<feature_check_t> checks;
+
+        // Batches are filled at prep and resubmitted as is, every repost
+        // must still move what the buffer or the file holds at post time
+        checks.push_back(default_check("repost"));
+        checks.back().reposts = 3;
+        checks.back().params["batch_limit"] = "2";
+
+        // Eight batches over four submission threads
+        checks.push_back(default_check("submit_threads"));
+        checks.back().descs = 16;
+        checks.back().reposts = 2;
+        checks.back().params["batch_limit"] = "2";
+        checks.back().params["submit_threads"] = "4";
+
+        // Stream ordered posts, with the buffer filled and read back by
+        // copies queued around them on the same stream
+        if (use_vram) {
+            checks.push_back(default_check("stream"));
+            checks.back().reposts = 2;
+            checks.back().use_stream = true;
+        }
+
+        // Unaligned file ranges staged through the bounce pool. Close
+        // descriptors share blocks at their edges, and small ones all fall
+        // in one block, so their write backs go one round after the other.
+        // The background around the transfer must survive.
+        checks.push_back(default_check("unaligned"));
+        checks.back().size = 10000;
+        checks.back().file_offset = 100;
+        checks.back().file_gap = 50;
+        checks.back().descs = 3;
+        checks.back().reposts = 2;
+        checks.back().params["bounce_pool_size"] = "16";
+        checks.push_back(default_check("unaligned_small"));
+        checks.back().size = 100;
+        checks.back().file_offset = 1000;
+        checks.back().file_gap = 50;
+        checks.back().descs = 8;
+        checks.back().reposts = 2;
+        checks.back().params["bounce_pool_size"] = "16";
+
+        for (const auto& check : checks) {
+            if (!run_feature_check(check, dir_path, use_vram, use_direct)) {
+                checks_failed = true;
+            }
+        }
+        if (!run_file_cache_check(dir_path, use_direct)) {
+            checks_failed = true;
+        }
+    }
+
     std::cout << "\n============================================================" << std::endl;
     std::cout << "                    TEST SUMMARY                             " << std::endl;
     std::cout << "============================================================" << std::endl;
     std::cout << "Total time: " << format_duration(total_time) << std::endl;
     std::cout << "Total data: " << std::fixed << std::setprecision(2) << total_data_gb << " GB" << std::endl;
+    std::cout << "Feature checks: " << (checks_failed ? "FAILED" : "passed") << std::endl;
     std::cout << "============================================================" << std::endl;
-    return 0;
+    return checks_failed ? 1 : 0;
 }
@@ -0,0 +1,315 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <cuda_runtime.h>
+
+#include "cuda_ipc_backend.h"
+
+#define BUF_SIZE (4 * 1024 * 1024)
+#define DESC_CNT 4
+
+static nixlBackendEngine *createEngine(const std::string &name)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = name;
+    init.customParams = &custom_params;
+    init.type         = "CUDA_IPC";
+
+    nixlBackendEngine *ipc = new nixlCudaIpcEngine(&init);
+    assert(!ipc->getInitErr());
+    if (ipc->getInitErr()) {
+        std::cout << "Failed to initialize CUDA IPC engine" << std::endl;
+        exit(1);
+    }
+    return ipc;
+}
+
+static void writeMsg(int fd, const std::string &str)
+{
+    size_t len = str.size();
+    ssize_t bytes = write(fd, &len, sizeof(len));
+    assert(bytes == sizeof(len));
+    bytes = write(fd, str.data(), len);
+    assert(bytes == (ssize_t) len);
+}
+
+static std::string readMsg(int fd)
+{
+    size_t len;
+    ssize_t bytes = read(fd, &len, sizeof(len));
+    assert(bytes == sizeof(len));
+    std::string str(len, '\0');
+    size_t done = 0;
+    while (done < len) {
+        ssize_t ret = read(fd, &str[done], len - done);
+        assert(ret > 0);
+        done += ret;
+    }
+    return str;
+}
+
+static std::string waitNotif(nixlBackendEngine *ipc, const std::string &from)
+{
+    nixl_status_t ret;
+    notif_list_t notifs;
+
+    while (notifs.empty()) {
+        ret = ipc->getNotifs(notifs);
+        assert(ret == NIXL_SUCCESS);
+    }
+    assert(notifs.size() == 1);
+    assert(notifs[0].first == from);
+    return notifs[0].second;
+}
+
+static char *allocBuf()
+{
+    void *buf;
+    cudaError_t err = cudaMalloc(&buf, BUF_SIZE);
+    assert(err == cudaSuccess);
+    err = cudaMemset(buf, 0, BUF_SIZE);
+    assert(err == cudaSuccess);
+    return (char*) buf;
+}
+
+static void fillBuf(char *buf, int mult, int add)
+{
+    char *host = (char*) malloc(BUF_SIZE);
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        host[i] = (char) (i * mult + add);
+    }
+    cudaError_t err = cudaMemcpy(buf, host, BUF_SIZE, cudaMemcpyHostToDevice);
+    assert(err == cudaSuccess);
+    free(host);
+}
+
+static void checkBuf(const char *buf, int mult, int add)
+{
+    char *host = (char*) malloc(BUF_SIZE);
+    cudaError_t err = cudaMemcpy(host, buf, BUF_SIZE, cudaMemcpyDeviceToHost);
+    assert(err == cudaSuccess);
+    for (size_t i = 0; i < BUF_SIZE; i++) {
+        assert(host[i] == (char) (i * mult + add));
+    }
+    free(host);
+}
+
+static void fillDescs(nixl_meta_dlist_t &list, char *base, nixlBackendMD *md)
+{
+    for (int i = 0; i < DESC_CNT; i++) {
+        nixlMetaDesc desc;
+        desc.addr = (uintptr_t) (base + i * (BUF_SIZE / DESC_CNT));
+        desc.len = BUF_SIZE / DESC_CNT;
+        desc.devId = 0;
+        desc.metadataP = md;
+        list.addDesc(desc);
+    }
+}
+
+// Target side: exposes a buffer, checks what Agent1 wrote and fills it for
+// the read back
+static int runTarget(int in_fd, int out_fd)
+{
+    nixlBackendEngine *ipc = createEngine("Agent2");
+    char *buf = allocBuf();
+    nixlBackendMD *md;
+    nixlBlobDesc mem;
+    std::string conn_info, public_data;
+
+    mem.addr = (uintptr_t) buf;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = ipc->registerMem(mem, VRAM_SEG, md);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->getPublicData(md, public_data);
+    assert(ret == NIXL_SUCCESS);
+
+    writeMsg(out_fd, conn_info);
+    writeMsg(out_fd, std::to_string((uintptr_t) buf));
+    writeMsg(out_fd, public_data);
+    ret = ipc->loadRemoteConnInfo("Agent1", readMsg(in_fd));
+    assert(ret == NIXL_SUCCESS);
+
+    std::string msg = waitNotif(ipc, "Agent1");
+    assert(msg == "written");
+    checkBuf(buf, 3, 1);
+    fillBuf(buf, 5, 2);
+    ret = ipc->genNotif("Agent1", "filled");
+    assert(ret == NIXL_SUCCESS);
+
+    msg = waitNotif(ipc, "Agent1");
+    assert(msg == "done");
+    ipc->deregisterMem(md);
+    cudaFree(buf);
+    delete ipc;
+    return 0;
+}
+
+static void doTransfer(nixlBackendEngine *ipc, nixl_xfer_op_t op,
+                       nixl_meta_dlist_t &local, nixl_meta_dlist_t &remote,
+                       const std::string &msg)
+{
+    nixlBackendReqH *handle;
+    nixl_opt_b_args_t opt_args;
+    nixl_status_t ret;
+
+    opt_args.notifMsg = msg;
+    opt_args.hasNotif = !msg.empty();
+
+    ret = ipc->prepXfer(op, local, remote, "Agent2", handle, &opt_args);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->postXfer(op, local, remote, "Agent2", handle, &opt_args);
+    while (ret == NIXL_IN_PROG) {
+        ret = ipc->checkXfer(handle);
+    }
+    assert(ret == NIXL_SUCCESS);
+    ipc->releaseReqH(handle);
+}
+
+static void testLocal()
+{
+    nixlBackendEngine *ipc = createEngine("Agent1");
+    char *src = allocBuf();
+    char *dst = allocBuf();
+    nixlBackendMD *src_md, *dst_md, *dst_local_md;
+    nixlBlobDesc mem;
+    nixlBackendReqH *handle;
+
+    fillBuf(src, 7, 0);
+
+    mem.addr = (uintptr_t) src;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = ipc->registerMem(mem, VRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = ipc->registerMem(mem, VRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->loadLocalMD(dst_md, dst_local_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(VRAM_SEG), dst_list(VRAM_SEG);
+    fillDescs(src_list, src, src_md);
+    fillDescs(dst_list, dst, dst_local_md);
+
+    ret = ipc->prepXfer(NIXL_WRITE, src_list, dst_list, "Agent1", handle);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->postXfer(NIXL_WRITE, src_list, dst_list, "Agent1", handle);
+    while (ret == NIXL_IN_PROG) {
+        ret = ipc->checkXfer(handle);
+    }
+    assert(ret == NIXL_SUCCESS);
+    ipc->releaseReqH(handle);
+    checkBuf(dst, 7, 0);
+
+    ipc->unloadMD(dst_local_md);
+    ipc->deregisterMem(src_md);
+    ipc->deregisterMem(dst_md);
+    cudaFree(src);
+    cudaFree(dst);
+    delete ipc;
+}
+
+static void testRemote()
+{
+    int to_target[2], from_target[2];
+    int rc = pipe(to_target);
+    assert(rc == 0);
+    rc = pipe(from_target);
+    assert(rc == 0);
+
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        close(to_target[1]);
+        close(from_target[0]);
+        _exit(runTarget(to_target[0], from_target[1]));
+    }
+    close(to_target[0]);
+    close(from_target[1]);
+
+    nixlBackendEngine *ipc = createEngine("Agent1");
+    char *buf = allocBuf();
+    nixlBackendMD *local_md, *remote_md;
+    nixlBlobDesc mem;
+    std::string conn_info;
+
+    fillBuf(buf, 3, 1);
+    mem.addr = (uintptr_t) buf;
+    mem.len = BUF_SIZE;
+    mem.devId = 0;
+    nixl_status_t ret = ipc->registerMem(mem, VRAM_SEG, local_md);
+    assert(ret == NIXL_SUCCESS);
+
+    ret = ipc->loadRemoteConnInfo("Agent2", readMsg(from_target[0]));
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->connect("Agent2");
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = std::stoull(readMsg(from_target[0]));
+    mem.metaInfo = readMsg(from_target[0]);
+    ret = ipc->loadRemoteMD(mem, VRAM_SEG, "Agent2", remote_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = ipc->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    writeMsg(to_target[1], conn_info);
+
+    nixl_meta_dlist_t local_list(VRAM_SEG), remote_list(VRAM_SEG);
+    fillDescs(local_list, buf, local_md);
+    fillDescs(remote_list, (char*) mem.addr, remote_md);
+
+    doTransfer(ipc, NIXL_WRITE, local_list, remote_list, "written");
+    std::string msg = waitNotif(ipc, "Agent2");
+    assert(msg == "filled");
+    doTransfer(ipc, NIXL_READ, local_list, remote_list, "");
+    checkBuf(buf, 5, 2);
+    ret = ipc->genNotif("Agent2", "done");
+    assert(ret == NIXL_SUCCESS);
+
+    int status;
+    pid_t waited = waitpid(child, &status, 0);
+    assert(waited == child);
+    assert(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+
+    ipc->unloadMD(remote_md);
+    ipc->deregisterMem(local_md);
+    ipc->disconnect("Agent2");
+    cudaFree(buf);
+    delete ipc;
+}
+
+int main()
+{
+    // Forks before this process initializes CUDA
+    testRemote();
+    testLocal();
+
+    std::cout << "CUDA IPC backend test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include "local_copy_backend.h"
+
+#define DESC_CNT 64
+#define DESC_SIZE (64 * 1024)
+
+static nixlBackendEngine *createEngine(const std::string &copy_threads)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    // Small chunks, so a transfer is spread over the threads
+    custom_params["copy_threads"] = copy_threads;
+    custom_params["chunk_size"] = "65536";
+    custom_params["thread_min_size"] = "131072";
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = "Agent1";
+    init.customParams = &custom_params;
+    init.type         = "LOCAL_COPY";
+
+    nixlBackendEngine *copy = new nixlLocalCopyEngine(&init);
+    assert(!copy->getInitErr());
+    if (copy->getInitErr()) {
+        std::cout << "Failed to initialize local copy engine" << std::endl;
+        exit(1);
+    }
+    return copy;
+}
+
+static void doTransfer(nixlBackendEngine *copy, nixl_xfer_op_t op,
+                       nixl_meta_dlist_t &local, nixl_meta_dlist_t &remote)
+{
+    nixlBackendReqH *handle;
+    nixl_status_t ret;
+
+    ret = copy->prepXfer(op, local, remote, "Agent1", handle);
+    assert(ret == NIXL_SUCCESS);
+
+    // Posted twice to check the handle can be reused
+    for (int i = 0; i < 2; i++) {
+        ret = copy->postXfer(op, local, remote, "Agent1", handle);
+        assert((ret == NIXL_SUCCESS) || (ret == NIXL_IN_PROG));
+        while (ret == NIXL_IN_PROG) {
+            ret = copy->checkXfer(handle);
+        }
+        assert(ret == NIXL_SUCCESS);
+    }
+
+    copy->releaseReqH(handle);
+}
+
+static void fillDescs(nixl_meta_dlist_t &list, char *base, nixlBackendMD *md,
+                      int cnt, bool reverse)
+{
+    for (int i = 0; i < cnt; i++) {
+        nixlMetaDesc desc;
+        int idx = reverse ? (cnt - 1 - i) : i;
+
+        desc.addr = (uintptr_t) (base + idx * DESC_SIZE);
+        desc.len = DESC_SIZE;
+        desc.devId = 0;
+        desc.metadataP = md;
+        list.addDesc(desc);
+    }
+}
+
+static void testDramCopy(const std::string &copy_threads, int cnt, bool reverse)
+{
+    nixlBackendEngine *copy = createEngine(copy_threads);
+    size_t len = DESC_CNT * DESC_SIZE;
+    char *src = (char*) malloc(len);
+    char *dst = (char*) malloc(len);
+    char *back = (char*) malloc(len);
+    nixlBackendMD *src_md, *dst_md, *back_md, *dst_local_md;
+    nixlBlobDesc mem;
+
+    for (size_t i = 0; i < len; i++) {
+        src[i] = (char) (i * 7 + 1);
+    }
+    memset(dst, 0, len);
+    memset(back, 0, len);
+
+    mem.devId = 0;
+    mem.len = len;
+    mem.addr = (uintptr_t) src;
+    nixl_status_t ret = copy->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = copy->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) back;
+    ret = copy->registerMem(mem, DRAM_SEG, back_md);
+    assert(ret == NIXL_SUCCESS);
+    ret = copy->loadLocalMD(dst_md, dst_local_md);
+    assert(ret == NIXL_SUCCESS);
+
+    // Consecutive descriptors are merged, reversed ones are not
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG), back_list(DRAM_SEG);
+    fillDescs(src_list, src, src_md, cnt, false);
+    fillDescs(dst_list, dst, dst_local_md, cnt, reverse);
+    fillDescs(back_list, back, back_md, cnt, false);
+
+    doTransfer(copy, NIXL_WRITE, src_list, dst_list);
+    doTransfer(copy, NIXL_READ, back_list, dst_list);
+    assert(memcmp(src, back, cnt * DESC_SIZE) == 0);
+    if (reverse) {
+        assert(memcmp(dst, src + (cnt - 1) * DESC_SIZE, DESC_SIZE) == 0);
+    } else {
+        assert(memcmp(dst, src, cnt * DESC_SIZE) == 0);
+    }
+
+    copy->unloadMD(dst_local_md);
+    copy->deregisterMem(src_md);
+    copy->deregisterMem(dst_md);
+    copy->deregisterMem(back_md);
+    free(src);
+    free(dst);
+    free(back);
+    delete copy;
+}
+
+int main()
+{
+    testDramCopy("4", DESC_CNT, false);
+    testDramCopy("4", DESC_CNT, true);
+    // Below thread_min_size, copied within postXfer
+    testDramCopy("4", 1, false);
+    // No threads
+    testDramCopy("0", DESC_CNT, true);
+
+    std::cout << "Local copy backend test passed" << std::endl;
+    return 0;
+}
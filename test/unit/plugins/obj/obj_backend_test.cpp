@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "obj_backend.h"
+
+#define PART_SIZE (64 * 1024)
+#define UPLOAD_PART_SIZE (5 * 1024 * 1024)
+#define OBJ_CNT 4
+#define OBJ_SIZE (2 * UPLOAD_PART_SIZE + 123)
+
+static nixlBackendEngine *createEngine(const std::string &endpoint,
+                                       const std::string &bucket)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    // Small parts, so reads are split, and the smallest S3 takes for uploads.
+    // Credentials come from the AWS environment variables.
+    custom_params["endpoint"] = endpoint;
+    custom_params["bucket"] = bucket;
+    custom_params["part_size"] = std::to_string(PART_SIZE);
+    custom_params["upload_part_size"] = std::to_string(UPLOAD_PART_SIZE);
+    custom_params["parallelism"] = "4";
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = "Agent1";
+    init.customParams = &custom_params;
+    init.type         = "OBJ";
+
+    nixlBackendEngine *obj = new nixlObjEngine(&init);
+    assert(!obj->getInitErr());
+    if (obj->getInitErr()) {
+        std::cout << "Failed to initialize OBJ engine" << std::endl;
+        exit(1);
+    }
+    return obj;
+}
+
+static nixl_status_t doTransfer(nixlBackendEngine *obj, nixl_xfer_op_t op,
+                                nixl_meta_dlist_t &bufs, nixl_meta_dlist_t &objs)
+{
+    nixlBackendReqH *handle;
+    nixl_status_t ret;
+
+    ret = obj->prepXfer(op, bufs, objs, "Agent1", handle);
+    if (ret != NIXL_SUCCESS) {
+        return ret;
+    }
+
+    ret = obj->postXfer(op, bufs, objs, "Agent1", handle);
+    while (ret == NIXL_IN_PROG) {
+        ret = obj->checkXfer(handle);
+    }
+
+    obj->releaseReqH(handle);
+    return ret;
+}
+
+static void testObjRoundTrip(const std::string &endpoint, const std::string &bucket)
+{
+    nixlBackendEngine *obj = createEngine(endpoint, bucket);
+    std::string prefix = "nixl_obj_test_" + std::to_string(getpid()) + "_";
+
+    size_t len = OBJ_CNT * OBJ_SIZE;
+    char *src = (char*) malloc(len);
+    char *dst = (char*) malloc(len);
+    for (size_t i = 0; i < len; i++) {
+        src[i] = (char) (i * 7 + 1);
+    }
+    memset(dst, 0, len);
+
+    nixlBackendMD *src_md, *dst_md, *obj_md[OBJ_CNT];
+    nixlBlobDesc mem;
+
+    mem.addr = (uintptr_t) src;
+    mem.len = len;
+    mem.devId = 0;
+    nixl_status_t ret = obj->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = obj->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG), obj_list(OBJ_SEG);
+    for (int i = 0; i < OBJ_CNT; i++) {
+        nixlMetaDesc desc;
+
+        // Objects 0 and 2 fit in one part, 1 and 3 are multipart uploads
+        size_t size = (i % 2) ? OBJ_SIZE : PART_SIZE / 2;
+
+        mem.addr = 0;
+        mem.len = 0;
+        mem.devId = i;
+        mem.metaInfo = prefix + std::to_string(i);
+        if (i == 3) {
+            mem.metaInfo = "s3://" + bucket + "/" + prefix + "dir/" + std::to_string(i);
+        }
+        ret = obj->registerMem(mem, OBJ_SEG, obj_md[i]);
+        assert(ret == NIXL_SUCCESS);
+
+        desc.addr = (uintptr_t) (src + i * OBJ_SIZE);
+        desc.len = size;
+        desc.devId = 0;
+        desc.metadataP = src_md;
+        src_list.addDesc(desc);
+
+        desc.addr = 0;
+        desc.devId = i;
+        desc.metadataP = obj_md[i];
+        obj_list.addDesc(desc);
+    }
+
+    ret = doTransfer(obj, NIXL_WRITE, src_list, obj_list);
+    assert(ret == NIXL_SUCCESS);
+
+    // Read in pieces at an offset, spread over parts
+    for (int i = 0; i < OBJ_CNT; i++) {
+        nixlMetaDesc desc;
+        size_t size = (i % 2) ? OBJ_SIZE : PART_SIZE / 2;
+
+        desc.addr = (uintptr_t) (dst + i * OBJ_SIZE + 100);
+        desc.len = size - 100;
+        desc.devId = 0;
+        desc.metadataP = dst_md;
+        dst_list.addDesc(desc);
+    }
+    for (int i = 0; i < OBJ_CNT; i++) {
+        obj_list[i].addr = 100;
+        obj_list[i].len = dst_list[i].len;
+    }
+    ret = doTransfer(obj, NIXL_READ, dst_list, obj_list);
+    assert(ret == NIXL_SUCCESS);
+    for (int i = 0; i < OBJ_CNT; i++) {
+        assert(memcmp(src + i * OBJ_SIZE + 100, dst + i * OBJ_SIZE + 100,
+                      dst_list[i].len) == 0);
+    }
+
+    // Writes replace whole objects, and reads stop at the object end
+    ret = doTransfer(obj, NIXL_WRITE, dst_list, obj_list);
+    assert(ret == NIXL_ERR_NOT_SUPPORTED);
+    dst_list[0].len = PART_SIZE;
+    obj_list[0].len = PART_SIZE;
+    ret = doTransfer(obj, NIXL_READ, dst_list, obj_list);
+    assert(ret == NIXL_ERR_BACKEND);
+
+    // More parts than S3 takes, rejected before anything is sent
+    nixl_meta_dlist_t huge_src(DRAM_SEG), huge_obj(OBJ_SEG);
+    huge_src.addDesc(src_list[1]);
+    huge_obj.addDesc(obj_list[1]);
+    huge_src[0].len = (size_t) UPLOAD_PART_SIZE * 10000 + 1;
+    huge_obj[0].addr = 0;
+    huge_obj[0].len = huge_src[0].len;
+    nixlBackendReqH *handle;
+    ret = obj->prepXfer(NIXL_WRITE, huge_src, huge_obj, "Agent1", handle);
+    assert(ret == NIXL_ERR_INVALID_PARAM);
+
+    obj->deregisterMem(src_md);
+    obj->deregisterMem(dst_md);
+    for (int i = 0; i < OBJ_CNT; i++) {
+        obj->deregisterMem(obj_md[i]);
+    }
+    free(src);
+    free(dst);
+    delete obj;
+}
+
+// Upload parts below the S3 minimum are refused at init
+static void testUploadPartSize()
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    custom_params["endpoint"] = "http://127.0.0.1";
+    custom_params["upload_part_size"] = std::to_string(PART_SIZE);
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = "Agent1";
+    init.customParams = &custom_params;
+    init.type         = "OBJ";
+
+    nixlObjEngine obj(&init);
+    assert(obj.getInitErr());
+}
+
+// Query values are encoded the same way in the URL and the signature
+static void testQueryEncoding()
+{
+    nixlObjS3Request req;
+
+    req.params["uploadId"] = "a/b+c=d&e f";
+    req.params["partNumber"] = "3";
+    assert(nixlObjS3Client::canonicalQuery(&req) ==
+           "partNumber=3&uploadId=a%2Fb%2Bc%3Dd%26e%20f");
+
+    req.params.clear();
+    req.params["uploads"] = "";
+    assert(nixlObjS3Client::canonicalQuery(&req) == "uploads=");
+}
+
+int main(int argc, char *argv[])
+{
+    testQueryEncoding();
+    testUploadPartSize();
+
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <endpoint> <bucket>" << std::endl;
+        std::cout << "Objects are left in the bucket with a nixl_obj_test_ prefix"
+                  << std::endl;
+        return 1;
+    }
+
+    testObjRoundTrip(argv[1], argv[2]);
+
+    std::cout << "OBJ backend test passed" << std::endl;
+    return 0;
+}
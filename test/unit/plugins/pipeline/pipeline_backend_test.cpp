@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <cuda_runtime.h>
+
+#include "pipeline_backend.h"
+#include "plugin_manager.h"
+
+// Small chunks and a ring of two slots, so the slots are reused
+#define CHUNK_SIZE (64 * 1024)
+#define DESC_SIZE (5 * CHUNK_SIZE + 123)
+#define DESC_CNT 2
+
+// Two agents of this process, over CMA as the inner backend
+static nixlBackendEngine *createEngine(const std::string &name)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    custom_params["backend"]    = "CMA";
+    custom_params["chunk_size"] = std::to_string(CHUNK_SIZE);
+    custom_params["chunks"]     = "2";
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = name;
+    init.customParams = &custom_params;
+    init.type         = "PIPELINE";
+    init.factory      = nixlPluginManager::getInstance().getEngineFactory();
+
+    nixlBackendEngine *pipe = new nixlPipelineEngine(&init);
+    assert(!pipe->getInitErr());
+    if (pipe->getInitErr()) {
+        std::cout << "Failed to initialize PIPELINE engine" << std::endl;
+        exit(1);
+    }
+    return pipe;
+}
+
+static std::string waitNotif(nixlBackendEngine *pipe, const std::string &from)
+{
+    nixl_status_t ret;
+    notif_list_t notifs;
+
+    while (notifs.empty()) {
+        ret = pipe->getNotifs(notifs);
+        assert(ret == NIXL_SUCCESS);
+    }
+    assert(notifs.size() == 1);
+    assert(notifs[0].first == from);
+    return notifs[0].second;
+}
+
+class testBuffer {
+    public:
+        nixl_mem_t mem;
+        char *addr;
+        nixlBackendMD *md;
+        nixlBackendMD *remoteMD;
+
+        testBuffer(nixlBackendEngine *owner, nixlBackendEngine *peer,
+                   const std::string &owner_name, nixl_mem_t nixl_mem) {
+            size_t len = DESC_CNT * DESC_SIZE;
+            nixlBlobDesc desc;
+            std::string blob;
+            nixl_status_t ret;
+            cudaError_t err;
+
+            mem = nixl_mem;
+            if (mem == VRAM_SEG) {
+                err = cudaMalloc((void**) &addr, len);
+                assert(err == cudaSuccess);
+                err = cudaMemset(addr, 0, len);
+                assert(err == cudaSuccess);
+            } else {
+                addr = (char*) calloc(1, len);
+            }
+            desc.addr = (uintptr_t) addr;
+            desc.len = len;
+            desc.devId = 0;
+            ret = owner->registerMem(desc, mem, md);
+            assert(ret == NIXL_SUCCESS);
+            ret = owner->getPublicData(md, blob);
+            assert(ret == NIXL_SUCCESS);
+            desc.metaInfo = blob;
+            ret = peer->loadRemoteMD(desc, mem, owner_name, remoteMD);
+            assert(ret == NIXL_SUCCESS);
+        }
+
+        void fill(char seed) {
+            std::string data(DESC_CNT * DESC_SIZE, 0);
+
+            for (size_t i = 0; i < data.size(); i++) {
+                data[i] = (char) (seed + i * 7);
+            }
+            copyIn(data);
+        }
+
+        void copyIn(const std::string &data) {
+            if (mem == VRAM_SEG) {
+                cudaError_t err = cudaMemcpy(addr, data.data(), data.size(),
+                                             cudaMemcpyHostToDevice);
+                assert(err == cudaSuccess);
+            } else {
+                memcpy(addr, data.data(), data.size());
+            }
+        }
+
+        std::string copyOut() {
+            std::string data(DESC_CNT * DESC_SIZE, 0);
+
+            if (mem == VRAM_SEG) {
+                cudaError_t err = cudaMemcpy(&data[0], addr, data.size(),
+                                             cudaMemcpyDeviceToHost);
+                assert(err == cudaSuccess);
+            } else {
+                memcpy(&data[0], addr, data.size());
+            }
+            return data;
+        }
+
+        void fillList(nixl_meta_dlist_t &descs, bool remote) {
+            for (int i = 0; i < DESC_CNT; i++) {
+                nixlMetaDesc desc;
+
+                desc.addr = (uintptr_t) (addr + i * DESC_SIZE);
+                desc.len = DESC_SIZE;
+                desc.devId = 0;
+                desc.metadataP = remote ? remoteMD : md;
+                descs.addDesc(desc);
+            }
+        }
+};
+
+// The receiver only copies into VRAM while its engine is progressed
+static void doWrite(nixlBackendEngine *sender, nixlBackendEngine *receiver,
+                    testBuffer &src, testBuffer &dst, const std::string &msg,
+                    nixl_b_params_t &stats)
+{
+    nixl_meta_dlist_t local(src.mem), remote(dst.mem);
+    nixlBackendReqH *handle;
+    nixl_opt_b_args_t opt_args;
+    nixl_status_t ret;
+
+    src.fillList(local, false);
+    dst.fillList(remote, true);
+    opt_args.notifMsg = msg;
+    opt_args.hasNotif = !msg.empty();
+
+    ret = sender->prepXfer(NIXL_WRITE, local, remote, "Agent2", handle, &opt_args);
+    assert(ret == NIXL_SUCCESS);
+    ret = sender->postXfer(NIXL_WRITE, local, remote, "Agent2", handle, &opt_args);
+    while (ret == NIXL_IN_PROG) {
+        receiver->progress();
+        ret = sender->checkXfer(handle);
+    }
+    assert(ret == NIXL_SUCCESS);
+    ret = sender->getXferStats(handle, stats);
+    assert(ret == NIXL_SUCCESS);
+    sender->releaseReqH(handle);
+}
+
+int main()
+{
+    nixlBackendEngine *sender = createEngine("Agent1");
+    nixlBackendEngine *receiver = createEngine("Agent2");
+    std::string conn_info;
+
+    nixl_status_t ret = sender->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = receiver->loadRemoteConnInfo("Agent1", conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = receiver->getConnInfo(conn_info);
+    assert(ret == NIXL_SUCCESS);
+    ret = sender->loadRemoteConnInfo("Agent2", conn_info);
+    assert(ret == NIXL_SUCCESS);
+
+    testBuffer src_vram(sender, receiver, "Agent1", VRAM_SEG);
+    testBuffer src_dram(sender, receiver, "Agent1", DRAM_SEG);
+    testBuffer dst_vram(receiver, sender, "Agent2", VRAM_SEG);
+    testBuffer dst_dram(receiver, sender, "Agent2", DRAM_SEG);
+    nixl_b_params_t stats;
+
+    // VRAM to VRAM, through both rings, and the message comes once all
+    // chunks are in place
+    src_vram.fill(1);
+    doWrite(sender, receiver, src_vram, dst_vram, "written", stats);
+    std::string msg = waitNotif(receiver, "Agent1");
+    assert(msg == "written");
+    assert(dst_vram.copyOut() == src_vram.copyOut());
+    assert(stats["pipelined"] == "1");
+    assert(stats["via_receiver"] == "1");
+    assert(stats["chunks"] == std::to_string(DESC_CNT * 6));
+
+    // VRAM to DRAM, written directly from the staging ring
+    doWrite(sender, receiver, src_vram, dst_dram, "direct", stats);
+    msg = waitNotif(receiver, "Agent1");
+    assert(msg == "direct");
+    assert(dst_dram.copyOut() == src_vram.copyOut());
+    assert(stats["pipelined"] == "1");
+    assert(stats["via_receiver"] == "0");
+
+    // DRAM to VRAM, without a message
+    src_dram.fill(2);
+    doWrite(sender, receiver, src_dram, dst_vram, "", stats);
+    assert(dst_vram.copyOut() == src_dram.copyOut());
+    assert(stats["via_receiver"] == "1");
+
+    // DRAM to DRAM goes through the inner engine as it is
+    doWrite(sender, receiver, src_dram, dst_dram, "plain write", stats);
+    msg = waitNotif(receiver, "Agent1");
+    assert(msg == "plain write");
+    assert(dst_dram.copyOut() == src_dram.copyOut());
+    assert(stats["pipelined"] == "0");
+
+    // Standalone notifications go through as they are
+    ret = sender->genNotif("Agent2", "plain");
+    assert(ret == NIXL_SUCCESS);
+    msg = waitNotif(receiver, "Agent1");
+    assert(msg == "plain");
+
+    for (testBuffer *buf : {&src_vram, &src_dram}) {
+        receiver->unloadMD(buf->remoteMD);
+        sender->deregisterMem(buf->md);
+    }
+    for (testBuffer *buf : {&dst_vram, &dst_dram}) {
+        sender->unloadMD(buf->remoteMD);
+        receiver->deregisterMem(buf->md);
+    }
+    cudaFree(src_vram.addr);
+    cudaFree(dst_vram.addr);
+    free(src_dram.addr);
+    free(dst_dram.addr);
+    delete sender;
+    delete receiver;
+
+    std::cout << "PIPELINE backend test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "posix_backend.h"
+
+#define DESC_CNT 8
+#define DESC_SIZE (1024 * 1024)
+
+static nixlBackendEngine *createEngine(const std::string &fixed_slots)
+{
+    nixlBackendInitParams init;
+    nixl_b_params_t       custom_params;
+
+    // Small requests and ring, so IOs are split and queued
+    custom_params["max_request_size"] = "65536";
+    custom_params["ring_size"] = "16";
+    custom_params["fixed_slots"] = fixed_slots;
+    init.enableProgTh = false;
+    init.pthrDelay    = 0;
+    init.localAgent   = "Agent1";
+    init.customParams = &custom_params;
+    init.type         = "POSIX";
+
+    nixlBackendEngine *posix = new nixlPosixEngine(&init);
+    assert(!posix->getInitErr());
+    if (posix->getInitErr()) {
+        std::cout << "Failed to initialize POSIX engine" << std::endl;
+        exit(1);
+    }
+    return posix;
+}
+
+static void doTransfer(nixlBackendEngine *posix, nixl_xfer_op_t op,
+                       nixl_meta_dlist_t &bufs, nixl_meta_dlist_t &files)
+{
+    nixlBackendReqH *handle;
+    nixl_status_t ret;
+
+    ret = posix->prepXfer(op, bufs, files, "Agent1", handle);
+    assert(ret == NIXL_SUCCESS);
+
+    // Posted twice to check the handle can be reused
+    for (int i = 0; i < 2; i++) {
+        ret = posix->postXfer(op, bufs, files, "Agent1", handle);
+        assert((ret == NIXL_SUCCESS) || (ret == NIXL_IN_PROG));
+        while (ret == NIXL_IN_PROG) {
+            ret = posix->checkXfer(handle);
+        }
+        assert(ret == NIXL_SUCCESS);
+    }
+
+    posix->releaseReqH(handle);
+}
+
+static void testFileRoundTrip(const std::string &fixed_slots)
+{
+    nixlBackendEngine *posix = createEngine(fixed_slots);
+    char path[] = "/tmp/nixl_posix_testXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    unlink(path);
+
+    size_t len = DESC_CNT * DESC_SIZE;
+    char *src = (char*) malloc(len);
+    char *dst = (char*) malloc(len);
+    for (size_t i = 0; i < len; i++) {
+        src[i] = (char) (i * 7 + 1);
+    }
+    memset(dst, 0, len);
+
+    nixlBackendMD *src_md, *dst_md, *file_md;
+    nixlBlobDesc mem;
+
+    mem.addr = (uintptr_t) src;
+    mem.len = len;
+    mem.devId = 0;
+    nixl_status_t ret = posix->registerMem(mem, DRAM_SEG, src_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = (uintptr_t) dst;
+    ret = posix->registerMem(mem, DRAM_SEG, dst_md);
+    assert(ret == NIXL_SUCCESS);
+    mem.addr = 0;
+    mem.devId = fd;
+    ret = posix->registerMem(mem, FILE_SEG, file_md);
+    assert(ret == NIXL_SUCCESS);
+
+    nixl_meta_dlist_t src_list(DRAM_SEG), dst_list(DRAM_SEG), file_list(FILE_SEG);
+    for (int i = 0; i < DESC_CNT; i++) {
+        nixlMetaDesc desc;
+
+        // Buffer chunks land on the file in reverse order
+        desc.addr = (uintptr_t) (src + i * DESC_SIZE);
+        desc.len = DESC_SIZE;
+        desc.devId = 0;
+        desc.metadataP = src_md;
+        src_list.addDesc(desc);
+
+        desc.addr = (uintptr_t) (dst + i * DESC_SIZE);
+        desc.metadataP = dst_md;
+        dst_list.addDesc(desc);
+
+        desc.addr = (DESC_CNT - 1 - i) * DESC_SIZE;
+        desc.devId = fd;
+        desc.metadataP = file_md;
+        file_list.addDesc(desc);
+    }
+
+    doTransfer(posix, NIXL_WRITE, src_list, file_list);
+    doTransfer(posix, NIXL_READ, dst_list, file_list);
+    assert(memcmp(src, dst, len) == 0);
+
+    // The file holds the chunks in reverse order
+    char check[16];
+    ssize_t bytes = pread(fd, check, sizeof(check), (DESC_CNT - 1) * DESC_SIZE);
+    assert(bytes == sizeof(check));
+    assert(memcmp(check, src, sizeof(check)) == 0);
+
+    posix->deregisterMem(src_md);
+    posix->deregisterMem(dst_md);
+    posix->deregisterMem(file_md);
+    close(fd);
+    free(src);
+    free(dst);
+    delete posix;
+}
+
+int main()
+{
+    testFileRoundTrip("1024");
+    // Plain fds and buffers
+    testFileRoundTrip("0");
+
+    std::cout << "POSIX backend test passed" << std::endl;
+    return 0;
+}
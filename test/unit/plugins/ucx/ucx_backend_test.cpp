@@ -18,8 +18,14 @@
 #include <sstream>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
 
 #include "ucx_backend.h"
+#include "serdes/serdes.h"
 
 using namespace std;
 
@@ -107,11 +113,13 @@ public:
 };
 
 
-nixlBackendEngine *createEngine(std::string name, bool p_thread)
+// Engine parameters not in params keep their defaults
+nixlBackendEngine *createEngine(std::string name, bool p_thread,
+                                const nixl_b_params_t &params = nixl_b_params_t())
 {
     nixlBackendEngine     *ucx;
     nixlBackendInitParams init;
-    nixl_b_params_t       custom_params;
+    nixl_b_params_t       custom_params = params;
 
     init.enableProgTh = p_thread;
     init.pthrDelay    = 100;
@@ -291,7 +299,8 @@ void allocateWrongGPUTest(nixlBackendEngine* ucx, int dev_id)
 
     allocateBuffer(VRAM_SEG, dev_id, desc.len, buf);
 
-    desc.devId = dev_id;
+    // Device id not matching the one of the address
+    desc.devId = dev_id - 1;
     desc.addr = (uint64_t) buf;
 
     int ret = ucx->registerMem(desc, VRAM_SEG, md);
@@ -301,6 +310,26 @@ void allocateWrongGPUTest(nixlBackendEngine* ucx, int dev_id)
     releaseBuffer(VRAM_SEG, dev_id, buf);
 }
 
+void allocateOtherGPUTest(nixlBackendEngine* ucx, int dev_id)
+{
+    nixlBlobDesc desc;
+    nixlBackendMD* md;
+    void* buf;
+
+    allocateBuffer(VRAM_SEG, dev_id, desc.len, buf);
+
+    // Another device than the first registered one, no thread restart
+    desc.devId = dev_id;
+    desc.addr = (uint64_t) buf;
+
+    int ret = ucx->registerMem(desc, VRAM_SEG, md);
+
+    assert(ret == NIXL_SUCCESS);
+
+    ucx->deregisterMem(md);
+    releaseBuffer(VRAM_SEG, dev_id, buf);
+}
+
 void allocateAndRegister(nixlBackendEngine *ucx, int dev_id, nixl_mem_t mem_type,
                          void* &addr, size_t len, nixlBackendMD* &md)
 {
@@ -671,11 +700,626 @@ void test_inter_agent_transfer(bool p_thread, bool reuse_hndl,
     //ucx2->disconnect(agent1);
 }
 
+void test_coalesced_notifs(bool p_thread, nixlBackendEngine *ucx1, nixlBackendEngine *ucx2)
+{
+    int count = 100;
+    nixl_status_t ret;
+
+    std::cout << std::endl << "Coalesced genNotif test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    std::string agent2("Agent2");
+    std::string conn_info2;
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    for (int k = 0; k < count; k++) {
+        ret = ucx1->genNotif(agent2, "notif" + std::to_string(k));
+        assert(ret == NIXL_SUCCESS);
+    }
+
+    // Packed messages arrive in the order they were generated
+    notif_list_t target_notifs;
+    while ((int) target_notifs.size() < count) {
+        notif_list_t notifs;
+        if (!p_thread) {
+            ucx1->progress();
+        }
+        ret = ucx2->getNotifs(notifs);
+        assert(ret == NIXL_SUCCESS);
+        move(notifs.begin(), notifs.end(), back_inserter(target_notifs));
+    }
+
+    assert((int) target_notifs.size() == count);
+    for (int k = 0; k < count; k++) {
+        assert(target_notifs[k].first == "Agent1");
+        assert(target_notifs[k].second == "notif" + std::to_string(k));
+    }
+    std::cout << "	" << count << " notifications OK" << std::endl;
+
+    ucx1->disconnect(agent2);
+}
+
+// Posts a prepared transfer and waits for it to complete
+void waitXfer(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2, nixl_xfer_op_t op,
+              nixl_meta_dlist_t &req_src_descs, nixl_meta_dlist_t &req_dst_descs,
+              const std::string &remote_agent, nixlBackendReqH *&handle,
+              bool progress, const nixl_opt_b_args_t *opt_args = nullptr)
+{
+    nixl_status_t ret;
+
+    ret = ucx1->postXfer(op, req_src_descs, req_dst_descs, remote_agent, handle, opt_args);
+    while (ret == NIXL_IN_PROG) {
+        ret = ucx1->checkXfer(handle);
+        if (progress) {
+            ucx2->progress();
+        }
+    }
+    assert(ret == NIXL_SUCCESS);
+}
+
+void verifyData(void *addr1, void *addr2, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        assert(((uint8_t*) addr1)[i] == ((uint8_t*) addr2)[i]);
+    }
+}
+
+// Submitting threads post through workers of their own, the peer gets one
+// endpoint from each of them
+void test_worker_pool(bool p_thread)
+{
+    const size_t num_workers = 4;
+    nixl_status_t ret;
+
+    std::cout << std::endl << "Worker pool test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    nixlBackendEngine *ucx1 = createEngine("Agent1", p_thread,
+                                           {{"num_workers", std::to_string(num_workers)}});
+    nixlBackendEngine *ucx2 = createEngine("Agent2", p_thread, {{"num_workers", "2"}});
+    std::string agent2("Agent2");
+
+    // The connection info carries the address of every worker
+    std::string conn_info1, conn_info2;
+    nixlSerDes ser_des;
+    ret = ucx1->getConnInfo(conn_info1);
+    assert(ret == NIXL_SUCCESS);
+    assert(ser_des.importStr(conn_info1) == NIXL_SUCCESS);
+    assert(ser_des.getStr("num_workers") == std::to_string(num_workers));
+    for (size_t w = 0; w < num_workers; w++) {
+        assert(ser_des.getBufLen("w" + std::to_string(w)) > 0);
+    }
+
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    size_t chunk = 1024 * 1024;
+    size_t len = chunk * num_workers;
+    void *addr1, *addr2;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+    allocateAndRegister(ucx1, 0, DRAM_SEG, addr1, len, lmd1);
+    allocateAndRegister(ucx2, 0, DRAM_SEG, addr2, len, lmd2);
+    loadRemote(ucx1, 0, agent2, DRAM_SEG, addr2, len, lmd2, rmd1);
+
+    // The remote rkey is unpacked on the endpoint of each local worker
+    assert(((nixlUcxPublicMetadata*) rmd1)->rkeys.size() == num_workers);
+
+    doMemset(DRAM_SEG, 0, addr1, 0xbb, len);
+    doMemset(DRAM_SEG, 0, addr2, 0, len);
+
+    // Threads are numbered on their first post, so the ones started
+    // together here cover all the workers
+    std::vector<size_t> workers(num_workers);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_workers; t++) {
+        threads.emplace_back([&, t]() {
+            nixl_meta_dlist_t src_descs(DRAM_SEG);
+            nixl_meta_dlist_t dst_descs(DRAM_SEG);
+            nixlBackendReqH *handle;
+            nixl_b_params_t stats;
+
+            populateDescs(src_descs, 0, (char*) addr1 + t * chunk, 1, chunk, lmd1);
+            populateDescs(dst_descs, 0, (char*) addr2 + t * chunk, 1, chunk, rmd1);
+
+            nixl_status_t ret = ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs,
+                                               agent2, handle);
+            assert(ret == NIXL_SUCCESS);
+            waitXfer(ucx1, ucx2, NIXL_WRITE, src_descs, dst_descs, agent2, handle,
+                     !p_thread);
+            ret = ucx1->getXferStats(handle, stats);
+            assert(ret == NIXL_SUCCESS);
+            workers[t] = std::stoul(stats["worker"]);
+            ucx1->releaseReqH(handle);
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::sort(workers.begin(), workers.end());
+    for (size_t w = 0; w < num_workers; w++) {
+        assert(workers[w] == w);
+    }
+    verifyData(addr1, addr2, len);
+    std::cout << "\t" << num_workers << " threads on " << num_workers << " workers OK" << std::endl;
+
+    ucx1->unloadMD(rmd1);
+    deallocateAndDeregister(ucx1, 0, DRAM_SEG, addr1, lmd1);
+    deallocateAndDeregister(ucx2, 0, DRAM_SEG, addr2, lmd2);
+    ucx1->disconnect(agent2);
+
+    releaseEngine(ucx1);
+    releaseEngine(ucx2);
+}
+
+// Agent1 and Agent2 engines with a DRAM buffer each, the one of Agent2
+// loaded by Agent1
+struct testPeers {
+    bool p_thread;
+    nixlBackendEngine *ucx1, *ucx2;
+    void *addr1, *addr2;
+    size_t len;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+};
+
+void setupPeers(testPeers &peers, bool p_thread, const nixl_b_params_t &params, size_t len)
+{
+    std::string conn_info2;
+    nixl_status_t ret;
+
+    peers.p_thread = p_thread;
+    peers.ucx1 = createEngine("Agent1", p_thread, params);
+    peers.ucx2 = createEngine("Agent2", p_thread, params);
+    peers.len = len;
+
+    ret = peers.ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = peers.ucx1->loadRemoteConnInfo("Agent2", conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    allocateAndRegister(peers.ucx1, 0, DRAM_SEG, peers.addr1, len, peers.lmd1);
+    allocateAndRegister(peers.ucx2, 0, DRAM_SEG, peers.addr2, len, peers.lmd2);
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, peers.addr2, len, peers.lmd2, peers.rmd1);
+}
+
+void teardownPeers(testPeers &peers)
+{
+    peers.ucx1->unloadMD(peers.rmd1);
+    deallocateAndDeregister(peers.ucx1, 0, DRAM_SEG, peers.addr1, peers.lmd1);
+    deallocateAndDeregister(peers.ucx2, 0, DRAM_SEG, peers.addr2, peers.lmd2);
+    peers.ucx1->disconnect("Agent2");
+
+    releaseEngine(peers.ucx1);
+    releaseEngine(peers.ucx2);
+}
+
+// Transfers desc_cnt descriptors of desc_size over the buffers of the peers,
+// checks the data once reported complete and returns the stats of the post
+nixl_b_params_t peersXfer(testPeers &peers, nixl_xfer_op_t op, int desc_cnt,
+                          size_t desc_size, bool use_notif = false)
+{
+    nixl_meta_dlist_t src_descs(DRAM_SEG);
+    nixl_meta_dlist_t dst_descs(DRAM_SEG);
+    nixlBackendReqH *handle;
+    nixl_opt_b_args_t opt_args;
+    nixl_b_params_t stats;
+    size_t len = desc_cnt * desc_size;
+    nixl_status_t ret;
+
+    assert(len <= peers.len);
+    opt_args.notifMsg = "peers";
+    opt_args.hasNotif = use_notif;
+
+    populateDescs(src_descs, 0, peers.addr1, desc_cnt, desc_size, peers.lmd1);
+    populateDescs(dst_descs, 0, peers.addr2, desc_cnt, desc_size, peers.rmd1);
+
+    // Initiator data is the source of a write and the target of a read
+    doMemset(DRAM_SEG, 0, peers.addr1, (op == NIXL_WRITE) ? 0xbb : 0, len);
+    doMemset(DRAM_SEG, 0, peers.addr2, (op == NIXL_WRITE) ? 0 : 0xda, len);
+
+    ret = peers.ucx1->prepXfer(op, src_descs, dst_descs, "Agent2", handle, &opt_args);
+    assert(ret == NIXL_SUCCESS);
+    waitXfer(peers.ucx1, peers.ucx2, op, src_descs, dst_descs, "Agent2", handle,
+             !peers.p_thread, &opt_args);
+    verifyData(peers.addr1, peers.addr2, len);
+
+    if (use_notif) {
+        notif_list_t notifs;
+        while (notifs.empty()) {
+            if (!peers.p_thread) {
+                peers.ucx1->progress();
+            }
+            ret = peers.ucx2->getNotifs(notifs);
+            assert(ret == NIXL_SUCCESS);
+        }
+        assert(notifs.size() == 1);
+        assert(notifs.front().second == opt_args.notifMsg);
+    }
+
+    ret = peers.ucx1->getXferStats(handle, stats);
+    assert(ret == NIXL_SUCCESS);
+    peers.ucx1->releaseReqH(handle);
+    return stats;
+}
+
+// Reads are complete once their own operations are, without the endpoint
+// flush that writes still need
+void test_op_completion(bool p_thread)
+{
+    std::cout << std::endl << "Operation completion test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    const char *modes[] = { "flush", "ops" };
+    for (const char *mode : modes) {
+        testPeers peers;
+        bool ops = (std::string(mode) == "ops");
+
+        // Few enough descriptors not to be grouped
+        setupPeers(peers, p_thread, {{"completion_mode", mode}}, 64 * 1024 * 4);
+        for (bool use_notif : { false, true }) {
+            nixl_b_params_t stats;
+
+            stats = peersXfer(peers, NIXL_READ, 4, 64 * 1024, use_notif);
+            assert(stats["flushes"] == (ops ? "0" : "1"));
+            stats = peersXfer(peers, NIXL_WRITE, 4, 64 * 1024, use_notif);
+            assert(stats["flushes"] == "1");
+        }
+        teardownPeers(peers);
+        std::cout << "\t" << mode << " mode OK" << std::endl;
+    }
+}
+
+// CPU time of the process, all its threads included
+double cpuSeconds()
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Idle progress threads sleep on the worker event fds instead of polling,
+// and wake up as soon as a message arrives. Runs while no other engine
+// has a polling thread.
+void test_event_progress()
+{
+    const int idle_ms = 200;
+    const int rounds = 5;
+    testPeers peers;
+    nixl_status_t ret;
+
+    std::cout << std::endl << "Event progress test" << std::endl;
+
+    setupPeers(peers, true, {{"num_workers", "2"}, {"progress_mode", "event"}},
+               1024 * 1024);
+
+    // Transfers complete without the caller progressing the target
+    peersXfer(peers, NIXL_WRITE, 16, 64 * 1024, true);
+    peersXfer(peers, NIXL_READ, 16, 64 * 1024, true);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    double busy = cpuSeconds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+    busy = cpuSeconds() - busy;
+    std::cout << "\tIdle CPU time " << busy * 1000 << " ms in " << idle_ms << " ms" << std::endl;
+    // Polling threads would keep two CPUs busy all along
+    assert(busy * 1000 < idle_ms / 4);
+
+    // Each round finds the thread of Agent2 asleep, the message has to wake
+    // it well before the timeout it sleeps with
+    for (int k = 0; k < rounds; k++) {
+        notif_list_t notifs;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto start = std::chrono::steady_clock::now();
+        ret = peers.ucx1->genNotif("Agent2", "wake" + std::to_string(k));
+        assert(ret == NIXL_SUCCESS);
+        while (notifs.empty()) {
+            ret = peers.ucx2->getNotifs(notifs);
+            assert(ret == NIXL_SUCCESS);
+        }
+        auto latency = std::chrono::steady_clock::now() - start;
+        assert(notifs.front().second == "wake" + std::to_string(k));
+        assert(latency < std::chrono::milliseconds(50));
+    }
+    std::cout << "\t" << rounds << " wakeups OK" << std::endl;
+
+    teardownPeers(peers);
+}
+
+// Runs of descriptors to the same remote registration are posted as groups
+// that complete with a single flush, shorter runs one operation each
+void test_grouped_descs(bool p_thread)
+{
+    const int desc_cnt = 64;
+    const size_t desc_size = 4096;
+    nixl_b_params_t stats;
+
+    std::cout << std::endl << "Grouped descriptors test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    testPeers peers;
+    setupPeers(peers, p_thread, {{"group_min_descs", "16"}}, desc_cnt * desc_size);
+
+    stats = peersXfer(peers, NIXL_WRITE, desc_cnt, desc_size);
+    assert(stats["grouped_descs"] == std::to_string(desc_cnt));
+    assert(stats["flushes"] == "1");
+    stats = peersXfer(peers, NIXL_READ, desc_cnt, desc_size, true);
+    assert(stats["grouped_descs"] == std::to_string(desc_cnt));
+    assert(stats["flushes"] == "1");
+    stats = peersXfer(peers, NIXL_WRITE, 15, desc_size);
+    assert(stats["grouped_descs"] == "0");
+
+    // A second load of the same registration splits the runs, the 4
+    // descriptors in the middle are too few for a group
+    nixlBackendMD *rmd1b;
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, peers.addr2, peers.len, peers.lmd2, rmd1b);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG);
+    nixl_meta_dlist_t dst_descs(DRAM_SEG);
+    populateDescs(src_descs, 0, peers.addr1, desc_cnt, desc_size, peers.lmd1);
+    for (int i = 0; i < desc_cnt; i++) {
+        nixlMetaDesc req;
+        req.addr      = (uintptr_t) peers.addr2 + i * desc_size;
+        req.len       = desc_size;
+        req.devId     = 0;
+        req.metadataP = ((i >= 20) && (i < 24)) ? rmd1b : peers.rmd1;
+        dst_descs.addDesc(req);
+    }
+
+    doMemset(DRAM_SEG, 0, peers.addr1, 0xbb, peers.len);
+    doMemset(DRAM_SEG, 0, peers.addr2, 0, peers.len);
+
+    nixlBackendReqH *handle;
+    nixl_status_t ret = peers.ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, "Agent2", handle);
+    assert(ret == NIXL_SUCCESS);
+    waitXfer(peers.ucx1, peers.ucx2, NIXL_WRITE, src_descs, dst_descs, "Agent2", handle,
+             !p_thread);
+    verifyData(peers.addr1, peers.addr2, peers.len);
+    stats.clear();
+    ret = peers.ucx1->getXferStats(handle, stats);
+    assert(ret == NIXL_SUCCESS);
+    assert(stats["grouped_descs"] == std::to_string(desc_cnt - 4));
+    peers.ucx1->releaseReqH(handle);
+
+    peers.ucx1->unloadMD(rmd1b);
+    teardownPeers(peers);
+
+    // Grouping disabled, and grouped reads that need a flush of their own
+    setupPeers(peers, p_thread, {{"group_min_descs", "0"}}, desc_cnt * desc_size);
+    stats = peersXfer(peers, NIXL_WRITE, desc_cnt, desc_size);
+    assert(stats["grouped_descs"] == "0");
+    teardownPeers(peers);
+
+    setupPeers(peers, p_thread, {{"completion_mode", "ops"}}, desc_cnt * desc_size);
+    stats = peersXfer(peers, NIXL_READ, desc_cnt, desc_size);
+    assert(stats["grouped_descs"] == std::to_string(desc_cnt));
+    assert(stats["flushes"] == "1");
+    teardownPeers(peers);
+
+    std::cout << "\tGroups OK" << std::endl;
+}
+
+// Released request handles are handed out again by the next prepXfer,
+// including the ones released by another thread
+void test_handle_reuse(bool p_thread)
+{
+    const int desc_cnt = 4;
+    const size_t desc_size = 4096;
+    nixlBackendReqH *handle, *first, *second;
+    nixl_b_params_t stats;
+    nixl_status_t ret;
+
+    std::cout << std::endl << "Request handle reuse test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    testPeers peers;
+    setupPeers(peers, p_thread, nixl_b_params_t(), desc_cnt * desc_size);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG);
+    nixl_meta_dlist_t dst_descs(DRAM_SEG);
+    populateDescs(src_descs, 0, peers.addr1, desc_cnt, desc_size, peers.lmd1);
+    populateDescs(dst_descs, 0, peers.addr2, desc_cnt, desc_size, peers.rmd1);
+
+    ret = peers.ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, "Agent2", first);
+    assert(ret == NIXL_SUCCESS);
+    waitXfer(peers.ucx1, peers.ucx2, NIXL_WRITE, src_descs, dst_descs, "Agent2", first,
+             !p_thread);
+    peers.ucx1->releaseReqH(first);
+
+    // Comes back without the state of its last post
+    ret = peers.ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, "Agent2", handle);
+    assert(ret == NIXL_SUCCESS);
+    assert(handle == first);
+    ret = peers.ucx1->getXferStats(handle, stats);
+    assert(ret == NIXL_SUCCESS);
+    assert(stats["flushes"] == "0");
+
+    doMemset(DRAM_SEG, 0, peers.addr1, 0xbb, peers.len);
+    doMemset(DRAM_SEG, 0, peers.addr2, 0, peers.len);
+    waitXfer(peers.ucx1, peers.ucx2, NIXL_WRITE, src_descs, dst_descs, "Agent2", handle,
+             !p_thread);
+    verifyData(peers.addr1, peers.addr2, peers.len);
+
+    // Two handles at once are distinct, and both are reused after release
+    ret = peers.ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, "Agent2", second);
+    assert(ret == NIXL_SUCCESS);
+    assert(second != first);
+    std::thread releaser([&]() {
+        peers.ucx1->releaseReqH(first);
+        peers.ucx1->releaseReqH(second);
+    });
+    releaser.join();
+
+    nixlBackendReqH *again[2];
+    for (auto &h : again) {
+        ret = peers.ucx1->prepXfer(NIXL_WRITE, src_descs, dst_descs, "Agent2", h);
+        assert(ret == NIXL_SUCCESS);
+    }
+    assert(((again[0] == first) && (again[1] == second)) ||
+           ((again[0] == second) && (again[1] == first)));
+    for (auto &h : again) {
+        peers.ucx1->releaseReqH(h);
+    }
+
+    teardownPeers(peers);
+    std::cout << "\tHandles reused OK" << std::endl;
+}
+
+nixlUcxRkeyEntry *rkeyEntry(nixlBackendMD *rmd)
+{
+    return ((nixlUcxPublicMetadata*) rmd)->rkeyEntry;
+}
+
+// Loads of the same packed rkey share one unpacked entry, which outlives its
+// last unload until rkey_cache_size newer ones were released or the
+// connection ends
+void test_rkey_cache(bool p_thread)
+{
+    const size_t len = 4096;
+    nixlBackendMD *rmd_x, *rmd_y;
+    nixlUcxRkeyEntry *entry_x, *entry_y;
+
+    std::cout << std::endl << "Remote key cache test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    testPeers peers;
+    setupPeers(peers, p_thread, {{"rkey_cache_size", "1"}}, len);
+
+    // A second registration of Agent2, with a key of its own
+    void *addr_y;
+    nixlBackendMD *lmd_y;
+    allocateAndRegister(peers.ucx2, 0, DRAM_SEG, addr_y, len, lmd_y);
+
+    entry_x = rkeyEntry(peers.rmd1);
+    assert(entry_x->refCnt == 1);
+    assert(entry_x->rkeys.size() == 1);
+
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, peers.addr2, len, peers.lmd2, rmd_x);
+    assert(rkeyEntry(rmd_x) == entry_x);
+    assert(entry_x->refCnt == 2);
+    peers.ucx1->unloadMD(rmd_x);
+    assert(entry_x->refCnt == 1);
+    assert(!entry_x->idle);
+
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, addr_y, len, lmd_y, rmd_y);
+    entry_y = rkeyEntry(rmd_y);
+    assert(entry_y != entry_x);
+
+    // Unreferenced, but kept for the next load
+    peers.ucx1->unloadMD(peers.rmd1);
+    assert(entry_x->refCnt == 0);
+    assert(entry_x->idle);
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, peers.addr2, len, peers.lmd2, peers.rmd1);
+    assert(rkeyEntry(peers.rmd1) == entry_x);
+    assert(entry_x->refCnt == 1);
+    assert(!entry_x->idle);
+
+    // With room for one, the least recently released entry goes
+    peers.ucx1->unloadMD(peers.rmd1);
+    peers.ucx1->unloadMD(rmd_y);
+    assert(entry_y->idle);
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, addr_y, len, lmd_y, rmd_y);
+    assert(rkeyEntry(rmd_y) == entry_y);
+    assert(entry_y->refCnt == 1);
+    loadRemote(peers.ucx1, 0, "Agent2", DRAM_SEG, peers.addr2, len, peers.lmd2, peers.rmd1);
+    assert(rkeyEntry(peers.rmd1) != entry_y);
+    assert(rkeyEntry(peers.rmd1)->refCnt == 1);
+
+    // Reloaded keys still work
+    peersXfer(peers, NIXL_WRITE, 1, len);
+
+    // Entries referenced when the connection ends are freed on their last unload
+    peers.ucx1->disconnect("Agent2");
+    assert(!entry_y->cached);
+    assert(!rkeyEntry(peers.rmd1)->cached);
+    peers.ucx1->unloadMD(rmd_y);
+
+    deallocateAndDeregister(peers.ucx2, 0, DRAM_SEG, addr_y, lmd_y);
+    teardownPeers(peers);
+    std::cout << "\tShared and evicted entries OK" << std::endl;
+}
+
+#ifdef HAVE_CUDA
+// Memory of a second GPU, registered after some of the first one, is posted
+// and progressed under the context of its own device
+void test_second_gpu_transfer(bool p_thread)
+{
+    const int dev_id = 1;
+    const int desc_cnt = 16;
+    const size_t desc_size = 1024 * 1024;
+    size_t len = desc_cnt * desc_size;
+    nixl_status_t ret;
+
+    std::cout << std::endl << "Second GPU transfer test: "
+              << "P-Thr=" << (p_thread ? "ON" : "OFF") << std::endl;
+
+    nixlBackendEngine *ucx1 = createEngine("Agent1", p_thread);
+    nixlBackendEngine *ucx2 = createEngine("Agent2", p_thread);
+    std::string agent2("Agent2");
+
+    // GPU 0 comes first, its context is the one the progress thread starts with
+    void *first1, *first2;
+    nixlBackendMD *fmd1, *fmd2;
+    allocateAndRegister(ucx1, 0, VRAM_SEG, first1, 4096, fmd1);
+    allocateAndRegister(ucx2, 0, VRAM_SEG, first2, 4096, fmd2);
+
+    std::string conn_info2;
+    ret = ucx2->getConnInfo(conn_info2);
+    assert(ret == NIXL_SUCCESS);
+    ret = ucx1->loadRemoteConnInfo(agent2, conn_info2);
+    assert(ret == NIXL_SUCCESS);
+
+    void *addr1, *addr2;
+    nixlBackendMD *lmd1, *lmd2, *rmd1;
+    allocateAndRegister(ucx1, dev_id, VRAM_SEG, addr1, len, lmd1);
+    allocateAndRegister(ucx2, dev_id, VRAM_SEG, addr2, len, lmd2);
+    loadRemote(ucx1, dev_id, agent2, VRAM_SEG, addr2, len, lmd2, rmd1);
+
+    nixl_meta_dlist_t req_src_descs(VRAM_SEG);
+    nixl_meta_dlist_t req_dst_descs(VRAM_SEG);
+    populateDescs(req_src_descs, dev_id, addr1, desc_cnt, desc_size, lmd1);
+    populateDescs(req_dst_descs, dev_id, addr2, desc_cnt, desc_size, rmd1);
+
+    for (nixl_xfer_op_t op : { NIXL_READ, NIXL_WRITE }) {
+        for (bool use_notif : { true, false }) {
+            doMemset(VRAM_SEG, dev_id, addr1, 0xbb, len);
+            doMemset(VRAM_SEG, dev_id, addr2, 0xda, len);
+            // The posting thread stays on GPU 0
+            checkCudaError(cudaSetDevice(0), "Failed to set device");
+
+            testHndlIterator hiter(false);
+            performTransfer(ucx1, ucx2, req_src_descs, req_dst_descs,
+                            addr1, addr2, len, op, hiter, !p_thread, use_notif);
+        }
+    }
+
+    ucx1->unloadMD(rmd1);
+    deallocateAndDeregister(ucx1, dev_id, VRAM_SEG, addr1, lmd1);
+    deallocateAndDeregister(ucx2, dev_id, VRAM_SEG, addr2, lmd2);
+    deallocateAndDeregister(ucx1, 0, VRAM_SEG, first1, fmd1);
+    deallocateAndDeregister(ucx2, 0, VRAM_SEG, first2, fmd2);
+    ucx1->disconnect(agent2);
+
+    releaseEngine(ucx1);
+    releaseEngine(ucx2);
+}
+#endif
+
 int main()
 {
     bool thread_on[2] = {false, true};
     nixlBackendEngine *ucx[2][2] = { 0 };
 
+    // Before the engines below start their polling threads
+    test_event_progress();
+
     // Allocate UCX engines
     for(int i = 0; i < 2; i++) {
         for(int j = 0; j < 2; j++) {
@@ -733,11 +1377,46 @@ int main()
 #endif
     }
 
+    for(int i = 0; i < 2; i++) {
+        test_worker_pool(thread_on[i]);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        test_handle_reuse(thread_on[i]);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        test_rkey_cache(thread_on[i]);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        test_op_completion(thread_on[i]);
+    }
+
+    for(int i = 0; i < 2; i++) {
+        test_grouped_descs(thread_on[i]);
+    }
+
+    // genNotif messages packed into fewer active messages
+    for(int i = 0; i < 2; i++) {
+        nixlBackendEngine *ucx_cn[2];
+        ucx_cn[0] = createEngine("Agent1", thread_on[i], {{"notif_coalesce_us", "50"}});
+        ucx_cn[1] = createEngine("Agent2", thread_on[i], {{"notif_coalesce_us", "50"}});
+        test_coalesced_notifs(thread_on[i], ucx_cn[0], ucx_cn[1]);
+        releaseEngine(ucx_cn[0]);
+        releaseEngine(ucx_cn[1]);
+    }
+
 #ifdef HAVE_CUDA
     if (n_vram_dev > 1) {
 		//Test if registering on a different GPU fails correctly
 		allocateWrongGPUTest(ucx[0][0], 1);
 		std::cout << "Verified registration on wrong GPU fails correctly\n";
+		allocateOtherGPUTest(ucx[1][0], 1);
+		std::cout << "Verified registration on a second GPU succeeds\n";
+		for(int i = 0; i < 2; i++) {
+			test_second_gpu_transfer(thread_on[i]);
+		}
 	}
 #endif
 
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <string>
 #include <cassert>
+#include <cstring>
 
 #include "ucx_mo_backend.h"
 
@@ -71,11 +72,13 @@ std::string memType2Str(nixl_mem_t mem_type)
     }
 }
 
-nixlBackendEngine *createEngine(std::string name, uint32_t ndev, bool p_thread)
+// Engine parameters not in params keep their defaults
+nixlBackendEngine *createEngine(std::string name, uint32_t ndev, bool p_thread,
+                                const nixl_b_params_t &params = nixl_b_params_t())
 {
     nixlBackendEngine     *ucx_mo;
     nixlBackendInitParams init;
-    nixl_b_params_t       custom_params;
+    nixl_b_params_t       custom_params = params;
 
     custom_params["num_ucx_engines"] = std::to_string(ndev);
     init.enableProgTh = p_thread;
@@ -238,6 +241,11 @@ int dev_distr_rr(int idx, int max_idx, int cnt)
     return idx % cnt;
 }
 
+int dev_distr_shift(int idx, int max_idx, int cnt)
+{
+    return (idx + 3) % cnt;
+}
+
 int dev_distr_blk(int idx, int max_idx, int cnt)
 {
     int block_size = max_idx / cnt;
@@ -250,27 +258,33 @@ int dev_distr_blk(int idx, int max_idx, int cnt)
 }
 
 
+void addLocalDesc(nixlBackendEngine *ucx, nixl_meta_dlist_t &descs,
+                  int dev_id, size_t desc_size)
+{
+    nixlBasicDesc desc;
+    nixlMetaDesc desc_m;
+    nixlBlobDesc desc_s;
+    void *addr;
+
+    desc.len = desc_size;
+    desc.devId = dev_id;
+
+    allocateBuffer(descs.getType(), desc.devId, desc.len, addr);
+    desc.addr = (uintptr_t)addr;
+    *((nixlBasicDesc*)&desc_s) = desc;
+    *((nixlBasicDesc*)&desc_m) = desc;
+    int ret = ucx->registerMem(desc_s, descs.getType(), desc_m.metadataP);
+    assert(ret == NIXL_SUCCESS);
+    descs.addDesc(desc_m);
+}
+
 void createLocalDescs(nixlBackendEngine *ucx, nixl_meta_dlist_t &descs,
                       int dev_cnt, dev_distr_t dist_f,
                       int desc_cnt, size_t desc_size)
 {
 
     for(int i = 0; i < desc_cnt; i++) {
-        nixlBasicDesc desc;
-        nixlMetaDesc desc_m;
-        nixlBlobDesc desc_s;
-        void *addr;
-
-        desc.len = desc_size;
-        desc.devId = dist_f(i, desc_cnt, dev_cnt);
-
-        allocateBuffer(descs.getType(), desc.devId, desc.len, addr);
-        desc.addr = (uintptr_t)addr;
-        *((nixlBasicDesc*)&desc_s) = desc;
-        *((nixlBasicDesc*)&desc_m) = desc;
-        int ret = ucx->registerMem(desc_s, descs.getType(), desc_m.metadataP);
-        assert(ret == NIXL_SUCCESS);
-        descs.addDesc(desc_m);
+        addLocalDesc(ucx, descs, dist_f(i, desc_cnt, dev_cnt), desc_size);
     }
 }
 
@@ -551,6 +565,148 @@ void test_agent_transfer(bool p_thread,
     //ucx2->disconnect(agent1);
 }
 
+// Transfers the descriptors, checks the data once complete and returns the
+// stats of the post
+nixl_b_params_t checkedTransfer(nixlBackendEngine *ucx1, nixlBackendEngine *ucx2,
+                                nixl_meta_dlist_t &req_src_descs,
+                                nixl_meta_dlist_t &req_dst_descs,
+                                nixl_xfer_op_t op)
+{
+    nixl_status_t status;
+    nixlBackendReqH* handle;
+    nixl_b_params_t stats;
+
+    for (int i = 0; i < req_src_descs.descCount(); i++) {
+        doMemset(DRAM_SEG, 0, (void*) req_src_descs[i].addr, 0xda, req_src_descs[i].len);
+        doMemset(DRAM_SEG, 0, (void*) req_dst_descs[i].addr, 0xff, req_dst_descs[i].len);
+    }
+
+    status = ucx1->prepXfer(op, req_src_descs, req_dst_descs, "Agent2", handle);
+    assert(status == NIXL_SUCCESS);
+    status = ucx1->postXfer(op, req_src_descs, req_dst_descs, "Agent2", handle);
+    while (status == NIXL_IN_PROG) {
+        status = ucx1->checkXfer(handle);
+        ucx2->progress();
+    }
+    assert(status == NIXL_SUCCESS);
+
+    for (int i = 0; i < req_src_descs.descCount(); i++) {
+        assert(!memcmp((void*) req_src_descs[i].addr, (void*) req_dst_descs[i].addr,
+                       req_src_descs[i].len));
+    }
+
+    status = ucx1->getXferStats(handle, stats);
+    assert(status == NIXL_SUCCESS);
+    ucx1->releaseReqH(handle);
+    return stats;
+}
+
+// Descriptors go through the engines of their devices, one group per pair
+// of local and remote engine. With rail threads, the groups of all but the
+// first local engine are posted by the thread of their engine.
+void test_rail_selection(bool rail_threads)
+{
+    const int ndev = 8;
+    nixl_status_t status;
+
+    std::cout << std::endl << "Rail selection test: Rail-Thr="
+              << (rail_threads ? "ON" : "OFF") << std::endl;
+
+    nixl_b_params_t params = {{"topology", "none"},
+                              {"rail_threads", rail_threads ? "true" : "false"}};
+    nixlBackendEngine *ucx1 = createEngine("Agent1", ndev, false, params);
+    nixlBackendEngine *ucx2 = createEngine("Agent2", ndev, false, params);
+
+    std::string conn_info2;
+    status = ucx2->getConnInfo(conn_info2);
+    assert(NIXL_SUCCESS == status);
+    status = ucx1->loadRemoteConnInfo("Agent2", conn_info2);
+    assert(NIXL_SUCCESS == status);
+
+    nixl_meta_dlist_t src_descs(DRAM_SEG);
+    nixl_meta_dlist_t ucx2_descs(DRAM_SEG);
+    nixl_meta_dlist_t dst_descs(DRAM_SEG);
+    createLocalDescs(ucx1, src_descs, ndev, dev_distr_rr, 2 * ndev, 64 * 1024);
+    createLocalDescs(ucx2, ucx2_descs, ndev, dev_distr_shift, 2 * ndev, 64 * 1024);
+    createRemoteDescs(ucx2, "Agent2", ucx2_descs, ucx1, dst_descs);
+
+    // Device d on Agent1 always meets device d + 3 on Agent2
+    std::string groups;
+    for (int l = 0; l < ndev; l++) {
+        groups += (l ? "," : "") + std::to_string(l) + ":" + std::to_string((l + 3) % ndev);
+    }
+
+    for (nixl_xfer_op_t op : { NIXL_READ, NIXL_WRITE }) {
+        nixl_b_params_t stats = checkedTransfer(ucx1, ucx2, src_descs, dst_descs, op);
+
+        assert(stats["groups"] == groups);
+        assert(stats["rail_threads"] == (rail_threads ? std::to_string(ndev - 1) : "0"));
+        std::cout << "\t" << op2string(op, false) << " groups " << stats["groups"]
+                  << ", rail threads " << stats["rail_threads"] << " OK" << std::endl;
+    }
+
+    destroyRemoteDescs(ucx1, dst_descs);
+    destroyLocalDescs(ucx1, src_descs);
+    destroyLocalDescs(ucx2, ucx2_descs);
+    ucx1->disconnect("Agent2");
+
+    releaseEngine(ucx1);
+    releaseEngine(ucx2);
+}
+
+// Descriptors of stripe_threshold bytes or more are split over the next
+// engines of their device, as many as the narrower side has, the smaller ones
+// stay on their engine
+void test_striping(const std::string &remote_width, size_t big_dev, size_t small_dev,
+                   size_t pieces, const std::string &groups)
+{
+    const int ndev = 8;
+    nixl_status_t status;
+
+    std::cout << std::endl << "Striping test: width 4 to " << remote_width << std::endl;
+
+    nixlBackendEngine *ucx1 = createEngine("Agent1", ndev, false,
+                                           {{"topology", "none"}, {"stripe_threshold", "65536"},
+                                            {"stripe_width", "4"}});
+    nixlBackendEngine *ucx2 = createEngine("Agent2", ndev, false,
+                                           {{"topology", "none"}, {"stripe_threshold", "65536"},
+                                            {"stripe_width", remote_width}});
+
+    std::string conn_info2;
+    status = ucx2->getConnInfo(conn_info2);
+    assert(NIXL_SUCCESS == status);
+    status = ucx1->loadRemoteConnInfo("Agent2", conn_info2);
+    assert(NIXL_SUCCESS == status);
+
+    // Not a multiple of the width, the last chunk is shorter
+    size_t big_size = 1024 * 1024 + 3;
+    nixl_meta_dlist_t src_descs(DRAM_SEG);
+    nixl_meta_dlist_t ucx2_descs(DRAM_SEG);
+    nixl_meta_dlist_t dst_descs(DRAM_SEG);
+    addLocalDesc(ucx1, src_descs, big_dev, big_size);
+    addLocalDesc(ucx1, src_descs, small_dev, 4096);
+    addLocalDesc(ucx2, ucx2_descs, big_dev, big_size);
+    addLocalDesc(ucx2, ucx2_descs, small_dev, 4096);
+    createRemoteDescs(ucx2, "Agent2", ucx2_descs, ucx1, dst_descs);
+
+    for (nixl_xfer_op_t op : { NIXL_READ, NIXL_WRITE }) {
+        nixl_b_params_t stats = checkedTransfer(ucx1, ucx2, src_descs, dst_descs, op);
+
+        assert(stats["pieces"] == std::to_string(pieces));
+        assert(stats["groups"] == groups);
+        std::cout << "\t" << op2string(op, false) << " " << stats["pieces"]
+                  << " pieces over " << stats["groups"] << " OK" << std::endl;
+    }
+
+    destroyRemoteDescs(ucx1, dst_descs);
+    destroyLocalDescs(ucx1, src_descs);
+    destroyLocalDescs(ucx2, ucx2_descs);
+    ucx1->disconnect("Agent2");
+
+    releaseEngine(ucx1);
+    releaseEngine(ucx2);
+}
+
 int main()
 {
     bool thread_on[] = {false , true};
@@ -613,6 +769,34 @@ int ndevices = NUM_WORKERS;
 #endif
     }
 
+    // Same transfers with the rails posted and progressed in parallel
+    nixlBackendEngine *rail1 = createEngine("Agent1", ndevices, false, {{"rail_threads", "true"}});
+    nixlBackendEngine *rail2 = createEngine("Agent2", ndevices, false, {{"rail_threads", "true"}});
+    test_agent_transfer(false,
+                        rail1, DRAM_SEG, ndevices, dev_distr_rr,
+                        rail2, DRAM_SEG, ndevices, dev_distr_blk);
+    releaseEngine(rail1);
+    releaseEngine(rail2);
+
+    test_rail_selection(false);
+    test_rail_selection(true);
+
+    // Every descriptor split over all the rails
+    nixlBackendEngine *stripe1 = createEngine("Agent1", ndevices, false,
+                                         {{"rail_threads", "true"}, {"stripe_threshold", "65536"}});
+    nixlBackendEngine *stripe2 = createEngine("Agent2", ndevices, false,
+                                         {{"rail_threads", "true"}, {"stripe_threshold", "65536"}});
+    test_agent_transfer(false,
+                        stripe1, DRAM_SEG, ndevices, dev_distr_rr,
+                        stripe2, DRAM_SEG, ndevices, dev_distr_blk);
+    releaseEngine(stripe1);
+    releaseEngine(stripe2);
+
+    // The stripe engines wrap around past the last one
+    test_striping("4", 7, 4, 5, "0:0,1:1,2:2,4:4,7:7");
+    // Split no wider than the remote side
+    test_striping("2", 2, 6, 3, "2:2,3:3,6:6");
+
     // Allocate UCX engines
     for(int i = 0; i < 2; i++) {
         for(int j = 0; j < 2; j++) {
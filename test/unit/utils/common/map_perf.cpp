@@ -131,6 +131,24 @@ void test_comparison_perf(const int n_entries, const size_t str_len) {
 
     std::cout << "ordered map lookup test, total time for " << n_iters << " iters: "
               << diff_time.tv_sec << "s " << diff_time.tv_usec << "us \n";
+
+    // Interned ids, as given to transfers instead of agent names
+    std::vector<uint32_t> interned(n_entries);
+    uint64_t sum3 = 0;
+    for(int i = 0; i<n_entries; i++)
+        interned[i] = normal_map[ref[i]];
+
+    gettimeofday(&start_time, NULL);
+    for(int i = 0; i<n_iters; i++)
+        sum3 += interned[i % n_entries];
+    gettimeofday(&end_time, NULL);
+
+    timersub(&end_time, &start_time, &diff_time);
+
+    std::cout << "interned id lookup test, total time for " << n_iters << " iters: "
+              << diff_time.tv_sec << "s " << diff_time.tv_usec << "us \n";
+
+    assert(sum3 == sum1);
 }
 
 int main()
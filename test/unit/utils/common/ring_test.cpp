@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/ring.h"
+
+int main()
+{
+    // Bounded, in order, and values stay with the caller when full
+    nixlRing<std::string> ring(3);
+    assert(ring.capacity() == 4);
+
+    for (int i = 0; i < 4; i++) {
+        std::string val = std::to_string(i);
+        assert(ring.push(val));
+    }
+    std::string extra("extra");
+    assert(!ring.push(extra));
+    assert(extra == "extra");
+
+    std::string out;
+    for (int i = 0; i < 4; i++) {
+        assert(ring.pop(out));
+        assert(out == std::to_string(i));
+    }
+    assert(!ring.pop(out));
+
+    // One producer, several consumers, every value popped exactly once
+    const int count = 100000;
+    const int consumers = 4;
+    nixlRing<int> int_ring(64);
+    std::vector<int> seen(count, 0);
+    std::vector<std::thread> threads;
+    std::atomic<int> popped{0};
+
+    for (int t = 0; t < consumers; t++) {
+        threads.emplace_back([&]() {
+            int val;
+            while (popped < count) {
+                if (int_ring.pop(val)) {
+                    seen[val]++;
+                    popped++;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < count; i++) {
+        int val = i;
+        while (!int_ring.push(val)) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (int i = 0; i < count; i++) {
+        assert(seen[i] == 1);
+    }
+
+    std::cout << "Ring test passed" << std::endl;
+    return 0;
+}
@@ -16,7 +16,36 @@
  */
 #include "serdes/serdes.h"
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <vector>
+
+// Reader of older releases: "nixlSerDes|", then per field its tag, a size_t
+// length, the value and a '|'
+static bool legacyRead(const std::string &buf, const std::vector<std::string> &tags,
+                       std::map<std::string, std::string> &fields) {
+    size_t offset = 11;
+
+    if (buf.compare(0, offset, "nixlSerDes|") != 0)
+        return false;
+
+    for (auto &tag : tags) {
+        size_t len;
+        if ((buf.compare(offset, tag.size(), tag) != 0) ||
+            (buf.size() < offset + tag.size() + sizeof(len)))
+            return false;
+        offset += tag.size();
+        memcpy(&len, buf.data() + offset, sizeof(len));
+        offset += sizeof(len);
+        if ((buf.size() < offset + len + 1) || (buf[offset + len] != '|'))
+            return false;
+        fields[tag] = buf.substr(offset, len);
+        offset += len + 1;
+    }
+    return offset == buf.size();
+}
 
 int main() {
 
@@ -61,5 +90,51 @@ int main() {
 
     free(ptr);
 
+    // Both formats are read, whichever the default is
+    for (auto format : {nixlSerDes::TAGGED, nixlSerDes::BINARY}) {
+        nixlSerDes sd3(format);
+        size_t big = 1 << 20;
+        std::string large(300, 'x');
+
+        assert(sd3.addBuf("n", &big, sizeof(big)) == 0);
+        assert(sd3.addStr("", "") == 0);
+        assert(sd3.addStr("l", large) == 0);
+        std::string buf3 = sd3.releaseStr();
+
+        nixlSerDes sd4;
+        assert(sd4.importView(buf3) == 0);
+        assert(sd4.getBufLen("n") == sizeof(big));
+        // A buffer of the wrong size or tag is not read
+        assert(sd4.getBuf("n", &i, sizeof(i)) != 0);
+        assert(sd4.getBuf("x", &big, sizeof(big)) != 0);
+        big = 0;
+        assert(sd4.getBuf("n", &big, sizeof(big)) == 0);
+        assert(big == 1 << 20);
+        assert(sd4.getStr("").empty());
+        std::string_view view = sd4.getStrView("l");
+        assert(view == large);
+        // In place
+        assert((view.data() >= buf3.data()) && (view.data() < buf3.data() + buf3.size()));
+
+        // Truncated buffers fail instead of reading past the end
+        nixlSerDes sd5;
+        assert(sd5.importStr(buf3.substr(0, buf3.size() - 1)) == 0);
+        assert(sd5.getBuf("n", &big, sizeof(big)) == 0);
+        assert(sd5.getStr("").empty());
+        assert(sd5.getStrView("l").data() == nullptr);
+    }
+
+    nixlSerDes sd6;
+    assert(sd6.importStr(std::string("garbage")) != 0);
+
+    // The default output is read by older releases
+    if (!getenv("NIXL_SERDES_FORMAT")) {
+        assert(nixlSerDes::defaultFormat() == nixlSerDes::TAGGED);
+        std::map<std::string, std::string> fields;
+        assert(legacyRead(sdbuf, {t1, t2}, fields));
+        assert(fields[t1] == std::string((char*) &i, sizeof(i)));
+        assert(fields[t2] == s);
+    }
+
     return 0;
 }
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "stream/metadata_stream.h"
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// Frames of several sizes through a nonblocking socket pair, the large one
+// taking many partial sends and receives
+int main (int argc, char *argv[]) {
+    int fds[2];
+    [[maybe_unused]] int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+    for (int fd : fds) {
+        rc = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        assert(rc == 0);
+    }
+
+    std::vector<std::string> sent;
+    sent.push_back("");
+    sent.push_back("small frame");
+    sent.push_back(std::string(50 * 1024 * 1024, '\0'));
+    for (size_t i = 0; i < sent.back().size(); i++)
+        sent.back()[i] = (char) (i * 7);
+    sent.push_back("after the large one");
+
+    nixlMDFrameWriter writer;
+    nixlMDFrameReader reader;
+    nixl_status_t ret;
+    for (size_t i = 0; i < sent.size(); i++) {
+        ret = writer.push(i + 1, std::string(sent[i]));
+        assert(ret == NIXL_SUCCESS);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t received = 0;
+    ret = writer.flush(fds[0]);
+
+    while (received < sent.size()) {
+        struct pollfd pfds[2] = {{fds[0], POLLOUT, 0}, {fds[1], POLLIN, 0}};
+        rc = poll(pfds, 2, 5000);
+        assert(rc > 0);
+
+        if ((ret == NIXL_IN_PROG) && (pfds[0].revents & POLLOUT))
+            ret = writer.flush(fds[0]);
+        assert(ret != NIXL_ERR_BACKEND);
+
+        uint32_t type;
+        std::string data;
+        nixl_status_t rret;
+        while ((rret = reader.recvFrame(fds[1], type, data)) == NIXL_SUCCESS) {
+            assert(type == received + 1);
+            assert(data == sent[received]);
+            received++;
+        }
+        assert(rret == NIXL_IN_PROG);
+    }
+    assert(writer.empty());
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Framed " << sent[2].size() / (1024 * 1024) << " MB in " << secs * 1000
+              << " ms, " << sent[2].size() / secs / (1024 * 1024) << " MB/s" << std::endl;
+
+    // A peer that closes in the middle of a frame is an error, not a frame
+    nixlMDFrameWriter partial;
+    ret = partial.push(1, std::string(1024, 'x'));
+    assert(ret == NIXL_SUCCESS);
+    ret = partial.flush(fds[0]);
+    assert(ret == NIXL_SUCCESS);
+    close(fds[0]);
+
+    uint32_t type;
+    std::string data;
+    ret = reader.recvFrame(fds[1], type, data);
+    assert(ret == NIXL_SUCCESS);
+    ret = reader.recvFrame(fds[1], type, data);
+    assert(ret == NIXL_ERR_BACKEND);
+    close(fds[1]);
+
+    // Data without the frame header is rejected
+    rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+    const char garbage[] = "NIXLCOMM:LOADsome old style message";
+    [[maybe_unused]] ssize_t bytes = write(fds[0], garbage, sizeof(garbage));
+    assert(bytes == sizeof(garbage));
+    nixlMDFrameReader fresh;
+    ret = fresh.recvFrame(fds[1], type, data);
+    assert(ret == NIXL_ERR_BACKEND);
+    close(fds[0]);
+    close(fds[1]);
+
+    // So is a header over the size limit, before its payload is read
+    rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+    nixlMDFrameHeader header = {};
+    memcpy(header.magic, NIXL_MD_FRAME_MAGIC, sizeof(header.magic));
+    header.type   = 1;
+    header.length = NIXL_MD_FRAME_MAX_SIZE + 1;
+    bytes = write(fds[0], &header, sizeof(header));
+    assert(bytes == sizeof(header));
+    nixlMDFrameReader limited;
+    ret = limited.recvFrame(fds[1], type, data);
+    assert(ret == NIXL_ERR_BACKEND);
+    close(fds[0]);
+    close(fds[1]);
+
+    std::cout << "Frame tests passed" << std::endl;
+    return 0;
+}
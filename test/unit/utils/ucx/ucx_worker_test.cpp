@@ -19,6 +19,7 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <sys/mman.h>
 
 #include "ucx/ucx_utils.h"
 
@@ -197,6 +198,50 @@ int main()
         assert(chk_buffer[i] == 0xda);
     }
 
+    /* =========================================
+     *   Test registration cache
+     * ========================================= */
+
+    {
+        nixlUcxMem cached[4];
+        size_t hits = w[0].regCacheHits();
+
+        assert(0 == w[0].regCacheEnable(2 * buf_size));
+        // Mapped once, then covered sub-ranges reuse it, also once unreferenced
+        assert(0 == w[0].memReg(buffer[1], buf_size, cached[0]));
+        assert(w[0].regCacheHits() == hits);
+        assert(0 == w[0].memReg(buffer[1] + 4096, 1024, cached[1]));
+        assert(w[0].regCacheHits() == hits + 1);
+        w[0].memDereg(cached[0]);
+        w[0].memDereg(cached[1]);
+        assert(0 == w[0].memReg(buffer[1] + buf_size / 2, buf_size / 4, cached[2]));
+        assert(w[0].regCacheHits() == hits + 2);
+        w[0].memDereg(cached[2]);
+        // A flushed registration is mapped again
+        w[0].regCacheFlush();
+        assert(0 == w[0].memReg(buffer[1] + 4096, 1024, cached[3]));
+        assert(w[0].regCacheHits() == hits + 2);
+        w[0].memDereg(cached[3]);
+
+        // A buffer unmapped while cached, and mapped again at the same
+        // address, does not get the old mapping
+        nixlUcxMem remapped[2];
+        void *region = mmap(NULL, buf_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(region != MAP_FAILED);
+        assert(0 == w[0].memReg(region, buf_size, remapped[0]));
+        w[0].memDereg(remapped[0]);
+        hits = w[0].regCacheHits();
+        munmap(region, buf_size);
+        assert(region == mmap(region, buf_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0));
+        assert(0 == w[0].memReg(region, buf_size, remapped[1]));
+        assert(w[0].regCacheHits() == hits);
+        w[0].memDereg(remapped[1]);
+        munmap(region, buf_size);
+        assert(0 == w[0].regCacheEnable(0));
+    }
+
     /* Test shutdown */
     for(i = 0; i < 2; i++) {
         w[i].rkeyDestroy(rkey[i]);